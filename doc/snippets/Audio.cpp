@@ -27,11 +27,18 @@
    affect anything else. */
 #define CORRADE_STATIC_PLUGIN
 
+#define DOXYGEN_IGNORE(...) __VA_ARGS__
+
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Audio/BufferStream.h"
 #include "Magnum/Audio/Context.h"
 #include "Magnum/Audio/Extensions.h"
+#include "Magnum/Audio/Source.h"
 
 using namespace Magnum;
 
@@ -60,6 +67,49 @@ CORRADE_PLUGIN_REGISTER(MyAudioImporter, MyNamespace::MyAudioImporter,
    avoid -Wmisssing-prototypes */
 void mainAudio();
 void mainAudio() {
+{
+Containers::Pointer<Audio::AbstractImporter> importer;
+/* [AbstractImporter-streaming] */
+std::size_t frameSize = Audio::bufferFormatSize(importer->format());
+Containers::Array<char> chunk{NoInit, 4096*frameSize};
+while(std::size_t frames = importer->readInto(chunk)) {
+    Containers::ArrayView<const char> data = chunk.prefix(frames*frameSize); DOXYGEN_IGNORE(static_cast<void>(data);)
+    // process the data ...
+}
+/* [AbstractImporter-streaming] */
+}
+
+{
+Containers::Pointer<Audio::AbstractImporter> importer;
+Containers::ArrayView<const char> packFile;
+std::size_t offset{}, size{};
+/* [AbstractImporter-openMemory] */
+/* The pack file is memory-mapped and stays around for the whole app lifetime,
+   so the importer can reference it directly */
+importer->openMemory(packFile.slice(offset, offset + size));
+
+Audio::Buffer buffer;
+buffer.setData(importer->format(), importer->dataView(), importer->frequency());
+/* [AbstractImporter-openMemory] */
+}
+
+{
+Containers::Pointer<Audio::AbstractImporter> importer;
+bool gameRunning{};
+/* [BufferStream] */
+Audio::Source source;
+Audio::BufferStream stream{*importer, source};
+stream.setLooping(true)
+      .update();
+source.play();
+
+while(gameRunning) {
+    stream.update();
+    // ...
+}
+/* [BufferStream] */
+}
+
 {
 /* [Context-isExtensionSupported] */
 if(Audio::Context::current().isExtensionSupported<Audio::Extensions::ALC::SOFTX::HRTF>()) {
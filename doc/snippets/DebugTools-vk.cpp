@@ -0,0 +1,72 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include "Magnum/DebugTools/FrameProfilerVk.h"
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPool.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/FramePacer.h"
+#include "Magnum/Vk/Queue.h"
+
+using namespace Magnum;
+
+#define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
+
+/* Make sure the name doesn't conflict with any other snippets to avoid linker
+   warnings, unlike with `int main()` there now has to be a declaration to
+   avoid -Wmisssing-prototypes */
+void mainDebugToolsVk();
+void mainDebugToolsVk() {
+{
+Vk::Device device{NoCreate};
+Vk::Queue queue{NoCreate};
+Vk::CommandPool pool{NoCreate};
+bool running{};
+/* [FrameProfilerVk-usage] */
+/* The same amount of frames in flight as the pacer has */
+Vk::FramePacer pacer{device, 2};
+DebugTools::FrameProfilerVk profiler{device,
+    DebugTools::FrameProfilerVk::Value::FrameTime|
+    DebugTools::FrameProfilerVk::Value::GpuDuration, 50, pacer.frameCount()};
+
+while(running) {
+    pacer.beginFrame();
+
+    Vk::CommandBuffer cmd = pool.allocate();
+    cmd.begin();
+    profiler.beginFrame(cmd);
+    DOXYGEN_ELLIPSIS()
+    profiler.endFrame(cmd);
+    cmd.end();
+
+    queue.submit({Vk::SubmitInfo{}
+        .setCommandBuffers({cmd})
+        .setSignalSemaphores({pacer.signalSemaphore()})
+    }, {});
+
+    profiler.printStatistics(10);
+}
+/* [FrameProfilerVk-usage] */
+}
+}
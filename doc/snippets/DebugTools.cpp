@@ -27,6 +27,7 @@
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/StringView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Path.h>
 #include <Corrade/PluginManager/Manager.h>
 
 #include "Magnum/Image.h"
@@ -101,6 +102,17 @@ CORRADE_COMPARE_WITH(actual.pixels<Color3ub>().flipped<0>(), expected,
     (DebugTools::CompareImage{1.5f, 0.01f}));
 /* [CompareImage-pixels-flip] */
 }
+
+{
+Image2D actual = doProcessing();
+Image2D expected = loadExpectedImage();
+/* [CompareImage-performance] */
+CORRADE_COMPARE_WITH(actual, expected,
+    (DebugTools::CompareImage{1.5f, 0.01f}
+        .setThreadCount(0)
+        .setFlags(DebugTools::CompareImageFlag::EarlyOut)));
+/* [CompareImage-performance] */
+}
 }
 };
 
@@ -166,4 +178,31 @@ DebugTools::FrameProfiler profiler{{
 /* [FrameProfiler-setup-immediate] */
 }
 
+{
+DebugTools::FrameProfiler profiler;
+auto updateAnimations = []{};
+auto drawShadows = [](Int) {};
+/* [FrameProfiler-scopes] */
+profiler.setScopeBufferSize(4096);
+
+// …
+
+{
+    MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, "update");
+    updateAnimations();
+}
+{
+    MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, "shadows");
+    for(Int cascade: {0, 1, 2}) {
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, "cascade");
+        drawShadows(cascade);
+    }
+}
+
+// …
+
+Utility::Path::write("trace.json", profiler.chromeTrace());
+/* [FrameProfiler-scopes] */
+}
+
 }
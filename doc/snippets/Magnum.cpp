@@ -32,6 +32,9 @@
 #include "Magnum/PixelFormat.h"
 #include "Magnum/VertexFormat.h"
 #ifdef MAGNUM_TARGET_GL
+#include <mutex>
+#include <unordered_map>
+
 #include "Magnum/ResourceManager.h"
 #include "Magnum/GL/AbstractShaderProgram.h"
 #include "Magnum/GL/Mesh.h"
@@ -65,6 +68,50 @@ class MeshResourceLoader: public AbstractResourceLoader<GL::Mesh> {
     }
 };
 /* [AbstractResourceLoader-implementation] */
+
+GL::Mesh uploadMesh(const Containers::Array<char>&) { return GL::Mesh{}; }
+Containers::Array<char> parseMeshFile(ResourceKey) { return {}; }
+
+/* [AbstractResourceLoader-async] */
+class AsyncMeshResourceLoader: public AbstractResourceLoader<GL::Mesh> {
+    public:
+        explicit AsyncMeshResourceLoader() {
+            setWorkerThreadCount(4);
+        }
+
+        ~AsyncMeshResourceLoader() {
+            // Stop the workers before the subclass state goes away
+            setWorkerThreadCount(0);
+        }
+
+    private:
+        // Called on a worker thread, parse the file there
+        void doLoad(ResourceKey key) override {
+            Containers::Array<char> data = parseMeshFile(key);
+            {
+                std::lock_guard<std::mutex> lock{_mutex};
+                _parsed.emplace(key, std::move(data));
+            }
+            finishOnMainThread(key);
+        }
+
+        // Called from ResourceManager::update() on the main thread, upload
+        // the parsed data to the GPU
+        void doFinish(ResourceKey key) override {
+            Containers::Array<char> data;
+            {
+                std::lock_guard<std::mutex> lock{_mutex};
+                auto found = _parsed.find(key);
+                data = std::move(found->second);
+                _parsed.erase(found);
+            }
+            set(key, uploadMesh(data));
+        }
+
+        std::mutex _mutex;
+        std::unordered_map<ResourceKey, Containers::Array<char>> _parsed;
+};
+/* [AbstractResourceLoader-async] */
 }
 #endif
 
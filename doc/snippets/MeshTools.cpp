@@ -34,6 +34,7 @@
 #include "Magnum/MeshTools/FlipNormals.h"
 #include "Magnum/MeshTools/GenerateNormals.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/MeshDataCache.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Transform.h"
 #include "Magnum/Primitives/Cube.h"
@@ -152,6 +153,21 @@ Trade::MeshData indexed{data.primitive(),
 /* [interleavedLayout-indices] */
 }
 
+{
+Trade::MeshData mesh{MeshPrimitive::Points, 0};
+/* [MeshDataCache] */
+MeshTools::MeshDataCache cache{mesh};
+
+/* Positions get converted to a Vector3 array just once, on the first call */
+Containers::Pair<Vector3, Vector3> bounds = Math::minmax(cache.positions3D());
+Vector3 center = (bounds.first() + bounds.second())*0.5f;
+Float radius = 0.0f;
+for(const Vector3& position: cache.positions3D())
+    radius = Math::max(radius, (position - center).length());
+/* [MeshDataCache] */
+static_cast<void>(radius);
+}
+
 {
 /* [removeDuplicates] */
 Containers::ArrayView<Vector3i> data;
@@ -28,17 +28,22 @@
 #define CORRADE_STATIC_PLUGIN
 
 #include <string> /** @todo drop when file callbacks are <string>-free */
+#include <thread>
 #include <unordered_map>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Pair.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/Containers/StringStl.h> /** @todo drop when file callbacks are <string>-free */
 #include <Corrade/Utility/Macros.h> /* CORRADE_LINE_STRING */
+#include <Corrade/Utility/Path.h>
 #include <Corrade/Utility/Resource.h>
 
 #include "Magnum/FileCallback.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/ShaderTools/AbstractConverter.h"
+#include "Magnum/ShaderTools/BatchConverter.h"
 #include "Magnum/ShaderTools/Stage.h"
 
 #define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
@@ -194,4 +199,34 @@ converter->setInputFileCallback([](const std::string& filename,
 /* [AbstractConverter-setInputFileCallback-template] */
 }
 
+{
+/* [BatchConverter-usage] */
+PluginManager::Manager<ShaderTools::AbstractConverter> manager;
+
+/* One converter instance for each thread, all set up the same way */
+Containers::Array<Containers::Pointer<ShaderTools::AbstractConverter>> converters;
+for(UnsignedInt i = 0; i != Math::max(std::thread::hardware_concurrency(), 1u); ++i) {
+    Containers::Pointer<ShaderTools::AbstractConverter> converter =
+        manager.loadAndInstantiate("GlslangShaderConverter");
+    converter->setOutputFormat(ShaderTools::Format::Spirv, "vulkan1.1");
+    arrayAppend(converters, Utility::move(converter));
+}
+
+ShaderTools::BatchConverter batch{Utility::move(converters)};
+batch.setCacheDirectory("shader-cache");
+
+Containers::ArrayView<const char> source = DOXYGEN_ELLIPSIS({});
+UnsignedInt plain = batch.addJob(ShaderTools::Stage::Fragment, source);
+UnsignedInt textured = batch.addJob(ShaderTools::Stage::Fragment, source, {
+    {"DIFFUSE_TEXTURE", ""},
+    {"NORMAL_TEXTURE", ""}
+});
+if(!batch.convert())
+    Fatal{} << "Some permutations failed to compile";
+
+Utility::Path::write("phong.frag.spv", *batch.output(plain));
+Utility::Path::write("phong-textured.frag.spv", *batch.output(textured));
+/* [BatchConverter-usage] */
+}
+
 }
@@ -27,8 +27,10 @@
    affect anything else. */
 #define CORRADE_STATIC_PLUGIN
 
+#include <thread>
 #include <unordered_map>
 #include <Corrade/Containers/ArrayTuple.h>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StringIterable.h>
 #include <Corrade/Containers/StringStl.h> /** @todo remove once file callbacks are <string>-free */
@@ -247,6 +249,33 @@ importer->openFile("scene.gltf"); // memory-maps all files
 }
 #endif
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+{
+PluginManager::Manager<Trade::AbstractImporter> manager;
+/* [AbstractImporter-usage-concurrent] */
+Containers::Pointer<Trade::AbstractImporter> importer =
+    manager.loadAndInstantiate("AnySceneImporter");
+if(!importer || !importer->openFile("scene.obj"))
+    Fatal{} << "Can't open scene.obj with AnySceneImporter";
+
+Containers::Array<Containers::Optional<Trade::MeshData>> meshes{
+    importer->meshCount()};
+if(importer->features() & Trade::ImporterFeature::ConcurrentDataAccess) {
+    /* Each thread imports every threadCount-th mesh */
+    const UnsignedInt threadCount = std::thread::hardware_concurrency();
+    Containers::Array<std::thread> threads;
+    for(UnsignedInt i = 0; i != threadCount; ++i)
+        arrayAppend(threads, InPlaceInit, [&](UnsignedInt first) {
+            for(UnsignedInt j = first; j < meshes.size(); j += threadCount)
+                meshes[j] = importer->mesh(j);
+        }, i);
+    for(std::thread& thread: threads) thread.join();
+} else for(UnsignedInt i = 0; i != meshes.size(); ++i)
+    meshes[i] = importer->mesh(i);
+/* [AbstractImporter-usage-concurrent] */
+}
+#endif
+
 {
 /* -Wnonnull in GCC 11+  "helpfully" says "this is null" if I don't initialize
    the converter pointer. I don't care, I just want you to check compilation
@@ -377,6 +406,23 @@ if(!converter->addSupportedImporterContents(*importer, ~Trade::SceneContent::Mes
 /* [AbstractSceneConverter-usage-multiple-file-selective] */
 }
 
+{
+PluginManager::Manager<Trade::AbstractSceneConverter> manager;
+Containers::Pointer<Trade::AbstractImporter> importer;
+/* [AbstractSceneConverter-usage-multiple-streaming] */
+Containers::Pointer<Trade::AbstractSceneConverter> converter =
+    manager.loadAndInstantiate("MagnumSceneConverter");
+if(!(converter->features() & Trade::SceneConverterFeature::StreamToFile))
+    Warning{} << "The whole output will be kept in memory";
+
+/* Each image and mesh is imported, written to the file and freed again */
+if(!converter->beginFile("huge.blob") ||
+   !converter->addImporterContents(*importer) ||
+   !converter->endFile())
+    Fatal{} << "Can't save huge.blob";
+/* [AbstractSceneConverter-usage-multiple-streaming] */
+}
+
 {
 UnsignedInt id{};
 Containers::Pointer<Trade::AbstractImporter> importer;
@@ -51,23 +51,34 @@
 #include "Magnum/Vk/ExtensionProperties.h"
 #include "Magnum/Vk/FenceCreateInfo.h"
 #include "Magnum/Vk/FramebufferCreateInfo.h"
+#include "Magnum/Vk/FrameDescriptorAllocator.h"
+#include "Magnum/Vk/FramePacer.h"
 #include "Magnum/Vk/InstanceCreateInfo.h"
 #include "Magnum/Vk/Integration.h"
 #include "Magnum/Vk/ImageCreateInfo.h"
 #include "Magnum/Vk/ImageViewCreateInfo.h"
 #include "Magnum/Vk/LayerProperties.h"
+#include "Magnum/Vk/LayoutCache.h"
 #include "Magnum/Vk/MemoryAllocateInfo.h"
+#include "Magnum/Vk/MemoryAllocator.h"
 #include "Magnum/Vk/Mesh.h"
 #include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/PipelineCacheCreateInfo.h"
 #include "Magnum/Vk/PipelineLayoutCreateInfo.h"
 #include "Magnum/Vk/PixelFormat.h"
+#include "Magnum/Vk/QueryPoolCreateInfo.h"
 #include "Magnum/Vk/Queue.h"
 #include "Magnum/Vk/RasterizationPipelineCreateInfo.h"
+#include "Magnum/Vk/RenderGraph.h"
 #include "Magnum/Vk/RenderPassCreateInfo.h"
 #include "Magnum/Vk/Result.h"
 #include "Magnum/Vk/SamplerCreateInfo.h"
+#include "Magnum/Vk/SemaphoreCreateInfo.h"
 #include "Magnum/Vk/ShaderCreateInfo.h"
+#include "Magnum/Vk/ShaderReflection.h"
 #include "Magnum/Vk/ShaderSet.h"
+#include "Magnum/Vk/ThreadCommandPools.h"
+#include "Magnum/Vk/Uploader.h"
 #include "MagnumExternal/Vulkan/flextVkGlobal.h"
 
 /* [wrapping-include-createinfo] */
@@ -321,6 +332,27 @@ fence.wait();
 /* [CommandBuffer-usage-submit] */
 }
 
+{
+Vk::RenderPass renderPass{NoCreate};
+Vk::Framebuffer framebuffer{NoCreate};
+/* [CommandBuffer-usage-secondary] */
+Vk::CommandPool pool{DOXYGEN_ELLIPSIS(NoCreate)};
+Vk::CommandBuffer secondary = pool.allocate(Vk::CommandBufferLevel::Secondary);
+secondary.begin(Vk::CommandBufferBeginInfo{
+        Vk::CommandBufferInheritanceInfo{renderPass, 0, framebuffer}})
+    DOXYGEN_ELLIPSIS()
+    .end();
+
+Vk::CommandBuffer cmd = pool.allocate();
+cmd.begin()
+   .beginRenderPass(Vk::RenderPassBeginInfo{renderPass, framebuffer},
+        Vk::SubpassBeginInfo{Vk::SubpassContents::SecondaryCommandBuffers})
+   .executeCommands({secondary})
+   .endRenderPass()
+   .end();
+/* [CommandBuffer-usage-secondary] */
+}
+
 {
 Vk::Device device{NoCreate};
 /* The include should be a no-op here since it was already included above */
@@ -908,6 +940,65 @@ indices.bindMemory(memory, indicesOffset);
 /* [Memory-mapping] */
 }
 
+{
+Vk::Device device{NoCreate};
+/* [MemoryAllocator-usage] */
+Vk::MemoryAllocator allocator{device};
+
+/* Both buffers get sub-allocated from the same memory block */
+Vk::Buffer vertices{device,
+    Vk::BufferCreateInfo{Vk::BufferUsage::VertexBuffer, 64*1024},
+    allocator, Vk::MemoryFlag::DeviceLocal};
+Vk::Buffer indices{device,
+    Vk::BufferCreateInfo{Vk::BufferUsage::IndexBuffer, 16*1024},
+    allocator, Vk::MemoryFlag::DeviceLocal};
+/* [MemoryAllocator-usage] */
+}
+
+{
+Vk::Device device{NoCreate};
+Vk::MemoryAllocator allocator{NoCreate};
+Containers::ArrayView<const char> data;
+/* [MemoryAllocator-allocate] */
+Vk::Buffer buffer{device,
+    Vk::BufferCreateInfo{Vk::BufferUsage::UniformBuffer, data.size()},
+    NoAllocate};
+
+Vk::MemoryAllocation allocation = allocator.allocate(
+    buffer.memoryRequirements(), Vk::MemoryFlag::HostVisible,
+    Vk::MemoryFlag::HostCoherent);
+buffer.bindMemory(allocation.memory(), allocation.offset());
+
+/* Host-visible memory is persistently mapped */
+Utility::copy(data, allocation.mappedData().prefix(data.size()));
+/* [MemoryAllocator-allocate] */
+}
+
+{
+Vk::Device device{NoCreate};
+Containers::ArrayView<const char> uniformData;
+/* [MemoryArena-usage] */
+Vk::MemoryArena arena{device, 1024*1024,
+    Vk::MemoryFlag::HostVisible|Vk::MemoryFlag::HostCoherent};
+
+/* Every frame, after waiting for the GPU to finish with the previous
+   contents of the arena */
+arena.reset();
+
+Vk::Buffer uniforms{device,
+    Vk::BufferCreateInfo{Vk::BufferUsage::UniformBuffer, uniformData.size()},
+    NoAllocate};
+Containers::Optional<UnsignedLong> offset =
+    arena.allocate(uniforms.memoryRequirements());
+if(!offset) {
+    // The arena is full
+}
+uniforms.bindMemory(arena.memory(), *offset);
+Utility::copy(uniformData,
+    arena.mappedData().sliceSize(*offset, uniformData.size()));
+/* [MemoryArena-usage] */
+}
+
 {
 /* [MeshLayout-usage] */
 constexpr UnsignedInt Binding = 0;
@@ -1105,6 +1196,43 @@ cmd.bindPipeline(pipeline);
 /* [Pipeline-usage] */
 }
 
+{
+Vk::Device device{NoCreate};
+/* The include should be a no-op here since it was already included above */
+/* [PipelineCache-creation] */
+#include <Magnum/Vk/PipelineCacheCreateInfo.h>
+
+DOXYGEN_ELLIPSIS()
+
+/* Discard the data if the driver or device changed since the last run */
+Containers::Optional<Containers::Array<char>> data =
+    Utility::Path::read("pipeline.cache");
+if(data && !Vk::PipelineCache::isDataCompatible(device.properties(), *data))
+    data = {};
+
+Vk::PipelineCache cache{device, Vk::PipelineCacheCreateInfo{
+    data ? Containers::ArrayView<const void>{*data} : nullptr
+}};
+/* [PipelineCache-creation] */
+}
+
+{
+Vk::Device device{NoCreate};
+Vk::PipelineCache cache{NoCreate};
+/* [PipelineCache-usage] */
+Vk::ShaderSet shaderSet{DOXYGEN_ELLIPSIS()};
+Vk::PipelineLayout pipelineLayout{DOXYGEN_ELLIPSIS(NoCreate)};
+
+Vk::Pipeline pipeline{device, Vk::ComputePipelineCreateInfo{
+    shaderSet, pipelineLayout
+}, cache};
+
+DOXYGEN_ELLIPSIS()
+
+Utility::Path::write("pipeline.cache", cache.data());
+/* [PipelineCache-usage] */
+}
+
 {
 Vk::Device device{NoCreate};
 /* The include should be a no-op here since it was already included above */
@@ -1123,6 +1251,43 @@ Vk::PipelineLayout{device, Vk::PipelineLayoutCreateInfo{
 /* [PipelineLayout-creation] */
 }
 
+{
+Vk::Device device{NoCreate};
+/* The include should be a no-op here since it was already included above */
+/* [QueryPool-creation] */
+#include <Magnum/Vk/QueryPoolCreateInfo.h>
+
+DOXYGEN_ELLIPSIS()
+
+Vk::QueryPool timestamps{device, Vk::QueryPoolCreateInfo{
+    Vk::QueryType::Timestamp, 2}};
+Vk::QueryPool statistics{device, Vk::QueryPoolCreateInfo{
+    Vk::QueryPipelineStatistic::InputAssemblyVertices|
+    Vk::QueryPipelineStatistic::VertexShaderInvocations, 1}};
+/* [QueryPool-creation] */
+}
+
+{
+Vk::Device device{NoCreate};
+Vk::QueryPool pool{NoCreate};
+Vk::CommandBuffer cmd{NoCreate};
+/* [QueryPool-usage] */
+cmd.resetQueryPool(pool, 0, 2)
+   .writeTimestamp(Vk::PipelineStage::TopOfPipe, pool, 0)
+   DOXYGEN_ELLIPSIS()
+   .writeTimestamp(Vk::PipelineStage::BottomOfPipe, pool, 1);
+
+DOXYGEN_ELLIPSIS()
+
+/* Once the command buffer is submitted and executed */
+UnsignedLong timestamps[2];
+pool.results(0, 2, timestamps, Vk::QueryResultFlag::Wait);
+Double nanoseconds = (timestamps[1] - timestamps[0])*Double(
+    device.properties().properties().properties.limits.timestampPeriod);
+/* [QueryPool-usage] */
+static_cast<void>(nanoseconds);
+}
+
 {
 Vk::Device device{NoCreate};
 /* The include should be a no-op here since it was already included above */
@@ -1208,6 +1373,20 @@ Vk::Sampler sampler{device, Vk::SamplerCreateInfo{}
 /* [Sampler-creation-linear] */
 }
 
+{
+Vk::Device device{NoCreate};
+/* The include should be a no-op here since it was already included above */
+/* [Semaphore-creation] */
+#include <Magnum/Vk/SemaphoreCreateInfo.h>
+
+DOXYGEN_ELLIPSIS()
+
+Vk::Semaphore binary{device};
+Vk::Semaphore timeline{device, Vk::SemaphoreCreateInfo{
+    Vk::SemaphoreCreateInfo::Type::Timeline, 1}};
+/* [Semaphore-creation] */
+}
+
 {
 Vk::Device device{NoCreate};
 /* The include should be a no-op here since it was already included above */
@@ -1257,6 +1436,210 @@ set.addShader(Vk::ShaderStage::Vertex, shader, "vert"_s)
 /* [ShaderSet-usage-ownership-transfer] */
 }
 
+{
+Vk::Device device{NoCreate};
+UnsignedInt threadCount{}, threadId{};
+/* [ThreadCommandPools-usage] */
+Vk::ThreadCommandPools pools{device, Vk::CommandPoolCreateInfo{
+    device.properties().pickQueueFamily(Vk::QueueFlag::Graphics)},
+    threadCount, 2};
+Vk::Fence frameFences[2]{DOXYGEN_ELLIPSIS(Vk::Fence{NoCreate}, Vk::Fence{NoCreate})};
+
+/* In each worker thread */
+Vk::CommandBuffer cmd = pools.pool(threadId)
+    .allocate(Vk::CommandBufferLevel::Secondary);
+DOXYGEN_ELLIPSIS()
+
+/* On the main thread at the start of each frame, wait until the GPU is done
+   with the pools of the upcoming frame, then recycle them */
+frameFences[(pools.frame() + 1) % pools.frameCount()].wait();
+pools.nextFrame();
+/* [ThreadCommandPools-usage] */
+}
+
+{
+Vk::Device device{NoCreate};
+Vk::DescriptorSetLayout layout{NoCreate};
+Vk::Buffer uniforms{NoCreate};
+Vk::ImageView view{NoCreate};
+Vk::Sampler sampler{NoCreate};
+UnsignedLong drawOffset{};
+/* [FrameDescriptorAllocator-usage] */
+Vk::FrameDescriptorAllocator descriptors{device, 2, 64, {
+    {Vk::DescriptorType::UniformBuffer, 64},
+    {Vk::DescriptorType::CombinedImageSampler, 64}
+}};
+Vk::Fence frameFences[2]{DOXYGEN_ELLIPSIS(Vk::Fence{NoCreate}, Vk::Fence{NoCreate})};
+
+/* At the start of each frame, wait until the GPU is done with the pools of
+   the upcoming frame, then recycle them */
+descriptors.nextFrame(frameFences[(descriptors.frame() + 1) % descriptors.frameCount()]);
+
+/* For each draw. If the same combination was already written in this frame,
+   the existing set is returned. */
+VkDescriptorSet set = descriptors.allocate(layout, {
+    Vk::DescriptorWrite{0, Vk::DescriptorType::UniformBuffer, uniforms,
+        drawOffset, 256},
+    Vk::DescriptorWrite{1, Vk::DescriptorType::CombinedImageSampler, view,
+        Vk::ImageLayout::ShaderReadOnly, sampler}
+});
+DOXYGEN_ELLIPSIS(static_cast<void>(set);)
+/* [FrameDescriptorAllocator-usage] */
+}
+
+{
+Vk::Device device{NoCreate};
+Vk::Queue queue{NoCreate};
+Vk::ThreadCommandPools pools{NoCreate};
+Vk::FrameDescriptorAllocator descriptors{NoCreate};
+bool running{};
+/* [FramePacer-usage] */
+Vk::FramePacer pacer{device, 2};
+
+while(running) {
+    /* Wait until the GPU is done with frame n - 2, then recycle its
+       resources */
+    pacer.beginFrame();
+    pools.nextFrame();
+    descriptors.nextFrame();
+
+    Vk::CommandBuffer cmd = pools.pool(0).allocate();
+    DOXYGEN_ELLIPSIS()
+
+    /* The last submit of the frame signals the frame number */
+    queue.submit({Vk::SubmitInfo{}
+        .setCommandBuffers({cmd})
+        .setSignalSemaphores({pacer.signalSemaphore()})
+    }, {});
+}
+
+/* Wait for all frames in flight to finish before destroying anything */
+pacer.waitIdle();
+/* [FramePacer-usage] */
+}
+
+{
+Vk::Device device{NoCreate};
+Vk::Queue queue{NoCreate};
+Containers::ArrayView<const char> vertexData, pixels;
+/* [Uploader-usage] */
+Vk::Uploader uploader{device, queue,
+    device.properties().pickQueueFamily(Vk::QueueFlag::Graphics)};
+
+Vk::Buffer vertices{device, Vk::BufferCreateInfo{
+    Vk::BufferUsage::VertexBuffer|Vk::BufferUsage::TransferDestination,
+    vertexData.size()
+}, Vk::MemoryFlag::DeviceLocal};
+Vk::Image texture{device, Vk::ImageCreateInfo2D{
+    Vk::ImageUsage::Sampled|Vk::ImageUsage::TransferDestination,
+    PixelFormat::RGBA8Srgb, {256, 256}, 1
+}, Vk::MemoryFlag::DeviceLocal};
+
+/* Copy the data to the staging buffer and record the transfers */
+uploader
+    .uploadBuffer(vertices, 0, vertexData)
+    .uploadImage(texture, Vk::ImageLayout::ShaderReadOnly,
+        Vk::BufferImageCopy2D{0, Vk::ImageAspect::Color, 0, {{}, {256, 256}}},
+        pixels);
+
+/* Submit all of them in a single command buffer */
+uploader.submit();
+/* [Uploader-usage] */
+}
+
+{
+Vk::Device device{NoCreate};
+Vk::CommandBuffer cmd{NoCreate};
+VkImage outputImage{};
+/* [RenderGraph-usage] */
+Vk::RenderGraph graph{device};
+UnsignedInt output = graph.importImage("output", outputImage,
+    Vk::ImageAspect::Color, Vk::ImageLayout::Undefined,
+    Vk::ImageLayout::ShaderReadOnly);
+UnsignedInt hdr = graph.addImage("hdr", Vk::ImageCreateInfo2D{
+    Vk::ImageUsage::ColorAttachment, Vk::PixelFormat::RGBA16F, {1920, 1080}, 1
+}, Vk::ImageAspect::Color);
+
+UnsignedInt scene = graph.addPass("scene",
+    [](const Vk::RenderGraph&, Vk::CommandBuffer&, void*) {
+        /* record draws into the command buffer */
+        DOXYGEN_ELLIPSIS()
+    });
+graph.addWrite(scene, hdr, Vk::RenderGraphUsage::ColorAttachment);
+
+UnsignedInt tonemap = graph.addPass("tonemap",
+    [](const Vk::RenderGraph&, Vk::CommandBuffer&, void*) {
+        /* record draws into the command buffer */
+        DOXYGEN_ELLIPSIS()
+    });
+graph.addRead(tonemap, hdr, Vk::RenderGraphUsage::Sampled)
+     .addWrite(tonemap, output, Vk::RenderGraphUsage::ColorAttachment);
+
+graph.compile();
+
+/* Every frame */
+graph.execute(cmd);
+/* [RenderGraph-usage] */
+}
+
+{
+Vk::Device device{NoCreate};
+Containers::ArrayView<const char> vertCode, fragCode;
+/* [ShaderReflection-usage] */
+Vk::ShaderReflection reflection;
+CORRADE_INTERNAL_ASSERT_OUTPUT(reflection.addShader(
+    Vk::ShaderStage::Vertex, vertCode, "main"));
+CORRADE_INTERNAL_ASSERT_OUTPUT(reflection.addShader(
+    Vk::ShaderStage::Fragment, fragCode, "main"));
+
+/* Create the layouts through a cache that's shared by all pipelines */
+Vk::LayoutCache layouts{device};
+VkPipelineLayout pipelineLayout = layouts.pipelineLayout(reflection);
+
+/* Use the reflected vertex inputs for the pipeline as well */
+Vk::MeshLayout meshLayout = reflection.meshLayout(MeshPrimitive::Triangles);
+/* [ShaderReflection-usage] */
+static_cast<void>(pipelineLayout);
+static_cast<void>(meshLayout);
+
+/* [ShaderReflection-usage-dynamic] */
+for(Vk::ShaderReflection::Binding& binding: reflection.bindings()) {
+    /* Per-draw uniforms in set 1 are bound with a dynamic offset */
+    if(binding.set == 1 && binding.type == Vk::DescriptorType::UniformBuffer)
+        binding.type = Vk::DescriptorType::UniformBufferDynamic;
+
+    /* A bindless texture array with an upper bound of 1024 */
+    if(binding.set == 2 && binding.count == 0) {
+        binding.count = 1024;
+        binding.flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT|
+                        VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT;
+    }
+}
+/* [ShaderReflection-usage-dynamic] */
+}
+
+{
+Vk::Device device{NoCreate};
+Vk::ShaderReflection reflection;
+/* [LayoutCache-usage] */
+Vk::LayoutCache layouts{device};
+
+/* Pipelines sharing the same resource interface get the same layouts */
+VkPipelineLayout a = layouts.pipelineLayout(reflection);
+VkPipelineLayout b = layouts.pipelineLayout(reflection);
+CORRADE_INTERNAL_ASSERT(a == b);
+
+/* Layouts can be also looked up from explicitly filled create infos */
+VkDescriptorSetLayout set = layouts.descriptorSetLayout(
+    Vk::DescriptorSetLayoutCreateInfo{
+        {{0, Vk::DescriptorType::UniformBuffer}},
+        {{1, Vk::DescriptorType::CombinedImageSampler}}
+    });
+VkPipelineLayout c = layouts.pipelineLayout(Vk::PipelineLayoutCreateInfo{set});
+/* [LayoutCache-usage] */
+static_cast<void>(c);
+}
+
 {
 /* [Integration] */
 VkOffset2D a{64, 32};
@@ -87,6 +87,8 @@
 #  VulkanTester                 - VulkanTester class
 #  MagnumFont                   - Magnum bitmap font plugin
 #  MagnumFontConverter          - Magnum bitmap font converter plugin
+#  MagnumImporter               - Magnum blob importer plugin
+#  MagnumSceneConverter         - Magnum blob scene converter plugin
 #  ObjImporter                  - OBJ importer plugin
 #  TgaImageConverter            - TGA image converter plugin
 #  TgaImporter                  - TGA importer plugin
@@ -377,6 +379,14 @@ if(NOT TARGET Magnum::Magnum)
     # Dependent libraries
     set_property(TARGET Magnum::Magnum APPEND PROPERTY INTERFACE_LINK_LIBRARIES
          Corrade::Utility)
+
+    # AbstractResourceLoader uses std::thread
+    if(NOT CORRADE_TARGET_EMSCRIPTEN)
+        set(THREADS_PREFER_PTHREAD_FLAG TRUE)
+        find_package(Threads REQUIRED)
+        set_property(TARGET Magnum::Magnum APPEND PROPERTY INTERFACE_LINK_LIBRARIES
+            Threads::Threads)
+    endif()
 else()
     set(MAGNUM_LIBRARY Magnum::Magnum)
 endif()
@@ -389,8 +399,8 @@ set(_MAGNUM_LIBRARY_COMPONENTS
     WindowlessEglApplication EglContext OpenGLTester)
 set(_MAGNUM_PLUGIN_COMPONENTS
     AnyAudioImporter AnyImageConverter AnyImageImporter AnySceneConverter
-    AnySceneImporter MagnumFont MagnumFontConverter ObjImporter
-    TgaImageConverter TgaImporter WavAudioImporter)
+    AnySceneImporter MagnumFont MagnumFontConverter MagnumImporter
+    MagnumSceneConverter ObjImporter TgaImageConverter TgaImporter WavAudioImporter)
 set(_MAGNUM_EXECUTABLE_COMPONENTS
     imageconverter sceneconverter shaderconverter gl-info al-info)
 # Audio and Vk libs aren't enabled by default, and none of the Context,
@@ -448,6 +458,9 @@ if(MAGNUM_TARGET_GL)
     set(_MAGNUM_DebugTools_Shaders_DEPENDENCY_IS_OPTIONAL ON)
     set(_MAGNUM_DebugTools_GL_DEPENDENCY_IS_OPTIONAL ON)
 endif()
+if(MAGNUM_TARGET_VK)
+    list(APPEND _MAGNUM_DebugTools_DEPENDENCIES Vk)
+endif()
 
 set(_MAGNUM_MaterialTools_DEPENDENCIES Trade)
 
@@ -455,6 +468,9 @@ set(_MAGNUM_MeshTools_DEPENDENCIES Trade)
 if(MAGNUM_TARGET_GL)
     list(APPEND _MAGNUM_MeshTools_DEPENDENCIES GL)
 endif()
+if(MAGNUM_TARGET_VK)
+    list(APPEND _MAGNUM_MeshTools_DEPENDENCIES Vk)
+endif()
 
 set(_MAGNUM_OpenGLTester_DEPENDENCIES GL)
 if(MAGNUM_TARGET_EGL)
@@ -976,6 +992,8 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         # No special setup for AnySceneImporter plugin
         # No special setup for MagnumFont plugin
         # No special setup for MagnumFontConverter plugin
+        # No special setup for MagnumImporter plugin
+        # No special setup for MagnumSceneConverter plugin
         # No special setup for ObjImporter plugin
         # No special setup for TgaImageConverter plugin
         # No special setup for TgaImporter plugin
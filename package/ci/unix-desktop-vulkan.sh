@@ -56,6 +56,8 @@ cmake .. \
     -DMAGNUM_WITH_ANYSHADERCONVERTER=OFF \
     -DMAGNUM_WITH_MAGNUMFONT=OFF \
     -DMAGNUM_WITH_MAGNUMFONTCONVERTER=OFF \
+    -DMAGNUM_WITH_MAGNUMIMPORTER=OFF \
+    -DMAGNUM_WITH_MAGNUMSCENECONVERTER=OFF \
     -DMAGNUM_WITH_OBJIMPORTER=OFF \
     -DMAGNUM_WITH_TGAIMAGECONVERTER=OFF \
     -DMAGNUM_WITH_TGAIMPORTER=ON \
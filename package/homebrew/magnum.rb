@@ -45,6 +45,8 @@ class Magnum < Formula
         "-DMAGNUM_WITH_ANYSHADERCONVERTER=ON",
         "-D#{option_prefix}WITH_MAGNUMFONT=ON",
         "-D#{option_prefix}WITH_MAGNUMFONTCONVERTER=ON",
+        "-D#{option_prefix}WITH_MAGNUMIMPORTER=ON",
+        "-D#{option_prefix}WITH_MAGNUMSCENECONVERTER=ON",
         "-D#{option_prefix}WITH_OBJIMPORTER=ON",
         "-D#{option_prefix}WITH_TGAIMAGECONVERTER=ON",
         "-D#{option_prefix}WITH_TGAIMPORTER=ON",
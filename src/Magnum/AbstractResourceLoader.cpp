@@ -0,0 +1,194 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AbstractResourceLoader.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional> /* std::ref */
+#include <mutex>
+#include <thread>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Macros.h> /* CORRADE_THREAD_LOCAL */
+
+namespace Magnum { namespace Implementation {
+
+namespace {
+
+struct CompletionNode {
+    ResourceLoaderCompletion completion;
+    CompletionNode* next;
+};
+
+/* Set for each worker thread to the pool it belongs to */
+CORRADE_THREAD_LOCAL ResourceLoaderWorkers* currentWorkers = nullptr;
+
+}
+
+struct ResourceLoaderWorkers::State {
+    void(*load)(void*, ResourceKey);
+    void(*deleter)(void*);
+    void* state;
+
+    /* Job queue, guarded by the mutex. Jobs are taken from the front, once
+       the queue is empty it's cleared to reuse the memory. */
+    std::mutex mutex;
+    std::condition_variable jobAvailable, jobsDone;
+    Containers::Array<ResourceKey> jobs;
+    std::size_t jobOffset{};
+    std::size_t jobsRunning{};
+    bool stop{};
+
+    /* Count of jobs that were submitted but didn't finish yet, and count of
+       results that weren't retrieved with next() yet. Atomic to be able to
+       query pendingCount() without locking. */
+    std::atomic<std::size_t> jobsPending{}, completionsPending{};
+
+    /* Completed results. Workers push to a lock-free stack, the consumer
+       takes the whole stack at once and puts it into a FIFO in the order the
+       results were pushed. */
+    std::atomic<CompletionNode*> completed{};
+    Containers::Array<CompletionNode*> ready;
+    std::size_t readyOffset{};
+
+    Containers::Array<std::thread> threads;
+};
+
+ResourceLoaderWorkers::ResourceLoaderWorkers(const UnsignedInt threadCount, void(*const load)(void*, ResourceKey), void(*const deleter)(void*), void* const state): _state{InPlaceInit} {
+    _state->load = load;
+    _state->deleter = deleter;
+    _state->state = state;
+
+    arrayReserve(_state->threads, threadCount);
+    for(UnsignedInt i = 0; i != threadCount; ++i) arrayAppend(_state->threads, InPlaceInit, [](ResourceLoaderWorkers& self) {
+        currentWorkers = &self;
+        State& state = *self._state;
+        for(;;) {
+            ResourceKey key;
+            {
+                std::unique_lock<std::mutex> lock{state.mutex};
+                state.jobAvailable.wait(lock, [&state]{
+                    return state.stop || state.jobOffset != state.jobs.size();
+                });
+                /* Stop only once there's no more work */
+                if(state.jobOffset == state.jobs.size()) return;
+
+                key = state.jobs[state.jobOffset++];
+                if(state.jobOffset == state.jobs.size()) {
+                    arrayResize(state.jobs, 0);
+                    state.jobOffset = 0;
+                }
+                ++state.jobsRunning;
+            }
+
+            state.load(state.state, key);
+
+            {
+                std::unique_lock<std::mutex> lock{state.mutex};
+                --state.jobsRunning;
+                --state.jobsPending;
+                if(!state.jobsRunning && state.jobOffset == state.jobs.size())
+                    state.jobsDone.notify_all();
+            }
+        }
+    }, std::ref(*this));
+}
+
+ResourceLoaderWorkers::~ResourceLoaderWorkers() {
+    {
+        std::unique_lock<std::mutex> lock{_state->mutex};
+        _state->stop = true;
+    }
+    _state->jobAvailable.notify_all();
+    for(std::thread& thread: _state->threads) thread.join();
+
+    /* Delete data of results that nobody retrieved */
+    ResourceLoaderCompletion completion;
+    while(next(completion)) _state->deleter(completion.data);
+}
+
+UnsignedInt ResourceLoaderWorkers::threadCount() const {
+    return _state->threads.size();
+}
+
+bool ResourceLoaderWorkers::isWorkerThread() const {
+    return currentWorkers == this;
+}
+
+std::size_t ResourceLoaderWorkers::pendingCount() const {
+    return _state->jobsPending + _state->completionsPending;
+}
+
+void ResourceLoaderWorkers::submit(const ResourceKey key) {
+    {
+        std::unique_lock<std::mutex> lock{_state->mutex};
+        arrayAppend(_state->jobs, key);
+        ++_state->jobsPending;
+    }
+    _state->jobAvailable.notify_one();
+}
+
+void ResourceLoaderWorkers::complete(const ResourceLoaderCompletion& completion) {
+    /* Increment before publishing the node so pendingCount() doesn't go
+       temporarily to zero between the job finishing and next() */
+    ++_state->completionsPending;
+    CompletionNode* const node = new CompletionNode{completion, _state->completed.load(std::memory_order_relaxed)};
+    while(!_state->completed.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void ResourceLoaderWorkers::wait() {
+    std::unique_lock<std::mutex> lock{_state->mutex};
+    _state->jobsDone.wait(lock, [this]{
+        return !_state->jobsRunning && _state->jobOffset == _state->jobs.size();
+    });
+}
+
+bool ResourceLoaderWorkers::next(ResourceLoaderCompletion& out) {
+    State& state = *_state;
+
+    /* If everything in the FIFO was consumed, take whatever the workers
+       completed since. The stack has the newest result on top, so put it
+       into the FIFO in reverse. */
+    if(state.readyOffset == state.ready.size()) {
+        arrayResize(state.ready, 0);
+        state.readyOffset = 0;
+
+        CompletionNode* node = state.completed.exchange(nullptr, std::memory_order_acquire);
+        for(CompletionNode* i = node; i; i = i->next)
+            arrayAppend(state.ready, nullptr);
+        for(std::size_t i = state.ready.size(); i; --i, node = node->next)
+            state.ready[i - 1] = node;
+
+        if(state.ready.isEmpty()) return false;
+    }
+
+    CompletionNode* const node = state.ready[state.readyOffset++];
+    out = node->completion;
+    delete node;
+    --state.completionsPending;
+    return true;
+}
+
+}}
@@ -35,6 +35,8 @@
 
 namespace Magnum {
 
+namespace Implementation { class ResourceLoaderWorkers; }
+
 /**
 @brief Base for resource loaders
 
@@ -75,11 +77,52 @@ the following code, however, the loader destroys itself (and removes itself
 from the manager) before the manager is destroyed.
 
 @snippet Magnum.cpp AbstractResourceLoader-use
+
+@section AbstractResourceLoader-async Asynchronous loading on worker threads
+
+By default, @ref doLoad() is called directly from @ref load(), i.e. on the
+thread that called @ref ResourceManager::get(). If the loading is expensive,
+you can call @ref setWorkerThreadCount() to make the loader spawn a pool of
+worker threads and call @ref doLoad() on those instead. The resource stays in
+@ref ResourceState::Loading until the main thread calls
+@ref ResourceManager::update(), which passes the results of @ref set() and
+@ref setNotFound() calls done on the workers to the manager. The results are
+passed through a lock-free queue, so the workers never wait for the main
+thread.
+
+Because the resource manager itself is not thread-safe, @ref doLoad()
+shouldn't access it in any way when running on a worker thread, and neither
+should it touch any state that's not safe to be accessed from multiple
+threads at once, such as the OpenGL context. Work that has to be done on the
+main thread, such as GPU uploads, can be deferred with
+@ref finishOnMainThread(). The @ref doFinish() implementation is then called
+for given key from @ref ResourceManager::update() on the main thread, where it
+can call @ref set() directly. The data to be uploaded have to be stashed in
+the loader subclass in a thread-safe way in the meantime. To avoid frame time
+spikes, @ref ResourceManager::update() can be given a maximal count of results
+to process in a single call, with the rest postponed to the next call.
+
+@snippet Magnum.cpp AbstractResourceLoader-async
+
+When a loader with worker threads is destroyed by the manager, the threads
+are stopped and all pending results are processed before. If you destroy the
+loader yourself, call @cpp setWorkerThreadCount(0) @ce in the subclass
+destructor to ensure @ref doLoad() isn't called on a partially destroyed
+instance.
+
+On @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", worker threads are available
+only if the application is built with pthread support.
 */
 template<class T> class AbstractResourceLoader {
     public:
         explicit AbstractResourceLoader(): manager(nullptr), _requestedCount(0), _loadedCount(0), _notFoundCount(0) {}
 
+        /**
+         * @brief Destructor
+         *
+         * Expects that there are no worker threads running, see
+         * @ref AbstractResourceLoader-async for more information.
+         */
         virtual ~AbstractResourceLoader();
 
         /**
@@ -126,6 +169,41 @@ template<class T> class AbstractResourceLoader {
          */
         void load(ResourceKey key);
 
+        /**
+         * @brief Worker thread count
+         * @m_since_latest
+         *
+         * If @cpp 0 @ce, the resources are loaded synchronously from
+         * @ref load(). Default is @cpp 0 @ce.
+         * @see @ref AbstractResourceLoader-async
+         */
+        UnsignedInt workerThreadCount() const;
+
+        /**
+         * @brief Set worker thread count
+         * @m_since_latest
+         *
+         * If there are worker threads already running, waits until they
+         * process all requested resources, passes all results to the
+         * manager and stops them. Then, if @p count is non-zero, spawns
+         * @p count new worker threads that will call @ref doLoad() for all
+         * subsequent @ref load() calls. Expects to be called from the main
+         * thread, i.e. the thread on which the @ref ResourceManager is used.
+         * @see @ref AbstractResourceLoader-async
+         */
+        void setWorkerThreadCount(UnsignedInt count);
+
+        /**
+         * @brief Count of pending resources
+         * @m_since_latest
+         *
+         * Count of resources that are still being loaded on worker threads
+         * plus the count of results that are waiting to be passed to the
+         * manager with @ref ResourceManager::update(). Always @cpp 0 @ce if
+         * @ref workerThreadCount() is @cpp 0 @ce.
+         */
+        std::size_t pendingCount() const;
+
     protected:
         /**
          * @brief Set loaded resource to resource manager
@@ -187,6 +265,18 @@ template<class T> class AbstractResourceLoader {
             set(key, nullptr, ResourceDataState::NotFound, ResourcePolicy::Resident);
         }
 
+        /**
+         * @brief Finish loading on the main thread
+         * @m_since_latest
+         *
+         * If called from @ref doLoad() running on a worker thread, schedules
+         * a call to @ref doFinish() for @p key from the next
+         * @ref ResourceManager::update() on the main thread. Otherwise calls
+         * @ref doFinish() directly.
+         * @see @ref AbstractResourceLoader-async
+         */
+        void finishOnMainThread(ResourceKey key);
+
     #ifndef DOXYGEN_GENERATING_OUTPUT
     private:
     #else
@@ -206,32 +296,153 @@ template<class T> class AbstractResourceLoader {
          */
         virtual void doLoad(ResourceKey key) = 0;
 
+        /**
+         * @brief Finish loading on the main thread
+         * @m_since_latest
+         *
+         * Called on the main thread for keys passed to
+         * @ref finishOnMainThread(). The implementation is expected to call
+         * @ref set() or @ref setNotFound() for @p key. Default
+         * implementation expects to not be called.
+         * @see @ref AbstractResourceLoader-async
+         */
+        virtual void doFinish(ResourceKey key);
+
     private:
         #ifndef DOXYGEN_GENERATING_OUTPUT /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
         friend Implementation::ResourceManagerData<T>;
         #endif
 
+        /* Passes at most maxCount results from worker threads to the
+           manager, returns how many were passed */
+        std::size_t update(std::size_t maxCount);
+
         Implementation::ResourceManagerData<T>* manager;
         std::size_t _requestedCount,
             _loadedCount,
             _notFoundCount;
+        Containers::Pointer<Implementation::ResourceLoaderWorkers> _workers;
 };
 
+namespace Implementation {
+
+/* Type-erased worker pool and completion queue for AbstractResourceLoader,
+   implemented in AbstractResourceLoader.cpp to not need to include any
+   threading headers here */
+struct ResourceLoaderCompletion {
+    ResourceKey key;
+    void* data;
+    ResourceDataState state;
+    ResourcePolicy policy;
+    bool finish;
+};
+
+class MAGNUM_EXPORT ResourceLoaderWorkers {
+    public:
+        explicit ResourceLoaderWorkers(UnsignedInt threadCount, void(*load)(void*, ResourceKey), void(*deleter)(void*), void* state);
+
+        /* Waits for all submitted jobs and deletes data of results that
+           weren't retrieved with next() */
+        ~ResourceLoaderWorkers();
+
+        UnsignedInt threadCount() const;
+
+        /* Whether the current thread is one of the workers of this pool */
+        bool isWorkerThread() const;
+
+        std::size_t pendingCount() const;
+
+        void submit(ResourceKey key);
+
+        /* Lock-free, meant to be called from the workers */
+        void complete(const ResourceLoaderCompletion& completion);
+
+        /* Waits until all submitted jobs are processed */
+        void wait();
+
+        /* Retrieves next result in the order they were completed, returns
+           false if there's none. Meant to be called from a single thread. */
+        bool next(ResourceLoaderCompletion& out);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}
+
 template<class T> AbstractResourceLoader<T>::~AbstractResourceLoader() {
+    CORRADE_ASSERT(!_workers,
+        "AbstractResourceLoader: destroyed with worker threads still running, call setWorkerThreadCount(0) in the subclass destructor", );
     if(manager) manager->_loader = nullptr;
 }
 
+template<class T> UnsignedInt AbstractResourceLoader<T>::workerThreadCount() const {
+    return _workers ? _workers->threadCount() : 0;
+}
+
+template<class T> void AbstractResourceLoader<T>::setWorkerThreadCount(const UnsignedInt count) {
+    /* Finish everything that's in flight and pass it to the manager */
+    if(_workers) {
+        _workers->wait();
+        update(~std::size_t{});
+        _workers = nullptr;
+    }
+
+    if(count) _workers.emplace(count,
+        [](void* state, ResourceKey key) {
+            static_cast<AbstractResourceLoader<T>*>(state)->doLoad(key);
+        },
+        [](void* data) {
+            Implementation::safeDelete(static_cast<T*>(data));
+        }, this);
+}
+
+template<class T> std::size_t AbstractResourceLoader<T>::pendingCount() const {
+    return _workers ? _workers->pendingCount() : 0;
+}
+
 template<class T> std::string AbstractResourceLoader<T>::doName(ResourceKey) const { return {}; }
 
+template<class T> void AbstractResourceLoader<T>::doFinish(ResourceKey) {
+    CORRADE_ASSERT_UNREACHABLE("AbstractResourceLoader::finishOnMainThread(): doFinish() not implemented", );
+}
+
 template<class T> void AbstractResourceLoader<T>::load(ResourceKey key) {
     ++_requestedCount;
     /** @todo What policy for loading resources? */
     manager->set(key, nullptr, ResourceDataState::Loading, ResourcePolicy::Resident);
 
-    doLoad(key);
+    if(_workers) _workers->submit(key);
+    else doLoad(key);
+}
+
+template<class T> void AbstractResourceLoader<T>::finishOnMainThread(ResourceKey key) {
+    if(_workers && _workers->isWorkerThread())
+        _workers->complete({key, nullptr, ResourceDataState::Loading, ResourcePolicy::Resident, true});
+    else doFinish(key);
+}
+
+template<class T> std::size_t AbstractResourceLoader<T>::update(const std::size_t maxCount) {
+    std::size_t count = 0;
+    Implementation::ResourceLoaderCompletion completion;
+    while(_workers && count < maxCount && _workers->next(completion)) {
+        if(completion.finish) doFinish(completion.key);
+        else set(completion.key, static_cast<T*>(completion.data), completion.state, completion.policy);
+        ++count;
+    }
+
+    return count;
 }
 
 template<class T> void AbstractResourceLoader<T>::set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy) {
+    /* If called from a worker thread, the manager and the counters get
+       updated later from update() on the main thread */
+    if(_workers && _workers->isWorkerThread()) {
+        _workers->complete({key, data, state, policy, false});
+        return;
+    }
+
     if(data) ++_loadedCount;
     if(!data && state == ResourceDataState::NotFound) ++_notFoundCount;
     manager->set(key, data, state, policy);
@@ -36,6 +36,8 @@
 #include <Corrade/Utility/DebugStl.h> /** @todo remove once AbstractImporter is <string>-free */
 #include <Corrade/Utility/Path.h>
 
+#include "Magnum/Math/Functions.h"
+
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
 #include "Magnum/Audio/configure.h"
 #endif
@@ -96,6 +98,19 @@ void AbstractImporter::doOpenData(Containers::ArrayView<const char>) {
     CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::openData(): feature advertised but not implemented", );
 }
 
+bool AbstractImporter::openMemory(Containers::ArrayView<const void> memory) {
+    CORRADE_ASSERT(features() & ImporterFeature::OpenData,
+        "Audio::AbstractImporter::openMemory(): feature not supported", {});
+
+    close();
+    doOpenMemory(Containers::arrayCast<const char>(memory));
+    return isOpened();
+}
+
+void AbstractImporter::doOpenMemory(Containers::ArrayView<const char> memory) {
+    doOpenData(memory);
+}
+
 bool AbstractImporter::openFile(const std::string& filename) {
     close();
     doOpenFile(filename);
@@ -140,6 +155,77 @@ Containers::Array<char> AbstractImporter::data() {
     return out;
 }
 
+Containers::ArrayView<const char> AbstractImporter::dataView() {
+    CORRADE_ASSERT(features() & ImporterFeature::DataView,
+        "Audio::AbstractImporter::dataView(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::dataView(): no file opened", {});
+    return doDataView();
+}
+
+Containers::ArrayView<const char> AbstractImporter::doDataView() {
+    CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::dataView(): feature advertised but not implemented", {});
+}
+
+std::size_t AbstractImporter::frameCount() const {
+    CORRADE_ASSERT(features() & ImporterFeature::Streaming,
+        "Audio::AbstractImporter::frameCount(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::frameCount(): no file opened", {});
+    return doFrameCount();
+}
+
+std::size_t AbstractImporter::doFrameCount() const {
+    CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::frameCount(): feature advertised but not implemented", {});
+}
+
+std::size_t AbstractImporter::frameOffset() const {
+    CORRADE_ASSERT(features() & ImporterFeature::Streaming,
+        "Audio::AbstractImporter::frameOffset(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::frameOffset(): no file opened", {});
+    return doFrameOffset();
+}
+
+std::size_t AbstractImporter::doFrameOffset() const {
+    CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::frameOffset(): feature advertised but not implemented", {});
+}
+
+std::size_t AbstractImporter::readInto(const Containers::ArrayView<void>& destination) {
+    CORRADE_ASSERT(features() & ImporterFeature::Streaming,
+        "Audio::AbstractImporter::readInto(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::readInto(): no file opened", {});
+
+    const std::size_t frameSize = bufferFormatSize(doFormat());
+    CORRADE_ASSERT(destination.size() % frameSize == 0,
+        "Audio::AbstractImporter::readInto(): expected a view size to be a multiple of" << frameSize << "bytes but got" << destination.size(), {});
+
+    /* Clamp to what's left so the implementation doesn't need to */
+    const std::size_t offset = doFrameOffset();
+    const std::size_t count = Math::min(destination.size()/frameSize, doFrameCount() - offset);
+    if(!count) return 0;
+
+    doReadInto(Containers::arrayCast<char>(destination).prefix(count*frameSize));
+    return count;
+}
+
+void AbstractImporter::doReadInto(Containers::ArrayView<char>) {
+    CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::readInto(): feature advertised but not implemented", );
+}
+
+void AbstractImporter::seek(const std::size_t frame) {
+    CORRADE_ASSERT(features() & ImporterFeature::Streaming,
+        "Audio::AbstractImporter::seek(): feature not supported", );
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::seek(): no file opened", );
+    #ifndef CORRADE_NO_ASSERT
+    const std::size_t frameCount = doFrameCount();
+    #endif
+    CORRADE_ASSERT(frame <= frameCount,
+        "Audio::AbstractImporter::seek(): offset" << frame << "out of range for" << frameCount << "frames", );
+    doSeek(frame);
+}
+
+void AbstractImporter::doSeek(std::size_t) {
+    CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::seek(): feature advertised but not implemented", );
+}
+
 Debug& operator<<(Debug& debug, const ImporterFeature value) {
     const bool packed = debug.immediateFlags() >= Debug::Flag::Packed;
 
@@ -150,6 +236,8 @@ Debug& operator<<(Debug& debug, const ImporterFeature value) {
         /* LCOV_EXCL_START */
         #define _c(v) case ImporterFeature::v: return debug << (packed ? "" : "::") << Debug::nospace << #v;
         _c(OpenData)
+        _c(Streaming)
+        _c(DataView)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -159,7 +247,9 @@ Debug& operator<<(Debug& debug, const ImporterFeature value) {
 
 Debug& operator<<(Debug& debug, const ImporterFeatures value) {
     return Containers::enumSetDebugOutput(debug, value, debug.immediateFlags() >= Debug::Flag::Packed ? "{}" : "Audio::ImporterFeatures{}", {
-        ImporterFeature::OpenData});
+        ImporterFeature::OpenData,
+        ImporterFeature::Streaming,
+        ImporterFeature::DataView});
 }
 
 }}
@@ -44,8 +44,28 @@ namespace Magnum { namespace Audio {
 @see @ref ImporterFeatures, @ref AbstractImporter::features()
 */
 enum class ImporterFeature: UnsignedByte {
-    /** Opening files from raw data using @ref AbstractImporter::openData() */
-    OpenData = 1 << 0
+    /**
+     * Opening files from raw data or non-temporary memory using
+     * @ref AbstractImporter::openData() or
+     * @relativeref{AbstractImporter,openMemory()}
+     */
+    OpenData = 1 << 0,
+
+    /**
+     * Incremental decoding using @ref AbstractImporter::frameCount(),
+     * @relativeref{AbstractImporter,frameOffset()},
+     * @relativeref{AbstractImporter,readInto()} and
+     * @relativeref{AbstractImporter,seek()}
+     * @m_since_latest
+     */
+    Streaming = 1 << 1,
+
+    /**
+     * Accessing the sample data without a copy using
+     * @ref AbstractImporter::dataView()
+     * @m_since_latest
+     */
+    DataView = 1 << 2
 };
 
 /**
@@ -80,11 +100,39 @@ around in order to have the returned data valid. Moreover, all returned
 deleters --- this is to avoid potential dangling function pointer calls when
 destructing such instances after the plugin module has been unloaded.
 
+If the importer supports @ref ImporterFeature::DataView, @ref dataView() can
+be used to access the sample data without a copy. Unlike @ref data(), the
+returned view is tied to the importer and stays valid only until the file is
+closed. Combined with @ref openMemory(), which references the memory instead
+of copying it, this allows for example playing sounds from a memory-mapped
+pack file without allocating anything payload-sized:
+
+@snippet Audio.cpp AbstractImporter-openMemory
+
+@section Audio-AbstractImporter-streaming Streaming decoding
+
+The @ref data() function decodes the whole file at once. For long music tracks
+or ambience loops that's unnecessarily wasteful, and if the importer supports
+@ref ImporterFeature::Streaming, the data can be decoded incrementally into a
+fixed-size buffer using @ref readInto() instead, with @ref seek() for
+rewinding or skipping. Data are read in whole frames, size of which is given
+by @ref bufferFormatSize():
+
+@snippet Audio.cpp AbstractImporter-streaming
+
+The @ref BufferStream class wraps this in a ring of @ref Buffer instances
+queued on a @ref Source.
+
 @section Audio-AbstractImporter-subclassing Subclassing
 
 Plugin implements function @ref doFeatures(), @ref doIsOpened(), one of or both
 @ref doOpenData() and @ref doOpenFile() functions, function @ref doClose() and
 data access functions @ref doFormat(), @ref doFrequency() and @ref doData().
+If @ref ImporterFeature::Streaming is supported, @ref doFrameCount(),
+@ref doFrameOffset(), @ref doReadInto() and @ref doSeek() are implemented as
+well. If @ref ImporterFeature::DataView is supported, @ref doDataView() is
+implemented. Implementing @ref doOpenMemory() is optional, by default it
+delegates to @ref doOpenData().
 
 You don't need to do most of the redundant sanity checks, these things are
 checked by the implementation:
@@ -92,10 +140,19 @@ checked by the implementation:
 -   Functions @ref doOpenData() and @ref doOpenFile() are called after the
     previous file was closed, function @ref doClose() is called only if there
     is any file opened.
--   Function @ref doOpenData() is called only if @ref ImporterFeature::OpenData
-    is supported.
+-   Functions @ref doOpenData() and @ref doOpenMemory() are called only if
+    @ref ImporterFeature::OpenData is supported.
+-   Function @ref doDataView() is called only if
+    @ref ImporterFeature::DataView is supported.
 -   All `do*()` implementations working on opened file are called only if
     there is any file opened.
+-   Functions @ref doFrameCount(), @ref doFrameOffset(), @ref doReadInto()
+    and @ref doSeek() are called only if @ref ImporterFeature::Streaming is
+    supported.
+-   Function @ref doReadInto() is called only with a non-empty view of a size
+    that's a multiple of the frame size and not larger than the count of
+    remaining frames, function @ref doSeek() is called only with an offset
+    not larger than @ref frameCount().
 
 @m_class{m-block m-warning}
 
@@ -172,10 +229,28 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          * file. Available only if @ref ImporterFeature::OpenData is supported.
          * On failure prints a message to @relativeref{Magnum,Error} and
          * returns @cpp false @ce.
-         * @see @ref features(), @ref openFile()
+         * @see @ref features(), @ref openMemory(), @ref openFile()
          */
         bool openData(Containers::ArrayView<const void> data);
 
+        /**
+         * @brief Open a non-temporary memory
+         * @m_since_latest
+         *
+         * Closes previous file, if it was opened, and tries to open given
+         * memory. Available only if @ref ImporterFeature::OpenData is
+         * supported. On failure prints a message to
+         * @relativeref{Magnum,Error} and returns @cpp false @ce.
+         *
+         * Unlike @ref openData(), this function expects that @p memory stays
+         * in scope until the importer is destructed, @ref close() is called
+         * or another file is opened. This allows the implementation to
+         * directly operate on the provided memory, without having to allocate
+         * a local copy to extend its lifetime.
+         * @see @ref features(), @ref dataView()
+         */
+        bool openMemory(Containers::ArrayView<const void> memory);
+
         /**
          * @brief Open file
          *
@@ -197,9 +272,79 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Sample frequency */
         UnsignedInt frequency() const;
 
-        /** @brief Sample data */
+        /**
+         * @brief Sample data
+         *
+         * The returned data are always an owned copy independent of the
+         * importer. Use @ref dataView() to avoid the copy.
+         */
         Containers::Array<char> data();
 
+        /**
+         * @brief Sample data view
+         * @m_since_latest
+         *
+         * Same contents as @ref data(), but without a copy. The view stays
+         * valid only until the importer is destructed, @ref close() is called
+         * or another file is opened. If the file was opened with
+         * @ref openMemory(), the view may point directly into the memory
+         * passed to it. Available only if @ref ImporterFeature::DataView is
+         * supported.
+         * @see @ref features()
+         */
+        Containers::ArrayView<const char> dataView();
+
+        /**
+         * @brief Total frame count
+         * @m_since_latest
+         *
+         * A frame is one sample for all channels, its size is
+         * @ref bufferFormatSize() for @ref format(). Available only if
+         * @ref ImporterFeature::Streaming is supported.
+         * @see @ref features(), @ref frameOffset()
+         */
+        std::size_t frameCount() const;
+
+        /**
+         * @brief Current frame offset
+         * @m_since_latest
+         *
+         * Offset from which the next @ref readInto() call reads. Initially
+         * @cpp 0 @ce, equal to @ref frameCount() once all frames are read.
+         * Available only if @ref ImporterFeature::Streaming is supported.
+         * @see @ref features(), @ref seek()
+         */
+        std::size_t frameOffset() const;
+
+        /**
+         * @brief Decode next frames into a buffer
+         * @return Count of frames read
+         * @m_since_latest
+         *
+         * Decodes at most @cpp destination.size()/bufferFormatSize(format()) @ce
+         * frames starting at @ref frameOffset() into @p destination and
+         * advances the offset by the count of frames read. The returned count
+         * is less than the destination capacity only if the end of the data
+         * was reached, and @cpp 0 @ce if there's nothing left to read. Unlike
+         * @ref data(), this doesn't need to hold the whole decoded data in
+         * memory. Available only if @ref ImporterFeature::Streaming is
+         * supported, expects that the @p destination size is a multiple of
+         * the frame size.
+         * @see @ref features(), @ref seek()
+         */
+        std::size_t readInto(const Containers::ArrayView<void>& destination);
+
+        /**
+         * @brief Seek to given frame
+         * @m_since_latest
+         *
+         * Subsequent @ref readInto() call will read from @p frame. Available
+         * only if @ref ImporterFeature::Streaming is supported, expects that
+         * @p frame is not larger than @ref frameCount().
+         * @see @ref features(), @ref frameOffset()
+         */
+        void seek(std::size_t frame);
+
         /* Since 1.8.17, the original short-hand group closing doesn't work
            anymore. FFS. */
         /**
@@ -216,6 +361,15 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Implementation for @ref openData() */
         virtual void doOpenData(Containers::ArrayView<const char> data);
 
+        /**
+         * @brief Implementation for @ref openMemory()
+         * @m_since_latest
+         *
+         * Default implementation calls @ref doOpenData(). Override in order
+         * to reference @p memory directly instead of copying it.
+         */
+        virtual void doOpenMemory(Containers::ArrayView<const char> memory);
+
         /**
          * @brief Implementation for @ref openFile()
          *
@@ -236,6 +390,41 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
 
         /** @brief Implementation for @ref data() */
         virtual Containers::Array<char> doData() = 0;
+
+        /**
+         * @brief Implementation for @ref dataView()
+         * @m_since_latest
+         */
+        virtual Containers::ArrayView<const char> doDataView();
+
+        /**
+         * @brief Implementation for @ref frameCount()
+         * @m_since_latest
+         */
+        virtual std::size_t doFrameCount() const;
+
+        /**
+         * @brief Implementation for @ref frameOffset()
+         * @m_since_latest
+         */
+        virtual std::size_t doFrameOffset() const;
+
+        /**
+         * @brief Implementation for @ref readInto()
+         * @m_since_latest
+         *
+         * The @p destination is guaranteed to be non-empty, have a size that
+         * is a multiple of the frame size and hold at most as many frames as
+         * there is left to read. The implementation is expected to fill it
+         * whole and advance @ref doFrameOffset() by the frame count.
+         */
+        virtual void doReadInto(Containers::ArrayView<char> destination);
+
+        /**
+         * @brief Implementation for @ref seek()
+         * @m_since_latest
+         */
+        virtual void doSeek(std::size_t frame);
 };
 
 /**
@@ -256,7 +445,7 @@ updated interface string.
 */
 /* Silly indentation to make the string appear in pluginInterface() docs */
 #define MAGNUM_AUDIO_ABSTRACTIMPORTER_PLUGIN_INTERFACE /* [interface] */ \
-"cz.mosra.magnum.Audio.AbstractImporter/0.1"
+"cz.mosra.magnum.Audio.AbstractImporter/0.2"
 /* [interface] */
 
 }}
@@ -43,6 +43,7 @@ class AbstractImporter;
 enum class BufferFormat: ALenum;
 
 class Buffer;
+class BufferStream;
 class Context;
 class Source;
 /* Renderer used only statically */
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Enum @ref Magnum::Audio::BufferFormat
+ * @brief Enum @ref Magnum::Audio::BufferFormat, function @ref Magnum::Audio::bufferFormatSize()
  */
 
 #include "Magnum/Magnum.h"
@@ -193,6 +193,17 @@ enum class BufferFormat: ALenum {
     Surround71Channel32 = AL_FORMAT_71CHN32
 };
 
+/**
+@brief Size of a single frame in given buffer format
+@m_since_latest
+
+Size of one sample for all channels, in bytes. For example, a frame in
+@ref BufferFormat::Stereo16 is four bytes. Expects that @p format is a known
+value.
+@see @ref AbstractImporter::readInto()
+*/
+MAGNUM_AUDIO_EXPORT UnsignedInt bufferFormatSize(BufferFormat format);
+
 /** @debugoperatorenum{BufferFormat} */
 MAGNUM_AUDIO_EXPORT Debug& operator<<(Debug& debug, BufferFormat value);
 
@@ -0,0 +1,102 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BufferStream.h"
+
+#include <new>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Audio/Source.h"
+
+namespace Magnum { namespace Audio {
+
+BufferStream::BufferStream(AbstractImporter& importer, Source& source, const UnsignedInt bufferCount, const std::size_t framesPerBuffer): _importer{&importer}, _source{&source}, _framesPerBuffer{framesPerBuffer}, _freeCount{} {
+    CORRADE_ASSERT(importer.features() & ImporterFeature::Streaming,
+        "Audio::BufferStream: the importer doesn't support streaming", );
+    CORRADE_ASSERT(importer.isOpened(),
+        "Audio::BufferStream: no file opened", );
+    CORRADE_ASSERT(bufferCount && framesPerBuffer,
+        "Audio::BufferStream: expected non-zero buffer count and frames per buffer but got" << bufferCount << "and" << framesPerBuffer, );
+
+    _buffers = Containers::Array<Buffer>{DefaultInit, bufferCount};
+    _free = Containers::Array<Containers::Reference<Buffer>>{NoInit, bufferCount};
+    for(std::size_t i = 0; i != bufferCount; ++i)
+        new(&_free[i]) Containers::Reference<Buffer>{_buffers[i]};
+    _freeCount = bufferCount;
+    _staging = Containers::Array<char>{NoInit, framesPerBuffer*bufferFormatSize(importer.format())};
+}
+
+BufferStream::~BufferStream() {
+    /* Nothing to do if the constructor exited early on a graceful assert */
+    if(_buffers.isEmpty()) return;
+
+    /* Detaching the buffers is possible only on a stopped source. Not done if
+       nothing is queued to not interfere with other use of the source. */
+    if(_freeCount != _buffers.size())
+        _source->stop().setBuffer(nullptr);
+}
+
+UnsignedInt BufferStream::update() {
+    /* Buffers the source finished playing get moved to the front of the
+       queued part of the list, i.e. directly after the free part */
+    if(_freeCount != _buffers.size())
+        _freeCount += _source->unqueueBuffers(_free.exceptPrefix(_freeCount));
+
+    const BufferFormat format = _importer->format();
+    const UnsignedInt frequency = _importer->frequency();
+    const std::size_t frameSize = bufferFormatSize(format);
+
+    /* Take buffers from the end of the free part, so the queued part stays
+       contiguous */
+    UnsignedInt queued = 0;
+    while(_freeCount && !_ended) {
+        std::size_t count = _importer->readInto(_staging);
+
+        /* If looping, fill the rest of the buffer from the start. If the
+           importer has no data at all, there's nothing to loop. */
+        while(_looping && count < _framesPerBuffer) {
+            _importer->seek(0);
+            const std::size_t read = _importer->readInto(_staging.exceptPrefix(count*frameSize));
+            if(!read) break;
+            count += read;
+        }
+
+        /* A partially filled buffer can only happen at the end if not
+           looping */
+        if(count < _framesPerBuffer) _ended = true;
+        if(!count) break;
+
+        --_freeCount;
+        _free[_freeCount]->setData(format, _staging.prefix(count*frameSize), frequency);
+        _source->queueBuffers(_free.slice(_freeCount, _freeCount + 1));
+        ++queued;
+    }
+
+    return queued;
+}
+
+}}
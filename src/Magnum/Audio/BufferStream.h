@@ -0,0 +1,185 @@
+#ifndef Magnum_Audio_BufferStream_h
+#define Magnum_Audio_BufferStream_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2019 Guillaume Jacquemin <williamjcm@users.noreply.github.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Audio::BufferStream
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Reference.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Audio/Audio.h"
+#include "Magnum/Audio/visibility.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Streaming playback from an importer
+@m_since_latest
+
+Decodes data from an importer supporting @ref ImporterFeature::Streaming
+into a fixed ring of @ref Buffer instances queued on a @ref Source. Compared
+to uploading the whole @ref AbstractImporter::data() into a single buffer,
+only @cpp bufferCount*framesPerBuffer @ce frames are held in memory at any
+time, which is useful for long music tracks or ambience loops.
+
+Call @ref update() periodically, for example once per frame. It unqueues
+buffers the source already finished playing, refills them with next frames
+from the importer and queues them again:
+
+@snippet Audio.cpp BufferStream
+
+The buffer ring is set up with enough data for @cpp bufferCount*framesPerBuffer/frequency @ce
+seconds of playback. If @ref update() isn't called often enough, the source
+runs out of queued data and stops. It's then up to the application to call
+@ref Source::play() again, which can be detected by checking
+@ref Source::state() after an @ref update().
+
+The importer and the source are expected to stay in scope for the whole
+lifetime of this instance. Neither is expected to be used for anything else
+while the stream is active --- in particular, seeking the importer or
+attaching other buffers to the source will cause unexpected playback.
+*/
+class MAGNUM_AUDIO_EXPORT BufferStream {
+    public:
+        /**
+         * @brief Constructor
+         * @param importer          Importer to read the data from
+         * @param source            Source to queue the buffers on
+         * @param bufferCount       Count of buffers in the ring
+         * @param framesPerBuffer   Count of frames decoded into each buffer
+         *
+         * Expects that the @p importer supports
+         * @ref ImporterFeature::Streaming, has a file opened and that both
+         * @p bufferCount and @p framesPerBuffer are non-zero. The buffers
+         * are created but not filled, the first @ref update() fills and
+         * queues all of them.
+         */
+        explicit BufferStream(AbstractImporter& importer, Source& source, UnsignedInt bufferCount = 4, std::size_t framesPerBuffer = 16384);
+
+        /** @brief Copying is not allowed */
+        BufferStream(const BufferStream&) = delete;
+
+        /**
+         * @brief Moving is not allowed
+         *
+         * The buffers are referenced by the source.
+         */
+        BufferStream(BufferStream&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Stops the source and detaches all buffers from it before deleting
+         * them.
+         */
+        ~BufferStream();
+
+        /** @brief Copying is not allowed */
+        BufferStream& operator=(const BufferStream&) = delete;
+
+        /** @brief Moving is not allowed */
+        BufferStream& operator=(BufferStream&&) = delete;
+
+        /** @brief Importer */
+        AbstractImporter& importer() { return *_importer; }
+
+        /** @brief Source */
+        Source& source() { return *_source; }
+
+        /** @brief Count of buffers in the ring */
+        UnsignedInt bufferCount() const { return _buffers.size(); }
+
+        /** @brief Count of frames decoded into each buffer */
+        std::size_t framesPerBuffer() const { return _framesPerBuffer; }
+
+        /** @brief Whether the stream is looping */
+        bool isLooping() const { return _looping; }
+
+        /**
+         * @brief Set looping
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, once the importer reaches the end, it's seeked back to
+         * the beginning and decoding continues from there. Default is
+         * @cpp false @ce. Note that @ref Source::setLooping() can't be used
+         * for streaming playback as it'd loop only the currently played
+         * buffer.
+         */
+        BufferStream& setLooping(bool looping) {
+            _looping = looping;
+            return *this;
+        }
+
+        /**
+         * @brief Count of buffers currently queued on the source
+         *
+         * Includes buffers that were already played but weren't unqueued by
+         * @ref update() yet.
+         */
+        UnsignedInt queuedBufferCount() const { return _buffers.size() - _freeCount; }
+
+        /**
+         * @brief Whether the whole stream was played
+         *
+         * Returns @cpp true @ce if the importer reached the end and all
+         * buffers were played and unqueued by @ref update(). For a
+         * @ref isLooping() "looping" stream this happens only if the importer
+         * has no data at all.
+         */
+        bool isFinished() const { return _ended && _freeCount == _buffers.size(); }
+
+        /**
+         * @brief Refill and queue processed buffers
+         * @return Count of newly queued buffers
+         *
+         * Unqueues buffers already played by the source, decodes next
+         * @ref framesPerBuffer() frames into each of them and queues them
+         * again. Doesn't affect the source state.
+         * @see @ref Source::unqueueBuffers(), @ref Source::queueBuffers()
+         */
+        UnsignedInt update();
+
+    private:
+        AbstractImporter* _importer;
+        Source* _source;
+        std::size_t _framesPerBuffer;
+        bool _looping{}, _ended{};
+        /* The first _freeCount items in _free are buffers that aren't queued,
+           the rest is queued on the source */
+        UnsignedInt _freeCount;
+        Containers::Array<Buffer> _buffers;
+        Containers::Array<Containers::Reference<Buffer>> _free;
+        Containers::Array<char> _staging;
+};
+
+}}
+
+#endif
@@ -25,7 +25,7 @@
 
 #include "Source.h"
 
-#include <algorithm> /* std::remove_if() */
+#include <algorithm> /* std::stable_partition() */
 
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Reference.h>
@@ -57,14 +57,16 @@ std::size_t Source::unqueueBuffers(Containers::ArrayView<Containers::Reference<B
 
     Containers::Array<ALuint> unqueuedIds(processedBuffers);
     alSourceUnqueueBuffers(_id, unqueuedIds.size(), unqueuedIds.data());
-    auto isNotUnqueued = [&unqueuedIds](Buffer& buffer) {
+    auto isUnqueued = [&unqueuedIds](Buffer& buffer) {
         for(ALuint id : unqueuedIds) {
             if(buffer.id() == id)
-                return false;
+                return true;
         }
-        return true;
+        return false;
     };
-    return std::remove_if(buffers.begin(), buffers.end(), isNotUnqueued) - buffers.begin();
+    /* Partitioning instead of std::remove_if() so the buffers that are still
+       queued are preserved in the suffix */
+    return std::stable_partition(buffers.begin(), buffers.end(), isUnqueued) - buffers.begin();
 }
 
 namespace {
@@ -52,8 +52,8 @@ namespace Magnum { namespace Audio {
 /**
 @brief Source
 
-Manages positional audio source.
-@todo Expose convenient API for buffer queuing
+Manages positional audio source. For streaming playback from an
+@ref AbstractImporter see @ref BufferStream.
 */
 class MAGNUM_AUDIO_EXPORT Source {
     public:
@@ -542,7 +542,8 @@ class MAGNUM_AUDIO_EXPORT Source {
          * @m_since{2019,10}
          *
          * The unqueued buffers will be listed in the prefix of the array. Use
-         * @ref Corrade::Containers::ArrayView::prefix() to get it.
+         * @ref Corrade::Containers::ArrayView::prefix() to get it. The
+         * remaining buffers are listed after, in their original order.
          * @see @fn_al_keyword{SourceUnqueueBuffers}
          */
         std::size_t unqueueBuffers(Containers::ArrayView<Containers::Reference<Buffer>> buffers);
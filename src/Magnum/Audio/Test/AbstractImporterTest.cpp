@@ -26,6 +26,7 @@
 #include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/Containers/StringStl.h> /** @todo remove once AbstractImporter is <string>-free */
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
@@ -48,10 +49,13 @@ struct AbstractImporterTest: TestSuite::Tester {
     void openData();
     void openFileAsData();
     void openFileAsDataNotFound();
+    void openMemory();
+    void openMemoryAsData();
 
     void openFileNotImplemented();
     void openDataNotSupported();
     void openDataNotImplemented();
+    void openMemoryNotSupported();
 
     /* file callbacks not supported -- those will be once this gets merged with
        Trade::AbstractImporter */
@@ -65,6 +69,17 @@ struct AbstractImporterTest: TestSuite::Tester {
     void data();
     void dataNoFile();
     void dataCustomDeleter();
+    void dataView();
+    void dataViewNotSupported();
+    void dataViewNotImplemented();
+    void dataViewNoFile();
+
+    void streaming();
+    void streamingNotSupported();
+    void streamingNotImplemented();
+    void streamingNoFile();
+    void readIntoInvalidSize();
+    void seekOutOfRange();
 
     void debugFeature();
     void debugFeaturePacked();
@@ -78,10 +93,13 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::openData,
               &AbstractImporterTest::openFileAsData,
               &AbstractImporterTest::openFileAsDataNotFound,
+              &AbstractImporterTest::openMemory,
+              &AbstractImporterTest::openMemoryAsData,
 
               &AbstractImporterTest::openFileNotImplemented,
               &AbstractImporterTest::openDataNotSupported,
               &AbstractImporterTest::openDataNotImplemented,
+              &AbstractImporterTest::openMemoryNotSupported,
 
               &AbstractImporterTest::format,
               &AbstractImporterTest::formatNoFile,
@@ -92,6 +110,17 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::data,
               &AbstractImporterTest::dataNoFile,
               &AbstractImporterTest::dataCustomDeleter,
+              &AbstractImporterTest::dataView,
+              &AbstractImporterTest::dataViewNotSupported,
+              &AbstractImporterTest::dataViewNotImplemented,
+              &AbstractImporterTest::dataViewNoFile,
+
+              &AbstractImporterTest::streaming,
+              &AbstractImporterTest::streamingNotSupported,
+              &AbstractImporterTest::streamingNotImplemented,
+              &AbstractImporterTest::streamingNoFile,
+              &AbstractImporterTest::readIntoInvalidSize,
+              &AbstractImporterTest::seekOutOfRange,
 
               &AbstractImporterTest::debugFeature,
               &AbstractImporterTest::debugFeaturePacked,
@@ -197,6 +226,57 @@ void AbstractImporterTest::openFileAsDataNotFound() {
         TestSuite::Compare::StringHasSuffix);
 }
 
+void AbstractImporterTest::openMemory() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _memory.data(); }
+        void doClose() override { _memory = nullptr; }
+
+        void doOpenMemory(Containers::ArrayView<const char> memory) override {
+            _memory = memory;
+        }
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        Containers::ArrayView<const char> _memory;
+    } importer;
+
+    const char a5[]{'\xa5', '\x5a'};
+    CORRADE_VERIFY(importer.openMemory(a5));
+    CORRADE_VERIFY(importer.isOpened());
+    /* The memory is passed through as-is, without a copy */
+    CORRADE_COMPARE(static_cast<const void*>(importer._memory.data()), a5);
+    CORRADE_COMPARE(importer._memory.size(), 2);
+
+    importer.close();
+    CORRADE_VERIFY(!importer.isOpened());
+}
+
+void AbstractImporterTest::openMemoryAsData() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenData(Containers::ArrayView<const char> data) override {
+            _opened = (data.size() == 1 && data[0] == '\xa5');
+        }
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        bool _opened = false;
+    } importer;
+
+    /* The default implementation delegates to doOpenData() */
+    const char a5 = '\xa5';
+    CORRADE_VERIFY(importer.openMemory({&a5, 1}));
+    CORRADE_VERIFY(importer.isOpened());
+}
+
 void AbstractImporterTest::openFileNotImplemented() {
     CORRADE_SKIP_IF_NO_ASSERT();
 
@@ -257,6 +337,26 @@ void AbstractImporterTest::openDataNotImplemented() {
     CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::openData(): feature advertised but not implemented\n");
 }
 
+void AbstractImporterTest::openMemoryNotSupported() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    CORRADE_VERIFY(!importer.openMemory(nullptr));
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::openMemory(): feature not supported\n");
+}
+
 void AbstractImporterTest::format() {
     struct: AbstractImporter {
         ImporterFeatures doFeatures() const override { return {}; }
@@ -385,6 +485,278 @@ void AbstractImporterTest::dataCustomDeleter() {
     CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::data(): implementation is not allowed to use a custom Array deleter\n");
 }
 
+void AbstractImporterTest::dataView() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::DataView; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+        Containers::ArrayView<const char> doDataView() override {
+            return _data;
+        }
+
+        const char _data[2]{'H', 'i'};
+    } importer;
+
+    Containers::ArrayView<const char> data = importer.dataView();
+    CORRADE_COMPARE(data.data(), importer._data);
+    CORRADE_COMPARE(data.size(), 2);
+}
+
+void AbstractImporterTest::dataViewNotSupported() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.dataView();
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::dataView(): feature not supported\n");
+}
+
+void AbstractImporterTest::dataViewNotImplemented() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::DataView; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.dataView();
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::dataView(): feature advertised but not implemented\n");
+}
+
+void AbstractImporterTest::dataViewNoFile() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::DataView; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.dataView();
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::dataView(): no file opened\n");
+}
+
+void AbstractImporterTest::streaming() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Stereo8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        std::size_t doFrameCount() const override { return 5; }
+        std::size_t doFrameOffset() const override { return offset; }
+        void doReadInto(Containers::ArrayView<char> destination) override {
+            /* The base should clamp to what's left */
+            CORRADE_VERIFY(destination.size() <= (5 - offset)*2);
+            for(std::size_t i = 0; i != destination.size(); ++i)
+                destination[i] = 'a' + offset*2 + i;
+            offset += destination.size()/2;
+        }
+        void doSeek(std::size_t frame) override { offset = frame; }
+
+        std::size_t offset = 0;
+    } importer;
+
+    CORRADE_COMPARE(importer.frameCount(), 5);
+    CORRADE_COMPARE(importer.frameOffset(), 0);
+
+    char out[6]{};
+    CORRADE_COMPARE(importer.readInto(out), 3);
+    CORRADE_COMPARE(Containers::StringView{out, 6}, "abcdef");
+    CORRADE_COMPARE(importer.frameOffset(), 3);
+
+    /* Less than the full buffer at the end */
+    CORRADE_COMPARE(importer.readInto(out), 2);
+    CORRADE_COMPARE(Containers::StringView{out, 4}, "ghij");
+    CORRADE_COMPARE(importer.frameOffset(), 5);
+
+    /* Nothing at the end, doReadInto() isn't called */
+    CORRADE_COMPARE(importer.readInto(out), 0);
+    CORRADE_COMPARE(importer.frameOffset(), 5);
+
+    /* Empty view also doesn't call doReadInto() */
+    importer.seek(1);
+    CORRADE_COMPARE(importer.frameOffset(), 1);
+    CORRADE_COMPARE(importer.readInto(nullptr), 0);
+    CORRADE_COMPARE(importer.readInto(Containers::arrayView(out).prefix(2)), 1);
+    CORRADE_COMPARE(Containers::StringView{out, 2}, "cd");
+    CORRADE_COMPARE(importer.frameOffset(), 2);
+
+    /* Seeking to the end is allowed */
+    importer.seek(5);
+    CORRADE_COMPARE(importer.frameOffset(), 5);
+}
+
+void AbstractImporterTest::streamingNotSupported() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[1];
+    importer.frameCount();
+    importer.frameOffset();
+    importer.readInto(data);
+    importer.seek(0);
+    CORRADE_COMPARE(out.str(),
+        "Audio::AbstractImporter::frameCount(): feature not supported\n"
+        "Audio::AbstractImporter::frameOffset(): feature not supported\n"
+        "Audio::AbstractImporter::readInto(): feature not supported\n"
+        "Audio::AbstractImporter::seek(): feature not supported\n");
+}
+
+void AbstractImporterTest::streamingNotImplemented() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct Importer: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    /* Needed in order to get to doReadInto() and doSeek() */
+    struct: Importer {
+        std::size_t doFrameCount() const override { return 1; }
+        std::size_t doFrameOffset() const override { return 0; }
+    } importerWithCount;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[1];
+    importer.frameCount();
+    importer.frameOffset();
+    importerWithCount.readInto(data);
+    importerWithCount.seek(0);
+    CORRADE_COMPARE(out.str(),
+        "Audio::AbstractImporter::frameCount(): feature advertised but not implemented\n"
+        "Audio::AbstractImporter::frameOffset(): feature advertised but not implemented\n"
+        "Audio::AbstractImporter::readInto(): feature advertised but not implemented\n"
+        "Audio::AbstractImporter::seek(): feature advertised but not implemented\n");
+}
+
+void AbstractImporterTest::streamingNoFile() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[1];
+    importer.frameCount();
+    importer.frameOffset();
+    importer.readInto(data);
+    importer.seek(0);
+    CORRADE_COMPARE(out.str(),
+        "Audio::AbstractImporter::frameCount(): no file opened\n"
+        "Audio::AbstractImporter::frameOffset(): no file opened\n"
+        "Audio::AbstractImporter::readInto(): no file opened\n"
+        "Audio::AbstractImporter::seek(): no file opened\n");
+}
+
+void AbstractImporterTest::readIntoInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Stereo16; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        std::size_t doFrameCount() const override { return 5; }
+        std::size_t doFrameOffset() const override { return 0; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[6];
+    importer.readInto(data);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::readInto(): expected a view size to be a multiple of 4 bytes but got 6\n");
+}
+
+void AbstractImporterTest::seekOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Stereo16; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        std::size_t doFrameCount() const override { return 5; }
+        std::size_t doFrameOffset() const override { return 0; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.seek(6);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::seek(): offset 6 out of range for 5 frames\n");
+}
+
 void AbstractImporterTest::debugFeature() {
     std::ostringstream out;
 
@@ -34,11 +34,40 @@ namespace Magnum { namespace Audio { namespace Test { namespace {
 struct BufferFormatTest: TestSuite::Tester {
     explicit BufferFormatTest();
 
+    void size();
+    void sizeInvalid();
+
     void debugFormat();
 };
 
 BufferFormatTest::BufferFormatTest() {
-    addTests({&BufferFormatTest::debugFormat});
+    addTests({&BufferFormatTest::size,
+              &BufferFormatTest::sizeInvalid,
+
+              &BufferFormatTest::debugFormat});
+}
+
+void BufferFormatTest::size() {
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::Mono8), 1);
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::Stereo16), 4);
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::StereoALaw), 2);
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::MonoMuLaw), 1);
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::StereoFloat), 8);
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::StereoDouble), 16);
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::Quad32), 16);
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::Rear16), 4);
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::Surround51Channel16), 12);
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::Surround61Channel8), 7);
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::Surround71Channel32), 32);
+}
+
+void BufferFormatTest::sizeInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    bufferFormatSize(BufferFormat(0xdead));
+    CORRADE_COMPARE(out.str(), "Audio::bufferFormatSize(): invalid format Audio::BufferFormat(0xdead)\n");
 }
 
 void BufferFormatTest::debugFormat() {
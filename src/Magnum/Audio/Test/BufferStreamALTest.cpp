@@ -0,0 +1,209 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2019 Guillaume Jacquemin <williamjcm@users.noreply.github.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Audio/BufferStream.h"
+#include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/Source.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct BufferStreamALTest: TestSuite::Tester {
+    explicit BufferStreamALTest();
+
+    void construct();
+    void constructInvalid();
+
+    void update();
+    void updateEnd();
+    void updateLooping();
+    void updateEmpty();
+
+    Context _context;
+};
+
+BufferStreamALTest::BufferStreamALTest():
+    TestSuite::Tester{TestSuite::Tester::TesterConfiguration{}.setSkippedArgumentPrefixes({"magnum"})},
+    _context{arguments().first, arguments().second}
+{
+    addTests({&BufferStreamALTest::construct,
+              &BufferStreamALTest::constructInvalid,
+
+              &BufferStreamALTest::update,
+              &BufferStreamALTest::updateEnd,
+              &BufferStreamALTest::updateLooping,
+              &BufferStreamALTest::updateEmpty});
+}
+
+/* Produces given count of 8-bit mono frames, the value being the frame
+   index */
+struct Importer: AbstractImporter {
+    explicit Importer(std::size_t count): count{count} {}
+
+    ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    BufferFormat doFormat() const override { return BufferFormat::Mono8; }
+    UnsignedInt doFrequency() const override { return 22050; }
+    Containers::Array<char> doData() override { return nullptr; }
+
+    std::size_t doFrameCount() const override { return count; }
+    std::size_t doFrameOffset() const override { return offset; }
+    void doReadInto(Containers::ArrayView<char> destination) override {
+        for(char& i: destination) i = offset++;
+    }
+    void doSeek(std::size_t frame) override { offset = frame; }
+
+    std::size_t count, offset = 0;
+};
+
+struct NonStreamingImporter: AbstractImporter {
+    ImporterFeatures doFeatures() const override { return {}; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    BufferFormat doFormat() const override { return BufferFormat::Mono8; }
+    UnsignedInt doFrequency() const override { return 22050; }
+    Containers::Array<char> doData() override { return nullptr; }
+};
+
+void BufferStreamALTest::construct() {
+    Importer importer{100};
+    Source source;
+
+    {
+        BufferStream stream{importer, source, 3, 16};
+        CORRADE_COMPARE(&stream.importer(), &importer);
+        CORRADE_COMPARE(&stream.source(), &source);
+        CORRADE_COMPARE(stream.bufferCount(), 3);
+        CORRADE_COMPARE(stream.framesPerBuffer(), 16);
+        CORRADE_VERIFY(!stream.isLooping());
+        CORRADE_COMPARE(stream.queuedBufferCount(), 0);
+        CORRADE_VERIFY(!stream.isFinished());
+
+        /* Nothing is read in the constructor */
+        CORRADE_COMPARE(importer.frameOffset(), 0);
+    }
+
+    /* Nothing was queued, so the source stays untouched */
+    CORRADE_COMPARE(source.type(), Source::Type::Undetermined);
+}
+
+void BufferStreamALTest::constructInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    NonStreamingImporter importer;
+    Source source;
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        BufferStream stream{importer, source, 3, 16};
+
+        /* The stream is empty, so update() doesn't touch the source */
+        CORRADE_COMPARE(stream.update(), 0);
+    }
+    CORRADE_COMPARE(out.str(), "Audio::BufferStream: the importer doesn't support streaming\n");
+
+    /* The destructor doesn't touch the source either */
+    CORRADE_COMPARE(source.type(), Source::Type::Undetermined);
+}
+
+void BufferStreamALTest::update() {
+    Importer importer{100};
+    Source source;
+
+    {
+        BufferStream stream{importer, source, 3, 16};
+        CORRADE_COMPARE(stream.update(), 3);
+        CORRADE_COMPARE(stream.queuedBufferCount(), 3);
+        CORRADE_COMPARE(importer.frameOffset(), 48);
+        CORRADE_COMPARE(source.type(), Source::Type::Streaming);
+        CORRADE_VERIFY(!stream.isFinished());
+
+        /* The source isn't playing, so nothing gets processed and there's
+           nothing to refill */
+        CORRADE_COMPARE(stream.update(), 0);
+        CORRADE_COMPARE(stream.queuedBufferCount(), 3);
+        CORRADE_COMPARE(importer.frameOffset(), 48);
+    }
+
+    /* The buffers get detached from the source on destruction */
+    CORRADE_COMPARE(source.state(), Source::State::Stopped);
+    CORRADE_COMPARE(source.type(), Source::Type::Undetermined);
+}
+
+void BufferStreamALTest::updateEnd() {
+    Importer importer{20};
+    Source source;
+
+    BufferStream stream{importer, source, 3, 16};
+    /* One full buffer and one partially filled */
+    CORRADE_COMPARE(stream.update(), 2);
+    CORRADE_COMPARE(stream.queuedBufferCount(), 2);
+    CORRADE_COMPARE(importer.frameOffset(), 20);
+
+    /* Not finished until the queued buffers are played */
+    CORRADE_VERIFY(!stream.isFinished());
+    CORRADE_COMPARE(stream.update(), 0);
+    CORRADE_COMPARE(importer.frameOffset(), 20);
+}
+
+void BufferStreamALTest::updateLooping() {
+    Importer importer{20};
+    Source source;
+
+    BufferStream stream{importer, source, 3, 16};
+    CORRADE_VERIFY(stream.setLooping(true).isLooping());
+
+    /* All buffers filled, wrapping around the end twice */
+    CORRADE_COMPARE(stream.update(), 3);
+    CORRADE_COMPARE(stream.queuedBufferCount(), 3);
+    CORRADE_COMPARE(importer.frameOffset(), 48 % 20);
+    CORRADE_VERIFY(!stream.isFinished());
+}
+
+void BufferStreamALTest::updateEmpty() {
+    Importer importer{0};
+    Source source;
+
+    /* Looping an empty stream shouldn't get stuck */
+    BufferStream stream{importer, source, 3, 16};
+    stream.setLooping(true);
+    CORRADE_COMPARE(stream.update(), 0);
+    CORRADE_COMPARE(stream.queuedBufferCount(), 0);
+    CORRADE_VERIFY(stream.isFinished());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::BufferStreamALTest)
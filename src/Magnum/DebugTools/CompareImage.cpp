@@ -25,9 +25,12 @@
 
 #include "CompareImage.h"
 
+#include <atomic>
 #include <map>
 #include <sstream>
-#include <Corrade/Containers/Array.h>
+#include <thread>
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Pair.h>
 #include <Corrade/Containers/StridedArrayView.h>
@@ -40,6 +43,7 @@
 
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Constants.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Half.h"
 #include "Magnum/Math/Color.h"
@@ -48,74 +52,380 @@
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/ImageData.h"
 
-namespace Magnum { namespace DebugTools { namespace Implementation {
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#elif defined(CORRADE_TARGET_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace DebugTools {
+
+Debug& operator<<(Debug& debug, const CompareImageFlag value) {
+    const bool packed = debug.immediateFlags() >= Debug::Flag::Packed;
+
+    if(!packed)
+        debug << "DebugTools::CompareImageFlag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case CompareImageFlag::v: return debug << (packed ? "" : "::") << Debug::nospace << #v;
+        _c(EarlyOut)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << (packed ? "" : "(") << Debug::nospace << Debug::hex << UnsignedByte(value) << Debug::nospace << (packed ? "" : ")");
+}
+
+Debug& operator<<(Debug& debug, const CompareImageFlags value) {
+    return Containers::enumSetDebugOutput(debug, value, debug.immediateFlags() >= Debug::Flag::Packed ? "{}" : "DebugTools::CompareImageFlags{}", {
+        CompareImageFlag::EarlyOut});
+}
+
+namespace Implementation {
 
 namespace {
 
+/* SIMD kernels for the most common four-component formats, processing four
+   pixels at a time. Each returns the count of pixels it processed and updates
+   the max, the remaining pixels are handled by the scalar loops below. The
+   results are bit-exact with those. 32-bit ARM NEON flushes denormals to
+   zero, so the floating-point kernels are used only on 64-bit ARM, where the
+   behavior matches the scalar code. */
+#if defined(CORRADE_TARGET_SSE2) || (defined(CORRADE_TARGET_NEON) && !defined(CORRADE_TARGET_32BIT))
+#define MAGNUM_COMPAREIMAGE_SIMD_FLOAT
+#endif
+
+template<std::size_t size, class T> std::size_t calculateContiguousRowDeltaSimd(const T*, const T*, Float*, std::size_t, Float&) {
+    return 0;
+}
+
+#ifdef CORRADE_TARGET_SSE2
+inline Float horizontalMax(const __m128 value, Float max) {
+    Float values[4];
+    _mm_storeu_ps(values, value);
+    for(const Float i: values) max = Math::max(max, i);
+    return max;
+}
+#elif defined(CORRADE_TARGET_NEON)
+inline Float horizontalMax(const float32x4_t value, Float max) {
+    Float values[4];
+    vst1q_f32(values, value);
+    for(const Float i: values) max = Math::max(max, i);
+    return max;
+}
+#endif
+
+#if defined(CORRADE_TARGET_SSE2) || defined(CORRADE_TARGET_NEON)
+template<> std::size_t calculateContiguousRowDeltaSimd<4, UnsignedByte>(const UnsignedByte* const actual, const UnsignedByte* const expected, Float* const output, const std::size_t count, Float& max) {
+    /* The per-pixel sums of absolute differences are integers below 1024, so
+       summing them as integers gives the same result as summing the floats
+       in the scalar variant. Multiplying by a power of two is equivalent to
+       the division there. */
+    const std::size_t simdCount = count - count % 4;
+    #ifdef CORRADE_TARGET_SSE2
+    const __m128i lowBytes = _mm_set1_epi32(0x00ff00ff);
+    const __m128i lowShorts = _mm_set1_epi32(0x0000ffff);
+    __m128 vmax = _mm_setzero_ps();
+    for(std::size_t j = 0; j != simdCount; j += 4) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(actual + j*4));
+        const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(expected + j*4));
+        const __m128i diff = _mm_or_si128(_mm_subs_epu8(a, e), _mm_subs_epu8(e, a));
+        const __m128i pairs = _mm_add_epi32(
+            _mm_and_si128(diff, lowBytes),
+            _mm_and_si128(_mm_srli_epi32(diff, 8), lowBytes));
+        const __m128i sums = _mm_add_epi32(
+            _mm_and_si128(pairs, lowShorts),
+            _mm_srli_epi32(pairs, 16));
+        const __m128 delta = _mm_mul_ps(_mm_cvtepi32_ps(sums), _mm_set1_ps(0.25f));
+        _mm_storeu_ps(output + j, delta);
+        vmax = _mm_max_ps(vmax, delta);
+    }
+    #else
+    float32x4_t vmax = vdupq_n_f32(0.0f);
+    for(std::size_t j = 0; j != simdCount; j += 4) {
+        const uint8x16_t diff = vabdq_u8(vld1q_u8(actual + j*4), vld1q_u8(expected + j*4));
+        const uint32x4_t sums = vpaddlq_u16(vpaddlq_u8(diff));
+        const float32x4_t delta = vmulq_f32(vcvtq_f32_u32(sums), vdupq_n_f32(0.25f));
+        vst1q_f32(output + j, delta);
+        vmax = vmaxq_f32(vmax, delta);
+    }
+    #endif
+    max = horizontalMax(vmax, max);
+    return simdCount;
+}
+#endif
+
+#ifdef MAGNUM_COMPAREIMAGE_SIMD_FLOAT
+#ifdef CORRADE_TARGET_SSE2
+/* Same special handling as in the scalar variant below -- values that are
+   NaN in both or the same in both (which includes the same sign of infinity)
+   have no difference */
+inline __m128 componentDelta(const __m128 a, const __m128 e) {
+    const __m128 same = _mm_or_ps(_mm_cmpeq_ps(a, e),
+        _mm_and_ps(_mm_cmpunord_ps(a, a), _mm_cmpunord_ps(e, e)));
+    return _mm_andnot_ps(same, _mm_andnot_ps(_mm_set1_ps(-0.0f), _mm_sub_ps(a, e)));
+}
+
+/* Inverted comparison to filter out both NaN and infinity */
+inline __m128 finiteDelta(const __m128 delta) {
+    return _mm_and_ps(_mm_cmplt_ps(delta, _mm_set1_ps(Constants::inf())), delta);
+}
+#else
+inline float32x4_t componentDelta(const float32x4_t a, const float32x4_t e) {
+    const uint32x4_t same = vorrq_u32(vceqq_f32(a, e),
+        vandq_u32(vmvnq_u32(vceqq_f32(a, a)), vmvnq_u32(vceqq_f32(e, e))));
+    return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(vabsq_f32(vsubq_f32(a, e))), same));
+}
+
+inline float32x4_t finiteDelta(const float32x4_t delta) {
+    return vreinterpretq_f32_u32(vandq_u32(vcltq_f32(delta, vdupq_n_f32(Constants::inf())), vreinterpretq_u32_f32(delta)));
+}
+#endif
+
+template<> std::size_t calculateContiguousRowDeltaSimd<4, Float>(const Float* const actual, const Float* const expected, Float* const output, const std::size_t count, Float& max) {
+    /* The pixels are transposed so each vector contains one channel of four
+       pixels, which makes it possible to sum the channels in the same order
+       as the scalar variant. It starts from zero, but as the deltas are never
+       negative zero, starting from the first channel is equivalent. */
+    const std::size_t simdCount = count - count % 4;
+    #ifdef CORRADE_TARGET_SSE2
+    __m128 vmax = _mm_setzero_ps();
+    for(std::size_t j = 0; j != simdCount; j += 4) {
+        __m128 a0 = _mm_loadu_ps(actual + j*4 + 0);
+        __m128 a1 = _mm_loadu_ps(actual + j*4 + 4);
+        __m128 a2 = _mm_loadu_ps(actual + j*4 + 8);
+        __m128 a3 = _mm_loadu_ps(actual + j*4 + 12);
+        __m128 e0 = _mm_loadu_ps(expected + j*4 + 0);
+        __m128 e1 = _mm_loadu_ps(expected + j*4 + 4);
+        __m128 e2 = _mm_loadu_ps(expected + j*4 + 8);
+        __m128 e3 = _mm_loadu_ps(expected + j*4 + 12);
+        _MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+        _MM_TRANSPOSE4_PS(e0, e1, e2, e3);
+
+        const __m128 d0 = componentDelta(a0, e0);
+        const __m128 d1 = componentDelta(a1, e1);
+        const __m128 d2 = componentDelta(a2, e2);
+        const __m128 d3 = componentDelta(a3, e3);
+        const __m128 sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(d0, d1), d2), d3);
+        const __m128 sumFinite = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            finiteDelta(d0), finiteDelta(d1)), finiteDelta(d2)), finiteDelta(d3));
+
+        _mm_storeu_ps(output + j, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+        vmax = _mm_max_ps(vmax, _mm_mul_ps(sumFinite, _mm_set1_ps(0.25f)));
+    }
+    #else
+    float32x4_t vmax = vdupq_n_f32(0.0f);
+    for(std::size_t j = 0; j != simdCount; j += 4) {
+        /* Deinterleaves the channels directly */
+        const float32x4x4_t a = vld4q_f32(actual + j*4);
+        const float32x4x4_t e = vld4q_f32(expected + j*4);
+
+        const float32x4_t d0 = componentDelta(a.val[0], e.val[0]);
+        const float32x4_t d1 = componentDelta(a.val[1], e.val[1]);
+        const float32x4_t d2 = componentDelta(a.val[2], e.val[2]);
+        const float32x4_t d3 = componentDelta(a.val[3], e.val[3]);
+        const float32x4_t sum = vaddq_f32(vaddq_f32(vaddq_f32(d0, d1), d2), d3);
+        const float32x4_t sumFinite = vaddq_f32(vaddq_f32(vaddq_f32(
+            finiteDelta(d0), finiteDelta(d1)), finiteDelta(d2)), finiteDelta(d3));
+
+        vst1q_f32(output + j, vmulq_f32(sum, vdupq_n_f32(0.25f)));
+        vmax = vmaxq_f32(vmax, vmulq_f32(sumFinite, vdupq_n_f32(0.25f)));
+    }
+    #endif
+    max = horizontalMax(vmax, max);
+    return simdCount;
+}
+#endif
+
+/* Unpacks half-floats four at a time, returning the count of values
+   processed. Does the exact same operations as Math::unpackHalf(), including
+   the float subtraction for renormalizing denormals, so the output is
+   bit-exact with it. */
+std::size_t unpackHalfSimd(const Half* const in, Float* const out, const std::size_t count) {
+    #ifdef MAGNUM_COMPAREIMAGE_SIMD_FLOAT
+    const std::size_t simdCount = count - count % 4;
+    #ifdef CORRADE_TARGET_SSE2
+    const __m128i shiftedExp = _mm_set1_epi32(0x7c00 << 13);
+    for(std::size_t i = 0; i != simdCount; i += 4) {
+        const __m128i h = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i)), _mm_setzero_si128());
+        __m128i o = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7fff)), 13);
+        const __m128i exp = _mm_and_si128(o, shiftedExp);
+        o = _mm_add_epi32(o, _mm_set1_epi32((127 - 15) << 23));
+        o = _mm_add_epi32(o, _mm_and_si128(_mm_cmpeq_epi32(exp, shiftedExp), _mm_set1_epi32((128 - 16) << 23)));
+        const __m128i zeroDenormal = _mm_cmpeq_epi32(exp, _mm_setzero_si128());
+        const __m128i renormalized = _mm_castps_si128(_mm_sub_ps(
+            _mm_castsi128_ps(_mm_add_epi32(o, _mm_set1_epi32(1 << 23))),
+            _mm_castsi128_ps(_mm_set1_epi32(113 << 23))));
+        o = _mm_or_si128(_mm_and_si128(zeroDenormal, renormalized), _mm_andnot_si128(zeroDenormal, o));
+        o = _mm_or_si128(o, _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), o);
+    }
+    #else
+    const uint32x4_t shiftedExp = vdupq_n_u32(0x7c00 << 13);
+    for(std::size_t i = 0; i != simdCount; i += 4) {
+        const uint32x4_t h = vmovl_u16(vld1_u16(reinterpret_cast<const UnsignedShort*>(in + i)));
+        uint32x4_t o = vshlq_n_u32(vandq_u32(h, vdupq_n_u32(0x7fff)), 13);
+        const uint32x4_t exp = vandq_u32(o, shiftedExp);
+        o = vaddq_u32(o, vdupq_n_u32((127 - 15) << 23));
+        o = vaddq_u32(o, vandq_u32(vceqq_u32(exp, shiftedExp), vdupq_n_u32((128 - 16) << 23)));
+        const float32x4_t renormalized = vsubq_f32(
+            vreinterpretq_f32_u32(vaddq_u32(o, vdupq_n_u32(1 << 23))),
+            vreinterpretq_f32_u32(vdupq_n_u32(113 << 23)));
+        o = vbslq_u32(vceqq_u32(exp, vdupq_n_u32(0)), vreinterpretq_u32_f32(renormalized), o);
+        o = vorrq_u32(o, vshlq_n_u32(vandq_u32(h, vdupq_n_u32(0x8000)), 16));
+        vst1q_f32(out + i, vreinterpretq_f32_u32(o));
+    }
+    #endif
+    return simdCount;
+    #else
+    static_cast<void>(in);
+    static_cast<void>(out);
+    static_cast<void>(count);
+    return 0;
+    #endif
+}
+
+/* Fast paths for rows that are contiguous in memory. Compared to going through
+   the strided views pixel by pixel, these work on plain component arrays with
+   no branching in the inner loop, and for the common four-component formats
+   delegate to the SIMD kernels above. The results are bit-exact with the
+   generic variants below, including the order in which the channel deltas
+   get summed. */
+
+template<std::size_t size, class T, typename std::enable_if<Math::IsIntegral<T>::value, int>::type = 0> Float calculateContiguousRowDelta(const T* const actual, const T* const expected, Float* const output, const std::size_t count, Containers::ArrayView<Float>) {
+    Float max{};
+    for(std::size_t j = calculateContiguousRowDeltaSimd<size>(actual, expected, output, count, max); j != count; ++j) {
+        Float sum{};
+        for(std::size_t k = 0; k != size; ++k)
+            sum += Math::abs(Float(actual[j*size + k]) - Float(expected[j*size + k]));
+        output[j] = sum/size;
+        max = Math::max(max, output[j]);
+    }
+
+    return max;
+}
+
+template<std::size_t size> Float calculateContiguousRowDelta(const Float* const actual, const Float* const expected, Float* const output, const std::size_t count, Containers::ArrayView<Float>) {
+    Float max{};
+    for(std::size_t j = calculateContiguousRowDeltaSimd<size>(actual, expected, output, count, max); j != count; ++j) {
+        Float sum{}, sumFinite{};
+        for(std::size_t k = 0; k != size; ++k) {
+            const Float a = actual[j*size + k];
+            const Float e = expected[j*size + k];
+            /* Same special handling as in the generic variant below -- values
+               that are NaN in both or the same in both (which includes the
+               same sign of infinity) have no difference. Inverted comparison
+               to filter out both NaN and infinity for the max. */
+            const Float diff = a == e || (Math::isNan(a) && Math::isNan(e)) ? 0.0f : Math::abs(a - e);
+            sum += diff;
+            sumFinite += diff < Constants::inf() ? diff : 0.0f;
+        }
+        output[j] = sum/size;
+        max = Math::max(max, sumFinite/size);
+    }
+
+    return max;
+}
+
+template<std::size_t size> Float calculateContiguousRowDelta(const Half* const actual, const Half* const expected, Float* const output, const std::size_t count, const Containers::ArrayView<Float> scratch) {
+    /* Unpack both rows to floats first and then delegate to the above */
+    const std::size_t componentCount = count*size;
+    CORRADE_INTERNAL_ASSERT(scratch.size() >= 2*componentCount);
+    const std::size_t simdCount = unpackHalfSimd(actual, scratch.data(), componentCount);
+    unpackHalfSimd(expected, scratch.data() + componentCount, componentCount);
+    for(std::size_t i = simdCount; i != componentCount; ++i) {
+        scratch[i] = Float(actual[i]);
+        scratch[componentCount + i] = Float(expected[i]);
+    }
+
+    return calculateContiguousRowDelta<size>(scratch.data(), scratch.data() + componentCount, output, count, nullptr);
+}
+
 /* There's a separate implementation for integral types, as those don't need
    any additional logic for handling NaN and infinity values, allowing the
    comparison to be much simpler & faster. */
 
-template<std::size_t size, class T, typename std::enable_if<Math::IsFloatingPoint<T>::value, int>::type = 0> Float calculateImageDelta(const Containers::StridedArrayView2D<const Math::Vector<size, T>>& actual, const Containers::StridedArrayView2D<const Math::Vector<size, T>>& expected, const Containers::StridedArrayView2D<Float>& output) {
-    CORRADE_INTERNAL_ASSERT(actual.size() == output.size());
-    CORRADE_INTERNAL_ASSERT(output.size() == expected.size());
+template<std::size_t size, class T, typename std::enable_if<Math::IsFloatingPoint<T>::value, int>::type = 0> Float calculateRowDelta(const Containers::StridedArrayView1D<const Math::Vector<size, T>>& actualRow, const Containers::StridedArrayView1D<const Math::Vector<size, T>>& expectedRow, const Containers::StridedArrayView1D<Float>& outputRow) {
+    /* Calculate deltas and maximal value of them */
+    Float max{};
+    for(std::size_t j = 0, jMax = expectedRow.size(); j != jMax; ++j) {
+        /* Explicitly convert from T to Float */
+        auto actualPixel = Math::Vector<size, Float>(actualRow[j]);
+        auto expectedPixel = Math::Vector<size, Float>(expectedRow[j]);
+
+        /* First calculate a classic difference */
+        Math::Vector<size, Float> diff = Math::abs(actualPixel - expectedPixel);
+
+        /* Mark pixels that are NaN in both actual and expected pixels as
+           having no difference */
+        diff = Math::lerp(diff, {}, Math::isNan(actualPixel) & Math::isNan(expectedPixel));
+
+        /* Then also mark pixels that are the same sign of infnity in both
+           actual and expected pixel as having no difference */
+        diff = Math::lerp(diff, {}, Math::isInf(actualPixel) & Math::isInf(expectedPixel) & Math::equal(actualPixel, expectedPixel));
+
+        /* Calculate the difference and save it to the output image even with
+           NaN and ±Inf (as the user should know) */
+        outputRow[j] = diff.sum()/size;
+
+        /* On the other hand, infs and NaNs should not contribute to the max
+           delta -- because all other differences would be zero compared to
+           them */
+        max = Math::max(max, Math::lerp(diff, {}, Math::isNan(diff)|Math::isInf(diff)).sum()/size);
+    }
 
+    return max;
+}
+
+template<std::size_t size, class T, typename std::enable_if<Math::IsIntegral<T>::value, int>::type = 0> Float calculateRowDelta(const Containers::StridedArrayView1D<const Math::Vector<size, T>>& actualRow, const Containers::StridedArrayView1D<const Math::Vector<size, T>>& expectedRow, const Containers::StridedArrayView1D<Float>& outputRow) {
     /* Calculate deltas and maximal value of them */
     Float max{};
-    for(std::size_t i = 0, iMax = expected.size()[0]; i != iMax; ++i) {
-        Containers::StridedArrayView1D<const Math::Vector<size, T>> actualRow = actual[i];
-        Containers::StridedArrayView1D<const Math::Vector<size, T>> expectedRow = expected[i];
-        Containers::StridedArrayView1D<Float> outputRow = output[i];
-
-        for(std::size_t j = 0, jMax = expectedRow.size(); j != jMax; ++j) {
-            /* Explicitly convert from T to Float */
-            auto actualPixel = Math::Vector<size, Float>(actualRow[j]);
-            auto expectedPixel = Math::Vector<size, Float>(expectedRow[j]);
-
-            /* First calculate a classic difference */
-            Math::Vector<size, Float> diff = Math::abs(actualPixel - expectedPixel);
-
-            /* Mark pixels that are NaN in both actual and expected pixels as
-               having no difference */
-            diff = Math::lerp(diff, {}, Math::isNan(actualPixel) & Math::isNan(expectedPixel));
-
-            /* Then also mark pixels that are the same sign of infnity in both
-               actual and expected pixel as having no difference */
-            diff = Math::lerp(diff, {}, Math::isInf(actualPixel) & Math::isInf(expectedPixel) & Math::equal(actualPixel, expectedPixel));
-
-            /* Calculate the difference and save it to the output image even
-               with NaN and ±Inf (as the user should know) */
-            outputRow[j] = diff.sum()/size;
-
-            /* On the other hand, infs and NaNs should not contribute to the
-               max delta -- because all other differences would be zero
-               compared to them */
-            max = Math::max(max, Math::lerp(diff, {}, Math::isNan(diff)|Math::isInf(diff)).sum()/size);
-        }
+    for(std::size_t j = 0, jMax = expectedRow.size(); j != jMax; ++j) {
+        /* Explicitly convert from T to Float */
+        auto actualPixel = Math::Vector<size, Float>(actualRow[j]);
+        auto expectedPixel = Math::Vector<size, Float>(expectedRow[j]);
+
+        Math::Vector<size, Float> diff = Math::abs(actualPixel - expectedPixel);
+        outputRow[j] = diff.sum()/size;
+        max = Math::max(max, outputRow[j]);
     }
 
     return max;
 }
 
-template<std::size_t size, class T, typename std::enable_if<Math::IsIntegral<T>::value, int>::type = 0> Float calculateImageDelta(const Containers::StridedArrayView2D<const Math::Vector<size, T>>& actual, const Containers::StridedArrayView2D<const Math::Vector<size, T>>& expected, const Containers::StridedArrayView2D<Float>& output) {
+/* Calculates deltas for a range of rows, called from multiple threads in
+   parallel if requested. If the max is above earlyOutThreshold, sets the stop
+   flag, and stops also if the flag is set by another thread. */
+template<std::size_t size, class T> Float calculateImageDelta(const Containers::StridedArrayView3D<const char>& actualPixels, const Containers::StridedArrayView3D<const char>& expectedPixels, const Containers::StridedArrayView2D<Float>& output, const Float earlyOutThreshold, std::atomic<bool>& stop) {
+    const Containers::StridedArrayView2D<const Math::Vector<size, T>> actual = Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels);
+    const Containers::StridedArrayView2D<const Math::Vector<size, T>> expected = Containers::arrayCast<2, const Math::Vector<size, T>>(expectedPixels);
     CORRADE_INTERNAL_ASSERT(actual.size() == output.size());
     CORRADE_INTERNAL_ASSERT(output.size() == expected.size());
+    /* The output is allocated by us, so always contiguous */
+    CORRADE_INTERNAL_ASSERT(output.isContiguous());
+
+    /* Half-floats get unpacked into a scratch memory in the fast path */
+    Containers::Array<Float> scratch{NoInit, std::is_same<T, Half>::value ? 2*size*output.size()[1] : 0};
 
-    /* Calculate deltas and maximal value of them */
     Float max{};
-    for(std::size_t i = 0, iMax = expected.size()[0]; i != iMax; ++i) {
-        Containers::StridedArrayView1D<const Math::Vector<size, T>> actualRow = actual[i];
-        Containers::StridedArrayView1D<const Math::Vector<size, T>> expectedRow = expected[i];
-        Containers::StridedArrayView1D<Float> outputRow = output[i];
-
-        for(std::size_t j = 0, jMax = expectedRow.size(); j != jMax; ++j) {
-            /* Explicitly convert from T to Float */
-            auto actualPixel = Math::Vector<size, Float>(actualRow[j]);
-            auto expectedPixel = Math::Vector<size, Float>(expectedRow[j]);
-
-            Math::Vector<size, Float> diff = Math::abs(actualPixel - expectedPixel);
-            outputRow[j] = diff.sum()/size;
-            max = Math::max(max, outputRow[j]);
+    for(std::size_t i = 0, iMax = output.size()[0]; i != iMax; ++i) {
+        if(stop.load(std::memory_order_relaxed)) break;
+
+        const Containers::StridedArrayView1D<const Math::Vector<size, T>> actualRow = actual[i];
+        const Containers::StridedArrayView1D<const Math::Vector<size, T>> expectedRow = expected[i];
+        const Containers::StridedArrayView1D<Float> outputRow = output[i];
+        max = Math::max(max, actualRow.isContiguous() && expectedRow.isContiguous() ?
+            calculateContiguousRowDelta<size>(
+                reinterpret_cast<const T*>(actualRow.data()),
+                reinterpret_cast<const T*>(expectedRow.data()),
+                static_cast<Float*>(outputRow.data()),
+                outputRow.size(), scratch) :
+            calculateRowDelta<size, T>(actualRow, expectedRow, outputRow));
+
+        if(max > earlyOutThreshold) {
+            stop.store(true, std::memory_order_relaxed);
+            break;
         }
     }
 
@@ -125,6 +435,10 @@ template<std::size_t size, class T, typename std::enable_if<Math::IsIntegral<T>:
 }
 
 Containers::Triple<Containers::Array<Float>, Float, Float> calculateImageDelta(const PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected) {
+    return calculateImageDelta(actualFormat, actualPixels, expected, 1, Constants::inf());
+}
+
+Containers::Triple<Containers::Array<Float>, Float, Float> calculateImageDelta(const PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected, const UnsignedInt threadCount, const Float earlyOutThreshold) {
     /* Calculate a delta image */
     Containers::Array<Float> deltaData{NoInit,
         std::size_t(expected.size().product())};
@@ -132,6 +446,7 @@ Containers::Triple<Containers::Array<Float>, Float, Float> calculateImageDelta(c
         {std::size_t(expected.size().y()), std::size_t(expected.size().x())}};
 
     CORRADE_INTERNAL_ASSERT(actualFormat == expected.format());
+    CORRADE_INTERNAL_ASSERT(threadCount);
     #ifdef CORRADE_NO_ASSERT
     static_cast<void>(actualFormat);
     #endif
@@ -142,37 +457,29 @@ Containers::Triple<Containers::Array<Float>, Float, Float> calculateImageDelta(c
     #pragma GCC diagnostic push
     #pragma GCC diagnostic error "-Wswitch"
     #endif
-    Float max{Constants::nan()};
+    Float(*calculate)(const Containers::StridedArrayView3D<const char>&, const Containers::StridedArrayView3D<const char>&, const Containers::StridedArrayView2D<Float>&, Float, std::atomic<bool>&) = nullptr;
     switch(expected.format()) {
         #define _c(format, size, T)                                         \
             case PixelFormat::format:                                       \
-                max = calculateImageDelta<size, T>(                         \
-                    Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
+                calculate = calculateImageDelta<size, T>;                   \
                 break;
         #define _d(first, second, size, T)                                  \
             case PixelFormat::first:                                        \
             case PixelFormat::second:                                       \
-                max = calculateImageDelta<size, T>(                         \
-                    Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
+                calculate = calculateImageDelta<size, T>;                   \
                 break;
         #define _e(first, second, third, size, T)                           \
             case PixelFormat::first:                                        \
             case PixelFormat::second:                                       \
             case PixelFormat::third:                                        \
-                max = calculateImageDelta<size, T>(                         \
-                    Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
+                calculate = calculateImageDelta<size, T>;                   \
                 break;
         #define _f(first, second, third, fourth, size, T)                   \
             case PixelFormat::first:                                        \
             case PixelFormat::second:                                       \
             case PixelFormat::third:                                        \
             case PixelFormat::fourth:                                       \
-                max = calculateImageDelta<size, T>(                         \
-                    Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
+                calculate = calculateImageDelta<size, T>;                   \
                 break;
         /* LCOV_EXCL_START */
         _f(R8Unorm, R8Srgb, R8UI, Stencil8UI, 1, UnsignedByte)
@@ -222,14 +529,53 @@ Containers::Triple<Containers::Array<Float>, Float, Float> calculateImageDelta(c
     #pragma GCC diagnostic pop
     #endif
 
-    CORRADE_ASSERT(max == max,
+    CORRADE_ASSERT(calculate,
         "DebugTools::CompareImage: unknown format" << expected.format(), {});
 
+    /* Split the rows among threads, the first chunk is done on the calling
+       thread. Each thread writes to a disjoint range of the delta image. */
+    const Containers::StridedArrayView3D<const char> expectedPixels = expected.pixels();
+    const std::size_t rowCount = delta.size()[0];
+    std::atomic<bool> stop{};
+    Float max{};
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    const std::size_t chunkCount = Math::max(Math::min(std::size_t(threadCount), rowCount), std::size_t{1});
+    if(chunkCount > 1) {
+        Containers::Array<Float> maxes{ValueInit, chunkCount};
+        Containers::Array<std::thread> threads;
+        arrayReserve(threads, chunkCount - 1);
+        for(std::size_t i = 1; i != chunkCount; ++i) {
+            const std::size_t begin = rowCount*i/chunkCount;
+            const std::size_t end = rowCount*(i + 1)/chunkCount;
+            arrayAppend(threads, InPlaceInit, [&, i, begin, end]() {
+                maxes[i] = calculate(actualPixels.slice(begin, end), expectedPixels.slice(begin, end), delta.slice(begin, end), earlyOutThreshold, stop);
+            });
+        }
+
+        const std::size_t end = rowCount/chunkCount;
+        maxes[0] = calculate(actualPixels.slice(0, end), expectedPixels.slice(0, end), delta.slice(0, end), earlyOutThreshold, stop);
+
+        for(std::thread& thread: threads) thread.join();
+        for(const Float i: maxes) max = Math::max(max, i);
+    } else
+    #else
+    static_cast<void>(threadCount);
+    #endif
+    {
+        max = calculate(actualPixels, expectedPixels, delta, earlyOutThreshold, stop);
+    }
+
+    /* If the calculation stopped early, the delta image is incomplete and the
+       mean can't be calculated */
+    if(max > earlyOutThreshold)
+        return {Utility::move(deltaData), max, Constants::nan()};
+
     /* Calculate mean delta. Do it the special way so we don't lose
        precision -- that would result in having false negatives! This
        *deliberately* leaves specials in. The `max` has them already filtered
        out so if this would filter them out as well, there would be nothing
-       left that could cause the comparison to fail. */
+       left that could cause the comparison to fail. It's done on a single
+       thread always to have the result independent of the thread count. */
     const Float mean = Math::Algorithms::kahanSum(deltaData.begin(), deltaData.end())/deltaData.size();
 
     return {Utility::move(deltaData), max, mean};
@@ -440,6 +786,7 @@ enum class Result: UnsignedByte {
     AboveThresholds,
     AboveMeanThreshold,
     AboveMaxThreshold,
+    AboveMaxThresholdEarlyOut,
     VerboseMessage
 };
 
@@ -480,6 +827,8 @@ class ImageComparatorBase::State {
         Containers::Optional<ImageView2D> expectedImage;
 
         Float maxThreshold, meanThreshold;
+        UnsignedInt threadCount{1};
+        CompareImageFlags flags;
         Result result{};
         Float max{}, mean{};
         Containers::Array<Float> delta;
@@ -495,6 +844,14 @@ ImageComparatorBase::ImageComparatorBase(PluginManager::Manager<Trade::AbstractI
 
 ImageComparatorBase::~ImageComparatorBase() = default;
 
+void ImageComparatorBase::setThreadCount(const UnsignedInt count) {
+    _state->threadCount = count;
+}
+
+void ImageComparatorBase::setFlags(const CompareImageFlags flags) {
+    _state->flags = flags;
+}
+
 TestSuite::ComparisonStatusFlags ImageComparatorBase::compare(const PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected) {
     /* The reference can be pointing to the storage, don't call the assignment
        on itself in that case */
@@ -515,10 +872,23 @@ TestSuite::ComparisonStatusFlags ImageComparatorBase::compare(const PixelFormat
         return TestSuite::ComparisonStatusFlag::Failed;
     }
 
-    Containers::Triple<Containers::Array<Float>, Float, Float> deltaMaxMean = DebugTools::Implementation::calculateImageDelta(actualFormat, actualPixels, expected);
+    /* Zero means as many threads as the hardware has, which can again be
+       zero if the value can't be queried */
+    UnsignedInt threadCount = _state->threadCount;
+    if(!threadCount) threadCount = Math::max(std::thread::hardware_concurrency(), 1u);
+
+    Containers::Triple<Containers::Array<Float>, Float, Float> deltaMaxMean = DebugTools::Implementation::calculateImageDelta(actualFormat, actualPixels, expected, threadCount, _state->flags & CompareImageFlag::EarlyOut ? _state->maxThreshold : Constants::inf());
     _state->max = deltaMaxMean.second();
     _state->mean = deltaMaxMean.third();
 
+    /* If the calculation stopped early, there's no mean and no complete delta
+       image to print, fail right away */
+    if((_state->flags & CompareImageFlag::EarlyOut) && _state->max > _state->maxThreshold) {
+        CORRADE_INTERNAL_ASSERT(!Math::isInf(_state->max) && !Math::isNan(_state->max));
+        _state->result = Result::AboveMaxThresholdEarlyOut;
+        return TestSuite::ComparisonStatusFlag::Failed;
+    }
+
     /* Verify the max/mean is never below zero so we didn't mess up when
        calculating specials. Note the inverted condition to catch NaNs in
        _mean. The max should OTOH be never special as it would make all other
@@ -730,6 +1100,10 @@ void ImageComparatorBase::printMessage(const TestSuite::ComparisonStatusFlags fl
     else if(_state->result == Result::DifferentFormat)
         out << "different format, actual" << _state->actualFormat
             << "but" << _state->expectedImage->format() << "expected.";
+    else if(_state->result == Result::AboveMaxThresholdEarlyOut)
+        out << "max delta above threshold, actual at least" << _state->max
+            << "but at most" << _state->maxThreshold
+            << "expected. Stopped early, mean delta and delta image not calculated.";
     else {
         if(_state->result == Result::AboveThresholds)
             out << "both max and mean delta above threshold, actual"
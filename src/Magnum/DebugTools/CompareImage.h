@@ -26,9 +26,10 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::DebugTools::CompareImage
+ * @brief Class @ref Magnum::DebugTools::CompareImage, enum @ref Magnum::DebugTools::CompareImageFlag, enum set @ref Magnum::DebugTools::CompareImageFlags
  */
 
+#include <Corrade/Containers/EnumSet.h>
 #include <Corrade/Containers/Pointer.h>
 #include <Corrade/PluginManager/PluginManager.h>
 #include <Corrade/TestSuite/TestSuite.h>
@@ -47,9 +48,53 @@
 
 namespace Magnum { namespace DebugTools {
 
+/**
+@brief Image comparison flag
+@m_since_latest
+
+@see @ref CompareImageFlags, @ref CompareImage::setFlags()
+*/
+enum class CompareImageFlag: UnsignedByte {
+    /**
+     * Stop calculating pixel deltas once a delta above the max threshold is
+     * found. Makes failing comparisons of large images faster, at the cost of
+     * the diagnostic output containing just the max delta found so far,
+     * without a mean delta, delta image visualization and a list of top
+     * deltas. Comparisons that pass aren't affected.
+     */
+    EarlyOut = 1 << 0
+};
+
+/**
+@brief Image comparison flags
+@m_since_latest
+
+@see @ref CompareImage::setFlags()
+*/
+typedef Containers::EnumSet<CompareImageFlag> CompareImageFlags;
+
+CORRADE_ENUMSET_OPERATORS(CompareImageFlags)
+
+/**
+@debugoperatorenum{CompareImageFlag}
+@m_since_latest
+*/
+MAGNUM_DEBUGTOOLS_EXPORT Debug& operator<<(Debug& debug, CompareImageFlag value);
+
+/**
+@debugoperatorenum{CompareImageFlags}
+@m_since_latest
+*/
+MAGNUM_DEBUGTOOLS_EXPORT Debug& operator<<(Debug& debug, CompareImageFlags value);
+
 namespace Implementation {
     MAGNUM_DEBUGTOOLS_EXPORT Containers::Triple<Containers::Array<Float>, Float, Float> calculateImageDelta(PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected);
 
+    /* Splits the rows among threadCount threads, stops once max is above
+       earlyOutThreshold. In that case the mean is NaN and the delta image is
+       incomplete. */
+    MAGNUM_DEBUGTOOLS_EXPORT Containers::Triple<Containers::Array<Float>, Float, Float> calculateImageDelta(PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected, UnsignedInt threadCount, Float earlyOutThreshold);
+
     MAGNUM_DEBUGTOOLS_EXPORT void printDeltaImage(Debug& out, Containers::ArrayView<const Float> delta, const Vector2i& size, Float max, Float maxThreshold, Float meanThreshold);
 
     MAGNUM_DEBUGTOOLS_EXPORT void printPixelDeltas(Debug& out, Containers::ArrayView<const Float> delta, PixelFormat format, const Containers::StridedArrayView3D<const char>& actualPixels, const Containers::StridedArrayView3D<const char>& expectedPixels, Float maxThreshold, Float meanThreshold, std::size_t maxCount);
@@ -74,6 +119,9 @@ class MAGNUM_DEBUGTOOLS_EXPORT ImageComparatorBase {
 
         ~ImageComparatorBase();
 
+        void setThreadCount(UnsignedInt count);
+        void setFlags(CompareImageFlags flags);
+
         TestSuite::ComparisonStatusFlags operator()(const ImageView2D& actual, const ImageView2D& expected);
 
         TestSuite::ComparisonStatusFlags operator()(Containers::StringView actual, Containers::StringView expected);
@@ -286,6 +334,27 @@ is specified, every image comparison with a non-zero delta will print an
 @cb{.ansi} [1;39mINFO @ce message in the same form as the error diagnostic
 shown above.
 
+@section DebugTools-CompareImage-performance Comparing large images
+
+Image rows that are contiguous in memory are processed with a dedicated code
+path, which is the case for all images with default @ref PixelStorage
+parameters and no padding at the end of rows. For
+@ref PixelFormat::RGBA8Unorm, @ref PixelFormat::RGBA16F and
+@ref PixelFormat::RGBA32F it uses SSE2 or NEON if enabled at compile time,
+with results bit-exact with the generic code path. For
+comparing large images, the rows can be additionally split among multiple
+threads using @ref setThreadCount(), with @cpp 0 @ce meaning to use as many
+threads as the hardware supports. The calculated deltas, and thus the
+comparison result and diagnostic output, are the same regardless of the thread
+count.
+
+If a comparison is expected to fail often, for example when a large image
+regression suite is run after a change that affects the output everywhere,
+@ref CompareImageFlag::EarlyOut can be used to stop the calculation as soon as
+a pixel delta above the max threshold is found:
+
+@snippet DebugTools.cpp CompareImage-performance
+
 @section DebugTools-CompareImage-specials Special floating-point values
 
 For floating-point input, the comparator treats the values similarly to how
@@ -360,6 +429,34 @@ class CompareImage {
          */
         explicit CompareImage(): _c{0.0f, 0.0f} {}
 
+        /**
+         * @brief Set worker thread count
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * If set to @cpp 0 @ce, uses as many threads as the hardware
+         * supports. Default is @cpp 1 @ce, i.e. doing the whole comparison
+         * on the calling thread. See
+         * @ref DebugTools-CompareImage-performance for more information.
+         */
+        CompareImage& setThreadCount(UnsignedInt count) {
+            _c.setThreadCount(count);
+            return *this;
+        }
+
+        /**
+         * @brief Set comparison flags
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * By default no flags are set. See
+         * @ref DebugTools-CompareImage-performance for more information.
+         */
+        CompareImage& setFlags(CompareImageFlags flags) {
+            _c.setFlags(flags);
+            return *this;
+        }
+
         #ifndef DOXYGEN_GENERATING_OUTPUT
         TestSuite::Comparator<CompareImage>& comparator() {
             return _c;
@@ -475,6 +572,34 @@ class CompareImageFile {
          */
         explicit CompareImageFile(): _c{nullptr, nullptr, 0.0f, 0.0f} {}
 
+        /**
+         * @brief Set worker thread count
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * If set to @cpp 0 @ce, uses as many threads as the hardware
+         * supports. Default is @cpp 1 @ce, i.e. doing the whole comparison
+         * on the calling thread. See
+         * @ref DebugTools-CompareImage-performance for more information.
+         */
+        CompareImageFile& setThreadCount(UnsignedInt count) {
+            _c.setThreadCount(count);
+            return *this;
+        }
+
+        /**
+         * @brief Set comparison flags
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * By default no flags are set. See
+         * @ref DebugTools-CompareImage-performance for more information.
+         */
+        CompareImageFile& setFlags(CompareImageFlags flags) {
+            _c.setFlags(flags);
+            return *this;
+        }
+
         #ifndef DOXYGEN_GENERATING_OUTPUT
         TestSuite::Comparator<CompareImageFile>& comparator() {
             return _c;
@@ -547,6 +672,34 @@ class CompareImageToFile {
          */
         explicit CompareImageToFile(): _c{nullptr, nullptr, 0.0f, 0.0f} {}
 
+        /**
+         * @brief Set worker thread count
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * If set to @cpp 0 @ce, uses as many threads as the hardware
+         * supports. Default is @cpp 1 @ce, i.e. doing the whole comparison
+         * on the calling thread. See
+         * @ref DebugTools-CompareImage-performance for more information.
+         */
+        CompareImageToFile& setThreadCount(UnsignedInt count) {
+            _c.setThreadCount(count);
+            return *this;
+        }
+
+        /**
+         * @brief Set comparison flags
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * By default no flags are set. See
+         * @ref DebugTools-CompareImage-performance for more information.
+         */
+        CompareImageToFile& setFlags(CompareImageFlags flags) {
+            _c.setFlags(flags);
+            return *this;
+        }
+
         #ifndef DOXYGEN_GENERATING_OUTPUT
         TestSuite::Comparator<CompareImageToFile>& comparator() {
             return _c;
@@ -602,6 +755,34 @@ class CompareFileToImage {
          */
         explicit CompareFileToImage(): _c{nullptr, 0.0f, 0.0f} {}
 
+        /**
+         * @brief Set worker thread count
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * If set to @cpp 0 @ce, uses as many threads as the hardware
+         * supports. Default is @cpp 1 @ce, i.e. doing the whole comparison
+         * on the calling thread. See
+         * @ref DebugTools-CompareImage-performance for more information.
+         */
+        CompareFileToImage& setThreadCount(UnsignedInt count) {
+            _c.setThreadCount(count);
+            return *this;
+        }
+
+        /**
+         * @brief Set comparison flags
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * By default no flags are set. See
+         * @ref DebugTools-CompareImage-performance for more information.
+         */
+        CompareFileToImage& setFlags(CompareImageFlags flags) {
+            _c.setFlags(flags);
+            return *this;
+        }
+
         #ifndef DOXYGEN_GENERATING_OUTPUT
         TestSuite::Comparator<CompareFileToImage>& comparator() {
             return _c;
@@ -61,6 +61,10 @@ class ObjectRendererOptions;
 
 class ResourceManager;
 #endif
+
+#ifdef MAGNUM_TARGET_VK
+class FrameProfilerVk;
+#endif
 #endif
 
 }}
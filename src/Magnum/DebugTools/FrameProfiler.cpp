@@ -25,18 +25,24 @@
 
 #include "FrameProfiler.h"
 
+#include <atomic>
 #include <chrono>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/StaticArray.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/Containers/StringIterable.h>
 #include <Corrade/Containers/StringStl.h> /** @todo drop once Debug is stream-free */
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/Utility/Format.h>
+#include <Corrade/Utility/Macros.h> /* CORRADE_THREAD_LOCAL */
 
 #include "Magnum/Math/Functions.h"
 #ifdef MAGNUM_TARGET_GL
+#include "Magnum/GL/OpenGL.h"
 #include "Magnum/GL/TimeQuery.h"
 #ifndef MAGNUM_TARGET_GLES
 #include "Magnum/GL/PipelineStatisticsQuery.h"
@@ -75,7 +81,8 @@ FrameProfiler::FrameProfiler(FrameProfiler&& other) noexcept:
     _maxFrameCount{other._maxFrameCount},
     _measuredFrameCount{other._measuredFrameCount},
     _measurements{Utility::move(other._measurements)},
-    _data{Utility::move(other._data)}
+    _data{Utility::move(other._data)},
+    _scopes{Utility::move(other._scopes)}
 {
     /* For all state pointers that point to &other patch them to point to this
        instead, to account for 90% of use cases of derived classes */
@@ -93,6 +100,7 @@ FrameProfiler& FrameProfiler::operator=(FrameProfiler&& other) noexcept {
     swap(_measuredFrameCount, other._measuredFrameCount);
     swap(_measurements, other._measurements);
     swap(_data, other._data);
+    swap(_scopes, other._scopes);
 
     /* For all state pointers that point to &other patch them to point to this
        instead, to account for 90% of use cases of derived classes */
@@ -107,6 +115,8 @@ FrameProfiler& FrameProfiler::operator=(FrameProfiler&& other) noexcept {
     return *this;
 }
 
+FrameProfiler::~FrameProfiler() = default;
+
 void FrameProfiler::setup(Containers::Array<Measurement>&& measurements, const UnsignedInt maxFrameCount) {
     CORRADE_ASSERT(maxFrameCount >= 1, "DebugTools::FrameProfiler::setup(): max frame count can't be zero", );
 
@@ -153,6 +163,203 @@ void FrameProfiler::disable() {
     _enabled = false;
 }
 
+struct FrameProfiler::ScopeState {
+    struct Event {
+        Containers::StringView name;
+        UnsignedLong begin, end;
+        UnsignedInt depth;
+    };
+
+    /* Ring buffer of events. The count is the total number of events ever
+       recorded, an event with index i is at position i % events.size(). */
+    struct Track {
+        explicit Track(std::thread::id thread, std::size_t capacity): thread{thread}, events{ValueInit, capacity} {}
+
+        std::thread::id thread;
+        Containers::Array<Event> events;
+        std::size_t count{};
+        /* Event indices of scopes that didn't end yet, or ~std::size_t{} for
+           scopes begun while the profiler was disabled so the corresponding
+           endScope() doesn't end an outer scope. The skipped count is
+           subtracted from the depth of newly recorded events. */
+        Containers::Array<std::size_t> open;
+        std::size_t skipped{};
+    };
+
+    explicit ScopeState(std::size_t capacity): id{++nextId}, capacity{capacity}, epoch{std::chrono::steady_clock::now()}, gpu{std::thread::id{}, capacity} {}
+
+    UnsignedLong time() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    Track& threadTrack();
+
+    static void chromeTraceTrack(Containers::Array<char>& out, UnsignedInt tid, Containers::StringView name, const Track& track);
+
+    static void add(Track& track, Containers::StringView name, UnsignedInt depth, UnsignedLong begin, UnsignedLong end) {
+        Event& event = track.events[track.count++ % track.events.size()];
+        event.name = name;
+        event.begin = begin;
+        event.end = end;
+        event.depth = depth;
+    }
+
+    /* Used to invalidate the thread-local track cache in case a profiler gets
+       destroyed and another created at the same address */
+    static std::atomic<UnsignedLong> nextId;
+
+    UnsignedLong id;
+    std::size_t capacity;
+    std::chrono::steady_clock::time_point epoch;
+    /* Registration of new threads is the only thing that needs locking */
+    std::mutex mutex;
+    Containers::Array<Containers::Pointer<Track>> threads;
+    Track gpu;
+};
+
+std::atomic<UnsignedLong> FrameProfiler::ScopeState::nextId{};
+
+namespace {
+
+/* Caches the track found for a profiler last used on this thread, so the
+   mutex only needs to be taken on first use from a particular thread or when
+   alternating between several profilers */
+struct ThreadTrackCache {
+    UnsignedLong id;
+    void* track;
+};
+
+CORRADE_THREAD_LOCAL ThreadTrackCache threadTrackCache{};
+
+}
+
+auto FrameProfiler::ScopeState::threadTrack() -> Track& {
+    if(threadTrackCache.id == id)
+        return *static_cast<Track*>(threadTrackCache.track);
+
+    const std::thread::id thread = std::this_thread::get_id();
+    Track* found = nullptr;
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        for(Containers::Pointer<Track>& track: threads) if(track->thread == thread) {
+            found = track.get();
+            break;
+        }
+        if(!found)
+            found = arrayAppend(threads, Containers::pointer<Track>(thread, capacity)).get();
+    }
+
+    threadTrackCache.id = id;
+    threadTrackCache.track = found;
+    return *found;
+}
+
+std::size_t FrameProfiler::scopeBufferSize() const {
+    return _scopes ? _scopes->capacity : 0;
+}
+
+void FrameProfiler::setScopeBufferSize(const std::size_t size) {
+    if(size) _scopes.emplace(size);
+    else _scopes = nullptr;
+}
+
+void FrameProfiler::beginScope(const Containers::StringView name) {
+    if(!_scopes) return;
+
+    ScopeState::Track& track = _scopes->threadTrack();
+    if(!_enabled) {
+        arrayAppend(track.open, ~std::size_t{});
+        ++track.skipped;
+        return;
+    }
+
+    arrayAppend(track.open, track.count);
+    ScopeState::add(track, name, track.open.size() - track.skipped - 1, _scopes->time(), ~UnsignedLong{});
+}
+
+void FrameProfiler::endScope() {
+    if(!_scopes) return;
+
+    const UnsignedLong time = _scopes->time();
+    ScopeState::Track& track = _scopes->threadTrack();
+    if(track.open.isEmpty()) return;
+
+    /* If the scope wasn't recorded, there's nothing to end. Otherwise update
+       the end time only if the event wasn't overwritten in the meantime. */
+    const std::size_t index = track.open.back();
+    arrayRemoveSuffix(track.open, 1);
+    if(index == ~std::size_t{}) {
+        --track.skipped;
+        return;
+    }
+    if(track.count - index <= track.events.size())
+        track.events[index % track.events.size()].end = time;
+}
+
+UnsignedLong FrameProfiler::scopeTime() const {
+    return _scopes ? _scopes->time() : 0;
+}
+
+UnsignedLong FrameProfiler::scopeEpoch() const {
+    return _scopes ? _scopes->id : 0;
+}
+
+void FrameProfiler::addGpuScope(const Containers::StringView name, const UnsignedInt depth, const UnsignedLong begin, const UnsignedLong end) {
+    if(!_scopes) return;
+
+    ScopeState::add(_scopes->gpu, name, depth, begin, end);
+}
+
+namespace {
+
+void appendString(Containers::Array<char>& out, const Containers::StringView string) {
+    arrayAppend(out, Containers::arrayView(string.data(), string.size()));
+}
+
+}
+
+void FrameProfiler::ScopeState::chromeTraceTrack(Containers::Array<char>& out, const UnsignedInt tid, const Containers::StringView name, const Track& track) {
+    /* Name the track. Every event is prefixed with a comma, chromeTrace()
+       then removes the first one. */
+    appendString(out, Utility::format(",\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}", tid, name));
+
+    const std::size_t size = Math::min(track.count, track.events.size());
+    for(std::size_t i = track.count - size; i != track.count; ++i) {
+        const Event& event = track.events[i % track.events.size()];
+        /* Scope didn't end yet */
+        if(event.end == ~UnsignedLong{}) continue;
+
+        appendString(out, ",\n{\"name\":\""_s);
+
+        /* Escape characters that would break the JSON */
+        for(const char c: event.name) {
+            if(c == '"' || c == '\\') arrayAppend(out, {'\\', c});
+            else if(UnsignedByte(c) < 0x20) arrayAppend(out, ' ');
+            else arrayAppend(out, c);
+        }
+
+        /* Timestamps are in microseconds */
+        appendString(out, Utility::format("\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f},\"args\":{{\"depth\":{}}}}}", tid, event.begin/1000.0, (event.end - event.begin)/1000.0, event.depth));
+    }
+}
+
+Containers::String FrameProfiler::chromeTrace() const {
+    Containers::Array<char> out;
+    appendString(out, "{\"traceEvents\":["_s);
+    const std::size_t headerSize = out.size();
+    if(_scopes) {
+        for(std::size_t i = 0; i != _scopes->threads.size(); ++i)
+            ScopeState::chromeTraceTrack(out, i, Utility::format("Thread {}", i), *_scopes->threads[i]);
+        if(_scopes->gpu.count)
+            ScopeState::chromeTraceTrack(out, _scopes->threads.size(), "GPU"_s, _scopes->gpu);
+    }
+    /* Replace the comma in front of the first event, if any */
+    if(out.size() != headerSize) out[headerSize] = ' ';
+
+    appendString(out, "\n],\"displayTimeUnit\":\"ns\"}\n"_s);
+    return Containers::String{out.data(), out.size()};
+}
+
 void FrameProfiler::beginFrame() {
     if(!_enabled) return;
 
@@ -450,8 +657,74 @@ struct FrameProfilerGL::State {
     Containers::StaticArray<QueryCount, GL::PipelineStatisticsQuery> clippingInputPrimitivesQueries{DirectInit, NoCreate};
     Containers::StaticArray<QueryCount, GL::PipelineStatisticsQuery> clippingOutputPrimitivesQueries{DirectInit, NoCreate};
     #endif
+
+    /* GPU scopes. Timestamp queries are taken from a pool that grows as
+       needed, scopes that ended are put into a FIFO and retrieved once their
+       results are available. */
+    struct GpuScope {
+        Containers::StringView name;
+        UnsignedInt depth;
+        UnsignedInt begin, end;
+    };
+    Containers::Array<GL::TimeQuery> gpuScopeQueries;
+    Containers::Array<UnsignedInt> gpuScopeFreeQueries;
+    /* Scopes begun while the profiler was disabled are put here with begin
+       set to ~UnsignedInt{} so the corresponding endGpuScope() doesn't end
+       an outer scope, and counted in gpuScopesSkipped */
+    Containers::Array<GpuScope> gpuScopesOpen;
+    UnsignedInt gpuScopesSkipped{};
+    Containers::Array<GpuScope> gpuScopesPending;
+    std::size_t gpuScopesPendingOffset{};
+    /* Offset to add to GPU timestamps to convert them to scopeTime(). Signed
+       as the GPU clock can be both ahead and behind. */
+    bool gpuScopeTimeCalibrated{};
+    Long gpuScopeTimeOffset{};
+    #ifdef MAGNUM_TARGET_GLES
+    UnsignedLong gpuScopeFirstCpuTime;
+    UnsignedInt gpuScopeFirstQuery{~UnsignedInt{}};
+    #endif
+    /* FrameProfiler::scopeEpoch() the calibration and scopes above are
+       relative to */
+    UnsignedLong gpuScopeEpoch{};
+
+    UnsignedInt acquireGpuScopeQuery();
+    void resetGpuScopes(UnsignedLong epoch);
 };
 
+UnsignedInt FrameProfilerGL::State::acquireGpuScopeQuery() {
+    UnsignedInt id;
+    if(!gpuScopeFreeQueries.isEmpty()) {
+        id = gpuScopeFreeQueries.back();
+        arrayRemoveSuffix(gpuScopeFreeQueries, 1);
+    } else {
+        id = gpuScopeQueries.size();
+        arrayAppend(gpuScopeQueries, InPlaceInit, GL::TimeQuery::Target::Timestamp);
+    }
+    gpuScopeQueries[id].timestamp();
+    return id;
+}
+
+void FrameProfilerGL::State::resetGpuScopes(const UnsignedLong epoch) {
+    /* Scopes that are open or not retrieved yet are in the old time base, so
+       drop them and return their queries to the pool. Reissuing a timestamp
+       on a query whose result wasn't retrieved is fine. */
+    for(const GpuScope& scope: gpuScopesOpen) if(scope.begin != ~UnsignedInt{})
+        arrayAppend(gpuScopeFreeQueries, scope.begin);
+    for(std::size_t i = gpuScopesPendingOffset; i != gpuScopesPending.size(); ++i)
+        arrayAppend(gpuScopeFreeQueries, {gpuScopesPending[i].begin, gpuScopesPending[i].end});
+    arrayResize(gpuScopesOpen, 0);
+    gpuScopesSkipped = 0;
+    arrayResize(gpuScopesPending, 0);
+    gpuScopesPendingOffset = 0;
+
+    gpuScopeTimeCalibrated = false;
+    gpuScopeTimeOffset = 0;
+    #ifdef MAGNUM_TARGET_GLES
+    gpuScopeFirstQuery = ~UnsignedInt{};
+    #endif
+    gpuScopeEpoch = epoch;
+}
+
 FrameProfilerGL::FrameProfilerGL(): _state{InPlaceInit} {}
 
 FrameProfilerGL::FrameProfilerGL(const Values values, const UnsignedInt maxFrameCount): FrameProfilerGL{}
@@ -576,6 +849,107 @@ void FrameProfilerGL::setup(const Values values, const UnsignedInt maxFrameCount
     setup(Utility::move(measurements), maxFrameCount);
 }
 
+void FrameProfilerGL::beginGpuScope(const Containers::StringView name) {
+    if(!scopeBufferSize()) return;
+
+    if(!isEnabled()) {
+        if(_state->gpuScopeEpoch != scopeEpoch())
+            _state->resetGpuScopes(scopeEpoch());
+        arrayAppend(_state->gpuScopesOpen, State::GpuScope{name, 0, ~UnsignedInt{}, ~UnsignedInt{}});
+        ++_state->gpuScopesSkipped;
+        return;
+    }
+
+    /* Retrieve whatever got finished since last time so the pending list and
+       the query pool don't grow indefinitely. This also discards everything
+       recorded against a previous scope buffer. */
+    retrieveGpuScopes();
+
+    if(!_state->gpuScopeTimeCalibrated) {
+        /* On desktop the current GPU time can be queried directly, getting
+           a precise offset. Elsewhere remember the CPU time of the first
+           scope and align it with its GPU timestamp once available. */
+        #ifndef MAGNUM_TARGET_GLES
+        GLint64 gpuTime;
+        glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+        _state->gpuScopeTimeOffset = Long(scopeTime()) - gpuTime;
+        _state->gpuScopeTimeCalibrated = true;
+        #endif
+    }
+
+    const UnsignedInt begin = _state->acquireGpuScopeQuery();
+    #ifdef MAGNUM_TARGET_GLES
+    if(!_state->gpuScopeTimeCalibrated && _state->gpuScopeFirstQuery == ~UnsignedInt{}) {
+        _state->gpuScopeFirstCpuTime = scopeTime();
+        _state->gpuScopeFirstQuery = begin;
+    }
+    #endif
+
+    arrayAppend(_state->gpuScopesOpen, State::GpuScope{name, UnsignedInt(_state->gpuScopesOpen.size()) - _state->gpuScopesSkipped, begin, ~UnsignedInt{}});
+}
+
+void FrameProfilerGL::endGpuScope() {
+    /* If the scope buffer got recreated since the scope began, it's
+       discarded */
+    if(_state->gpuScopeEpoch != scopeEpoch())
+        _state->resetGpuScopes(scopeEpoch());
+    if(_state->gpuScopesOpen.isEmpty()) return;
+
+    State::GpuScope scope = _state->gpuScopesOpen.back();
+    arrayRemoveSuffix(_state->gpuScopesOpen, 1);
+    /* The scope wasn't recorded, nothing to end */
+    if(scope.begin == ~UnsignedInt{}) {
+        --_state->gpuScopesSkipped;
+        return;
+    }
+    scope.end = _state->acquireGpuScopeQuery();
+    arrayAppend(_state->gpuScopesPending, scope);
+}
+
+void FrameProfilerGL::retrieveGpuScopes() {
+    /* If the scope buffer got recreated, everything recorded so far is in a
+       different time base */
+    State& state = *_state;
+    if(state.gpuScopeEpoch != scopeEpoch())
+        state.resetGpuScopes(scopeEpoch());
+
+    /* Queries finish in order, so stop at the first one that's not available
+       yet */
+    while(state.gpuScopesPendingOffset != state.gpuScopesPending.size()) {
+        const State::GpuScope& scope = state.gpuScopesPending[state.gpuScopesPendingOffset];
+        GL::TimeQuery& end = state.gpuScopeQueries[scope.end];
+        if(!end.resultAvailable()) break;
+
+        const UnsignedLong beginTime = state.gpuScopeQueries[scope.begin].result<UnsignedLong>();
+        const UnsignedLong endTime = end.result<UnsignedLong>();
+
+        /* The first retrieved scope may be nested in the first issued one,
+           whose begin query is however still not released at this point */
+        #ifdef MAGNUM_TARGET_GLES
+        if(!state.gpuScopeTimeCalibrated) {
+            state.gpuScopeTimeOffset = Long(state.gpuScopeFirstCpuTime) - state.gpuScopeQueries[state.gpuScopeFirstQuery].result<Long>();
+            state.gpuScopeTimeCalibrated = true;
+        }
+        #endif
+
+        addGpuScope(scope.name, scope.depth, beginTime + state.gpuScopeTimeOffset, endTime + state.gpuScopeTimeOffset);
+
+        arrayAppend(state.gpuScopeFreeQueries, {scope.begin, scope.end});
+        ++state.gpuScopesPendingOffset;
+    }
+
+    /* If everything got retrieved, reset the FIFO to reuse its memory */
+    if(state.gpuScopesPendingOffset == state.gpuScopesPending.size()) {
+        arrayResize(state.gpuScopesPending, 0);
+        state.gpuScopesPendingOffset = 0;
+    }
+}
+
+Containers::String FrameProfilerGL::chromeTrace() {
+    retrieveGpuScopes();
+    return FrameProfiler::chromeTrace();
+}
+
 auto FrameProfilerGL::values() const -> Values {
     Values values;
     if(_state->frameTimeIndex != 0xffff) values |= Value::FrameTime;
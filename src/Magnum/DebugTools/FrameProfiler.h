@@ -33,6 +33,7 @@
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Pointer.h>
 #include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/DebugTools/visibility.h"
@@ -126,6 +127,32 @@ parameters passed to each callback:
     If you don't or can't use @cpp this @ce as a state pointer, you need to
     either provide a dedicated move constructor and assignment to do the
     required patching or disable moves altogether to avoid accidents.
+
+@section DebugTools-FrameProfiler-scopes Hierarchical scopes
+
+Besides the flat per-frame measurements, the profiler can record nested named
+CPU scopes, for example to find out how much a particular cascade of a shadow
+pass takes. Scope recording is disabled by default, enable it by setting a
+per-thread event buffer size with @ref setScopeBufferSize() and then either
+call @ref beginScope() / @ref endScope() pairs directly, or use the
+@ref MAGNUM_DEBUGTOOLS_PROFILE_SCOPE() macro that creates a @ref Scope
+instance for the rest of the enclosing C++ scope:
+
+@snippet DebugTools.cpp FrameProfiler-scopes
+
+Each thread records into its own ring buffer, so recording a scope involves
+no locking except for the first scope recorded from a particular thread. Once
+the ring buffer is full, the oldest events get overwritten. The recorded
+scopes can be exported with @ref chromeTrace() to a JSON file that can be
+opened in [Chrome's about:tracing](https://www.chromium.org/developers/how-tos/trace-event-profiling-tool/)
+or [Perfetto](https://ui.perfetto.dev/), with one track for each thread.
+
+If @cpp MAGNUM_DEBUGTOOLS_NO_PROFILE_SCOPES @ce is defined before including
+this header, the @ref MAGNUM_DEBUGTOOLS_PROFILE_SCOPE() macro expands to
+nothing, not evaluating its arguments either, so the instrumentation can be
+left in the code at no cost in release builds. The @ref FrameProfilerGL
+subclass additionally provides GPU scopes, see
+@ref DebugTools-FrameProfilerGL-scopes.
 */
 class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
     public:
@@ -171,6 +198,7 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
         };
 
         class Measurement;
+        class Scope;
 
         /**
          * @brief Default constructor
@@ -202,6 +230,9 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
         /** @brief Move assignment */
         FrameProfiler& operator=(FrameProfiler&&) noexcept;
 
+        /** @brief Destructor */
+        ~FrameProfiler();
+
         /**
          * @brief Setup measurements
          * @param measurements  List of measurements
@@ -402,7 +433,113 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
             printStatistics(out, frequency);
         }
 
+        /**
+         * @brief Per-thread scope buffer size
+         * @m_since_latest
+         *
+         * Count of scope events each thread can record before the oldest
+         * ones get overwritten. If @cpp 0 @ce, scope recording is disabled.
+         * Default is @cpp 0 @ce.
+         * @see @ref DebugTools-FrameProfiler-scopes
+         */
+        std::size_t scopeBufferSize() const;
+
+        /**
+         * @brief Set per-thread scope buffer size
+         * @m_since_latest
+         *
+         * Discards all scopes recorded so far. Setting the size to @cpp 0 @ce
+         * disables scope recording. Expects that no scopes are being
+         * recorded on any thread during this call.
+         * @see @ref DebugTools-FrameProfiler-scopes
+         */
+        void setScopeBufferSize(std::size_t size);
+
+        /**
+         * @brief Begin a CPU scope
+         * @m_since_latest
+         *
+         * Records current time and @p name into a buffer specific to the
+         * calling thread and increases the nesting depth for given thread.
+         * Has to be paired with a corresponding @ref endScope() call from the
+         * same thread. The @p name is only referenced, not copied, so it's
+         * expected to stay in scope until @ref chromeTrace() is called, which
+         * is trivially satisfied for string literals. If
+         * @ref scopeBufferSize() is @cpp 0 @ce, the function is a no-op. If
+         * the profiler is disabled, nothing is recorded, but the matching
+         * @ref endScope() call is still tracked.
+         * @see @ref isEnabled(), @ref Scope,
+         *      @ref MAGNUM_DEBUGTOOLS_PROFILE_SCOPE()
+         */
+        void beginScope(Containers::StringView name);
+
+        /**
+         * @brief End a CPU scope
+         * @m_since_latest
+         *
+         * Records current time for the innermost scope opened with
+         * @ref beginScope() from the calling thread. If the matching
+         * @ref beginScope() was a no-op because the profiler was disabled,
+         * the function is a no-op as well, independently of whether the
+         * profiler is enabled now. Scopes begun while disabled aren't counted
+         * into the nesting depth of the recorded ones. If there's no such
+         * scope, the function is a no-op.
+         */
+        void endScope();
+
+        /**
+         * @brief Export recorded scopes as a Chrome trace
+         * @m_since_latest
+         *
+         * Returns a JSON in the [Trace Event Format](https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/),
+         * with a track for each thread that recorded a scope, and an
+         * additional GPU track if a subclass provides GPU scopes. Scopes that
+         * didn't end yet are not included. Expects that no scopes are being
+         * recorded on any thread during this call. If scope recording is
+         * disabled, returns a trace with no events.
+         */
+        Containers::String chromeTrace() const;
+
+    protected:
+        /**
+         * @brief Time used for scope recording
+         * @m_since_latest
+         *
+         * Nanoseconds since scope recording was enabled with
+         * @ref setScopeBufferSize(). Meant to be used by subclasses for
+         * calibrating device timestamps passed to @ref addGpuScope(). If
+         * scope recording is disabled, returns @cpp 0 @ce.
+         */
+        UnsignedLong scopeTime() const;
+
+        /**
+         * @brief Scope time epoch
+         * @m_since_latest
+         *
+         * Identifies the time base of @ref scopeTime(). A different value is
+         * returned every time @ref setScopeBufferSize() recreates the scope
+         * buffers, meaning subclasses have to discard their timestamp
+         * calibration and all device scopes recorded until then. If scope
+         * recording is disabled, returns @cpp 0 @ce.
+         */
+        UnsignedLong scopeEpoch() const;
+
+        /**
+         * @brief Add a completed GPU scope
+         * @m_since_latest
+         *
+         * Meant to be used by subclasses for recording scopes measured on a
+         * device with a delay. The @p begin and @p end times are expected to
+         * be in the same time base as @ref scopeTime(). The scopes get
+         * exported in a dedicated GPU track by @ref chromeTrace(). The @p name
+         * is referenced the same way as in @ref beginScope(). If scope
+         * recording is disabled, the function is a no-op.
+         */
+        void addGpuScope(Containers::StringView name, UnsignedInt depth, UnsignedLong begin, UnsignedLong end);
+
     private:
+        struct ScopeState;
+
         UnsignedInt delayedCurrentData(UnsignedInt delay) const;
         Double measurementMeanInternal(const Measurement& measurement) const;
         void printStatisticsInternal(Debug& out) const;
@@ -416,6 +553,7 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
         UnsignedInt _maxFrameCount{1}, _measuredFrameCount{};
         Containers::Array<Measurement> _measurements;
         Containers::Array<UnsignedLong> _data;
+        Containers::Pointer<ScopeState> _scopes;
 };
 
 /**
@@ -504,6 +642,64 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler::Measurement {
         UnsignedLong _movingSum{};
 };
 
+/**
+@brief Scope
+@m_since_latest
+
+Calls @ref FrameProfiler::beginScope() on construction and
+@ref FrameProfiler::endScope() on destruction. Usually created through the
+@ref MAGNUM_DEBUGTOOLS_PROFILE_SCOPE() macro. See
+@ref DebugTools-FrameProfiler-scopes for more information.
+*/
+class FrameProfiler::Scope {
+    public:
+        /** @brief Constructor */
+        explicit Scope(FrameProfiler& profiler, Containers::StringView name): _profiler(profiler) {
+            profiler.beginScope(name);
+        }
+
+        /** @brief Copying is not allowed */
+        Scope(const Scope&) = delete;
+
+        /** @brief Moving is not allowed */
+        Scope(Scope&&) = delete;
+
+        /** @brief Destructor */
+        ~Scope() { _profiler.endScope(); }
+
+        /** @brief Copying is not allowed */
+        Scope& operator=(const Scope&) = delete;
+
+        /** @brief Moving is not allowed */
+        Scope& operator=(Scope&&) = delete;
+
+    private:
+        FrameProfiler& _profiler;
+};
+
+/**
+@brief Profile a scope
+@m_since_latest
+
+Creates a @ref DebugTools::FrameProfiler::Scope "FrameProfiler::Scope" instance
+measuring the rest of the enclosing C++ scope, with @p name being passed to
+@ref DebugTools::FrameProfiler::beginScope() "FrameProfiler::beginScope()". If
+@cpp MAGNUM_DEBUGTOOLS_NO_PROFILE_SCOPES @ce is defined, expands to nothing.
+See @ref DebugTools-FrameProfiler-scopes for more information.
+*/
+#if !defined(MAGNUM_DEBUGTOOLS_NO_PROFILE_SCOPES) || defined(DOXYGEN_GENERATING_OUTPUT)
+#define MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, name)                     \
+    ::Magnum::DebugTools::FrameProfiler::Scope _MAGNUM_DEBUGTOOLS_PROFILE_SCOPE_NAME(__LINE__){profiler, name}
+#else
+#define MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, name)
+#endif
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+/* Two levels of indirection needed to expand __LINE__ before concatenating */
+#define _MAGNUM_DEBUGTOOLS_PROFILE_SCOPE_NAME(line) _MAGNUM_DEBUGTOOLS_PROFILE_SCOPE_NAME_IMPLEMENTATION(line)
+#define _MAGNUM_DEBUGTOOLS_PROFILE_SCOPE_NAME_IMPLEMENTATION(line) _magnumDebugToolsProfileScope ## line
+#endif
+
 /**
 @debugoperatorclassenum{FrameProfiler,FrameProfiler::Units}
 @m_since{2020,06}
@@ -525,6 +721,24 @@ If none if @ref Value::GpuDuration, @ref Value::VertexFetchRatio and
 @ref Value::PrimitiveClipRatio is not enabled, the class can operate without an
 active OpenGL context.
 
+@section DebugTools-FrameProfilerGL-scopes GPU scopes
+
+In addition to the CPU scopes described in
+@ref DebugTools-FrameProfiler-scopes, GPU time of nested scopes can be
+measured with @ref beginGpuScope() / @ref endGpuScope() or the
+@ref MAGNUM_DEBUGTOOLS_PROFILE_GPU_SCOPE() macro. Each scope issues a
+@ref GL::TimeQuery::timestamp() at its beginning and end, with the queries
+taken from a pool that grows as needed. Results are retrieved without
+stalling once they become available, which is checked in each
+@ref beginGpuScope() and in @ref chromeTrace(), and get exported in a
+dedicated GPU track of @ref chromeTrace(). On desktop GL the GPU timestamps
+are calibrated against the CPU clock, elsewhere the GPU track is aligned to
+the time the first GPU scope was issued on the CPU, so it may appear slightly
+earlier than it really happened. GPU scopes are recorded only if
+@ref scopeBufferSize() is non-zero, and need an active OpenGL context with
+@gl_extension{ARB,timer_query} (part of OpenGL 3.3) or
+@gl_extension{EXT,disjoint_timer_query} on OpenGL ES and WebGL.
+
 @experimental
 */
 class MAGNUM_DEBUGTOOLS_EXPORT FrameProfilerGL: public FrameProfiler {
@@ -709,15 +923,113 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfilerGL: public FrameProfiler {
         Double primitiveClipRatioMean() const;
         #endif
 
+        class GpuScope;
+
+        /**
+         * @brief Begin a GPU scope
+         * @m_since_latest
+         *
+         * Issues a timestamp query and increases the GPU scope nesting depth.
+         * Has to be paired with a corresponding @ref endGpuScope() call. The
+         * @p name is referenced the same way as in @ref beginScope(). If
+         * @ref scopeBufferSize() is @cpp 0 @ce, the function is a no-op. If
+         * the profiler is disabled, no query is issued, but the matching
+         * @ref endGpuScope() call is still tracked. See
+         * @ref DebugTools-FrameProfilerGL-scopes for more information.
+         * @see @ref GpuScope, @ref MAGNUM_DEBUGTOOLS_PROFILE_GPU_SCOPE()
+         */
+        void beginGpuScope(Containers::StringView name);
+
+        /**
+         * @brief End a GPU scope
+         * @m_since_latest
+         *
+         * Issues a timestamp query for the innermost scope opened with
+         * @ref beginGpuScope(). Scopes begun while the profiler was disabled
+         * are matched the same way as in @ref endScope(). If there's no such
+         * scope, the function is a no-op.
+         */
+        void endGpuScope();
+
+        /**
+         * @brief Export recorded CPU and GPU scopes as a Chrome trace
+         * @m_since_latest
+         *
+         * Retrieves results of all GPU scopes that are available and then
+         * delegates to @ref FrameProfiler::chromeTrace().
+         */
+        Containers::String chromeTrace();
+
+        using FrameProfiler::chromeTrace;
+
     private:
         using FrameProfiler::setup;
 
+        void MAGNUM_DEBUGTOOLS_LOCAL retrieveGpuScopes();
+
         struct State;
         Containers::Pointer<State> _state;
 };
 
 CORRADE_ENUMSET_OPERATORS(FrameProfilerGL::Values)
 
+/**
+@brief GPU scope
+@m_since_latest
+
+Calls @ref FrameProfilerGL::beginGpuScope() on construction and
+@ref FrameProfilerGL::endGpuScope() on destruction. Usually created through
+the @ref MAGNUM_DEBUGTOOLS_PROFILE_GPU_SCOPE() macro. See
+@ref DebugTools-FrameProfilerGL-scopes for more information.
+*/
+class FrameProfilerGL::GpuScope {
+    public:
+        /** @brief Constructor */
+        explicit GpuScope(FrameProfilerGL& profiler, Containers::StringView name): _profiler(profiler) {
+            profiler.beginGpuScope(name);
+        }
+
+        /** @brief Copying is not allowed */
+        GpuScope(const GpuScope&) = delete;
+
+        /** @brief Moving is not allowed */
+        GpuScope(GpuScope&&) = delete;
+
+        /** @brief Destructor */
+        ~GpuScope() { _profiler.endGpuScope(); }
+
+        /** @brief Copying is not allowed */
+        GpuScope& operator=(const GpuScope&) = delete;
+
+        /** @brief Moving is not allowed */
+        GpuScope& operator=(GpuScope&&) = delete;
+
+    private:
+        FrameProfilerGL& _profiler;
+};
+
+/**
+@brief Profile a GPU scope
+@m_since_latest
+
+Creates a @ref DebugTools::FrameProfilerGL::GpuScope "FrameProfilerGL::GpuScope"
+instance measuring the rest of the enclosing C++ scope, with @p name being
+passed to @ref DebugTools::FrameProfilerGL::beginGpuScope() "FrameProfilerGL::beginGpuScope()".
+If @cpp MAGNUM_DEBUGTOOLS_NO_PROFILE_SCOPES @ce is defined, expands to
+nothing. See @ref DebugTools-FrameProfilerGL-scopes for more information.
+*/
+#if !defined(MAGNUM_DEBUGTOOLS_NO_PROFILE_SCOPES) || defined(DOXYGEN_GENERATING_OUTPUT)
+#define MAGNUM_DEBUGTOOLS_PROFILE_GPU_SCOPE(profiler, name)                 \
+    ::Magnum::DebugTools::FrameProfilerGL::GpuScope _MAGNUM_DEBUGTOOLS_PROFILE_GPU_SCOPE_NAME(__LINE__){profiler, name}
+#else
+#define MAGNUM_DEBUGTOOLS_PROFILE_GPU_SCOPE(profiler, name)
+#endif
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#define _MAGNUM_DEBUGTOOLS_PROFILE_GPU_SCOPE_NAME(line) _MAGNUM_DEBUGTOOLS_PROFILE_GPU_SCOPE_NAME_IMPLEMENTATION(line)
+#define _MAGNUM_DEBUGTOOLS_PROFILE_GPU_SCOPE_NAME_IMPLEMENTATION(line) _magnumDebugToolsProfileGpuScope ## line
+#endif
+
 /**
 @debugoperatorclassenum{FrameProfilerGL,FrameProfilerGL::Value}
 @m_since{2020,06}
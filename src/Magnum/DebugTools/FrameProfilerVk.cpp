@@ -0,0 +1,360 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FrameProfilerVk.h"
+
+#include <chrono>
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StringView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/QueryPoolCreateInfo.h"
+
+namespace Magnum { namespace DebugTools {
+
+using namespace Containers::Literals;
+
+struct FrameProfilerVk::State {
+    UnsignedShort cpuDurationIndex = 0xffff,
+        gpuDurationIndex = 0xffff,
+        frameTimeIndex = 0xffff,
+        vertexFetchRatioIndex = 0xffff,
+        primitiveClipRatioIndex = 0xffff;
+    UnsignedInt framesInFlight = 2;
+    UnsignedLong frameTimeStartFrame[2];
+    UnsignedLong cpuDurationStartFrame;
+
+    /* Two timestamps for each frame in the ring */
+    Vk::QueryPool timestampQueries{NoCreate};
+    Float timestampPeriod{};
+
+    /* A single pipeline statistics query for each frame in the ring, shared
+       by both vertex fetch and primitive clip ratio, as there can't be two
+       pipeline statistics queries active at the same time. The order of
+       values is given by the QueryPipelineStatistic bit order. */
+    Vk::QueryPool statisticsQueries{NoCreate};
+
+    /* Command buffer passed to beginFrame() / endFrame(), valid only for the
+       duration of the call */
+    Vk::CommandBuffer* commandBuffer{};
+    #ifndef CORRADE_NO_ASSERT
+    VkCommandBuffer statisticsCommandBuffer{};
+    #endif
+
+    bool hasGpuValues() const {
+        return gpuDurationIndex != 0xffff ||
+               vertexFetchRatioIndex != 0xffff ||
+               primitiveClipRatioIndex != 0xffff;
+    }
+
+    void beginStatistics(UnsignedInt current);
+    void endStatistics(UnsignedInt current);
+    void queryStatistics(UnsignedInt previous, UnsignedLong(&out)[4]);
+};
+
+void FrameProfilerVk::State::beginStatistics(const UnsignedInt current) {
+    CORRADE_INTERNAL_ASSERT(commandBuffer);
+    commandBuffer->resetQueryPool(statisticsQueries, current, 1)
+        .beginQuery(statisticsQueries, current);
+}
+
+void FrameProfilerVk::State::endStatistics(const UnsignedInt current) {
+    CORRADE_INTERNAL_ASSERT(commandBuffer);
+    commandBuffer->endQuery(statisticsQueries, current);
+}
+
+void FrameProfilerVk::State::queryStatistics(const UnsignedInt previous, UnsignedLong(&out)[4]) {
+    /* With the frame pacing described in the docs the query is finished
+       already, so the wait is a no-op */
+    statisticsQueries.results(previous, 1, out, Vk::QueryResultFlag::Wait);
+}
+
+FrameProfilerVk::FrameProfilerVk(): _state{InPlaceInit} {}
+
+FrameProfilerVk::FrameProfilerVk(Vk::Device& device, const Values values, const UnsignedInt maxFrameCount, const UnsignedInt framesInFlight): FrameProfilerVk{} {
+    setup(device, values, maxFrameCount, framesInFlight);
+}
+
+FrameProfilerVk::FrameProfilerVk(FrameProfilerVk&&) noexcept = default;
+
+FrameProfilerVk& FrameProfilerVk::operator=(FrameProfilerVk&&) noexcept = default;
+
+FrameProfilerVk::~FrameProfilerVk() = default;
+
+void FrameProfilerVk::setup(Vk::Device& device, const Values values, const UnsignedInt maxFrameCount, const UnsignedInt framesInFlight) {
+    CORRADE_ASSERT(framesInFlight,
+        "DebugTools::FrameProfilerVk::setup(): expected non-zero frames in flight", );
+
+    /* Reset everything from a potential previous setup. The measurements
+       reference the state through a pointer that stays the same. */
+    *_state = State{};
+    _state->framesInFlight = framesInFlight;
+
+    /* One more slot than frames in flight for the frame being recorded */
+    const UnsignedInt delay = framesInFlight + 1;
+
+    UnsignedShort index = 0;
+    Containers::Array<Measurement> measurements;
+    if(values & Value::FrameTime) {
+        arrayAppend(measurements, InPlaceInit,
+            "Frame time"_s, Units::Nanoseconds, UnsignedInt(Containers::arraySize(_state->frameTimeStartFrame)),
+            [](void* state, UnsignedInt current) {
+                static_cast<State*>(state)->frameTimeStartFrame[current] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+            },
+            [](void*, UnsignedInt) {},
+            [](void* state, UnsignedInt previous, UnsignedInt current) {
+                auto& self = *static_cast<State*>(state);
+                return self.frameTimeStartFrame[current] -
+                    self.frameTimeStartFrame[previous];
+            }, _state.get());
+        _state->frameTimeIndex = index++;
+    }
+    if(values & Value::CpuDuration) {
+        arrayAppend(measurements, InPlaceInit,
+            "CPU duration"_s, Units::Nanoseconds,
+            [](void* state) {
+                static_cast<State*>(state)->cpuDurationStartFrame = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+            },
+            [](void* state) {
+                /* libc++ 10 needs an explicit cast to UnsignedLong */
+                return UnsignedLong(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count() - static_cast<State*>(state)->cpuDurationStartFrame);
+            }, _state.get());
+        _state->cpuDurationIndex = index++;
+    }
+    if(values & Value::GpuDuration) {
+        _state->timestampQueries = Vk::QueryPool{device, Vk::QueryPoolCreateInfo{Vk::QueryType::Timestamp, 2*delay}};
+        _state->timestampPeriod = device.properties().properties().properties.limits.timestampPeriod;
+        arrayAppend(measurements, InPlaceInit,
+            "GPU duration"_s, Units::Nanoseconds, delay,
+            [](void* state, UnsignedInt current) {
+                auto& self = *static_cast<State*>(state);
+                CORRADE_INTERNAL_ASSERT(self.commandBuffer);
+                self.commandBuffer->resetQueryPool(self.timestampQueries, current*2, 2)
+                    .writeTimestamp(Vk::PipelineStage::TopOfPipe, self.timestampQueries, current*2);
+            },
+            [](void* state, UnsignedInt current) {
+                auto& self = *static_cast<State*>(state);
+                CORRADE_INTERNAL_ASSERT(self.commandBuffer);
+                self.commandBuffer->writeTimestamp(Vk::PipelineStage::BottomOfPipe, self.timestampQueries, current*2 + 1);
+            },
+            [](void* state, UnsignedInt previous, UnsignedInt) {
+                auto& self = *static_cast<State*>(state);
+                /* With the frame pacing described in the docs the queries
+                   are finished already, so the wait is a no-op */
+                UnsignedLong timestamps[2];
+                self.timestampQueries.results(previous*2, 2, timestamps, Vk::QueryResultFlag::Wait);
+                return UnsignedLong(Double(timestamps[1] - timestamps[0])*self.timestampPeriod);
+            }, _state.get());
+        _state->gpuDurationIndex = index++;
+    }
+    if(values & (Value::VertexFetchRatio|Value::PrimitiveClipRatio)) {
+        _state->statisticsQueries = Vk::QueryPool{device, Vk::QueryPoolCreateInfo{
+            Vk::QueryPipelineStatistic::InputAssemblyVertices|
+            Vk::QueryPipelineStatistic::VertexShaderInvocations|
+            Vk::QueryPipelineStatistic::ClippingInvocations|
+            Vk::QueryPipelineStatistic::ClippingPrimitives, delay}};
+    }
+    if(values & Value::VertexFetchRatio) {
+        arrayAppend(measurements, InPlaceInit,
+            "Vertex fetch ratio"_s, Units::RatioThousandths, delay,
+            [](void* state, UnsignedInt current) {
+                static_cast<State*>(state)->beginStatistics(current);
+            },
+            [](void* state, UnsignedInt current) {
+                static_cast<State*>(state)->endStatistics(current);
+            },
+            [](void* state, UnsignedInt previous, UnsignedInt) {
+                UnsignedLong data[4];
+                static_cast<State*>(state)->queryStatistics(previous, data);
+
+                /* Avoid division by zero if a frame doesn't have any draws */
+                const UnsignedLong submitted = data[0];
+                if(!submitted) return UnsignedLong{};
+
+                return data[1]*1000/submitted;
+            }, _state.get());
+        _state->vertexFetchRatioIndex = index++;
+    }
+    if(values & Value::PrimitiveClipRatio) {
+        arrayAppend(measurements, InPlaceInit,
+            "Primitives clipped"_s, Units::PercentageThousandths, delay,
+            [](void* state, UnsignedInt current) {
+                /* The query is shared with the vertex fetch ratio, begin and
+                   end it only if that one doesn't do it already */
+                auto& self = *static_cast<State*>(state);
+                if(self.vertexFetchRatioIndex == 0xffff)
+                    self.beginStatistics(current);
+            },
+            [](void* state, UnsignedInt current) {
+                auto& self = *static_cast<State*>(state);
+                if(self.vertexFetchRatioIndex == 0xffff)
+                    self.endStatistics(current);
+            },
+            [](void* state, UnsignedInt previous, UnsignedInt) {
+                UnsignedLong data[4];
+                static_cast<State*>(state)->queryStatistics(previous, data);
+
+                /* Avoid division by zero if a frame doesn't have any draws */
+                const UnsignedLong input = data[2];
+                if(!input) return UnsignedLong{};
+
+                /* If we have more output primitives than input, it's because
+                   a triangle got split into multiple. To avoid an underflow,
+                   return zero as well. */
+                const UnsignedLong output = data[3];
+                if(input < output) return UnsignedLong{};
+
+                return 100000 - output*100000/input;
+            }, _state.get());
+        _state->primitiveClipRatioIndex = index++;
+    }
+    setup(Utility::move(measurements), maxFrameCount);
+}
+
+auto FrameProfilerVk::values() const -> Values {
+    Values values;
+    if(_state->frameTimeIndex != 0xffff) values |= Value::FrameTime;
+    if(_state->cpuDurationIndex != 0xffff) values |= Value::CpuDuration;
+    if(_state->gpuDurationIndex != 0xffff) values |= Value::GpuDuration;
+    if(_state->vertexFetchRatioIndex != 0xffff) values |= Value::VertexFetchRatio;
+    if(_state->primitiveClipRatioIndex != 0xffff) values |= Value::PrimitiveClipRatio;
+    return values;
+}
+
+UnsignedInt FrameProfilerVk::framesInFlight() const {
+    return _state->framesInFlight;
+}
+
+void FrameProfilerVk::beginFrame() {
+    CORRADE_ASSERT(!_state->hasGpuValues(),
+        "DebugTools::FrameProfilerVk::beginFrame(): a command buffer is required for GPU measurements", );
+    FrameProfiler::beginFrame();
+}
+
+void FrameProfilerVk::beginFrame(Vk::CommandBuffer& commandBuffer) {
+    #ifndef CORRADE_NO_ASSERT
+    if(isEnabled()) _state->statisticsCommandBuffer = commandBuffer;
+    #endif
+    _state->commandBuffer = &commandBuffer;
+    FrameProfiler::beginFrame();
+    _state->commandBuffer = nullptr;
+}
+
+void FrameProfilerVk::endFrame() {
+    CORRADE_ASSERT(!_state->hasGpuValues(),
+        "DebugTools::FrameProfilerVk::endFrame(): a command buffer is required for GPU measurements", );
+    FrameProfiler::endFrame();
+}
+
+void FrameProfilerVk::endFrame(Vk::CommandBuffer& commandBuffer) {
+    CORRADE_ASSERT(!isEnabled() || !_state->statisticsQueries.handle() || _state->statisticsCommandBuffer == commandBuffer.handle(),
+        "DebugTools::FrameProfilerVk::endFrame(): pipeline statistics have to be queried in the same command buffer as passed to beginFrame()", );
+    _state->commandBuffer = &commandBuffer;
+    FrameProfiler::endFrame();
+    _state->commandBuffer = nullptr;
+}
+
+bool FrameProfilerVk::isMeasurementAvailable(const Value value) const {
+    const UnsignedShort* index = nullptr;
+    switch(value) {
+        case Value::FrameTime: index = &_state->frameTimeIndex; break;
+        case Value::CpuDuration: index = &_state->cpuDurationIndex; break;
+        case Value::GpuDuration: index = &_state->gpuDurationIndex; break;
+        case Value::VertexFetchRatio: index = &_state->vertexFetchRatioIndex; break;
+        case Value::PrimitiveClipRatio: index = &_state->primitiveClipRatioIndex; break;
+    }
+    CORRADE_INTERNAL_ASSERT(index);
+    CORRADE_ASSERT(*index < measurementCount(),
+        "DebugTools::FrameProfilerVk::isMeasurementAvailable():" << value << "not enabled", {});
+    return isMeasurementAvailable(*index);
+}
+
+Double FrameProfilerVk::frameTimeMean() const {
+    CORRADE_ASSERT(_state->frameTimeIndex < measurementCount(),
+        "DebugTools::FrameProfilerVk::frameTimeMean(): not enabled", {});
+    return measurementMean(_state->frameTimeIndex);
+}
+
+Double FrameProfilerVk::cpuDurationMean() const {
+    CORRADE_ASSERT(_state->cpuDurationIndex < measurementCount(),
+        "DebugTools::FrameProfilerVk::cpuDurationMean(): not enabled", {});
+    return measurementMean(_state->cpuDurationIndex);
+}
+
+Double FrameProfilerVk::gpuDurationMean() const {
+    CORRADE_ASSERT(_state->gpuDurationIndex < measurementCount(),
+        "DebugTools::FrameProfilerVk::gpuDurationMean(): not enabled", {});
+    return measurementMean(_state->gpuDurationIndex);
+}
+
+Double FrameProfilerVk::vertexFetchRatioMean() const {
+    CORRADE_ASSERT(_state->vertexFetchRatioIndex < measurementCount(),
+        "DebugTools::FrameProfilerVk::vertexFetchRatioMean(): not enabled", {});
+    return measurementMean(_state->vertexFetchRatioIndex);
+}
+
+Double FrameProfilerVk::primitiveClipRatioMean() const {
+    CORRADE_ASSERT(_state->primitiveClipRatioIndex < measurementCount(),
+        "DebugTools::FrameProfilerVk::primitiveClipRatioMean(): not enabled", {});
+    return measurementMean(_state->primitiveClipRatioIndex);
+}
+
+namespace {
+
+constexpr const char* FrameProfilerVkValueNames[] {
+    "FrameTime",
+    "CpuDuration",
+    "GpuDuration",
+    "VertexFetchRatio",
+    "PrimitiveClipRatio"
+};
+
+}
+
+Debug& operator<<(Debug& debug, const FrameProfilerVk::Value value) {
+    debug << "DebugTools::FrameProfilerVk::Value" << Debug::nospace;
+
+    const UnsignedInt bit = Math::log2(UnsignedShort(value));
+    if(1 << bit == UnsignedShort(value))
+        return debug << "::" << Debug::nospace << FrameProfilerVkValueNames[bit];
+
+    return debug << "(" << Debug::nospace << Debug::hex << UnsignedShort(value) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const FrameProfilerVk::Values value) {
+    return Containers::enumSetDebugOutput(debug, value, "DebugTools::FrameProfilerVk::Values{}", {
+        FrameProfilerVk::Value::FrameTime,
+        FrameProfilerVk::Value::CpuDuration,
+        FrameProfilerVk::Value::GpuDuration,
+        FrameProfilerVk::Value::VertexFetchRatio,
+        FrameProfilerVk::Value::PrimitiveClipRatio});
+}
+
+}}
@@ -0,0 +1,347 @@
+#ifndef Magnum_DebugTools_FrameProfilerVk_h
+#define Magnum_DebugTools_FrameProfilerVk_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::DebugTools::FrameProfilerVk
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifdef MAGNUM_TARGET_VK
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/DebugTools/FrameProfiler.h"
+#include "Magnum/Vk/Vk.h"
+
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Vulkan frame profiler
+@m_since_latest
+
+A @ref FrameProfiler with Vulkan-specific measurements, a counterpart to
+@ref FrameProfilerGL. Instantiate with a desired subset of measured values and
+then continue the same way as described in the
+@ref DebugTools-FrameProfiler-usage "FrameProfiler usage documentation", except
+that GPU measurements are recorded into a command buffer passed to
+@ref beginFrame(Vk::CommandBuffer&) and @ref endFrame(Vk::CommandBuffer&):
+
+@snippet DebugTools-vk.cpp FrameProfilerVk-usage
+
+@section DebugTools-FrameProfilerVk-delay Measurement delay
+
+GPU measurements use a ring of @ref Vk::QueryPool slots, one for each frame
+that can be in flight plus one for the frame being recorded. A value recorded
+in a particular frame is retrieved @ref framesInFlight() frames later, at
+which point the GPU is already done with it if the application doesn't let the
+CPU get ahead of the GPU by more than @ref framesInFlight() frames, for example
+by using a @ref Vk::FramePacer with the same frame count and calling
+@ref Vk::FramePacer::beginFrame() before @ref endFrame(Vk::CommandBuffer&). The
+results are thus retrieved without stalling the CPU, only if the application
+runs further ahead than that, the retrieval waits for the GPU to catch up.
+
+Both @ref beginFrame(Vk::CommandBuffer&) and @ref endFrame(Vk::CommandBuffer&)
+record commands that are allowed only outside of a render pass. The command
+buffers don't need to be the same, however the command buffer passed to
+@ref beginFrame(Vk::CommandBuffer&) has to be submitted before the one passed
+to @ref endFrame(Vk::CommandBuffer&). If @ref Value::VertexFetchRatio or
+@ref Value::PrimitiveClipRatio is enabled, both have to be the same command
+buffer, as a pipeline statistics query can't span multiple command buffers.
+
+If none of @ref Value::GpuDuration, @ref Value::VertexFetchRatio and
+@ref Value::PrimitiveClipRatio is enabled, the class doesn't access the
+Vulkan device at all and @ref beginFrame() and @ref endFrame() can be called
+without a command buffer.
+
+@experimental
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT FrameProfilerVk: public FrameProfiler {
+    public:
+        /**
+         * @brief Measured value
+         *
+         * @see @ref Values, @ref FrameProfilerVk(Vk::Device&, Values, UnsignedInt, UnsignedInt),
+         *      @ref setup()
+         */
+        enum class Value: UnsignedShort {
+            /**
+             * Measure total frame time (i.e., time between consecutive
+             * @ref beginFrame() calls). Reported in @ref Units::Nanoseconds
+             * with a delay of 2 frames. When converted to seconds, the value
+             * is an inverse of FPS.
+             */
+            FrameTime = 1 << 0,
+
+            /**
+             * Measure CPU frame duration (i.e., CPU time spent between
+             * @ref beginFrame() and @ref endFrame()). Reported in
+             * @ref Units::Nanoseconds with a delay of 1 frame.
+             */
+            CpuDuration = 1 << 1,
+
+            /**
+             * Measure GPU frame duration (i.e., time between a
+             * @ref Vk::PipelineStage::TopOfPipe timestamp written in
+             * @ref beginFrame(Vk::CommandBuffer&) and a
+             * @ref Vk::PipelineStage::BottomOfPipe timestamp written in
+             * @ref endFrame(Vk::CommandBuffer&)). Reported in
+             * @ref Units::Nanoseconds with a delay of @ref framesInFlight()
+             * plus one frames. Requires the queue the command buffers are
+             * submitted to to support timestamps.
+             */
+            GpuDuration = 1 << 2,
+
+            /**
+             * Ratio of vertex shader invocations to count of vertices
+             * submitted. For a non-indexed draw the ratio will be 1, for
+             * indexed draws ratio is less than 1. The lower the value is, the
+             * better a mesh is optimized for post-transform vertex cache.
+             * Reported in @ref Units::RatioThousandths with a delay of
+             * @ref framesInFlight() plus one frames.
+             * @requires_vk_feature @ref Vk::DeviceFeature::PipelineStatisticsQuery
+             */
+            VertexFetchRatio = 1 << 3,
+
+            /**
+             * Ratio of primitives discarded by the clipping stage to count of
+             * primitives submitted. The ratio is 0 when all primitives pass
+             * the clipping stage and 1 when all are discarded. Can be used to
+             * measure efficiency of a frustum culling algorithm. Reported in
+             * @ref Units::PercentageThousandths with a delay of
+             * @ref framesInFlight() plus one frames.
+             * @requires_vk_feature @ref Vk::DeviceFeature::PipelineStatisticsQuery
+             */
+            PrimitiveClipRatio = 1 << 4
+        };
+
+        /**
+         * @brief Measured values
+         *
+         * @see @ref FrameProfilerVk(Vk::Device&, Values, UnsignedInt, UnsignedInt),
+         *      @ref setup()
+         */
+        typedef Containers::EnumSet<Value> Values;
+
+        /**
+         * @brief Default constructor
+         *
+         * Call @ref setup() to populate the profiler with measurements.
+         */
+        explicit FrameProfilerVk();
+
+        /**
+         * @brief Constructor
+         *
+         * Equivalent to default-constructing an instance and calling
+         * @ref setup() afterwards.
+         */
+        explicit FrameProfilerVk(Vk::Device& device, Values values, UnsignedInt maxFrameCount, UnsignedInt framesInFlight = 2);
+
+        /** @brief Copying is not allowed */
+        FrameProfilerVk(const FrameProfilerVk&) = delete;
+
+        /** @brief Move constructor */
+        FrameProfilerVk(FrameProfilerVk&&) noexcept;
+
+        /** @brief Copying is not allowed */
+        FrameProfilerVk& operator=(const FrameProfilerVk&) = delete;
+
+        /** @brief Move assignment */
+        FrameProfilerVk& operator=(FrameProfilerVk&&) noexcept;
+
+        ~FrameProfilerVk();
+
+        /**
+         * @brief Setup measured values
+         * @param device        Device to create the query pools on. Not
+         *      accessed if none of @ref Value::GpuDuration,
+         *      @ref Value::VertexFetchRatio and @ref Value::PrimitiveClipRatio
+         *      is enabled.
+         * @param values        List of measuremed values
+         * @param maxFrameCount Max frame count over which to calculate a
+         *      moving average. Expected to be at least @cpp 1 @ce.
+         * @param framesInFlight Max count of frames the CPU can be ahead of
+         *      the GPU, such as @ref Vk::FramePacer::frameCount(). Expected
+         *      to be at least @cpp 1 @ce. See
+         *      @ref DebugTools-FrameProfilerVk-delay for more information.
+         *
+         * Calling @ref setup() on an already set up profiler will replace
+         * existing measurements with @p measurements and reset
+         * @ref measuredFrameCount() back to @cpp 0 @ce.
+         */
+        void setup(Vk::Device& device, Values values, UnsignedInt maxFrameCount, UnsignedInt framesInFlight = 2);
+
+        /**
+         * @brief Measured values
+         *
+         * Corresponds to the @p values parameter passed to
+         * @ref FrameProfilerVk(Vk::Device&, Values, UnsignedInt, UnsignedInt)
+         * or @ref setup().
+         */
+        Values values() const;
+
+        /**
+         * @brief Max count of frames in flight
+         *
+         * Corresponds to the @p framesInFlight parameter passed to
+         * @ref FrameProfilerVk(Vk::Device&, Values, UnsignedInt, UnsignedInt)
+         * or @ref setup().
+         */
+        UnsignedInt framesInFlight() const;
+
+        /**
+         * @brief Begin a frame
+         *
+         * Expects that none of @ref Value::GpuDuration,
+         * @ref Value::VertexFetchRatio and @ref Value::PrimitiveClipRatio is
+         * enabled, use @ref beginFrame(Vk::CommandBuffer&) otherwise. See
+         * @ref FrameProfiler::beginFrame() for more information.
+         */
+        void beginFrame();
+
+        /**
+         * @brief Begin a frame and record GPU measurements
+         *
+         * Delegates to @ref FrameProfiler::beginFrame(), recording query
+         * resets, a timestamp and begin of a pipeline statistics query into
+         * @p commandBuffer for GPU measurements. Allowed only outside of a
+         * render pass.
+         */
+        void beginFrame(Vk::CommandBuffer& commandBuffer);
+
+        /**
+         * @brief End a frame
+         *
+         * Expects that none of @ref Value::GpuDuration,
+         * @ref Value::VertexFetchRatio and @ref Value::PrimitiveClipRatio is
+         * enabled, use @ref endFrame(Vk::CommandBuffer&) otherwise. See
+         * @ref FrameProfiler::endFrame() for more information.
+         */
+        void endFrame();
+
+        /**
+         * @brief End a frame and record GPU measurements
+         *
+         * Delegates to @ref FrameProfiler::endFrame(), recording a timestamp
+         * and end of a pipeline statistics query into @p commandBuffer for GPU
+         * measurements and retrieving results of GPU measurements recorded
+         * @ref framesInFlight() frames ago. Allowed only outside of a render
+         * pass. If @ref Value::VertexFetchRatio or
+         * @ref Value::PrimitiveClipRatio is enabled, expects that
+         * @p commandBuffer is the same as passed to the corresponding
+         * @ref beginFrame(Vk::CommandBuffer&).
+         */
+        void endFrame(Vk::CommandBuffer& commandBuffer);
+
+        /**
+         * @brief Whether given measurement is available
+         *
+         * Returns @cpp true @ce if enough frames was captured to calculate
+         * given @p value, @cpp false @ce otherwise. Expects that @p value was
+         * enabled.
+         */
+        bool isMeasurementAvailable(Value value) const;
+
+        using FrameProfiler::isMeasurementAvailable;
+
+        /**
+         * @brief Mean frame time in nanoseconds
+         *
+         * Expects that @ref Value::FrameTime was enabled, and that measurement
+         * data is available. See the flag documentation for more information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double frameTimeMean() const;
+
+        /**
+         * @brief Mean CPU frame duration in nanoseconds
+         *
+         * Expects that @ref Value::CpuDuration was enabled, and that
+         * measurement data is available. See the flag documentation for more
+         * information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double cpuDurationMean() const;
+
+        /**
+         * @brief Mean GPU frame duration in nanoseconds
+         *
+         * Expects that @ref Value::GpuDuration was enabled, and that
+         * measurement data is available. See the flag documentation for more
+         * information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double gpuDurationMean() const;
+
+        /**
+         * @brief Mean vertex fetch ratio in thousandths
+         *
+         * Expects that @ref Value::VertexFetchRatio was enabled, and that
+         * measurement data is available. See the flag documentation for more
+         * information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double vertexFetchRatioMean() const;
+
+        /**
+         * @brief Mean primitive clip ratio in percentage thousandths
+         *
+         * Expects that @ref Value::PrimitiveClipRatio was enabled, and that
+         * measurement data is available. See the flag documentation for more
+         * information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double primitiveClipRatioMean() const;
+
+    private:
+        using FrameProfiler::setup;
+
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+CORRADE_ENUMSET_OPERATORS(FrameProfilerVk::Values)
+
+/**
+@debugoperatorclassenum{FrameProfilerVk,FrameProfilerVk::Value}
+@m_since_latest
+*/
+MAGNUM_DEBUGTOOLS_EXPORT Debug& operator<<(Debug& debug, FrameProfilerVk::Value value);
+
+/**
+@debugoperatorclassenum{FrameProfilerVk,FrameProfilerVk::Values}
+@m_since_latest
+*/
+MAGNUM_DEBUGTOOLS_EXPORT Debug& operator<<(Debug& debug, FrameProfilerVk::Values value);
+
+}}
+#else
+#error this header is available only in the Vulkan build
+#endif
+
+#endif
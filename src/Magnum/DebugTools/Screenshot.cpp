@@ -31,6 +31,7 @@
 
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Image.h"
+#include "Magnum/ImageConversion.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/GL/AbstractFramebuffer.h"
 #include "Magnum/GL/PixelFormat.h"
@@ -38,6 +39,22 @@
 
 namespace Magnum { namespace DebugTools {
 
+namespace {
+
+bool saveScreenshot(PluginManager::Manager<Trade::AbstractImageConverter>& manager, const ImageView2D& image, const Containers::StringView filename) {
+    Containers::Pointer<Trade::AbstractImageConverter> converter;
+    if(!(converter = manager.loadAndInstantiate("AnyImageConverter")))
+        return false;
+
+    if(!converter->convertToFile(image, filename))
+        return false;
+
+    Debug{} << "DebugTools::screenshot(): saved a" << image.format() << "image of size" << image.size() << "to" << filename;
+    return true;
+}
+
+}
+
 bool screenshot(GL::AbstractFramebuffer& framebuffer, const Containers::StringView filename) {
     PluginManager::Manager<Trade::AbstractImageConverter> manager;
     return screenshot(manager, framebuffer, filename);
@@ -49,6 +66,18 @@ bool screenshot(PluginManager::Manager<Trade::AbstractImageConverter>& manager,
     const GL::PixelType type = framebuffer.implementationColorReadType();
     const Containers::Optional<PixelFormat> genericFormat = GL::genericPixelFormat(format, type);
     if(!genericFormat) {
+        #ifndef MAGNUM_TARGET_WEBGL
+        /* BGRA has no generic equivalent, but it's a common implementation
+           color read format on ES with EXT_read_format_bgra. Read it as-is
+           and swizzle to RGBA. */
+        if(format == GL::PixelFormat::BGRA && type == GL::PixelType::UnsignedByte) {
+            Image2D image = framebuffer.read(framebuffer.viewport(), {format, type});
+            const MutableImageView2D rgba{image.storage(), PixelFormat::RGBA8Unorm, image.size(), image.data()};
+            swizzleBgrImageInPlace(rgba);
+            return saveScreenshot(manager, rgba, filename);
+        }
+        #endif
+
         Error{} << "DebugTools::screenshot(): can't map {" << Debug::nospace << format << Debug::nospace << "," << type << Debug::nospace << "} to a generic pixel format";
         return false;
     }
@@ -62,16 +91,7 @@ bool screenshot(GL::AbstractFramebuffer& framebuffer, const PixelFormat format,
 }
 
 bool screenshot(PluginManager::Manager<Trade::AbstractImageConverter>& manager, GL::AbstractFramebuffer& framebuffer, const PixelFormat format, const Containers::StringView filename) {
-    Containers::Pointer<Trade::AbstractImageConverter> converter;
-    if(!(converter = manager.loadAndInstantiate("AnyImageConverter")))
-        return false;
-
-    Image2D image = framebuffer.read(framebuffer.viewport(), {format});
-    if(!converter->convertToFile(image, filename))
-        return false;
-
-    Debug{} << "DebugTools::screenshot(): saved a" << format << "image of size" << image.size() << "to" << filename;
-    return true;
+    return saveScreenshot(manager, framebuffer.read(framebuffer.viewport(), {format}), filename);
 }
 
 }}
@@ -53,7 +53,10 @@ Reads a rectangle of given @p framebuffer, defined by its
 @ref GL::AbstractFramebuffer::viewport() "viewport()". Pixel format is queried
 using @ref GL::AbstractFramebuffer::implementationColorReadFormat() and
 @ref GL::AbstractFramebuffer::implementationColorReadType() and then mapped
-back to the generic @ref Magnum::PixelFormat "PixelFormat". If, for some
+back to the generic @ref Magnum::PixelFormat "PixelFormat". If the driver
+suggests @ref GL::PixelFormat::BGRA with @ref GL::PixelType::UnsignedByte,
+which has no generic equivalent, the pixels are read as-is and swizzled to
+@ref PixelFormat::RGBA8Unorm using @ref swizzleBgrImageInPlace(). If, for some
 reason, the driver-suggested pixel format is not desired, use the
 @ref screenshot(GL::AbstractFramebuffer&, PixelFormat, Containers::StringView)
 overload instead.
@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
 #include <sstream>
 #include <numeric>
 #include <Corrade/Containers/Array.h>
@@ -35,6 +36,8 @@
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/File.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Path.h>
@@ -67,6 +70,9 @@ struct CompareImageTest: TestSuite::Tester {
     void calculateDeltaStorage();
     void calculateDeltaSpecials();
     void calculateDeltaSpecials3();
+    void calculateDeltaContiguous();
+    void calculateDeltaThreads();
+    void calculateDeltaEarlyOut();
 
     void deltaImage();
     void deltaImageScaling();
@@ -89,6 +95,9 @@ struct CompareImageTest: TestSuite::Tester {
     void compareSpecials();
     void compareSpecialsMeanOnly();
     void compareSpecialsDisallowedThreshold();
+    void compareThreads();
+    void compareEarlyOut();
+    void compareEarlyOutBelowThreshold();
 
     void setupExternalPluginManager();
     void teardownExternalPluginManager();
@@ -134,6 +143,11 @@ struct CompareImageTest: TestSuite::Tester {
     void pixelsToFileError();
     void pixelsToFileExpectedLoadFailed();
 
+    void debugFlag();
+    void debugFlags();
+
+    void benchmarkDelta();
+
     private:
         Containers::Optional<PluginManager::Manager<Trade::AbstractImporter>> _importerManager;
         Containers::Optional<PluginManager::Manager<Trade::AbstractImageConverter>> _converterManager;
@@ -147,6 +161,49 @@ const struct {
     {"sRGB", true}
 };
 
+const struct {
+    const char* name;
+    PixelFormat format;
+    bool specials;
+} CalculateDeltaContiguousData[]{
+    {"R8Unorm", PixelFormat::R8Unorm, false},
+    {"RGB8Unorm", PixelFormat::RGB8Unorm, false},
+    {"RGBA8Unorm", PixelFormat::RGBA8Unorm, false},
+    {"RG16I", PixelFormat::RG16I, false},
+    {"RGBA32UI", PixelFormat::RGBA32UI, false},
+    {"RG16F", PixelFormat::RG16F, false},
+    {"RGBA16F", PixelFormat::RGBA16F, false},
+    {"RGBA16F, specials", PixelFormat::RGBA16F, true},
+    {"R32F", PixelFormat::R32F, false},
+    {"RGB32F", PixelFormat::RGB32F, false},
+    {"RGBA32F", PixelFormat::RGBA32F, false},
+    {"RGBA32F, specials", PixelFormat::RGBA32F, true},
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} CalculateDeltaThreadsData[]{
+    {"2 threads", 2},
+    {"3 threads", 3},
+    {"7 threads", 7},
+    /* More threads than rows, should be clamped */
+    {"100 threads", 100},
+};
+
+const struct {
+    const char* name;
+    PixelFormat format;
+    UnsignedInt threadCount;
+} BenchmarkDeltaData[]{
+    {"RGBA8Unorm", PixelFormat::RGBA8Unorm, 1},
+    {"RGBA8Unorm, 4 threads", PixelFormat::RGBA8Unorm, 4},
+    {"RGBA16F", PixelFormat::RGBA16F, 1},
+    {"RGBA16F, 4 threads", PixelFormat::RGBA16F, 4},
+    {"RGBA32F", PixelFormat::RGBA32F, 1},
+    {"RGBA32F, 4 threads", PixelFormat::RGBA32F, 4},
+};
+
 CompareImageTest::CompareImageTest() {
     addTests({&CompareImageTest::formatUnknown,
               &CompareImageTest::formatPackedDepthStencil,
@@ -156,7 +213,15 @@ CompareImageTest::CompareImageTest() {
               &CompareImageTest::calculateDeltaInteger,
               &CompareImageTest::calculateDeltaStorage,
               &CompareImageTest::calculateDeltaSpecials,
-              &CompareImageTest::calculateDeltaSpecials3,
+              &CompareImageTest::calculateDeltaSpecials3});
+
+    addInstancedTests({&CompareImageTest::calculateDeltaContiguous},
+        Containers::arraySize(CalculateDeltaContiguousData));
+
+    addInstancedTests({&CompareImageTest::calculateDeltaThreads},
+        Containers::arraySize(CalculateDeltaThreadsData));
+
+    addTests({&CompareImageTest::calculateDeltaEarlyOut,
 
               &CompareImageTest::deltaImage,
               &CompareImageTest::deltaImageScaling,
@@ -179,6 +244,9 @@ CompareImageTest::CompareImageTest() {
               &CompareImageTest::compareSpecials,
               &CompareImageTest::compareSpecialsMeanOnly,
               &CompareImageTest::compareSpecialsDisallowedThreshold,
+              &CompareImageTest::compareThreads,
+              &CompareImageTest::compareEarlyOut,
+              &CompareImageTest::compareEarlyOutBelowThreshold,
 
               &CompareImageTest::imageZeroDelta,
               &CompareImageTest::imageNonZeroDelta,
@@ -264,6 +332,12 @@ CompareImageTest::CompareImageTest() {
         &CompareImageTest::setupExternalPluginManager,
         &CompareImageTest::teardownExternalPluginManager);
 
+    addTests({&CompareImageTest::debugFlag,
+              &CompareImageTest::debugFlags});
+
+    addInstancedBenchmarks({&CompareImageTest::benchmarkDelta}, 10,
+        Containers::arraySize(BenchmarkDeltaData));
+
     /* Plugin manager setup is not done here, but in the
        setupExternalPluginManager() function */
 }
@@ -458,6 +532,154 @@ void CompareImageTest::calculateDeltaSpecials3() {
     CORRADE_COMPARE(deltaMaxMean.third(), -Constants::nan());
 }
 
+/* Deterministic pseudo-random pixel data. Floating-point formats get values
+   in the [0, 1] range, everything else just arbitrary bytes. Every fourth
+   component is kept the same between seeds in order to have some zero deltas
+   as well. */
+Containers::Array<char> pixelData(PixelFormat format, const Vector2i& size, UnsignedInt seed) {
+    const std::size_t dataSize = pixelFormatSize(format)*size.product();
+    Containers::Array<char> data{ValueInit, dataSize};
+    UnsignedInt state = 0x1234567u;
+    const auto next = [&state]() {
+        state = state*1664525u + 1013904223u;
+        return state;
+    };
+
+    if(format == PixelFormat::RG16F || format == PixelFormat::RGBA16F) {
+        Containers::ArrayView<UnsignedShort> out = Containers::arrayCast<UnsignedShort>(data);
+        for(std::size_t i = 0; i != out.size(); ++i) {
+            const UnsignedInt value = next() + (i % 4 ? seed : 0);
+            out[i] = Math::packHalf(Float(value >> 8)/Float(1 << 24));
+        }
+    } else if(format == PixelFormat::R32F || format == PixelFormat::RGB32F || format == PixelFormat::RGBA32F) {
+        Containers::ArrayView<Float> out = Containers::arrayCast<Float>(data);
+        for(std::size_t i = 0; i != out.size(); ++i) {
+            const UnsignedInt value = next() + (i % 4 ? seed : 0);
+            out[i] = Float(value >> 8)/Float(1 << 24);
+        }
+    } else for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = char((next() + (i % 4 ? seed : 0)) >> 24);
+
+    return data;
+}
+
+/* Sprinkles NaNs, infinities, signed zeros and denormals over the data, with
+   a different period for each seed so they both match and mismatch */
+void pixelDataSpecials(PixelFormat format, Containers::ArrayView<char> data, UnsignedInt seed) {
+    const std::size_t period = seed ? 11 : 7;
+    if(format == PixelFormat::RGBA16F) {
+        constexpr UnsignedShort Specials[]{
+            0x7e00, 0x7c00, 0xfc00, 0x0000, 0x8000, 0x0001, 0x83ff
+        };
+        Containers::ArrayView<UnsignedShort> out = Containers::arrayCast<UnsignedShort>(data);
+        for(std::size_t i = 0; i < out.size(); i += period)
+            out[i] = Specials[(i/period) % Containers::arraySize(Specials)];
+    } else {
+        CORRADE_INTERNAL_ASSERT(format == PixelFormat::RGBA32F);
+        constexpr Float Specials[]{
+            Constants::nan(), Constants::inf(), -Constants::inf(),
+            0.0f, -0.0f, 1.0e-40f, -1.0e-40f
+        };
+        Containers::ArrayView<Float> out = Containers::arrayCast<Float>(data);
+        for(std::size_t i = 0; i < out.size(); i += period)
+            out[i] = Specials[(i/period) % Containers::arraySize(Specials)];
+    }
+}
+
+/* Bit representation of the floats, with all NaNs being the same as the NaN
+   payload isn't guaranteed to be preserved across the code paths */
+UnsignedInt floatBits(Float value) {
+    if(Math::isNan(value)) value = Constants::nan();
+    UnsignedInt out;
+    std::memcpy(&out, &value, sizeof(Float));
+    return out;
+}
+
+Containers::Array<UnsignedInt> floatBits(Containers::ArrayView<const Float> values) {
+    Containers::Array<UnsignedInt> out{NoInit, values.size()};
+    for(std::size_t i = 0; i != values.size(); ++i)
+        out[i] = floatBits(values[i]);
+    return out;
+}
+
+void CompareImageTest::calculateDeltaContiguous() {
+    auto&& data = CalculateDeltaContiguousData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Calculates the delta once with contiguous rows, which go through the
+       fast path, and once with actual pixels interleaved with garbage, which
+       goes through the generic strided path. The results should be exactly
+       the same, bit by bit, including the SIMD kernels used for RGBA8Unorm,
+       RGBA16F and RGBA32F. The width isn't divisible by four to verify the
+       remainder gets handled as well. */
+    const Vector2i size{37, 23};
+    const std::size_t pixelSize = pixelFormatSize(data.format);
+    Containers::Array<char> actualData = pixelData(data.format, size, 0);
+    Containers::Array<char> expectedData = pixelData(data.format, size, 1);
+    if(data.specials) {
+        pixelDataSpecials(data.format, actualData, 0);
+        pixelDataSpecials(data.format, expectedData, 1);
+    }
+    const ImageView2D actual{PixelStorage{}.setAlignment(1), data.format, size, actualData};
+    const ImageView2D expected{PixelStorage{}.setAlignment(1), data.format, size, expectedData};
+
+    Containers::Array<char> interleavedData{DirectInit, actualData.size()*2, '\xce'};
+    Containers::StridedArrayView3D<char> interleaved{interleavedData,
+        {std::size_t(size.y()), std::size_t(size.x()), pixelSize},
+        {std::ptrdiff_t(size.x()*pixelSize*2), std::ptrdiff_t(pixelSize*2), 1}};
+    Utility::copy(actual.pixels(), interleaved);
+
+    Containers::Triple<Containers::Array<Float>, Float, Float> contiguous = Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected);
+    Containers::Triple<Containers::Array<Float>, Float, Float> strided = Implementation::calculateImageDelta(actual.format(), interleaved, expected);
+    CORRADE_COMPARE_AS(floatBits(contiguous.first()), floatBits(strided.first()),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(floatBits(contiguous.second()), floatBits(strided.second()));
+    CORRADE_COMPARE(floatBits(contiguous.third()), floatBits(strided.third()));
+
+    /* Sanity check that the data actually differ */
+    CORRADE_COMPARE_AS(contiguous.second(), 0.0f,
+        TestSuite::Compare::Greater);
+}
+
+void CompareImageTest::calculateDeltaThreads() {
+    auto&& data = CalculateDeltaThreadsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Vector2i size{13, 29};
+    Containers::Array<char> actualData = pixelData(PixelFormat::RGBA8Unorm, size, 0);
+    Containers::Array<char> expectedData = pixelData(PixelFormat::RGBA8Unorm, size, 1);
+    const ImageView2D actual{PixelFormat::RGBA8Unorm, size, actualData};
+    const ImageView2D expected{PixelFormat::RGBA8Unorm, size, expectedData};
+
+    Containers::Triple<Containers::Array<Float>, Float, Float> single = Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected);
+    Containers::Triple<Containers::Array<Float>, Float, Float> threaded = Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected, data.threadCount, Constants::inf());
+
+    /* The mean is always calculated on a single thread, so even that should
+       be bit-exact */
+    CORRADE_COMPARE_AS(threaded.first(), single.first(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(threaded.second(), single.second());
+    CORRADE_COMPARE(threaded.third(), single.third());
+}
+
+void CompareImageTest::calculateDeltaEarlyOut() {
+    /* Max of the first row is 0.35, so it stops right after it */
+    {
+        Containers::Triple<Containers::Array<Float>, Float, Float> deltaMaxMean = Implementation::calculateImageDelta(ActualRed.format(), ActualRed.pixels(), ExpectedRed, 1, 0.3f);
+        CORRADE_COMPARE(deltaMaxMean.second(), 0.35f);
+        CORRADE_COMPARE(deltaMaxMean.third(), Constants::nan());
+
+    /* Threshold not exceeded, should calculate everything */
+    } {
+        Containers::Triple<Containers::Array<Float>, Float, Float> deltaMaxMean = Implementation::calculateImageDelta(ActualRed.format(), ActualRed.pixels(), ExpectedRed, 1, 1.0f);
+        CORRADE_COMPARE_AS(deltaMaxMean.first(),
+            Containers::arrayView(DeltaRed),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE(deltaMaxMean.second(), 1.0f);
+        CORRADE_COMPARE(deltaMaxMean.third(), 0.208889f);
+    }
+}
+
 void CompareImageTest::deltaImage() {
     std::ostringstream out;
     Debug d{&out, Debug::Flag::DisableColors};
@@ -985,6 +1207,69 @@ void CompareImageTest::compareSpecialsDisallowedThreshold() {
         "DebugTools::CompareImage: thresholds can't be NaN or infinity\n");
 }
 
+void CompareImageTest::compareThreads() {
+    std::stringstream out;
+
+    {
+        TestSuite::Comparator<CompareImage> compare{30.0f, 20.0f};
+        /* 0 means hardware concurrency, which makes it more than the two rows
+           on basically every machine */
+        compare.setThreadCount(0);
+        TestSuite::ComparisonStatusFlags flags = compare(ActualRgb, ExpectedRgb);
+        CORRADE_COMPARE(flags, TestSuite::ComparisonStatusFlag::Failed);
+        Debug d{&out, Debug::Flag::DisableColors};
+        compare.printMessage(flags, d, "a", "b");
+    }
+
+    /* Should be the same as compareAboveMaxThreshold() */
+    CORRADE_COMPARE(out.str(),
+        "Images a and b have max delta above threshold, actual 39 but at most 30 expected. Mean delta 18.5 is within threshold 20. Delta image:\n"
+        "          |?M|\n"
+        "        Pixels above max/mean threshold:\n"
+        "          [1,1] #abcd85, expected #abcdfa (Δ = 39)\n");
+}
+
+void CompareImageTest::compareEarlyOut() {
+    std::stringstream out;
+
+    {
+        /* The first row has max delta 18.6667, the second 39. It should stop
+           after the first row already. */
+        TestSuite::Comparator<CompareImage> compare{10.0f, 5.0f};
+        compare.setFlags(CompareImageFlag::EarlyOut);
+        TestSuite::ComparisonStatusFlags flags = compare(ActualRgb, ExpectedRgb);
+        CORRADE_COMPARE(flags, TestSuite::ComparisonStatusFlag::Failed);
+        Debug d{&out, Debug::Flag::DisableColors};
+        compare.printMessage(flags, d, "a", "b");
+    }
+
+    CORRADE_COMPARE(out.str(),
+        "Images a and b have max delta above threshold, actual at least 18.6667 but at most 10 expected. Stopped early, mean delta and delta image not calculated.\n");
+}
+
+void CompareImageTest::compareEarlyOutBelowThreshold() {
+    std::stringstream out;
+
+    {
+        /* Only the mean is above the threshold, which means the early out
+           doesn't kick in and the output is the same as in
+           compareAboveMeanThreshold() */
+        TestSuite::Comparator<CompareImage> compare{50.0f, 18.0f};
+        compare.setFlags(CompareImageFlag::EarlyOut);
+        TestSuite::ComparisonStatusFlags flags = compare(ActualRgb, ExpectedRgb);
+        CORRADE_COMPARE(flags, TestSuite::ComparisonStatusFlag::Failed);
+        Debug d{&out, Debug::Flag::DisableColors};
+        compare.printMessage(flags, d, "a", "b");
+    }
+
+    CORRADE_COMPARE(out.str(),
+        "Images a and b have mean delta above threshold, actual 18.5 but at most 18 expected. Max delta 39 is within threshold 50. Delta image:\n"
+        "          |?M|\n"
+        "        Pixels above max/mean threshold:\n"
+        "          [1,1] #abcd85, expected #abcdfa (Δ = 39)\n"
+        "          [1,0] #5647ec, expected #5610ed (Δ = 18.6667)\n");
+}
+
 void CompareImageTest::setupExternalPluginManager() {
     _importerManager.emplace("nonexistent");
     _converterManager.emplace("nonexistent");
@@ -2149,6 +2434,39 @@ void CompareImageTest::pixelsToFileExpectedLoadFailed() {
         Utility::Path::join(DEBUGTOOLS_TEST_DIR, "CompareImageActual.tga"), TestSuite::Compare::File);
 }
 
+void CompareImageTest::debugFlag() {
+    std::ostringstream out;
+
+    Debug{&out} << CompareImageFlag::EarlyOut << CompareImageFlag(0xf0);
+    CORRADE_COMPARE(out.str(), "DebugTools::CompareImageFlag::EarlyOut DebugTools::CompareImageFlag(0xf0)\n");
+}
+
+void CompareImageTest::debugFlags() {
+    std::ostringstream out;
+
+    Debug{&out} << (CompareImageFlag::EarlyOut|CompareImageFlag(0xf0)) << CompareImageFlags{};
+    CORRADE_COMPARE(out.str(), "DebugTools::CompareImageFlag::EarlyOut|DebugTools::CompareImageFlag(0xf0) DebugTools::CompareImageFlags{}\n");
+}
+
+void CompareImageTest::benchmarkDelta() {
+    auto&& data = BenchmarkDeltaData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Vector2i size{1024};
+    Containers::Array<char> actualData = pixelData(data.format, size, 0);
+    Containers::Array<char> expectedData = pixelData(data.format, size, 1);
+    const ImageView2D actual{data.format, size, actualData};
+    const ImageView2D expected{data.format, size, expectedData};
+
+    Float max = 0.0f;
+    CORRADE_BENCHMARK(1) {
+        max += Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected, data.threadCount, Constants::inf()).second();
+    }
+
+    CORRADE_COMPARE_AS(max, 0.0f,
+        TestSuite::Compare::Greater);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::DebugTools::Test::CompareImageTest)
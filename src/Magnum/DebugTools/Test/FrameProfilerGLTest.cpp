@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstdlib>
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/System.h>
 
@@ -49,6 +51,9 @@ struct FrameProfilerGLTest: GL::OpenGLTester {
     explicit FrameProfilerGLTest();
 
     void test();
+    void gpuScopes();
+    void gpuScopesScopeBufferRecreated();
+    void gpuScopesProfilerDisabledInBetween();
     #ifndef MAGNUM_TARGET_GLES
     void vertexFetchRatioDivisionByZero();
     void primitiveClipRatioDivisionByZero();
@@ -75,6 +80,10 @@ FrameProfilerGLTest::FrameProfilerGLTest() {
     addInstancedTests({&FrameProfilerGLTest::test},
         Containers::arraySize(Data));
 
+    addTests({&FrameProfilerGLTest::gpuScopes,
+              &FrameProfilerGLTest::gpuScopesScopeBufferRecreated,
+              &FrameProfilerGLTest::gpuScopesProfilerDisabledInBetween});
+
     #ifndef MAGNUM_TARGET_GLES
     addTests({&FrameProfilerGLTest::vertexFetchRatioDivisionByZero,
               &FrameProfilerGLTest::primitiveClipRatioDivisionByZero,
@@ -197,6 +206,196 @@ void FrameProfilerGLTest::test() {
     #endif
 }
 
+void FrameProfilerGLTest::gpuScopes() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::timer_query>())
+        CORRADE_SKIP(GL::Extensions::ARB::timer_query::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query_webgl2>())
+        CORRADE_SKIP(GL::Extensions::EXT::disjoint_timer_query_webgl2::string() << "is not supported.");
+    #else
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(GL::Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    /* Bind some FB to avoid errors on contexts w/o default FB */
+    GL::Renderbuffer color;
+    color.setStorage(
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        GL::RenderbufferFormat::RGBA8,
+        #else
+        GL::RenderbufferFormat::RGBA4,
+        #endif
+        Vector2i{32});
+    GL::Framebuffer fb{{{}, Vector2i{32}}};
+    fb.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color)
+      .bind();
+
+    GL::Mesh mesh = MeshTools::compile(Primitives::cubeSolid());
+    Shaders::FlatGL3D shader;
+
+    FrameProfilerGL profiler{{}, 1};
+    profiler.setScopeBufferSize(16);
+
+    {
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, "cpu");
+        MAGNUM_DEBUGTOOLS_PROFILE_GPU_SCOPE(profiler, "frame");
+        for(std::size_t i = 0; i != 3; ++i) {
+            MAGNUM_DEBUGTOOLS_PROFILE_GPU_SCOPE(profiler, "draw");
+            shader.draw(mesh);
+        }
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Wait until the results are available */
+    Containers::String trace;
+    for(std::size_t i = 0; i != 100; ++i) {
+        trace = profiler.chromeTrace();
+        if(trace.contains("\"name\":\"frame\"")) break;
+        Utility::System::sleep(10);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(trace.contains("\"args\":{\"name\":\"GPU\"}"));
+    CORRADE_VERIFY(trace.contains("{\"name\":\"cpu\",\"ph\":\"X\",\"pid\":0,\"tid\":0,"));
+    CORRADE_VERIFY(trace.contains("{\"name\":\"frame\",\"ph\":\"X\",\"pid\":0,\"tid\":1,"));
+    CORRADE_VERIFY(trace.contains("{\"name\":\"draw\",\"ph\":\"X\",\"pid\":0,\"tid\":1,"));
+}
+
+/* Timestamp of the first event matching given prefix, in microseconds */
+Double traceTimestamp(const Containers::StringView trace, const Containers::StringView prefix) {
+    const Containers::StringView found = trace.find(prefix);
+    if(!found.data()) return -1.0;
+    return std::strtod(found.end(), nullptr);
+}
+
+void FrameProfilerGLTest::gpuScopesScopeBufferRecreated() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::timer_query>())
+        CORRADE_SKIP(GL::Extensions::ARB::timer_query::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query_webgl2>())
+        CORRADE_SKIP(GL::Extensions::EXT::disjoint_timer_query_webgl2::string() << "is not supported.");
+    #else
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(GL::Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    FrameProfilerGL profiler{{}, 1};
+    profiler.setScopeBufferSize(16);
+
+    /* Calibrate the GPU time against the first scope buffer, leaving one
+       scope open and one pending */
+    profiler.beginGpuScope("stale open");
+    {
+        MAGNUM_DEBUGTOOLS_PROFILE_GPU_SCOPE(profiler, "stale");
+    }
+
+    /* Recreate the buffer after a while, so if the old calibration was kept,
+       the GPU scopes would be shifted by the time that passed */
+    Utility::System::sleep(200);
+    profiler.setScopeBufferSize(16);
+
+    {
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, "cpu");
+        MAGNUM_DEBUGTOOLS_PROFILE_GPU_SCOPE(profiler, "gpu");
+    }
+
+    /* This would close the stale scope, which should be discarded already */
+    profiler.endGpuScope();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Wait until the results are available */
+    Containers::String trace;
+    for(std::size_t i = 0; i != 100; ++i) {
+        trace = profiler.chromeTrace();
+        if(trace.contains("\"name\":\"gpu\"")) break;
+        Utility::System::sleep(10);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(!trace.contains("\"name\":\"stale"));
+
+    const Double cpuTime = traceTimestamp(trace, "{\"name\":\"cpu\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":");
+    const Double gpuTime = traceTimestamp(trace, "{\"name\":\"gpu\",\"ph\":\"X\",\"pid\":0,\"tid\":1,\"ts\":");
+    CORRADE_VERIFY(cpuTime >= 0.0);
+    CORRADE_VERIFY(gpuTime >= 0.0);
+
+    /* Both are relative to the new buffer, so both should be well below the
+       200 ms that passed before it got recreated. Allow for some latency on
+       the GPU side. */
+    CORRADE_COMPARE_AS(cpuTime, 100000.0,
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(gpuTime, 100000.0,
+        TestSuite::Compare::Less);
+}
+
+void FrameProfilerGLTest::gpuScopesProfilerDisabledInBetween() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::timer_query>())
+        CORRADE_SKIP(GL::Extensions::ARB::timer_query::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query_webgl2>())
+        CORRADE_SKIP(GL::Extensions::EXT::disjoint_timer_query_webgl2::string() << "is not supported.");
+    #else
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(GL::Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    FrameProfilerGL profiler{{}, 1};
+    profiler.setScopeBufferSize(16);
+
+    /* Same as FrameProfilerTest::scopesProfilerDisabledInBetween(), the end
+       of the skipped scope shouldn't end the outer one */
+    profiler.beginGpuScope("outer");
+    profiler.disable();
+    profiler.beginGpuScope("skipped");
+    profiler.enable();
+    {
+        MAGNUM_DEBUGTOOLS_PROFILE_GPU_SCOPE(profiler, "nested");
+    }
+    profiler.endGpuScope();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Wait until the results are available */
+    Containers::String trace;
+    for(std::size_t i = 0; i != 100; ++i) {
+        trace = profiler.chromeTrace();
+        if(trace.contains("\"name\":\"nested\"")) break;
+        Utility::System::sleep(10);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The outer scope is still open, the skipped scope isn't counted into
+       the nested scope depth */
+    CORRADE_VERIFY(!trace.contains("\"name\":\"outer\""));
+    CORRADE_VERIFY(!trace.contains("\"name\":\"skipped\""));
+    CORRADE_VERIFY(trace.contains("{\"name\":\"nested\",\"ph\":\"X\",\"pid\":0,\"tid\":1,"));
+    CORRADE_VERIFY(trace.contains("\"args\":{\"depth\":1}"));
+
+    profiler.disable();
+    profiler.endGpuScope();
+    profiler.enable();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    for(std::size_t i = 0; i != 100; ++i) {
+        trace = profiler.chromeTrace();
+        if(trace.contains("\"name\":\"outer\"")) break;
+        Utility::System::sleep(10);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(trace.contains("{\"name\":\"outer\",\"ph\":\"X\",\"pid\":0,\"tid\":1,"));
+}
+
 #ifndef MAGNUM_TARGET_GLES
 void FrameProfilerGLTest::vertexFetchRatioDivisionByZero() {
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::pipeline_statistics_query>())
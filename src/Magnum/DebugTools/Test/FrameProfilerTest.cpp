@@ -24,7 +24,9 @@
 */
 
 #include <sstream>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -32,9 +34,19 @@
 #include <Corrade/Utility/System.h>
 
 #include "Magnum/DebugTools/FrameProfiler.h"
+#ifdef MAGNUM_TARGET_VK
+#include "Magnum/DebugTools/FrameProfilerVk.h"
+#include "Magnum/Vk/Device.h"
+#endif
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
 
 namespace Magnum { namespace DebugTools { namespace Test { namespace {
 
+using namespace Containers::Literals;
+
 struct FrameProfilerTest: TestSuite::Tester {
     explicit FrameProfilerTest();
 
@@ -61,11 +73,28 @@ struct FrameProfilerTest: TestSuite::Tester {
 
     void statistics();
 
+    void scopes();
+    void scopesNotEnabled();
+    void scopesProfilerDisabled();
+    void scopesProfilerDisabledInBetween();
+    void scopesOverflow();
+    void scopesEndWithoutBegin();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void scopesMultipleThreads();
+    #endif
+    void scopesMove();
+
     #ifdef MAGNUM_TARGET_GL
     void gl();
     void glNotEnabled();
     #endif
 
+    #ifdef MAGNUM_TARGET_VK
+    void vk();
+    void vkNotEnabled();
+    void vkZeroFramesInFlight();
+    #endif
+
     void debugUnits();
     #ifdef MAGNUM_TARGET_GL
     void debugGLValue();
@@ -74,6 +103,10 @@ struct FrameProfilerTest: TestSuite::Tester {
     void configurationGLValue();
     void configurationGLValues();
     #endif
+    #ifdef MAGNUM_TARGET_VK
+    void debugVkValue();
+    void debugVkValues();
+    #endif
 };
 
 struct {
@@ -109,6 +142,21 @@ struct {
 };
 #endif
 
+#ifdef MAGNUM_TARGET_VK
+struct {
+    const char* name;
+    FrameProfilerVk::Values values;
+    UnsignedInt measurementCount;
+    /* Delay of the first measurement, if any */
+    UnsignedInt measurementDelay;
+} VkData[]{
+    {"empty", {}, 0, 1},
+    {"frame time", FrameProfilerVk::Value::FrameTime, 1, 2},
+    {"cpu duration", FrameProfilerVk::Value::CpuDuration, 1, 1},
+    {"frame time + cpu duration", FrameProfilerVk::Value::FrameTime|FrameProfilerVk::Value::CpuDuration, 2, 2}
+};
+#endif
+
 FrameProfilerTest::FrameProfilerTest() {
     addTests({&FrameProfilerTest::defaultConstructed,
               &FrameProfilerTest::noMeasurements});
@@ -133,17 +181,37 @@ FrameProfilerTest::FrameProfilerTest() {
               &FrameProfilerTest::dataNotAvailableYet,
               &FrameProfilerTest::meanNotAvailableYet,
 
-              &FrameProfilerTest::statistics});
+              &FrameProfilerTest::statistics,
+
+              &FrameProfilerTest::scopes,
+              &FrameProfilerTest::scopesNotEnabled,
+              &FrameProfilerTest::scopesProfilerDisabled,
+              &FrameProfilerTest::scopesProfilerDisabledInBetween,
+              &FrameProfilerTest::scopesOverflow,
+              &FrameProfilerTest::scopesEndWithoutBegin,
+              #ifndef CORRADE_TARGET_EMSCRIPTEN
+              &FrameProfilerTest::scopesMultipleThreads,
+              #endif
+              &FrameProfilerTest::scopesMove});
 
     #ifdef MAGNUM_TARGET_GL
     addInstancedTests({&FrameProfilerTest::gl},
         Containers::arraySize(GLData));
     #endif
 
+    #ifdef MAGNUM_TARGET_VK
+    addInstancedTests({&FrameProfilerTest::vk},
+        Containers::arraySize(VkData));
+    #endif
+
     addTests({
               #ifdef MAGNUM_TARGET_GL
               &FrameProfilerTest::glNotEnabled,
               #endif
+              #ifdef MAGNUM_TARGET_VK
+              &FrameProfilerTest::vkNotEnabled,
+              &FrameProfilerTest::vkZeroFramesInFlight,
+              #endif
 
               &FrameProfilerTest::debugUnits,
               #ifdef MAGNUM_TARGET_GL
@@ -151,7 +219,11 @@ FrameProfilerTest::FrameProfilerTest() {
               &FrameProfilerTest::debugGLValues,
 
               &FrameProfilerTest::configurationGLValue,
-              &FrameProfilerTest::configurationGLValues
+              &FrameProfilerTest::configurationGLValues,
+              #endif
+              #ifdef MAGNUM_TARGET_VK
+              &FrameProfilerTest::debugVkValue,
+              &FrameProfilerTest::debugVkValues
               #endif
               });
 }
@@ -1092,6 +1164,218 @@ void FrameProfilerTest::statistics() {
         "  CPU usage: -.-- %");
 }
 
+void FrameProfilerTest::scopes() {
+    FrameProfiler profiler;
+    CORRADE_COMPARE(profiler.scopeBufferSize(), 0);
+
+    profiler.setScopeBufferSize(16);
+    CORRADE_COMPARE(profiler.scopeBufferSize(), 16);
+
+    {
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, "outer");
+        {
+            MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, "inner \"quoted\"");
+        }
+        /* This one doesn't end before the export, so it isn't present */
+        profiler.beginScope("unfinished");
+        Containers::String trace = profiler.chromeTrace();
+        CORRADE_VERIFY(!trace.contains("unfinished"));
+        profiler.endScope();
+    }
+
+    Containers::String trace = profiler.chromeTrace();
+    CORRADE_VERIFY(trace.hasPrefix("{\"traceEvents\":[ \n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Thread 0\"}}"_s));
+    CORRADE_VERIFY(trace.hasSuffix("\n],\"displayTimeUnit\":\"ns\"}\n"_s));
+    /* Events are in order of the scope beginning */
+    Containers::Optional<Containers::StringView> outer = trace.find("{\"name\":\"outer\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":"_s);
+    Containers::Optional<Containers::StringView> inner = trace.find("{\"name\":\"inner \\\"quoted\\\"\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":"_s);
+    Containers::Optional<Containers::StringView> unfinished = trace.find("{\"name\":\"unfinished\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":"_s);
+    CORRADE_VERIFY(outer);
+    CORRADE_VERIFY(inner);
+    CORRADE_VERIFY(unfinished);
+    CORRADE_VERIFY(outer->data() < inner->data());
+    CORRADE_VERIFY(inner->data() < unfinished->data());
+    CORRADE_VERIFY(trace.contains("\"args\":{\"depth\":0}"));
+    CORRADE_VERIFY(trace.contains("\"args\":{\"depth\":1}"));
+    /* No GPU scopes were recorded */
+    CORRADE_VERIFY(!trace.contains("GPU"));
+
+    /* Setting the size again discards everything */
+    profiler.setScopeBufferSize(4);
+    CORRADE_COMPARE(profiler.scopeBufferSize(), 4);
+    CORRADE_COMPARE(profiler.chromeTrace(), "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ns\"}\n");
+}
+
+void FrameProfilerTest::scopesNotEnabled() {
+    FrameProfiler profiler;
+
+    {
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, "nothing");
+    }
+    CORRADE_COMPARE(profiler.chromeTrace(), "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ns\"}\n");
+
+    profiler.setScopeBufferSize(4);
+    profiler.setScopeBufferSize(0);
+    CORRADE_COMPARE(profiler.scopeBufferSize(), 0);
+    {
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, "nothing");
+    }
+    CORRADE_COMPARE(profiler.chromeTrace(), "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ns\"}\n");
+}
+
+void FrameProfilerTest::scopesProfilerDisabled() {
+    FrameProfiler profiler;
+    profiler.setScopeBufferSize(4);
+
+    profiler.disable();
+    {
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, "disabled");
+    }
+
+    profiler.enable();
+    {
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, "enabled");
+    }
+
+    Containers::String trace = profiler.chromeTrace();
+    CORRADE_VERIFY(!trace.contains("disabled"));
+    CORRADE_VERIFY(trace.contains("\"name\":\"enabled\""));
+}
+
+void FrameProfilerTest::scopesProfilerDisabledInBetween() {
+    FrameProfiler profiler;
+    profiler.setScopeBufferSize(4);
+
+    /* The scope begun while disabled shouldn't be recorded, but its end
+       shouldn't end the outer scope either, no matter whether the profiler is
+       enabled at that point */
+    profiler.beginScope("outer");
+    profiler.disable();
+    profiler.beginScope("skipped");
+    profiler.enable();
+    {
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, "nested");
+    }
+    profiler.endScope();
+
+    /* The outer scope is still open, so it isn't exported. The skipped scope
+       isn't counted into the nested scope depth. */
+    Containers::String trace = profiler.chromeTrace();
+    CORRADE_VERIFY(!trace.contains("\"name\":\"outer\""));
+    CORRADE_VERIFY(!trace.contains("\"name\":\"skipped\""));
+    CORRADE_VERIFY(trace.contains("{\"name\":\"nested\",\"ph\":\"X\""));
+    CORRADE_VERIFY(trace.contains("\"args\":{\"depth\":1}"));
+    CORRADE_VERIFY(!trace.contains("\"args\":{\"depth\":2}"));
+
+    /* Same the other way around, the scope begun while enabled gets ended
+       even if disabled in the meantime */
+    profiler.disable();
+    profiler.endScope();
+    profiler.enable();
+
+    trace = profiler.chromeTrace();
+    CORRADE_VERIFY(trace.contains("{\"name\":\"outer\",\"ph\":\"X\""));
+    CORRADE_VERIFY(trace.contains("\"args\":{\"depth\":0}"));
+}
+
+void FrameProfilerTest::scopesOverflow() {
+    FrameProfiler profiler;
+    profiler.setScopeBufferSize(3);
+
+    /* The first scope gets overwritten while still open, its end should not
+       modify the scope that took its place */
+    profiler.beginScope("first");
+    for(const char* name: {"a", "b", "c"}) {
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, name);
+    }
+    profiler.endScope();
+    {
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, "d");
+    }
+
+    Containers::String trace = profiler.chromeTrace();
+    CORRADE_VERIFY(!trace.contains("\"name\":\"first\""));
+    CORRADE_VERIFY(!trace.contains("\"name\":\"a\""));
+    CORRADE_VERIFY(trace.contains("{\"name\":\"b\",\"ph\":\"X\""));
+    CORRADE_VERIFY(trace.contains("{\"name\":\"c\",\"ph\":\"X\""));
+    CORRADE_VERIFY(trace.contains("{\"name\":\"d\",\"ph\":\"X\""));
+    /* The nested scopes had depth 1, the last one 0 */
+    CORRADE_VERIFY(trace.contains("\"args\":{\"depth\":1}"));
+    CORRADE_VERIFY(trace.contains("\"args\":{\"depth\":0}"));
+}
+
+void FrameProfilerTest::scopesEndWithoutBegin() {
+    FrameProfiler profiler;
+    profiler.setScopeBufferSize(4);
+
+    /* Should be a no-op, not a crash */
+    profiler.endScope();
+    CORRADE_COMPARE(profiler.chromeTrace(), "{\"traceEvents\":[ \n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Thread 0\"}}\n],\"displayTimeUnit\":\"ns\"}\n");
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void FrameProfilerTest::scopesMultipleThreads() {
+    FrameProfiler profiler;
+    profiler.setScopeBufferSize(16);
+
+    {
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, "main");
+    }
+
+    std::thread a{[&profiler]{
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, "thread");
+    }};
+    a.join();
+
+    std::thread b{[&profiler]{
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(profiler, "thread");
+    }};
+    b.join();
+
+    Containers::String trace = profiler.chromeTrace();
+    CORRADE_VERIFY(trace.contains("{\"name\":\"main\",\"ph\":\"X\",\"pid\":0,\"tid\":0,"));
+    CORRADE_VERIFY(trace.contains("\"tid\":1,\"args\":{\"name\":\"Thread 1\"}"));
+    CORRADE_VERIFY(trace.contains("\"tid\":2,\"args\":{\"name\":\"Thread 2\"}"));
+    CORRADE_VERIFY(trace.contains("{\"name\":\"thread\",\"ph\":\"X\",\"pid\":0,\"tid\":1,"));
+    CORRADE_VERIFY(trace.contains("{\"name\":\"thread\",\"ph\":\"X\",\"pid\":0,\"tid\":2,"));
+}
+#endif
+
+void FrameProfilerTest::scopesMove() {
+    FrameProfiler a;
+    a.setScopeBufferSize(4);
+    {
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(a, "a");
+    }
+
+    FrameProfiler b{Utility::move(a)};
+    CORRADE_COMPARE(b.scopeBufferSize(), 4);
+    CORRADE_VERIFY(b.chromeTrace().contains("\"name\":\"a\""));
+
+    FrameProfiler c;
+    c.setScopeBufferSize(8);
+    {
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(c, "c");
+    }
+
+    c = Utility::move(b);
+    CORRADE_COMPARE(c.scopeBufferSize(), 4);
+    CORRADE_COMPARE(b.scopeBufferSize(), 8);
+    /* The thread track cache shouldn't get confused by the swap */
+    {
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(c, "c2");
+        MAGNUM_DEBUGTOOLS_PROFILE_SCOPE(b, "b2");
+    }
+    Containers::String traceC = c.chromeTrace();
+    Containers::String traceB = b.chromeTrace();
+    CORRADE_VERIFY(traceC.contains("\"name\":\"a\""));
+    CORRADE_VERIFY(traceC.contains("\"name\":\"c2\""));
+    CORRADE_VERIFY(!traceC.contains("\"name\":\"b2\""));
+    CORRADE_VERIFY(traceB.contains("\"name\":\"c\""));
+    CORRADE_VERIFY(traceB.contains("\"name\":\"b2\""));
+    CORRADE_VERIFY(!traceB.contains("\"name\":\"c2\""));
+}
+
 #ifdef MAGNUM_TARGET_GL
 void FrameProfilerTest::gl() {
     auto&& data = GLData[testCaseInstanceId()];
@@ -1173,6 +1457,107 @@ void FrameProfilerTest::glNotEnabled() {
 }
 #endif
 
+#ifdef MAGNUM_TARGET_VK
+void FrameProfilerTest::vk() {
+    auto&& data = VkData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* CPU-only measurements don't touch the device at all, so it doesn't
+       need to be created. GPU measurements are tested in
+       FrameProfilerVkTest. */
+    Vk::Device device{NoCreate};
+
+    /* Test that we use the right state pointers to survive a move */
+    Containers::Pointer<FrameProfilerVk> profiler_{InPlaceInit, device, data.values, 4u};
+    FrameProfilerVk profiler = Utility::move(*profiler_);
+    profiler_ = nullptr;
+    CORRADE_COMPARE(profiler.values(), data.values);
+    CORRADE_COMPARE(profiler.maxFrameCount(), 4);
+    CORRADE_COMPARE(profiler.framesInFlight(), 2);
+    CORRADE_COMPARE(profiler.measurementCount(), data.measurementCount);
+    /* Frame time is added first and has a delay of 2, CPU duration after it
+       with a delay of 1 */
+    if(data.measurementCount)
+        CORRADE_COMPARE(profiler.measurementDelay(0), data.measurementDelay);
+    if(data.measurementCount > 1)
+        CORRADE_COMPARE(profiler.measurementDelay(1), 1);
+
+    /* MSVC 2015 needs the {} */
+    for(auto value: {FrameProfilerVk::Value::CpuDuration,
+                     FrameProfilerVk::Value::FrameTime}) {
+        if(data.values & value)
+            CORRADE_VERIFY(!profiler.isMeasurementAvailable(value));
+    }
+
+    profiler.beginFrame();
+    Utility::System::sleep(1);
+    profiler.endFrame();
+
+    profiler.beginFrame();
+    profiler.endFrame();
+
+    Utility::System::sleep(10);
+
+    profiler.beginFrame();
+    Utility::System::sleep(1);
+    profiler.endFrame();
+
+    profiler.beginFrame();
+    Utility::System::sleep(1);
+    profiler.endFrame();
+
+    for(std::size_t i = 0; i != data.measurementCount; ++i)
+        CORRADE_VERIFY(profiler.isMeasurementAvailable(i));
+
+    /* Same expectations as in gl() above */
+    if(data.values & FrameProfilerVk::Value::CpuDuration) {
+        CORRADE_VERIFY(profiler.isMeasurementAvailable(FrameProfilerVk::Value::CpuDuration));
+        CORRADE_COMPARE_AS(profiler.cpuDurationMean(), 0.50*1000*1000,
+            TestSuite::Compare::GreaterOrEqual);
+    }
+    if(data.values & FrameProfilerVk::Value::FrameTime) {
+        CORRADE_VERIFY(profiler.isMeasurementAvailable(FrameProfilerVk::Value::FrameTime));
+        CORRADE_COMPARE_AS(profiler.frameTimeMean(), 3.20*1000*1000,
+            TestSuite::Compare::GreaterOrEqual);
+    }
+}
+
+void FrameProfilerTest::vkNotEnabled() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vk::Device device{NoCreate};
+    FrameProfilerVk profiler{device, {}, 5};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    profiler.isMeasurementAvailable(FrameProfilerVk::Value::CpuDuration);
+    profiler.frameTimeMean();
+    profiler.cpuDurationMean();
+    profiler.gpuDurationMean();
+    profiler.vertexFetchRatioMean();
+    profiler.primitiveClipRatioMean();
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::FrameProfilerVk::isMeasurementAvailable(): DebugTools::FrameProfilerVk::Value::CpuDuration not enabled\n"
+        "DebugTools::FrameProfilerVk::frameTimeMean(): not enabled\n"
+        "DebugTools::FrameProfilerVk::cpuDurationMean(): not enabled\n"
+        "DebugTools::FrameProfilerVk::gpuDurationMean(): not enabled\n"
+        "DebugTools::FrameProfilerVk::vertexFetchRatioMean(): not enabled\n"
+        "DebugTools::FrameProfilerVk::primitiveClipRatioMean(): not enabled\n");
+}
+
+void FrameProfilerTest::vkZeroFramesInFlight() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vk::Device device{NoCreate};
+    FrameProfilerVk profiler;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    profiler.setup(device, FrameProfilerVk::Value::CpuDuration, 5, 0);
+    CORRADE_COMPARE(out.str(), "DebugTools::FrameProfilerVk::setup(): expected non-zero frames in flight\n");
+}
+#endif
+
 void FrameProfilerTest::debugUnits() {
     std::ostringstream out;
 
@@ -1228,6 +1613,22 @@ void FrameProfilerTest::configurationGLValues() {
 }
 #endif
 
+#ifdef MAGNUM_TARGET_VK
+void FrameProfilerTest::debugVkValue() {
+    std::ostringstream out;
+
+    Debug{&out} << FrameProfilerVk::Value::GpuDuration << FrameProfilerVk::Value(0xfff0);
+    CORRADE_COMPARE(out.str(), "DebugTools::FrameProfilerVk::Value::GpuDuration DebugTools::FrameProfilerVk::Value(0xfff0)\n");
+}
+
+void FrameProfilerTest::debugVkValues() {
+    std::ostringstream out;
+
+    Debug{&out} << (FrameProfilerVk::Value::CpuDuration|FrameProfilerVk::Value::FrameTime) << FrameProfilerVk::Values{};
+    CORRADE_COMPARE(out.str(), "DebugTools::FrameProfilerVk::Value::FrameTime|DebugTools::FrameProfilerVk::Value::CpuDuration DebugTools::FrameProfilerVk::Values{}\n");
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::DebugTools::Test::FrameProfilerTest)
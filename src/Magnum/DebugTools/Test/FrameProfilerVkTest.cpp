@@ -0,0 +1,250 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <sstream>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/DebugTools/FrameProfilerVk.h"
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/DeviceCreateInfo.h"
+#include "Magnum/Vk/DeviceFeatures.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Fence.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace DebugTools { namespace Test { namespace {
+
+struct FrameProfilerVkTest: Vk::VulkanTester {
+    explicit FrameProfilerVkTest();
+
+    void test();
+    void vertexFetchRatioDivisionByZero();
+    void primitiveClipRatioDivisionByZero();
+
+    void noCommandBuffer();
+    void differentCommandBuffer();
+};
+
+struct {
+    const char* name;
+    FrameProfilerVk::Values values;
+    UnsignedInt framesInFlight;
+} Data[]{
+    {"gpu duration", FrameProfilerVk::Value::GpuDuration, 2},
+    {"gpu duration, one frame in flight", FrameProfilerVk::Value::GpuDuration, 1},
+    {"cpu duration + gpu duration", FrameProfilerVk::Value::CpuDuration|FrameProfilerVk::Value::GpuDuration, 2},
+    {"frame time + gpu duration", FrameProfilerVk::Value::FrameTime|FrameProfilerVk::Value::GpuDuration, 2},
+    {"gpu duration + vertex fetch ratio", FrameProfilerVk::Value::GpuDuration|FrameProfilerVk::Value::VertexFetchRatio, 2},
+    {"vertex fetch ratio + primitive clip ratio", FrameProfilerVk::Value::VertexFetchRatio|FrameProfilerVk::Value::PrimitiveClipRatio, 2}
+};
+
+FrameProfilerVkTest::FrameProfilerVkTest() {
+    addInstancedTests({&FrameProfilerVkTest::test},
+        Containers::arraySize(Data));
+
+    addTests({&FrameProfilerVkTest::vertexFetchRatioDivisionByZero,
+              &FrameProfilerVkTest::primitiveClipRatioDivisionByZero,
+
+              &FrameProfilerVkTest::noCommandBuffer,
+              &FrameProfilerVkTest::differentCommandBuffer});
+}
+
+/* Records and submits a frame with no commands except the ones done by the
+   profiler, waiting for it to finish */
+void submitFrame(FrameProfilerVk& profiler, Vk::Queue& queue, Vk::CommandPool& commandPool) {
+    Vk::CommandBuffer cmd = commandPool.allocate();
+    cmd.begin();
+    profiler.beginFrame(cmd);
+    profiler.endFrame(cmd);
+    cmd.end();
+
+    queue.submit({Vk::SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+}
+
+void FrameProfilerVkTest::test() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Vk::DeviceProperties properties = Vk::pickDevice(instance());
+    const UnsignedInt queueFamily = properties.pickQueueFamily(Vk::QueueFlag::Graphics);
+    if((data.values & FrameProfilerVk::Value::GpuDuration) && !properties.queueFamilyProperties()[queueFamily].queueFamilyProperties.timestampValidBits)
+        CORRADE_SKIP("Timestamps not supported on the graphics queue, can't test.");
+
+    const bool needsStatistics = data.values & (FrameProfilerVk::Value::VertexFetchRatio|FrameProfilerVk::Value::PrimitiveClipRatio);
+    if(needsStatistics && !(properties.features() & Vk::DeviceFeature::PipelineStatisticsQuery))
+        CORRADE_SKIP("Vk::DeviceFeature::PipelineStatisticsQuery not supported, can't test.");
+
+    Vk::Queue queue{NoCreate};
+    Vk::Device device{instance(), Vk::DeviceCreateInfo{Utility::move(properties)}
+        .addQueues(Vk::QueueFlag::Graphics, {0.0f}, {queue})
+        .setEnabledFeatures(needsStatistics ? Vk::DeviceFeature::PipelineStatisticsQuery : Vk::DeviceFeatures{})};
+    Vk::CommandPool commandPool{device, Vk::CommandPoolCreateInfo{queueFamily}};
+
+    FrameProfilerVk profiler{device, data.values, 4, data.framesInFlight};
+    CORRADE_COMPARE(profiler.values(), data.values);
+    CORRADE_COMPARE(profiler.maxFrameCount(), 4);
+    CORRADE_COMPARE(profiler.framesInFlight(), data.framesInFlight);
+
+    /* MSVC 2015 needs the {} */
+    UnsignedInt i = 0;
+    for(auto value: {FrameProfilerVk::Value::CpuDuration,
+                     FrameProfilerVk::Value::GpuDuration,
+                     FrameProfilerVk::Value::VertexFetchRatio,
+                     FrameProfilerVk::Value::PrimitiveClipRatio}) {
+        if(!(data.values & value)) continue;
+
+        CORRADE_VERIFY(!profiler.isMeasurementAvailable(value));
+        /* The names should not be allocated */
+        CORRADE_COMPARE(profiler.measurementName(i++).flags(), Containers::StringViewFlag::NullTerminated|Containers::StringViewFlag::Global);
+    }
+
+    /* The GPU measurements are delayed by framesInFlight + 1 frames, so with
+       at most two frames in flight all of them are available after four
+       frames */
+    for(std::size_t j = 0; j != 4; ++j)
+        submitFrame(profiler, queue, commandPool);
+
+    /* The GPU time should not be a total zero, as the timestamps are at the
+       opposite ends of the pipeline. It can however be very small for an
+       empty command buffer, so not testing any lower bound. */
+    if(data.values & FrameProfilerVk::Value::GpuDuration) {
+        CORRADE_VERIFY(profiler.isMeasurementAvailable(FrameProfilerVk::Value::GpuDuration));
+        CORRADE_COMPARE_AS(profiler.gpuDurationMean(), 0.0,
+            TestSuite::Compare::GreaterOrEqual);
+    }
+
+    if(data.values & FrameProfilerVk::Value::CpuDuration)
+        CORRADE_VERIFY(profiler.isMeasurementAvailable(FrameProfilerVk::Value::CpuDuration));
+
+    if(data.values & FrameProfilerVk::Value::FrameTime)
+        CORRADE_VERIFY(profiler.isMeasurementAvailable(FrameProfilerVk::Value::FrameTime));
+
+    /* No draws happened, so the ratios are zero */
+    if(data.values & FrameProfilerVk::Value::VertexFetchRatio) {
+        CORRADE_VERIFY(profiler.isMeasurementAvailable(FrameProfilerVk::Value::VertexFetchRatio));
+        CORRADE_COMPARE(profiler.vertexFetchRatioMean(), 0.0);
+    }
+    if(data.values & FrameProfilerVk::Value::PrimitiveClipRatio) {
+        CORRADE_VERIFY(profiler.isMeasurementAvailable(FrameProfilerVk::Value::PrimitiveClipRatio));
+        CORRADE_COMPARE(profiler.primitiveClipRatioMean(), 0.0);
+    }
+}
+
+void FrameProfilerVkTest::vertexFetchRatioDivisionByZero() {
+    Vk::DeviceProperties properties = Vk::pickDevice(instance());
+    if(!(properties.features() & Vk::DeviceFeature::PipelineStatisticsQuery))
+        CORRADE_SKIP("Vk::DeviceFeature::PipelineStatisticsQuery not supported, can't test.");
+
+    Vk::Queue queue{NoCreate};
+    Vk::Device device{instance(), Vk::DeviceCreateInfo{Utility::move(properties)}
+        .addQueues(Vk::QueueFlag::Graphics, {0.0f}, {queue})
+        .setEnabledFeatures(Vk::DeviceFeature::PipelineStatisticsQuery)};
+    Vk::CommandPool commandPool{device, Vk::CommandPoolCreateInfo{
+        device.properties().pickQueueFamily(Vk::QueueFlag::Graphics)}};
+
+    /* Only the vertex fetch ratio, which means it's the one beginning and
+       ending the shared query */
+    FrameProfilerVk profiler{device, FrameProfilerVk::Value::VertexFetchRatio, 4};
+    for(std::size_t i = 0; i != 4; ++i)
+        submitFrame(profiler, queue, commandPool);
+
+    /* No draws happened, so the ratio should be 0 (and not crashing with a
+       division by zero) */
+    CORRADE_VERIFY(profiler.isMeasurementAvailable(FrameProfilerVk::Value::VertexFetchRatio));
+    CORRADE_COMPARE(profiler.vertexFetchRatioMean(), 0.0);
+}
+
+void FrameProfilerVkTest::primitiveClipRatioDivisionByZero() {
+    Vk::DeviceProperties properties = Vk::pickDevice(instance());
+    if(!(properties.features() & Vk::DeviceFeature::PipelineStatisticsQuery))
+        CORRADE_SKIP("Vk::DeviceFeature::PipelineStatisticsQuery not supported, can't test.");
+
+    Vk::Queue queue{NoCreate};
+    Vk::Device device{instance(), Vk::DeviceCreateInfo{Utility::move(properties)}
+        .addQueues(Vk::QueueFlag::Graphics, {0.0f}, {queue})
+        .setEnabledFeatures(Vk::DeviceFeature::PipelineStatisticsQuery)};
+    Vk::CommandPool commandPool{device, Vk::CommandPoolCreateInfo{
+        device.properties().pickQueueFamily(Vk::QueueFlag::Graphics)}};
+
+    /* Only the primitive clip ratio, which means it's the one beginning and
+       ending the shared query */
+    FrameProfilerVk profiler{device, FrameProfilerVk::Value::PrimitiveClipRatio, 4};
+    for(std::size_t i = 0; i != 4; ++i)
+        submitFrame(profiler, queue, commandPool);
+
+    /* No draws happened, so the ratio should be 0 (and not crashing with a
+       division by zero) */
+    CORRADE_VERIFY(profiler.isMeasurementAvailable(FrameProfilerVk::Value::PrimitiveClipRatio));
+    CORRADE_COMPARE(profiler.primitiveClipRatioMean(), 0.0);
+}
+
+void FrameProfilerVkTest::noCommandBuffer() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    FrameProfilerVk profiler{device(), FrameProfilerVk::Value::GpuDuration, 4};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::FrameProfilerVk::beginFrame(): a command buffer is required for GPU measurements\n"
+        "DebugTools::FrameProfilerVk::endFrame(): a command buffer is required for GPU measurements\n");
+}
+
+void FrameProfilerVkTest::differentCommandBuffer() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vk::DeviceProperties properties = Vk::pickDevice(instance());
+    if(!(properties.features() & Vk::DeviceFeature::PipelineStatisticsQuery))
+        CORRADE_SKIP("Vk::DeviceFeature::PipelineStatisticsQuery not supported, can't test.");
+
+    Vk::Queue queue{NoCreate};
+    Vk::Device device{instance(), Vk::DeviceCreateInfo{Utility::move(properties)}
+        .addQueues(Vk::QueueFlag::Graphics, {0.0f}, {queue})
+        .setEnabledFeatures(Vk::DeviceFeature::PipelineStatisticsQuery)};
+    Vk::CommandPool commandPool{device, Vk::CommandPoolCreateInfo{
+        device.properties().pickQueueFamily(Vk::QueueFlag::Graphics)}};
+
+    FrameProfilerVk profiler{device, FrameProfilerVk::Value::VertexFetchRatio, 4};
+
+    Vk::CommandBuffer a = commandPool.allocate();
+    Vk::CommandBuffer b = commandPool.allocate();
+    a.begin();
+    b.begin();
+    profiler.beginFrame(a);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    profiler.endFrame(b);
+    CORRADE_COMPARE(out.str(), "DebugTools::FrameProfilerVk::endFrame(): pipeline statistics have to be queried in the same command buffer as passed to beginFrame()\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::FrameProfilerVkTest)
@@ -0,0 +1,403 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AsyncTextureUploader.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional> /* std::ref */
+#include <mutex>
+#include <thread>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Move.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/PixelFormat.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/Implementation/RendererState.h"
+#include "Magnum/GL/Implementation/State.h"
+#include "Magnum/GL/Implementation/TextureState.h"
+#include "Magnum/Implementation/ImageProperties.h"
+
+namespace Magnum { namespace GL {
+
+namespace Implementation {
+
+struct AsyncTextureUploaderUpload {
+    Texture2D* texture;
+    Int level;
+    Vector2i offset;
+    Vector2i size;
+    bool compressed;
+    PixelStorage storage;
+    CompressedPixelStorage compressedStorage;
+    PixelFormat format;
+    PixelType type;
+    CompressedPixelFormat compressedFormat;
+    /* For compressed images the size of the actually occupied data, which is
+       what glCompressedTexSubImage() expects */
+    GLsizei uploadSize;
+    /* Source data, referenced until the upload is copied to a buffer. Set to
+       null by the worker thread once copied. */
+    Containers::ArrayView<const char> data;
+    /* Offset of the data in the buffer, filled when copying */
+    std::size_t bufferOffset;
+};
+
+struct AsyncTextureUploaderSlot {
+    enum class State: UnsignedByte {
+        /* Buffer is available for copying */
+        Free,
+        /* Buffer is mapped and a worker thread copies the data into it,
+           uploads will be issued once the copy finishes */
+        Copying,
+        /* Uploads got issued, waiting for the fence */
+        InFlight
+    };
+
+    Buffer buffer{NoCreate};
+    State state;
+    GLsync fence;
+    /* Order in which the buffer got filled, uploads are issued in it */
+    UnsignedLong fillIndex;
+    Containers::Array<AsyncTextureUploaderUpload> uploads;
+    /* Set by the worker thread when done copying. Only the worker touches
+       the uploads while the state is Copying. */
+    std::atomic<bool> copied;
+};
+
+struct AsyncTextureUploaderWorker {
+    struct Job {
+        AsyncTextureUploaderSlot* slot;
+        Containers::ArrayView<char> mapped;
+    };
+
+    /* Job queue, guarded by the mutex. Jobs are taken from the front in the
+       order the buffers were filled, once the queue is empty it's cleared to
+       reuse the memory. */
+    std::mutex mutex;
+    std::condition_variable jobAvailable, jobDone;
+    Containers::Array<Job> jobs;
+    std::size_t jobOffset{};
+    bool stop{};
+
+    /* Created once for the whole uploader lifetime and joined in the
+       destructor, so update() doesn't create a thread every frame */
+    std::thread thread;
+};
+
+}
+
+namespace {
+    /* Offsets in the pixel unpack buffer have to be a multiple of the pixel
+       size, and the row alignment from PixelStorage is calculated relative to
+       the offset as well, so keep all of them sufficiently aligned */
+    constexpr std::size_t BufferOffsetAlignment = 16;
+}
+
+AsyncTextureUploader::AsyncTextureUploader(const std::size_t bufferSize, const UnsignedInt bufferCount): _bufferSize{bufferSize}, _frameBudget{bufferSize}, _queueOffset{}, _fillCounter{} {
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_ASSERT(Context::current().isExtensionSupported<Extensions::ARB::sync>(),
+        "GL::AsyncTextureUploader:" << Extensions::ARB::sync::string() << "is not supported", );
+    #endif
+    CORRADE_ASSERT(bufferSize,
+        "GL::AsyncTextureUploader: expected non-zero buffer size", );
+    CORRADE_ASSERT(bufferCount >= 2,
+        "GL::AsyncTextureUploader: expected at least two buffers, got" << bufferCount, );
+
+    _slots = Containers::Array<Implementation::AsyncTextureUploaderSlot>{bufferCount};
+    for(Implementation::AsyncTextureUploaderSlot& slot: _slots) {
+        slot.buffer = Buffer{Buffer::TargetHint::PixelUnpack};
+        slot.buffer.setData({nullptr, bufferSize}, BufferUsage::StreamDraw);
+        slot.state = Implementation::AsyncTextureUploaderSlot::State::Free;
+        slot.fence = nullptr;
+    }
+
+    /* The worker state is on the heap and the slot array is never
+       reallocated, so the pointers the worker uses stay valid even if the
+       uploader gets moved */
+    _worker.emplace();
+    _worker->thread = std::thread{[](Implementation::AsyncTextureUploaderWorker& worker) {
+        for(;;) {
+            Implementation::AsyncTextureUploaderWorker::Job job;
+            {
+                std::unique_lock<std::mutex> lock{worker.mutex};
+                worker.jobAvailable.wait(lock, [&worker]{
+                    return worker.stop || worker.jobOffset != worker.jobs.size();
+                });
+                /* Stop only once there's no more work, as the buffers can't
+                   be deleted while still being written to */
+                if(worker.jobOffset == worker.jobs.size()) return;
+
+                job = worker.jobs[worker.jobOffset++];
+                if(worker.jobOffset == worker.jobs.size()) {
+                    arrayResize(worker.jobs, 0);
+                    worker.jobOffset = 0;
+                }
+            }
+
+            for(Implementation::AsyncTextureUploaderUpload& upload: job.slot->uploads) {
+                Utility::copy(upload.data, job.mapped.sliceSize(upload.bufferOffset, upload.data.size()));
+                /* The data is not referenced anymore */
+                upload.data = nullptr;
+            }
+
+            /* Set under the lock so finishCopying() can't miss the
+               notification */
+            {
+                std::unique_lock<std::mutex> lock{worker.mutex};
+                job.slot->copied.store(true, std::memory_order_release);
+            }
+            worker.jobDone.notify_all();
+        }
+    }, std::ref(*_worker)};
+}
+
+AsyncTextureUploader::AsyncTextureUploader(NoCreateT) noexcept: _bufferSize{}, _frameBudget{}, _queueOffset{}, _fillCounter{} {}
+
+AsyncTextureUploader::AsyncTextureUploader(AsyncTextureUploader&&) noexcept = default;
+
+AsyncTextureUploader::~AsyncTextureUploader() {
+    /* The buffers can't be deleted while the worker is still writing to the
+       mapped memory, so let it finish the remaining copies first */
+    if(_worker) {
+        {
+            std::unique_lock<std::mutex> lock{_worker->mutex};
+            _worker->stop = true;
+        }
+        _worker->jobAvailable.notify_all();
+        _worker->thread.join();
+    }
+
+    for(Implementation::AsyncTextureUploaderSlot& slot: _slots)
+        if(slot.fence) glDeleteSync(slot.fence);
+}
+
+AsyncTextureUploader& AsyncTextureUploader::operator=(AsyncTextureUploader&& other) noexcept {
+    using Utility::swap;
+    swap(_bufferSize, other._bufferSize);
+    swap(_frameBudget, other._frameBudget);
+    swap(_slots, other._slots);
+    swap(_queue, other._queue);
+    swap(_queueOffset, other._queueOffset);
+    swap(_fillCounter, other._fillCounter);
+    swap(_worker, other._worker);
+    return *this;
+}
+
+UnsignedInt AsyncTextureUploader::bufferCount() const { return _slots.size(); }
+
+AsyncTextureUploader& AsyncTextureUploader::setFrameBudget(const std::size_t budget) {
+    CORRADE_ASSERT(budget,
+        "GL::AsyncTextureUploader::setFrameBudget(): expected a non-zero budget", *this);
+    _frameBudget = budget;
+    return *this;
+}
+
+std::size_t AsyncTextureUploader::pendingCount() const {
+    std::size_t count = _queue.size() - _queueOffset;
+    for(const Implementation::AsyncTextureUploaderSlot& slot: _slots)
+        if(slot.state == Implementation::AsyncTextureUploaderSlot::State::Copying)
+            count += slot.uploads.size();
+    return count;
+}
+
+std::size_t AsyncTextureUploader::inFlightCount() const {
+    std::size_t count = 0;
+    for(const Implementation::AsyncTextureUploaderSlot& slot: _slots)
+        if(slot.state == Implementation::AsyncTextureUploaderSlot::State::InFlight)
+            count += slot.uploads.size();
+    return count;
+}
+
+AsyncTextureUploader& AsyncTextureUploader::upload(Texture2D& texture, const Int level, const Vector2i& offset, const ImageView2D& image) {
+    CORRADE_ASSERT(image.data().size() <= _bufferSize,
+        "GL::AsyncTextureUploader::upload(): expected image data to fit into" << _bufferSize << "bytes but got" << image.data().size(), *this);
+
+    Implementation::AsyncTextureUploaderUpload& upload = arrayAppend(_queue, InPlaceInit);
+    upload.texture = &texture;
+    upload.level = level;
+    upload.offset = offset;
+    upload.size = image.size();
+    upload.compressed = false;
+    upload.storage = image.storage();
+    upload.format = pixelFormat(image.format());
+    upload.type = pixelType(image.format(), image.formatExtra());
+    upload.data = image.data();
+    return *this;
+}
+
+AsyncTextureUploader& AsyncTextureUploader::upload(Texture2D& texture, const Int level, const Vector2i& offset, const CompressedImageView2D& image) {
+    CORRADE_ASSERT(image.data().size() <= _bufferSize,
+        "GL::AsyncTextureUploader::upload(): expected image data to fit into" << _bufferSize << "bytes but got" << image.data().size(), *this);
+
+    Implementation::AsyncTextureUploaderUpload& upload = arrayAppend(_queue, InPlaceInit);
+    upload.texture = &texture;
+    upload.level = level;
+    upload.offset = offset;
+    upload.size = image.size();
+    upload.compressed = true;
+    upload.compressedStorage = image.storage();
+    upload.compressedFormat = compressedPixelFormat(image.format());
+    upload.uploadSize = Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size());
+    upload.data = image.data();
+    return *this;
+}
+
+void AsyncTextureUploader::issueCopiedUploads(const bool wait) {
+    Implementation::State& state = Context::current().state();
+    using SlotState = Implementation::AsyncTextureUploaderSlot::State;
+
+    /* Go through the buffers in the order they were filled, so uploads to
+       overlapping texture regions are issued in the order they were queued.
+       If not waiting, stop at the first buffer that's still being copied. */
+    for(;;) {
+        Implementation::AsyncTextureUploaderSlot* next = nullptr;
+        for(Implementation::AsyncTextureUploaderSlot& slot: _slots)
+            if(slot.state == SlotState::Copying && (!next || slot.fillIndex < next->fillIndex))
+                next = &slot;
+        if(!next || (!wait && !next->copied.load(std::memory_order_acquire)))
+            break;
+
+        /* Wait for the worker to finish, if it's not done yet. The acquire
+           load makes its writes visible to this thread. */
+        if(wait) {
+            std::unique_lock<std::mutex> lock{_worker->mutex};
+            _worker->jobDone.wait(lock, [next]{
+                return next->copied.load(std::memory_order_acquire);
+            });
+        }
+        next->buffer.unmap();
+
+        /* Textures are uploaded with the buffer bound, so the data pointer is
+           just an offset into it */
+        next->buffer.bindInternal(Buffer::TargetHint::PixelUnpack);
+        for(const Implementation::AsyncTextureUploaderUpload& upload: next->uploads) {
+            const GLvoid* const data = reinterpret_cast<const GLvoid*>(upload.bufferOffset);
+            if(upload.compressed) {
+                state.renderer.applyPixelStorageUnpack(upload.compressedStorage);
+                state.texture.compressedSubImage2DImplementation(*upload.texture, upload.level, upload.offset, upload.size, upload.compressedFormat, data, upload.uploadSize);
+            } else {
+                state.renderer.applyPixelStorageUnpack(upload.storage);
+                state.texture.subImage2DImplementation(*upload.texture, upload.level, upload.offset, upload.size, upload.format, upload.type, data, upload.storage);
+            }
+        }
+
+        next->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        next->state = SlotState::InFlight;
+    }
+}
+
+void AsyncTextureUploader::update() {
+    using SlotState = Implementation::AsyncTextureUploaderSlot::State;
+
+    /* Recycle buffers the GPU is done with. Not waiting for anything, if the
+       fence isn't signaled yet we'll check again next frame. */
+    for(Implementation::AsyncTextureUploaderSlot& slot: _slots) {
+        if(slot.state != SlotState::InFlight) continue;
+
+        const GLenum status = glClientWaitSync(slot.fence, 0, 0);
+        if(status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            continue;
+
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+        arrayResize(slot.uploads, 0);
+        slot.state = SlotState::Free;
+    }
+
+    /* Issue uploads from buffers the worker thread finished copying to */
+    issueCopiedUploads(false);
+
+    /* Nothing to copy, done */
+    if(_queueOffset == _queue.size()) return;
+
+    /* Find a free buffer. If there's none, the GPU or the worker is behind
+       and we'll try again next frame. */
+    Implementation::AsyncTextureUploaderSlot* freeSlot = nullptr;
+    for(Implementation::AsyncTextureUploaderSlot& slot: _slots) {
+        if(slot.state == SlotState::Free) {
+            freeSlot = &slot;
+            break;
+        }
+    }
+    if(!freeSlot) return;
+
+    /* The buffer is known to be unused by the GPU at this point, so it can
+       be mapped without synchronization, and since the whole contents get
+       replaced, the previous contents can be discarded. Mapping has to
+       happen on the GL thread, only the copy is offloaded. */
+    const Containers::ArrayView<char> mapped = freeSlot->buffer.map(0, _bufferSize,
+        Buffer::MapFlag::Write|
+        Buffer::MapFlag::InvalidateBuffer|
+        Buffer::MapFlag::Unsynchronized);
+    CORRADE_INTERNAL_ASSERT(mapped);
+
+    /* Assign as many queued uploads as fit into the buffer and the frame
+       budget, but always at least one to ensure progress */
+    std::size_t bufferOffset = 0;
+    while(_queueOffset != _queue.size()) {
+        Implementation::AsyncTextureUploaderUpload& upload = _queue[_queueOffset];
+        const std::size_t size = upload.data.size();
+        if(bufferOffset + size > _bufferSize || (bufferOffset && bufferOffset + size > _frameBudget))
+            break;
+
+        upload.bufferOffset = bufferOffset;
+        arrayAppend(freeSlot->uploads, upload);
+
+        bufferOffset += (size + BufferOffsetAlignment - 1)/BufferOffsetAlignment*BufferOffsetAlignment;
+        ++_queueOffset;
+    }
+
+    /* Hand the copy over to the worker thread. The mutex makes the slot
+       contents written above visible to it. */
+    freeSlot->state = SlotState::Copying;
+    freeSlot->fillIndex = _fillCounter++;
+    freeSlot->copied.store(false, std::memory_order_relaxed);
+    {
+        std::unique_lock<std::mutex> lock{_worker->mutex};
+        arrayAppend(_worker->jobs, Implementation::AsyncTextureUploaderWorker::Job{freeSlot, mapped});
+    }
+    _worker->jobAvailable.notify_one();
+
+    /* If the whole queue got consumed, reset it so it doesn't grow
+       indefinitely. The capacity stays, so it doesn't get reallocated every
+       frame. */
+    if(_queueOffset == _queue.size()) {
+        arrayResize(_queue, 0);
+        _queueOffset = 0;
+    }
+}
+
+void AsyncTextureUploader::finishCopying() {
+    issueCopiedUploads(true);
+}
+
+}}
@@ -0,0 +1,261 @@
+#ifndef Magnum_GL_AsyncTextureUploader_h
+#define Magnum_GL_AsyncTextureUploader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::GL::AsyncTextureUploader
+ * @m_since_latest
+ */
+#endif
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Tags.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/visibility.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace GL {
+
+namespace Implementation {
+    struct AsyncTextureUploaderSlot;
+    struct AsyncTextureUploaderUpload;
+    struct AsyncTextureUploaderWorker;
+}
+
+/**
+@brief Asynchronous texture uploader
+@m_since_latest
+
+Streams image data to textures through a ring of pixel unpack buffers, in
+order to avoid stalls that @ref Texture::setSubImage() with an
+@ref ImageView may cause when the driver has to copy the data synchronously.
+Unlike @ref BufferImage, which is a single buffer tied to a single image, the
+buffers here are reused across frames and many uploads, with the GPU progress
+tracked via fence sync objects.
+
+@section GL-AsyncTextureUploader-usage Usage
+
+Create the uploader with a size large enough to fit the largest image you
+expect to upload, queue uploads using @ref upload() and call @ref update() once
+per frame. Each @ref update() call performs the following, in order:
+
+1.  Buffers whose fence got signaled, i.e. the GPU finished the uploads from
+    them, are marked as available again. This is a non-blocking check.
+2.  Buffers for which the worker thread finished copying are unmapped, bound
+    as the pixel unpack buffer and the actual texture uploads are issued from
+    them, followed by a fence. This is a non-blocking check as well, buffers
+    are processed in the order they were filled and a buffer for which the
+    copy is still in progress is checked again in the next @ref update().
+3.  If there's a free buffer, it's mapped via an unsynchronized
+    @ref Buffer::map() and the next queued uploads are assigned to it, until
+    either the buffer space or the per-frame byte budget set via
+    @ref setFrameBudget() is exhausted. The data are then copied into the
+    mapped memory on a worker thread, without blocking the calling thread.
+
+The worker thread is created in the constructor and lives until the uploader
+is destroyed, it sleeps while there's nothing to copy and buffers filled in
+consecutive @ref update() calls are queued to it.
+
+All OpenGL calls happen on the thread calling @ref update(), only the memory
+copy is done on the worker thread. A queued image thus reaches the texture
+at the earliest in the @ref update() call following the one that started the
+copy. Use @ref finishCopying() to wait for the copies in progress and issue the
+uploads right away.
+
+The image data are referenced until the copy finishes, so the memory passed
+to @ref upload() has to stay in scope until @ref pendingCount() drops to zero.
+Similarly, the target textures have to stay alive until both
+@ref pendingCount() and @ref inFlightCount() drop to zero.
+
+@section GL-AsyncTextureUploader-budget Per-frame budget
+
+To avoid frame time spikes when streaming many large images, the amount of
+bytes copied in a single @ref update() can be limited with
+@ref setFrameBudget(). At least one image is always copied per frame in order
+to make progress even if a single image is larger than the budget, however an
+image can never be larger than @ref bufferSize().
+
+@requires_gl30 Extension @gl_extension{ARB,map_buffer_range}
+@requires_gl32 Extension @gl_extension{ARB,sync}
+@requires_gles30 Pixel buffer objects and fence sync objects are not available
+    in OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+class MAGNUM_GL_EXPORT AsyncTextureUploader {
+    public:
+        /**
+         * @brief Constructor
+         * @param bufferSize    Size of each pixel unpack buffer in bytes
+         * @param bufferCount   Count of buffers in the ring. Expected to be at
+         *      least @cpp 2 @ce.
+         *
+         * Allocates @p bufferCount pixel unpack buffers, each @p bufferSize
+         * bytes large. The frame budget is set to @p bufferSize, i.e.
+         * effectively unlimited.
+         * @see @fn_gl_keyword{BufferData}
+         */
+        explicit AsyncTextureUploader(std::size_t bufferSize, UnsignedInt bufferCount = 3);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL objects
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit AsyncTextureUploader(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        AsyncTextureUploader(const AsyncTextureUploader&) = delete;
+
+        /** @brief Move constructor */
+        AsyncTextureUploader(AsyncTextureUploader&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Waits for copies in progress to finish, then deletes all buffers
+         * and fences. Uploads that were not issued yet are discarded.
+         */
+        ~AsyncTextureUploader();
+
+        /** @brief Copying is not allowed */
+        AsyncTextureUploader& operator=(const AsyncTextureUploader&) = delete;
+
+        /** @brief Move assignment */
+        AsyncTextureUploader& operator=(AsyncTextureUploader&&) noexcept;
+
+        /** @brief Size of each pixel unpack buffer in bytes */
+        std::size_t bufferSize() const { return _bufferSize; }
+
+        /** @brief Count of pixel unpack buffers in the ring */
+        UnsignedInt bufferCount() const;
+
+        /** @brief Max count of bytes copied in a single @ref update() */
+        std::size_t frameBudget() const { return _frameBudget; }
+
+        /**
+         * @brief Set max count of bytes copied in a single @ref update()
+         * @return Reference to self (for method chaining)
+         *
+         * Values larger than @ref bufferSize() have the same effect as
+         * @ref bufferSize(). Expects that @p budget is not zero. Default is
+         * @ref bufferSize().
+         */
+        AsyncTextureUploader& setFrameBudget(std::size_t budget);
+
+        /**
+         * @brief Queue an image upload
+         * @param texture   Texture to upload to
+         * @param level     Mip level
+         * @param offset    Offset where to put the data in the texture
+         * @param image     Image to upload
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the image data fit into @ref bufferSize(). The
+         * @p image data and the @p texture are only referenced, see the
+         * @ref GL-AsyncTextureUploader-usage "class documentation" for
+         * details about their lifetime. The upload is eventually performed
+         * with the same effect as
+         * @ref Texture::setSubImage(Int, const VectorTypeFor<dimensions, Int>&, const BasicImageView<dimensions>&).
+         */
+        AsyncTextureUploader& upload(Texture2D& texture, Int level, const Vector2i& offset, const ImageView2D& image);
+
+        /**
+         * @brief Queue a compressed image upload
+         * @return Reference to self (for method chaining)
+         *
+         * Compressed counterpart to @ref upload(Texture2D&, Int, const Vector2i&, const ImageView2D&),
+         * eventually performed with the same effect as
+         * @ref Texture::setCompressedSubImage(Int, const VectorTypeFor<dimensions, Int>&, const BasicCompressedImageView<dimensions>&).
+         */
+        AsyncTextureUploader& upload(Texture2D& texture, Int level, const Vector2i& offset, const CompressedImageView2D& image);
+
+        /**
+         * @brief Count of uploads that weren't issued yet
+         *
+         * Includes both uploads that are queued and uploads that are being
+         * copied to a buffer on the worker thread. Data passed to
+         * @ref upload() need to stay in scope until they're copied.
+         */
+        std::size_t pendingCount() const;
+
+        /**
+         * @brief Count of uploads issued but not finished yet
+         *
+         * Uploads that were issued but the GPU didn't signal their fence
+         * yet.
+         */
+        std::size_t inFlightCount() const;
+
+        /**
+         * @brief Advance the upload pipeline
+         *
+         * Expected to be called once per frame. See the
+         * @ref GL-AsyncTextureUploader-usage "class documentation" for
+         * details.
+         * @see @fn_gl_keyword{ClientWaitSync}, @fn_gl_keyword{FenceSync},
+         *      @fn_gl_keyword{MapBufferRange}, @fn_gl_keyword{UnmapBuffer},
+         *      @fn_gl2_keyword{TextureSubImage2D,TexSubImage2D},
+         *      @fn_gl2_keyword{CompressedTextureSubImage2D,CompressedTexSubImage2D}
+         */
+        void update();
+
+        /**
+         * @brief Finish copies in progress
+         *
+         * Blocks until the worker thread finishes all copies started by
+         * previous @ref update() calls and issues the corresponding uploads.
+         * Queued uploads that weren't assigned to a buffer yet are not
+         * affected. Afterwards, @ref pendingCount() includes only these.
+         * @see @fn_gl_keyword{FenceSync}, @fn_gl_keyword{UnmapBuffer},
+         *      @fn_gl2_keyword{TextureSubImage2D,TexSubImage2D},
+         *      @fn_gl2_keyword{CompressedTextureSubImage2D,CompressedTexSubImage2D}
+         */
+        void finishCopying();
+
+    private:
+        void MAGNUM_GL_LOCAL issueCopiedUploads(bool wait);
+
+        std::size_t _bufferSize, _frameBudget;
+        Containers::Array<Implementation::AsyncTextureUploaderSlot> _slots;
+        Containers::Array<Implementation::AsyncTextureUploaderUpload> _queue;
+        std::size_t _queueOffset;
+        /* Incremented for every buffer filled, to issue the uploads in the
+           order they were queued */
+        UnsignedLong _fillCounter;
+        Containers::Pointer<Implementation::AsyncTextureUploaderWorker> _worker;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
@@ -64,6 +64,10 @@ class AbstractQuery;
 class AbstractShaderProgram;
 class AbstractTexture;
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class AsyncTextureUploader;
+#endif
+
 template<UnsignedInt, class> class Attribute;
 
 enum class BufferUsage: GLenum;
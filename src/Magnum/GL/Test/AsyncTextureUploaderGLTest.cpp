@@ -0,0 +1,229 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/AsyncTextureUploader.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/PixelFormat.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct AsyncTextureUploaderGLTest: OpenGLTester {
+    explicit AsyncTextureUploaderGLTest();
+
+    void construct();
+    void constructMove();
+
+    void upload();
+    void uploadFrameBudget();
+    void uploadTooLarge();
+};
+
+AsyncTextureUploaderGLTest::AsyncTextureUploaderGLTest() {
+    addTests({&AsyncTextureUploaderGLTest::construct,
+              &AsyncTextureUploaderGLTest::constructMove,
+
+              &AsyncTextureUploaderGLTest::upload,
+              &AsyncTextureUploaderGLTest::uploadFrameBudget,
+              &AsyncTextureUploaderGLTest::uploadTooLarge});
+}
+
+using namespace Math::Literals;
+
+constexpr Color4ub Data[]{
+    0x11223344_rgba, 0x55667788_rgba,
+    0x99aabbcc_rgba, 0xddeeff00_rgba
+};
+
+void AsyncTextureUploaderGLTest::construct() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::sync>())
+        CORRADE_SKIP(Extensions::ARB::sync::string() << "is not supported.");
+    #endif
+
+    {
+        AsyncTextureUploader uploader{1024, 4};
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_COMPARE(uploader.bufferSize(), 1024);
+        CORRADE_COMPARE(uploader.bufferCount(), 4);
+        CORRADE_COMPARE(uploader.frameBudget(), 1024);
+        CORRADE_COMPARE(uploader.pendingCount(), 0);
+        CORRADE_COMPARE(uploader.inFlightCount(), 0);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void AsyncTextureUploaderGLTest::constructMove() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::sync>())
+        CORRADE_SKIP(Extensions::ARB::sync::string() << "is not supported.");
+    #endif
+
+    AsyncTextureUploader a{1024, 2};
+
+    AsyncTextureUploader b{Utility::move(a)};
+    CORRADE_COMPARE(a.bufferCount(), 0);
+    CORRADE_COMPARE(b.bufferSize(), 1024);
+    CORRADE_COMPARE(b.bufferCount(), 2);
+
+    AsyncTextureUploader c{512, 3};
+    c = Utility::move(b);
+    CORRADE_COMPARE(b.bufferSize(), 512);
+    CORRADE_COMPARE(b.bufferCount(), 3);
+    CORRADE_COMPARE(c.bufferSize(), 1024);
+    CORRADE_COMPARE(c.bufferCount(), 2);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<AsyncTextureUploader>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<AsyncTextureUploader>::value);
+}
+
+void AsyncTextureUploaderGLTest::upload() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::sync>())
+        CORRADE_SKIP(Extensions::ARB::sync::string() << "is not supported.");
+    #endif
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, Vector2i{2, 4});
+
+    AsyncTextureUploader uploader{1024};
+    uploader.upload(texture, 0, {}, ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, Data})
+            .upload(texture, 0, {0, 2}, ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, Data});
+    CORRADE_COMPARE(uploader.pendingCount(), 2);
+    CORRADE_COMPARE(uploader.inFlightCount(), 0);
+
+    /* First update starts the copy on a worker thread. The uploads are
+       pending until issued, regardless of whether the worker finished
+       already. */
+    uploader.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(uploader.pendingCount(), 2);
+    CORRADE_COMPARE(uploader.inFlightCount(), 0);
+
+    /* Waiting for the copy issues the uploads */
+    uploader.finishCopying();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(uploader.pendingCount(), 0);
+    CORRADE_COMPARE(uploader.inFlightCount(), 2);
+
+    /* Nothing left to copy or issue */
+    uploader.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(uploader.pendingCount(), 0);
+
+    /* Wait until everything is done, then the next update should recycle the
+       buffer */
+    Renderer::finish();
+    uploader.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(uploader.inFlightCount(), 0);
+
+    /** @todo How to test this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = texture.image(0, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.size(), (Vector2i{2, 4}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<Color4ub>(image.data()), Containers::arrayView<Color4ub>({
+        0x11223344_rgba, 0x55667788_rgba,
+        0x99aabbcc_rgba, 0xddeeff00_rgba,
+        0x11223344_rgba, 0x55667788_rgba,
+        0x99aabbcc_rgba, 0xddeeff00_rgba
+    }), TestSuite::Compare::Container);
+    #endif
+}
+
+void AsyncTextureUploaderGLTest::uploadFrameBudget() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::sync>())
+        CORRADE_SKIP(Extensions::ARB::sync::string() << "is not supported.");
+    #endif
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, Vector2i{2, 6});
+
+    /* Each image is 16 bytes, so only one fits into the budget */
+    AsyncTextureUploader uploader{1024};
+    uploader.setFrameBudget(20);
+    CORRADE_COMPARE(uploader.frameBudget(), 20);
+
+    uploader.upload(texture, 0, {}, ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, Data})
+            .upload(texture, 0, {0, 2}, ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, Data})
+            .upload(texture, 0, {0, 4}, ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, Data});
+    CORRADE_COMPARE(uploader.pendingCount(), 3);
+
+    uploader.update();
+    uploader.finishCopying();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(uploader.pendingCount(), 2);
+    CORRADE_COMPARE(uploader.inFlightCount(), 1);
+
+    uploader.update();
+    uploader.finishCopying();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(uploader.pendingCount(), 1);
+
+    /* Three buffers by default, so the third should be available even if the
+       GPU didn't finish any of the previous uploads yet */
+    uploader.update();
+    uploader.finishCopying();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(uploader.pendingCount(), 0);
+}
+
+void AsyncTextureUploaderGLTest::uploadTooLarge() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::sync>())
+        CORRADE_SKIP(Extensions::ARB::sync::string() << "is not supported.");
+    #endif
+
+    Texture2D texture;
+    AsyncTextureUploader uploader{8};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    uploader.upload(texture, 0, {}, ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, Data});
+    CORRADE_COMPARE(out.str(), "GL::AsyncTextureUploader::upload(): expected image data to fit into 8 bytes but got 16\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::AsyncTextureUploaderGLTest)
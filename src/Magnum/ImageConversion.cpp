@@ -0,0 +1,401 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ImageConversion.h"
+
+#include <algorithm> /* std::swap_ranges() */
+#include <cstring>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/PackingBatch.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#elif defined(CORRADE_TARGET_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Magnum {
+
+namespace {
+
+/* Splits the rows into at most threadCount contiguous ranges and calls
+   f(begin, end) for each, with the first range processed on the calling
+   thread. There's no work stealing or anything, the rows are all expected to
+   take roughly the same time to process. */
+template<class F> void forEachRowRange(const std::size_t rowCount, const UnsignedInt threadCount, const F& f) {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    const std::size_t chunkCount = Math::max(Math::min(std::size_t(threadCount ? threadCount : Math::max(std::thread::hardware_concurrency(), 1u)), rowCount), std::size_t{1});
+    if(chunkCount > 1) {
+        Containers::Array<std::thread> threads;
+        arrayReserve(threads, chunkCount - 1);
+        for(std::size_t i = 1; i != chunkCount; ++i)
+            arrayAppend(threads, InPlaceInit, f, rowCount*i/chunkCount, rowCount*(i + 1)/chunkCount);
+        f(std::size_t{0}, rowCount/chunkCount);
+        for(std::thread& thread: threads) thread.join();
+        return;
+    }
+    #else
+    static_cast<void>(threadCount);
+    #endif
+
+    f(std::size_t{0}, rowCount);
+}
+
+template<class T, std::size_t channelCount> void swizzleBgrRows(const Containers::StridedArrayView3D<char>& pixels, const std::size_t begin, const std::size_t end) {
+    const std::size_t width = pixels.size()[1];
+    for(std::size_t y = begin; y != end; ++y) {
+        /* Plain pointer access on a contiguous row so the compiler has a
+           chance to turn this into shuffles */
+        T* const row = static_cast<T*>(pixels[y].data());
+        for(std::size_t i = 0, max = width*channelCount; i != max; i += channelCount) {
+            const T b = row[i];
+            row[i] = row[i + 2];
+            row[i + 2] = b;
+        }
+    }
+}
+
+#if defined(CORRADE_TARGET_SSE2) || defined(CORRADE_TARGET_NEON)
+/* The most common case, BGRA <-> RGBA with 8-bit channels, has a dedicated
+   SIMD variant. The pixels that don't fill a whole vector are handled by the
+   same scalar loop as above. */
+template<> void swizzleBgrRows<UnsignedByte, 4>(const Containers::StridedArrayView3D<char>& pixels, const std::size_t begin, const std::size_t end) {
+    const std::size_t width = pixels.size()[1];
+    #ifdef CORRADE_TARGET_SSE2
+    /* No byte shuffle in plain SSE2, so the first and third byte of each
+       four-byte pixel get exchanged with shifts and masks */
+    const std::size_t simdWidth = width - width % 4;
+    const __m128i mask = _mm_set1_epi32(0xff);
+    const __m128i maskKeep = _mm_set1_epi32(int(0xff00ff00));
+    #else
+    /* Loads sixteen pixels deinterleaved into four channel vectors */
+    const std::size_t simdWidth = width - width % 16;
+    #endif
+    for(std::size_t y = begin; y != end; ++y) {
+        UnsignedByte* const row = static_cast<UnsignedByte*>(pixels[y].data());
+        #ifdef CORRADE_TARGET_SSE2
+        for(std::size_t i = 0; i != simdWidth*4; i += 16) {
+            __m128i* const data = reinterpret_cast<__m128i*>(row + i);
+            const __m128i v = _mm_loadu_si128(data);
+            _mm_storeu_si128(data, _mm_or_si128(_mm_and_si128(v, maskKeep),
+                _mm_or_si128(_mm_and_si128(_mm_srli_epi32(v, 16), mask),
+                             _mm_slli_epi32(_mm_and_si128(v, mask), 16))));
+        }
+        #else
+        for(std::size_t i = 0; i != simdWidth*4; i += 64) {
+            uint8x16x4_t v = vld4q_u8(row + i);
+            const uint8x16_t b = v.val[0];
+            v.val[0] = v.val[2];
+            v.val[2] = b;
+            vst4q_u8(row + i, v);
+        }
+        #endif
+        for(std::size_t i = simdWidth*4, max = width*4; i != max; i += 4) {
+            const UnsignedByte b = row[i];
+            row[i] = row[i + 2];
+            row[i + 2] = b;
+        }
+    }
+}
+#endif
+
+/* Packs four floats at a time to half-floats, returning the count of values
+   processed. Does the same as the table-based Math::packHalfInto() used for
+   the remaining values, including rounding toward zero and keeping the top
+   mantissa bits of NaNs, so the output is bit-exact with it. Denormals are
+   calculated by scaling with 2^24 and truncating, which gives the exact same
+   result as the table shifts. */
+std::size_t packHalfSimd(const Containers::ArrayView<const Float> src, const Containers::ArrayView<UnsignedShort> dst) {
+    #if defined(CORRADE_TARGET_SSE2) || defined(CORRADE_TARGET_NEON)
+    const std::size_t simdCount = src.size() - src.size() % 4;
+    #ifdef CORRADE_TARGET_SSE2
+    for(std::size_t i = 0; i != simdCount; i += 4) {
+        const __m128i u = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src.data() + i));
+        const __m128i a = _mm_and_si128(u, _mm_set1_epi32(0x7fffffff));
+        const __m128i sign = _mm_and_si128(_mm_srli_epi32(u, 16), _mm_set1_epi32(0x8000));
+        const __m128i denormal = _mm_cvttps_epi32(_mm_mul_ps(_mm_castsi128_ps(a), _mm_set1_ps(16777216.0f)));
+        const __m128i normal = _mm_sub_epi32(_mm_srli_epi32(a, 13), _mm_set1_epi32(112 << 10));
+        /* Overflow is an infinity, NaNs keep the top ten mantissa bits */
+        const __m128i infinityNan = _mm_or_si128(_mm_set1_epi32(0x7c00), _mm_and_si128(
+            _mm_cmpgt_epi32(a, _mm_set1_epi32(0x7f7fffff)),
+            _mm_and_si128(_mm_srli_epi32(a, 13), _mm_set1_epi32(0x3ff))));
+        /* All operands are below 0x80000000, so signed compares are fine */
+        const __m128i isDenormal = _mm_cmplt_epi32(a, _mm_set1_epi32(113 << 23));
+        const __m128i isNormal = _mm_cmplt_epi32(a, _mm_set1_epi32(143 << 23));
+        __m128i h = _mm_or_si128(_mm_and_si128(isNormal, normal), _mm_andnot_si128(isNormal, infinityNan));
+        h = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, h));
+        h = _mm_or_si128(h, sign);
+        /* No unsigned saturating pack in SSE2, sign-extend the lower half
+           so the signed one keeps the bits intact */
+        h = _mm_srai_epi32(_mm_slli_epi32(h, 16), 16);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst.data() + i), _mm_packs_epi32(h, h));
+    }
+    #else
+    for(std::size_t i = 0; i != simdCount; i += 4) {
+        const uint32x4_t u = vld1q_u32(reinterpret_cast<const UnsignedInt*>(src.data() + i));
+        const uint32x4_t a = vandq_u32(u, vdupq_n_u32(0x7fffffff));
+        const uint32x4_t sign = vandq_u32(vshrq_n_u32(u, 16), vdupq_n_u32(0x8000));
+        const uint32x4_t denormal = vcvtq_u32_f32(vmulq_f32(vreinterpretq_f32_u32(a), vdupq_n_f32(16777216.0f)));
+        const uint32x4_t normal = vsubq_u32(vshrq_n_u32(a, 13), vdupq_n_u32(112 << 10));
+        /* Overflow is an infinity, NaNs keep the top ten mantissa bits */
+        const uint32x4_t infinityNan = vorrq_u32(vdupq_n_u32(0x7c00), vandq_u32(
+            vcgtq_u32(a, vdupq_n_u32(0x7f7fffff)),
+            vandq_u32(vshrq_n_u32(a, 13), vdupq_n_u32(0x3ff))));
+        const uint32x4_t h = vbslq_u32(vcltq_u32(a, vdupq_n_u32(113 << 23)), denormal,
+            vbslq_u32(vcltq_u32(a, vdupq_n_u32(143 << 23)), normal, infinityNan));
+        vst1_u16(dst.data() + i, vmovn_u32(vorrq_u32(h, sign)));
+    }
+    #endif
+    return simdCount;
+    #else
+    static_cast<void>(src);
+    static_cast<void>(dst);
+    return 0;
+    #endif
+}
+
+/* sRGB channels are treated the same as linear ones, no conversion is done */
+PixelFormat linearChannelFormat(const PixelFormat format) {
+    const PixelFormat channelFormat = pixelFormatChannelFormat(format);
+    return channelFormat == PixelFormat::R8Srgb ? PixelFormat::R8Unorm : channelFormat;
+}
+
+template<class T> void writeValue(char* const out, const T value) {
+    std::memcpy(out, &value, sizeof(T));
+}
+
+void writeOne(const PixelFormat channelFormat, char* const out) {
+    switch(channelFormat) {
+        case PixelFormat::R8Unorm:
+            return writeValue<UnsignedByte>(out, 0xff);
+        case PixelFormat::R8Snorm:
+            return writeValue<Byte>(out, 0x7f);
+        case PixelFormat::R8UI:
+        case PixelFormat::R8I:
+            return writeValue<UnsignedByte>(out, 1);
+        case PixelFormat::R16Unorm:
+            return writeValue<UnsignedShort>(out, 0xffff);
+        case PixelFormat::R16Snorm:
+            return writeValue<Short>(out, 0x7fff);
+        case PixelFormat::R16UI:
+        case PixelFormat::R16I:
+            return writeValue<UnsignedShort>(out, 1);
+        case PixelFormat::R16F:
+            /* 1.0 in half-float representation */
+            return writeValue<UnsignedShort>(out, 0x3c00);
+        case PixelFormat::R32UI:
+        case PixelFormat::R32I:
+            return writeValue<UnsignedInt>(out, 1);
+        case PixelFormat::R32F:
+            return writeValue<Float>(out, 1.0f);
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+}
+
+void unpackRow(const PixelFormat channelFormat, const Containers::StridedArrayView2D<const char>& src, const Containers::StridedArrayView2D<Float>& dst) {
+    switch(channelFormat) {
+        case PixelFormat::R8Unorm:
+            return Math::unpackInto(Containers::arrayCast<2, const UnsignedByte>(src), dst);
+        case PixelFormat::R8Snorm:
+            return Math::unpackInto(Containers::arrayCast<2, const Byte>(src), dst);
+        case PixelFormat::R16Unorm:
+            return Math::unpackInto(Containers::arrayCast<2, const UnsignedShort>(src), dst);
+        case PixelFormat::R16Snorm:
+            return Math::unpackInto(Containers::arrayCast<2, const Short>(src), dst);
+        case PixelFormat::R16F:
+            return Math::unpackHalfInto(Containers::arrayCast<2, const UnsignedShort>(src), dst);
+        case PixelFormat::R32F:
+            return Utility::copy(Containers::arrayCast<2, const Float>(src), dst);
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+}
+
+void packRow(const PixelFormat channelFormat, const Containers::StridedArrayView2D<const Float>& src, const Containers::StridedArrayView2D<char>& dst) {
+    switch(channelFormat) {
+        case PixelFormat::R8Unorm:
+            return Math::packInto(src, Containers::arrayCast<2, UnsignedByte>(dst));
+        case PixelFormat::R8Snorm:
+            return Math::packInto(src, Containers::arrayCast<2, Byte>(dst));
+        case PixelFormat::R16Unorm:
+            return Math::packInto(src, Containers::arrayCast<2, UnsignedShort>(dst));
+        case PixelFormat::R16Snorm:
+            return Math::packInto(src, Containers::arrayCast<2, Short>(dst));
+        case PixelFormat::R16F: {
+            const Containers::StridedArrayView2D<UnsignedShort> dstHalf = Containers::arrayCast<2, UnsignedShort>(dst);
+            /* If both are contiguous, which is the case when converting
+               between formats with the same channel count, the bulk goes
+               through the SIMD variant and only the rest through the batch
+               API */
+            if(src.isContiguous() && dstHalf.isContiguous()) {
+                const Containers::ArrayView<const Float> srcContiguous = src.asContiguous();
+                const Containers::ArrayView<UnsignedShort> dstContiguous = dstHalf.asContiguous();
+                const std::size_t offset = packHalfSimd(srcContiguous, dstContiguous);
+                const std::size_t remaining = srcContiguous.size() - offset;
+                return Math::packHalfInto(
+                    Containers::StridedArrayView2D<const Float>{srcContiguous.exceptPrefix(offset), {remaining, 1}},
+                    Containers::StridedArrayView2D<UnsignedShort>{dstContiguous.exceptPrefix(offset), {remaining, 1}});
+            }
+            return Math::packHalfInto(src, dstHalf);
+        }
+        case PixelFormat::R32F:
+            return Utility::copy(src, Containers::arrayCast<2, Float>(dst));
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+}
+
+}
+
+void yFlipImageInPlace(const MutableImageView2D& image, const UnsignedInt threadCount) {
+    const Containers::StridedArrayView3D<char> pixels = image.pixels();
+    const std::size_t height = pixels.size()[0];
+    const std::size_t rowSize = pixels.size()[1]*pixels.size()[2];
+    if(!rowSize) return;
+
+    /* Pixels in a row are always contiguous, so it's enough to swap whole
+       byte ranges */
+    forEachRowRange(height/2, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t y = begin; y != end; ++y) {
+            char* const a = static_cast<char*>(pixels[y].data());
+            char* const b = static_cast<char*>(pixels[height - y - 1].data());
+            std::swap_ranges(a, a + rowSize, b);
+        }
+    });
+}
+
+void yFlipImageInto(const ImageView2D& src, const MutableImageView2D& dst, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "yFlipImageInto(): expected destination size" << Debug::packed << src.size() << "but got" << Debug::packed << dst.size(), );
+    CORRADE_ASSERT(src.pixelSize() == dst.pixelSize(),
+        "yFlipImageInto(): expected destination pixel size" << src.pixelSize() << "but got" << dst.pixelSize(), );
+
+    const Containers::StridedArrayView3D<const char> srcPixels = src.pixels().flipped<0>();
+    const Containers::StridedArrayView3D<char> dstPixels = dst.pixels();
+    forEachRowRange(srcPixels.size()[0], threadCount, [&](const std::size_t begin, const std::size_t end) {
+        Utility::copy(srcPixels.slice(begin, end), dstPixels.slice(begin, end));
+    });
+}
+
+void swizzleBgrImageInPlace(const MutableImageView2D& image, const UnsignedInt threadCount) {
+    const PixelFormat format = image.format();
+    CORRADE_ASSERT(!isPixelFormatImplementationSpecific(format) && !isPixelFormatDepthOrStencil(format),
+        "swizzleBgrImageInPlace(): can't swizzle" << format, );
+    const UnsignedInt channelCount = pixelFormatChannelCount(format);
+    CORRADE_ASSERT(channelCount == 3 || channelCount == 4,
+        "swizzleBgrImageInPlace(): expected a three- or four-channel format, got" << format, );
+
+    void(*swizzle)(const Containers::StridedArrayView3D<char>&, std::size_t, std::size_t);
+    switch(pixelFormatSize(pixelFormatChannelFormat(format))) {
+        case 1:
+            swizzle = channelCount == 3 ? swizzleBgrRows<UnsignedByte, 3> : swizzleBgrRows<UnsignedByte, 4>;
+            break;
+        case 2:
+            swizzle = channelCount == 3 ? swizzleBgrRows<UnsignedShort, 3> : swizzleBgrRows<UnsignedShort, 4>;
+            break;
+        case 4:
+            swizzle = channelCount == 3 ? swizzleBgrRows<UnsignedInt, 3> : swizzleBgrRows<UnsignedInt, 4>;
+            break;
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+
+    const Containers::StridedArrayView3D<char> pixels = image.pixels();
+    forEachRowRange(pixels.size()[0], threadCount, [&](const std::size_t begin, const std::size_t end) {
+        swizzle(pixels, begin, end);
+    });
+}
+
+void convertImageInto(const ImageView2D& src, const MutableImageView2D& dst, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "convertImageInto(): expected destination size" << Debug::packed << src.size() << "but got" << Debug::packed << dst.size(), );
+    const PixelFormat srcFormat = src.format();
+    const PixelFormat dstFormat = dst.format();
+    CORRADE_ASSERT(!isPixelFormatImplementationSpecific(srcFormat) && !isPixelFormatDepthOrStencil(srcFormat) && !isPixelFormatImplementationSpecific(dstFormat) && !isPixelFormatDepthOrStencil(dstFormat),
+        "convertImageInto(): can't convert" << srcFormat << "to" << dstFormat, );
+
+    /* Same channel format means just copying (a subset of) the channels,
+       otherwise it has to go through a float intermediate, which is possible
+       only for normalized and floating-point formats */
+    const PixelFormat srcChannelFormat = linearChannelFormat(srcFormat);
+    const PixelFormat dstChannelFormat = linearChannelFormat(dstFormat);
+    const bool direct = srcChannelFormat == dstChannelFormat;
+    CORRADE_ASSERT(direct || (!isPixelFormatIntegral(srcFormat) && !isPixelFormatIntegral(dstFormat)),
+        "convertImageInto(): can't convert" << srcFormat << "to" << dstFormat, );
+    const bool clamp = isPixelFormatNormalized(dstFormat);
+    const Float clampMin = dstChannelFormat == PixelFormat::R8Snorm || dstChannelFormat == PixelFormat::R16Snorm ? -1.0f : 0.0f;
+
+    const UnsignedInt srcChannelCount = pixelFormatChannelCount(srcFormat);
+    const UnsignedInt dstChannelCount = pixelFormatChannelCount(dstFormat);
+    const std::size_t commonChannelCount = Math::min(srcChannelCount, dstChannelCount);
+    const std::size_t srcCommonSize = commonChannelCount*pixelFormatSize(srcChannelFormat);
+    const std::size_t dstChannelSize = pixelFormatSize(dstChannelFormat);
+    const std::size_t dstCommonSize = commonChannelCount*dstChannelSize;
+    const std::size_t dstExtraSize = dst.pixelSize() - dstCommonSize;
+
+    /* Values for channels not present in the source, zero except for alpha */
+    char fill[16]{};
+    if(dstChannelCount == 4 && srcChannelCount < 4)
+        writeOne(dstChannelFormat, fill + 3*dstChannelSize);
+
+    const Containers::StridedArrayView3D<const char> srcPixels = src.pixels();
+    const Containers::StridedArrayView3D<char> dstPixels = dst.pixels();
+    const std::size_t width = srcPixels.size()[1];
+    forEachRowRange(srcPixels.size()[0], threadCount, [&](const std::size_t begin, const std::size_t end) {
+        const std::size_t rowCount = end - begin;
+
+        /* Copy or convert the channels present in both */
+        if(direct) Utility::copy(
+            srcPixels.slice(begin, end).prefix({rowCount, width, srcCommonSize}),
+            dstPixels.slice(begin, end).prefix({rowCount, width, dstCommonSize}));
+        else {
+            /* A row-sized scratch buffer, allocated for each thread
+               separately */
+            Containers::Array<Float> scratchData{NoInit, width*commonChannelCount};
+            const Containers::StridedArrayView2D<Float> scratch{scratchData, {width, commonChannelCount}};
+            for(std::size_t y = begin; y != end; ++y) {
+                unpackRow(srcChannelFormat, srcPixels[y].prefix({width, srcCommonSize}), scratch);
+                if(clamp) for(Float& i: scratchData)
+                    i = Math::clamp(i, clampMin, 1.0f);
+                packRow(dstChannelFormat, scratch, dstPixels[y].prefix({width, dstCommonSize}));
+            }
+        }
+
+        /* Fill the remaining channels */
+        if(dstExtraSize) Utility::copy(
+            Containers::StridedArrayView3D<const char>{
+                Containers::arrayView(fill).sliceSize(dstCommonSize, dstExtraSize),
+                {rowCount, width, dstExtraSize}, {0, 0, 1}},
+            dstPixels.slice(begin, end).sliceSize({0, 0, dstCommonSize}, {rowCount, width, dstExtraSize}));
+    });
+}
+
+}
@@ -0,0 +1,125 @@
+#ifndef Magnum_ImageConversion_h
+#define Magnum_ImageConversion_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::yFlipImageInPlace(), @ref Magnum::yFlipImageInto(), @ref Magnum::swizzleBgrImageInPlace(), @ref Magnum::convertImageInto()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Y-flip image pixels in-place
+@param image        Image to flip
+@param threadCount  Count of threads to use. If @cpp 0 @ce, uses as many
+    threads as is the hardware concurrency.
+@m_since_latest
+
+Swaps the first row with the last, second with the second-to-last etc.,
+respecting @ref PixelStorage properties of the image. Pixel format isn't
+taken into account in any way, the operation only works with the pixel size.
+On @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" the operation is always done
+on a single thread.
+@see @ref yFlipImageInto(), @ref Math::yFlipBc1InPlace()
+*/
+MAGNUM_EXPORT void yFlipImageInPlace(const MutableImageView2D& image, UnsignedInt threadCount = 1);
+
+/**
+@brief Y-flip image pixels into another image
+@param src          Source image
+@param dst          Destination image
+@param threadCount  Count of threads to use. If @cpp 0 @ce, uses as many
+    threads as is the hardware concurrency.
+@m_since_latest
+
+Copies the first row of @p src to the last row of @p dst, second to the
+second-to-last etc. Expects that both images have the same size and pixel
+size, the @ref PixelStorage properties can be different for each. The images
+are expected to not overlap, use @ref yFlipImageInPlace() for an in-place
+operation.
+*/
+MAGNUM_EXPORT void yFlipImageInto(const ImageView2D& src, const MutableImageView2D& dst, UnsignedInt threadCount = 1);
+
+/**
+@brief Swizzle BGR(A) image pixels to RGB(A) or vice versa in-place
+@param image        Image to swizzle
+@param threadCount  Count of threads to use. If @cpp 0 @ce, uses as many
+    threads as is the hardware concurrency.
+@m_since_latest
+
+Swaps the first and third channel of each pixel. Expects that the image is
+in a three- or four-channel format that's not implementation-specific and not
+a depth/stencil format. Useful for example when importing from or exporting to
+file formats that store pixels in the BGR(A) order, or when reading
+framebuffers with @ref GL::PixelFormat::BGRA. Four-channel formats with 8-bit
+channels are processed with SSE2 or NEON if enabled at compile time.
+*/
+MAGNUM_EXPORT void swizzleBgrImageInPlace(const MutableImageView2D& image, UnsignedInt threadCount = 1);
+
+/**
+@brief Convert image pixels to a different format
+@param src          Source image
+@param dst          Destination image
+@param threadCount  Count of threads to use. If @cpp 0 @ce, uses as many
+    threads as is the hardware concurrency.
+@m_since_latest
+
+Expects that both images have the same size, that neither of the formats is
+implementation-specific or a depth/stencil format and that the conversion is
+one of the following:
+
+-   Same channel type, different channel count. If @p dst has less channels,
+    the extra source channels are dropped, if it has more, the extra color
+    channels are filled with zeros and the alpha channel with
+    @cpp 1.0f @ce or the max representable value for normalized formats,
+    @cpp 1 @ce for integral formats. Channels with the same type but one being
+    sRGB and the other not are treated as the same type, i.e. no sRGB
+    conversion is done.
+-   Conversion between normalized and floating-point channel types, such as
+    @ref PixelFormat::RGBA32F to @ref PixelFormat::RGBA16F or
+    @ref PixelFormat::RGB8Unorm to @ref PixelFormat::RGBA32F, optionally
+    combined with the channel count change described above. Floating-point
+    values outside of the range representable by a normalized destination
+    format are clamped. The conversion is done with
+    @ref Math::unpackInto(), @ref Math::packInto(), @ref Math::packHalfInto()
+    and @ref Math::unpackHalfInto(). Conversion to a half-float format with
+    the same channel count as the source is done with SSE2 or NEON if
+    enabled at compile time, with the result bit-exact with
+    @ref Math::packHalfInto().
+
+The @ref PixelStorage properties can be different for each image. The images
+are expected to not overlap. See also @ref yFlipImageInto() and
+@ref swizzleBgrImageInPlace() for other common operations.
+*/
+MAGNUM_EXPORT void convertImageInto(const ImageView2D& src, const MutableImageView2D& dst, UnsignedInt threadCount = 1);
+
+}
+
+#endif
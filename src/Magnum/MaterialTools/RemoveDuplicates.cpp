@@ -25,10 +25,15 @@
 
 #include "RemoveDuplicates.h"
 
+#include <cstring>
+#include <unordered_map>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Iterable.h>
 #include <Corrade/Containers/Pair.h>
 #include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/MurmurHash2.h>
 
+#include "Magnum/Math/Functions.h"
 #include "Magnum/MaterialTools/Implementation/attributesEqual.h"
 #include "Magnum/Trade/MaterialData.h"
 
@@ -74,35 +79,221 @@ bool materialEqual(const Trade::MaterialData& a, const Trade::MaterialData& b) {
     return true;
 }
 
+/* Floating-point attribute values are compared with Math::TypeTraits::equals()
+   which uses an absolute epsilon for values below 1 and a relative epsilon
+   above. To be able to hash them, the values are discretized into cells of an
+   absolute size of 1/16 below 1 and to cells with four mantissa bits above,
+   with cell centers on common values such as 0, 0.5, 1 or 2. Two values that
+   compare equal either land in the same cell or they're both closer to the
+   cell boundary than the margins below, in which case they're marked as
+   ambiguous and the neighboring cell is remembered as an alternative. The
+   margins are a few times larger than the actual comparison epsilon to be on
+   the safe side. */
+constexpr Float AbsoluteCellMargin = 64.0f*Math::TypeTraits<Float>::epsilon();
+constexpr UnsignedInt RelativeCellBits = 19;
+constexpr UnsignedInt RelativeCellMargin = 1024;
+
+/* Cell of a value of at least 1. The result is always less than 2^13 with the
+   sign in the highest bit, absolute cells have bit 31 set to not conflict
+   with these. */
+UnsignedInt relativeCell(const Float value, UnsignedInt& alternative) {
+    const Float absValue = Math::abs(value);
+    UnsignedInt bits;
+    std::memcpy(&bits, &absValue, sizeof(UnsignedInt));
+    const UnsignedInt sign = value < 0.0f ? 1 << (32 - RelativeCellBits) : 0;
+    const UnsignedInt cell = ((bits + (1 << (RelativeCellBits - 1))) >> RelativeCellBits)|sign;
+
+    /* Distance from the cell boundary, which is in the middle of the
+       discarded mantissa bits */
+    const Int distance = Int(bits & ((1 << RelativeCellBits) - 1)) - (1 << (RelativeCellBits - 1));
+    if(distance >= 0 && distance < Int(RelativeCellMargin))
+        alternative = cell - 1;
+    else if(distance < 0 && distance > -Int(RelativeCellMargin))
+        alternative = cell + 1;
+    else
+        alternative = cell;
+    return cell;
+}
+
+UnsignedInt absoluteCell(const Int cell) {
+    /* Cells at ±1 are shared with the relative ones */
+    if(cell == 16 || cell == -16) {
+        UnsignedInt unused;
+        return relativeCell(cell > 0 ? 1.0f : -1.0f, unused);
+    }
+    return 0x80000000u|UnsignedInt(cell + 16);
+}
+
+UnsignedInt discretize(const Float value, UnsignedInt& alternative) {
+    if(!(Math::abs(value) < 1.0f))
+        return relativeCell(value, alternative);
+
+    const Float scaled = value*16.0f;
+    const Float rounded = Math::round(scaled);
+    const Int cell = Int(rounded);
+    const Float distance = scaled - rounded;
+    if(distance > 0.5f - AbsoluteCellMargin)
+        alternative = absoluteCell(cell + 1);
+    else if(distance < -0.5f + AbsoluteCellMargin)
+        alternative = absoluteCell(cell - 1);
+    else
+        alternative = absoluteCell(cell);
+    return absoluteCell(cell);
+}
+
+template<class T> void appendKey(Containers::Array<char>& key, const T& value) {
+    arrayAppend(key, Containers::arrayView(reinterpret_cast<const char*>(&value), sizeof(T)));
+}
+
+/* Puts a hashable representation of the material into key. Offsets of
+   ambiguous floating-point values together with their alternative
+   representation are put into ambiguous. */
+void materialKey(const Trade::MaterialData& material, Containers::Array<char>& key, Containers::Array<Containers::Pair<std::size_t, UnsignedInt>>& ambiguous) {
+    arrayResize(key, 0);
+    arrayResize(ambiguous, 0);
+
+    /* An implicit base layer and a single explicit layer are equivalent,
+       so hashing the per-layer attribute counts instead of the layer data */
+    appendKey(key, UnsignedInt(material.types()));
+    appendKey(key, material.layerCount());
+    for(UnsignedInt layer = 0; layer != material.layerCount(); ++layer)
+        appendKey(key, material.attributeCount(layer));
+
+    for(const Trade::MaterialAttributeData& attribute: material.attributeData()) {
+        const Containers::StringView name = attribute.name();
+        appendKey(key, name.size());
+        arrayAppend(key, Containers::arrayView(name.data(), name.size()));
+        const Trade::MaterialAttributeType type = attribute.type();
+        appendKey(key, type);
+
+        switch(type) {
+            /* Floating-point types get discretized */
+            case Trade::MaterialAttributeType::Float:
+            case Trade::MaterialAttributeType::Deg:
+            case Trade::MaterialAttributeType::Rad:
+            case Trade::MaterialAttributeType::Vector2:
+            case Trade::MaterialAttributeType::Vector3:
+            case Trade::MaterialAttributeType::Vector4:
+            case Trade::MaterialAttributeType::Matrix2x2:
+            case Trade::MaterialAttributeType::Matrix2x3:
+            case Trade::MaterialAttributeType::Matrix2x4:
+            case Trade::MaterialAttributeType::Matrix3x2:
+            case Trade::MaterialAttributeType::Matrix3x3:
+            case Trade::MaterialAttributeType::Matrix3x4:
+            case Trade::MaterialAttributeType::Matrix4x2:
+            case Trade::MaterialAttributeType::Matrix4x3: {
+                const Containers::ArrayView<const Float> values{static_cast<const Float*>(attribute.value()), Trade::materialAttributeTypeSize(type)/sizeof(Float)};
+                for(const Float value: values) {
+                    UnsignedInt alternative;
+                    const UnsignedInt cell = discretize(value, alternative);
+                    if(alternative != cell)
+                        arrayAppend(ambiguous, InPlaceInit, key.size(), alternative);
+                    appendKey(key, cell);
+                }
+            } break;
+
+            /* Strings and buffers have a variable size */
+            case Trade::MaterialAttributeType::String: {
+                const Containers::StringView value = attribute.value<Containers::StringView>();
+                appendKey(key, value.size());
+                arrayAppend(key, Containers::arrayView(value.data(), value.size()));
+            } break;
+            case Trade::MaterialAttributeType::Buffer: {
+                const Containers::ArrayView<const char> value = Containers::arrayCast<const char>(attribute.value<Containers::ArrayView<const void>>());
+                appendKey(key, value.size());
+                arrayAppend(key, value);
+            } break;
+
+            /* Everything else is compared exactly */
+            default:
+                arrayAppend(key, Containers::arrayView(static_cast<const char*>(attribute.value()), Trade::materialAttributeTypeSize(type)));
+        }
+    }
+}
+
+std::size_t hashKey(const Containers::ArrayView<const char> key) {
+    return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2{}(key.data(), key.size()).byteArray());
+}
+
+/* If there's more ambiguous values than this, falling back to comparing with
+   all unique materials instead of trying all 2^n key combinations. Each value
+   is ambiguous with a probability of roughly 0.5%, so this should happen
+   only very rarely. */
+constexpr std::size_t MaxAmbiguousValues = 6;
+
+/* Table mapping a key hash to indices of unique materials. Matching the
+   original pairwise implementation, the lowest index of all materials that
+   compare equal is returned, ~UnsignedInt{} if there's none. The unique
+   materials are accessed through the getter. */
+template<class Getter> UnsignedInt findUnique(const std::unordered_multimap<std::size_t, UnsignedInt>& table, const Containers::ArrayView<const UnsignedInt> uniques, const Trade::MaterialData& material, Containers::Array<char>& key, const Containers::ArrayView<const Containers::Pair<std::size_t, UnsignedInt>> ambiguous, const Getter& unique) {
+    /* Too many ambiguous values, compare with all unique materials. Those
+       are ordered so the first found is also the lowest index. */
+    if(ambiguous.size() > MaxAmbiguousValues) {
+        for(const UnsignedInt i: uniques)
+            if(materialEqual(material, unique(i))) return i;
+        return ~UnsignedInt{};
+    }
+
+    /* Otherwise try all combinations of the ambiguous values. In the common
+       case there's none, leading to just a single lookup. */
+    UnsignedInt found = ~UnsignedInt{};
+    for(std::size_t combination = 0; combination != std::size_t{1} << ambiguous.size(); ++combination) {
+        /* Patch the alternatives in. The original values are restored after,
+           the key is reused for insertion afterwards. */
+        UnsignedInt original[MaxAmbiguousValues];
+        for(std::size_t i = 0; i != ambiguous.size(); ++i) {
+            if(!(combination & (std::size_t{1} << i))) continue;
+            std::memcpy(original + i, key + ambiguous[i].first(), sizeof(UnsignedInt));
+            std::memcpy(key + ambiguous[i].first(), &ambiguous[i].second(), sizeof(UnsignedInt));
+        }
+
+        const auto range = table.equal_range(hashKey(key));
+        for(auto it = range.first; it != range.second; ++it)
+            if(it->second < found && materialEqual(material, unique(it->second)))
+                found = it->second;
+
+        for(std::size_t i = 0; i != ambiguous.size(); ++i) {
+            if(!(combination & (std::size_t{1} << i))) continue;
+            std::memcpy(key + ambiguous[i].first(), original + i, sizeof(UnsignedInt));
+        }
+    }
+
+    return found;
+}
+
 }
 
 std::size_t removeDuplicatesInPlaceInto(const Containers::Iterable<Trade::MaterialData>& materials, const Containers::StridedArrayView1D<UnsignedInt>& mapping) {
     CORRADE_ASSERT(mapping.size() == materials.size(),
         "MaterialTools::removeDuplicatesInPlaceInto(): bad output size, expected" << materials.size() << "but got" << mapping.size(), {});
 
-    /* O(n^2). As there's a lot of early returns, should be fine for a moderate
-       count of materials that differ in a significant way. Won't work well for
-       materials that are all the same except one attribute value. */
+    /* Expected O(n). Each material is hashed, including discretized
+       floating-point values, and compared only against unique materials with
+       the same hash. */
+    std::unordered_multimap<std::size_t, UnsignedInt> table;
+    table.reserve(materials.size());
+    Containers::Array<UnsignedInt> uniques;
+    Containers::Array<char> key;
+    Containers::Array<Containers::Pair<std::size_t, UnsignedInt>> ambiguous;
     std::size_t uniqueCount = 0;
     for(std::size_t i = 0; i != materials.size(); ++i) {
         /* Find a material that's already in the unique set */
-        Containers::Optional<UnsignedInt> found;
-        for(std::size_t j = 0; j != uniqueCount; ++j) {
-            if(materialEqual(materials[i], materials[j])) {
-                found = j;
-                break;
-            }
-        }
+        materialKey(materials[i], key, ambiguous);
+        const UnsignedInt found = findUnique(table, uniques, materials[i], key, ambiguous, [&materials](UnsignedInt j) -> const Trade::MaterialData& {
+            return materials[j];
+        });
 
         /* Material found, reference its ID */
-        if(found) {
-            mapping[i] = *found;
+        if(found != ~UnsignedInt{}) {
+            mapping[i] = found;
 
         /* Move the material into its new location, unless it's the same
            index, and increase the number of unique materials */
         } else {
             if(uniqueCount != i)
                 materials[uniqueCount] = Utility::move(materials[i]);
+            table.emplace(hashKey(key), uniqueCount);
+            arrayAppend(uniques, UnsignedInt(uniqueCount));
             mapping[i] = uniqueCount++;
         }
     }
@@ -120,34 +311,32 @@ std::size_t removeDuplicatesInto(const Containers::Iterable<const Trade::Materia
     CORRADE_ASSERT(mapping.size() == materials.size(),
         "MaterialTools::removeDuplicatesInto(): bad output size, expected" << materials.size() << "but got" << mapping.size(), {});
 
-    /* O(n^2). Like removeDuplicatesInPlaceInto(), but as the input material
-       list is immutable, it has to go through the already-processed prefix
-       and compare only against materials that are unique, which may add some
-       extra overhead. Another option would be to allocate a temporary array
-       with (contiguous) references to the material data, but so far I think
-       the prefix iteration is efficient enough to not need that. */
+    /* Expected O(n), like removeDuplicatesInPlaceInto(), but as the input
+       material list is immutable, the table references the original
+       indices */
+    std::unordered_multimap<std::size_t, UnsignedInt> table;
+    table.reserve(materials.size());
+    Containers::Array<UnsignedInt> uniques;
+    Containers::Array<char> key;
+    Containers::Array<Containers::Pair<std::size_t, UnsignedInt>> ambiguous;
     std::size_t uniqueCount = 0;
     for(std::size_t i = 0; i != materials.size(); ++i) {
-        /* Find a material that's already in the unique set by going through
-           the already-processed prefix and comparing only against materials
-           that are unique, i.e. for which the output index is the same as the
-           input index. */
-        Containers::Optional<UnsignedInt> found;
-        for(std::size_t j = 0; j != i; ++j) {
-            if(mapping[j] == j && materialEqual(materials[i], materials[j])) {
-                found = j;
-                break;
-            }
-        }
+        /* Find a material that's already in the unique set */
+        materialKey(materials[i], key, ambiguous);
+        const UnsignedInt found = findUnique(table, uniques, materials[i], key, ambiguous, [&materials](UnsignedInt j) -> const Trade::MaterialData& {
+            return materials[j];
+        });
 
         /* Material found, reference its ID */
-        if(found) {
-            mapping[i] = *found;
+        if(found != ~UnsignedInt{}) {
+            mapping[i] = found;
 
         /* Otherwise the output index the same as the input index. Also
            increase the number of unique materials which isn't used for
            anything here except the return value. */
         } else {
+            table.emplace(hashKey(key), i);
+            arrayAppend(uniques, UnsignedInt(i));
             mapping[i] = i;
             uniqueCount++;
         }
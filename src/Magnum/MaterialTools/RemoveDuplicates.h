@@ -55,12 +55,16 @@ output. See @ref removeDuplicates() for a variant that doesn't modify the input
 list in any way but instead returns a mapping array pointing to original data
 locations.
 
-The operation is done in an @f$ \mathcal{O}(n^2 m) @f$ complexity with
-@f$ n @f$ being the material list size and @f$ m @f$ the per-material attribute
-count --- every material in the list is compared to all unique materials
-collected so far. As attributes are sorted in @ref Trade::MaterialData,
-material comparison is just a linear operation. The function doesn't allocate
-any temporary memory.
+The operation is done in an expected @f$ \mathcal{O}(n m) @f$ complexity
+with @f$ n @f$ being the material list size and @f$ m @f$ the per-material
+attribute count --- every material is hashed, with floating-point values
+discretized to cells larger than the comparison epsilon, and compared only to
+unique materials with the same hash. Values that are too close to a cell
+boundary are looked up in the neighboring cell as well, so the result is the
+same as when comparing every material to all unique materials collected so
+far. As attributes are sorted in @ref Trade::MaterialData, material comparison
+is just a linear operation. The function allocates a temporary hash table and
+a per-material key.
 
 The output index array can be passed to @ref SceneTools::mapIndexField() to
 update a @ref Trade::SceneField::MeshMaterial field to reference only the
@@ -102,13 +106,10 @@ only unique materials in the input array. See @ref removeDuplicatesInPlace()
 for a variant that also shifts the unique materials to the front of the list
 and for a practical usage example.
 
-The operation is done in an @f$ \mathcal{O}(n^2 m) @f$ complexity with
-@f$ n @f$ being the material list size and @f$ m @f$ the per-material attribute
-count --- every material in the list is compared to all unique materials
-collected so far, by iterating the filled prefix of the output index list and
-considering only index for which the index value is the same as the index. As
-attributes are sorted in @ref Trade::MaterialData, material comparison is just
-a linear operation. The function doesn't allocate any temporary memory.
+The operation is done in an expected @f$ \mathcal{O}(n m) @f$ complexity
+with @f$ n @f$ being the material list size and @f$ m @f$ the per-material
+attribute count, see @ref removeDuplicatesInPlace() for details about the
+hashing. The function allocates a temporary hash table and a per-material key.
 @see @ref removeDuplicatesInto()
 */
 MAGNUM_MATERIALTOOLS_EXPORT Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicates(const Containers::Iterable<const Trade::MaterialData>& materials);
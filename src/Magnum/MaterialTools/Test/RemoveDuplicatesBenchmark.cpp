@@ -0,0 +1,154 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Iterable.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/MaterialTools/RemoveDuplicates.h"
+#include "Magnum/MaterialTools/Implementation/attributesEqual.h"
+#include "Magnum/Trade/MaterialData.h"
+
+namespace Magnum { namespace MaterialTools { namespace Test { namespace {
+
+struct RemoveDuplicatesBenchmark: TestSuite::Tester {
+    explicit RemoveDuplicatesBenchmark();
+
+    void fewUniqueBaseline();
+    void fewUnique();
+    void allUniqueBaseline();
+    void allUnique();
+};
+
+enum: std::size_t { MaterialCount = 2000 };
+
+RemoveDuplicatesBenchmark::RemoveDuplicatesBenchmark() {
+    addBenchmarks({&RemoveDuplicatesBenchmark::fewUniqueBaseline,
+                   &RemoveDuplicatesBenchmark::fewUnique,
+                   &RemoveDuplicatesBenchmark::allUniqueBaseline,
+                   &RemoveDuplicatesBenchmark::allUnique}, 5);
+}
+
+/* Materials that differ only in the base color, as is common with scenes
+   exported from DCC tools */
+Containers::Array<Trade::MaterialData> materials(const std::size_t uniqueCount) {
+    Containers::Array<Trade::MaterialData> out;
+    arrayReserve(out, MaterialCount);
+    for(std::size_t i = 0; i != MaterialCount; ++i) {
+        arrayAppend(out, Trade::MaterialData{Trade::MaterialType::PbrMetallicRoughness, {
+            {Trade::MaterialAttribute::BaseColor, Color4{Float(i % uniqueCount)/MaterialCount, 0.5f, 0.25f, 1.0f}},
+            {Trade::MaterialAttribute::BaseColorTexture, 3u},
+            {Trade::MaterialAttribute::Metalness, 0.0f},
+            {Trade::MaterialAttribute::Roughness, 0.75f},
+            {Trade::MaterialAttribute::NormalTexture, 4u},
+            {Trade::MaterialAttribute::DoubleSided, true},
+            {"name", "A material"},
+        }});
+    }
+    return out;
+}
+
+/* The original pairwise implementation */
+bool materialEqualBaseline(const Trade::MaterialData& a, const Trade::MaterialData& b) {
+    if(a.types() != b.types() || a.layerCount() != b.layerCount() || a.attributeData().size() != b.attributeData().size())
+        return false;
+    for(UnsignedInt layer = 0; layer != a.layerCount(); ++layer)
+        if(a.attributeCount(layer) != b.attributeCount(layer)) return false;
+    for(UnsignedInt attribute = 0; attribute != a.attributeData().size(); ++attribute) {
+        if(a.attributeData()[attribute].name() != b.attributeData()[attribute].name() ||
+           a.attributeData()[attribute].type() != b.attributeData()[attribute].type() ||
+          !Implementation::attributesEqual(a.attributeData()[attribute], b.attributeData()[attribute]))
+            return false;
+    }
+    return true;
+}
+
+std::size_t removeDuplicatesBaseline(const Containers::ArrayView<const Trade::MaterialData> materials, const Containers::ArrayView<UnsignedInt> mapping) {
+    std::size_t uniqueCount = 0;
+    for(std::size_t i = 0; i != materials.size(); ++i) {
+        mapping[i] = i;
+        for(std::size_t j = 0; j != i; ++j) {
+            if(mapping[j] == j && materialEqualBaseline(materials[i], materials[j])) {
+                mapping[i] = j;
+                break;
+            }
+        }
+        if(mapping[i] == i) ++uniqueCount;
+    }
+    return uniqueCount;
+}
+
+void RemoveDuplicatesBenchmark::fewUniqueBaseline() {
+    Containers::Array<Trade::MaterialData> data = materials(50);
+    Containers::Array<UnsignedInt> mapping{NoInit, MaterialCount};
+
+    std::size_t count{};
+    CORRADE_BENCHMARK(1) {
+        count = removeDuplicatesBaseline(data, mapping);
+    }
+
+    CORRADE_COMPARE(count, 50);
+}
+
+void RemoveDuplicatesBenchmark::fewUnique() {
+    Containers::Array<Trade::MaterialData> data = materials(50);
+    Containers::Array<UnsignedInt> mapping{NoInit, MaterialCount};
+
+    std::size_t count{};
+    CORRADE_BENCHMARK(1) {
+        count = removeDuplicatesInto(data, mapping);
+    }
+
+    CORRADE_COMPARE(count, 50);
+}
+
+void RemoveDuplicatesBenchmark::allUniqueBaseline() {
+    Containers::Array<Trade::MaterialData> data = materials(MaterialCount);
+    Containers::Array<UnsignedInt> mapping{NoInit, MaterialCount};
+
+    std::size_t count{};
+    CORRADE_BENCHMARK(1) {
+        count = removeDuplicatesBaseline(data, mapping);
+    }
+
+    CORRADE_COMPARE(count, MaterialCount);
+}
+
+void RemoveDuplicatesBenchmark::allUnique() {
+    Containers::Array<Trade::MaterialData> data = materials(MaterialCount);
+    Containers::Array<UnsignedInt> mapping{NoInit, MaterialCount};
+
+    std::size_t count{};
+    CORRADE_BENCHMARK(1) {
+        count = removeDuplicatesInto(data, mapping);
+    }
+
+    CORRADE_COMPARE(count, MaterialCount);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MaterialTools::Test::RemoveDuplicatesBenchmark)
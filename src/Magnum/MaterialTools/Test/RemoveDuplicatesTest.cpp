@@ -121,6 +121,30 @@ const struct {
             Matrix3::translation({5.0f, 9.0f + Math::TypeTraits<Float>::epsilon()*5.0f})},
         {Trade::MaterialAttribute::TextureMatrix,
             Matrix3::translation({5.0f, 9.0f + Math::TypeTraits<Float>::epsilon()*20.0f})}},
+    /* The values are discretized for hashing, cells below 1 have an absolute
+       size of 1/16, cells above have four mantissa bits. Values that are
+       fuzzy-equal but on a different side of a cell boundary should still be
+       treated as the same. */
+    {"scalar around an absolute cell boundary",
+        {Trade::MaterialAttribute::Roughness, 0.96875f - Math::TypeTraits<Float>::epsilon()*0.25f},
+        {Trade::MaterialAttribute::Roughness, 0.96875f + Math::TypeTraits<Float>::epsilon()*0.25f},
+        {Trade::MaterialAttribute::Roughness, 0.96875f + Math::TypeTraits<Float>::epsilon()*3.0f}},
+    {"scalar around a relative cell boundary",
+        {Trade::MaterialAttribute::Roughness, 1.03125f - Math::TypeTraits<Float>::epsilon()*0.25f},
+        {Trade::MaterialAttribute::Roughness, 1.03125f + Math::TypeTraits<Float>::epsilon()*0.25f},
+        {Trade::MaterialAttribute::Roughness, 1.03125f + Math::TypeTraits<Float>::epsilon()*4.0f}},
+    {"scalar around the absolute and relative cell boundary",
+        {Trade::MaterialAttribute::Roughness, 1.0f - Math::TypeTraits<Float>::epsilon()*0.25f},
+        {Trade::MaterialAttribute::Roughness, 1.0f + Math::TypeTraits<Float>::epsilon()*0.25f},
+        {Trade::MaterialAttribute::Roughness, 1.0f + Math::TypeTraits<Float>::epsilon()*4.0f}},
+    /* Too many values close to a cell boundary to try all neighbor cells */
+    {"matrix around cell boundaries",
+        {Trade::MaterialAttribute::TextureMatrix,
+            Matrix3{Vector3{0.96875f - Math::TypeTraits<Float>::epsilon()*0.25f}, Vector3{0.96875f - Math::TypeTraits<Float>::epsilon()*0.25f}, Vector3{0.96875f - Math::TypeTraits<Float>::epsilon()*0.25f}}},
+        {Trade::MaterialAttribute::TextureMatrix,
+            Matrix3{Vector3{0.96875f + Math::TypeTraits<Float>::epsilon()*0.25f}, Vector3{0.96875f + Math::TypeTraits<Float>::epsilon()*0.25f}, Vector3{0.96875f + Math::TypeTraits<Float>::epsilon()*0.25f}}},
+        {Trade::MaterialAttribute::TextureMatrix,
+            Matrix3{Vector3{0.96875f + Math::TypeTraits<Float>::epsilon()*0.25f}, Vector3{0.96875f + Math::TypeTraits<Float>::epsilon()*3.0f}, Vector3{0.96875f + Math::TypeTraits<Float>::epsilon()*0.25f}}}},
 };
 
 RemoveDuplicatesTest::RemoveDuplicatesTest() {
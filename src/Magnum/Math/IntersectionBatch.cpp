@@ -0,0 +1,268 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "IntersectionBatch.h"
+
+#include <Corrade/Containers/BitArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Range.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <xmmintrin.h>
+#elif defined(CORRADE_TARGET_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace Math { namespace Intersection {
+
+namespace {
+
+/* Frustum planes transposed to a structure-of-arrays form, so each plane
+   component can be broadcast and tested against several bounding volumes at
+   once. The absolute values of the normals are used by the box tests. */
+struct FrustumSoA {
+    explicit FrustumSoA(const Frustum<Float>& frustum) {
+        for(std::size_t i = 0; i != 6; ++i) {
+            const Vector4<Float>& plane = frustum[i];
+            x[i] = plane.x();
+            y[i] = plane.y();
+            z[i] = plane.z();
+            w[i] = plane.w();
+            absX[i] = plane.x() < 0.0f ? -plane.x() : plane.x();
+            absY[i] = plane.y() < 0.0f ? -plane.y() : plane.y();
+            absZ[i] = plane.z() < 0.0f ? -plane.z() : plane.z();
+        }
+    }
+
+    Float x[6], y[6], z[6], w[6];
+    Float absX[6], absY[6], absZ[6];
+};
+
+/* Four bounding volumes at a time. The inputs are strided, so they're first
+   gathered into small contiguous arrays that are then loaded as vectors. */
+constexpr std::size_t BatchSize = 4;
+
+/* Sets bits for the batch starting at offset based on a mask of volumes that
+   are outside of the frustum. The view is reset upfront, so only the visible
+   bits are set here. */
+inline void setVisibleBits(const Containers::MutableBitArrayView& visible, const std::size_t offset, const unsigned outsideMask) {
+    for(std::size_t j = 0; j != BatchSize; ++j)
+        if(!(outsideMask & (1 << j))) visible.set(offset + j);
+}
+
+#ifdef CORRADE_TARGET_SSE2
+/* Computes ((nx*x + ny*y) + nz*z), in the same order as Math::dot() to give
+   bit-exact results compared to the scalar variants */
+inline __m128 dot3(const Float nx, const Float ny, const Float nz, const __m128 x, const __m128 y, const __m128 z) {
+    return _mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(_mm_set1_ps(nx), x),
+        _mm_mul_ps(_mm_set1_ps(ny), y)),
+        _mm_mul_ps(_mm_set1_ps(nz), z));
+}
+#elif defined(CORRADE_TARGET_NEON)
+inline float32x4_t dot3(const Float nx, const Float ny, const Float nz, const float32x4_t x, const float32x4_t y, const float32x4_t z) {
+    /* Not using vmlaq_f32() as it may get fused, which would make the results
+       differ from the scalar variants */
+    return vaddq_f32(vaddq_f32(
+        vmulq_f32(vdupq_n_f32(nx), x),
+        vmulq_f32(vdupq_n_f32(ny), y)),
+        vmulq_f32(vdupq_n_f32(nz), z));
+}
+#endif
+
+}
+
+void sphereFrustumInto(const Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Containers::StridedArrayView1D<const Float>& radii, const Frustum<Float>& frustum, const Containers::MutableBitArrayView visible) {
+    CORRADE_ASSERT(radii.size() == centers.size(),
+        "Math::Intersection::sphereFrustumInto(): expected radii to have" << centers.size() << "items but got" << radii.size(), );
+    CORRADE_ASSERT(visible.size() == centers.size(),
+        "Math::Intersection::sphereFrustumInto(): expected output to have" << centers.size() << "bits but got" << visible.size(), );
+
+    const FrustumSoA planes{frustum};
+    visible.resetAll();
+
+    std::size_t i = 0;
+    #if defined(CORRADE_TARGET_SSE2) || defined(CORRADE_TARGET_NEON)
+    for(const std::size_t max = centers.size() - centers.size() % BatchSize; i != max; i += BatchSize) {
+        Float x[BatchSize], y[BatchSize], z[BatchSize], negativeRadiusSq[BatchSize];
+        for(std::size_t j = 0; j != BatchSize; ++j) {
+            const Vector3<Float>& center = centers[i + j];
+            const Float radius = radii[i + j];
+            x[j] = center.x();
+            y[j] = center.y();
+            z[j] = center.z();
+            negativeRadiusSq[j] = -(radius*radius);
+        }
+
+        #ifdef CORRADE_TARGET_SSE2
+        const __m128 vx = _mm_loadu_ps(x);
+        const __m128 vy = _mm_loadu_ps(y);
+        const __m128 vz = _mm_loadu_ps(z);
+        const __m128 vr = _mm_loadu_ps(negativeRadiusSq);
+        __m128 outside = _mm_setzero_ps();
+        for(std::size_t p = 0; p != 6; ++p) {
+            const __m128 d = _mm_add_ps(dot3(planes.x[p], planes.y[p], planes.z[p], vx, vy, vz), _mm_set1_ps(planes.w[p]));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(d, vr));
+        }
+        setVisibleBits(visible, i, _mm_movemask_ps(outside));
+        #else
+        const float32x4_t vx = vld1q_f32(x);
+        const float32x4_t vy = vld1q_f32(y);
+        const float32x4_t vz = vld1q_f32(z);
+        const float32x4_t vr = vld1q_f32(negativeRadiusSq);
+        uint32x4_t outside = vdupq_n_u32(0);
+        for(std::size_t p = 0; p != 6; ++p) {
+            const float32x4_t d = vaddq_f32(dot3(planes.x[p], planes.y[p], planes.z[p], vx, vy, vz), vdupq_n_f32(planes.w[p]));
+            outside = vorrq_u32(outside, vcltq_f32(d, vr));
+        }
+        setVisibleBits(visible, i,
+            (vgetq_lane_u32(outside, 0) & 1)|
+            (vgetq_lane_u32(outside, 1) & 2)|
+            (vgetq_lane_u32(outside, 2) & 4)|
+            (vgetq_lane_u32(outside, 3) & 8));
+        #endif
+    }
+    #endif
+
+    /* Remaining items, or everything if there's no SIMD available. Branchless
+       over the planes so the compiler has a chance to vectorize at least
+       that. */
+    for(const std::size_t max = centers.size(); i != max; ++i) {
+        const Vector3<Float>& center = centers[i];
+        const Float negativeRadiusSq = -(radii[i]*radii[i]);
+        bool outside = false;
+        for(std::size_t p = 0; p != 6; ++p)
+            outside |= planes.x[p]*center.x() + planes.y[p]*center.y() + planes.z[p]*center.z() + planes.w[p] < negativeRadiusSq;
+        if(!outside) visible.set(i);
+    }
+}
+
+namespace {
+
+/* Shared between aabbFrustumInto() and rangeFrustumInto(). Range centers and
+   extents are passed doubled and compared against a doubled plane distance
+   in order to avoid a division, consistently with rangeFrustum(). */
+template<class Gather> void boxFrustumInto(const std::size_t size, Gather gather, const Float planeDistanceScale, const Frustum<Float>& frustum, const Containers::MutableBitArrayView& visible) {
+    FrustumSoA planes{frustum};
+    for(Float& w: planes.w) w = -planeDistanceScale*w;
+    visible.resetAll();
+
+    std::size_t i = 0;
+    #if defined(CORRADE_TARGET_SSE2) || defined(CORRADE_TARGET_NEON)
+    for(const std::size_t max = size - size % BatchSize; i != max; i += BatchSize) {
+        Float cx[BatchSize], cy[BatchSize], cz[BatchSize];
+        Float ex[BatchSize], ey[BatchSize], ez[BatchSize];
+        for(std::size_t j = 0; j != BatchSize; ++j) {
+            Vector3<Float> center, extent;
+            gather(i + j, center, extent);
+            cx[j] = center.x();
+            cy[j] = center.y();
+            cz[j] = center.z();
+            ex[j] = extent.x();
+            ey[j] = extent.y();
+            ez[j] = extent.z();
+        }
+
+        #ifdef CORRADE_TARGET_SSE2
+        const __m128 vcx = _mm_loadu_ps(cx);
+        const __m128 vcy = _mm_loadu_ps(cy);
+        const __m128 vcz = _mm_loadu_ps(cz);
+        const __m128 vex = _mm_loadu_ps(ex);
+        const __m128 vey = _mm_loadu_ps(ey);
+        const __m128 vez = _mm_loadu_ps(ez);
+        __m128 outside = _mm_setzero_ps();
+        for(std::size_t p = 0; p != 6; ++p) {
+            const __m128 d = dot3(planes.x[p], planes.y[p], planes.z[p], vcx, vcy, vcz);
+            const __m128 r = dot3(planes.absX[p], planes.absY[p], planes.absZ[p], vex, vey, vez);
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), _mm_set1_ps(planes.w[p])));
+        }
+        setVisibleBits(visible, i, _mm_movemask_ps(outside));
+        #else
+        const float32x4_t vcx = vld1q_f32(cx);
+        const float32x4_t vcy = vld1q_f32(cy);
+        const float32x4_t vcz = vld1q_f32(cz);
+        const float32x4_t vex = vld1q_f32(ex);
+        const float32x4_t vey = vld1q_f32(ey);
+        const float32x4_t vez = vld1q_f32(ez);
+        uint32x4_t outside = vdupq_n_u32(0);
+        for(std::size_t p = 0; p != 6; ++p) {
+            const float32x4_t d = dot3(planes.x[p], planes.y[p], planes.z[p], vcx, vcy, vcz);
+            const float32x4_t r = dot3(planes.absX[p], planes.absY[p], planes.absZ[p], vex, vey, vez);
+            outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(d, r), vdupq_n_f32(planes.w[p])));
+        }
+        setVisibleBits(visible, i,
+            (vgetq_lane_u32(outside, 0) & 1)|
+            (vgetq_lane_u32(outside, 1) & 2)|
+            (vgetq_lane_u32(outside, 2) & 4)|
+            (vgetq_lane_u32(outside, 3) & 8));
+        #endif
+    }
+    #endif
+
+    /* Remaining items, or everything if there's no SIMD available */
+    for(; i != size; ++i) {
+        Vector3<Float> center, extent;
+        gather(i, center, extent);
+        bool outside = false;
+        for(std::size_t p = 0; p != 6; ++p) {
+            const Float d = planes.x[p]*center.x() + planes.y[p]*center.y() + planes.z[p]*center.z();
+            const Float r = planes.absX[p]*extent.x() + planes.absY[p]*extent.y() + planes.absZ[p]*extent.z();
+            outside |= d + r < planes.w[p];
+        }
+        if(!outside) visible.set(i);
+    }
+}
+
+}
+
+void aabbFrustumInto(const Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Containers::StridedArrayView1D<const Vector3<Float>>& extents, const Frustum<Float>& frustum, const Containers::MutableBitArrayView visible) {
+    CORRADE_ASSERT(extents.size() == centers.size(),
+        "Math::Intersection::aabbFrustumInto(): expected extents to have" << centers.size() << "items but got" << extents.size(), );
+    CORRADE_ASSERT(visible.size() == centers.size(),
+        "Math::Intersection::aabbFrustumInto(): expected output to have" << centers.size() << "bits but got" << visible.size(), );
+
+    boxFrustumInto(centers.size(), [&](const std::size_t i, Vector3<Float>& center, Vector3<Float>& extent) {
+        center = centers[i];
+        extent = extents[i];
+    }, 1.0f, frustum, visible);
+}
+
+void rangeFrustumInto(const Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, const Containers::MutableBitArrayView visible) {
+    CORRADE_ASSERT(visible.size() == ranges.size(),
+        "Math::Intersection::rangeFrustumInto(): expected output to have" << ranges.size() << "bits but got" << visible.size(), );
+
+    /* Convert to center/extent, avoiding division by 2 and instead comparing
+       to 2*-plane.w() */
+    boxFrustumInto(ranges.size(), [&](const std::size_t i, Vector3<Float>& center, Vector3<Float>& extent) {
+        const Range3D<Float>& range = ranges[i];
+        center = range.min() + range.max();
+        extent = range.max() - range.min();
+    }, 2.0f, frustum, visible);
+}
+
+}}}
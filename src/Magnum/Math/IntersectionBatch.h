@@ -0,0 +1,99 @@
+#ifndef Magnum_Math_IntersectionBatch_h
+#define Magnum_Math_IntersectionBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Functions @ref Magnum::Math::Intersection::sphereFrustumInto(), @ref Magnum::Math::Intersection::aabbFrustumInto(), @ref Magnum::Math::Intersection::rangeFrustumInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Math { namespace Intersection {
+
+/**
+@{ @name Batch frustum culling functions
+
+These functions test an unbounded range of bounding volumes against a single
+frustum, as opposed to the per-object functions in
+@ref Magnum/Math/Intersection.h. The frustum planes are transposed into a
+structure-of-arrays form once and then tested against several bounding volumes
+at a time using SSE2 or NEON, if available, or a branchless scalar loop
+otherwise.
+*/
+
+/**
+@brief Intersection of spheres and a frustum
+@param[in]  centers Sphere centers
+@param[in]  radii   Sphere radii
+@param[in]  frustum Frustum planes with normals pointing outwards
+@param[out] visible Where to put the results
+@m_since_latest
+
+Batch equivalent of @ref sphereFrustum(), giving the same result for each
+sphere. Bits in @p visible are set for spheres that intersect the frustum and
+reset for those that don't. Expects that @p centers, @p radii and @p visible
+have the same size.
+*/
+MAGNUM_EXPORT void sphereFrustumInto(const Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Containers::StridedArrayView1D<const Float>& radii, const Frustum<Float>& frustum, Containers::MutableBitArrayView visible);
+
+/**
+@brief Intersection of axis-aligned boxes and a frustum
+@param[in]  centers Centers of the AABBs
+@param[in]  extents (Half-)extents of the AABBs
+@param[in]  frustum Frustum planes with normals pointing outwards
+@param[out] visible Where to put the results
+@m_since_latest
+
+Batch equivalent of @ref aabbFrustum(), giving the same result for each box.
+Bits in @p visible are set for boxes that intersect the frustum and reset for
+those that don't. Expects that @p centers, @p extents and @p visible have the
+same size.
+*/
+MAGNUM_EXPORT void aabbFrustumInto(const Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Containers::StridedArrayView1D<const Vector3<Float>>& extents, const Frustum<Float>& frustum, Containers::MutableBitArrayView visible);
+
+/**
+@brief Intersection of ranges and a frustum
+@param[in]  ranges  Ranges
+@param[in]  frustum Frustum planes with normals pointing outwards
+@param[out] visible Where to put the results
+@m_since_latest
+
+Batch equivalent of @ref rangeFrustum(), giving the same result for each
+range. Bits in @p visible are set for ranges that intersect the frustum and
+reset for those that don't. Expects that @p ranges and @p visible have the
+same size.
+*/
+MAGNUM_EXPORT void rangeFrustumInto(const Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, Containers::MutableBitArrayView visible);
+
+/*@}*/
+
+}}}
+
+#endif
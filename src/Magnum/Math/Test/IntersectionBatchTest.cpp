@@ -0,0 +1,184 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/BitArray.h>
+#include <Corrade/Containers/BitArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/IntersectionBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct IntersectionBatchTest: TestSuite::Tester {
+    explicit IntersectionBatchTest();
+
+    void sphereFrustum();
+    void aabbFrustum();
+    void rangeFrustum();
+    void empty();
+
+    void assertions();
+};
+
+using Magnum::Vector3;
+using Magnum::Vector4;
+using Magnum::Frustum;
+using Magnum::Range3D;
+
+/* Same as in IntersectionTest */
+const Frustum FrustumData{
+    {1.0f, 0.0f, 0.0f, 0.0f},
+    {-1.0f, 0.0f, 0.0f, 5.0f},
+    {0.0f, 1.0f, 0.0f, 0.0f},
+    {0.0f, -1.0f, 0.0f, 1.0f},
+    {0.0f, 0.0f, 1.0f, 0.0f},
+    {0.0f, 0.0f, -1.0f, 10.0f}};
+
+/* Eleven items, so both the four-item batches and the remainder get tested
+   on SIMD-enabled platforms. The boxes are interleaved with the spheres in
+   order to test strided input as well. */
+const struct {
+    Vector3 center;
+    Float radius;
+    Vector3 extents;
+    bool sphereVisible, aabbVisible;
+} VolumeData[]{
+    /* Fully inside */
+    {{2.5f, 0.5f, 5.0f}, 0.1f, {0.1f}, true, true},
+    /* Intersects with exactly one plane each */
+    {{2.5f, 0.0f, 5.0f}, 0.1f, {0.1f}, true, true},
+    {{2.5f, 1.0f, 5.0f}, 0.1f, {0.1f}, true, true},
+    {{0.0f, 0.5f, 5.0f}, 0.1f, {0.1f}, true, true},
+    {{5.0f, 0.5f, 5.0f}, 0.1f, {0.1f}, true, true},
+    {{2.5f, 0.5f, 0.0f}, 0.1f, {0.1f}, true, true},
+    /* Outside of frustum */
+    {{-7.5f, -7.5f, -7.5f}, 2.5f, {2.5f}, false, false},
+    {{2.5f, 0.5f, 10.0f}, 0.1f, {0.1f}, true, true},
+    /* Bigger than frustum, but still intersects */
+    {{0.0f, 0.0f, 0.0f}, 100.0f, {100.0f}, true, true},
+    /* Outside of frustum again */
+    {{2.5f, 0.5f, 20.0f}, 1.0f, {1.0f}, false, false},
+    {{2.5f, 3.0f, 5.0f}, 1.0f, {1.0f}, false, false},
+};
+
+IntersectionBatchTest::IntersectionBatchTest() {
+    addTests({&IntersectionBatchTest::sphereFrustum,
+              &IntersectionBatchTest::aabbFrustum,
+              &IntersectionBatchTest::rangeFrustum,
+              &IntersectionBatchTest::empty,
+
+              &IntersectionBatchTest::assertions});
+}
+
+void IntersectionBatchTest::sphereFrustum() {
+    auto data = Containers::stridedArrayView(VolumeData);
+
+    Containers::BitArray visible{ValueInit, data.size()};
+    Intersection::sphereFrustumInto(
+        data.slice(&std::remove_all_extents<decltype(VolumeData)>::type::center),
+        data.slice(&std::remove_all_extents<decltype(VolumeData)>::type::radius),
+        FrustumData, visible);
+
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(visible[i], data[i].sphereVisible);
+        /* Should give the same result as the scalar variant */
+        CORRADE_COMPARE(visible[i], Intersection::sphereFrustum(data[i].center, data[i].radius, FrustumData));
+    }
+}
+
+void IntersectionBatchTest::aabbFrustum() {
+    auto data = Containers::stridedArrayView(VolumeData);
+
+    Containers::BitArray visible{ValueInit, data.size()};
+    Intersection::aabbFrustumInto(
+        data.slice(&std::remove_all_extents<decltype(VolumeData)>::type::center),
+        data.slice(&std::remove_all_extents<decltype(VolumeData)>::type::extents),
+        FrustumData, visible);
+
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(visible[i], data[i].aabbVisible);
+        /* Should give the same result as the scalar variant */
+        CORRADE_COMPARE(visible[i], Intersection::aabbFrustum(data[i].center, data[i].extents, FrustumData));
+    }
+}
+
+void IntersectionBatchTest::rangeFrustum() {
+    Range3D ranges[Containers::arraySize(VolumeData)];
+    for(std::size_t i = 0; i != Containers::arraySize(VolumeData); ++i)
+        ranges[i] = Range3D::fromCenter(VolumeData[i].center, VolumeData[i].extents);
+
+    /* Start with everything set to verify the bits get reset as well */
+    Containers::BitArray visible{DirectInit, Containers::arraySize(ranges), true};
+    Intersection::rangeFrustumInto(ranges, FrustumData, visible);
+
+    for(std::size_t i = 0; i != Containers::arraySize(ranges); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(visible[i], VolumeData[i].aabbVisible);
+        /* Should give the same result as the scalar variant */
+        CORRADE_COMPARE(visible[i], Intersection::rangeFrustum(ranges[i], FrustumData));
+    }
+}
+
+void IntersectionBatchTest::empty() {
+    /* Shouldn't crash or assert */
+    Intersection::sphereFrustumInto(nullptr, nullptr, FrustumData, nullptr);
+    Intersection::aabbFrustumInto(nullptr, nullptr, FrustumData, nullptr);
+    Intersection::rangeFrustumInto(nullptr, FrustumData, nullptr);
+    CORRADE_VERIFY(true);
+}
+
+void IntersectionBatchTest::assertions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector3 centers[3];
+    Float radii[3];
+    Vector3 extents[2];
+    Range3D ranges[3];
+    Containers::BitArray visible{ValueInit, 3};
+    Containers::BitArray visibleWrongSize{ValueInit, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Intersection::sphereFrustumInto(centers, Containers::arrayView(radii).prefix(2), FrustumData, visible);
+    Intersection::sphereFrustumInto(centers, radii, FrustumData, visibleWrongSize);
+    Intersection::aabbFrustumInto(centers, extents, FrustumData, visible);
+    Intersection::rangeFrustumInto(ranges, FrustumData, visibleWrongSize);
+    CORRADE_COMPARE(out.str(),
+        "Math::Intersection::sphereFrustumInto(): expected radii to have 3 items but got 2\n"
+        "Math::Intersection::sphereFrustumInto(): expected output to have 3 bits but got 2\n"
+        "Math::Intersection::aabbFrustumInto(): expected extents to have 3 items but got 2\n"
+        "Math::Intersection::rangeFrustumInto(): expected output to have 3 bits but got 2\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::IntersectionBatchTest)
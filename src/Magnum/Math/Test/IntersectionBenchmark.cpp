@@ -25,10 +25,14 @@
 */
 
 #include <random>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/BitArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Angle.h"
 #include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/IntersectionBatch.h"
 
 namespace Magnum { namespace Math { namespace Test { namespace {
 
@@ -101,10 +105,14 @@ struct IntersectionBenchmark: TestSuite::Tester {
 
     void rangeFrustumNaive();
     void rangeFrustum();
+    void rangeFrustumBatch();
 
     void rangeCone();
 
     void sphereFrustum();
+    void sphereFrustumBatch();
+    void sphereFrustumMany();
+    void sphereFrustumManyBatch();
 
     void sphereConeNaive();
     void sphereCone();
@@ -120,15 +128,25 @@ struct IntersectionBenchmark: TestSuite::Tester {
 
     std::vector<Range3D> _boxes;
     std::vector<Vector4> _spheres;
+
+    /* Sphere data split for the batch variants, and a large set for comparing
+       them against the scalar one */
+    std::vector<Vector3> _sphereCenters, _manySphereCenters;
+    std::vector<Float> _sphereRadii, _manySphereRadii;
+    Containers::BitArray _visible, _manyVisible;
 };
 
 IntersectionBenchmark::IntersectionBenchmark() {
     addBenchmarks({&IntersectionBenchmark::rangeFrustumNaive,
                    &IntersectionBenchmark::rangeFrustum,
+                   &IntersectionBenchmark::rangeFrustumBatch,
 
                    &IntersectionBenchmark::rangeCone,
 
                    &IntersectionBenchmark::sphereFrustum,
+                   &IntersectionBenchmark::sphereFrustumBatch,
+                   &IntersectionBenchmark::sphereFrustumMany,
+                   &IntersectionBenchmark::sphereFrustumManyBatch,
 
                    &IntersectionBenchmark::sphereConeNaive,
                    &IntersectionBenchmark::sphereCone,
@@ -155,7 +173,20 @@ IntersectionBenchmark::IntersectionBenchmark() {
         Vector3 extents{pd(g), pd(g), pd(g)};
         _boxes.emplace_back(center - extents, center + extents);
         _spheres.emplace_back(center, extents.length());
+        _sphereCenters.push_back(center);
+        _sphereRadii.push_back(extents.length());
+    }
+
+    _manySphereCenters.reserve(100000);
+    _manySphereRadii.reserve(100000);
+    for(int i = 0; i < 100000; ++i) {
+        _manySphereCenters.emplace_back(pd(g), pd(g), pd(g));
+        /* Smaller radii than above, so some are actually culled */
+        _manySphereRadii.push_back(Math::abs(pd(g))*0.1f);
     }
+
+    _visible = Containers::BitArray{ValueInit, _boxes.size()};
+    _manyVisible = Containers::BitArray{ValueInit, _manySphereCenters.size()};
 }
 
 void IntersectionBenchmark::rangeFrustumNaive() {
@@ -172,6 +203,12 @@ void IntersectionBenchmark::rangeFrustum() {
     }
 }
 
+void IntersectionBenchmark::rangeFrustumBatch() {
+    CORRADE_BENCHMARK(50) {
+        Intersection::rangeFrustumInto(Containers::arrayView(_boxes), _frustum, _visible);
+    }
+}
+
 void IntersectionBenchmark::rangeCone() {
     volatile bool b = false;
     CORRADE_BENCHMARK(50) {
@@ -190,6 +227,25 @@ void IntersectionBenchmark::sphereFrustum() {
     }
 }
 
+void IntersectionBenchmark::sphereFrustumBatch() {
+    CORRADE_BENCHMARK(50) {
+        Intersection::sphereFrustumInto(Containers::arrayView(_sphereCenters), Containers::arrayView(_sphereRadii), _frustum, _visible);
+    }
+}
+
+void IntersectionBenchmark::sphereFrustumMany() {
+    volatile bool b = false;
+    CORRADE_BENCHMARK(1) for(std::size_t i = 0; i != _manySphereCenters.size(); ++i) {
+        b = b ^ Intersection::sphereFrustum(_manySphereCenters[i], _manySphereRadii[i], _frustum);
+    }
+}
+
+void IntersectionBenchmark::sphereFrustumManyBatch() {
+    CORRADE_BENCHMARK(1) {
+        Intersection::sphereFrustumInto(Containers::arrayView(_manySphereCenters), Containers::arrayView(_manySphereRadii), _frustum, _manyVisible);
+    }
+}
+
 void IntersectionBenchmark::sphereConeNaive() {
     volatile bool b = false;
     CORRADE_BENCHMARK(50) for(auto& sphere: _spheres) {
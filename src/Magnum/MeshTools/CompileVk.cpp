@@ -0,0 +1,188 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CompileVk.h"
+
+#include <Corrade/Containers/StaticArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/Mesh.h"
+#include "Magnum/Vk/Uploader.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Matches the generic attribute definitions in Shaders/generic.glsl */
+Int genericAttributeLocation(const Trade::MeshAttribute name) {
+    switch(name) {
+        case Trade::MeshAttribute::Position: return 0;
+        case Trade::MeshAttribute::TextureCoordinates: return 1;
+        case Trade::MeshAttribute::Color: return 2;
+        case Trade::MeshAttribute::Tangent: return 3;
+        case Trade::MeshAttribute::Bitangent:
+        case Trade::MeshAttribute::ObjectId: return 4;
+        case Trade::MeshAttribute::Normal: return 5;
+        /* Joint IDs and weights are commonly arrays spanning more than one
+           location, not handled here. A runtime warning is printed for
+           these. */
+        case Trade::MeshAttribute::JointIds:
+        case Trade::MeshAttribute::Weights:
+            break;
+    }
+
+    return -1;
+}
+
+Vk::Mesh compileInternal(Vk::Device& device, Vk::Uploader& uploader, Vk::MemoryAllocator* const allocator, const Trade::MeshData& meshData) {
+    /* Decide which attributes get bound first to know how much data is
+       needed. Ensure each location gets bound only once, remember the mesh
+       attribute index that got bound to it first, or ~UnsignedInt{} if
+       none yet. */
+    Containers::StaticArray<6, UnsignedInt> boundAttributes{DirectInit, ~UnsignedInt{}};
+    UnsignedInt morphTargetAttributeCount = 0;
+    bool hasAttributes = false;
+    for(UnsignedInt i = 0; i != meshData.attributeCount(); ++i) {
+        /* No builtin support for morph targets yet, count them and print a
+           single warning at the end */
+        if(meshData.attributeMorphTargetId(i) != -1) {
+            ++morphTargetAttributeCount;
+            continue;
+        }
+
+        const Int location = genericAttributeLocation(meshData.attributeName(i));
+        if(location == -1) {
+            Warning{} << "MeshTools::compile(): ignoring unknown/unsupported attribute" << meshData.attributeName(i);
+            continue;
+        }
+
+        if(meshData.attributeArraySize(i)) {
+            Warning{} << "MeshTools::compile(): ignoring array attribute" << meshData.attributeName(i);
+            continue;
+        }
+
+        /* Similarly to the GL variant, warn if an attribute has a location
+           conflicting with another one (such as ObjectId and Bitangent), or
+           if there's more than one set of a particular attribute */
+        if(boundAttributes[location] != ~UnsignedInt{}) {
+            Warning{} << "MeshTools::compile(): ignoring" << meshData.attributeName(i) << meshData.attributeId(i) << "as its binding slot is already occupied by" << meshData.attributeName(boundAttributes[location]) << meshData.attributeId(boundAttributes[location]);
+            continue;
+        }
+
+        /* Vulkan allows zero strides, but then all vertices get the same
+           value, which isn't what a zero stride means in MeshData. Negative
+           strides are not supported at all. */
+        const Int stride = meshData.attributeStride(i);
+        CORRADE_ASSERT(stride > 0,
+            "MeshTools::compile():" << meshData.attributeName(i) << "stride of" << stride << "bytes isn't supported by Vulkan", Vk::Mesh{Vk::MeshLayout{meshData.primitive()}});
+
+        boundAttributes[location] = i;
+        hasAttributes = true;
+    }
+
+    if(morphTargetAttributeCount)
+        Warning{} << "MeshTools::compile(): ignoring" << morphTargetAttributeCount << "morph target attributes";
+
+    /* Index data go first, vertex data after, aligned to 16 bytes. The index
+       buffer offset has to be a multiple of the index type size, which is
+       satisfied for index data at offset 0. */
+    const Containers::ArrayView<const char> indexData = meshData.isIndexed() ? meshData.indexData() : nullptr;
+    const Containers::ArrayView<const char> vertexData = hasAttributes ? meshData.vertexData() : nullptr;
+    const UnsignedLong vertexOffset = (indexData.size() + 15) & ~UnsignedLong{15};
+
+    if(meshData.isIndexed())
+        CORRADE_ASSERT(isMeshIndexTypeImplementationSpecific(meshData.indexType()) || Short(meshIndexTypeSize(meshData.indexType())) == meshData.indexStride(),
+            "MeshTools::compile():" << meshData.indexType() << "with stride of" << meshData.indexStride() << "bytes isn't supported by Vulkan", Vk::Mesh{Vk::MeshLayout{meshData.primitive()}});
+
+    /* Mesh layout with a dedicated binding for every attribute, having the
+       same ID as the location */
+    Vk::MeshLayout layout{meshData.primitive()};
+    for(UnsignedInt location = 0; location != boundAttributes.size(); ++location) {
+        const UnsignedInt i = boundAttributes[location];
+        if(i == ~UnsignedInt{}) continue;
+
+        layout.addBinding(location, meshData.attributeStride(i))
+              .addAttribute(location, location, meshData.attributeFormat(i), 0);
+    }
+
+    Vk::Mesh mesh{Utility::move(layout)};
+    mesh.setCount(meshData.isIndexed() ? meshData.indexCount() : meshData.vertexCount());
+
+    /* Nothing to upload, return just the layout with a count. This can happen
+       for example for attribute-less meshes generated in the vertex
+       shader. */
+    if(indexData.isEmpty() && vertexData.isEmpty())
+        return mesh;
+
+    Vk::BufferUsages usage = Vk::BufferUsage::TransferDestination;
+    if(!indexData.isEmpty()) usage |= Vk::BufferUsage::IndexBuffer;
+    if(!vertexData.isEmpty()) usage |= Vk::BufferUsage::VertexBuffer;
+    const Vk::BufferCreateInfo info{usage, vertexOffset + vertexData.size()};
+    Vk::Buffer buffer = allocator ?
+        Vk::Buffer{device, info, *allocator, Vk::MemoryFlag::DeviceLocal} :
+        Vk::Buffer{device, info, Vk::MemoryFlag::DeviceLocal};
+
+    if(!indexData.isEmpty())
+        uploader.uploadBuffer(buffer, 0, indexData);
+    if(!vertexData.isEmpty())
+        uploader.uploadBuffer(buffer, vertexOffset, vertexData);
+
+    /* Vertex buffers are referenced by the handle, the buffer ownership is
+       transferred either to the index buffer or, for a non-indexed mesh, to
+       the first vertex binding */
+    const VkBuffer handle = buffer;
+    bool owned = false;
+    if(meshData.isIndexed()) {
+        mesh.setIndexBuffer(Utility::move(buffer), meshData.indexOffset(), meshData.indexType());
+        owned = true;
+    }
+    for(UnsignedInt location = 0; location != boundAttributes.size(); ++location) {
+        const UnsignedInt i = boundAttributes[location];
+        if(i == ~UnsignedInt{}) continue;
+
+        const UnsignedLong offset = vertexOffset + meshData.attributeOffset(i);
+        if(!owned) {
+            mesh.addVertexBuffer(location, Utility::move(buffer), offset);
+            owned = true;
+        } else mesh.addVertexBuffer(location, handle, offset);
+    }
+
+    return mesh;
+}
+
+}
+
+Vk::Mesh compile(Vk::Device& device, Vk::Uploader& uploader, const Trade::MeshData& mesh) {
+    return compileInternal(device, uploader, nullptr, mesh);
+}
+
+Vk::Mesh compile(Vk::Device& device, Vk::Uploader& uploader, Vk::MemoryAllocator& allocator, const Trade::MeshData& mesh) {
+    return compileInternal(device, uploader, &allocator, mesh);
+}
+
+}}
@@ -0,0 +1,109 @@
+#ifndef Magnum_MeshTools_CompileVk_h
+#define Magnum_MeshTools_CompileVk_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::compile(Vk::Device&, Vk::Uploader&, const Trade::MeshData&)
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifdef MAGNUM_TARGET_VK
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Vk/Vk.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Compile Vulkan mesh data
+@m_since_latest
+
+Vulkan counterpart to @ref compile(const Trade::MeshData&). Creates a single
+device-local @ref Vk::Buffer containing both the index and vertex data of
+@p mesh, schedules an upload of the data to it via @p uploader and configures
+a @ref Vk::MeshLayout with binding locations matching the generic shader
+attribute definitions:
+
+-   @ref Trade::MeshAttribute::Position is bound to location @cpp 0 @ce
+-   @ref Trade::MeshAttribute::TextureCoordinates is bound to location
+    @cpp 1 @ce
+-   @ref Trade::MeshAttribute::Color is bound to location @cpp 2 @ce
+-   @ref Trade::MeshAttribute::Tangent is bound to location @cpp 3 @ce
+-   @ref Trade::MeshAttribute::Bitangent and
+    @ref Trade::MeshAttribute::ObjectId are bound to location @cpp 4 @ce. If
+    the mesh contains both, only the first appearing of the two is bound and
+    the second is ignored with a warning as they share the same location.
+-   @ref Trade::MeshAttribute::Normal is bound to location @cpp 5 @ce
+-   @ref Trade::MeshAttribute::JointIds, @ref Trade::MeshAttribute::Weights,
+    custom attributes, morph target attributes and array attributes are
+    ignored with a warning.
+-   Implementation-specific @ref Magnum::VertexFormat,
+    @ref Magnum::MeshPrimitive and @ref Magnum::MeshIndexType values are
+    passed as-is with @ref vertexFormatUnwrap(), @ref meshPrimitiveUnwrap()
+    and @ref meshIndexTypeUnwrap(). Unlike with OpenGL, a single 32-bit value
+    is enough to describe a Vulkan vertex format so these don't need to be
+    ignored. It's the user responsibility to ensure an implementation-specific
+    value is valid in this context.
+
+Each attribute gets its own binding with the same index as the location,
+pointing to the same buffer at the attribute offset. The original vertex
+layout and formats are kept without any further modifications. The index
+buffer is expected to be contiguous and stride of all attributes is expected
+to be positive.
+
+The returned mesh owns the buffer. As the upload is only scheduled and not
+executed, it's the caller responsibility to call @ref Vk::Uploader::submit()
+or @ref Vk::Uploader::wait() before the mesh is drawn. The uploader takes care
+of making the data visible to all subsequent commands submitted to the same
+queue.
+
+@note This function is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_VK enabled (done by default if Vulkan is enabled). See
+    @ref building-features for more information.
+
+@see @ref compile(Vk::Device&, Vk::Uploader&, Vk::MemoryAllocator&, const Trade::MeshData&)
+*/
+MAGNUM_MESHTOOLS_EXPORT Vk::Mesh compile(Vk::Device& device, Vk::Uploader& uploader, const Trade::MeshData& mesh);
+
+/**
+@brief Compile Vulkan mesh data with memory from an allocator
+@m_since_latest
+
+Compared to @ref compile(Vk::Device&, Vk::Uploader&, const Trade::MeshData&)
+the buffer memory is sub-allocated from @p allocator instead of using a
+dedicated allocation, which is preferrable when compiling many small meshes.
+*/
+MAGNUM_MESHTOOLS_EXPORT Vk::Mesh compile(Vk::Device& device, Vk::Uploader& uploader, Vk::MemoryAllocator& allocator, const Trade::MeshData& mesh);
+
+}}
+#else
+#error this header is available only in the Vulkan build
+#endif
+
+#endif
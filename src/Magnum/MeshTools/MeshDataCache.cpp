@@ -0,0 +1,249 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshDataCache.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace Implementation {
+
+enum class MeshDataCacheAccessor: UnsignedByte {
+    Indices,
+    Positions2D,
+    Positions3D,
+    Tangents,
+    BitangentSigns,
+    Bitangents,
+    Normals,
+    TextureCoordinates2D,
+    Colors,
+    ObjectIds
+};
+
+struct MeshDataCacheEntry {
+    MeshDataCacheAccessor accessor;
+    UnsignedInt id;
+    Int morphTargetId;
+    Containers::Array<char> data;
+};
+
+}
+
+namespace {
+
+using Implementation::MeshDataCacheAccessor;
+using Implementation::MeshDataCacheEntry;
+
+/* Attribute each accessor converts from, used by invalidate(MeshAttribute).
+   Indices aren't an attribute so they're never matched here. */
+bool accessorUsesAttribute(const MeshDataCacheAccessor accessor, const Trade::MeshAttribute name) {
+    switch(accessor) {
+        case MeshDataCacheAccessor::Indices:
+            return false;
+        case MeshDataCacheAccessor::Positions2D:
+        case MeshDataCacheAccessor::Positions3D:
+            return name == Trade::MeshAttribute::Position;
+        case MeshDataCacheAccessor::Tangents:
+        case MeshDataCacheAccessor::BitangentSigns:
+            return name == Trade::MeshAttribute::Tangent;
+        case MeshDataCacheAccessor::Bitangents:
+            return name == Trade::MeshAttribute::Bitangent;
+        case MeshDataCacheAccessor::Normals:
+            return name == Trade::MeshAttribute::Normal;
+        case MeshDataCacheAccessor::TextureCoordinates2D:
+            return name == Trade::MeshAttribute::TextureCoordinates;
+        case MeshDataCacheAccessor::Colors:
+            return name == Trade::MeshAttribute::Color;
+        case MeshDataCacheAccessor::ObjectIds:
+            return name == Trade::MeshAttribute::ObjectId;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Returns an existing conversion result or converts the data using given
+   MeshData member function. The entry data is a separate allocation so the
+   returned view stays valid even if the entry array gets reallocated by
+   subsequent conversions. */
+template<class T, class ...Args> Containers::ArrayView<const T> cached(Containers::Array<MeshDataCacheEntry>& entries, const Trade::MeshData& mesh, const MeshDataCacheAccessor accessor, const std::size_t count, const UnsignedInt id, const Int morphTargetId, void(Trade::MeshData::*into)(const Containers::StridedArrayView1D<T>&, Args...) const, Args... args) {
+    for(const MeshDataCacheEntry& entry: entries)
+        if(entry.accessor == accessor && entry.id == id && entry.morphTargetId == morphTargetId)
+            return Containers::arrayCast<const T>(entry.data);
+
+    Containers::Array<char> data{NoInit, count*sizeof(T)};
+    (mesh.*into)(Containers::arrayCast<T>(data), args...);
+    return Containers::arrayCast<const T>(arrayAppend(entries, MeshDataCacheEntry{accessor, id, morphTargetId, Utility::move(data)}).data);
+}
+
+}
+
+MeshDataCache::MeshDataCache(const Trade::MeshData& mesh): _mesh{&mesh} {}
+
+MeshDataCache::MeshDataCache(MeshDataCache&&) noexcept = default;
+
+MeshDataCache::~MeshDataCache() = default;
+
+MeshDataCache& MeshDataCache::operator=(MeshDataCache&&) noexcept = default;
+
+std::size_t MeshDataCache::cachedCount() const {
+    return _entries.size();
+}
+
+Containers::ArrayView<const UnsignedInt> MeshDataCache::indices() {
+    CORRADE_ASSERT(_mesh->isIndexed(),
+        "MeshTools::MeshDataCache::indices(): the mesh is not indexed", {});
+    return cached<UnsignedInt>(_entries, *_mesh, MeshDataCacheAccessor::Indices, _mesh->indexCount(), 0, -1, &Trade::MeshData::indicesInto);
+}
+
+Containers::ArrayView<const Vector2> MeshDataCache::positions2D(const UnsignedInt id, const Int morphTargetId) {
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt count = _mesh->attributeCount(Trade::MeshAttribute::Position, morphTargetId);
+    if(morphTargetId == -1) CORRADE_ASSERT(id < count,
+        "MeshTools::MeshDataCache::positions2D(): index" << id << "out of range for" << count << "position attributes", {});
+    else CORRADE_ASSERT(id < count,
+        "MeshTools::MeshDataCache::positions2D(): index" << id << "out of range for" << count << "position attributes in morph target" << morphTargetId, {});
+    #endif
+    return cached<Vector2, UnsignedInt, Int>(_entries, *_mesh, MeshDataCacheAccessor::Positions2D, _mesh->vertexCount(), id, morphTargetId, &Trade::MeshData::positions2DInto, id, morphTargetId);
+}
+
+Containers::ArrayView<const Vector3> MeshDataCache::positions3D(const UnsignedInt id, const Int morphTargetId) {
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt count = _mesh->attributeCount(Trade::MeshAttribute::Position, morphTargetId);
+    if(morphTargetId == -1) CORRADE_ASSERT(id < count,
+        "MeshTools::MeshDataCache::positions3D(): index" << id << "out of range for" << count << "position attributes", {});
+    else CORRADE_ASSERT(id < count,
+        "MeshTools::MeshDataCache::positions3D(): index" << id << "out of range for" << count << "position attributes in morph target" << morphTargetId, {});
+    #endif
+    return cached<Vector3, UnsignedInt, Int>(_entries, *_mesh, MeshDataCacheAccessor::Positions3D, _mesh->vertexCount(), id, morphTargetId, &Trade::MeshData::positions3DInto, id, morphTargetId);
+}
+
+Containers::ArrayView<const Vector3> MeshDataCache::tangents(const UnsignedInt id, const Int morphTargetId) {
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt count = _mesh->attributeCount(Trade::MeshAttribute::Tangent, morphTargetId);
+    if(morphTargetId == -1) CORRADE_ASSERT(id < count,
+        "MeshTools::MeshDataCache::tangents(): index" << id << "out of range for" << count << "tangent attributes", {});
+    else CORRADE_ASSERT(id < count,
+        "MeshTools::MeshDataCache::tangents(): index" << id << "out of range for" << count << "tangent attributes in morph target" << morphTargetId, {});
+    #endif
+    return cached<Vector3, UnsignedInt, Int>(_entries, *_mesh, MeshDataCacheAccessor::Tangents, _mesh->vertexCount(), id, morphTargetId, &Trade::MeshData::tangentsInto, id, morphTargetId);
+}
+
+Containers::ArrayView<const Float> MeshDataCache::bitangentSigns(const UnsignedInt id, const Int morphTargetId) {
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt count = _mesh->attributeCount(Trade::MeshAttribute::Tangent, morphTargetId);
+    if(morphTargetId == -1) CORRADE_ASSERT(id < count,
+        "MeshTools::MeshDataCache::bitangentSigns(): index" << id << "out of range for" << count << "tangent attributes", {});
+    else CORRADE_ASSERT(id < count,
+        "MeshTools::MeshDataCache::bitangentSigns(): index" << id << "out of range for" << count << "tangent attributes in morph target" << morphTargetId, {});
+    #endif
+    return cached<Float, UnsignedInt, Int>(_entries, *_mesh, MeshDataCacheAccessor::BitangentSigns, _mesh->vertexCount(), id, morphTargetId, &Trade::MeshData::bitangentSignsInto, id, morphTargetId);
+}
+
+Containers::ArrayView<const Vector3> MeshDataCache::bitangents(const UnsignedInt id, const Int morphTargetId) {
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt count = _mesh->attributeCount(Trade::MeshAttribute::Bitangent, morphTargetId);
+    if(morphTargetId == -1) CORRADE_ASSERT(id < count,
+        "MeshTools::MeshDataCache::bitangents(): index" << id << "out of range for" << count << "bitangent attributes", {});
+    else CORRADE_ASSERT(id < count,
+        "MeshTools::MeshDataCache::bitangents(): index" << id << "out of range for" << count << "bitangent attributes in morph target" << morphTargetId, {});
+    #endif
+    return cached<Vector3, UnsignedInt, Int>(_entries, *_mesh, MeshDataCacheAccessor::Bitangents, _mesh->vertexCount(), id, morphTargetId, &Trade::MeshData::bitangentsInto, id, morphTargetId);
+}
+
+Containers::ArrayView<const Vector3> MeshDataCache::normals(const UnsignedInt id, const Int morphTargetId) {
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt count = _mesh->attributeCount(Trade::MeshAttribute::Normal, morphTargetId);
+    if(morphTargetId == -1) CORRADE_ASSERT(id < count,
+        "MeshTools::MeshDataCache::normals(): index" << id << "out of range for" << count << "normal attributes", {});
+    else CORRADE_ASSERT(id < count,
+        "MeshTools::MeshDataCache::normals(): index" << id << "out of range for" << count << "normal attributes in morph target" << morphTargetId, {});
+    #endif
+    return cached<Vector3, UnsignedInt, Int>(_entries, *_mesh, MeshDataCacheAccessor::Normals, _mesh->vertexCount(), id, morphTargetId, &Trade::MeshData::normalsInto, id, morphTargetId);
+}
+
+Containers::ArrayView<const Vector2> MeshDataCache::textureCoordinates2D(const UnsignedInt id, const Int morphTargetId) {
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt count = _mesh->attributeCount(Trade::MeshAttribute::TextureCoordinates, morphTargetId);
+    if(morphTargetId == -1) CORRADE_ASSERT(id < count,
+        "MeshTools::MeshDataCache::textureCoordinates2D(): index" << id << "out of range for" << count << "texture coordinate attributes", {});
+    else CORRADE_ASSERT(id < count,
+        "MeshTools::MeshDataCache::textureCoordinates2D(): index" << id << "out of range for" << count << "texture coordinate attributes in morph target" << morphTargetId, {});
+    #endif
+    return cached<Vector2, UnsignedInt, Int>(_entries, *_mesh, MeshDataCacheAccessor::TextureCoordinates2D, _mesh->vertexCount(), id, morphTargetId, &Trade::MeshData::textureCoordinates2DInto, id, morphTargetId);
+}
+
+Containers::ArrayView<const Color4> MeshDataCache::colors(const UnsignedInt id, const Int morphTargetId) {
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt count = _mesh->attributeCount(Trade::MeshAttribute::Color, morphTargetId);
+    if(morphTargetId == -1) CORRADE_ASSERT(id < count,
+        "MeshTools::MeshDataCache::colors(): index" << id << "out of range for" << count << "color attributes", {});
+    else CORRADE_ASSERT(id < count,
+        "MeshTools::MeshDataCache::colors(): index" << id << "out of range for" << count << "color attributes in morph target" << morphTargetId, {});
+    #endif
+    return cached<Color4, UnsignedInt, Int>(_entries, *_mesh, MeshDataCacheAccessor::Colors, _mesh->vertexCount(), id, morphTargetId, &Trade::MeshData::colorsInto, id, morphTargetId);
+}
+
+Containers::ArrayView<const UnsignedInt> MeshDataCache::objectIds(const UnsignedInt id) {
+    CORRADE_ASSERT(id < _mesh->attributeCount(Trade::MeshAttribute::ObjectId),
+        "MeshTools::MeshDataCache::objectIds(): index" << id << "out of range for" << _mesh->attributeCount(Trade::MeshAttribute::ObjectId) << "object ID attributes", {});
+    return cached<UnsignedInt, UnsignedInt>(_entries, *_mesh, MeshDataCacheAccessor::ObjectIds, _mesh->vertexCount(), id, -1, &Trade::MeshData::objectIdsInto, id);
+}
+
+MeshDataCache& MeshDataCache::invalidate() {
+    _entries = {};
+    return *this;
+}
+
+MeshDataCache& MeshDataCache::invalidate(const Trade::MeshAttribute name) {
+    /* Swap the removed entries with the ones at the end. The order doesn't
+       matter as the lookup is linear anyway. */
+    for(std::size_t i = 0; i != _entries.size(); ) {
+        if(accessorUsesAttribute(_entries[i].accessor, name)) {
+            if(i != _entries.size() - 1)
+                _entries[i] = Utility::move(_entries.back());
+            arrayRemoveSuffix(_entries, 1);
+        } else ++i;
+    }
+    return *this;
+}
+
+MeshDataCache& MeshDataCache::invalidateIndices() {
+    for(std::size_t i = 0; i != _entries.size(); ++i) {
+        if(_entries[i].accessor != MeshDataCacheAccessor::Indices) continue;
+        if(i != _entries.size() - 1)
+            _entries[i] = Utility::move(_entries.back());
+        arrayRemoveSuffix(_entries, 1);
+        break;
+    }
+    return *this;
+}
+
+}}
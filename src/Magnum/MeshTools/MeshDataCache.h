@@ -0,0 +1,220 @@
+#ifndef Magnum_MeshTools_MeshDataCache_h
+#define Magnum_MeshTools_MeshDataCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::MeshDataCache
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace Implementation {
+    struct MeshDataCacheEntry;
+}
+
+/**
+@brief Mesh data with cached attribute conversions
+@m_since_latest
+
+The @ref Trade::MeshData::positions3DAsArray(), ... accessors unpack and
+convert the attribute into a newly allocated array on every call. If the same
+attributes are needed repeatedly, for example when passing a single mesh to
+several functions, wrap it in this class instead. Each attribute gets
+converted just once per requested type, with the result kept for the lifetime
+of the cache and returned as a view:
+
+@snippet MeshTools.cpp MeshDataCache
+
+The class only references the original @ref Trade::MeshData, which is expected
+to stay in scope for the whole cache lifetime. If any of the attributes get
+modified through @ref Trade::MeshData::mutableAttribute(),
+@relativeref{Trade::MeshData,mutableIndices()} or the mutable data accessors,
+call @ref invalidate() or @ref invalidateIndices() to discard the stale
+conversion results. Views returned from the cache prior to the invalidation
+become dangling.
+
+Apart from the conversion, the accessors have the same behavior and
+expectations as their @ref Trade::MeshData counterparts. The class isn't
+thread-safe, use a dedicated instance for each thread.
+*/
+class MAGNUM_MESHTOOLS_EXPORT MeshDataCache {
+    public:
+        /** @brief Constructor */
+        explicit MeshDataCache(const Trade::MeshData& mesh);
+
+        /** @brief Copying is not allowed */
+        MeshDataCache(const MeshDataCache&) = delete;
+
+        /** @brief Move constructor */
+        MeshDataCache(MeshDataCache&&) noexcept;
+
+        ~MeshDataCache();
+
+        /** @brief Copying is not allowed */
+        MeshDataCache& operator=(const MeshDataCache&) = delete;
+
+        /** @brief Move assignment */
+        MeshDataCache& operator=(MeshDataCache&&) noexcept;
+
+        /** @brief Referenced mesh */
+        const Trade::MeshData& mesh() const { return *_mesh; }
+
+        /**
+         * @brief Count of cached conversion results
+         *
+         * Each distinct accessor, attribute ID and morph target combination
+         * counts as one.
+         */
+        std::size_t cachedCount() const;
+
+        /**
+         * @brief Indices as 32-bit integers
+         *
+         * Converted with @ref Trade::MeshData::indicesInto() on first use.
+         * Expects that the mesh is indexed.
+         */
+        Containers::ArrayView<const UnsignedInt> indices();
+
+        /**
+         * @brief Positions as 2D float vectors
+         *
+         * Converted with @ref Trade::MeshData::positions2DInto() on first
+         * use. Expects that the mesh has a @ref Trade::MeshAttribute::Position
+         * attribute of given @p id in given @p morphTargetId.
+         */
+        Containers::ArrayView<const Vector2> positions2D(UnsignedInt id = 0, Int morphTargetId = -1);
+
+        /**
+         * @brief Positions as 3D float vectors
+         *
+         * Converted with @ref Trade::MeshData::positions3DInto() on first
+         * use. Expects that the mesh has a @ref Trade::MeshAttribute::Position
+         * attribute of given @p id in given @p morphTargetId.
+         */
+        Containers::ArrayView<const Vector3> positions3D(UnsignedInt id = 0, Int morphTargetId = -1);
+
+        /**
+         * @brief Tangents as 3D float vectors
+         *
+         * Converted with @ref Trade::MeshData::tangentsInto() on first use.
+         * Expects that the mesh has a @ref Trade::MeshAttribute::Tangent
+         * attribute of given @p id in given @p morphTargetId.
+         */
+        Containers::ArrayView<const Vector3> tangents(UnsignedInt id = 0, Int morphTargetId = -1);
+
+        /**
+         * @brief Bitangent signs as floats
+         *
+         * Converted with @ref Trade::MeshData::bitangentSignsInto() on first
+         * use. Expects that the mesh has a four-component
+         * @ref Trade::MeshAttribute::Tangent attribute of given @p id in
+         * given @p morphTargetId.
+         */
+        Containers::ArrayView<const Float> bitangentSigns(UnsignedInt id = 0, Int morphTargetId = -1);
+
+        /**
+         * @brief Bitangents as 3D float vectors
+         *
+         * Converted with @ref Trade::MeshData::bitangentsInto() on first use.
+         * Expects that the mesh has a @ref Trade::MeshAttribute::Bitangent
+         * attribute of given @p id in given @p morphTargetId.
+         */
+        Containers::ArrayView<const Vector3> bitangents(UnsignedInt id = 0, Int morphTargetId = -1);
+
+        /**
+         * @brief Normals as 3D float vectors
+         *
+         * Converted with @ref Trade::MeshData::normalsInto() on first use.
+         * Expects that the mesh has a @ref Trade::MeshAttribute::Normal
+         * attribute of given @p id in given @p morphTargetId.
+         */
+        Containers::ArrayView<const Vector3> normals(UnsignedInt id = 0, Int morphTargetId = -1);
+
+        /**
+         * @brief Texture coordinates as 2D float vectors
+         *
+         * Converted with @ref Trade::MeshData::textureCoordinates2DInto() on
+         * first use. Expects that the mesh has a
+         * @ref Trade::MeshAttribute::TextureCoordinates attribute of given
+         * @p id in given @p morphTargetId.
+         */
+        Containers::ArrayView<const Vector2> textureCoordinates2D(UnsignedInt id = 0, Int morphTargetId = -1);
+
+        /**
+         * @brief Colors as RGBA floats
+         *
+         * Converted with @ref Trade::MeshData::colorsInto() on first use.
+         * Expects that the mesh has a @ref Trade::MeshAttribute::Color
+         * attribute of given @p id in given @p morphTargetId.
+         */
+        Containers::ArrayView<const Color4> colors(UnsignedInt id = 0, Int morphTargetId = -1);
+
+        /**
+         * @brief Object IDs as 32-bit integers
+         *
+         * Converted with @ref Trade::MeshData::objectIdsInto() on first use.
+         * Expects that the mesh has a @ref Trade::MeshAttribute::ObjectId
+         * attribute of given @p id.
+         */
+        Containers::ArrayView<const UnsignedInt> objectIds(UnsignedInt id = 0);
+
+        /**
+         * @brief Discard all cached conversion results
+         * @return Reference to self (for method chaining)
+         */
+        MeshDataCache& invalidate();
+
+        /**
+         * @brief Discard cached conversion results for given attribute
+         * @return Reference to self (for method chaining)
+         *
+         * Discards results converted from all attributes of given @p name, in
+         * all morph targets. In case of @ref Trade::MeshAttribute::Tangent,
+         * both @ref tangents() and @ref bitangentSigns() are discarded.
+         */
+        MeshDataCache& invalidate(Trade::MeshAttribute name);
+
+        /**
+         * @brief Discard cached index conversion result
+         * @return Reference to self (for method chaining)
+         */
+        MeshDataCache& invalidateIndices();
+
+    private:
+        const Trade::MeshData* _mesh;
+        Containers::Array<Implementation::MeshDataCacheEntry> _entries;
+};
+
+}}
+
+#endif
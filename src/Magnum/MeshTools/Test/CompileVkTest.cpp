@@ -0,0 +1,195 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/CompileVk.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Mesh.h"
+#include "Magnum/Vk/Uploader.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct CompileVkTest: Vk::VulkanTester {
+    explicit CompileVkTest();
+
+    void indexed();
+    void nonIndexed();
+    void noData();
+    void ignoredAttributes();
+    void zeroStride();
+};
+
+CompileVkTest::CompileVkTest() {
+    addTests({&CompileVkTest::indexed,
+              &CompileVkTest::nonIndexed,
+              &CompileVkTest::noData,
+              &CompileVkTest::ignoredAttributes,
+              &CompileVkTest::zeroStride});
+}
+
+const struct Vertex {
+    Vector3 position;
+    Vector2 textureCoordinates;
+} Vertices[]{
+    {{-1.0f, -1.0f, 0.0f}, {0.0f, 0.0f}},
+    {{ 1.0f, -1.0f, 0.0f}, {1.0f, 0.0f}},
+    {{ 0.0f,  1.0f, 0.0f}, {0.5f, 1.0f}}
+};
+
+void CompileVkTest::indexed() {
+    const UnsignedShort indices[]{0, 2, 1};
+    Containers::StridedArrayView1D<const Vertex> vertices = Vertices;
+    Trade::MeshData meshData{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, Vertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                vertices.slice(&Vertex::position)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+                vertices.slice(&Vertex::textureCoordinates)}
+        }};
+
+    Vk::Uploader uploader{device(), queue(), device().properties().pickQueueFamily(Vk::QueueFlag::Graphics), 4096};
+    Vk::Mesh mesh = compile(device(), uploader, meshData);
+    CORRADE_COMPARE(uploader.pendingCopyCount(), 2);
+    uploader.wait();
+
+    CORRADE_COMPARE(mesh.count(), 3);
+    CORRADE_VERIFY(mesh.isIndexed());
+    CORRADE_VERIFY(mesh.indexBuffer());
+    CORRADE_COMPARE(mesh.indexBufferOffset(), 0);
+    CORRADE_COMPARE(mesh.indexType(), Vk::MeshIndexType::UnsignedShort);
+
+    /* Index data are 6 bytes, vertex data are aligned to 16 bytes after */
+    CORRADE_COMPARE(mesh.vertexBuffers().size(), 2);
+    CORRADE_COMPARE(mesh.vertexBuffers()[0], mesh.indexBuffer());
+    CORRADE_COMPARE(mesh.vertexBuffers()[1], mesh.indexBuffer());
+    CORRADE_COMPARE_AS(mesh.vertexBufferOffsets(), Containers::arrayView<UnsignedLong>({
+        16, 16 + 12
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh.vertexBufferStrides(), Containers::arrayView<UnsignedLong>({
+        20, 20
+    }), TestSuite::Compare::Container);
+
+    const VkPipelineVertexInputStateCreateInfo& vertexInfo = mesh.layout().vkPipelineVertexInputStateCreateInfo();
+    CORRADE_COMPARE(vertexInfo.vertexBindingDescriptionCount, 2);
+    CORRADE_COMPARE(vertexInfo.vertexAttributeDescriptionCount, 2);
+    CORRADE_COMPARE(vertexInfo.pVertexAttributeDescriptions[0].location, 0);
+    CORRADE_COMPARE(vertexInfo.pVertexAttributeDescriptions[0].binding, 0);
+    CORRADE_COMPARE(vertexInfo.pVertexAttributeDescriptions[0].format, VK_FORMAT_R32G32B32_SFLOAT);
+    CORRADE_COMPARE(vertexInfo.pVertexAttributeDescriptions[1].location, 1);
+    CORRADE_COMPARE(vertexInfo.pVertexAttributeDescriptions[1].binding, 1);
+    CORRADE_COMPARE(vertexInfo.pVertexAttributeDescriptions[1].format, VK_FORMAT_R32G32_SFLOAT);
+}
+
+void CompileVkTest::nonIndexed() {
+    Containers::StridedArrayView1D<const Vertex> vertices = Vertices;
+    Trade::MeshData meshData{MeshPrimitive::Triangles, {}, Vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            vertices.slice(&Vertex::position)}
+    }};
+
+    Vk::Uploader uploader{device(), queue(), device().properties().pickQueueFamily(Vk::QueueFlag::Graphics), 4096};
+    Vk::Mesh mesh = compile(device(), uploader, meshData);
+    CORRADE_COMPARE(uploader.pendingCopyCount(), 1);
+    uploader.wait();
+
+    CORRADE_COMPARE(mesh.count(), 3);
+    CORRADE_VERIFY(!mesh.isIndexed());
+    CORRADE_COMPARE(mesh.vertexBuffers().size(), 1);
+    CORRADE_VERIFY(mesh.vertexBuffers()[0]);
+    CORRADE_COMPARE_AS(mesh.vertexBufferOffsets(), Containers::arrayView<UnsignedLong>({
+        0
+    }), TestSuite::Compare::Container);
+}
+
+void CompileVkTest::noData() {
+    Trade::MeshData meshData{MeshPrimitive::Triangles, 3};
+
+    Vk::Uploader uploader{device(), queue(), device().properties().pickQueueFamily(Vk::QueueFlag::Graphics), 4096};
+    Vk::Mesh mesh = compile(device(), uploader, meshData);
+    CORRADE_COMPARE(uploader.pendingCopyCount(), 0);
+
+    CORRADE_COMPARE(mesh.count(), 3);
+    CORRADE_VERIFY(!mesh.isIndexed());
+    CORRADE_COMPARE(mesh.vertexBuffers().size(), 0);
+}
+
+void CompileVkTest::ignoredAttributes() {
+    struct VertexWithIgnored {
+        Vector3 position;
+        Vector3 bitangent;
+        UnsignedInt objectId;
+        Float custom;
+    } vertexData[3]{};
+    Containers::StridedArrayView1D<const VertexWithIgnored> vertices = vertexData;
+    Trade::MeshData meshData{MeshPrimitive::Points, {}, vertexData, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            vertices.slice(&VertexWithIgnored::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Bitangent,
+            vertices.slice(&VertexWithIgnored::bitangent)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId,
+            vertices.slice(&VertexWithIgnored::objectId)},
+        Trade::MeshAttributeData{Trade::meshAttributeCustom(115),
+            vertices.slice(&VertexWithIgnored::custom)},
+    }};
+
+    Vk::Uploader uploader{device(), queue(), device().properties().pickQueueFamily(Vk::QueueFlag::Graphics), 4096};
+
+    std::ostringstream out;
+    Warning redirectWarning{&out};
+    Vk::Mesh mesh = compile(device(), uploader, meshData);
+    uploader.wait();
+    CORRADE_COMPARE(mesh.vertexBuffers().size(), 2);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::compile(): ignoring Trade::MeshAttribute::ObjectId 0 as its binding slot is already occupied by Trade::MeshAttribute::Bitangent 0\n"
+        "MeshTools::compile(): ignoring unknown/unsupported attribute Trade::MeshAttribute::Custom(115)\n");
+}
+
+void CompileVkTest::zeroStride() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData meshData{MeshPrimitive::Points, {}, Vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::StridedArrayView1D<const Vector3>{Vertices, &Vertices[0].position, 3, 0}}
+    }};
+
+    Vk::Uploader uploader{device(), queue(), device().properties().pickQueueFamily(Vk::QueueFlag::Graphics), 4096};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    compile(device(), uploader, meshData);
+    CORRADE_COMPARE(out.str(), "MeshTools::compile(): Trade::MeshAttribute::Position stride of 0 bytes isn't supported by Vulkan\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CompileVkTest)
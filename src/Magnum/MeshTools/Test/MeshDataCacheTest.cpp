@@ -0,0 +1,427 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/String.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Half.h"
+#include "Magnum/MeshTools/MeshDataCache.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct MeshDataCacheTest: TestSuite::Tester {
+    explicit MeshDataCacheTest();
+
+    void construct();
+    void constructMove();
+
+    void cached();
+    void cachedIdMorphTarget();
+
+    void invalidate();
+    void invalidateAttribute();
+    void invalidateIndices();
+
+    void notIndexed();
+    void attributeNotFound();
+};
+
+MeshDataCacheTest::MeshDataCacheTest() {
+    addTests({&MeshDataCacheTest::construct,
+              &MeshDataCacheTest::constructMove,
+
+              &MeshDataCacheTest::cached,
+              &MeshDataCacheTest::cachedIdMorphTarget,
+
+              &MeshDataCacheTest::invalidate,
+              &MeshDataCacheTest::invalidateAttribute,
+              &MeshDataCacheTest::invalidateIndices,
+
+              &MeshDataCacheTest::notIndexed,
+              &MeshDataCacheTest::attributeNotFound});
+}
+
+struct Vertex {
+    Vector2us position;
+    Vector4b tangent;
+    Vector3h normal;
+    Color3ub color;
+    UnsignedShort objectId;
+    Vector2s textureCoordinates;
+    Vector3 positionMorphed;
+};
+
+void MeshDataCacheTest::construct() {
+    Trade::MeshData mesh{MeshPrimitive::Points, 5};
+
+    MeshDataCache cache{mesh};
+    CORRADE_COMPARE(&cache.mesh(), &mesh);
+    CORRADE_COMPARE(cache.cachedCount(), 0);
+}
+
+void MeshDataCacheTest::constructMove() {
+    const Vector2 positions[]{{1.0f, 2.0f}, {3.0f, 4.0f}};
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+    }};
+    Trade::MeshData another{MeshPrimitive::Points, 5};
+
+    MeshDataCache a{mesh};
+    Containers::ArrayView<const Vector3> positions3D = a.positions3D();
+    CORRADE_COMPARE(a.cachedCount(), 1);
+
+    /* The cached data should be transferred as well, not copied */
+    MeshDataCache b{Utility::move(a)};
+    CORRADE_COMPARE(&b.mesh(), &mesh);
+    CORRADE_COMPARE(b.cachedCount(), 1);
+    CORRADE_COMPARE(b.positions3D().data(), positions3D.data());
+
+    MeshDataCache c{another};
+    c = Utility::move(b);
+    CORRADE_COMPARE(&c.mesh(), &mesh);
+    CORRADE_COMPARE(c.cachedCount(), 1);
+    CORRADE_COMPARE(c.positions3D().data(), positions3D.data());
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<MeshDataCache>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<MeshDataCache>::value);
+}
+
+void MeshDataCacheTest::cached() {
+    const UnsignedByte indices[]{2, 0, 1, 1};
+    const Vertex vertices[]{
+        {{1, 2}, {127, 0, 0, -127}, {0.0_h, 1.0_h, 0.0_h}, 0xff3366_rgb, 15, {-32767, 32767}, {}},
+        {{3, 4}, {0, 127, 0, 127}, {1.0_h, 0.0_h, 0.0_h}, 0x3366ff_rgb, 27, {32767, 0}, {}},
+        {{5, 6}, {0, 0, 127, 127}, {0.0_h, 0.0_h, 1.0_h}, 0x66ff33_rgb, 3, {0, -32767}, {}},
+    };
+    Containers::StridedArrayView1D<const Vertex> view = vertices;
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, vertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, view.slice(&Vertex::position)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Tangent, VertexFormat::Vector4bNormalized, view.slice(&Vertex::tangent)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Bitangent, VertexFormat::Vector3bNormalized, view.slice(&Vertex::tangent)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal, view.slice(&Vertex::normal)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, VertexFormat::Vector2sNormalized, view.slice(&Vertex::textureCoordinates)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Color, VertexFormat::Vector3ubNormalized, view.slice(&Vertex::color)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId, view.slice(&Vertex::objectId)},
+        }};
+
+    MeshDataCache cache{mesh};
+
+    /* Converted on first access */
+    Containers::ArrayView<const UnsignedInt> indices1 = cache.indices();
+    CORRADE_COMPARE_AS(indices1, Containers::arrayView<UnsignedInt>({
+        2, 0, 1, 1
+    }), TestSuite::Compare::Container);
+    Containers::ArrayView<const Vector2> positions2D1 = cache.positions2D();
+    CORRADE_COMPARE_AS(positions2D1, Containers::arrayView<Vector2>({
+        {1.0f, 2.0f}, {3.0f, 4.0f}, {5.0f, 6.0f}
+    }), TestSuite::Compare::Container);
+    Containers::ArrayView<const Vector3> positions3D1 = cache.positions3D();
+    CORRADE_COMPARE_AS(positions3D1, Containers::arrayView<Vector3>({
+        {1.0f, 2.0f, 0.0f}, {3.0f, 4.0f, 0.0f}, {5.0f, 6.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+    Containers::ArrayView<const Vector3> tangents1 = cache.tangents();
+    CORRADE_COMPARE_AS(tangents1, Containers::arrayView<Vector3>({
+        {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}
+    }), TestSuite::Compare::Container);
+    Containers::ArrayView<const Float> bitangentSigns1 = cache.bitangentSigns();
+    CORRADE_COMPARE_AS(bitangentSigns1, Containers::arrayView<Float>({
+        -1.0f, 1.0f, 1.0f
+    }), TestSuite::Compare::Container);
+    Containers::ArrayView<const Vector3> bitangents1 = cache.bitangents();
+    CORRADE_COMPARE_AS(bitangents1, Containers::arrayView<Vector3>({
+        {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}
+    }), TestSuite::Compare::Container);
+    Containers::ArrayView<const Vector3> normals1 = cache.normals();
+    CORRADE_COMPARE_AS(normals1, Containers::arrayView<Vector3>({
+        {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}
+    }), TestSuite::Compare::Container);
+    Containers::ArrayView<const Vector2> textureCoordinates1 = cache.textureCoordinates2D();
+    CORRADE_COMPARE_AS(textureCoordinates1, Containers::arrayView<Vector2>({
+        {-1.0f, 1.0f}, {1.0f, 0.0f}, {0.0f, -1.0f}
+    }), TestSuite::Compare::Container);
+    Containers::ArrayView<const Color4> colors1 = cache.colors();
+    CORRADE_COMPARE_AS(colors1, Containers::arrayView<Color4>({
+        0xff3366ff_rgbaf, 0x3366ffff_rgbaf, 0x66ff33ff_rgbaf
+    }), TestSuite::Compare::Container);
+    Containers::ArrayView<const UnsignedInt> objectIds1 = cache.objectIds();
+    CORRADE_COMPARE_AS(objectIds1, Containers::arrayView<UnsignedInt>({
+        15, 27, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(cache.cachedCount(), 10);
+
+    /* Second access returns the same memory, without converting again. The
+       views should be still valid even though the internal storage got
+       reallocated several times meanwhile. */
+    CORRADE_COMPARE(cache.indices().data(), indices1.data());
+    CORRADE_COMPARE(cache.positions2D().data(), positions2D1.data());
+    CORRADE_COMPARE(cache.positions3D().data(), positions3D1.data());
+    CORRADE_COMPARE(cache.tangents().data(), tangents1.data());
+    CORRADE_COMPARE(cache.bitangentSigns().data(), bitangentSigns1.data());
+    CORRADE_COMPARE(cache.bitangents().data(), bitangents1.data());
+    CORRADE_COMPARE(cache.normals().data(), normals1.data());
+    CORRADE_COMPARE(cache.textureCoordinates2D().data(), textureCoordinates1.data());
+    CORRADE_COMPARE(cache.colors().data(), colors1.data());
+    CORRADE_COMPARE(cache.objectIds().data(), objectIds1.data());
+    CORRADE_COMPARE(cache.cachedCount(), 10);
+    CORRADE_COMPARE_AS(cache.positions2D(), Containers::arrayView<Vector2>({
+        {1.0f, 2.0f}, {3.0f, 4.0f}, {5.0f, 6.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void MeshDataCacheTest::cachedIdMorphTarget() {
+    const Vertex vertices[]{
+        {{1, 2}, {}, {}, {}, {}, {}, {7.0f, 8.0f, 9.0f}},
+        {{3, 4}, {}, {}, {}, {}, {}, {1.5f, 2.5f, 3.5f}}
+    };
+    Containers::StridedArrayView1D<const Vertex> view = vertices;
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, view.slice(&Vertex::positionMorphed)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, view.slice(&Vertex::positionMorphed), 37},
+    }};
+
+    MeshDataCache cache{mesh};
+    Containers::ArrayView<const Vector3> positions0 = cache.positions3D();
+    Containers::ArrayView<const Vector3> positions1 = cache.positions3D(1);
+    Containers::ArrayView<const Vector3> positionsMorphed = cache.positions3D(0, 37);
+    CORRADE_COMPARE(cache.cachedCount(), 3);
+
+    /* Each ID / morph target combination is a separate entry */
+    CORRADE_VERIFY(positions0.data() != positions1.data());
+    CORRADE_VERIFY(positions1.data() != positionsMorphed.data());
+    CORRADE_COMPARE_AS(positions0, Containers::arrayView<Vector3>({
+        {1.0f, 2.0f, 0.0f}, {3.0f, 4.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(positions1, Containers::arrayView<Vector3>({
+        {7.0f, 8.0f, 9.0f}, {1.5f, 2.5f, 3.5f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(positionsMorphed, Containers::arrayView<Vector3>({
+        {7.0f, 8.0f, 9.0f}, {1.5f, 2.5f, 3.5f}
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(cache.positions3D(1).data(), positions1.data());
+    CORRADE_COMPARE(cache.positions3D(0, 37).data(), positionsMorphed.data());
+    CORRADE_COMPARE(cache.cachedCount(), 3);
+}
+
+void MeshDataCacheTest::invalidate() {
+    const UnsignedShort indices[]{1, 0};
+    const Vector2 positions[]{{1.0f, 2.0f}, {3.0f, 4.0f}};
+    Trade::MeshData mesh{MeshPrimitive::Lines,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+        }};
+
+    MeshDataCache cache{mesh};
+    cache.indices();
+    cache.positions2D();
+    cache.positions3D();
+    CORRADE_COMPARE(cache.cachedCount(), 3);
+
+    MeshDataCache& out = cache.invalidate();
+    CORRADE_COMPARE(&out, &cache);
+    CORRADE_COMPARE(cache.cachedCount(), 0);
+
+    /* Converts again */
+    CORRADE_COMPARE_AS(cache.positions2D(), Containers::arrayView(positions),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(cache.cachedCount(), 1);
+}
+
+void MeshDataCacheTest::invalidateAttribute() {
+    UnsignedShort indices[]{1, 0};
+    Vertex vertices[]{
+        {{1, 2}, {127, 0, 0, -127}, {0.0_h, 1.0_h, 0.0_h}, {}, {}, {}, {}},
+        {{3, 4}, {0, 127, 0, 127}, {1.0_h, 0.0_h, 0.0_h}, {}, {}, {}, {}}
+    };
+    Containers::StridedArrayView1D<Vertex> view = vertices;
+    Trade::MeshData mesh{MeshPrimitive::Lines,
+        Trade::DataFlag::Mutable, indices, Trade::MeshIndexData{indices},
+        Trade::DataFlag::Mutable, vertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, view.slice(&Vertex::position)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, view.slice(&Vertex::positionMorphed), 37},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Tangent, VertexFormat::Vector4bNormalized, view.slice(&Vertex::tangent)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal, view.slice(&Vertex::normal)},
+        }};
+
+    MeshDataCache cache{mesh};
+    cache.indices();
+    cache.positions2D();
+    cache.positions3D();
+    cache.positions3D(0, 37);
+    cache.tangents();
+    cache.bitangentSigns();
+    Containers::ArrayView<const Vector3> normals = cache.normals();
+    CORRADE_COMPARE(cache.cachedCount(), 7);
+
+    /* Modify the data, the cache doesn't know about that */
+    mesh.mutableAttribute<Vector2us>(Trade::MeshAttribute::Position)[1] = {5, 6};
+    mesh.mutableAttribute<Vector4b>(Trade::MeshAttribute::Tangent)[0] = {0, 0, 127, 127};
+    CORRADE_COMPARE(cache.positions2D()[1], (Vector2{3.0f, 4.0f}));
+    CORRADE_COMPARE(cache.tangents()[0], (Vector3{1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(cache.bitangentSigns()[0], -1.0f);
+
+    /* Invalidating positions removes all position conversions including
+       morph targets but leaves the others */
+    cache.invalidate(Trade::MeshAttribute::Position);
+    CORRADE_COMPARE(cache.cachedCount(), 4);
+    CORRADE_COMPARE_AS(cache.positions2D(), Containers::arrayView<Vector2>({
+        {1.0f, 2.0f}, {5.0f, 6.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(cache.cachedCount(), 5);
+
+    /* Invalidating tangents removes bitangent signs as well */
+    MeshDataCache& out = cache.invalidate(Trade::MeshAttribute::Tangent);
+    CORRADE_COMPARE(&out, &cache);
+    CORRADE_COMPARE(cache.cachedCount(), 3);
+    CORRADE_COMPARE(cache.tangents()[0], (Vector3{0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(cache.bitangentSigns()[0], 1.0f);
+    CORRADE_COMPARE(cache.cachedCount(), 5);
+
+    /* Invalidating an attribute that isn't cached does nothing */
+    cache.invalidate(Trade::MeshAttribute::Color);
+    CORRADE_COMPARE(cache.cachedCount(), 5);
+
+    /* The untouched entries stay the same */
+    CORRADE_COMPARE(cache.normals().data(), normals.data());
+    CORRADE_COMPARE(cache.cachedCount(), 5);
+}
+
+void MeshDataCacheTest::invalidateIndices() {
+    UnsignedShort indices[]{1, 0};
+    const Vector2 positions[]{{1.0f, 2.0f}, {3.0f, 4.0f}};
+    Trade::MeshData mesh{MeshPrimitive::Lines,
+        Trade::DataFlag::Mutable, indices, Trade::MeshIndexData{indices},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+        }};
+
+    MeshDataCache cache{mesh};
+    cache.indices();
+    Containers::ArrayView<const Vector2> positions2D = cache.positions2D();
+    CORRADE_COMPARE(cache.cachedCount(), 2);
+
+    mesh.mutableIndices<UnsignedShort>()[0] = 0;
+    CORRADE_COMPARE_AS(cache.indices(), Containers::arrayView<UnsignedInt>({
+        1, 0
+    }), TestSuite::Compare::Container);
+
+    MeshDataCache& out = cache.invalidateIndices();
+    CORRADE_COMPARE(&out, &cache);
+    CORRADE_COMPARE(cache.cachedCount(), 1);
+    CORRADE_COMPARE_AS(cache.indices(), Containers::arrayView<UnsignedInt>({
+        0, 0
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(cache.positions2D().data(), positions2D.data());
+    CORRADE_COMPARE(cache.cachedCount(), 2);
+}
+
+void MeshDataCacheTest::notIndexed() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData mesh{MeshPrimitive::Points, 5};
+
+    MeshDataCache cache{mesh};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.indices();
+    CORRADE_COMPARE(out.str(), "MeshTools::MeshDataCache::indices(): the mesh is not indexed\n");
+    CORRADE_COMPARE(cache.cachedCount(), 0);
+}
+
+void MeshDataCacheTest::attributeNotFound() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Vertex vertices[2]{};
+    Containers::StridedArrayView1D<const Vertex> view = vertices;
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, view.slice(&Vertex::positionMorphed), 37},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Tangent, VertexFormat::Vector4bNormalized, view.slice(&Vertex::tangent)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal, view.slice(&Vertex::normal)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Color, VertexFormat::Vector3ubNormalized, view.slice(&Vertex::color)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId, view.slice(&Vertex::objectId)},
+    }};
+
+    MeshDataCache cache{mesh};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.positions2D(1);
+    cache.positions2D(1, 37);
+    cache.positions3D(1);
+    cache.positions3D(1, 37);
+    cache.tangents(1);
+    cache.tangents(0, 37);
+    cache.bitangentSigns(1);
+    cache.bitangentSigns(0, 37);
+    cache.bitangents();
+    cache.bitangents(0, 37);
+    cache.normals(1);
+    cache.normals(0, 37);
+    cache.textureCoordinates2D();
+    cache.textureCoordinates2D(0, 37);
+    cache.colors(1);
+    cache.colors(0, 37);
+    cache.objectIds(1);
+    CORRADE_COMPARE_AS(out.str(),
+        "MeshTools::MeshDataCache::positions2D(): index 1 out of range for 1 position attributes\n"
+        "MeshTools::MeshDataCache::positions2D(): index 1 out of range for 1 position attributes in morph target 37\n"
+        "MeshTools::MeshDataCache::positions3D(): index 1 out of range for 1 position attributes\n"
+        "MeshTools::MeshDataCache::positions3D(): index 1 out of range for 1 position attributes in morph target 37\n"
+        "MeshTools::MeshDataCache::tangents(): index 1 out of range for 1 tangent attributes\n"
+        "MeshTools::MeshDataCache::tangents(): index 0 out of range for 0 tangent attributes in morph target 37\n"
+        "MeshTools::MeshDataCache::bitangentSigns(): index 1 out of range for 1 tangent attributes\n"
+        "MeshTools::MeshDataCache::bitangentSigns(): index 0 out of range for 0 tangent attributes in morph target 37\n"
+        "MeshTools::MeshDataCache::bitangents(): index 0 out of range for 0 bitangent attributes\n"
+        "MeshTools::MeshDataCache::bitangents(): index 0 out of range for 0 bitangent attributes in morph target 37\n"
+        "MeshTools::MeshDataCache::normals(): index 1 out of range for 1 normal attributes\n"
+        "MeshTools::MeshDataCache::normals(): index 0 out of range for 0 normal attributes in morph target 37\n"
+        "MeshTools::MeshDataCache::textureCoordinates2D(): index 0 out of range for 0 texture coordinate attributes\n"
+        "MeshTools::MeshDataCache::textureCoordinates2D(): index 0 out of range for 0 texture coordinate attributes in morph target 37\n"
+        "MeshTools::MeshDataCache::colors(): index 1 out of range for 1 color attributes\n"
+        "MeshTools::MeshDataCache::colors(): index 0 out of range for 0 color attributes in morph target 37\n"
+        "MeshTools::MeshDataCache::objectIds(): index 1 out of range for 1 object ID attributes\n",
+        TestSuite::Compare::String);
+
+    /* Nothing got cached for the failed accesses */
+    CORRADE_COMPARE(cache.cachedCount(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::MeshDataCacheTest)
@@ -132,11 +132,11 @@ class Resource {
          * Creates empty resource. Resources are acquired from the manager by
          * calling @ref ResourceManager::get().
          */
-        explicit Resource(): _manager{nullptr}, _lastCheck{0}, _state{ResourceState::Final}, _data{nullptr} {}
+        explicit Resource(): _manager{nullptr}, _slot{0}, _generation{0}, _lastCheck{0}, _state{ResourceState::Final}, _data{nullptr} {}
 
         /** @brief Copy constructor */
-        Resource(const Resource<T, U>& other): _manager{other._manager}, _key{other._key}, _lastCheck{other._lastCheck}, _state{other._state}, _data{other._data} {
-            if(_manager) _manager->incrementReferenceCount(_key);
+        Resource(const Resource<T, U>& other): _manager{other._manager}, _key{other._key}, _slot{other._slot}, _generation{other._generation}, _lastCheck{other._lastCheck}, _state{other._state}, _data{other._data} {
+            if(_manager) _manager->incrementReferenceCount(_slot);
         }
 
         /** @brief Move constructor */
@@ -144,7 +144,7 @@ class Resource {
 
         /** @brief Destructor */
         ~Resource() {
-            if(_manager) _manager->decrementReferenceCount(_key);
+            if(_manager) _manager->decrementReferenceCount(_slot, _generation);
         }
 
         /** @brief Copy assignment */
@@ -236,35 +236,40 @@ class Resource {
         friend Implementation::ResourceManagerData<T>;
         #endif
 
-        Resource(Implementation::ResourceManagerData<T>* manager, ResourceKey key): _manager{manager}, _key{key}, _lastCheck{0}, _state{ResourceState::NotLoaded}, _data{nullptr} {
-            manager->incrementReferenceCount(key);
-        }
+        Resource(Implementation::ResourceManagerData<T>* manager, ResourceKey key, UnsignedInt slot);
 
         void acquire();
 
         Implementation::ResourceManagerData<T>* _manager;
         ResourceKey _key;
+        /* Slot in the manager storage and its generation, to detect the slot
+           being reused for something else */
+        UnsignedInt _slot, _generation;
         std::size_t _lastCheck;
         ResourceState _state;
         T* _data;
 };
 
 template<class T, class U> Resource<T, U>& Resource<T, U>::operator=(const Resource<T, U>& other) {
-    if(_manager) _manager->decrementReferenceCount(_key);
+    if(_manager) _manager->decrementReferenceCount(_slot, _generation);
 
     _manager = other._manager;
     _key = other._key;
+    _slot = other._slot;
+    _generation = other._generation;
     _lastCheck = other._lastCheck;
     _state = other._state;
     _data = other._data;
 
-    if(_manager) _manager->incrementReferenceCount(_key);
+    if(_manager) _manager->incrementReferenceCount(_slot);
     return *this;
 }
 
-template<class T, class U> Resource<T, U>::Resource(Resource<T, U>&& other) noexcept: _manager(other._manager), _key(other._key), _lastCheck(other._lastCheck), _state(other._state), _data(other._data) {
+template<class T, class U> Resource<T, U>::Resource(Resource<T, U>&& other) noexcept: _manager(other._manager), _key(other._key), _slot(other._slot), _generation(other._generation), _lastCheck(other._lastCheck), _state(other._state), _data(other._data) {
     other._manager = nullptr;
     other._key = {};
+    other._slot = 0;
+    other._generation = 0;
     other._lastCheck = 0;
     other._state = ResourceState::Final;
     other._data = nullptr;
@@ -274,26 +279,36 @@ template<class T, class U> Resource<T, U>& Resource<T, U>::operator=(Resource<T,
     using std::swap;
     swap(_manager, other._manager);
     swap(_key, other._key);
+    swap(_slot, other._slot);
+    swap(_generation, other._generation);
     swap(_lastCheck, other._lastCheck);
     swap(_state, other._state);
     swap(_data, other._data);
     return *this;
 }
 
+template<class T, class U> Resource<T, U>::Resource(Implementation::ResourceManagerData<T>* manager, ResourceKey key, UnsignedInt slot): _manager{manager}, _key{key}, _slot{slot}, _generation{manager->_slots[slot].generation}, _lastCheck{0}, _state{ResourceState::NotLoaded}, _data{nullptr} {
+    manager->incrementReferenceCount(slot);
+}
+
 template<class T, class U> void Resource<T, U>::acquire() {
     /* The data are already final, nothing to do */
     if(_state == ResourceState::Final) return;
 
-    /* Nothing changed since last check */
-    if(_manager->lastChange() <= _lastCheck) return;
+    /* Nothing changed for this particular resource or the fallback since
+       last check. The slot can be gone only if the manager was cleared while
+       the resource was still referenced, in which case it's treated as not
+       loaded. */
+    const typename Implementation::ResourceManagerData<T>::Data* const d = _manager->data(_slot, _generation);
+    if(d && d->lastChange <= _lastCheck && _manager->_fallbackChange <= _lastCheck)
+        return;
 
-    /* Acquire new data and save last check time */
-    const typename Implementation::ResourceManagerData<T>::Data& d = _manager->data(_key);
+    /* Save last check time */
     _lastCheck = _manager->lastChange();
 
     /* Try to get the data */
-    _data = d.data;
-    _state = static_cast<ResourceState>(d.state);
+    _data = d ? d->data : nullptr;
+    _state = d ? static_cast<ResourceState>(d->state) : ResourceState::NotLoaded;
 
     /* Data are not available */
     if(!_data) {
@@ -29,7 +29,7 @@
  * @brief Class @ref Magnum::ResourceManager, @ref Magnum::ResourceDataState, @ref Magnum::ResourcePolicy
  */
 
-#include <unordered_map>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Resource.h"
@@ -110,7 +110,7 @@ template<class T> class ResourceManagerData {
 
         std::size_t lastChange() const { return _lastChange; }
 
-        std::size_t count() const { return _data.size(); }
+        std::size_t count() const { return _slots.size() - _freeSlots.size(); }
 
         std::size_t referenceCount(ResourceKey key) const;
 
@@ -127,7 +127,7 @@ template<class T> class ResourceManagerData {
 
         void free();
 
-        void clear() { _data.clear(); }
+        void clear();
 
         AbstractResourceLoader<T>* loader() { return _loader; }
         const AbstractResourceLoader<T>* loader() const { return _loader; }
@@ -136,24 +136,54 @@ template<class T> class ResourceManagerData {
 
         void setLoader(AbstractResourceLoader<T>* loader);
 
+        std::size_t update(std::size_t maxCount);
+
     protected:
-        ResourceManagerData(): _fallback(nullptr), _loader(nullptr), _lastChange(0) {}
+        ResourceManagerData(): _fallback(nullptr), _loader(nullptr), _lastChange(0), _fallbackChange(0) {}
 
     private:
         struct Data;
 
-        const Data& data(ResourceKey key) { return _data[key]; }
+        enum: UnsignedInt { NoSlot = ~UnsignedInt{} };
 
-        void incrementReferenceCount(ResourceKey key) {
-            ++_data[key].referenceCount;
+        static std::size_t hash(ResourceKey key) {
+            return std::hash<ResourceKey>{}(key);
         }
 
-        void decrementReferenceCount(ResourceKey key);
+        /* Slot for given key or NoSlot if there's no such key */
+        UnsignedInt find(ResourceKey key) const;
+
+        /* Slot for given key, adds a new one if there's no such key */
+        UnsignedInt findOrInsert(ResourceKey key);
+
+        /* Removes the slot from the index and puts it to the free list,
+           incrementing its generation */
+        void erase(UnsignedInt slot);
+
+        /* Slot data or nullptr if the slot got erased in the meantime */
+        const Data* data(UnsignedInt slot, UnsignedInt generation) const;
+
+        void incrementReferenceCount(UnsignedInt slot) {
+            ++_slots[slot].referenceCount;
+        }
 
-        std::unordered_map<ResourceKey, Data> _data;
+        void decrementReferenceCount(UnsignedInt slot, UnsignedInt generation);
+
+        /* Flat slot storage. Slot indices are stable for the lifetime of the
+           resource, freed slots get reused with an incremented generation
+           counter. */
+        Containers::Array<Data> _slots;
+        Containers::Array<UnsignedInt> _freeSlots;
+        /* Open-addressing hash table with linear probing, mapping keys to
+           slots. Stores slot index + 1, zero denotes an empty entry. Size is
+           always a power of two. */
+        Containers::Array<UnsignedInt> _index;
         T* _fallback;
         AbstractResourceLoader<T>* _loader;
-        std::size_t _lastChange;
+        /* Incremented on every change, each slot remembers the value of its
+           last change so resources can skip refreshing if only unrelated
+           resources changed */
+        std::size_t _lastChange, _fallbackChange;
 };
 
 /* Helper class for defining which real types are in the type pack */
@@ -218,6 +248,18 @@ Basic usage is:
 </li>
 </ul>
 
+@section ResourceManager-performance Performance considerations
+
+Resources of each type are stored in a flat array of slots, with keys mapped
+to slots through an open-addressing hash table. A slot stays the same for the
+whole lifetime of a resource, and each @ref Resource instance remembers it
+together with a generation counter that's incremented every time a slot is
+freed. Accessing a mutable resource thus involves just a bounds and a
+generation check followed by a comparison with the slot change counter, and
+the data are refreshed only if that particular resource or the fallback
+changed. A hash table lookup is done only in @ref get(), @ref set() and
+@ref state().
+
 @see @ref AbstractResourceLoader
 */
 /* Due to too much work involved with explicit template instantiation (all
@@ -431,7 +473,45 @@ template<class... Types> class ResourceManager: private Implementation::Resource
             return setLoader(loader.release());
         }
 
+        /**
+         * @brief Process results of asynchronous loading for given type
+         * @param maxCount  Max count of results to process
+         * @return Count of processed results
+         * @m_since_latest
+         *
+         * Passes at most @p maxCount resources loaded on worker threads of
+         * the loader for given type to the manager, updating their state
+         * from @ref ResourceState::Loading. Should be called on the main
+         * thread, for example once each frame. If there's no loader or it
+         * has no worker threads, does nothing. See
+         * @ref AbstractResourceLoader-async for more information.
+         */
+        template<class T> std::size_t update(std::size_t maxCount = ~std::size_t{}) {
+            return this->Implementation::ResourceManagerData<T>::update(maxCount);
+        }
+
+        /**
+         * @brief Process results of asynchronous loading for all types
+         * @param maxCount  Max count of results to process, shared among all
+         *      types
+         * @return Count of processed results
+         * @m_since_latest
+         *
+         * Calls @ref update(std::size_t) for all types in the order they're
+         * specified in the template parameter list until @p maxCount results
+         * are processed.
+         */
+        std::size_t update(std::size_t maxCount = ~std::size_t{}) {
+            return updateInternal(Implementation::ResourceTypePack<Types...>{}, maxCount);
+        }
+
     private:
+        template<class FirstType, class ...NextTypes> std::size_t updateInternal(Implementation::ResourceTypePack<FirstType, NextTypes...>, std::size_t maxCount) {
+            const std::size_t count = update<FirstType>(maxCount);
+            return count + updateInternal(Implementation::ResourceTypePack<NextTypes...>{}, maxCount - count);
+        }
+        std::size_t updateInternal(Implementation::ResourceTypePack<>, std::size_t) { return 0; }
+
         template<class FirstType, class ...NextTypes> void freeInternal(Implementation::ResourceTypePack<FirstType, NextTypes...>) {
             free<FirstType>();
             freeInternal(Implementation::ResourceTypePack<NextTypes...>{});
@@ -463,65 +543,160 @@ template<class T> ResourceManagerData<T>::~ResourceManagerData() {
     safeDelete(_fallback);
 }
 
+template<class T> UnsignedInt ResourceManagerData<T>::find(const ResourceKey key) const {
+    if(_index.isEmpty()) return NoSlot;
+
+    const std::size_t mask = _index.size() - 1;
+    for(std::size_t i = hash(key) & mask; _index[i]; i = (i + 1) & mask)
+        if(_slots[_index[i] - 1].key == key) return _index[i] - 1;
+
+    return NoSlot;
+}
+
+template<class T> UnsignedInt ResourceManagerData<T>::findOrInsert(const ResourceKey key) {
+    const UnsignedInt found = find(key);
+    if(found != NoSlot) return found;
+
+    /* Grow the index if it'd get more than 3/4 full, reinserting all used
+       slots */
+    const std::size_t newCount = count() + 1;
+    if(newCount*4 > _index.size()*3) {
+        Containers::Array<UnsignedInt> index{ValueInit, _index.isEmpty() ? 16 : _index.size()*2};
+        const std::size_t mask = index.size() - 1;
+        for(UnsignedInt slot: _index) if(slot) {
+            std::size_t i = hash(_slots[slot - 1].key) & mask;
+            while(index[i]) i = (i + 1) & mask;
+            index[i] = slot;
+        }
+        _index = Utility::move(index);
+    }
+
+    /* Reuse a free slot or add a new one */
+    UnsignedInt slot;
+    if(!_freeSlots.isEmpty()) {
+        slot = _freeSlots.back();
+        arrayRemoveSuffix(_freeSlots, 1);
+    } else {
+        slot = _slots.size();
+        arrayAppend(_slots, InPlaceInit);
+    }
+    _slots[slot].key = key;
+    _slots[slot].used = true;
+
+    const std::size_t mask = _index.size() - 1;
+    std::size_t i = hash(key) & mask;
+    while(_index[i]) i = (i + 1) & mask;
+    _index[i] = slot + 1;
+
+    return slot;
+}
+
+template<class T> void ResourceManagerData<T>::erase(const UnsignedInt slot) {
+    Data& d = _slots[slot];
+
+    /* Remove from the index, shifting subsequent entries of the same probe
+       sequence back to not need any tombstones */
+    const std::size_t mask = _index.size() - 1;
+    std::size_t i = hash(d.key) & mask;
+    while(_index[i] != slot + 1) i = (i + 1) & mask;
+    for(;;) {
+        _index[i] = 0;
+        std::size_t j = i;
+        for(;;) {
+            j = (j + 1) & mask;
+            if(!_index[j]) break;
+
+            /* If the entry's ideal position is cyclically in (i, j], it's
+               fine where it is */
+            const std::size_t home = hash(_slots[_index[j] - 1].key) & mask;
+            if(i <= j ? (i < home && home <= j) : (i < home || home <= j))
+                continue;
+
+            break;
+        }
+        if(!_index[j]) break;
+
+        _index[i] = _index[j];
+        i = j;
+    }
+
+    /* Delete the data and put the slot to the free list */
+    d.destroy();
+    d.key = {};
+    d.data = nullptr;
+    d.state = ResourceDataState::Mutable;
+    d.policy = ResourcePolicy::Manual;
+    d.referenceCount = 0;
+    d.lastChange = 0;
+    d.used = false;
+    ++d.generation;
+    arrayAppend(_freeSlots, slot);
+}
+
+template<class T> auto ResourceManagerData<T>::data(const UnsignedInt slot, const UnsignedInt generation) const -> const Data* {
+    if(slot >= _slots.size() || _slots[slot].generation != generation)
+        return nullptr;
+    return &_slots[slot];
+}
+
 template<class T> std::size_t ResourceManagerData<T>::referenceCount(const ResourceKey key) const {
-    auto it = _data.find(key);
-    if(it == _data.end()) return 0;
-    return it->second.referenceCount;
+    const UnsignedInt slot = find(key);
+    if(slot == NoSlot) return 0;
+    return _slots[slot].referenceCount;
 }
 
 template<class T> ResourceState ResourceManagerData<T>::state(const ResourceKey key) const {
-    const auto it = _data.find(key);
+    const UnsignedInt slot = find(key);
+    const Data* const d = slot == NoSlot ? nullptr : &_slots[slot];
 
     /* Resource not loaded */
-    if(it == _data.end() || !it->second.data) {
+    if(!d || !d->data) {
         /* Fallback found, add *Fallback to state */
         if(_fallback) {
-            if(it != _data.end() && it->second.state == ResourceDataState::Loading)
+            if(d && d->state == ResourceDataState::Loading)
                 return ResourceState::LoadingFallback;
-            else if(it != _data.end() && it->second.state == ResourceDataState::NotFound)
+            else if(d && d->state == ResourceDataState::NotFound)
                 return ResourceState::NotFoundFallback;
             else return ResourceState::NotLoadedFallback;
         }
 
         /* Fallback not found, loading didn't start yet */
-        if(it == _data.end() || (it->second.state != ResourceDataState::Loading && it->second.state != ResourceDataState::NotFound))
+        if(!d || (d->state != ResourceDataState::Loading && d->state != ResourceDataState::NotFound))
             return ResourceState::NotLoaded;
     }
 
     /* Loading / NotFound without fallback, Mutable / Final */
-    return static_cast<ResourceState>(it->second.state);
+    return static_cast<ResourceState>(d->state);
 }
 
 template<class T> template<class U> Resource<T, U> ResourceManagerData<T>::get(ResourceKey key) {
     /* Ask loader for the data, if they aren't there yet */
-    if(_loader && _data.find(key) == _data.end())
+    if(_loader && find(key) == NoSlot)
         _loader->load(key);
 
-    return Resource<T, U>(this, key);
+    return Resource<T, U>(this, key, findOrInsert(key));
 }
 
 template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* const data, const ResourceDataState state, const ResourcePolicy policy) {
-    auto it = _data.find(key);
+    const UnsignedInt found = find(key);
 
     /* NotFound / Loading state shouldn't have any data */
     CORRADE_ASSERT((data == nullptr) == (state == ResourceDataState::NotFound || state == ResourceDataState::Loading),
         "ResourceManager::set(): data should be null if and only if state is NotFound or Loading", );
 
     /* Cannot change resource with already final state */
-    CORRADE_ASSERT(it == _data.end() || it->second.state != ResourceDataState::Final,
+    CORRADE_ASSERT(found == NoSlot || _slots[found].state != ResourceDataState::Final,
         "ResourceManager::set(): cannot change already final resource" << key, );
 
-    /* Insert the resource, if not already there */
-    if(it == _data.end())
-        it = _data.emplace(key, Data()).first;
-
-    /* Otherwise delete previous data */
-    else safeDelete(it->second.data);
+    /* Insert the resource, if not already there, otherwise delete previous
+       data */
+    Data& d = _slots[found == NoSlot ? findOrInsert(key) : found];
+    safeDelete(d.data);
 
-    it->second.data = data;
-    it->second.state = state;
-    it->second.policy = policy;
-    ++_lastChange;
+    d.data = data;
+    d.state = state;
+    d.policy = policy;
+    d.lastChange = ++_lastChange;
 }
 
 template<class T> void ResourceManagerData<T>::setFallback(T* const data) {
@@ -529,20 +704,27 @@ template<class T> void ResourceManagerData<T>::setFallback(T* const data) {
     _fallback = data;
     /* Notify resources also in this case, as some of them could go from empty
        to a fallback (or from a fallback to empty) */
-    ++_lastChange;
+    _fallbackChange = ++_lastChange;
 }
 
 template<class T> void ResourceManagerData<T>::free() {
     /* Delete all non-referenced non-resident resources */
-    for(auto it = _data.begin(); it != _data.end(); ) {
-        if(it->second.policy != ResourcePolicy::Resident && !it->second.referenceCount)
-            it = _data.erase(it);
-        else ++it;
+    for(UnsignedInt i = 0; i != _slots.size(); ++i) {
+        const Data& d = _slots[i];
+        if(d.used && d.policy != ResourcePolicy::Resident && !d.referenceCount)
+            erase(i);
     }
 }
 
+template<class T> void ResourceManagerData<T>::clear() {
+    for(UnsignedInt i = 0; i != _slots.size(); ++i)
+        if(_slots[i].used) erase(i);
+}
+
 template<class T> void ResourceManagerData<T>::setLoader(AbstractResourceLoader<T>* const loader) {
-    /* Delete previous loader */
+    /* Delete previous loader, stopping its worker threads first so they
+       don't call into a partially destroyed instance */
+    if(_loader) _loader->setWorkerThreadCount(0);
     delete _loader;
 
     /* Add new loader */
@@ -552,41 +734,57 @@ template<class T> void ResourceManagerData<T>::setLoader(AbstractResourceLoader<
 template<class T> void ResourceManagerData<T>::freeLoader() {
     if(!_loader) return;
 
+    /* Stop the worker threads while the manager is still around so the
+       results of in-flight loads can be passed to it */
+    _loader->setWorkerThreadCount(0);
     _loader->manager = nullptr;
     delete _loader;
 }
 
-template<class T> void ResourceManagerData<T>::decrementReferenceCount(ResourceKey key) {
-    auto it = _data.find(key);
-    CORRADE_INTERNAL_ASSERT(it != _data.end());
+template<class T> std::size_t ResourceManagerData<T>::update(const std::size_t maxCount) {
+    return _loader ? _loader->update(maxCount) : 0;
+}
+
+template<class T> void ResourceManagerData<T>::decrementReferenceCount(const UnsignedInt slot, const UnsignedInt generation) {
+    /* The slot could be gone if the manager was cleared while the resource
+       was still referenced, which was already reported by an assert */
+    if(!data(slot, generation)) return;
 
     /* Free the resource if it is reference counted */
-    if(--it->second.referenceCount == 0 && it->second.policy == ResourcePolicy::ReferenceCounted)
-        _data.erase(it);
+    Data& d = _slots[slot];
+    CORRADE_INTERNAL_ASSERT(d.referenceCount);
+    if(--d.referenceCount == 0 && d.policy == ResourcePolicy::ReferenceCounted)
+        erase(slot);
 }
 
 template<class T> struct ResourceManagerData<T>::Data {
-    Data(): data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), referenceCount(0) {}
+    Data(): data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), referenceCount(0), lastChange(0), generation(0), used(false) {}
 
     Data(const Data&) = delete;
 
-    Data(Data&& other) noexcept: data{other.data}, state{other.state}, policy{other.policy}, referenceCount{other.referenceCount} {
+    Data(Data&& other) noexcept: key{other.key}, data{other.data}, state{other.state}, policy{other.policy}, referenceCount{other.referenceCount}, lastChange{other.lastChange}, generation{other.generation}, used{other.used} {
         other.data = nullptr;
         other.referenceCount = 0;
     }
 
-    ~Data();
+    ~Data() { destroy(); }
 
     Data& operator=(const Data&) = delete;
     Data& operator=(Data&&) = delete;
 
+    void destroy();
+
+    ResourceKey key;
     T* data;
     ResourceDataState state;
     ResourcePolicy policy;
     std::size_t referenceCount;
+    std::size_t lastChange;
+    UnsignedInt generation;
+    bool used;
 };
 
-template<class T> inline ResourceManagerData<T>::Data::~Data() {
+template<class T> inline void ResourceManagerData<T>::Data::destroy() {
     CORRADE_ASSERT(referenceCount == 0,
         "ResourceManager: cleared/destroyed while data are still referenced", );
     safeDelete(data);
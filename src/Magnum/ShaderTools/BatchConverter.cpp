@@ -0,0 +1,360 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BatchConverter.h"
+
+#include <atomic>
+#include <unordered_map>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringStl.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Format.h>
+#include <Corrade/Utility/Path.h>
+#include <Corrade/Utility/Sha1.h>
+
+#include "Magnum/Implementation/stringHash.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/ShaderTools/AbstractConverter.h"
+
+#ifdef CORRADE_TARGET_WINDOWS
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Magnum { namespace ShaderTools {
+
+using namespace Containers::Literals;
+
+namespace Implementation {
+
+namespace {
+
+/* Prefixing with size so concatenation of two strings can't produce the same
+   hash as a different split of the same bytes */
+void hashData(Utility::Sha1& sha1, const char* const data, const std::size_t size) {
+    const UnsignedLong size64 = size;
+    sha1 << Containers::arrayView(reinterpret_cast<const char*>(&size64), sizeof(size64))
+         << Containers::arrayView(data, size);
+}
+
+void hashData(Utility::Sha1& sha1, const Containers::StringView data) {
+    hashData(sha1, data.data(), data.size());
+}
+
+template<class T> void hashValue(Utility::Sha1& sha1, const T& value) {
+    sha1 << Containers::arrayView(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+}
+
+struct BatchConverterJob {
+    Stage stage;
+    Containers::Array<char> data;
+    /* Containers::String can't represent a null view, so an undefine is
+       stored as a NullOpt value */
+    Containers::Array<Containers::Pair<Containers::String, Containers::Optional<Containers::String>>> definitions;
+    Containers::String hash;
+    /* Index of an earlier job in the same batch with the same hash, or ~0 */
+    UnsignedInt duplicateOf;
+    bool processed, cached;
+    Containers::Optional<Containers::Array<char>> output;
+};
+
+struct BatchConverterState {
+    explicit BatchConverterState(Containers::Array<Containers::Pointer<AbstractConverter>>&& converters): converters{Utility::move(converters)} {}
+
+    Containers::Array<Containers::Pointer<AbstractConverter>> converters;
+    Containers::String cacheDirectory, cacheKey;
+    Containers::Array<BatchConverterJob> jobs;
+    /* Index of the first job that wasn't processed yet */
+    UnsignedInt pendingJobOffset{};
+    UnsignedInt cacheHitCount{}, cacheMissCount{};
+};
+
+}
+
+namespace {
+
+UnsignedLong processId() {
+    #ifdef CORRADE_TARGET_WINDOWS
+    return _getpid();
+    #else
+    return getpid();
+    #endif
+}
+
+/* Called from multiple threads in parallel, each with its own converter. The
+   job is touched only by the thread that processes it. */
+void processJob(AbstractConverter& converter, const Containers::StringView cacheDirectory, const UnsignedInt threadId, Implementation::BatchConverterJob& job) {
+    Containers::String cacheFile;
+    if(!cacheDirectory.isEmpty()) {
+        cacheFile = Utility::Path::join(cacheDirectory, job.hash);
+        if(Utility::Path::exists(cacheFile)) {
+            if(Containers::Optional<Containers::Array<char>> data = Utility::Path::read(cacheFile)) {
+                job.output = Utility::move(*data);
+                job.cached = true;
+                return;
+            }
+        }
+    }
+
+    /* Always set the definitions if the converter supports them, even if
+       empty, to not inherit the ones from the previous job */
+    if(converter.features() >= ConverterFeature::Preprocess) {
+        Containers::Array<Containers::Pair<Containers::StringView, Containers::StringView>> definitions{ValueInit, job.definitions.size()};
+        for(std::size_t i = 0; i != job.definitions.size(); ++i) {
+            const Containers::Pair<Containers::String, Containers::Optional<Containers::String>>& definition = job.definitions[i];
+            definitions[i].first() = definition.first();
+            if(definition.second()) definitions[i].second() = *definition.second();
+        }
+        converter.setDefinitions(definitions);
+    }
+
+    /* The converter is expected to print a message on its own on failure */
+    job.output = converter.convertDataToData(job.stage, Containers::arrayView(job.data));
+    job.cached = false;
+
+    /* Write to a file unique for this process and thread and rename it
+       after, so a partially written output never gets picked up from the
+       cache, not even if several processes share the cache directory.
+       Failures aren't fatal, the output is still available in memory. */
+    if(job.output && !cacheFile.isEmpty()) {
+        const Containers::String temporaryFile = Utility::format("{}.{}.{}.tmp", cacheFile, processId(), threadId);
+        if(Utility::Path::write(temporaryFile, Containers::arrayView(*job.output)))
+            Utility::Path::move(temporaryFile, cacheFile);
+    }
+}
+
+}
+
+BatchConverter::BatchConverter(Containers::Array<Containers::Pointer<AbstractConverter>>&& converters) {
+    CORRADE_ASSERT(!converters.isEmpty(),
+        "ShaderTools::BatchConverter: expected at least one converter", );
+    for(std::size_t i = 0; i != converters.size(); ++i) {
+        CORRADE_ASSERT(converters[i],
+            "ShaderTools::BatchConverter: converter" << i << "is null", );
+        CORRADE_ASSERT(converters[i]->features() >= ConverterFeature::ConvertData,
+            "ShaderTools::BatchConverter: converter" << i << "doesn't support data conversion", );
+        CORRADE_ASSERT(converters[i]->plugin() == converters[0]->plugin(),
+            "ShaderTools::BatchConverter: converter" << i << "is" << Containers::StringView{converters[i]->plugin()} << "but expected" << Containers::StringView{converters[0]->plugin()}, );
+    }
+
+    _state.emplace(Utility::move(converters));
+}
+
+BatchConverter::BatchConverter(NoCreateT) noexcept {}
+
+BatchConverter::BatchConverter(BatchConverter&&) noexcept = default;
+
+BatchConverter::~BatchConverter() = default;
+
+BatchConverter& BatchConverter::operator=(BatchConverter&&) noexcept = default;
+
+UnsignedInt BatchConverter::converterCount() const {
+    return _state ? _state->converters.size() : 0;
+}
+
+AbstractConverter& BatchConverter::converter(const UnsignedInt id) {
+    CORRADE_ASSERT(id < converterCount(),
+        "ShaderTools::BatchConverter::converter(): index" << id << "out of range for" << converterCount() << "converters", *_state->converters[0]);
+    return *_state->converters[id];
+}
+
+Containers::StringView BatchConverter::cacheDirectory() const {
+    return _state ? Containers::StringView{_state->cacheDirectory} : Containers::StringView{};
+}
+
+void BatchConverter::setCacheDirectory(const Containers::StringView directory) {
+    _state->cacheDirectory = Containers::String::nullTerminatedGlobalView(directory);
+}
+
+Containers::StringView BatchConverter::cacheKey() const {
+    return _state ? Containers::StringView{_state->cacheKey} : Containers::StringView{};
+}
+
+void BatchConverter::setCacheKey(const Containers::StringView key) {
+    _state->cacheKey = Containers::String::nullTerminatedGlobalView(key);
+}
+
+UnsignedInt BatchConverter::addJob(const Stage stage, const Containers::ArrayView<const void> data, const Containers::ArrayView<const Containers::Pair<Containers::StringView, Containers::StringView>> definitions) {
+    CORRADE_ASSERT(definitions.isEmpty() || _state->converters[0]->features() >= ConverterFeature::Preprocess,
+        "ShaderTools::BatchConverter::addJob(): definitions set, but the converters don't support preprocessing", {});
+
+    Implementation::BatchConverterJob& job = arrayAppend(_state->jobs, InPlaceInit);
+    job.stage = stage;
+    job.data = Containers::Array<char>{NoInit, data.size()};
+    Utility::copy(Containers::arrayCast<const char>(data), job.data);
+    arrayReserve(job.definitions, definitions.size());
+    for(const Containers::Pair<Containers::StringView, Containers::StringView>& definition: definitions)
+        arrayAppend(job.definitions, InPlaceInit,
+            Containers::String{definition.first()},
+            definition.second().data() ?
+                Containers::Optional<Containers::String>{InPlaceInit, definition.second()} :
+                Containers::Optional<Containers::String>{});
+    job.duplicateOf = ~UnsignedInt{};
+    job.processed = false;
+    job.cached = false;
+    return _state->jobs.size() - 1;
+}
+
+UnsignedInt BatchConverter::addJob(const Stage stage, const Containers::ArrayView<const void> data, const std::initializer_list<Containers::Pair<Containers::StringView, Containers::StringView>> definitions) {
+    return addJob(stage, data, Containers::arrayView(definitions));
+}
+
+UnsignedInt BatchConverter::jobCount() const {
+    return _state ? _state->jobs.size() : 0;
+}
+
+bool BatchConverter::convert() {
+    Implementation::BatchConverterState& state = *_state;
+    const UnsignedInt begin = state.pendingJobOffset;
+    const UnsignedInt end = state.jobs.size();
+    if(begin == end) return true;
+
+    if(!state.cacheDirectory.isEmpty() && !Utility::Path::make(state.cacheDirectory)) {
+        Error{} << "ShaderTools::BatchConverter::convert(): can't create the cache directory" << state.cacheDirectory;
+        return false;
+    }
+
+    /* Hash everything that affects the output. Quiet and Verbose affect only
+       the diagnostics, so they're not included. Done on the calling thread as
+       it's cheap compared to the conversion itself and it allows finding
+       duplicates before any work is done. */
+    const Containers::StringView plugin{state.converters[0]->plugin()};
+    const UnsignedInt flags = UnsignedInt(state.converters[0]->flags() & ~(ConverterFlag::Quiet|ConverterFlag::Verbose));
+    std::unordered_map<Containers::String, UnsignedInt, Magnum::Implementation::StringHash> hashes;
+    for(UnsignedInt i = begin; i != end; ++i) {
+        Implementation::BatchConverterJob& job = state.jobs[i];
+
+        /* Bump the version if the hashed data layout changes */
+        Utility::Sha1 sha1;
+        Implementation::hashData(sha1, "ShaderTools::BatchConverter 1"_s);
+        Implementation::hashData(sha1, plugin);
+        Implementation::hashValue(sha1, flags);
+        Implementation::hashData(sha1, state.cacheKey);
+        Implementation::hashValue(sha1, UnsignedInt(job.stage));
+        Implementation::hashValue(sha1, UnsignedLong(job.definitions.size()));
+        for(const Containers::Pair<Containers::String, Containers::Optional<Containers::String>>& definition: job.definitions) {
+            Implementation::hashData(sha1, definition.first());
+            Implementation::hashValue(sha1, bool(definition.second()));
+            if(definition.second())
+                Implementation::hashData(sha1, *definition.second());
+        }
+        Implementation::hashData(sha1, job.data.data(), job.data.size());
+        job.hash = Containers::String{sha1.digest().hexString()};
+
+        const auto inserted = hashes.emplace(job.hash, i);
+        if(!inserted.second) job.duplicateOf = inserted.first->second;
+    }
+
+    /* Distribute the jobs among the threads, the first converter is used on
+       the calling thread. Each job is picked by exactly one thread. */
+    std::atomic<UnsignedInt> next{begin};
+    const Containers::StringView cacheDirectory = state.cacheDirectory;
+    auto process = [&](const UnsignedInt threadId) {
+        AbstractConverter& converter = *state.converters[threadId];
+        for(UnsignedInt i; (i = next++) < end; ) {
+            Implementation::BatchConverterJob& job = state.jobs[i];
+            if(job.duplicateOf == ~UnsignedInt{}) processJob(converter, cacheDirectory, threadId, job);
+        }
+    };
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    const UnsignedInt threadCount = Math::min(UnsignedInt(state.converters.size()), end - begin);
+    Containers::Array<std::thread> threads;
+    arrayReserve(threads, threadCount - 1);
+    for(UnsignedInt i = 1; i < threadCount; ++i)
+        arrayAppend(threads, InPlaceInit, process, i);
+    process(0);
+    for(std::thread& thread: threads) thread.join();
+    #else
+    process(0);
+    #endif
+
+    /* Copy outputs to duplicates, update stats and report failures. The
+       duplicates always point to an earlier job, so it's processed already
+       at this point. */
+    bool success = true;
+    for(UnsignedInt i = begin; i != end; ++i) {
+        Implementation::BatchConverterJob& job = state.jobs[i];
+        if(job.duplicateOf != ~UnsignedInt{}) {
+            const Implementation::BatchConverterJob& original = state.jobs[job.duplicateOf];
+            if(original.output) {
+                job.output = Containers::Array<char>{NoInit, original.output->size()};
+                Utility::copy(*original.output, *job.output);
+            }
+            job.cached = true;
+        }
+
+        job.processed = true;
+        if(job.cached) ++state.cacheHitCount;
+        else ++state.cacheMissCount;
+
+        if(!job.output) {
+            Error{} << "ShaderTools::BatchConverter::convert(): conversion of job" << i << "failed";
+            success = false;
+        }
+    }
+
+    state.pendingJobOffset = end;
+    return success;
+}
+
+Containers::Optional<Containers::ArrayView<const char>> BatchConverter::output(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < jobCount(),
+        "ShaderTools::BatchConverter::output(): index" << id << "out of range for" << jobCount() << "jobs", {});
+    const Implementation::BatchConverterJob& job = _state->jobs[id];
+    CORRADE_ASSERT(job.processed,
+        "ShaderTools::BatchConverter::output(): job" << id << "wasn't converted yet", {});
+    if(!job.output) return {};
+    return Containers::ArrayView<const char>{*job.output};
+}
+
+bool BatchConverter::isCached(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < jobCount(),
+        "ShaderTools::BatchConverter::isCached(): index" << id << "out of range for" << jobCount() << "jobs", {});
+    const Implementation::BatchConverterJob& job = _state->jobs[id];
+    CORRADE_ASSERT(job.processed,
+        "ShaderTools::BatchConverter::isCached(): job" << id << "wasn't converted yet", {});
+    return job.cached;
+}
+
+UnsignedInt BatchConverter::cacheHitCount() const {
+    return _state ? _state->cacheHitCount : 0;
+}
+
+UnsignedInt BatchConverter::cacheMissCount() const {
+    return _state ? _state->cacheMissCount : 0;
+}
+
+}}
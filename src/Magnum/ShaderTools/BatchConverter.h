@@ -0,0 +1,253 @@
+#ifndef Magnum_ShaderTools_BatchConverter_h
+#define Magnum_ShaderTools_BatchConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ShaderTools::BatchConverter
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/ShaderTools/ShaderTools.h"
+#include "Magnum/ShaderTools/visibility.h"
+
+namespace Magnum { namespace ShaderTools {
+
+namespace Implementation { struct BatchConverterState; }
+
+/**
+@brief Batch shader converter
+@m_since_latest
+
+Converts many shader permutations at once, distributing them across multiple
+threads with one @ref AbstractConverter instance per thread, and optionally
+caching the outputs on disk. Useful for example for building a large amount of
+shader variants differing only in preprocessor definitions, which is
+inherently serial when done through a single converter instance.
+
+Corresponds to the `--batch` option of
+@ref magnum-shaderconverter "magnum-shaderconverter".
+
+@section ShaderTools-BatchConverter-usage Usage
+
+Create as many converter instances as there should be threads, all of them
+set up the same way, and pass them to the constructor. Then add conversion
+jobs with @ref addJob(), run them all with @ref convert() and retrieve the
+outputs with @ref output():
+
+@snippet ShaderTools.cpp BatchConverter-usage
+
+The converters are used only through @ref AbstractConverter::setDefinitions()
+and @ref AbstractConverter::convertDataToData() --- as plugins don't have any
+way to infer the stage from a filename in this case, it's important to pass
+the correct @ref Stage to @ref addJob().
+
+@section ShaderTools-BatchConverter-cache Output cache
+
+If @ref setCacheDirectory() is set, each output is saved to a file in given
+directory, named after a SHA-1 hash of the job input. On the next
+@ref convert() call, jobs for which the file exists are not converted again
+but the output is read from it instead. The hash includes the source, stage,
+preprocessor definitions, plugin name and @ref ConverterFlags except for
+@ref ConverterFlag::Quiet and @relativeref{ConverterFlag,Verbose}. Input and
+output formats, optimization and debug info levels and plugin-specific
+configuration can't be queried from the converter, so if these differ between
+runs, pass them to @ref setCacheKey() to have them included in the hash as
+well. Jobs with the same hash within a single @ref convert() call are
+converted just once, regardless of whether the cache directory is set.
+
+The cache is never pruned, stale entries have to be removed by the
+application. The files are written to a temporary location first and then
+renamed, so an interrupted run doesn't leave truncated outputs in the cache.
+The temporary file name includes the process ID and the converter thread
+index, so it's safe for multiple processes on the same machine to share a
+single cache directory, such as in a parallel build --- if two of them
+convert the same input, each writes its own temporary file and the last
+rename wins, with both outputs being the same. Sharing the directory between
+different machines, for example over a network filesystem, isn't safe, as the
+process IDs aren't unique across machines and the rename may not be atomic.
+
+@attention
+    The converter instances are accessed from multiple threads during
+    @ref convert(), meaning the plugins have to be safe to use from different
+    threads if each thread has its own instance. Apart from that, the class
+    isn't synchronized in any way.
+*/
+class MAGNUM_SHADERTOOLS_EXPORT BatchConverter {
+    public:
+        /**
+         * @brief Constructor
+         * @param converters    Converter instances, one for each thread
+         *
+         * Expects that @p converters is non-empty, all converters are
+         * instances of the same plugin and support
+         * @ref ConverterFeature::ConvertData. The converters are expected to
+         * be set up with the same formats, flags and options. On platforms
+         * without thread support only the first converter is used.
+         */
+        explicit BatchConverter(Containers::Array<Containers::Pointer<AbstractConverter>>&& converters);
+
+        /**
+         * @brief Construct without creating the converter
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit BatchConverter(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        BatchConverter(const BatchConverter&) = delete;
+
+        /** @brief Move constructor */
+        BatchConverter(BatchConverter&& other) noexcept;
+
+        ~BatchConverter();
+
+        /** @brief Copying is not allowed */
+        BatchConverter& operator=(const BatchConverter&) = delete;
+
+        /** @brief Move assignment */
+        BatchConverter& operator=(BatchConverter&& other) noexcept;
+
+        /** @brief Converter count */
+        UnsignedInt converterCount() const;
+
+        /**
+         * @brief Converter instance
+         *
+         * Expects that @p id is less than @ref converterCount().
+         */
+        AbstractConverter& converter(UnsignedInt id);
+
+        /** @brief Cache directory */
+        Containers::StringView cacheDirectory() const;
+
+        /**
+         * @brief Set cache directory
+         *
+         * The directory is created on the next @ref convert() call if it
+         * doesn't exist. Empty string disables the cache, which is the
+         * default. See @ref ShaderTools-BatchConverter-cache for more
+         * information.
+         */
+        void setCacheDirectory(Containers::StringView directory);
+
+        /** @brief Additional cache key */
+        Containers::StringView cacheKey() const;
+
+        /**
+         * @brief Set additional cache key
+         *
+         * Included in the hash of every job. Use to describe converter setup
+         * that isn't queryable through the @ref AbstractConverter interface,
+         * such as formats or plugin options. Empty by default. See
+         * @ref ShaderTools-BatchConverter-cache for more information.
+         */
+        void setCacheKey(Containers::StringView key);
+
+        /**
+         * @brief Add a conversion job
+         * @param stage         Shader stage
+         * @param data          Shader source
+         * @param definitions   Preprocessor definitions
+         * @return Job ID, to be used in @ref output() and @ref isCached()
+         *
+         * Both @p data and @p definitions are copied, there's no need to
+         * keep them in scope until @ref convert() is called. The
+         * @p definitions have the same semantics as in
+         * @ref AbstractConverter::setDefinitions(), they replace any
+         * definitions the converters may have been set up with. If non-empty,
+         * the converters are expected to support
+         * @ref ConverterFeature::Preprocess.
+         */
+        UnsignedInt addJob(Stage stage, Containers::ArrayView<const void> data, Containers::ArrayView<const Containers::Pair<Containers::StringView, Containers::StringView>> definitions = {});
+
+        /** @overload */
+        UnsignedInt addJob(Stage stage, Containers::ArrayView<const void> data, std::initializer_list<Containers::Pair<Containers::StringView, Containers::StringView>> definitions);
+
+        /** @brief Count of added jobs */
+        UnsignedInt jobCount() const;
+
+        /**
+         * @brief Convert all pending jobs
+         *
+         * Processes all jobs added since the previous call, using
+         * @ref converterCount() threads, the calling thread included. If a
+         * conversion fails, the remaining jobs are still processed, a message
+         * listing the failed job is printed and the function returns
+         * @cpp false @ce at the end. Failed jobs aren't saved to the cache.
+         */
+        bool convert();
+
+        /**
+         * @brief Conversion output
+         *
+         * Expects that @p id is less than @ref jobCount() and that
+         * @ref convert() was called after the job was added. Returns
+         * @relativeref{Corrade,Containers::NullOpt} if the conversion failed.
+         */
+        Containers::Optional<Containers::ArrayView<const char>> output(UnsignedInt id) const;
+
+        /**
+         * @brief Whether the output was taken from the cache
+         *
+         * Returns @cpp true @ce if the output was read from the cache
+         * directory or copied from an identical job in the same batch,
+         * @cpp false @ce if the job was converted. Expects that @p id is less
+         * than @ref jobCount() and that @ref convert() was called after the
+         * job was added.
+         */
+        bool isCached(UnsignedInt id) const;
+
+        /**
+         * @brief Count of cache hits
+         *
+         * Count of jobs for which @ref isCached() returns @cpp true @ce,
+         * accumulated over all @ref convert() calls.
+         */
+        UnsignedInt cacheHitCount() const;
+
+        /**
+         * @brief Count of cache misses
+         *
+         * Count of jobs that were converted, including the failed ones,
+         * accumulated over all @ref convert() calls.
+         */
+        UnsignedInt cacheMissCount() const;
+
+    private:
+        Containers::Pointer<Implementation::BatchConverterState> _state;
+};
+
+}}
+
+#endif
@@ -36,6 +36,7 @@ namespace Magnum { namespace ShaderTools {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
 class AbstractConverter;
+class BatchConverter;
 enum class Stage: UnsignedInt;
 #endif
 
@@ -0,0 +1,588 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringStl.h> /** @todo remove once Debug is stream-free */
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/String.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Format.h>
+#include <Corrade/Utility/Path.h>
+
+#include "Magnum/ShaderTools/AbstractConverter.h"
+#include "Magnum/ShaderTools/BatchConverter.h"
+#include "Magnum/ShaderTools/Stage.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace ShaderTools { namespace Test { namespace {
+
+struct BatchConverterTest: TestSuite::Tester {
+    explicit BatchConverterTest();
+
+    void construct();
+    void constructNoConverters();
+    void constructNullConverter();
+    void constructDataConversionNotSupported();
+    void constructNoCreate();
+    void constructCopy();
+    void constructMove();
+
+    void converterInvalid();
+
+    void convert();
+    void convertNothing();
+    void convertDefinitions();
+    void convertDefinitionsNotSupported();
+    void convertDuplicates();
+    void convertIncremental();
+    void convertFailed();
+
+    void cache();
+    void cacheKey();
+
+    void outputInvalid();
+    void outputNotConverted();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt converterCount;
+} ConvertData[]{
+    {"single converter", 1},
+    {"three converters", 3},
+    {"more converters than jobs", 16}
+};
+
+using namespace Containers::Literals;
+
+BatchConverterTest::BatchConverterTest() {
+    addTests({&BatchConverterTest::construct,
+              &BatchConverterTest::constructNoConverters,
+              &BatchConverterTest::constructNullConverter,
+              &BatchConverterTest::constructDataConversionNotSupported,
+              &BatchConverterTest::constructNoCreate,
+              &BatchConverterTest::constructCopy,
+              &BatchConverterTest::constructMove,
+
+              &BatchConverterTest::converterInvalid});
+
+    addInstancedTests({&BatchConverterTest::convert},
+        Containers::arraySize(ConvertData));
+
+    addTests({&BatchConverterTest::convertNothing,
+              &BatchConverterTest::convertDefinitions,
+              &BatchConverterTest::convertDefinitionsNotSupported,
+              &BatchConverterTest::convertDuplicates,
+              &BatchConverterTest::convertIncremental,
+              &BatchConverterTest::convertFailed,
+
+              &BatchConverterTest::cache,
+              &BatchConverterTest::cacheKey,
+
+              &BatchConverterTest::outputInvalid,
+              &BatchConverterTest::outputNotConverted});
+}
+
+/* Outputs the stage, definitions set for given conversion and the input
+   data. Doesn't print anything on failure as the output would come from a
+   different thread and thus couldn't be redirected. */
+struct DummyConverter: AbstractConverter {
+    explicit DummyConverter(ConverterFeatures features, std::atomic<UnsignedInt>& convertCount): _features{features}, _convertCount(convertCount) {}
+
+    ConverterFeatures doFeatures() const override { return _features; }
+    void doSetInputFormat(Format, Containers::StringView) override {}
+    void doSetOutputFormat(Format, Containers::StringView) override {}
+
+    void doSetDefinitions(Containers::ArrayView<const Containers::Pair<Containers::StringView, Containers::StringView>> definitions) override {
+        _definitions = {};
+        for(const Containers::Pair<Containers::StringView, Containers::StringView>& definition: definitions) {
+            if(definition.second().data())
+                _definitions = Utility::format("{}{}={};", _definitions, definition.first(), definition.second());
+            else
+                _definitions = Utility::format("{}!{};", _definitions, definition.first());
+        }
+    }
+
+    Containers::Optional<Containers::Array<char>> doConvertDataToData(Stage stage, Containers::ArrayView<const char> data) override {
+        ++_convertCount;
+
+        const Containers::StringView input{data.data(), data.size()};
+        if(input == "fail"_s) return {};
+
+        const Containers::String string = Utility::format("{}:{}:{}", UnsignedInt(stage), _definitions, input);
+        Containers::Array<char> out{NoInit, string.size()};
+        Utility::copy(Containers::arrayView(string.data(), string.size()), out);
+        return out;
+    }
+
+    ConverterFeatures _features;
+    std::atomic<UnsignedInt>& _convertCount;
+    Containers::String _definitions;
+};
+
+Containers::Array<Containers::Pointer<AbstractConverter>> converters(const UnsignedInt count, const ConverterFeatures features, std::atomic<UnsignedInt>& convertCount) {
+    Containers::Array<Containers::Pointer<AbstractConverter>> out;
+    for(UnsignedInt i = 0; i != count; ++i)
+        arrayAppend(out, Containers::Pointer<AbstractConverter>{new DummyConverter{features, convertCount}});
+    return out;
+}
+
+Containers::ArrayView<const void> view(const Containers::StringView string) {
+    return {string.data(), string.size()};
+}
+
+Containers::String outputString(const BatchConverter& converter, const UnsignedInt id) {
+    const Containers::Optional<Containers::ArrayView<const char>> output = converter.output(id);
+    if(!output) return "<failed>";
+    return Containers::String{output->data(), output->size()};
+}
+
+void BatchConverterTest::construct() {
+    std::atomic<UnsignedInt> convertCount{};
+    Containers::Array<Containers::Pointer<AbstractConverter>> instances = converters(3, ConverterFeature::ConvertData, convertCount);
+    AbstractConverter* second = instances[1].get();
+
+    BatchConverter converter{Utility::move(instances)};
+    CORRADE_COMPARE(converter.converterCount(), 3);
+    CORRADE_COMPARE(&converter.converter(1), second);
+    CORRADE_COMPARE(converter.cacheDirectory(), "");
+    CORRADE_COMPARE(converter.cacheKey(), "");
+    CORRADE_COMPARE(converter.jobCount(), 0);
+    CORRADE_COMPARE(converter.cacheHitCount(), 0);
+    CORRADE_COMPARE(converter.cacheMissCount(), 0);
+}
+
+void BatchConverterTest::constructNoConverters() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    BatchConverter{Containers::Array<Containers::Pointer<AbstractConverter>>{}};
+    CORRADE_COMPARE(out.str(), "ShaderTools::BatchConverter: expected at least one converter\n");
+}
+
+void BatchConverterTest::constructNullConverter() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::atomic<UnsignedInt> convertCount{};
+    Containers::Array<Containers::Pointer<AbstractConverter>> instances = converters(3, ConverterFeature::ConvertData, convertCount);
+    instances[2] = nullptr;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    BatchConverter{Utility::move(instances)};
+    CORRADE_COMPARE(out.str(), "ShaderTools::BatchConverter: converter 2 is null\n");
+}
+
+void BatchConverterTest::constructDataConversionNotSupported() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::atomic<UnsignedInt> convertCount{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    BatchConverter{converters(2, ConverterFeature::ConvertFile, convertCount)};
+    CORRADE_COMPARE(out.str(), "ShaderTools::BatchConverter: converter 0 doesn't support data conversion\n");
+}
+
+void BatchConverterTest::constructNoCreate() {
+    {
+        BatchConverter converter{NoCreate};
+        CORRADE_COMPARE(converter.converterCount(), 0);
+        CORRADE_COMPARE(converter.cacheDirectory(), "");
+        CORRADE_COMPARE(converter.cacheKey(), "");
+        CORRADE_COMPARE(converter.jobCount(), 0);
+        CORRADE_COMPARE(converter.cacheHitCount(), 0);
+        CORRADE_COMPARE(converter.cacheMissCount(), 0);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, BatchConverter>::value);
+}
+
+void BatchConverterTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<BatchConverter>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<BatchConverter>{});
+}
+
+void BatchConverterTest::constructMove() {
+    std::atomic<UnsignedInt> convertCount{};
+
+    BatchConverter a{converters(2, ConverterFeature::ConvertData, convertCount)};
+    a.setCacheKey("hello");
+    a.addJob(Stage::Vertex, view("vert"));
+
+    BatchConverter b{Utility::move(a)};
+    CORRADE_COMPARE(a.converterCount(), 0);
+    CORRADE_COMPARE(b.converterCount(), 2);
+    CORRADE_COMPARE(b.cacheKey(), "hello");
+    CORRADE_COMPARE(b.jobCount(), 1);
+
+    BatchConverter c{NoCreate};
+    c = Utility::move(b);
+    CORRADE_COMPARE(b.converterCount(), 0);
+    CORRADE_COMPARE(c.converterCount(), 2);
+    CORRADE_COMPARE(c.cacheKey(), "hello");
+    CORRADE_COMPARE(c.jobCount(), 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<BatchConverter>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<BatchConverter>::value);
+}
+
+void BatchConverterTest::converterInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::atomic<UnsignedInt> convertCount{};
+    BatchConverter converter{converters(2, ConverterFeature::ConvertData, convertCount)};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.converter(2);
+    CORRADE_COMPARE(out.str(), "ShaderTools::BatchConverter::converter(): index 2 out of range for 2 converters\n");
+}
+
+void BatchConverterTest::convert() {
+    auto&& data = ConvertData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::atomic<UnsignedInt> convertCount{};
+    BatchConverter converter{converters(data.converterCount, ConverterFeature::ConvertData, convertCount)};
+
+    Containers::Array<Containers::String> sources;
+    for(UnsignedInt i = 0; i != 10; ++i) {
+        arrayAppend(sources, Utility::format("shader{}", i));
+        CORRADE_COMPARE(converter.addJob(i % 2 ? Stage::Fragment : Stage::Vertex, view(sources.back())), i);
+    }
+    CORRADE_COMPARE(converter.jobCount(), 10);
+
+    /* The sources are copied, so this shouldn't affect anything */
+    sources = {};
+
+    CORRADE_VERIFY(converter.convert());
+    CORRADE_COMPARE(convertCount.load(), 10);
+    CORRADE_COMPARE(converter.cacheHitCount(), 0);
+    CORRADE_COMPARE(converter.cacheMissCount(), 10);
+    for(UnsignedInt i = 0; i != 10; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(outputString(converter, i), Utility::format("{}::shader{}", UnsignedInt(i % 2 ? Stage::Fragment : Stage::Vertex), i));
+        CORRADE_VERIFY(!converter.isCached(i));
+    }
+}
+
+void BatchConverterTest::convertNothing() {
+    std::atomic<UnsignedInt> convertCount{};
+    BatchConverter converter{converters(2, ConverterFeature::ConvertData, convertCount)};
+
+    CORRADE_VERIFY(converter.convert());
+    CORRADE_COMPARE(convertCount.load(), 0);
+    CORRADE_COMPARE(converter.cacheHitCount(), 0);
+    CORRADE_COMPARE(converter.cacheMissCount(), 0);
+}
+
+void BatchConverterTest::convertDefinitions() {
+    std::atomic<UnsignedInt> convertCount{};
+    BatchConverter converter{converters(2, ConverterFeature::ConvertData|ConverterFeature::Preprocess, convertCount)};
+
+    converter.addJob(Stage::Vertex, view("a"), {
+        {"LIGHT_COUNT", "3"},
+        {"VULKAN", ""},
+        {"GL_ES", nullptr}
+    });
+    /* The definitions are reset for each job */
+    converter.addJob(Stage::Vertex, view("b"));
+    /* Empty and null value are different */
+    converter.addJob(Stage::Vertex, view("a"), {
+        {"VULKAN", nullptr}
+    });
+    converter.addJob(Stage::Vertex, view("a"), {
+        {"VULKAN", ""}
+    });
+
+    CORRADE_VERIFY(converter.convert());
+    CORRADE_COMPARE(convertCount.load(), 4);
+    CORRADE_COMPARE(outputString(converter, 0), "1:LIGHT_COUNT=3;VULKAN=;!GL_ES;:a");
+    CORRADE_COMPARE(outputString(converter, 1), "1::b");
+    CORRADE_COMPARE(outputString(converter, 2), "1:!VULKAN;:a");
+    CORRADE_COMPARE(outputString(converter, 3), "1:VULKAN=;:a");
+}
+
+void BatchConverterTest::convertDefinitionsNotSupported() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::atomic<UnsignedInt> convertCount{};
+    BatchConverter converter{converters(2, ConverterFeature::ConvertData, convertCount)};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.addJob(Stage::Vertex, view("a"), {
+        {"VULKAN", ""}
+    });
+    CORRADE_COMPARE(converter.jobCount(), 0);
+    CORRADE_COMPARE(out.str(), "ShaderTools::BatchConverter::addJob(): definitions set, but the converters don't support preprocessing\n");
+}
+
+void BatchConverterTest::convertDuplicates() {
+    std::atomic<UnsignedInt> convertCount{};
+    BatchConverter converter{converters(3, ConverterFeature::ConvertData|ConverterFeature::Preprocess, convertCount)};
+
+    converter.addJob(Stage::Vertex, view("a"), {{"VULKAN", ""}});
+    converter.addJob(Stage::Fragment, view("a"), {{"VULKAN", ""}});
+    converter.addJob(Stage::Vertex, view("a"), {{"VULKAN", ""}});
+    converter.addJob(Stage::Vertex, view("a"), {{"VULKAN", nullptr}});
+    converter.addJob(Stage::Vertex, view("a"), {{"VULKAN", ""}});
+    CORRADE_VERIFY(converter.convert());
+
+    /* Jobs 2 and 4 are the same as 0 */
+    CORRADE_COMPARE(convertCount.load(), 3);
+    CORRADE_COMPARE(converter.cacheHitCount(), 2);
+    CORRADE_COMPARE(converter.cacheMissCount(), 3);
+    CORRADE_VERIFY(!converter.isCached(0));
+    CORRADE_VERIFY(!converter.isCached(1));
+    CORRADE_VERIFY(converter.isCached(2));
+    CORRADE_VERIFY(!converter.isCached(3));
+    CORRADE_VERIFY(converter.isCached(4));
+    CORRADE_COMPARE(outputString(converter, 0), "1:VULKAN=;:a");
+    CORRADE_COMPARE(outputString(converter, 1), "2:VULKAN=;:a");
+    CORRADE_COMPARE(outputString(converter, 2), "1:VULKAN=;:a");
+    CORRADE_COMPARE(outputString(converter, 3), "1:!VULKAN;:a");
+    CORRADE_COMPARE(outputString(converter, 4), "1:VULKAN=;:a");
+}
+
+void BatchConverterTest::convertIncremental() {
+    std::atomic<UnsignedInt> convertCount{};
+    BatchConverter converter{converters(2, ConverterFeature::ConvertData, convertCount)};
+
+    converter.addJob(Stage::Vertex, view("a"));
+    converter.addJob(Stage::Vertex, view("b"));
+    CORRADE_VERIFY(converter.convert());
+    CORRADE_COMPARE(convertCount.load(), 2);
+
+    /* Only the newly added jobs get converted. Without a cache directory, an
+       identical job from a previous batch is converted again. */
+    converter.addJob(Stage::Vertex, view("c"));
+    converter.addJob(Stage::Vertex, view("a"));
+    CORRADE_VERIFY(converter.convert());
+    CORRADE_COMPARE(convertCount.load(), 4);
+    CORRADE_COMPARE(converter.cacheHitCount(), 0);
+    CORRADE_COMPARE(converter.cacheMissCount(), 4);
+    CORRADE_COMPARE(outputString(converter, 0), "1::a");
+    CORRADE_COMPARE(outputString(converter, 1), "1::b");
+    CORRADE_COMPARE(outputString(converter, 2), "1::c");
+    CORRADE_COMPARE(outputString(converter, 3), "1::a");
+
+    /* Nothing left to do */
+    CORRADE_VERIFY(converter.convert());
+    CORRADE_COMPARE(convertCount.load(), 4);
+}
+
+void BatchConverterTest::convertFailed() {
+    std::atomic<UnsignedInt> convertCount{};
+    BatchConverter converter{converters(2, ConverterFeature::ConvertData, convertCount)};
+
+    converter.addJob(Stage::Vertex, view("a"));
+    converter.addJob(Stage::Vertex, view("fail"));
+    converter.addJob(Stage::Vertex, view("b"));
+    converter.addJob(Stage::Vertex, view("fail"));
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!converter.convert());
+    }
+    CORRADE_COMPARE(out.str(),
+        "ShaderTools::BatchConverter::convert(): conversion of job 1 failed\n"
+        "ShaderTools::BatchConverter::convert(): conversion of job 3 failed\n");
+
+    /* The remaining jobs are still processed, the duplicate failure isn't
+       attempted again */
+    CORRADE_COMPARE(convertCount.load(), 3);
+    CORRADE_COMPARE(converter.cacheHitCount(), 1);
+    CORRADE_COMPARE(converter.cacheMissCount(), 3);
+    CORRADE_COMPARE(outputString(converter, 0), "1::a");
+    CORRADE_VERIFY(!converter.output(1));
+    CORRADE_COMPARE(outputString(converter, 2), "1::b");
+    CORRADE_VERIFY(!converter.output(3));
+}
+
+void clearCacheDirectory(const Containers::StringView directory) {
+    if(!Utility::Path::exists(directory)) return;
+    const Containers::Optional<Containers::Array<Containers::String>> files = Utility::Path::list(directory, Utility::Path::ListFlag::SkipDirectories|Utility::Path::ListFlag::SkipDotAndDotDot);
+    CORRADE_INTERNAL_ASSERT(files);
+    for(const Containers::String& file: *files)
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Path::remove(Utility::Path::join(directory, file)));
+}
+
+void BatchConverterTest::cache() {
+    const Containers::String cacheDirectory = Utility::Path::join(SHADERTOOLS_TEST_OUTPUT_DIR, "BatchConverterTestCache");
+    clearCacheDirectory(cacheDirectory);
+
+    std::atomic<UnsignedInt> convertCount{};
+    {
+        BatchConverter converter{converters(2, ConverterFeature::ConvertData|ConverterFeature::Preprocess, convertCount)};
+        converter.setCacheDirectory(cacheDirectory);
+        CORRADE_COMPARE(converter.cacheDirectory(), Containers::StringView{cacheDirectory});
+
+        converter.addJob(Stage::Vertex, view("a"), {{"VULKAN", ""}});
+        converter.addJob(Stage::Fragment, view("a"));
+        converter.addJob(Stage::Vertex, view("fail"));
+        {
+            std::ostringstream out;
+            Error redirectError{&out};
+            CORRADE_VERIFY(!converter.convert());
+        }
+        CORRADE_COMPARE(convertCount.load(), 3);
+        CORRADE_COMPARE(converter.cacheHitCount(), 0);
+        CORRADE_COMPARE(converter.cacheMissCount(), 3);
+    }
+
+    /* The directory got created and contains just the successful outputs */
+    {
+        const Containers::Optional<Containers::Array<Containers::String>> files = Utility::Path::list(cacheDirectory, Utility::Path::ListFlag::SkipDirectories|Utility::Path::ListFlag::SkipDotAndDotDot);
+        CORRADE_VERIFY(files);
+        CORRADE_COMPARE(files->size(), 2);
+    }
+
+    /* A new instance with the same setup takes the outputs from the cache,
+       except for the new job and the failed one */
+    {
+        BatchConverter converter{converters(3, ConverterFeature::ConvertData|ConverterFeature::Preprocess, convertCount)};
+        converter.setCacheDirectory(cacheDirectory);
+
+        converter.addJob(Stage::Fragment, view("a"));
+        converter.addJob(Stage::Vertex, view("a"), {{"VULKAN", ""}});
+        converter.addJob(Stage::Vertex, view("b"));
+        converter.addJob(Stage::Vertex, view("fail"));
+        {
+            std::ostringstream out;
+            Error redirectError{&out};
+            CORRADE_VERIFY(!converter.convert());
+        }
+        CORRADE_COMPARE(convertCount.load(), 5);
+        CORRADE_COMPARE(converter.cacheHitCount(), 2);
+        CORRADE_COMPARE(converter.cacheMissCount(), 2);
+        CORRADE_VERIFY(converter.isCached(0));
+        CORRADE_VERIFY(converter.isCached(1));
+        CORRADE_VERIFY(!converter.isCached(2));
+        CORRADE_VERIFY(!converter.isCached(3));
+        CORRADE_COMPARE(outputString(converter, 0), "2::a");
+        CORRADE_COMPARE(outputString(converter, 1), "1:VULKAN=;:a");
+        CORRADE_COMPARE(outputString(converter, 2), "1::b");
+    }
+}
+
+void BatchConverterTest::cacheKey() {
+    const Containers::String cacheDirectory = Utility::Path::join(SHADERTOOLS_TEST_OUTPUT_DIR, "BatchConverterTestCacheKey");
+    clearCacheDirectory(cacheDirectory);
+
+    std::atomic<UnsignedInt> convertCount{};
+    {
+        BatchConverter converter{converters(1, ConverterFeature::ConvertData, convertCount)};
+        converter.setCacheDirectory(cacheDirectory);
+        converter.setCacheKey("--output-version vulkan1.1");
+        CORRADE_COMPARE(converter.cacheKey(), "--output-version vulkan1.1");
+        converter.addJob(Stage::Vertex, view("a"));
+        CORRADE_VERIFY(converter.convert());
+        CORRADE_COMPARE(convertCount.load(), 1);
+    }
+
+    /* A different key results in a cache miss */
+    {
+        BatchConverter converter{converters(1, ConverterFeature::ConvertData, convertCount)};
+        converter.setCacheDirectory(cacheDirectory);
+        converter.setCacheKey("--output-version vulkan1.2");
+        converter.addJob(Stage::Vertex, view("a"));
+        CORRADE_VERIFY(converter.convert());
+        CORRADE_COMPARE(convertCount.load(), 2);
+        CORRADE_VERIFY(!converter.isCached(0));
+    }
+
+    /* Different flags as well, except for verbosity */
+    {
+        BatchConverter converter{converters(1, ConverterFeature::ConvertData, convertCount)};
+        converter.setCacheDirectory(cacheDirectory);
+        converter.setCacheKey("--output-version vulkan1.2");
+        converter.converter(0).setFlags(ConverterFlag::WarningAsError);
+        converter.addJob(Stage::Vertex, view("a"));
+        CORRADE_VERIFY(converter.convert());
+        CORRADE_COMPARE(convertCount.load(), 3);
+        CORRADE_VERIFY(!converter.isCached(0));
+    } {
+        BatchConverter converter{converters(1, ConverterFeature::ConvertData, convertCount)};
+        converter.setCacheDirectory(cacheDirectory);
+        converter.setCacheKey("--output-version vulkan1.2");
+        converter.converter(0).setFlags(ConverterFlag::WarningAsError|ConverterFlag::Verbose);
+        converter.addJob(Stage::Vertex, view("a"));
+        CORRADE_VERIFY(converter.convert());
+        CORRADE_COMPARE(convertCount.load(), 3);
+        CORRADE_VERIFY(converter.isCached(0));
+    }
+}
+
+void BatchConverterTest::outputInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::atomic<UnsignedInt> convertCount{};
+    BatchConverter converter{converters(1, ConverterFeature::ConvertData, convertCount)};
+    converter.addJob(Stage::Vertex, view("a"));
+    converter.convert();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.output(1);
+    converter.isCached(1);
+    CORRADE_COMPARE(out.str(),
+        "ShaderTools::BatchConverter::output(): index 1 out of range for 1 jobs\n"
+        "ShaderTools::BatchConverter::isCached(): index 1 out of range for 1 jobs\n");
+}
+
+void BatchConverterTest::outputNotConverted() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::atomic<UnsignedInt> convertCount{};
+    BatchConverter converter{converters(1, ConverterFeature::ConvertData, convertCount)};
+    converter.addJob(Stage::Vertex, view("a"));
+    converter.convert();
+    converter.addJob(Stage::Vertex, view("b"));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.output(1);
+    converter.isCached(1);
+    CORRADE_COMPARE(out.str(),
+        "ShaderTools::BatchConverter::output(): job 1 wasn't converted yet\n"
+        "ShaderTools::BatchConverter::isCached(): job 1 wasn't converted yet\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ShaderTools::Test::BatchConverterTest)
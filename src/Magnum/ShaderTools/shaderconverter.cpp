@@ -23,17 +23,20 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <thread>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StringIterable.h>
 #include <Corrade/Containers/Pair.h>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Format.h>
 #include <Corrade/Utility/Path.h>
 
 #include "Magnum/Implementation/converterUtilities.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/ShaderTools/AbstractConverter.h"
+#include "Magnum/ShaderTools/BatchConverter.h"
 #include "Magnum/ShaderTools/Stage.h"
 #include "Magnum/ShaderTools/Implementation/spirv.h"
 
@@ -85,11 +88,30 @@ magnum-shaderconverter phong.frag phong.frag.spv \
     --input-version "410 core" --output-version opengl4.5
 @endcode
 
+Converting all permutations listed in a file on all available cores, skipping
+the ones that didn't change since the last run:
+
+@code{.sh}
+magnum-shaderconverter --batch permutations.txt --cache-dir shader-cache \
+    --output-version vulkan1.1
+@endcode
+
+The `permutations.txt` file can look for example like this:
+
+@code{.sh}
+# Options after the output file apply only to given shader
+phong.vert phong.vert.spv
+phong.frag phong.frag.spv
+phong.frag phong-textured.frag.spv -DDIFFUSE_TEXTURE -DNORMAL_TEXTURE
+phong.frag phong-lights.frag.spv -DLIGHT_COUNT=8
+@endcode
+
 @section magnum-shaderconverter-usage Full usage documentation
 
 @code{.sh}
-magnum-shaderconverter [-h|--help] [--validate] [--link]
-    [-C|--converter NAME]... [--plugin-dir DIR]
+magnum-shaderconverter [-h|--help] [--validate] [--link] [--batch]
+    [-j|--threads N] [--cache-dir DIR] [-C|--converter NAME]...
+    [--plugin-dir DIR]
     [-c|--converter-options key=val,key2=val2,…]... [--info] [-q|--quiet]
     [-v|--verbose] [--warning-as-error] [-E|--preprocess-only]
     [-D|--define name=value]... [-U|--undefine name]... [-O|--optimize LEVEL]
@@ -103,14 +125,20 @@ Arguments:
 
 -   `input` --- input file(s)
 -   `output` --- output file; ignored if `--info` is present, disallowed for
-    `--validate`. If neither `--info`, `--validate` nor `--link` is present,
-    corresponds to the @ref ShaderTools::AbstractConverter::convertFileToFile()
-    function.
+    `--validate` and `--batch`. If neither `--info`, `--validate`, `--link`
+    nor `--batch` is present, corresponds to the
+    @ref ShaderTools::AbstractConverter::convertFileToFile() function.
 -   `-h`, `--help` --- display this help message and exit
 -   `--validate` --- validate input. Corresponds to the
     @ref ShaderTools::AbstractConverter::validateFile() function.
 -   `--link` --- link multiple input files together. Corresponds to the
     @ref ShaderTools::AbstractConverter::linkFilesToFile() function.
+-   `--batch` --- convert shaders listed in the input file. Corresponds to the
+    @ref ShaderTools::BatchConverter class.
+-   `-j`, `--threads N` --- number of threads to use for `--batch`, `0` for
+    all cores (default: `0`)
+-   `--cache-dir DIR` --- output cache directory for `--batch`. Corresponds to
+    the @ref ShaderTools::BatchConverter::setCacheDirectory() function.
 -   `-C`, `--converter CONVERTER` --- shader converter plugin(s)
 -   `--plugin-dir DIR` --- override base plugin dir
 -   `-c`, `--converter-options key=val,key2=val2,…` --- configuration options
@@ -150,6 +178,21 @@ save it to `output`. If neither is specified, the utility will convert the
 @ref ShaderTools::AnyConverter "AnyShaderConverter" if none is specified) and
 save it to `output`.
 
+If `--batch` is given, the `input` file is a list of shaders to convert, one
+per line, each line consisting of an input file, an output file and optional
+`-D` / `-U` options specific to given shader, separated by whitespace. Empty
+lines and lines starting with `#` are ignored. The shaders are converted on
+`-j` / `--threads` threads using the `--converter` (or
+@ref ShaderTools::AnyConverter "AnyShaderConverter" if none is specified)
+with all other options applied to each of them. Plugins can't infer the stage
+from a filename in this case, so it's deduced from the input file extension
+instead --- `.vert`, `.frag`, `.geom`, `.tesc`, `.tese`, `.comp`, `.rgen`,
+`.rahit`, `.rchit`, `.rmiss`, `.rint`, `.rcall`, `.task` and `.mesh` are
+recognized, optionally followed by `.glsl` or `.hlsl`. If `--cache-dir` is
+specified, outputs are cached there and shaders for which neither the source
+nor any of the options changed aren't converted again. See
+@ref ShaderTools-BatchConverter-cache for more information.
+
 The `-c` / `--converter-options` argument accept a comma-separated list of
 key/value pairs to set in the converter plugin configuration. If the `=`
 character is omitted, it's equivalent to saying `key=true`; configuration
@@ -212,6 +255,31 @@ ShaderTools::Stage spvExecutionModelToStage(const SpvExecutionModel model) {
     return ShaderTools::Stage((1u << 31)|model);
 }
 
+/* Plugins can't infer the stage from a filename when converting data, so it's
+   done here for --batch. The extensions are the same as glslangValidator
+   recognizes, optionally followed by .glsl or .hlsl. */
+ShaderTools::Stage stageForFilename(Containers::StringView filename) {
+    if(filename.hasSuffix(".glsl"_s) || filename.hasSuffix(".hlsl"_s))
+        filename = filename.exceptSuffix(5);
+
+    const Containers::StringView extension = Utility::Path::splitExtension(filename).second();
+    if(extension == ".vert"_s) return ShaderTools::Stage::Vertex;
+    if(extension == ".frag"_s) return ShaderTools::Stage::Fragment;
+    if(extension == ".geom"_s) return ShaderTools::Stage::Geometry;
+    if(extension == ".tesc"_s) return ShaderTools::Stage::TessellationControl;
+    if(extension == ".tese"_s) return ShaderTools::Stage::TessellationEvaluation;
+    if(extension == ".comp"_s) return ShaderTools::Stage::Compute;
+    if(extension == ".rgen"_s) return ShaderTools::Stage::RayGeneration;
+    if(extension == ".rahit"_s) return ShaderTools::Stage::RayAnyHit;
+    if(extension == ".rchit"_s) return ShaderTools::Stage::RayClosestHit;
+    if(extension == ".rmiss"_s) return ShaderTools::Stage::RayMiss;
+    if(extension == ".rint"_s) return ShaderTools::Stage::RayIntersection;
+    if(extension == ".rcall"_s) return ShaderTools::Stage::RayCallable;
+    if(extension == ".task"_s) return ShaderTools::Stage::MeshTask;
+    if(extension == ".mesh"_s) return ShaderTools::Stage::Mesh;
+    return ShaderTools::Stage::Unspecified;
+}
+
 void printSpirvInfo(Containers::ArrayView<const UnsignedInt> data) {
     while(Containers::Optional<ShaderTools::Implementation::SpirvEntrypoint> entrypoint = ShaderTools::Implementation::spirvNextEntrypoint(data)) {
         Debug d;
@@ -240,9 +308,12 @@ void printSpirvInfo(Containers::ArrayView<const UnsignedInt> data) {
 int main(int argc, char** argv) {
     Utility::Arguments args;
     args.addArrayArgument("input").setHelp("input", "input file(s)")
-        .addArgument("output").setHelp("output", "output file; ignored if --info is present, disallowed for --validate")
+        .addArgument("output").setHelp("output", "output file; ignored if --info is present, disallowed for --validate and --batch")
         .addBooleanOption("validate").setHelp("validate", "validate input")
         .addBooleanOption("link").setHelp("link", "link multiple input files together")
+        .addBooleanOption("batch").setHelp("batch", "convert shaders listed in the input file")
+        .addOption('j', "threads", "0").setHelp("threads", "number of threads to use for --batch, 0 for all cores", "N")
+        .addOption("cache-dir").setHelp("cache-dir", "output cache directory for --batch", "DIR")
         .addArrayOption('C', "converter").setHelp("converter", "shader converter plugin(s)")
         #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
         .addOption("plugin-dir").setHelp("plugin-dir", "override base plugin dir", "DIR")
@@ -263,10 +334,10 @@ int main(int argc, char** argv) {
         .addArrayOption("input-version").setHelp("input-version", "input format version for each converter", "VERSION")
         .addArrayOption("output-version").setHelp("output-version", "output format version for each converter", "VERSION")
         .setParseErrorCallback([](const Utility::Arguments& args, Utility::Arguments::ParseError error, const std::string& key) {
-            /* If --info / --validate is passed, we don't need the output
-               argument */
+            /* If --info / --validate / --batch is passed, we don't need the
+               output argument */
             if(error == Utility::Arguments::ParseError::MissingArgument &&
-               key == "output" && (args.isSet("info") || args.isSet("validate")))
+               key == "output" && (args.isSet("info") || args.isSet("validate") || args.isSet("batch")))
                 return true;
 
             /* Handle all other errors as usual */
@@ -286,6 +357,16 @@ AnyShaderConverter if none is specified) and save it to output. If neither is
 specified, the utility will convert the input file using (one or more) passed
 --converter and save it to output.
 
+If --batch is given, the input file is a list of shaders to convert, one per
+line, each line consisting of an input file, an output file and optional -D /
+-U options specific to given shader, separated by whitespace. Empty lines and
+lines starting with # are ignored. The shaders are converted on -j / --threads
+threads using the --converter (or AnyShaderConverter if none is specified) with
+all other options applied to each of them. The stage is deduced from the input
+file extension. If --cache-dir is specified, outputs are cached there and
+shaders for which neither the source nor any of the options changed aren't
+converted again.
+
 The -c / --converter-options argument accept a comma-separated list of
 key/value pairs to set in the converter plugin configuration. If the =
 character is omitted, it's equivalent to saying key=true; configuration
@@ -316,6 +397,11 @@ see documentation of a particular converter for more information.)")
             return 1;
         }
 
+        if(args.isSet("batch")) {
+            Error{} << "Output file shouldn't be set for --batch:" << args.value<Containers::StringView>("output");
+            return 25;
+        }
+
         /* Not an error in this case, it should be possible to just append
            --info to existing command line without having to remove anything.
            But print a warning at least, it could also be a mistyped option. */
@@ -339,6 +425,17 @@ see documentation of a particular converter for more information.)")
             return 5;
         }
     }
+    if(args.isSet("batch")) {
+        if(args.isSet("info") || args.isSet("validate") || args.isSet("link")) {
+            Error{} << "The --batch option isn't allowed together with --info, --validate or --link";
+            return 26;
+        }
+
+        if(args.arrayValueCount("converter") > 1) {
+            Error{} << "Cannot use multiple converters with --batch";
+            return 27;
+        }
+    }
     if(args.isSet("quiet") && args.isSet("verbose")) {
         Error{} << "Can't set both --quiet and --verbose";
         return 6;
@@ -372,22 +469,12 @@ see documentation of a particular converter for more information.)")
         #endif
     };
 
-    /* Data passed from one converter to another in case there's more than one */
-    Containers::Array<char> data;
-
-    /* If there's no converters, it'll be just one AnyShaderConverter. */
-    for(std::size_t i = 0, converterCount = args.arrayValueCount("converter"); i < Math::max(converterCount, std::size_t{1}); ++i) {
-        const std::string converterName = converterCount ?
-            args.arrayValue("converter", i) : "AnyShaderConverter";
-        Containers::Pointer<ShaderTools::AbstractConverter> converter = converterManager.loadAndInstantiate(converterName);
-        if(!converter) {
-            Debug{} << "Available converter plugins:" << ", "_s.join(converterManager.aliasList());
-            return 7;
-        }
-
+    /* Sets up options, formats and flags of i-th converter in the chain.
+       Returns a non-zero exit code on failure. */
+    auto setupConverter = [&args](ShaderTools::AbstractConverter& converter, const std::size_t i, const std::string& converterName) -> int {
         /* Set options if passed */
         if(i < args.arrayValueCount("converter-options"))
-            Implementation::setOptions(*converter, "AnyShaderConverter", args.arrayValue("converter-options", i));
+            Implementation::setOptions(converter, "AnyShaderConverter", args.arrayValue("converter-options", i));
 
         /* Parse format, if passed. If --info is desired, implicitly set the
            output format to SPIR-V */
@@ -426,8 +513,8 @@ see documentation of a particular converter for more information.)")
 
         /* If not passed, these are set to Unspecified and "", which is the
            default */
-        converter->setInputFormat(inputFormat, inputVersion);
-        converter->setOutputFormat(outputFormat, outputVersion);
+        converter.setInputFormat(inputFormat, inputVersion);
+        converter.setOutputFormat(outputFormat, outputVersion);
 
         ShaderTools::ConverterFlags flags;
 
@@ -436,12 +523,10 @@ see documentation of a particular converter for more information.)")
         if(args.isSet("verbose")) flags |= ShaderTools::ConverterFlag::Verbose;
         if(args.isSet("warning-as-error")) flags |= ShaderTools::ConverterFlag::WarningAsError;
 
-        /* Options and flags applied just for the first converter; setting up
-           file list for linking  */
-        Containers::Array<Containers::Pair<ShaderTools::Stage, Containers::StringView>> linkInputs;
+        /* Options and flags applied just for the first converter */
         if(i == 0) {
             if((args.isSet("preprocess-only") || args.arrayValueCount("define") || args.arrayValueCount("undefine"))) {
-                if(!(converter->features() >= ShaderTools::ConverterFeature::Preprocess)) {
+                if(!(converter.features() >= ShaderTools::ConverterFeature::Preprocess)) {
                     Error{} << "The -E / -D / -U options are set, but" << converterName << "doesn't support preprocessing";
                     return 10;
                 }
@@ -462,36 +547,183 @@ see documentation of a particular converter for more information.)")
                         args.arrayValue<Containers::StringView>("undefine", j), nullptr);
                 }
 
-                converter->setDefinitions(definitions);
+                converter.setDefinitions(definitions);
             }
 
             if(!args.value<Containers::StringView>("optimize").isEmpty()) {
-                if(!(converter->features() >= ShaderTools::ConverterFeature::Optimize)) {
+                if(!(converter.features() >= ShaderTools::ConverterFeature::Optimize)) {
                     Error{} << "The -O option is set, but" << converterName << "doesn't support optimization";
                     return 11;
                 }
 
-                converter->setOptimizationLevel(args.value<Containers::StringView>("optimize"));
+                converter.setOptimizationLevel(args.value<Containers::StringView>("optimize"));
             }
 
             if(!args.value<Containers::StringView>("debug-info").isEmpty()) {
-                if(!(converter->features() >= ShaderTools::ConverterFeature::DebugInfo)) {
+                if(!(converter.features() >= ShaderTools::ConverterFeature::DebugInfo)) {
                     Error{} << "The -g option is set, but" << converterName << "doesn't support debug info";
                     return 12;
                 }
 
-                converter->setDebugInfoLevel(args.value<Containers::StringView>("debug-info"));
+                converter.setDebugInfoLevel(args.value<Containers::StringView>("debug-info"));
             }
+        }
 
-            if(args.isSet("link")) {
-                arrayReserve(linkInputs, args.arrayValueCount("input"));
-                for(std::size_t j = 0; j != args.arrayValueCount("input"); ++j)
-                    arrayAppend(linkInputs, InPlaceInit,
-                        ShaderTools::Stage::Unspecified, args.arrayValue<Containers::StringView>("input", j));
+        converter.addFlags(flags);
+        return 0;
+    };
+
+    /* Batch conversion, with a converter instance for each thread */
+    if(args.isSet("batch")) {
+        const std::string converterName = args.arrayValueCount("converter") ?
+            args.arrayValue("converter", 0) : "AnyShaderConverter";
+
+        UnsignedInt threadCount = args.value<UnsignedInt>("threads");
+        if(!threadCount)
+            threadCount = Math::max(std::thread::hardware_concurrency(), 1u);
+
+        Containers::Array<Containers::Pointer<ShaderTools::AbstractConverter>> converters;
+        arrayReserve(converters, threadCount);
+        for(UnsignedInt i = 0; i != threadCount; ++i) {
+            Containers::Pointer<ShaderTools::AbstractConverter> converter = converterManager.loadAndInstantiate(converterName);
+            if(!converter) {
+                Debug{} << "Available converter plugins:" << ", "_s.join(converterManager.aliasList());
+                return 7;
+            }
+
+            if(const int error = setupConverter(*converter, 0, converterName))
+                return error;
+
+            if(!(converter->features() >= ShaderTools::ConverterFeature::ConvertData)) {
+                Error{} << converterName << "doesn't support data conversion";
+                return 18; /* same code as the same message below */
+            }
+
+            arrayAppend(converters, Utility::move(converter));
+        }
+
+        const ShaderTools::ConverterFeatures features = converters[0]->features();
+        ShaderTools::BatchConverter converter{Utility::move(converters)};
+
+        /* Options that affect the output but can't be queried from the
+           converter instances are hashed as passed on the command line */
+        converter.setCacheDirectory(args.value<Containers::StringView>("cache-dir"));
+        converter.setCacheKey(Utility::format("{}\n{}\n{}\n{}\n{}\n{}\n{}",
+            args.arrayValueCount("converter-options") ? args.arrayValue<Containers::StringView>("converter-options", 0) : ""_s,
+            args.arrayValueCount("input-format") ? args.arrayValue<Containers::StringView>("input-format", 0) : ""_s,
+            args.arrayValueCount("output-format") ? args.arrayValue<Containers::StringView>("output-format", 0) : ""_s,
+            args.arrayValueCount("input-version") ? args.arrayValue<Containers::StringView>("input-version", 0) : ""_s,
+            args.arrayValueCount("output-version") ? args.arrayValue<Containers::StringView>("output-version", 0) : ""_s,
+            args.value<Containers::StringView>("optimize"),
+            args.value<Containers::StringView>("debug-info")));
+
+        const Containers::StringView batchFile = args.arrayValue<Containers::StringView>("input", 0);
+        const Containers::Optional<Containers::String> batch = Utility::Path::readString(batchFile);
+        if(!batch) {
+            Error{} << "Can't read" << batchFile;
+            return 28;
+        }
+
+        /* Each job gets the definitions from the command line, followed by
+           definitions specific to given job. The views point either to the
+           arguments or to the batch file contents, both of which stay in scope
+           until the conversion is done. */
+        Containers::Array<Containers::StringView> outputs;
+        Containers::Array<Containers::Pair<Containers::StringView, Containers::StringView>> definitions;
+        std::size_t lineNumber = 0;
+        for(const Containers::StringView line: batch->split('\n')) {
+            ++lineNumber;
+            const Containers::StringView trimmed = line.trimmed();
+            if(trimmed.isEmpty() || trimmed.hasPrefix('#')) continue;
+
+            const Containers::Array<Containers::StringView> tokens = trimmed.splitOnWhitespaceWithoutEmptyParts();
+            if(tokens.size() < 2) {
+                Error{} << "Expected an input and an output file on line" << lineNumber << "of" << batchFile;
+                return 29;
+            }
+
+            arrayResize(definitions, 0);
+            for(std::size_t j = 0; j != args.arrayValueCount("define"); ++j) {
+                const Containers::Array3<Containers::StringView> define =
+                    args.arrayValue<Containers::StringView>("define", j).partition('=');
+                arrayAppend(definitions, InPlaceInit,
+                    define[0], define[2]);
+            }
+            for(std::size_t j = 0; j != args.arrayValueCount("undefine"); ++j)
+                arrayAppend(definitions, InPlaceInit,
+                    args.arrayValue<Containers::StringView>("undefine", j), nullptr);
+            for(const Containers::StringView token: tokens.exceptPrefix(2)) {
+                if(token.hasPrefix("-D"_s)) {
+                    const Containers::Array3<Containers::StringView> define = token.exceptPrefix(2).partition('=');
+                    arrayAppend(definitions, InPlaceInit,
+                        define[0], define[2]);
+                } else if(token.hasPrefix("-U"_s)) {
+                    arrayAppend(definitions, InPlaceInit,
+                        token.exceptPrefix(2), nullptr);
+                } else {
+                    Error{} << "Unrecognized option" << token << "on line" << lineNumber << "of" << batchFile;
+                    return 29;
+                }
+            }
+            if(!definitions.isEmpty() && !(features >= ShaderTools::ConverterFeature::Preprocess)) {
+                Error{} << "Definitions are set on line" << lineNumber << "of" << batchFile << Debug::nospace << ", but" << converterName << "doesn't support preprocessing";
+                return 10; /* same code as the same message above */
+            }
+
+            const Containers::Optional<Containers::Array<char>> input = Utility::Path::read(tokens[0]);
+            if(!input) {
+                Error{} << "Can't read" << tokens[0];
+                return 30;
+            }
+
+            converter.addJob(stageForFilename(tokens[0]), Containers::arrayView(*input), definitions);
+            arrayAppend(outputs, tokens[1]);
+        }
+
+        if(args.isSet("verbose"))
+            Debug{} << "Converting" << converter.jobCount() << "shaders with" << converterName << "on" << threadCount << "threads...";
+
+        /* Save all outputs that succeeded even if some failed, so the next
+           run can pick up the rest from the cache */
+        const bool success = converter.convert();
+        for(UnsignedInt i = 0; i != converter.jobCount(); ++i) {
+            const Containers::Optional<Containers::ArrayView<const char>> output = converter.output(i);
+            if(output && !Utility::Path::write(outputs[i], *output)) {
+                Error{} << "Cannot save file" << outputs[i];
+                return 32;
             }
         }
 
-        converter->addFlags(flags);
+        if(args.isSet("verbose"))
+            Debug{} << converter.cacheHitCount() << "of" << converter.jobCount() << "shaders taken from the cache";
+
+        return success ? 0 : 31;
+    }
+
+    /* Data passed from one converter to another in case there's more than one */
+    Containers::Array<char> data;
+
+    /* If there's no converters, it'll be just one AnyShaderConverter. */
+    for(std::size_t i = 0, converterCount = args.arrayValueCount("converter"); i < Math::max(converterCount, std::size_t{1}); ++i) {
+        const std::string converterName = converterCount ?
+            args.arrayValue("converter", i) : "AnyShaderConverter";
+        Containers::Pointer<ShaderTools::AbstractConverter> converter = converterManager.loadAndInstantiate(converterName);
+        if(!converter) {
+            Debug{} << "Available converter plugins:" << ", "_s.join(converterManager.aliasList());
+            return 7;
+        }
+
+        if(const int error = setupConverter(*converter, i, converterName))
+            return error;
+
+        /* Set up file list for linking */
+        Containers::Array<Containers::Pair<ShaderTools::Stage, Containers::StringView>> linkInputs;
+        if(i == 0 && args.isSet("link")) {
+            arrayReserve(linkInputs, args.arrayValueCount("input"));
+            for(std::size_t j = 0; j != args.arrayValueCount("input"); ++j)
+                arrayAppend(linkInputs, InPlaceInit,
+                    ShaderTools::Stage::Unspecified, args.arrayValue<Containers::StringView>("input", j));
+        }
 
         /* If we want just SPIR-V info, convert to a SPIR-V and exit */
         if(args.isSet("info")) {
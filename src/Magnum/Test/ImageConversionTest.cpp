@@ -0,0 +1,501 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/ImageConversion.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Math/Vector2.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct ImageConversionTest: TestSuite::Tester {
+    explicit ImageConversionTest();
+
+    void yFlipInPlace();
+    void yFlipInPlaceThreads();
+    void yFlipInto();
+    void yFlipIntoInvalid();
+
+    void swizzleBgr8();
+    void swizzleBgr16Alpha();
+    void swizzleBgr32();
+    void swizzleBgra8Wide();
+    void swizzleBgrThreads();
+    void swizzleBgrInvalid();
+
+    void convertLessChannels();
+    void convertMoreChannels();
+    void convertMoreChannelsFloat();
+    void convertMoreChannelsIntegral();
+    void convertFloatToHalf();
+    void convertFloatToHalfWide();
+    void convertHalfToFloatLessChannels();
+    void convertUnormToFloat();
+    void convertFloatToUnormClamp();
+    void convertFloatToSnormClamp();
+    void convertThreads();
+    void convertInvalid();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+    Int height;
+} YFlipInPlaceThreadsData[]{
+    {"1 thread, odd height", 1, 7},
+    {"1 thread, even height", 1, 8},
+    {"2 threads, odd height", 2, 7},
+    {"3 threads, even height", 3, 8},
+    {"hardware concurrency", 0, 8},
+    /* More threads than rows to swap, should be clamped */
+    {"100 threads", 100, 7},
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadsData[]{
+    {"2 threads", 2},
+    {"3 threads", 3},
+    {"hardware concurrency", 0},
+    {"100 threads", 100},
+};
+
+ImageConversionTest::ImageConversionTest() {
+    addTests({&ImageConversionTest::yFlipInPlace});
+
+    addInstancedTests({&ImageConversionTest::yFlipInPlaceThreads},
+        Containers::arraySize(YFlipInPlaceThreadsData));
+
+    addTests({&ImageConversionTest::yFlipInto,
+              &ImageConversionTest::yFlipIntoInvalid,
+
+              &ImageConversionTest::swizzleBgr8,
+              &ImageConversionTest::swizzleBgr16Alpha,
+              &ImageConversionTest::swizzleBgr32,
+              &ImageConversionTest::swizzleBgra8Wide});
+
+    addInstancedTests({&ImageConversionTest::swizzleBgrThreads},
+        Containers::arraySize(ThreadsData));
+
+    addTests({&ImageConversionTest::swizzleBgrInvalid,
+
+              &ImageConversionTest::convertLessChannels,
+              &ImageConversionTest::convertMoreChannels,
+              &ImageConversionTest::convertMoreChannelsFloat,
+              &ImageConversionTest::convertMoreChannelsIntegral,
+              &ImageConversionTest::convertFloatToHalf,
+              &ImageConversionTest::convertFloatToHalfWide,
+              &ImageConversionTest::convertHalfToFloatLessChannels,
+              &ImageConversionTest::convertUnormToFloat,
+              &ImageConversionTest::convertFloatToUnormClamp,
+              &ImageConversionTest::convertFloatToSnormClamp});
+
+    addInstancedTests({&ImageConversionTest::convertThreads},
+        Containers::arraySize(ThreadsData));
+
+    addTests({&ImageConversionTest::convertInvalid});
+}
+
+void ImageConversionTest::yFlipInPlace() {
+    /* Default four-byte alignment, the padding should stay untouched */
+    char data[]{
+        'a', 'b', 'c', 'd', 'e', 'f', '0', '0',
+        'g', 'h', 'i', 'j', 'k', 'l', '1', '1',
+        'm', 'n', 'o', 'p', 'q', 'r', '2', '2'
+    };
+    yFlipImageInPlace(MutableImageView2D{PixelFormat::RGB8Unorm, {2, 3}, data});
+
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView({
+        'm', 'n', 'o', 'p', 'q', 'r', '0', '0',
+        'g', 'h', 'i', 'j', 'k', 'l', '1', '1',
+        'a', 'b', 'c', 'd', 'e', 'f', '2', '2'
+    }), TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::yFlipInPlaceThreads() {
+    auto&& data = YFlipInPlaceThreadsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    UnsignedInt pixels[8]{};
+    UnsignedInt expected[8]{};
+    for(Int i = 0; i != data.height; ++i) {
+        pixels[i] = i;
+        expected[data.height - i - 1] = i;
+    }
+
+    yFlipImageInPlace(MutableImageView2D{PixelFormat::R32UI, {1, data.height}, pixels}, data.threadCount);
+    CORRADE_COMPARE_AS(Containers::arrayView(pixels),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::yFlipInto() {
+    const char src[]{
+        'a', 'b', 'c', 'd', 'e', 'f', '0', '0',
+        'g', 'h', 'i', 'j', 'k', 'l', '1', '1',
+        'm', 'n', 'o', 'p', 'q', 'r', '2', '2'
+    };
+    char dst[18]{};
+    /* The format is different but pixel size is the same, which is fine */
+    yFlipImageInto(
+        ImageView2D{PixelFormat::RGB8Unorm, {2, 3}, src},
+        MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8UI, {2, 3}, dst});
+
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView({
+        'm', 'n', 'o', 'p', 'q', 'r',
+        'g', 'h', 'i', 'j', 'k', 'l',
+        'a', 'b', 'c', 'd', 'e', 'f'
+    }), TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::yFlipIntoInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char src[16]{};
+    char dst[16];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    yFlipImageInto(
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, src},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 4}, dst});
+    yFlipImageInto(
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, src},
+        MutableImageView2D{PixelFormat::RG8Unorm, {2, 2}, dst});
+    CORRADE_COMPARE(out.str(),
+        "yFlipImageInto(): expected destination size {2, 2} but got {1, 4}\n"
+        "yFlipImageInto(): expected destination pixel size 4 but got 2\n");
+}
+
+void ImageConversionTest::swizzleBgr8() {
+    /* Default four-byte alignment, the padding should stay untouched */
+    char data[]{
+        '0', '1', '2', '3', '4', '5', 'x', 'x',
+        '6', '7', '8', '9', 'a', 'b', 'y', 'y'
+    };
+    swizzleBgrImageInPlace(MutableImageView2D{PixelFormat::RGB8Srgb, {2, 2}, data});
+
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView({
+        '2', '1', '0', '5', '4', '3', 'x', 'x',
+        '8', '7', '6', 'b', 'a', '9', 'y', 'y'
+    }), TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::swizzleBgr16Alpha() {
+    UnsignedShort data[]{
+        1, 2, 3, 4, 5, 6, 7, 8
+    };
+    swizzleBgrImageInPlace(MutableImageView2D{PixelFormat::RGBA16Unorm, {2, 1}, data});
+
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView<UnsignedShort>({
+        3, 2, 1, 4, 7, 6, 5, 8
+    }), TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::swizzleBgr32() {
+    Float data[]{
+        1.0f, 2.0f, 3.0f,
+        4.0f, 5.0f, 6.0f
+    };
+    swizzleBgrImageInPlace(MutableImageView2D{PixelFormat::RGB32F, {1, 2}, data});
+
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView({
+        3.0f, 2.0f, 1.0f,
+        6.0f, 5.0f, 4.0f
+    }), TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::swizzleBgra8Wide() {
+    /* Wide enough to go through the SIMD variant, and with the width not
+       divisible by sixteen to test the remainder as well */
+    UnsignedByte pixels[4*37*3];
+    UnsignedByte expected[4*37*3];
+    for(std::size_t i = 0; i != Containers::arraySize(pixels); i += 4) {
+        pixels[i + 0] = expected[i + 2] = UnsignedByte(i*7);
+        pixels[i + 1] = expected[i + 1] = UnsignedByte(i*7 + 1);
+        pixels[i + 2] = expected[i + 0] = UnsignedByte(i*7 + 2);
+        pixels[i + 3] = expected[i + 3] = UnsignedByte(i*7 + 3);
+    }
+
+    swizzleBgrImageInPlace(MutableImageView2D{PixelFormat::RGBA8Unorm, {37, 3}, pixels});
+    CORRADE_COMPARE_AS(Containers::arrayView(pixels),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::swizzleBgrThreads() {
+    auto&& data = ThreadsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    UnsignedByte pixels[4*3*5];
+    UnsignedByte expected[4*3*5];
+    for(std::size_t i = 0; i != Containers::arraySize(pixels); i += 4) {
+        pixels[i + 0] = expected[i + 2] = UnsignedByte(i);
+        pixels[i + 1] = expected[i + 1] = UnsignedByte(i + 1);
+        pixels[i + 2] = expected[i + 0] = UnsignedByte(i + 2);
+        pixels[i + 3] = expected[i + 3] = UnsignedByte(i + 3);
+    }
+
+    swizzleBgrImageInPlace(MutableImageView2D{PixelFormat::RGBA8Unorm, {3, 5}, pixels}, data.threadCount);
+    CORRADE_COMPARE_AS(Containers::arrayView(pixels),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::swizzleBgrInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char data[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    swizzleBgrImageInPlace(MutableImageView2D{PixelFormat::RG8Unorm, {1, 1}, data});
+    swizzleBgrImageInPlace(MutableImageView2D{PixelStorage{}, pixelFormatWrap(0xdead), 0, 4, {1, 1}, data});
+    swizzleBgrImageInPlace(MutableImageView2D{PixelFormat::Depth32F, {1, 1}, data});
+    CORRADE_COMPARE(out.str(),
+        "swizzleBgrImageInPlace(): expected a three- or four-channel format, got PixelFormat::RG8Unorm\n"
+        "swizzleBgrImageInPlace(): can't swizzle PixelFormat::ImplementationSpecific(0xdead)\n"
+        "swizzleBgrImageInPlace(): can't swizzle PixelFormat::Depth32F\n");
+}
+
+void ImageConversionTest::convertLessChannels() {
+    const UnsignedByte src[]{
+        1, 2, 3, 4, 5, 6, 7, 8
+    };
+    UnsignedByte dst[6];
+    convertImageInto(
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, src},
+        MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 1}, dst});
+
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<UnsignedByte>({
+        1, 2, 3, 5, 6, 7
+    }), TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::convertMoreChannels() {
+    const UnsignedByte src[]{
+        1, 2, 3, 4, 5, 6
+    };
+    UnsignedByte dst[8];
+    /* sRGB is treated the same as linear, there should be no conversion */
+    convertImageInto(
+        ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA8Srgb, {2, 1}, dst});
+
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<UnsignedByte>({
+        1, 2, 3, 0xff, 4, 5, 6, 0xff
+    }), TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::convertMoreChannelsFloat() {
+    const Float src[]{
+        0.5f, 0.25f
+    };
+    Float dst[8];
+    convertImageInto(
+        ImageView2D{PixelFormat::R32F, {1, 2}, src},
+        MutableImageView2D{PixelFormat::RGBA32F, {1, 2}, dst});
+
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView({
+        0.5f, 0.0f, 0.0f, 1.0f,
+        0.25f, 0.0f, 0.0f, 1.0f
+    }), TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::convertMoreChannelsIntegral() {
+    const UnsignedShort src[]{
+        7, 8
+    };
+    UnsignedShort dst[4];
+    convertImageInto(
+        ImageView2D{PixelFormat::RG16UI, {1, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA16UI, {1, 1}, dst});
+
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<UnsignedShort>({
+        7, 8, 0, 1
+    }), TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::convertFloatToHalf() {
+    const Float src[]{
+        0.0f, 1.0f, -2.0f, 0.5f
+    };
+    UnsignedShort dst[4];
+    convertImageInto(
+        ImageView2D{PixelFormat::RGBA32F, {1, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA16F, {1, 1}, dst});
+
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<UnsignedShort>({
+        0x0000, 0x3c00, 0xc000, 0x3800
+    }), TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::convertFloatToHalfWide() {
+    /* Wide enough to go through the SIMD variant, and with the width not
+       divisible by four to test the remainder as well. Should give the exact
+       same result as the batch API for everything including specials,
+       denormals, values rounded towards zero and overflows. */
+    Float src[4*37*3];
+    const Float specials[]{
+        Constants::nan(), -Constants::nan(), Constants::inf(), -Constants::inf(),
+        0.0f, -0.0f, 1.0e-40f, 65504.0f, 65536.0f, -1.0e10f, 6.1e-5f,
+        5.97e-8f, -2.9e-8f, 1.0f/3.0f
+    };
+    for(std::size_t i = 0; i != Containers::arraySize(src); ++i)
+        src[i] = i % 3 ? Float(i*i*0.731f - 3000.0f) : specials[(i/3) % Containers::arraySize(specials)];
+
+    UnsignedShort expected[4*37*3];
+    Math::packHalfInto(
+        Containers::StridedArrayView2D<const Float>{src, {Containers::arraySize(src), 1}},
+        Containers::StridedArrayView2D<UnsignedShort>{expected, {Containers::arraySize(expected), 1}});
+
+    UnsignedShort dst[4*37*3];
+    convertImageInto(
+        ImageView2D{PixelFormat::RGBA32F, {37, 3}, src},
+        MutableImageView2D{PixelFormat::RGBA16F, {37, 3}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::convertHalfToFloatLessChannels() {
+    const UnsignedShort src[]{
+        0x3c00, 0x3800, 0xc000, 0x0000
+    };
+    Float dst[2];
+    convertImageInto(
+        ImageView2D{PixelFormat::RGBA16F, {1, 1}, src},
+        MutableImageView2D{PixelFormat::RG32F, {1, 1}, dst});
+
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView({
+        1.0f, 0.5f
+    }), TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::convertUnormToFloat() {
+    const UnsignedByte src[]{
+        0x00, 0xff, 0x33, 0
+    };
+    Float dst[4];
+    convertImageInto(
+        ImageView2D{PixelFormat::RGB8Unorm, {1, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA32F, {1, 1}, dst});
+
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView({
+        0.0f, 1.0f, 0.2f, 1.0f
+    }), TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::convertFloatToUnormClamp() {
+    const Float src[]{
+        -0.5f, 1.5f, 0.2f
+    };
+    UnsignedByte dst[4];
+    convertImageInto(
+        ImageView2D{PixelFormat::R32F, {3, 1}, src},
+        MutableImageView2D{PixelFormat::R8Unorm, {3, 1}, dst});
+
+    CORRADE_COMPARE_AS(Containers::arrayView(dst).prefix(3), Containers::arrayView<UnsignedByte>({
+        0, 255, 51
+    }), TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::convertFloatToSnormClamp() {
+    const Float src[]{
+        -1.5f, 1.5f, 0.0f, -1.0f
+    };
+    Short dst[4];
+    convertImageInto(
+        ImageView2D{PixelFormat::RG32F, {2, 1}, src},
+        MutableImageView2D{PixelFormat::RG16Snorm, {2, 1}, dst});
+
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Short>({
+        -32767, 32767, 0, -32767
+    }), TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::convertThreads() {
+    auto&& data = ThreadsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Odd row size to have the destination padded */
+    UnsignedByte src[3*5*9];
+    for(std::size_t i = 0; i != Containers::arraySize(src); ++i)
+        src[i] = UnsignedByte(i*37);
+    const ImageView2D srcImage{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {5, 9}, src};
+
+    UnsignedShort expected[4*5*9];
+    UnsignedShort dst[4*5*9];
+    convertImageInto(srcImage, MutableImageView2D{PixelFormat::RGBA16F, {5, 9}, expected});
+    convertImageInto(srcImage, MutableImageView2D{PixelFormat::RGBA16F, {5, 9}, dst}, data.threadCount);
+
+    CORRADE_COMPARE_AS(Containers::arrayView(dst),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void ImageConversionTest::convertInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char src[16]{};
+    char dst[16];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    convertImageInto(
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, src},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 4}, dst});
+    convertImageInto(
+        ImageView2D{PixelStorage{}, pixelFormatWrap(0xdead), 0, 4, {2, 2}, src},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, dst});
+    convertImageInto(
+        ImageView2D{PixelFormat::R32F, {2, 2}, src},
+        MutableImageView2D{PixelFormat::Depth32F, {2, 2}, dst});
+    convertImageInto(
+        ImageView2D{PixelFormat::RGBA8UI, {2, 2}, src},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, dst});
+    convertImageInto(
+        ImageView2D{PixelFormat::R32F, {2, 2}, src},
+        MutableImageView2D{PixelFormat::R32I, {2, 2}, dst});
+    CORRADE_COMPARE(out.str(),
+        "convertImageInto(): expected destination size {2, 2} but got {1, 4}\n"
+        "convertImageInto(): can't convert PixelFormat::ImplementationSpecific(0xdead) to PixelFormat::RGBA8Unorm\n"
+        "convertImageInto(): can't convert PixelFormat::R32F to PixelFormat::Depth32F\n"
+        "convertImageInto(): can't convert PixelFormat::RGBA8UI to PixelFormat::RGBA8Unorm\n"
+        "convertImageInto(): can't convert PixelFormat::R32F to PixelFormat::R32I\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::ImageConversionTest)
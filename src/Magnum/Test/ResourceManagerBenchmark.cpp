@@ -0,0 +1,147 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2019 Daniel Guzman <daniel.guzman85@gmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/ResourceManager.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct ResourceManagerBenchmark: TestSuite::Tester {
+    explicit ResourceManagerBenchmark();
+
+    void get();
+    void dereferenceFinal();
+    void dereferenceMutable();
+    void dereferenceMutableChurn();
+    void setFreeChurn();
+};
+
+/* Big enough to not fit into L1 */
+constexpr std::size_t ResourceCount = 20000;
+
+ResourceManagerBenchmark::ResourceManagerBenchmark() {
+    addBenchmarks({&ResourceManagerBenchmark::get,
+                   &ResourceManagerBenchmark::dereferenceFinal,
+                   &ResourceManagerBenchmark::dereferenceMutable,
+                   &ResourceManagerBenchmark::dereferenceMutableChurn,
+                   &ResourceManagerBenchmark::setFreeChurn}, 10);
+}
+
+typedef Magnum::ResourceManager<Int> ResourceManager;
+
+void ResourceManagerBenchmark::get() {
+    ResourceManager rm;
+    for(std::size_t i = 0; i != ResourceCount; ++i)
+        rm.set(ResourceKey{i}, Int(i));
+
+    std::size_t sum = 0;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != ResourceCount; ++i)
+            sum += *rm.get<Int>(ResourceKey{i});
+    }
+
+    CORRADE_VERIFY(sum);
+}
+
+void ResourceManagerBenchmark::dereferenceFinal() {
+    ResourceManager rm;
+    Containers::Array<Resource<Int>> resources;
+    for(std::size_t i = 0; i != ResourceCount; ++i) {
+        rm.set(ResourceKey{i}, Int(i), ResourceDataState::Final, ResourcePolicy::Resident);
+        arrayAppend(resources, rm.get<Int>(ResourceKey{i}));
+    }
+
+    std::size_t sum = 0;
+    CORRADE_BENCHMARK(10) {
+        for(Resource<Int>& resource: resources)
+            sum += *resource;
+    }
+
+    CORRADE_VERIFY(sum);
+}
+
+void ResourceManagerBenchmark::dereferenceMutable() {
+    ResourceManager rm;
+    Containers::Array<Resource<Int>> resources;
+    for(std::size_t i = 0; i != ResourceCount; ++i) {
+        rm.set(ResourceKey{i}, Int(i), ResourceDataState::Mutable, ResourcePolicy::Resident);
+        arrayAppend(resources, rm.get<Int>(ResourceKey{i}));
+    }
+
+    std::size_t sum = 0;
+    CORRADE_BENCHMARK(10) {
+        for(Resource<Int>& resource: resources)
+            sum += *resource;
+    }
+
+    CORRADE_VERIFY(sum);
+}
+
+void ResourceManagerBenchmark::dereferenceMutableChurn() {
+    ResourceManager rm;
+    Containers::Array<Resource<Int>> resources;
+    for(std::size_t i = 0; i != ResourceCount; ++i) {
+        rm.set(ResourceKey{i}, Int(i), ResourceDataState::Mutable, ResourcePolicy::Resident);
+        arrayAppend(resources, rm.get<Int>(ResourceKey{i}));
+    }
+
+    /* Update one unrelated resource before each pass, which used to cause
+       all resources to be looked up again */
+    std::size_t sum = 0;
+    Int counter = 0;
+    CORRADE_BENCHMARK(10) {
+        rm.set("streamed", ++counter, ResourceDataState::Mutable, ResourcePolicy::Resident);
+        for(Resource<Int>& resource: resources)
+            sum += *resource;
+    }
+
+    CORRADE_VERIFY(sum);
+}
+
+void ResourceManagerBenchmark::setFreeChurn() {
+    ResourceManager rm;
+    for(std::size_t i = 0; i != ResourceCount; ++i)
+        rm.set(ResourceKey{i}, Int(i), ResourceDataState::Mutable, ResourcePolicy::Resident);
+
+    /* Streaming in and out reference-counted resources, keeping the slot and
+       index storage busy */
+    std::size_t sum = 0;
+    std::size_t next = ResourceCount;
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != 1000; ++i, ++next) {
+            rm.set(ResourceKey{next}, Int(i), ResourceDataState::Final, ResourcePolicy::ReferenceCounted);
+            sum += *rm.get<Int>(ResourceKey{next});
+        }
+    }
+
+    CORRADE_COMPARE(rm.count<Int>(), ResourceCount);
+    CORRADE_VERIFY(sum);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::ResourceManagerBenchmark)
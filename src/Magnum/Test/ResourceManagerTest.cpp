@@ -25,12 +25,18 @@
 */
 
 #include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/FormatStl.h>
 
 #include "Magnum/AbstractResourceLoader.h"
 #include "Magnum/ResourceManager.h"
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <atomic>
+#include <thread>
+#endif
+
 namespace Magnum { namespace Test { namespace {
 
 struct ResourceManagerTest: TestSuite::Tester {
@@ -53,9 +59,16 @@ struct ResourceManagerTest: TestSuite::Tester {
     void defaults();
     void clear();
     void clearWhileReferenced();
+    void manyResources();
+    void slotReuse();
 
     void loader();
     void loaderSetNullptr();
+    void loaderFinishOnMainThreadSync();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void loaderAsync();
+    void loaderAsyncStop();
+    #endif
 
     void debugResourceState();
     void debugResourceKey();
@@ -90,9 +103,16 @@ ResourceManagerTest::ResourceManagerTest() {
               &ResourceManagerTest::defaults,
               &ResourceManagerTest::clear,
               &ResourceManagerTest::clearWhileReferenced,
+              &ResourceManagerTest::manyResources,
+              &ResourceManagerTest::slotReuse,
 
               &ResourceManagerTest::loader,
               &ResourceManagerTest::loaderSetNullptr,
+              &ResourceManagerTest::loaderFinishOnMainThreadSync,
+              #ifndef CORRADE_TARGET_EMSCRIPTEN
+              &ResourceManagerTest::loaderAsync,
+              &ResourceManagerTest::loaderAsyncStop,
+              #endif
 
               &ResourceManagerTest::debugResourceState,
               &ResourceManagerTest::debugResourceKey});
@@ -426,6 +446,63 @@ void ResourceManagerTest::clearWhileReferenced() {
     CORRADE_COMPARE(out.str(), "ResourceManager: cleared/destroyed while data are still referenced\n");
 }
 
+void ResourceManagerTest::manyResources() {
+    ResourceManager rm;
+
+    /* Enough to make the index grow several times */
+    for(std::size_t i = 0; i != 1000; ++i)
+        rm.set(ResourceKey{i}, Int(i), ResourceDataState::Mutable, ResourcePolicy::Manual);
+    CORRADE_COMPARE(rm.count<Int>(), 1000);
+
+    /* Keep every third referenced and free the rest, which removes entries
+       from the middle of probe sequences */
+    Containers::Array<Resource<Int>> resources;
+    for(std::size_t i = 0; i < 1000; i += 3)
+        arrayAppend(resources, rm.get<Int>(ResourceKey{i}));
+    rm.free();
+    CORRADE_COMPARE(rm.count<Int>(), 334);
+
+    /* All remaining ones are still reachable */
+    for(std::size_t i = 0; i != 1000; ++i) {
+        CORRADE_ITERATION(i);
+        if(i % 3) {
+            CORRADE_COMPARE(rm.state<Int>(ResourceKey{i}), ResourceState::NotLoaded);
+        } else {
+            CORRADE_COMPARE(rm.state<Int>(ResourceKey{i}), ResourceState::Mutable);
+            CORRADE_COMPARE(*resources[i/3], Int(i));
+        }
+    }
+
+    /* Updating one resource is seen only by that resource */
+    rm.set(ResourceKey{std::size_t{999}}, 7, ResourceDataState::Mutable, ResourcePolicy::Manual);
+    CORRADE_COMPARE(*resources[333], 7);
+    CORRADE_COMPARE(*resources[332], 996);
+}
+
+void ResourceManagerTest::slotReuse() {
+    ResourceManager rm;
+
+    Resource<Data> a = rm.get<Data>("a");
+
+    /* Reference-counted resources get freed immediately, reusing the slot
+       with a different generation */
+    for(std::size_t i = 0; i != 10; ++i) {
+        rm.set(ResourceKey{i}, Containers::pointer<Data>(), ResourceDataState::Final, ResourcePolicy::ReferenceCounted);
+        Resource<Data> data = rm.get<Data>(ResourceKey{i});
+        CORRADE_COMPARE(data.state(), ResourceState::Final);
+        CORRADE_COMPARE(rm.count<Data>(), 2);
+        CORRADE_COMPARE(Data::count, 1);
+    }
+    CORRADE_COMPARE(rm.count<Data>(), 1);
+    CORRADE_COMPARE(Data::count, 0);
+
+    /* The long-lived resource is not affected */
+    CORRADE_COMPARE(a.state(), ResourceState::NotLoaded);
+    rm.set("a", Containers::pointer<Data>());
+    CORRADE_COMPARE(a.state(), ResourceState::Final);
+    CORRADE_COMPARE(Data::count, 1);
+}
+
 void ResourceManagerTest::loader() {
     class IntResourceLoader: public AbstractResourceLoader<Int> {
         public:
@@ -530,6 +607,150 @@ void ResourceManagerTest::loaderSetNullptr() {
     CORRADE_COMPARE(*world, 42);
 }
 
+void ResourceManagerTest::loaderFinishOnMainThreadSync() {
+    class IntResourceLoader: public AbstractResourceLoader<Int> {
+        void doLoad(ResourceKey key) override {
+            finishOnMainThread(key);
+        }
+
+        void doFinish(ResourceKey key) override {
+            set(key, 1337);
+        }
+    };
+
+    ResourceManager rm;
+    rm.setLoader<Int>(Containers::pointer<IntResourceLoader>());
+    CORRADE_COMPARE(rm.loader<Int>()->workerThreadCount(), 0);
+
+    /* Without worker threads the finish happens directly */
+    Resource<Int> hello = rm.get<Int>("hello");
+    CORRADE_COMPARE(hello.state(), ResourceState::Final);
+    CORRADE_COMPARE(*hello, 1337);
+    CORRADE_COMPARE(rm.loader<Int>()->pendingCount(), 0);
+    CORRADE_COMPARE(rm.update(), 0);
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void ResourceManagerTest::loaderAsync() {
+    class IntResourceLoader: public AbstractResourceLoader<Int> {
+        public:
+            explicit IntResourceLoader(std::thread::id mainThread): mainThread{mainThread} {}
+
+            std::atomic<std::size_t> loadCount{};
+            std::atomic<std::size_t> workerThreadLoadCount{};
+            std::thread::id mainThread;
+            bool finishedOnMainThread = false;
+
+        private:
+            void doLoad(ResourceKey key) override {
+                if(std::this_thread::get_id() != mainThread)
+                    ++workerThreadLoadCount;
+
+                if(key == ResourceKey{"missing"})
+                    setNotFound(key);
+                else if(key == ResourceKey{"deferred"})
+                    finishOnMainThread(key);
+                else
+                    set(key, 42);
+
+                ++loadCount;
+            }
+
+            void doFinish(ResourceKey key) override {
+                finishedOnMainThread = std::this_thread::get_id() == mainThread;
+                set(key, 1337);
+            }
+    };
+
+    ResourceManager rm;
+    Containers::Pointer<IntResourceLoader> loaderPtr{InPlaceInit, std::this_thread::get_id()};
+    IntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    loader.setWorkerThreadCount(2);
+    CORRADE_COMPARE(loader.workerThreadCount(), 2);
+
+    Resource<Int> a = rm.get<Int>("a");
+    Resource<Int> b = rm.get<Int>("b");
+    Resource<Int> missing = rm.get<Int>("missing");
+    Resource<Int> deferred = rm.get<Int>("deferred");
+    CORRADE_COMPARE(loader.requestedCount(), 4);
+
+    /* Wait until the workers are done. The pending count includes also the
+       jobs that are still running, so after all finish it's just the four
+       results waiting for update(). */
+    while(loader.loadCount != 4 || loader.pendingCount() != 4)
+        std::this_thread::yield();
+    CORRADE_COMPARE(loader.workerThreadLoadCount.load(), 4);
+
+    /* Nothing gets to the manager until update() is called */
+    CORRADE_COMPARE(a.state(), ResourceState::Loading);
+    CORRADE_COMPARE(b.state(), ResourceState::Loading);
+    CORRADE_COMPARE(missing.state(), ResourceState::Loading);
+    CORRADE_COMPARE(deferred.state(), ResourceState::Loading);
+    CORRADE_COMPARE(loader.loadedCount(), 0);
+    CORRADE_COMPARE(loader.notFoundCount(), 0);
+
+    /* The updates are budgeted */
+    CORRADE_COMPARE(rm.update(1), 1);
+    CORRADE_COMPARE(loader.pendingCount(), 3);
+    CORRADE_COMPARE(rm.update<Int>(2), 2);
+    CORRADE_COMPARE(loader.pendingCount(), 1);
+    CORRADE_COMPARE(rm.update(), 1);
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+    CORRADE_COMPARE(rm.update(), 0);
+
+    CORRADE_COMPARE(a.state(), ResourceState::Final);
+    CORRADE_COMPARE(*a, 42);
+    CORRADE_COMPARE(b.state(), ResourceState::Final);
+    CORRADE_COMPARE(*b, 42);
+    CORRADE_COMPARE(missing.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(deferred.state(), ResourceState::Final);
+    CORRADE_COMPARE(*deferred, 1337);
+    CORRADE_VERIFY(loader.finishedOnMainThread);
+    CORRADE_COMPARE(loader.requestedCount(), 4);
+    CORRADE_COMPARE(loader.loadedCount(), 3);
+    CORRADE_COMPARE(loader.notFoundCount(), 1);
+}
+
+void ResourceManagerTest::loaderAsyncStop() {
+    class IntResourceLoader: public AbstractResourceLoader<Int> {
+        void doLoad(ResourceKey key) override {
+            set(key, 42);
+        }
+    };
+
+    ResourceManager rm;
+    Containers::Pointer<IntResourceLoader> loaderPtr{InPlaceInit};
+    IntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    loader.setWorkerThreadCount(3);
+    Resource<Int> a = rm.get<Int>("a");
+    Resource<Int> b = rm.get<Int>("b");
+    Resource<Int> c = rm.get<Int>("c");
+
+    /* Stopping the workers waits for all of them and passes the results to
+       the manager */
+    loader.setWorkerThreadCount(0);
+    CORRADE_COMPARE(loader.workerThreadCount(), 0);
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+    CORRADE_COMPARE(loader.loadedCount(), 3);
+    CORRADE_COMPARE(a.state(), ResourceState::Final);
+    CORRADE_COMPARE(b.state(), ResourceState::Final);
+    CORRADE_COMPARE(c.state(), ResourceState::Final);
+
+    /* Loading is synchronous again */
+    Resource<Int> d = rm.get<Int>("d");
+    CORRADE_COMPARE(d.state(), ResourceState::Final);
+
+    /* Destroying the manager with loads in flight shouldn't leak or crash */
+    loader.setWorkerThreadCount(1);
+    Resource<Int> e = rm.get<Int>("e");
+    CORRADE_COMPARE(e.state(), ResourceState::Loading);
+}
+#endif
+
 void ResourceManagerTest::debugResourceState() {
     std::ostringstream out;
     Debug{&out} << ResourceState::Loading << ResourceState(0xbe);
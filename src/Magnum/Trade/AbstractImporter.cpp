@@ -1629,6 +1629,7 @@ Debug& operator<<(Debug& debug, const ImporterFeature value) {
         _c(OpenData)
         _c(OpenState)
         _c(FileCallback)
+        _c(ConcurrentDataAccess)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -1640,7 +1641,8 @@ Debug& operator<<(Debug& debug, const ImporterFeatures value) {
     return Containers::enumSetDebugOutput(debug, value, debug.immediateFlags() >= Debug::Flag::Packed ? "{}" : "Trade::ImporterFeatures{}", {
         ImporterFeature::OpenData,
         ImporterFeature::OpenState,
-        ImporterFeature::FileCallback});
+        ImporterFeature::FileCallback,
+        ImporterFeature::ConcurrentDataAccess});
 }
 
 Debug& operator<<(Debug& debug, const ImporterFlag value) {
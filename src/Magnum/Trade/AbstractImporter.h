@@ -72,7 +72,15 @@ enum class ImporterFeature: UnsignedByte {
      * See @ref Trade-AbstractImporter-usage-callbacks and particular importer
      * documentation for more information.
      */
-    FileCallback = 1 << 2
+    FileCallback = 1 << 2,
+
+    /**
+     * Data of an opened file can be queried concurrently from multiple
+     * threads. See @ref Trade-AbstractImporter-usage-concurrent for more
+     * information.
+     * @m_since_latest
+     */
+    ConcurrentDataAccess = 1 << 3
 };
 
 /**
@@ -364,6 +372,26 @@ Besides exposing internal state, importers that support the
 state using @ref openState(). See documentation of a particular importer for
 details about concrete types returned and accepted by these functions.
 
+@subsection Trade-AbstractImporter-usage-concurrent Concurrent data access
+
+An importer instance is by default meant to be used from a single thread only.
+Importers that advertise @ref ImporterFeature::ConcurrentDataAccess however
+allow the data of an opened file to be queried from multiple threads at the
+same time, which means a file with many meshes or images has to be opened and
+parsed only once, with the actual imports then spread across a thread pool:
+
+@snippet Trade.cpp AbstractImporter-usage-concurrent
+
+The guarantee covers all const-like queries --- the @ref defaultScene(),
+`*Count()`, `*ForName()` and `*Name()` functions, the data accessors such as
+@ref mesh(), @ref image2D() or @ref material() and @ref importerState(). It
+doesn't cover @ref openData(), @ref openFile(), @ref close(), changing flags
+or file callbacks and importer configuration, which all still need to be
+called with no other thread accessing the instance. If a file callback is set,
+it has to be thread-safe as well. As some importers such as
+@ref AnySceneImporter advertise the feature based on the plugin they delegate
+to, query @ref features() only after a file is opened.
+
 @section Trade-AbstractImporter-data-dependency Data dependency
 
 The `*Data` instances returned from various functions *by design* have no
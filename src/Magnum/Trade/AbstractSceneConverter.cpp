@@ -1748,6 +1748,7 @@ Debug& operator<<(Debug& debug, const SceneConverterFeature value) {
         _c(AddCompressedImages3D)
         _c(MeshLevels)
         _c(ImageLevels)
+        _c(StreamToFile)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -1782,7 +1783,8 @@ Debug& operator<<(Debug& debug, const SceneConverterFeatures value) {
         SceneConverterFeature::AddCompressedImages2D,
         SceneConverterFeature::AddCompressedImages3D,
         SceneConverterFeature::MeshLevels,
-        SceneConverterFeature::ImageLevels});
+        SceneConverterFeature::ImageLevels,
+        SceneConverterFeature::StreamToFile});
 }
 
 Debug& operator<<(Debug& debug, const SceneConverterFlag value) {
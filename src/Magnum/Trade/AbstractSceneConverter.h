@@ -261,7 +261,20 @@ enum class SceneConverterFeature: UnsignedInt {
      * supported.
      * @m_since_latest
      */
-    ImageLevels = 1 << 23
+    ImageLevels = 1 << 23,
+
+    /**
+     * Data passed to @ref AbstractSceneConverter::add() during a
+     * @ref AbstractSceneConverter::beginFile() conversion are written to the
+     * file right away. The converter doesn't keep any reference to or copy of
+     * the added data after the function returns, so the memory use doesn't
+     * depend on the total size of the output. Advertised only together with
+     * @ref SceneConverterFeature::ConvertMultipleToFile. See
+     * @ref Trade-AbstractSceneConverter-usage-multiple-streaming for more
+     * information.
+     * @m_since_latest
+     */
+    StreamToFile = 1 << 24
 };
 
 /**
@@ -698,6 +711,19 @@ duplicates from all meshes before saving them to the output:
 
 @snippet Trade.cpp AbstractSceneConverter-usage-multiple-file-selective
 
+@subsubsection Trade-AbstractSceneConverter-usage-multiple-streaming Bounded-memory conversion
+
+By default, a converter may accumulate all data passed to @ref add() and
+produce the output only in @ref endFile(), which means the peak memory use is
+proportional to the size of the whole output. Converters that advertise
+@ref SceneConverterFeature::StreamToFile write each added item to the file
+immediately and don't reference it afterwards, so the input can be discarded
+right after @ref add() returns. With the @ref addImporterContents() workflow
+shown above, every item is imported, added and discarded one by one, so the
+whole conversion then needs only as much memory as the largest item:
+
+@snippet Trade.cpp AbstractSceneConverter-usage-multiple-streaming
+
 <b></b>
 
 @m_class{m-note m-success}
@@ -757,7 +783,11 @@ checked by the implementation:
 -   The @ref doBeginData() and @ref doEndData() functions are called only if
     @ref SceneConverterFeature::ConvertMultipleToData is supported.
 -   The @ref doBeginFile() and @ref doEndFile() functions are called only if
-    @ref SceneConverterFeature::ConvertMultipleToFile is supported.
+    @ref SceneConverterFeature::ConvertMultipleToFile is supported. If the
+    plugin advertises @ref SceneConverterFeature::StreamToFile, it's expected
+    to implement both and write the data out already in @ref doAdd() instead
+    of relying on the default delegation to @ref doBeginData() /
+    @ref doEndData().
 -   The @ref doEnd(), @ref doEndData(), @ref doEndFile(), @ref doAbort() and
     @ref doAdd() functions are called only if a corresponding @ref begin(),
     @ref beginData() or @ref beginFile() was called before and @ref abort()
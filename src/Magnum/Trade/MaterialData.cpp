@@ -63,6 +63,25 @@ constexpr struct {
 };
 #endif
 
+/* Builtin attribute indices into AttributeMap ordered by their name, used to
+   map attribute names of a material back to MaterialAttribute values when
+   populating the lookup table. Calculated just once, the function-local static
+   initialization is thread-safe. */
+const UnsignedByte* attributeMapSortedByName() {
+    static const struct Sorted {
+        Sorted() {
+            for(std::size_t i = 0; i != Containers::arraySize(AttributeMap); ++i)
+                indices[i] = i;
+            std::sort(indices, indices + Containers::arraySize(AttributeMap), [](UnsignedByte a, UnsignedByte b) {
+                return AttributeMap[a].name < AttributeMap[b].name;
+            });
+        }
+
+        UnsignedByte indices[Containers::arraySize(AttributeMap)];
+    } sorted;
+    return sorted.indices;
+}
+
 }
 
 namespace Implementation {
@@ -324,6 +343,8 @@ MaterialData::MaterialData(const MaterialTypes types, Containers::Array<Material
 
     CORRADE_ASSERT(layerOffsets.back() == _data.size(),
         "Trade::MaterialData: last layer offset" << layerOffsets.back() << "too short for" << _data.size() << "attributes in total", );
+
+    populateAttributeLookupInternal();
 }
 
 MaterialData::MaterialData(const MaterialTypes types, const std::initializer_list<MaterialAttributeData> attributeData, const std::initializer_list<UnsignedInt> layerData, const void* const importerState): MaterialData{types, Implementation::initializerListToArrayWithDefaultDeleter(attributeData), Implementation::initializerListToArrayWithDefaultDeleter(layerData), importerState} {}
@@ -365,6 +386,8 @@ MaterialData::MaterialData(const MaterialTypes types, const DataFlags attributeD
     CORRADE_ASSERT(layerOffsets.back() == _data.size(),
         "Trade::MaterialData: last layer offset" << layerOffsets.back() << "too short for" << _data.size() << "attributes in total", );
     #endif
+
+    populateAttributeLookupInternal();
 }
 
 MaterialData::MaterialData(MaterialData&&) noexcept = default;
@@ -635,6 +658,57 @@ UnsignedInt MaterialData::findAttributeIdInternal(const UnsignedInt layer, const
     return found - begin;
 }
 
+UnsignedInt MaterialData::findAttributeIdInternal(const UnsignedInt layer, const MaterialAttribute name) const {
+    /* The public APIs assert on invalid names, but in CORRADE_NO_ASSERT
+       builds those would index both the lookup table and the attribute map
+       out of bounds. Treat them as not found instead, consistently with
+       what the string lookup does with names that aren't present. */
+    if(UnsignedInt(name) - 1 >= Containers::arraySize(AttributeMap))
+        return ~UnsignedInt{};
+
+    if(_attributeLookup) {
+        const UnsignedByte id = _attributeLookup[layer*Containers::arraySize(AttributeMap) + UnsignedInt(name) - 1];
+        /* 0 means the attribute isn't present, which wraps around to
+           ~UnsignedInt{} here */
+        if(id != 0xff) return UnsignedInt(id) - 1;
+    }
+
+    /* The lookup table isn't populated or the attribute index doesn't fit
+       into it, fall back to a binary search */
+    return findAttributeIdInternal(layer, AttributeMap[UnsignedInt(name) - 1].name);
+}
+
+void MaterialData::populateAttributeLookupInternal() {
+    /* Not allocating anything for materials without any attributes */
+    if(_data.isEmpty()) return;
+
+    /* For every layer and every builtin attribute the table contains 0 if the
+       attribute isn't present, its ID + 1 if it's less than 254 and 0xff
+       otherwise, in which case the lookup falls back to a binary search */
+    constexpr std::size_t AttributeCount = Containers::arraySize(AttributeMap);
+    const UnsignedByte* const sorted = attributeMapSortedByName();
+    const UnsignedInt layerCount = this->layerCount();
+    _attributeLookup = Containers::Array<UnsignedByte>{ValueInit, layerCount*AttributeCount};
+    for(UnsignedInt layer = 0; layer != layerCount; ++layer) {
+        const UnsignedInt offset = layerOffset(layer);
+        const UnsignedInt end = _layerOffsets ? _layerOffsets[layer] : _data.size();
+        UnsignedByte* const lookup = _attributeLookup + layer*AttributeCount;
+        for(UnsignedInt i = offset; i != end; ++i) {
+            /* Custom attributes won't be found, builtin ones are looked up
+               by their name */
+            const Containers::StringView name = _data[i].name();
+            const UnsignedByte* const found = std::lower_bound(sorted, sorted + AttributeCount, name, [](UnsignedByte a, const Containers::StringView& b) {
+                return AttributeMap[a].name < b;
+            });
+            if(found == sorted + AttributeCount || AttributeMap[*found].name != name)
+                continue;
+
+            const UnsignedInt id = i - offset;
+            lookup[*found] = id < 0xfe ? id + 1 : 0xff;
+        }
+    }
+}
+
 bool MaterialData::hasAttribute(const UnsignedInt layer, const Containers::StringView name) const {
     CORRADE_ASSERT(layer < layerCount(),
         "Trade::MaterialData::hasAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
@@ -642,9 +716,11 @@ bool MaterialData::hasAttribute(const UnsignedInt layer, const Containers::Strin
 }
 
 bool MaterialData::hasAttribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::hasAttribute(): invalid name" << name, {});
-    return hasAttribute(layer, string);
+    CORRADE_ASSERT(UnsignedInt(name) - 1 < Containers::arraySize(AttributeMap),
+        "Trade::MaterialData::hasAttribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::hasAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    return findAttributeIdInternal(layer, name) != ~UnsignedInt{};
 }
 
 bool MaterialData::hasAttribute(const Containers::StringView layer, const Containers::StringView name) const {
@@ -655,9 +731,12 @@ bool MaterialData::hasAttribute(const Containers::StringView layer, const Contai
 }
 
 bool MaterialData::hasAttribute(const Containers::StringView layer, const MaterialAttribute name) const {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::hasAttribute(): invalid name" << name, {});
-    return hasAttribute(layer, string);
+    CORRADE_ASSERT(UnsignedInt(name) - 1 < Containers::arraySize(AttributeMap),
+        "Trade::MaterialData::hasAttribute(): invalid name" << name, {});
+    const UnsignedInt layerId = findLayerIdInternal(layer);
+    CORRADE_ASSERT(layerId != ~UnsignedInt{},
+        "Trade::MaterialData::hasAttribute(): layer" << layer << "not found", {});
+    return findAttributeIdInternal(layerId, name) != ~UnsignedInt{};
 }
 
 bool MaterialData::hasAttribute(const MaterialLayer layer, const Containers::StringView name) const {
@@ -680,9 +759,12 @@ Containers::Optional<UnsignedInt> MaterialData::findAttributeId(const UnsignedIn
 }
 
 Containers::Optional<UnsignedInt> MaterialData::findAttributeId(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::findAttributeId(): invalid name" << name, {});
-    return findAttributeId(layer, string);
+    CORRADE_ASSERT(UnsignedInt(name) - 1 < Containers::arraySize(AttributeMap),
+        "Trade::MaterialData::findAttributeId(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::findAttributeId(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = findAttributeIdInternal(layer, name);
+    return id == ~UnsignedInt{} ? Containers::Optional<UnsignedInt>{} : id;
 }
 
 Containers::Optional<UnsignedInt> MaterialData::findAttributeId(const Containers::StringView layer, const Containers::StringView name) const {
@@ -694,9 +776,13 @@ Containers::Optional<UnsignedInt> MaterialData::findAttributeId(const Containers
 }
 
 Containers::Optional<UnsignedInt> MaterialData::findAttributeId(const Containers::StringView layer, const MaterialAttribute name) const {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::findAttributeId(): invalid name" << name, {});
-    return findAttributeId(layer, string);
+    CORRADE_ASSERT(UnsignedInt(name) - 1 < Containers::arraySize(AttributeMap),
+        "Trade::MaterialData::findAttributeId(): invalid name" << name, {});
+    const UnsignedInt layerId = findLayerIdInternal(layer);
+    CORRADE_ASSERT(layerId != ~UnsignedInt{},
+        "Trade::MaterialData::findAttributeId(): layer" << layer << "not found", {});
+    const UnsignedInt id = findAttributeIdInternal(layerId, name);
+    return id == ~UnsignedInt{} ? Containers::Optional<UnsignedInt>{} : id;
 }
 
 Containers::Optional<UnsignedInt> MaterialData::findAttributeId(const MaterialLayer layer, const Containers::StringView name) const {
@@ -729,9 +815,14 @@ UnsignedInt MaterialData::attributeId(const UnsignedInt layer, const Containers:
 }
 
 UnsignedInt MaterialData::attributeId(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::attributeId(): invalid name" << name, {});
-    return attributeId(layer, string);
+    CORRADE_ASSERT(UnsignedInt(name) - 1 < Containers::arraySize(AttributeMap),
+        "Trade::MaterialData::attributeId(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attributeId(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = findAttributeIdInternal(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attributeId(): attribute" << AttributeMap[UnsignedInt(name) - 1].name << "not found in layer" << layer, {});
+    return id;
 }
 
 UnsignedInt MaterialData::attributeId(const Containers::StringView layer, const Containers::StringView name) const {
@@ -745,9 +836,15 @@ UnsignedInt MaterialData::attributeId(const Containers::StringView layer, const
 }
 
 UnsignedInt MaterialData::attributeId(const Containers::StringView layer, const MaterialAttribute name) const {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::attributeId(): invalid name" << name, {});
-    return attributeId(layer, string);
+    CORRADE_ASSERT(UnsignedInt(name) - 1 < Containers::arraySize(AttributeMap),
+        "Trade::MaterialData::attributeId(): invalid name" << name, {});
+    const UnsignedInt layerId = findLayerIdInternal(layer);
+    CORRADE_ASSERT(layerId != ~UnsignedInt{},
+        "Trade::MaterialData::attributeId(): layer" << layer << "not found", {});
+    const UnsignedInt id = findAttributeIdInternal(layerId, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attributeId(): attribute" << AttributeMap[UnsignedInt(name) - 1].name << "not found in layer" << layer, {});
+    return id;
 }
 
 UnsignedInt MaterialData::attributeId(const MaterialLayer layer, const Containers::StringView name) const {
@@ -811,9 +908,14 @@ MaterialAttributeType MaterialData::attributeType(const UnsignedInt layer, const
 }
 
 MaterialAttributeType MaterialData::attributeType(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::attributeType(): invalid name" << name, {});
-    return attributeType(layer, string);
+    CORRADE_ASSERT(UnsignedInt(name) - 1 < Containers::arraySize(AttributeMap),
+        "Trade::MaterialData::attributeType(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attributeType(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = findAttributeIdInternal(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attributeType(): attribute" << AttributeMap[UnsignedInt(name) - 1].name << "not found in layer" << layer, {});
+    return _data[layerOffset(layer) + id]._data.type;
 }
 
 MaterialAttributeType MaterialData::attributeType(const Containers::StringView layer, const UnsignedInt id) const {
@@ -836,9 +938,15 @@ MaterialAttributeType MaterialData::attributeType(const Containers::StringView l
 }
 
 MaterialAttributeType MaterialData::attributeType(const Containers::StringView layer, const MaterialAttribute name) const {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::attributeType(): invalid name" << name, {});
-    return attributeType(layer, string);
+    CORRADE_ASSERT(UnsignedInt(name) - 1 < Containers::arraySize(AttributeMap),
+        "Trade::MaterialData::attributeType(): invalid name" << name, {});
+    const UnsignedInt layerId = findLayerIdInternal(layer);
+    CORRADE_ASSERT(layerId != ~UnsignedInt{},
+        "Trade::MaterialData::attributeType(): layer" << layer << "not found", {});
+    const UnsignedInt id = findAttributeIdInternal(layerId, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attributeType(): attribute" << AttributeMap[UnsignedInt(name) - 1].name << "not found in layer" << layer, {});
+    return _data[layerOffset(layerId) + id]._data.type;
 }
 
 MaterialAttributeType MaterialData::attributeType(const MaterialLayer layer, const UnsignedInt id) const {
@@ -898,15 +1006,27 @@ void* MaterialData::mutableAttribute(const UnsignedInt layer, const Containers::
 }
 
 const void* MaterialData::attribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::attribute(): invalid name" << name, {});
-    return attribute(layer, string);
+    CORRADE_ASSERT(UnsignedInt(name) - 1 < Containers::arraySize(AttributeMap),
+        "Trade::MaterialData::attribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = findAttributeIdInternal(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attribute(): attribute" << AttributeMap[UnsignedInt(name) - 1].name << "not found in layer" << layer, {});
+    return _data[layerOffset(layer) + id].value();
 }
 
 void* MaterialData::mutableAttribute(const UnsignedInt layer, const MaterialAttribute name) {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::mutableAttribute(): invalid name" << name, {});
-    return mutableAttribute(layer, string);
+    CORRADE_ASSERT(UnsignedInt(name) - 1 < Containers::arraySize(AttributeMap),
+        "Trade::MaterialData::mutableAttribute(): invalid name" << name, {});
+    CORRADE_ASSERT(_attributeDataFlags & DataFlag::Mutable,
+        "Trade::MaterialData::mutableAttribute(): attribute data not mutable", {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::mutableAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = findAttributeIdInternal(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::mutableAttribute(): attribute" << AttributeMap[UnsignedInt(name) - 1].name << "not found in layer" << layer, {});
+    return const_cast<void*>(_data[layerOffset(layer) + id].value());
 }
 
 const void* MaterialData::attribute(const Containers::StringView layer, const UnsignedInt id) const {
@@ -952,15 +1072,29 @@ void* MaterialData::mutableAttribute(const Containers::StringView layer, const C
 }
 
 const void* MaterialData::attribute(const Containers::StringView layer, const MaterialAttribute name) const {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::attribute(): invalid name" << name, {});
-    return attribute(layer, string);
+    CORRADE_ASSERT(UnsignedInt(name) - 1 < Containers::arraySize(AttributeMap),
+        "Trade::MaterialData::attribute(): invalid name" << name, {});
+    const UnsignedInt layerId = findLayerIdInternal(layer);
+    CORRADE_ASSERT(layerId != ~UnsignedInt{},
+        "Trade::MaterialData::attribute(): layer" << layer << "not found", {});
+    const UnsignedInt id = findAttributeIdInternal(layerId, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attribute(): attribute" << AttributeMap[UnsignedInt(name) - 1].name << "not found in layer" << layer, {});
+    return _data[layerOffset(layerId) + id].value();
 }
 
 void* MaterialData::mutableAttribute(const Containers::StringView layer, const MaterialAttribute name) {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::mutableAttribute(): invalid name" << name, {});
-    return mutableAttribute(layer, string);
+    CORRADE_ASSERT(UnsignedInt(name) - 1 < Containers::arraySize(AttributeMap),
+        "Trade::MaterialData::mutableAttribute(): invalid name" << name, {});
+    CORRADE_ASSERT(_attributeDataFlags & DataFlag::Mutable,
+        "Trade::MaterialData::mutableAttribute(): attribute data not mutable", {});
+    const UnsignedInt layerId = findLayerIdInternal(layer);
+    CORRADE_ASSERT(layerId != ~UnsignedInt{},
+        "Trade::MaterialData::mutableAttribute(): layer" << layer << "not found", {});
+    const UnsignedInt id = findAttributeIdInternal(layerId, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::mutableAttribute(): attribute" << AttributeMap[UnsignedInt(name) - 1].name << "not found in layer" << layer, {});
+    return const_cast<void*>(_data[layerOffset(layerId) + id].value());
 }
 
 const void* MaterialData::attribute(const MaterialLayer layer, const UnsignedInt id) const {
@@ -1080,9 +1214,13 @@ const void* MaterialData::findAttribute(const UnsignedInt layer, const Container
 }
 
 const void* MaterialData::findAttribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::findAttribute(): invalid name" << name, {});
-    return findAttribute(layer, string);
+    CORRADE_ASSERT(UnsignedInt(name) - 1 < Containers::arraySize(AttributeMap),
+        "Trade::MaterialData::findAttribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::findAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = findAttributeIdInternal(layer, name);
+    if(id == ~UnsignedInt{}) return nullptr;
+    return _data[layerOffset(layer) + id].value();
 }
 
 const void* MaterialData::findAttribute(const Containers::StringView layer, const Containers::StringView name) const {
@@ -1095,9 +1233,14 @@ const void* MaterialData::findAttribute(const Containers::StringView layer, cons
 }
 
 const void* MaterialData::findAttribute(const Containers::StringView layer, const MaterialAttribute name) const {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::findAttribute(): invalid name" << name, {});
-    return findAttribute(layer, string);
+    CORRADE_ASSERT(UnsignedInt(name) - 1 < Containers::arraySize(AttributeMap),
+        "Trade::MaterialData::findAttribute(): invalid name" << name, {});
+    const UnsignedInt layerId = findLayerIdInternal(layer);
+    CORRADE_ASSERT(layerId != ~UnsignedInt{},
+        "Trade::MaterialData::findAttribute(): layer" << layer << "not found", {});
+    const UnsignedInt id = findAttributeIdInternal(layerId, name);
+    if(id == ~UnsignedInt{}) return nullptr;
+    return _data[layerOffset(layerId) + id].value();
 }
 
 const void* MaterialData::findAttribute(const MaterialLayer layer, const Containers::StringView name) const {
@@ -1140,10 +1283,13 @@ Float MaterialData::alphaMask() const {
 }
 
 Containers::Array<UnsignedInt> MaterialData::releaseLayerData() {
+    /* The lookup is per-layer, which would no longer match */
+    _attributeLookup = nullptr;
     return Utility::move(_layerOffsets);
 }
 
 Containers::Array<MaterialAttributeData> MaterialData::releaseAttributeData() {
+    _attributeLookup = nullptr;
     return Utility::move(_data);
 }
 
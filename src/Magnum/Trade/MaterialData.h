@@ -1917,6 +1917,9 @@ names, but you're encouraged to use the predefined names from
 @ref MaterialAttribute --- with those, the attribute gets checked additionally
 that it's in an expected type. Attribute order doesn't matter, the array gets
 internally sorted by name to allow a @f$ \mathcal{O}(\log n) @f$ lookup.
+Additionally, for each layer the instance keeps a small table mapping
+@ref MaterialAttribute values to attribute IDs, which makes lookup using the
+predefined names a @f$ \mathcal{O}(1) @f$ operation.
 
 @snippet Trade.cpp MaterialData-populating
 
@@ -3447,9 +3450,16 @@ class MAGNUM_TRADE_EXPORT MaterialData {
             return layer && _layerOffsets ? _layerOffsets[layer - 1] : 0;
         }
         UnsignedInt findAttributeIdInternal(UnsignedInt layer, Containers::StringView name) const;
+        /* Uses _attributeLookup if populated, falling back to the above
+           otherwise. Expects that the name is valid. */
+        UnsignedInt findAttributeIdInternal(UnsignedInt layer, MaterialAttribute name) const;
+        MAGNUM_TRADE_LOCAL void populateAttributeLookupInternal();
 
         Containers::Array<MaterialAttributeData> _data;
         Containers::Array<UnsignedInt> _layerOffsets;
+        /* Per-layer MaterialAttribute to attribute ID mapping, see
+           populateAttributeLookupInternal() for details */
+        Containers::Array<UnsignedByte> _attributeLookup;
         MaterialTypes _types;
         DataFlags _attributeDataFlags, _layerDataFlags;
         /* 2 bytes free */
@@ -3640,15 +3650,29 @@ template<class T> typename std::conditional<std::is_same<T, Containers::MutableS
 }
 
 template<class T> T MaterialData::attribute(const UnsignedInt layer, const MaterialAttribute name) const {
+    #ifndef CORRADE_NO_ASSERT
     const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
+    #endif
     CORRADE_ASSERT(string.data(), "Trade::MaterialData::attribute(): invalid name" << name, {});
-    return attribute<T>(layer, string);
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = findAttributeIdInternal(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attribute(): attribute" << string << "not found in layer" << layer, {});
+    return attribute<T>(layer, id);
 }
 
 template<class T> typename std::conditional<std::is_same<T, Containers::MutableStringView>::value || std::is_same<T, Containers::ArrayView<void>>::value, T, T&>::type MaterialData::mutableAttribute(const UnsignedInt layer, const MaterialAttribute name) {
+    #ifndef CORRADE_NO_ASSERT
     const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
+    #endif
     CORRADE_ASSERT(string.data(), "Trade::MaterialData::mutableAttribute(): invalid name" << name, *reinterpret_cast<T*>(this));
-    return mutableAttribute<T>(layer, string);
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::mutableAttribute(): index" << layer << "out of range for" << layerCount() << "layers", *reinterpret_cast<T*>(this));
+    const UnsignedInt id = findAttributeIdInternal(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::mutableAttribute(): attribute" << string << "not found in layer" << layer, *reinterpret_cast<T*>(this));
+    return mutableAttribute<T>(layer, id);
 }
 
 template<class T> T MaterialData::attribute(const Containers::StringView layer, const UnsignedInt id) const {
@@ -3690,15 +3714,31 @@ template<class T> typename std::conditional<std::is_same<T, Containers::MutableS
 }
 
 template<class T> T MaterialData::attribute(const Containers::StringView layer, const MaterialAttribute name) const {
+    #ifndef CORRADE_NO_ASSERT
     const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
+    #endif
     CORRADE_ASSERT(string.data(), "Trade::MaterialData::attribute(): invalid name" << name, {});
-    return attribute<T>(layer, string);
+    const UnsignedInt layerId = findLayerIdInternal(layer);
+    CORRADE_ASSERT(layerId != ~UnsignedInt{},
+        "Trade::MaterialData::attribute(): layer" << layer << "not found", {});
+    const UnsignedInt id = findAttributeIdInternal(layerId, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attribute(): attribute" << string << "not found in layer" << layer, {});
+    return attribute<T>(layerId, id);
 }
 
 template<class T> typename std::conditional<std::is_same<T, Containers::MutableStringView>::value || std::is_same<T, Containers::ArrayView<void>>::value, T, T&>::type MaterialData::mutableAttribute(const Containers::StringView layer, const MaterialAttribute name) {
+    #ifndef CORRADE_NO_ASSERT
     const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
+    #endif
     CORRADE_ASSERT(string.data(), "Trade::MaterialData::mutableAttribute(): invalid name" << name, *reinterpret_cast<T*>(this));
-    return mutableAttribute<T>(layer, string);
+    const UnsignedInt layerId = findLayerIdInternal(layer);
+    CORRADE_ASSERT(layerId != ~UnsignedInt{},
+        "Trade::MaterialData::mutableAttribute(): layer" << layer << "not found", *reinterpret_cast<T*>(this));
+    const UnsignedInt id = findAttributeIdInternal(layerId, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::mutableAttribute(): attribute" << string << "not found in layer" << layer, *reinterpret_cast<T*>(this));
+    return mutableAttribute<T>(layerId, id);
 }
 
 template<class T> T MaterialData::attribute(const MaterialLayer layer, const UnsignedInt id) const {
@@ -3746,9 +3786,13 @@ template<class T> Containers::Optional<T> MaterialData::findAttribute(const Unsi
 }
 
 template<class T> Containers::Optional<T> MaterialData::findAttribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::findAttribute(): invalid name" << name, {});
-    return findAttribute<T>(layer, string);
+    CORRADE_ASSERT(Implementation::materialAttributeNameInternal(name).data(),
+        "Trade::MaterialData::findAttribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::findAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = findAttributeIdInternal(layer, name);
+    if(id == ~UnsignedInt{}) return {};
+    return attribute<T>(layer, id);
 }
 
 template<class T> Containers::Optional<T> MaterialData::findAttribute(const Containers::StringView layer, const Containers::StringView name) const {
@@ -3759,9 +3803,14 @@ template<class T> Containers::Optional<T> MaterialData::findAttribute(const Cont
 }
 
 template<class T> Containers::Optional<T> MaterialData::findAttribute(const Containers::StringView layer, const MaterialAttribute name) const {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::findAttribute(): invalid name" << name, {});
-    return findAttribute<T>(layer, string);
+    CORRADE_ASSERT(Implementation::materialAttributeNameInternal(name).data(),
+        "Trade::MaterialData::findAttribute(): invalid name" << name, {});
+    const UnsignedInt layerId = findLayerIdInternal(layer);
+    CORRADE_ASSERT(layerId != ~UnsignedInt{},
+        "Trade::MaterialData::findAttribute(): layer" << layer << "not found", {});
+    const UnsignedInt id = findAttributeIdInternal(layerId, name);
+    if(id == ~UnsignedInt{}) return {};
+    return attribute<T>(layerId, id);
 }
 
 template<class T> Containers::Optional<T> MaterialData::findAttribute(const MaterialLayer layer, const Containers::StringView name) const {
@@ -3785,9 +3834,13 @@ template<class T> T MaterialData::attributeOr(const UnsignedInt layer, const Con
 }
 
 template<class T> T MaterialData::attributeOr(const UnsignedInt layer, const MaterialAttribute name, const T& defaultValue) const {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::attributeOr(): invalid name" << name, {});
-    return attributeOr<T>(layer, string, defaultValue);
+    CORRADE_ASSERT(Implementation::materialAttributeNameInternal(name).data(),
+        "Trade::MaterialData::attributeOr(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attributeOr(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = findAttributeIdInternal(layer, name);
+    if(id == ~UnsignedInt{}) return defaultValue;
+    return attribute<T>(layer, id);
 }
 
 template<class T> T MaterialData::attributeOr(const Containers::StringView layer, const Containers::StringView name, const T& defaultValue) const {
@@ -3798,9 +3851,14 @@ template<class T> T MaterialData::attributeOr(const Containers::StringView layer
 }
 
 template<class T> T MaterialData::attributeOr(const Containers::StringView layer, const MaterialAttribute name, const T& defaultValue) const {
-    const Containers::StringView string = Implementation::materialAttributeNameInternal(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::attributeOr(): invalid name" << name, {});
-    return attributeOr<T>(layer, string, defaultValue);
+    CORRADE_ASSERT(Implementation::materialAttributeNameInternal(name).data(),
+        "Trade::MaterialData::attributeOr(): invalid name" << name, {});
+    const UnsignedInt layerId = findLayerIdInternal(layer);
+    CORRADE_ASSERT(layerId != ~UnsignedInt{},
+        "Trade::MaterialData::attributeOr(): layer" << layer << "not found", {});
+    const UnsignedInt id = findAttributeIdInternal(layerId, name);
+    if(id == ~UnsignedInt{}) return defaultValue;
+    return attribute<T>(layerId, id);
 }
 
 template<class T> T MaterialData::attributeOr(const MaterialLayer layer, const Containers::StringView name, const T& defaultValue) const {
@@ -0,0 +1,160 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Trade/MaterialData.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MaterialDataBenchmark: TestSuite::Tester {
+    explicit MaterialDataBenchmark();
+
+    void attributeBuiltin();
+    void attributeBuiltinString();
+    void attributeBuiltinLayer();
+    void attributeBuiltinLayerString();
+    void attributeCustom();
+    void attributeOrBuiltinNotFound();
+    void attributeOrBuiltinNotFoundString();
+};
+
+MaterialDataBenchmark::MaterialDataBenchmark() {
+    addBenchmarks({&MaterialDataBenchmark::attributeBuiltin,
+                   &MaterialDataBenchmark::attributeBuiltinString,
+                   &MaterialDataBenchmark::attributeBuiltinLayer,
+                   &MaterialDataBenchmark::attributeBuiltinLayerString,
+                   &MaterialDataBenchmark::attributeCustom,
+                   &MaterialDataBenchmark::attributeOrBuiltinNotFound,
+                   &MaterialDataBenchmark::attributeOrBuiltinNotFoundString}, 100);
+}
+
+enum: std::size_t { Repeats = 10000 };
+
+/* A reasonably realistic PBR material with a clear coat layer */
+MaterialData material() {
+    return MaterialData{{}, {
+        {MaterialAttribute::BaseColor, Color4{0.8f, 0.2f, 0.4f, 1.0f}},
+        {MaterialAttribute::BaseColorTexture, 2u},
+        {MaterialAttribute::BaseColorTextureMatrix, Matrix3::scaling({0.5f, 1.0f})},
+        {MaterialAttribute::Metalness, 0.25f},
+        {MaterialAttribute::Roughness, 0.75f},
+        {MaterialAttribute::NoneRoughnessMetallicTexture, 3u},
+        {MaterialAttribute::NormalTexture, 4u},
+        {MaterialAttribute::NormalTextureScale, 0.5f},
+        {MaterialAttribute::OcclusionTexture, 5u},
+        {MaterialAttribute::EmissiveColor, Color3{0.1f}},
+        {MaterialAttribute::DoubleSided, true},
+        {"customFactor", 0.5f},
+
+        {MaterialLayer::ClearCoat},
+        {MaterialAttribute::LayerFactor, 0.5f},
+        {MaterialAttribute::LayerFactorTexture, 6u},
+        {MaterialAttribute::Roughness, 0.1f},
+        {MaterialAttribute::NormalTexture, 7u},
+    }, {12, 17}};
+}
+
+void MaterialDataBenchmark::attributeBuiltin() {
+    MaterialData data = material();
+
+    UnsignedInt out{};
+    CORRADE_BENCHMARK(Repeats) {
+        out += data.attribute<UnsignedInt>(MaterialAttribute::OcclusionTexture);
+    }
+
+    CORRADE_COMPARE(out, 5*Repeats);
+}
+
+void MaterialDataBenchmark::attributeBuiltinString() {
+    MaterialData data = material();
+
+    UnsignedInt out{};
+    CORRADE_BENCHMARK(Repeats) {
+        out += data.attribute<UnsignedInt>("OcclusionTexture");
+    }
+
+    CORRADE_COMPARE(out, 5*Repeats);
+}
+
+void MaterialDataBenchmark::attributeBuiltinLayer() {
+    MaterialData data = material();
+
+    UnsignedInt out{};
+    CORRADE_BENCHMARK(Repeats) {
+        out += data.attribute<UnsignedInt>(1, MaterialAttribute::NormalTexture);
+    }
+
+    CORRADE_COMPARE(out, 7*Repeats);
+}
+
+void MaterialDataBenchmark::attributeBuiltinLayerString() {
+    MaterialData data = material();
+
+    UnsignedInt out{};
+    CORRADE_BENCHMARK(Repeats) {
+        out += data.attribute<UnsignedInt>(1, "NormalTexture");
+    }
+
+    CORRADE_COMPARE(out, 7*Repeats);
+}
+
+void MaterialDataBenchmark::attributeCustom() {
+    MaterialData data = material();
+
+    Float out{};
+    CORRADE_BENCHMARK(Repeats) {
+        out += data.attribute<Float>("customFactor");
+    }
+
+    CORRADE_COMPARE(out, 0.5f*Repeats);
+}
+
+void MaterialDataBenchmark::attributeOrBuiltinNotFound() {
+    MaterialData data = material();
+
+    UnsignedInt out{};
+    CORRADE_BENCHMARK(Repeats) {
+        out += data.attributeOr(MaterialAttribute::SpecularTexture, 1u);
+    }
+
+    CORRADE_COMPARE(out, Repeats);
+}
+
+void MaterialDataBenchmark::attributeOrBuiltinNotFoundString() {
+    MaterialData data = material();
+
+    UnsignedInt out{};
+    CORRADE_BENCHMARK(Repeats) {
+        out += data.attributeOr("SpecularTexture", 1u);
+    }
+
+    CORRADE_COMPARE(out, Repeats);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MaterialDataBenchmark)
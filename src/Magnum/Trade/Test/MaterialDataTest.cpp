@@ -25,6 +25,7 @@
 
 #include <algorithm> /* std::next_permutation() */
 #include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/StaticArray.h>
 #include <Corrade/Containers/StringStl.h> /* partition() on a std::string */
 #include <Corrade/TestSuite/Tester.h>
@@ -125,6 +126,7 @@ struct MaterialDataTest: TestSuite::Tester {
     void accessTextureSwizzle();
     void accessMutable();
     void accessOptional();
+    void accessManyAttributes();
     void accessOutOfRange();
     void accessNotFound();
     void accessInvalidAttributeName();
@@ -294,6 +296,7 @@ MaterialDataTest::MaterialDataTest() {
               &MaterialDataTest::accessTextureSwizzle,
               &MaterialDataTest::accessMutable,
               &MaterialDataTest::accessOptional,
+              &MaterialDataTest::accessManyAttributes,
               &MaterialDataTest::accessOutOfRange,
               &MaterialDataTest::accessNotFound,
               &MaterialDataTest::accessInvalidAttributeName,
@@ -2006,6 +2009,61 @@ void MaterialDataTest::accessOptional() {
     CORRADE_COMPARE(data.attributeOr(MaterialAttribute::DiffuseTexture, 5u), 5);
 }
 
+void MaterialDataTest::accessManyAttributes() {
+    /* Builtin attributes are looked up through a per-layer table that stores
+       IDs in a byte, verify that a fallback is used for attributes beyond
+       that. The first 200 custom names start with $, thus get sorted before
+       the builtin attributes, the remaining ones start with M, thus get
+       sorted between DoubleSided and TextureLayer. */
+    Containers::Array<MaterialAttributeData> attributes;
+    arrayAppend(attributes, InPlaceInit, MaterialAttribute::DoubleSided, true);
+    for(UnsignedInt i = 0; i != 300; ++i) {
+        const char name[]{i < 200 ? '$' : 'M', char('0' + i/100), char('0' + i/10%10), char('0' + i%10), '\0'};
+        arrayAppend(attributes, InPlaceInit, name, i);
+    }
+    arrayAppend(attributes, InPlaceInit, MaterialAttribute::TextureLayer, 17u);
+    arrayAppend(attributes, InPlaceInit, MaterialAttribute::AlphaMask, 0.25f);
+    arrayAppend(attributes, InPlaceInit, MaterialAttribute::LayerFactor, 0.75f);
+
+    MaterialData data{{}, Utility::move(attributes), Containers::array<UnsignedInt>({302, 304})};
+    CORRADE_COMPARE(data.layerCount(), 2);
+    CORRADE_COMPARE(data.attributeCount(0), 302);
+
+    /* In the first layer one attribute fits into the table, one doesn't */
+    CORRADE_COMPARE(data.attributeId(MaterialAttribute::DoubleSided), 200);
+    CORRADE_COMPARE(data.attributeId(MaterialAttribute::TextureLayer), 301);
+    CORRADE_COMPARE(data.attributeId("$123"), 123);
+    CORRADE_COMPARE(data.attributeId("M250"), 251);
+    CORRADE_COMPARE(data.attribute<bool>(MaterialAttribute::DoubleSided), true);
+    CORRADE_COMPARE(data.attribute<UnsignedInt>(MaterialAttribute::TextureLayer), 17);
+    CORRADE_COMPARE(data.attributeOr(MaterialAttribute::TextureLayer, 0u), 17);
+    CORRADE_VERIFY(!data.hasAttribute(MaterialAttribute::AlphaMask));
+    CORRADE_COMPARE(data.attributeOr(MaterialAttribute::AlphaMask, 0.5f), 0.5f);
+
+    /* The second layer is independent */
+    CORRADE_COMPARE(data.attributeId(1, MaterialAttribute::AlphaMask), 0);
+    CORRADE_COMPARE(data.attributeId(1, MaterialAttribute::LayerFactor), 1);
+    CORRADE_COMPARE(data.attribute<Float>(1, MaterialAttribute::LayerFactor), 0.75f);
+    CORRADE_VERIFY(!data.hasAttribute(1, MaterialAttribute::DoubleSided));
+    CORRADE_VERIFY(!data.findAttribute<UnsignedInt>(1, MaterialAttribute::TextureLayer));
+
+    /* Same when constructing from non-owned data, which is expected to be
+       sorted already */
+    const UnsignedInt layers[]{302, 304};
+    MaterialData view{{}, {}, data.attributeData(), {}, layers};
+    CORRADE_COMPARE(view.attributeId(MaterialAttribute::DoubleSided), 200);
+    CORRADE_COMPARE(view.attributeId(MaterialAttribute::TextureLayer), 301);
+    CORRADE_COMPARE(view.attributeId(1, MaterialAttribute::LayerFactor), 1);
+    CORRADE_VERIFY(!view.hasAttribute(MaterialAttribute::AlphaMask));
+
+    /* After releasing the layer data, everything is in the base layer */
+    data.releaseLayerData();
+    CORRADE_COMPARE(data.layerCount(), 1);
+    CORRADE_COMPARE(data.attributeCount(), 304);
+    CORRADE_VERIFY(data.hasAttribute(MaterialAttribute::TextureLayer));
+    CORRADE_VERIFY(data.hasAttribute(MaterialAttribute::LayerFactor));
+}
+
 void MaterialDataTest::accessOutOfRange() {
     CORRADE_SKIP_IF_NO_ASSERT();
 
@@ -63,7 +63,7 @@ Buffer Buffer::wrap(Device& device, const VkBuffer handle, const HandleFlags fla
     return out;
 }
 
-Buffer::Buffer(Device& device, const BufferCreateInfo& info, NoAllocateT): _device{&device}, _flags{HandleFlag::DestroyOnDestruction}, _dedicatedMemory{NoCreate} {
+Buffer::Buffer(Device& device, const BufferCreateInfo& info, NoAllocateT): _device{&device}, _flags{HandleFlag::DestroyOnDestruction}, _dedicatedMemory{NoCreate}, _allocation{NoCreate} {
     MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateBuffer(device, info, nullptr, &_handle));
 }
 
@@ -75,9 +75,14 @@ Buffer::Buffer(Device& device, const BufferCreateInfo& info, const MemoryFlags m
     }});
 }
 
-Buffer::Buffer(NoCreateT): _device{}, _handle{}, _dedicatedMemory{NoCreate} {}
+Buffer::Buffer(Device& device, const BufferCreateInfo& info, MemoryAllocator& allocator, const MemoryFlags memoryFlags): Buffer{device, info, NoAllocate} {
+    _allocation = allocator.allocate(memoryRequirements(), memoryFlags, {}, {});
+    bindMemory(_allocation.memory(), _allocation.offset());
+}
+
+Buffer::Buffer(NoCreateT): _device{}, _handle{}, _dedicatedMemory{NoCreate}, _allocation{NoCreate} {}
 
-Buffer::Buffer(Buffer&& other) noexcept: _device{other._device}, _handle{other._handle}, _flags{other._flags}, _dedicatedMemory{Utility::move(other._dedicatedMemory)} {
+Buffer::Buffer(Buffer&& other) noexcept: _device{other._device}, _handle{other._handle}, _flags{other._flags}, _dedicatedMemory{Utility::move(other._dedicatedMemory)}, _allocation{Utility::move(other._allocation)} {
     other._handle = {};
 }
 
@@ -92,6 +97,7 @@ Buffer& Buffer::operator=(Buffer&& other) noexcept {
     swap(other._handle, _handle);
     swap(other._flags, _flags);
     swap(other._dedicatedMemory, _dedicatedMemory);
+    swap(other._allocation, _allocation);
     return *this;
 }
 
@@ -130,6 +136,16 @@ Memory& Buffer::dedicatedMemory() {
     return _dedicatedMemory;
 }
 
+bool Buffer::hasAllocation() const {
+    return bool(_allocation);
+}
+
+MemoryAllocation& Buffer::allocation() {
+    CORRADE_ASSERT(_allocation,
+        "Vk::Buffer::allocation(): buffer doesn't have memory from an allocator", _allocation);
+    return _allocation;
+}
+
 VkBuffer Buffer::release() {
     const VkBuffer handle = _handle;
     _handle = {};
@@ -37,6 +37,7 @@
 #include "Magnum/Magnum.h"
 #include "Magnum/Tags.h"
 #include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/MemoryAllocator.h"
 #include "Magnum/Vk/Vk.h"
 #include "Magnum/Vk/Vulkan.h"
 #include "Magnum/Vk/visibility.h"
@@ -62,6 +63,14 @@ constructor together with specifying @ref MemoryFlags for the allocation.
     accessible through @ref dedicatedMemory(). This behavior may change in the
     future.
 
+@subsection Vk-Buffer-creation-allocator Sub-allocating from a memory allocator
+
+Creating a large amount of buffers with dedicated allocations is inefficient.
+Pass a @ref MemoryAllocator to the constructor instead to sub-allocate the
+memory from larger blocks. The allocation is then accessible through
+@ref allocation(). See the @ref MemoryAllocator documentation for more
+information.
+
 @subsection Vk-Buffer-creation-custom-allocation Custom memory allocation
 
 Using @ref Buffer(Device&, const BufferCreateInfo&, NoAllocateT), the buffer
@@ -147,6 +156,22 @@ class MAGNUM_VK_EXPORT Buffer {
          */
         explicit Buffer(Device& device, const BufferCreateInfo& info, MemoryFlags memoryFlags);
 
+        /**
+         * @brief Construct a buffer with memory from an allocator
+         * @param device        Vulkan device to create the buffer on
+         * @param info          Buffer creation info
+         * @param allocator     Memory allocator
+         * @param memoryFlags   Memory allocation flags
+         *
+         * Compared to @ref Buffer(Device&, const BufferCreateInfo&, MemoryFlags)
+         * the memory is sub-allocated from @p allocator using
+         * @ref MemoryAllocator::allocate() instead of using a dedicated
+         * allocation. The allocation is subsequently accessible through
+         * @ref allocation() and given back to the allocator on destruction,
+         * which means the @p allocator has to outlive the buffer.
+         */
+        explicit Buffer(Device& device, const BufferCreateInfo& info, MemoryAllocator& allocator, MemoryFlags memoryFlags);
+
         /**
          * @brief Construct without creating the buffer
          *
@@ -231,6 +256,24 @@ class MAGNUM_VK_EXPORT Buffer {
          */
         Memory& dedicatedMemory();
 
+        /**
+         * @brief Whether the buffer has memory from a @ref MemoryAllocator
+         *
+         * Returns @cpp true @ce if the buffer was created using
+         * @ref Buffer(Device&, const BufferCreateInfo&, MemoryAllocator&, MemoryFlags),
+         * @cpp false @ce otherwise.
+         * @see @ref allocation()
+         */
+        bool hasAllocation() const;
+
+        /**
+         * @brief Memory allocation
+         *
+         * Expects that the buffer has memory from a @ref MemoryAllocator.
+         * @see @ref hasAllocation()
+         */
+        MemoryAllocation& allocation();
+
         /**
          * @brief Release the underlying Vulkan buffer
          *
@@ -258,6 +301,7 @@ class MAGNUM_VK_EXPORT Buffer {
         VkBuffer _handle;
         HandleFlags _flags;
         Memory _dedicatedMemory;
+        MemoryAllocation _allocation;
 };
 
 /**
@@ -25,6 +25,8 @@
 
 #include "CommandBuffer.h"
 
+#include <Corrade/Containers/ArrayView.h>
+
 #include "Magnum/Vk/Assert.h"
 #include "Magnum/Vk/Device.h"
 #include "Magnum/Vk/Handle.h"
@@ -66,11 +68,35 @@ void CommandBuffer::reset(const CommandBufferResetFlags flags) {
     MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).ResetCommandBuffer(_handle, VkCommandBufferResetFlags(flags)));
 }
 
+CommandBufferInheritanceInfo::CommandBufferInheritanceInfo(const VkRenderPass renderPass, const UnsignedInt subpass, const VkFramebuffer framebuffer): _info{} {
+    _info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    _info.renderPass = renderPass;
+    _info.subpass = subpass;
+    _info.framebuffer = framebuffer;
+}
+
+CommandBufferInheritanceInfo::CommandBufferInheritanceInfo(): _info{} {
+    _info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+}
+
+CommandBufferInheritanceInfo::CommandBufferInheritanceInfo(NoInitT) noexcept {}
+
+CommandBufferInheritanceInfo::CommandBufferInheritanceInfo(const VkCommandBufferInheritanceInfo& info):
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(info) {}
+
 CommandBufferBeginInfo::CommandBufferBeginInfo(const Flags flags): _info{} {
     _info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     _info.flags = VkCommandBufferUsageFlags(flags);
 }
 
+CommandBufferBeginInfo::CommandBufferBeginInfo(const CommandBufferInheritanceInfo& inheritanceInfo, const Flags flags): CommandBufferBeginInfo{flags} {
+    if(inheritanceInfo->renderPass)
+        _info.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    _info.pInheritanceInfo = inheritanceInfo;
+}
+
 CommandBufferBeginInfo::CommandBufferBeginInfo(NoInitT) noexcept {}
 
 CommandBufferBeginInfo::CommandBufferBeginInfo(const VkCommandBufferBeginInfo& info):
@@ -93,6 +119,15 @@ void CommandBuffer::end() {
     MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).EndCommandBuffer(_handle));
 }
 
+CommandBuffer& CommandBuffer::executeCommands(const Containers::ArrayView<const VkCommandBuffer> commandBuffers) {
+    (**_device).CmdExecuteCommands(_handle, commandBuffers.size(), commandBuffers);
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::executeCommands(const std::initializer_list<VkCommandBuffer> commandBuffers) {
+    return executeCommands(Containers::arrayView(commandBuffers));
+}
+
 VkCommandBuffer CommandBuffer::release() {
     const VkCommandBuffer handle = _handle;
     _handle = nullptr;
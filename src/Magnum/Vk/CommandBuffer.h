@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Vk::CommandBuffer, @ref Magnum::Vk::CommandBufferBeginInfo, enum @ref Magnum::Vk::CommandPoolResetFlag, enum set @ref Magnum::Vk::CommandPoolResetFlags
+ * @brief Class @ref Magnum::Vk::CommandBuffer, @ref Magnum::Vk::CommandBufferInheritanceInfo, @ref Magnum::Vk::CommandBufferBeginInfo, enum @ref Magnum::Vk::CommandPoolResetFlag, enum set @ref Magnum::Vk::CommandPoolResetFlags
  * @m_since_latest
  */
 
@@ -44,6 +44,77 @@ namespace Magnum { namespace Vk {
 
 namespace Implementation { struct DeviceState; }
 
+/**
+@brief Command buffer inheritance info
+@m_since_latest
+
+Wraps a @type_vk_keyword{CommandBufferInheritanceInfo}. Describes state a
+@ref CommandBufferLevel::Secondary command buffer inherits from the primary
+command buffer it gets executed in. See
+@ref Vk-CommandBuffer-secondary "Secondary command buffers" for more
+information.
+@see @ref CommandBufferBeginInfo::CommandBufferBeginInfo(const CommandBufferInheritanceInfo&, Flags)
+*/
+class MAGNUM_VK_EXPORT CommandBufferInheritanceInfo {
+    public:
+        /**
+         * @brief Constructor
+         * @param renderPass    Render pass the secondary command buffer
+         *      will be executed in
+         * @param subpass       Subpass index the secondary command buffer
+         *      will be executed in
+         * @param framebuffer   Framebuffer the secondary command buffer will
+         *      be executed with. Optional, but specifying it may allow the
+         *      driver to produce better code.
+         *
+         * The following @type_vk{CommandBufferInheritanceInfo} fields are
+         * pre-filled in addition to `sType`, everything else is zero-filled:
+         *
+         * -    `renderPass`
+         * -    `subpass`
+         * -    `framebuffer`
+         */
+        explicit CommandBufferInheritanceInfo(VkRenderPass renderPass, UnsignedInt subpass, VkFramebuffer framebuffer = {});
+
+        /**
+         * @brief Construct for a secondary command buffer executed outside of a render pass
+         *
+         * Only the `sType` field is set, everything else is zero-filled.
+         */
+        explicit CommandBufferInheritanceInfo();
+
+        /**
+         * @brief Construct without initializing the contents
+         *
+         * Note that not even the `sType` field is set --- the structure has to
+         * be fully initialized afterwards in order to be usable.
+         */
+        explicit CommandBufferInheritanceInfo(NoInitT) noexcept;
+
+        /**
+         * @brief Construct from existing data
+         *
+         * Copies the existing values verbatim, pointers are kept unchanged
+         * without taking over the ownership. Modifying the newly created
+         * instance will not modify the original data nor the pointed-to data.
+         */
+        explicit CommandBufferInheritanceInfo(const VkCommandBufferInheritanceInfo& info);
+
+        /** @brief Underlying @type_vk{CommandBufferInheritanceInfo} structure */
+        VkCommandBufferInheritanceInfo& operator*() { return _info; }
+        /** @overload */
+        const VkCommandBufferInheritanceInfo& operator*() const { return _info; }
+        /** @overload */
+        VkCommandBufferInheritanceInfo* operator->() { return &_info; }
+        /** @overload */
+        const VkCommandBufferInheritanceInfo* operator->() const { return &_info; }
+        /** @overload */
+        operator const VkCommandBufferInheritanceInfo*() const { return &_info; }
+
+    private:
+        VkCommandBufferInheritanceInfo _info;
+};
+
 /**
 @brief Command buffer begin info
 @m_since_latest
@@ -111,6 +182,26 @@ class MAGNUM_VK_EXPORT CommandBufferBeginInfo {
            point in making this implicit. */
         explicit CommandBufferBeginInfo(Flags flags = {});
 
+        /**
+         * @brief Construct for a secondary command buffer
+         * @param inheritanceInfo   Inheritance info
+         * @param flags             Command buffer begin flags
+         *
+         * The following @type_vk{CommandBufferBeginInfo} fields are pre-filled
+         * in addition to `sType`, everything else is zero-filled:
+         *
+         * -    `flags`, with @ref Flag::RenderPassContinue added implicitly
+         *      if `renderPass` in @p inheritanceInfo is not
+         *      @cpp VK_NULL_HANDLE @ce
+         * -    `pInheritanceInfo` to @p inheritanceInfo
+         *
+         * Note that the @p inheritanceInfo is referenced, not copied, so it
+         * has to stay in scope until @ref CommandBuffer::begin() is called.
+         * Passing a temporary directly to the @ref CommandBuffer::begin()
+         * expression is fine.
+         */
+        explicit CommandBufferBeginInfo(const CommandBufferInheritanceInfo& inheritanceInfo, Flags flags = {});
+
         /**
          * @brief Construct without initializing the contents
          *
@@ -206,6 +297,26 @@ compatible @ref Queue that was set up at
 the submit completion with a @link Fence @endlink:
 
 @snippet Vk.cpp CommandBuffer-usage-submit
+
+@section Vk-CommandBuffer-secondary Secondary command buffers
+
+A @ref CommandBufferLevel::Secondary command buffer can't be submitted to a
+queue directly, instead it's executed from a primary command buffer using
+@ref executeCommands(). Their main use is splitting up recording of a large
+render pass among multiple threads --- each thread records its part into its
+own secondary command buffer, allocated from its own @ref CommandPool, and the
+primary command buffer then executes them all. A secondary command buffer
+recorded for use inside a render pass needs to be begun with a
+@ref CommandBufferInheritanceInfo describing the render pass, subpass and
+optionally the framebuffer, and the subpass in the primary command buffer
+has to be started with @ref SubpassContents::SecondaryCommandBuffers:
+
+@snippet Vk.cpp CommandBuffer-usage-secondary
+
+Command pools are externally synchronized, which means a single pool can't be
+used to allocate or record command buffers from multiple threads at the same
+time. See the @ref ThreadCommandPools class for a convenient way to give each
+thread its own pool and recycle them on every frame.
 */
 class MAGNUM_VK_EXPORT CommandBuffer {
     public:
@@ -372,6 +483,25 @@ class MAGNUM_VK_EXPORT CommandBuffer {
         CommandBuffer& endRenderPass();
         #endif
 
+        /**
+         * @brief Execute secondary command buffers
+         * @param commandBuffers    @ref CommandBufferLevel::Secondary command
+         *      buffers to execute
+         * @return Reference to self (for method chaining)
+         *
+         * Can be called both inside and outside a render pass. If called
+         * inside a render pass, the current subpass has to be begun with
+         * @ref SubpassContents::SecondaryCommandBuffers and the command
+         * buffers have to be recorded with
+         * @ref CommandBufferBeginInfo::Flag::RenderPassContinue and a
+         * matching @ref CommandBufferInheritanceInfo. See
+         * @ref Vk-CommandBuffer-secondary for a usage example.
+         * @see @fn_vk_keyword{CmdExecuteCommands}
+         */
+        CommandBuffer& executeCommands(Containers::ArrayView<const VkCommandBuffer> commandBuffers);
+        /** @overload */
+        CommandBuffer& executeCommands(std::initializer_list<VkCommandBuffer> commandBuffers);
+
         /**
          * @brief Bind a pipeline
          * @return Reference to self (for method chaining)
@@ -782,6 +912,57 @@ class MAGNUM_VK_EXPORT CommandBuffer {
          */
         CommandBuffer& copyImageToBuffer(const CopyImageToBufferInfo& info);
 
+        /**
+         * @brief Reset queries in a query pool
+         * @param pool      A @ref QueryPool or a raw Vulkan query pool handle
+         * @param first     First query to reset
+         * @param count     Count of queries to reset
+         * @return Reference to self (for method chaining)
+         *
+         * Allowed only outside of a render pass. Queries have to be reset
+         * before they're used. See @ref Vk-QueryPool-usage for a usage
+         * example.
+         * @see @fn_vk_keyword{CmdResetQueryPool}
+         */
+        CommandBuffer& resetQueryPool(VkQueryPool pool, UnsignedInt first, UnsignedInt count);
+
+        /**
+         * @brief Begin a query
+         * @param pool      A @ref QueryPool or a raw Vulkan query pool handle
+         * @param query     Query index in the pool
+         * @param flags     Query control flags
+         * @return Reference to self (for method chaining)
+         *
+         * Not allowed for @ref QueryType::Timestamp queries, use
+         * @ref writeTimestamp() for those instead. A query that begins inside
+         * a render pass has to end in the same subpass, a query that begins
+         * outside of a render pass has to end outside of it as well.
+         * @see @ref endQuery(), @fn_vk_keyword{CmdBeginQuery}
+         */
+        CommandBuffer& beginQuery(VkQueryPool pool, UnsignedInt query, QueryControlFlags flags = {});
+
+        /**
+         * @brief End a query
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref beginQuery(), @fn_vk_keyword{CmdEndQuery}
+         */
+        CommandBuffer& endQuery(VkQueryPool pool, UnsignedInt query);
+
+        /**
+         * @brief Write a timestamp
+         * @param stage     Pipeline stage at which to write the timestamp
+         * @param pool      A @ref QueryPool or a raw Vulkan query pool handle.
+         *      Expected to be created with @ref QueryType::Timestamp.
+         * @param query     Query index in the pool
+         * @return Reference to self (for method chaining)
+         *
+         * The timestamp is written once all previously submitted commands
+         * reach @p stage. See @ref Vk-QueryPool-usage for a usage example.
+         * @see @fn_vk_keyword{CmdWriteTimestamp}
+         */
+        CommandBuffer& writeTimestamp(PipelineStage stage, VkQueryPool pool, UnsignedInt query);
+
     private:
         friend CommandPool;
         friend Implementation::DeviceState;
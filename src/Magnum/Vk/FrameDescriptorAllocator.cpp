@@ -0,0 +1,272 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FrameDescriptorAllocator.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Implementation/stringHash.h"
+#include "Magnum/Vk/Assert.h"
+#include "Magnum/Vk/DescriptorPool.h"
+#include "Magnum/Vk/DescriptorPoolCreateInfo.h"
+#include "Magnum/Vk/DescriptorSet.h"
+#include "Magnum/Vk/DescriptorType.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/Fence.h"
+#include "Magnum/Vk/Image.h"
+
+namespace Magnum { namespace Vk {
+
+namespace {
+
+bool isBufferDescriptor(const DescriptorType type) {
+    return type == DescriptorType::UniformBuffer ||
+           type == DescriptorType::StorageBuffer ||
+           type == DescriptorType::UniformBufferDynamic ||
+           type == DescriptorType::StorageBufferDynamic;
+}
+
+bool isImageDescriptor(const DescriptorType type) {
+    return type == DescriptorType::CombinedImageSampler ||
+           type == DescriptorType::SampledImage ||
+           type == DescriptorType::StorageImage ||
+           type == DescriptorType::InputAttachment;
+}
+
+}
+
+DescriptorWrite::DescriptorWrite(const UnsignedInt binding, const DescriptorType type, const VkBuffer buffer, const UnsignedLong offset, const UnsignedLong range) noexcept: _binding{binding}, _arrayElement{}, _type{type}, _imageLayout{}, _buffer{buffer}, _offset{offset}, _range{range}, _imageView{}, _sampler{} {
+    CORRADE_ASSERT(isBufferDescriptor(type),
+        "Vk::DescriptorWrite: expected a buffer descriptor type but got" << type, );
+}
+
+DescriptorWrite::DescriptorWrite(const UnsignedInt binding, const DescriptorType type, const VkImageView imageView, const ImageLayout layout, const VkSampler sampler) noexcept: _binding{binding}, _arrayElement{}, _type{type}, _imageLayout{layout}, _buffer{}, _offset{}, _range{}, _imageView{imageView}, _sampler{sampler} {
+    CORRADE_ASSERT(isImageDescriptor(type),
+        "Vk::DescriptorWrite: expected an image descriptor type but got" << type, );
+}
+
+DescriptorWrite::DescriptorWrite(const UnsignedInt binding, const VkSampler sampler) noexcept: _binding{binding}, _arrayElement{}, _type{DescriptorType::Sampler}, _imageLayout{}, _buffer{}, _offset{}, _range{}, _imageView{}, _sampler{sampler} {}
+
+namespace Implementation {
+
+struct FrameDescriptorAllocatorFrame {
+    Containers::Array<DescriptorPool> pools;
+    /* Index of the pool to allocate from next */
+    UnsignedInt currentPool{};
+    UnsignedInt setCount{};
+    std::unordered_map<Containers::String, VkDescriptorSet, Magnum::Implementation::StringHash> cache;
+};
+
+struct FrameDescriptorAllocatorState {
+    explicit FrameDescriptorAllocatorState(Device& device, const UnsignedInt frameCount, const UnsignedInt maxSetsPerPool, const Containers::ArrayView<const Containers::Pair<DescriptorType, UnsignedInt>> poolSizes): device{device}, maxSetsPerPool{maxSetsPerPool}, poolSizes{NoInit, poolSizes.size()}, frames{frameCount} {
+        Utility::copy(poolSizes, this->poolSizes);
+    }
+
+    Device& device;
+    UnsignedInt maxSetsPerPool;
+    Containers::Array<Containers::Pair<DescriptorType, UnsignedInt>> poolSizes;
+    Containers::Array<FrameDescriptorAllocatorFrame> frames;
+    UnsignedInt frame{};
+    UnsignedInt poolCount{};
+    UnsignedLong cacheHitCount{}, cacheMissCount{};
+};
+
+}
+
+FrameDescriptorAllocator::FrameDescriptorAllocator(Device& device, const UnsignedInt frameCount, const UnsignedInt maxSetsPerPool, const Containers::ArrayView<const Containers::Pair<DescriptorType, UnsignedInt>> poolSizes) {
+    CORRADE_ASSERT(frameCount && maxSetsPerPool,
+        "Vk::FrameDescriptorAllocator: expected non-zero frame and set count but got" << frameCount << "and" << maxSetsPerPool, );
+    CORRADE_ASSERT(!poolSizes.isEmpty(),
+        "Vk::FrameDescriptorAllocator: there has to be at least one pool size", );
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != poolSizes.size(); ++i)
+        CORRADE_ASSERT(poolSizes[i].second(),
+            "Vk::FrameDescriptorAllocator: pool size" << i << "of" << poolSizes[i].first() << "has no descriptors", );
+    #endif
+
+    _state.emplace(device, frameCount, maxSetsPerPool, poolSizes);
+}
+
+FrameDescriptorAllocator::FrameDescriptorAllocator(Device& device, const UnsignedInt frameCount, const UnsignedInt maxSetsPerPool, const std::initializer_list<Containers::Pair<DescriptorType, UnsignedInt>> poolSizes): FrameDescriptorAllocator{device, frameCount, maxSetsPerPool, Containers::arrayView(poolSizes)} {}
+
+FrameDescriptorAllocator::FrameDescriptorAllocator(NoCreateT) noexcept {}
+
+FrameDescriptorAllocator::FrameDescriptorAllocator(FrameDescriptorAllocator&&) noexcept = default;
+
+FrameDescriptorAllocator::~FrameDescriptorAllocator() = default;
+
+FrameDescriptorAllocator& FrameDescriptorAllocator::operator=(FrameDescriptorAllocator&&) noexcept = default;
+
+UnsignedInt FrameDescriptorAllocator::frameCount() const {
+    return _state ? _state->frames.size() : 0;
+}
+
+UnsignedInt FrameDescriptorAllocator::frame() const {
+    return _state ? _state->frame : 0;
+}
+
+UnsignedInt FrameDescriptorAllocator::poolCount() const {
+    return _state ? _state->poolCount : 0;
+}
+
+UnsignedInt FrameDescriptorAllocator::setCount() const {
+    return _state ? _state->frames[_state->frame].setCount : 0;
+}
+
+UnsignedLong FrameDescriptorAllocator::cacheHitCount() const {
+    return _state ? _state->cacheHitCount : 0;
+}
+
+UnsignedLong FrameDescriptorAllocator::cacheMissCount() const {
+    return _state ? _state->cacheMissCount : 0;
+}
+
+void FrameDescriptorAllocator::resetCacheStatistics() {
+    if(!_state) return;
+    _state->cacheHitCount = _state->cacheMissCount = 0;
+}
+
+VkDescriptorSet FrameDescriptorAllocator::allocate(const VkDescriptorSetLayout layout) {
+    CORRADE_ASSERT(_state,
+        "Vk::FrameDescriptorAllocator::allocate(): the allocator has no descriptor pools", {});
+
+    Implementation::FrameDescriptorAllocatorState& state = *_state;
+    Implementation::FrameDescriptorAllocatorFrame& frame = state.frames[state.frame];
+
+    for(;;) {
+        /* Create a new pool if all existing ones are exhausted */
+        bool created = false;
+        if(frame.currentPool == frame.pools.size()) {
+            arrayAppend(frame.pools, InPlaceInit, state.device, DescriptorPoolCreateInfo{state.maxSetsPerPool, state.poolSizes});
+            ++state.poolCount;
+            created = true;
+        }
+
+        if(Containers::Optional<DescriptorSet> set = frame.pools[frame.currentPool].tryAllocate(layout)) {
+            ++frame.setCount;
+            /* The sets are never freed individually, the pool reset in
+               nextFrame() takes care of everything */
+            return set->release();
+        }
+
+        CORRADE_ASSERT(!created,
+            "Vk::FrameDescriptorAllocator::allocate(): allocation failed in a newly created pool, the layout needs more descriptors than a single pool has", {});
+        ++frame.currentPool;
+    }
+}
+
+VkDescriptorSet FrameDescriptorAllocator::allocate(const VkDescriptorSetLayout layout, const Containers::ArrayView<const DescriptorWrite> writes) {
+    CORRADE_ASSERT(_state,
+        "Vk::FrameDescriptorAllocator::allocate(): the allocator has no descriptor pools", {});
+
+    Implementation::FrameDescriptorAllocatorState& state = *_state;
+    Implementation::FrameDescriptorAllocatorFrame& frame = state.frames[state.frame];
+
+    /* The key is the layout handle followed by all writes. DescriptorWrite
+       has no padding between its members, so the bytes can be used
+       directly. */
+    static_assert(sizeof(DescriptorWrite) == 4*4 + sizeof(VkBuffer) + 2*8 + sizeof(VkImageView) + sizeof(VkSampler),
+        "DescriptorWrite is expected to have no padding");
+    Containers::String key{NoInit, sizeof(VkDescriptorSetLayout) + writes.size()*sizeof(DescriptorWrite)};
+    std::memcpy(key.data(), &layout, sizeof(VkDescriptorSetLayout));
+    if(!writes.isEmpty())
+        std::memcpy(key.data() + sizeof(VkDescriptorSetLayout), writes.data(), writes.size()*sizeof(DescriptorWrite));
+
+    const auto found = frame.cache.find(key);
+    if(found != frame.cache.end()) {
+        ++state.cacheHitCount;
+        return found->second;
+    }
+
+    const VkDescriptorSet set = allocate(layout);
+
+    /* Gather the buffer and image infos first, the write structures then
+       point into them */
+    Containers::Array<VkWriteDescriptorSet> vkWrites{ValueInit, writes.size()};
+    Containers::Array<VkDescriptorBufferInfo> bufferInfos{ValueInit, writes.size()};
+    Containers::Array<VkDescriptorImageInfo> imageInfos{ValueInit, writes.size()};
+    for(std::size_t i = 0; i != writes.size(); ++i) {
+        const DescriptorWrite& write = writes[i];
+        VkWriteDescriptorSet& vkWrite = vkWrites[i];
+        vkWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        vkWrite.dstSet = set;
+        vkWrite.dstBinding = write.binding();
+        vkWrite.dstArrayElement = write.arrayElement();
+        vkWrite.descriptorCount = 1;
+        vkWrite.descriptorType = VkDescriptorType(write.type());
+        if(isBufferDescriptor(write.type())) {
+            bufferInfos[i].buffer = write.buffer();
+            bufferInfos[i].offset = write.offset();
+            bufferInfos[i].range = write.range();
+            vkWrite.pBufferInfo = &bufferInfos[i];
+        } else {
+            imageInfos[i].sampler = write.sampler();
+            imageInfos[i].imageView = write.imageView();
+            imageInfos[i].imageLayout = VkImageLayout(write.imageLayout());
+            vkWrite.pImageInfo = &imageInfos[i];
+        }
+    }
+    if(!vkWrites.isEmpty())
+        state.device->UpdateDescriptorSets(state.device, vkWrites.size(), vkWrites, 0, nullptr);
+
+    frame.cache.emplace(Utility::move(key), set);
+    ++state.cacheMissCount;
+    return set;
+}
+
+VkDescriptorSet FrameDescriptorAllocator::allocate(const VkDescriptorSetLayout layout, const std::initializer_list<DescriptorWrite> writes) {
+    return allocate(layout, Containers::arrayView(writes));
+}
+
+void FrameDescriptorAllocator::nextFrame() {
+    CORRADE_ASSERT(_state,
+        "Vk::FrameDescriptorAllocator::nextFrame(): the allocator has no descriptor pools", );
+
+    Implementation::FrameDescriptorAllocatorState& state = *_state;
+    state.frame = (state.frame + 1) % state.frames.size();
+
+    Implementation::FrameDescriptorAllocatorFrame& frame = state.frames[state.frame];
+    for(DescriptorPool& pool: frame.pools) pool.reset();
+    frame.currentPool = 0;
+    frame.setCount = 0;
+    frame.cache.clear();
+}
+
+void FrameDescriptorAllocator::nextFrame(Fence& fence) {
+    CORRADE_ASSERT(_state,
+        "Vk::FrameDescriptorAllocator::nextFrame(): the allocator has no descriptor pools", );
+
+    fence.wait();
+    nextFrame();
+}
+
+}}
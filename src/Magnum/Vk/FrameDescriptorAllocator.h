@@ -0,0 +1,376 @@
+#ifndef Magnum_Vk_FrameDescriptorAllocator_h
+#define Magnum_Vk_FrameDescriptorAllocator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::FrameDescriptorAllocator, @ref Magnum::Vk::DescriptorWrite
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+namespace Implementation { struct FrameDescriptorAllocatorState; }
+
+/**
+@brief Descriptor write
+@m_since_latest
+
+Describes a single buffer, image or sampler descriptor written into a
+descriptor set by @ref FrameDescriptorAllocator::allocate(VkDescriptorSetLayout, Containers::ArrayView<const DescriptorWrite>).
+Wraps the data going into a @type_vk_keyword{WriteDescriptorSet} together with
+a @type_vk_keyword{DescriptorBufferInfo} or @type_vk_keyword{DescriptorImageInfo}.
+Texel buffer and acceleration structure descriptors aren't supported.
+*/
+class MAGNUM_VK_EXPORT DescriptorWrite {
+    public:
+        /**
+         * @brief Construct a buffer descriptor write
+         * @param binding   Binding index
+         * @param type      Descriptor type. Expected to be one of
+         *      @ref DescriptorType::UniformBuffer,
+         *      @relativeref{DescriptorType,StorageBuffer},
+         *      @relativeref{DescriptorType,UniformBufferDynamic} or
+         *      @relativeref{DescriptorType,StorageBufferDynamic}.
+         * @param buffer    Buffer to bind
+         * @param offset    Offset into the buffer
+         * @param range     Size of the bound range. Use
+         *      @def_vk{WHOLE_SIZE} to bind everything from @p offset until
+         *      the end of the buffer.
+         */
+        explicit DescriptorWrite(UnsignedInt binding, DescriptorType type, VkBuffer buffer, UnsignedLong offset = 0, UnsignedLong range = VK_WHOLE_SIZE) noexcept;
+
+        /**
+         * @brief Construct an image descriptor write
+         * @param binding   Binding index
+         * @param type      Descriptor type. Expected to be one of
+         *      @ref DescriptorType::CombinedImageSampler,
+         *      @relativeref{DescriptorType,SampledImage},
+         *      @relativeref{DescriptorType,StorageImage} or
+         *      @relativeref{DescriptorType,InputAttachment}.
+         * @param imageView Image view to bind
+         * @param layout    Layout the image is in when accessed
+         * @param sampler   Sampler to bind. Used only with
+         *      @ref DescriptorType::CombinedImageSampler and only if the
+         *      layout binding doesn't have an immutable sampler.
+         */
+        explicit DescriptorWrite(UnsignedInt binding, DescriptorType type, VkImageView imageView, ImageLayout layout, VkSampler sampler = {}) noexcept;
+
+        /**
+         * @brief Construct a sampler descriptor write
+         * @param binding   Binding index
+         * @param sampler   Sampler to bind
+         *
+         * The descriptor type is @ref DescriptorType::Sampler.
+         */
+        explicit DescriptorWrite(UnsignedInt binding, VkSampler sampler) noexcept;
+
+        /** @brief Binding index */
+        UnsignedInt binding() const { return _binding; }
+
+        /** @brief Array element */
+        UnsignedInt arrayElement() const { return _arrayElement; }
+
+        /**
+         * @brief Set array element
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp 0 @ce.
+         */
+        DescriptorWrite& setArrayElement(UnsignedInt element) {
+            _arrayElement = element;
+            return *this;
+        }
+
+        /** @brief Descriptor type */
+        DescriptorType type() const { return _type; }
+
+        /**
+         * @brief Buffer
+         *
+         * @cpp nullptr @ce for image and sampler descriptors.
+         */
+        VkBuffer buffer() const { return _buffer; }
+
+        /**
+         * @brief Buffer offset
+         *
+         * @cpp 0 @ce for image and sampler descriptors.
+         */
+        UnsignedLong offset() const { return _offset; }
+
+        /**
+         * @brief Buffer range
+         *
+         * @cpp 0 @ce for image and sampler descriptors.
+         */
+        UnsignedLong range() const { return _range; }
+
+        /**
+         * @brief Image view
+         *
+         * @cpp nullptr @ce for buffer and sampler descriptors.
+         */
+        VkImageView imageView() const { return _imageView; }
+
+        /**
+         * @brief Image layout
+         *
+         * @ref ImageLayout::Undefined for buffer and sampler descriptors.
+         */
+        ImageLayout imageLayout() const { return _imageLayout; }
+
+        /**
+         * @brief Sampler
+         *
+         * @cpp nullptr @ce for buffer descriptors and image descriptors
+         * without a sampler.
+         */
+        VkSampler sampler() const { return _sampler; }
+
+    private:
+        UnsignedInt _binding, _arrayElement;
+        DescriptorType _type;
+        ImageLayout _imageLayout;
+        VkBuffer _buffer;
+        UnsignedLong _offset, _range;
+        VkImageView _imageView;
+        VkSampler _sampler;
+};
+
+/**
+@brief Per-frame linear descriptor set allocator
+@m_since_latest
+
+Allocates short-lived descriptor sets, such as per-draw sets with dynamic
+content, from a growable chain of @ref DescriptorPool instances. The pools are
+duplicated for each frame in flight and all pools of a frame are reset together
+once the frame is reused, which means individual sets are never freed and the
+pools don't suffer from fragmentation. When a pool gets exhausted, allocation
+continues from the next pool in the chain, creating a new one if needed. The
+pools are kept across frames, so after a few frames the allocator reaches a
+steady state where no new pools are created anymore.
+
+@section Vk-FrameDescriptorAllocator-usage Usage
+
+Create the instance with a count of frames in flight, a maximum count of sets
+in a single pool and total descriptor counts of each pool, with the same
+meaning as in @ref DescriptorPoolCreateInfo. At the start of each frame, after
+the fence of the frame that previously used the same set of pools signals, call
+@ref nextFrame(), and then allocate descriptor sets as needed:
+
+@snippet Vk.cpp FrameDescriptorAllocator-usage
+
+@section Vk-FrameDescriptorAllocator-caching Descriptor set caching
+
+Besides plain @ref allocate(VkDescriptorSetLayout), which returns a descriptor
+set with unspecified contents, there's
+@ref allocate(VkDescriptorSetLayout, Containers::ArrayView<const DescriptorWrite>)
+that additionally writes given descriptors to the set using
+@fn_vk_keyword{UpdateDescriptorSets}. The sets allocated this way are cached
+based on the layout and all written descriptors for the duration of the frame,
+and a repeated request for the same combination returns the already written set
+without allocating or updating anything. The cache of a particular frame is
+cleared in @ref nextFrame() together with resetting the pools. Cache
+efficiency can be checked with @ref cacheHitCount() and @ref cacheMissCount().
+
+@attention
+    The class isn't synchronized in any way. If you need to allocate
+    descriptor sets from multiple threads, create one instance per thread.
+*/
+class MAGNUM_VK_EXPORT FrameDescriptorAllocator {
+    public:
+        /**
+         * @brief Constructor
+         * @param device        Vulkan device to create the descriptor pools
+         *      on
+         * @param frameCount    Count of frames in flight. Expected to be
+         *      non-zero.
+         * @param maxSetsPerPool  Maximum count of descriptor sets allocated
+         *      from a single pool. Expected to be non-zero.
+         * @param poolSizes     Total descriptor counts for each descriptor
+         *      type in a single pool. Expected to be non-empty and with all
+         *      counts non-zero.
+         *
+         * No pools are created upfront, the first pool of each frame is
+         * created on the first allocation in that frame. The @ref frame()
+         * is set to @cpp 0 @ce.
+         */
+        explicit FrameDescriptorAllocator(Device& device, UnsignedInt frameCount, UnsignedInt maxSetsPerPool, Containers::ArrayView<const Containers::Pair<DescriptorType, UnsignedInt>> poolSizes);
+
+        /** @overload */
+        explicit FrameDescriptorAllocator(Device& device, UnsignedInt frameCount, UnsignedInt maxSetsPerPool, std::initializer_list<Containers::Pair<DescriptorType, UnsignedInt>> poolSizes);
+
+        /**
+         * @brief Construct without creating the allocator
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit FrameDescriptorAllocator(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        FrameDescriptorAllocator(const FrameDescriptorAllocator&) = delete;
+
+        /** @brief Move constructor */
+        FrameDescriptorAllocator(FrameDescriptorAllocator&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys all descriptor pools, which frees all descriptor sets
+         * allocated from them.
+         * @see @fn_vk_keyword{DestroyDescriptorPool}
+         */
+        ~FrameDescriptorAllocator();
+
+        /** @brief Copying is not allowed */
+        FrameDescriptorAllocator& operator=(const FrameDescriptorAllocator&) = delete;
+
+        /** @brief Move assignment */
+        FrameDescriptorAllocator& operator=(FrameDescriptorAllocator&& other) noexcept;
+
+        /** @brief Count of frames in flight */
+        UnsignedInt frameCount() const;
+
+        /**
+         * @brief Current frame index
+         *
+         * A value in range @f$ [ 0, \operatorname{frameCount}() ) @f$,
+         * advanced by @ref nextFrame().
+         */
+        UnsignedInt frame() const;
+
+        /**
+         * @brief Count of descriptor pools
+         *
+         * Total count of pools created for all frames so far.
+         */
+        UnsignedInt poolCount() const;
+
+        /**
+         * @brief Count of descriptor sets allocated in the current frame
+         *
+         * Sets returned from the cache aren't counted.
+         */
+        UnsignedInt setCount() const;
+
+        /**
+         * @brief Count of cache hits
+         *
+         * Count of @ref allocate(VkDescriptorSetLayout, Containers::ArrayView<const DescriptorWrite>)
+         * calls that returned an already written descriptor set, accumulated
+         * since construction or since the last @ref resetCacheStatistics()
+         * call.
+         */
+        UnsignedLong cacheHitCount() const;
+
+        /**
+         * @brief Count of cache misses
+         *
+         * Count of @ref allocate(VkDescriptorSetLayout, Containers::ArrayView<const DescriptorWrite>)
+         * calls that had to allocate and write a new descriptor set,
+         * accumulated since construction or since the last
+         * @ref resetCacheStatistics() call. The hit rate is then
+         * @ref cacheHitCount() divided by the sum of both.
+         */
+        UnsignedLong cacheMissCount() const;
+
+        /**
+         * @brief Reset cache statistics
+         *
+         * Sets both @ref cacheHitCount() and @ref cacheMissCount() to
+         * @cpp 0 @ce. Doesn't affect the cached descriptor sets.
+         */
+        void resetCacheStatistics();
+
+        /**
+         * @brief Allocate a descriptor set
+         *
+         * Allocates from the current pool of the current frame. If it's
+         * exhausted, moves to the next pool in the frame, creating it if
+         * there isn't any. Expects that the set fits into a newly created
+         * pool. The returned set is valid until the next time the same frame
+         * is reset in @ref nextFrame() and its contents are unspecified.
+         * @see @fn_vk_keyword{AllocateDescriptorSets}
+         */
+        VkDescriptorSet allocate(VkDescriptorSetLayout layout);
+
+        /**
+         * @brief Allocate a descriptor set with given descriptors
+         *
+         * If a set for the same @p layout and the same @p writes was already
+         * allocated in the current frame, returns it directly and increments
+         * @ref cacheHitCount(). Otherwise allocates a new set using
+         * @ref allocate(VkDescriptorSetLayout), writes @p writes to it,
+         * remembers it in the cache and increments @ref cacheMissCount().
+         * The order of @p writes is significant for the cache lookup.
+         * @see @fn_vk_keyword{UpdateDescriptorSets}
+         */
+        VkDescriptorSet allocate(VkDescriptorSetLayout layout, Containers::ArrayView<const DescriptorWrite> writes);
+
+        /** @overload */
+        VkDescriptorSet allocate(VkDescriptorSetLayout layout, std::initializer_list<DescriptorWrite> writes);
+
+        /**
+         * @brief Advance to the next frame
+         *
+         * Sets @ref frame() to the next index, wrapping around to
+         * @cpp 0 @ce after @ref frameCount(), resets all descriptor pools of
+         * that frame and clears its descriptor set cache. Before calling this
+         * function, it's the user responsibility to ensure the GPU finished
+         * executing command buffers from the frame that previously used the
+         * same pools.
+         * @see @fn_vk_keyword{ResetDescriptorPool}
+         */
+        void nextFrame();
+
+        /**
+         * @brief Wait for a fence and advance to the next frame
+         *
+         * Waits for @p fence to become signaled using @ref Fence::wait() and
+         * then calls @ref nextFrame(). The fence is expected to be the one
+         * signaled by the submit of the frame that previously used the next
+         * set of pools. Resetting the fence is left to the caller.
+         */
+        void nextFrame(Fence& fence);
+
+    private:
+        Containers::Pointer<Implementation::FrameDescriptorAllocatorState> _state;
+};
+
+}}
+
+#endif
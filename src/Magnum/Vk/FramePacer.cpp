@@ -0,0 +1,92 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FramePacer.h"
+
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Move.h>
+
+#include "Magnum/Vk/SemaphoreCreateInfo.h"
+
+namespace Magnum { namespace Vk {
+
+FramePacer::FramePacer(Device& device, const UnsignedInt frameCount): _semaphore{NoCreate}, _frameCount{frameCount}, _frameNumber{} {
+    CORRADE_ASSERT(frameCount,
+        "Vk::FramePacer: expected non-zero frame count", );
+
+    _semaphore = Semaphore{device, SemaphoreCreateInfo{SemaphoreCreateInfo::Type::Timeline}};
+}
+
+FramePacer::FramePacer(NoCreateT) noexcept: _semaphore{NoCreate}, _frameCount{}, _frameNumber{} {}
+
+FramePacer::FramePacer(FramePacer&& other) noexcept: _semaphore{Utility::move(other._semaphore)}, _frameCount{other._frameCount}, _frameNumber{other._frameNumber} {
+    other._frameCount = 0;
+    other._frameNumber = 0;
+}
+
+FramePacer::~FramePacer() = default;
+
+FramePacer& FramePacer::operator=(FramePacer&& other) noexcept {
+    using Utility::swap;
+    swap(other._semaphore, _semaphore);
+    swap(other._frameCount, _frameCount);
+    swap(other._frameNumber, _frameNumber);
+    return *this;
+}
+
+UnsignedInt FramePacer::frame() const {
+    return _frameNumber ? (_frameNumber - 1) % _frameCount : 0;
+}
+
+UnsignedLong FramePacer::completedFrameNumber() {
+    CORRADE_ASSERT(_frameCount,
+        "Vk::FramePacer::completedFrameNumber(): the pacer has no semaphore", {});
+    return _semaphore.value();
+}
+
+void FramePacer::beginFrame() {
+    CORRADE_ASSERT(_frameCount,
+        "Vk::FramePacer::beginFrame(): the pacer has no semaphore", );
+
+    ++_frameNumber;
+    if(_frameNumber > _frameCount)
+        _semaphore.wait(_frameNumber - _frameCount);
+}
+
+Containers::Pair<VkSemaphore, UnsignedLong> FramePacer::signalSemaphore() {
+    CORRADE_ASSERT(_frameNumber,
+        "Vk::FramePacer::signalSemaphore(): no frame started", {});
+    return {_semaphore, _frameNumber};
+}
+
+void FramePacer::waitIdle() {
+    CORRADE_ASSERT(_frameCount,
+        "Vk::FramePacer::waitIdle(): the pacer has no semaphore", );
+
+    if(_frameNumber) _semaphore.wait(_frameNumber);
+}
+
+}}
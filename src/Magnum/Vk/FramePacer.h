@@ -0,0 +1,187 @@
+#ifndef Magnum_Vk_FramePacer_h
+#define Magnum_Vk_FramePacer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::FramePacer
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Semaphore.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Frame pacing using a timeline semaphore
+@m_since_latest
+
+Keeps a fixed count of frames in flight, allowing the CPU to record frame
+@f$ n @f$ while the GPU is still executing frames @f$ n - 1 @f$ down to
+@f$ n - \operatorname{frameCount}() + 1 @f$, instead of waiting for a
+@ref Fence of the previous frame every frame and thus serializing CPU and GPU
+work. Frames are numbered from @cpp 1 @ce and the last submit of each frame
+signals a single timeline @ref Semaphore with the frame number. At the start of
+a frame, @ref beginFrame() then waits until the frame that used the same
+per-frame resources, i.e. the frame @ref frameCount() frames ago, finished.
+
+@section Vk-FramePacer-usage Usage
+
+Create the instance with a count of frames in flight. Per-frame resources
+such as command buffers, descriptor sets or uniform buffer ranges are then
+indexed with @ref frame(), or recycled by @ref ThreadCommandPools::nextFrame()
+and @ref FrameDescriptorAllocator::nextFrame() right after @ref beginFrame().
+The last submit of the frame signals the semaphore with a value returned by
+@ref signalSemaphore():
+
+@snippet Vk.cpp FramePacer-usage
+
+Before destroying any per-frame resources, call @ref waitIdle() to ensure the
+GPU isn't using them anymore.
+
+@requires_vk12 Extension @vk_extension{KHR,timeline_semaphore}
+@requires_vk_feature @ref DeviceFeature::TimelineSemaphore
+*/
+class MAGNUM_VK_EXPORT FramePacer {
+    public:
+        /**
+         * @brief Constructor
+         * @param device        Vulkan device to create the timeline
+         *      semaphore on
+         * @param frameCount    Count of frames in flight. Expected to be
+         *      non-zero.
+         *
+         * Creates a timeline @ref Semaphore with an initial value of
+         * @cpp 0 @ce. The @ref frameNumber() is set to @cpp 0 @ce.
+         * @see @fn_vk_keyword{CreateSemaphore}
+         */
+        explicit FramePacer(Device& device, UnsignedInt frameCount);
+
+        /**
+         * @brief Construct without creating the semaphore
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit FramePacer(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        FramePacer(const FramePacer&) = delete;
+
+        /** @brief Move constructor */
+        FramePacer(FramePacer&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys the timeline semaphore. It's the user responsibility to
+         * ensure no submitted work references it anymore, for example by
+         * calling @ref waitIdle().
+         * @see @fn_vk_keyword{DestroySemaphore}
+         */
+        ~FramePacer();
+
+        /** @brief Copying is not allowed */
+        FramePacer& operator=(const FramePacer&) = delete;
+
+        /** @brief Move assignment */
+        FramePacer& operator=(FramePacer&& other) noexcept;
+
+        /** @brief Count of frames in flight */
+        UnsignedInt frameCount() const { return _frameCount; }
+
+        /**
+         * @brief Current frame number
+         *
+         * Incremented by each @ref beginFrame() call, @cpp 0 @ce before the
+         * first frame started.
+         */
+        UnsignedLong frameNumber() const { return _frameNumber; }
+
+        /**
+         * @brief Current frame index
+         *
+         * A value in range @f$ [ 0, \operatorname{frameCount}() ) @f$ for
+         * indexing per-frame resources. Calculated as
+         * @f$ (\operatorname{frameNumber}() - 1) \mod \operatorname{frameCount}() @f$,
+         * @cpp 0 @ce before the first frame started.
+         */
+        UnsignedInt frame() const;
+
+        /** @brief Timeline semaphore signaled by finished frames */
+        Semaphore& semaphore() { return _semaphore; }
+
+        /**
+         * @brief Number of the last finished frame
+         *
+         * Queries the current counter value of the timeline semaphore.
+         * @see @ref Semaphore::value()
+         */
+        UnsignedLong completedFrameNumber();
+
+        /**
+         * @brief Begin a new frame
+         *
+         * Increments @ref frameNumber() and if it's larger than
+         * @ref frameCount(), waits until the frame with number
+         * @ref frameNumber() @cpp - @ce @ref frameCount() finished, which
+         * means resources for the current @ref frame() aren't used by the
+         * GPU anymore and can be recycled.
+         * @see @ref Semaphore::wait()
+         */
+        void beginFrame();
+
+        /**
+         * @brief Semaphore signal for the current frame
+         *
+         * Returns the timeline semaphore and @ref frameNumber(), to be passed
+         * to @ref SubmitInfo::setSignalSemaphores(Containers::ArrayView<const Containers::Pair<VkSemaphore, UnsignedLong>>)
+         * of the last submit in the frame. Expects that @ref beginFrame() was
+         * called at least once.
+         */
+        Containers::Pair<VkSemaphore, UnsignedLong> signalSemaphore();
+
+        /**
+         * @brief Wait for all submitted frames to finish
+         *
+         * Waits until the frame with number @ref frameNumber() finished. If
+         * no frame was started yet, returns immediately.
+         */
+        void waitIdle();
+
+    private:
+        Semaphore _semaphore;
+        UnsignedInt _frameCount;
+        UnsignedLong _frameNumber;
+};
+
+}}
+
+#endif
@@ -35,6 +35,7 @@
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/MemoryAllocator.h"
 #include "Magnum/Vk/Vk.h"
 #include "Magnum/Vk/Vulkan.h"
 #include "Magnum/Vk/visibility.h"
@@ -242,6 +243,14 @@ constructor together with specifying @ref MemoryFlags for memory allocation.
     accessible through @ref dedicatedMemory(). This behavior may change in the
     future.
 
+@subsection Vk-Image-creation-allocator Sub-allocating from a memory allocator
+
+Creating a large amount of images with dedicated allocations is inefficient.
+Pass a @ref MemoryAllocator to the constructor instead to sub-allocate the
+memory from larger blocks. The allocation is then accessible through
+@ref allocation(). See the @ref MemoryAllocator documentation for more
+information.
+
 With an @ref Image ready, you may want to proceed to @ref ImageView creation.
 
 @subsection Vk-Image-creation-custom-allocation Custom memory allocation
@@ -375,6 +384,26 @@ class MAGNUM_VK_EXPORT Image {
          */
         explicit Image(Device& device, const ImageCreateInfo& info, MemoryFlags memoryFlags);
 
+        /**
+         * @brief Construct a image with memory from an allocator
+         * @param device        Vulkan device to create the image on
+         * @param info          Image creation info
+         * @param allocator     Memory allocator
+         * @param memoryFlags   Memory allocation flags
+         *
+         * Compared to @ref Image(Device&, const ImageCreateInfo&, MemoryFlags)
+         * the memory is sub-allocated from @p allocator using
+         * @ref MemoryAllocator::allocate() instead of using a dedicated
+         * allocation. The allocation is subsequently accessible through
+         * @ref allocation() and given back to the allocator on destruction,
+         * which means the @p allocator has to outlive the image.
+         *
+         * If @p info specifies @val_vk{IMAGE_TILING_OPTIMAL,ImageTiling}
+         * tiling, @ref MemoryAllocationFlag::OptimalImage is passed to the
+         * allocator.
+         */
+        explicit Image(Device& device, const ImageCreateInfo& info, MemoryAllocator& allocator, MemoryFlags memoryFlags);
+
         /**
          * @brief Construct without creating the image
          *
@@ -462,6 +491,24 @@ class MAGNUM_VK_EXPORT Image {
          */
         Memory& dedicatedMemory();
 
+        /**
+         * @brief Whether the image has memory from a @ref MemoryAllocator
+         *
+         * Returns @cpp true @ce if the image was created using
+         * @ref Image(Device&, const ImageCreateInfo&, MemoryAllocator&, MemoryFlags),
+         * @cpp false @ce otherwise.
+         * @see @ref allocation()
+         */
+        bool hasAllocation() const;
+
+        /**
+         * @brief Memory allocation
+         *
+         * Expects that the image has memory from a @ref MemoryAllocator.
+         * @see @ref hasAllocation()
+         */
+        MemoryAllocation& allocation();
+
         /**
          * @brief Release the underlying Vulkan image
          *
@@ -502,6 +549,7 @@ class MAGNUM_VK_EXPORT Image {
         PixelFormat _format;
 
         Memory _dedicatedMemory;
+        MemoryAllocation _allocation;
 };
 
 /**
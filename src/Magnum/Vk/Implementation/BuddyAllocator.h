@@ -0,0 +1,169 @@
+#ifndef Magnum_Vk_Implementation_BuddyAllocator_h
+#define Magnum_Vk_Implementation_BuddyAllocator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Magnum.h"
+
+namespace Magnum { namespace Vk { namespace Implementation {
+
+/* Binary buddy sub-allocator used by MemoryAllocator. Operates purely on
+   offsets, knows nothing about Vulkan. The range is a power-of-two `size`
+   split into a complete binary tree of nodes down to `minSize`, node state is
+   stored in a heap-ordered array (children of node `i` are `2i + 1` and
+   `2i + 2`) and each level has a list of its free nodes, so both allocation
+   and deallocation are O(levels) apart from the buddy removal from a free
+   list, which is a linear search but in practice the lists are short. */
+class BuddyAllocator {
+    public:
+        explicit BuddyAllocator(UnsignedLong size, UnsignedLong minSize): _size{size}, _minSize{minSize}, _freeSize{size} {
+            CORRADE_INTERNAL_ASSERT(minSize && !(minSize & (minSize - 1)) && size >= minSize && !(size & (size - 1)));
+
+            _levelCount = 1;
+            for(UnsignedLong nodeSize = size; nodeSize > minSize; nodeSize >>= 1)
+                ++_levelCount;
+            /* Keep the node array at a sane size */
+            CORRADE_INTERNAL_ASSERT(_levelCount <= 24);
+
+            _state = Containers::Array<UnsignedByte>{ValueInit, (std::size_t{1} << _levelCount) - 1};
+            _freeLists = Containers::Array<Containers::Array<UnsignedInt>>{_levelCount};
+            arrayAppend(_freeLists[0], 0u);
+        }
+
+        UnsignedLong size() const { return _size; }
+        UnsignedLong minSize() const { return _minSize; }
+        UnsignedLong freeSize() const { return _freeSize; }
+        bool isEmpty() const { return _freeSize == _size; }
+
+        /* Size of the largest contiguous free range */
+        UnsignedLong largestFreeSize() const {
+            for(UnsignedInt level = 0; level != _levelCount; ++level)
+                if(!_freeLists[level].isEmpty()) return _size >> level;
+            return 0;
+        }
+
+        /* Size of a node that an allocation of given size and alignment would
+           occupy. Alignment is expected to be a power of two (as Vulkan
+           guarantees), node offsets are always a multiple of the node size so
+           it's enough to round up to it. */
+        UnsignedLong nodeSize(UnsignedLong size, UnsignedLong alignment) const {
+            UnsignedLong nodeSize = _minSize;
+            while(nodeSize < size || nodeSize < alignment) nodeSize <<= 1;
+            return nodeSize;
+        }
+
+        Containers::Optional<UnsignedLong> allocate(UnsignedLong size, UnsignedLong alignment) {
+            const UnsignedLong nodeSize = this->nodeSize(size, alignment);
+            if(nodeSize > _size) return {};
+
+            UnsignedInt targetLevel = 0;
+            while((_size >> targetLevel) != nodeSize) ++targetLevel;
+
+            /* Find the closest level with a free node that's large enough */
+            UnsignedInt level = targetLevel + 1;
+            do {
+                --level;
+                if(!_freeLists[level].isEmpty()) break;
+            } while(level);
+            if(_freeLists[level].isEmpty()) return {};
+
+            UnsignedInt node = _freeLists[level].back();
+            arrayRemoveSuffix(_freeLists[level], 1);
+
+            /* Split it until it's the size we need, putting the right halves
+               to free lists */
+            for(; level != targetLevel; ++level) {
+                _state[node] = Split;
+                _state[2*node + 2] = Free;
+                arrayAppend(_freeLists[level + 1], 2*node + 2);
+                node = 2*node + 1;
+            }
+
+            _state[node] = Allocated;
+            _freeSize -= nodeSize;
+            return (node + 1 - (1u << level))*nodeSize;
+        }
+
+        /* Returns size of the freed node */
+        UnsignedLong free(UnsignedLong offset) {
+            /* Descend from the root to find the allocated node */
+            UnsignedInt node = 0;
+            UnsignedInt level = 0;
+            UnsignedLong nodeOffset = 0;
+            while(_state[node] == Split) {
+                const UnsignedLong halfSize = _size >> (level + 1);
+                if(offset - nodeOffset < halfSize) {
+                    node = 2*node + 1;
+                } else {
+                    node = 2*node + 2;
+                    nodeOffset += halfSize;
+                }
+                ++level;
+            }
+            CORRADE_INTERNAL_ASSERT(_state[node] == Allocated && nodeOffset == offset);
+
+            const UnsignedLong nodeSize = _size >> level;
+            _freeSize += nodeSize;
+
+            /* Coalesce with the buddy as long as it's free as well */
+            while(node) {
+                const UnsignedInt buddy = node & 1 ? node + 1 : node - 1;
+                if(_state[buddy] != Free) break;
+
+                Containers::Array<UnsignedInt>& freeList = _freeLists[level];
+                std::size_t i = freeList.size();
+                while(freeList[--i] != buddy);
+                freeList[i] = freeList.back();
+                arrayRemoveSuffix(freeList, 1);
+
+                node = (node - 1)/2;
+                --level;
+            }
+
+            _state[node] = Free;
+            arrayAppend(_freeLists[level], node);
+            return nodeSize;
+        }
+
+    private:
+        enum: UnsignedByte {
+            Free = 0,
+            Split = 1,
+            Allocated = 2
+        };
+
+        UnsignedLong _size, _minSize, _freeSize;
+        UnsignedInt _levelCount;
+        Containers::Array<UnsignedByte> _state;
+        Containers::Array<Containers::Array<UnsignedInt>> _freeLists;
+};
+
+}}}
+
+#endif
@@ -32,6 +32,7 @@
 #include "Magnum/Vk/Extensions.h"
 #include "Magnum/Vk/Image.h"
 #include "Magnum/Vk/RenderPass.h"
+#include "Magnum/Vk/Semaphore.h"
 #include "Magnum/Vk/Shader.h"
 #include "Magnum/Vk/Version.h"
 #include "Magnum/Vk/Implementation/DriverWorkaround.h"
@@ -89,6 +90,19 @@ DeviceState::DeviceState(Device& device, Containers::Array<Containers::Pair<Cont
         cmdEndRenderPassImplementation = &CommandBuffer::endRenderPassImplementationDefault;
     }
 
+    /* There's no fallback for timeline semaphores, if neither 1.2 nor the
+       extension is available, the KHR function pointers are null and the
+       semaphore creation would fail anyway */
+    if(device.isVersionSupported(Version::Vk12)) {
+        getSemaphoreCounterValueImplementation = &Semaphore::getCounterValueImplementation12;
+        signalSemaphoreImplementation = &Semaphore::signalImplementation12;
+        waitSemaphoresImplementation = &Semaphore::waitImplementation12;
+    } else {
+        getSemaphoreCounterValueImplementation = &Semaphore::getCounterValueImplementationKHR;
+        signalSemaphoreImplementation = &Semaphore::signalImplementationKHR;
+        waitSemaphoresImplementation = &Semaphore::waitImplementationKHR;
+    }
+
     if(device.isExtensionEnabled<Extensions::EXT::extended_dynamic_state>()) {
         cmdBindVertexBuffersImplementation = &CommandBuffer::bindVertexBuffersImplementationEXT;
     } else {
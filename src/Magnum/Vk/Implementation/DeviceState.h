@@ -54,6 +54,10 @@ struct DeviceState {
     void(*cmdNextSubpassImplementation)(CommandBuffer&, const VkSubpassEndInfo&, const VkSubpassBeginInfo&);
     void(*cmdEndRenderPassImplementation)(CommandBuffer&, const VkSubpassEndInfo&);
 
+    VkResult(*getSemaphoreCounterValueImplementation)(Device&, VkSemaphore, UnsignedLong&);
+    VkResult(*signalSemaphoreImplementation)(Device&, const VkSemaphoreSignalInfo&);
+    VkResult(*waitSemaphoresImplementation)(Device&, const VkSemaphoreWaitInfo&, UnsignedLong);
+
     VkResult(*createShaderImplementation)(Device&, const VkShaderModuleCreateInfo&, const VkAllocationCallbacks*, VkShaderModule&);
 
     void(*cmdBindVertexBuffersImplementation)(CommandBuffer&, UnsignedInt, UnsignedInt, const VkBuffer*, const UnsignedLong*, const UnsignedLong*);
@@ -0,0 +1,187 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include "LayoutCache.h"
+
+#include <algorithm> /* std::sort() */
+#include <cstring>
+#include <unordered_map>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/String.h>
+
+#include "Magnum/Implementation/stringHash.h"
+#include "Magnum/Vk/DescriptorSetLayout.h"
+#include "Magnum/Vk/DescriptorSetLayoutCreateInfo.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/PipelineLayout.h"
+#include "Magnum/Vk/PipelineLayoutCreateInfo.h"
+#include "Magnum/Vk/ShaderReflection.h"
+
+namespace Magnum { namespace Vk {
+
+namespace Implementation {
+
+namespace {
+
+template<class T> void appendKey(Containers::Array<char>& key, const T& value) {
+    arrayAppend(key, Containers::arrayView(reinterpret_cast<const char*>(&value), sizeof(T)));
+}
+
+}
+
+struct LayoutCacheState {
+    explicit LayoutCacheState(Device& device): device{device} {}
+
+    Device& device;
+    std::unordered_map<Containers::String, DescriptorSetLayout, Magnum::Implementation::StringHash> descriptorSetLayouts;
+    std::unordered_map<Containers::String, PipelineLayout, Magnum::Implementation::StringHash> pipelineLayouts;
+    UnsignedLong cacheHitCount{}, cacheMissCount{};
+};
+
+}
+
+LayoutCache::LayoutCache(Device& device): _state{InPlaceInit, device} {}
+
+LayoutCache::LayoutCache(NoCreateT) noexcept {}
+
+LayoutCache::LayoutCache(LayoutCache&&) noexcept = default;
+
+LayoutCache::~LayoutCache() = default;
+
+LayoutCache& LayoutCache::operator=(LayoutCache&&) noexcept = default;
+
+UnsignedInt LayoutCache::descriptorSetLayoutCount() const {
+    return _state ? _state->descriptorSetLayouts.size() : 0;
+}
+
+UnsignedInt LayoutCache::pipelineLayoutCount() const {
+    return _state ? _state->pipelineLayouts.size() : 0;
+}
+
+UnsignedLong LayoutCache::cacheHitCount() const {
+    return _state ? _state->cacheHitCount : 0;
+}
+
+UnsignedLong LayoutCache::cacheMissCount() const {
+    return _state ? _state->cacheMissCount : 0;
+}
+
+VkDescriptorSetLayout LayoutCache::descriptorSetLayout(const DescriptorSetLayoutCreateInfo& info) {
+    CORRADE_ASSERT(_state,
+        "Vk::LayoutCache::descriptorSetLayout(): the cache has no device", {});
+
+    /* The only pNext structure that's understood is the one containing
+       per-binding flags, which is what DescriptorSetLayoutCreateInfo itself
+       puts there */
+    const VkDescriptorBindingFlags* bindingFlags = nullptr;
+    if(info->pNext) {
+        const auto& bindingFlagsInfo = *static_cast<const VkDescriptorSetLayoutBindingFlagsCreateInfo*>(info->pNext);
+        CORRADE_ASSERT(bindingFlagsInfo.sType == VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO && !bindingFlagsInfo.pNext,
+            "Vk::LayoutCache::descriptorSetLayout(): only binding flags are supported in the pNext chain", {});
+        bindingFlags = bindingFlagsInfo.pBindingFlags;
+    }
+
+    /* Sort the bindings by their index so the order in which they were
+       specified doesn't matter */
+    Containers::Array<UnsignedInt> order{NoInit, info->bindingCount};
+    for(UnsignedInt i = 0; i != order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&info](UnsignedInt a, UnsignedInt b) {
+        return info->pBindings[a].binding < info->pBindings[b].binding;
+    });
+
+    /* The key is the flags followed by all bindings and their immutable
+       samplers */
+    Containers::Array<char> keyData;
+    Implementation::appendKey(keyData, info->flags);
+    for(const UnsignedInt i: order) {
+        const VkDescriptorSetLayoutBinding& binding = info->pBindings[i];
+        Implementation::appendKey(keyData, binding.binding);
+        Implementation::appendKey(keyData, binding.descriptorType);
+        Implementation::appendKey(keyData, binding.descriptorCount);
+        Implementation::appendKey(keyData, binding.stageFlags);
+        Implementation::appendKey(keyData, bindingFlags ? bindingFlags[i] : VkDescriptorBindingFlags{});
+        const UnsignedInt immutableSamplerCount = binding.pImmutableSamplers ? binding.descriptorCount : 0;
+        Implementation::appendKey(keyData, immutableSamplerCount);
+        for(UnsignedInt j = 0; j != immutableSamplerCount; ++j)
+            Implementation::appendKey(keyData, binding.pImmutableSamplers[j]);
+    }
+    Containers::String key{keyData.data(), keyData.size()};
+
+    Implementation::LayoutCacheState& state = *_state;
+    const auto found = state.descriptorSetLayouts.find(key);
+    if(found != state.descriptorSetLayouts.end()) {
+        ++state.cacheHitCount;
+        return found->second.handle();
+    }
+
+    ++state.cacheMissCount;
+    return state.descriptorSetLayouts.emplace(Utility::move(key), DescriptorSetLayout{state.device, info}).first->second.handle();
+}
+
+VkPipelineLayout LayoutCache::pipelineLayout(const PipelineLayoutCreateInfo& info) {
+    CORRADE_ASSERT(_state,
+        "Vk::LayoutCache::pipelineLayout(): the cache has no device", {});
+    CORRADE_ASSERT(!info->pNext,
+        "Vk::LayoutCache::pipelineLayout(): the pNext chain is expected to be empty", {});
+
+    /* The key is the flags followed by the layouts and push constant ranges,
+       both of which are order-dependent. Set layouts are compared by their
+       handles, which is fine for those coming from descriptorSetLayout(). */
+    Containers::Array<char> keyData;
+    Implementation::appendKey(keyData, info->flags);
+    Implementation::appendKey(keyData, info->setLayoutCount);
+    for(UnsignedInt i = 0; i != info->setLayoutCount; ++i)
+        Implementation::appendKey(keyData, info->pSetLayouts[i]);
+    for(UnsignedInt i = 0; i != info->pushConstantRangeCount; ++i) {
+        const VkPushConstantRange& range = info->pPushConstantRanges[i];
+        Implementation::appendKey(keyData, range.stageFlags);
+        Implementation::appendKey(keyData, range.offset);
+        Implementation::appendKey(keyData, range.size);
+    }
+    Containers::String key{keyData.data(), keyData.size()};
+
+    Implementation::LayoutCacheState& state = *_state;
+    const auto found = state.pipelineLayouts.find(key);
+    if(found != state.pipelineLayouts.end()) {
+        ++state.cacheHitCount;
+        return found->second.handle();
+    }
+
+    ++state.cacheMissCount;
+    return state.pipelineLayouts.emplace(Utility::move(key), PipelineLayout{state.device, info}).first->second.handle();
+}
+
+VkPipelineLayout LayoutCache::pipelineLayout(const ShaderReflection& reflection) {
+    CORRADE_ASSERT(_state,
+        "Vk::LayoutCache::pipelineLayout(): the cache has no device", {});
+
+    Containers::Array<VkDescriptorSetLayout> setLayouts{NoInit, reflection.descriptorSetCount()};
+    for(UnsignedInt i = 0; i != setLayouts.size(); ++i)
+        setLayouts[i] = descriptorSetLayout(reflection.descriptorSetLayoutCreateInfo(i));
+
+    return pipelineLayout(PipelineLayoutCreateInfo{setLayouts, reflection.pushConstantRanges()});
+}
+
+}}
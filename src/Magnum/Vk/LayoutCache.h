@@ -0,0 +1,184 @@
+#ifndef Magnum_Vk_LayoutCache_h
+#define Magnum_Vk_LayoutCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::LayoutCache
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+namespace Implementation { struct LayoutCacheState; }
+
+/**
+@brief Descriptor set and pipeline layout cache
+@m_since_latest
+
+Deduplicates @ref DescriptorSetLayout and @ref PipelineLayout instances
+created from equivalent create info structures. A lookup for a layout that was
+created before returns the existing handle instead of creating a new one,
+which is useful especially when many pipelines are created from shaders that
+share the same resource interface. All layouts are owned by the cache and stay
+valid until it's destroyed.
+
+@section Vk-LayoutCache-usage Usage
+
+Together with @ref ShaderReflection, the cache allows creating a pipeline
+layout directly from SPIR-V code, with descriptor set layouts shared among all
+pipelines that use them:
+
+@snippet Vk.cpp LayoutCache-usage
+
+The layouts can be also created from explicitly filled
+@ref DescriptorSetLayoutCreateInfo and @ref PipelineLayoutCreateInfo. The
+order of bindings in @ref DescriptorSetLayoutCreateInfo doesn't matter for the
+lookup, while the order of descriptor set layouts and push constant ranges in
+@ref PipelineLayoutCreateInfo does. Cache efficiency can be checked with
+@ref cacheHitCount() and @ref cacheMissCount().
+
+@attention
+    The class isn't synchronized in any way. If you need to look up layouts
+    from multiple threads, guard the access with a mutex.
+*/
+class MAGNUM_VK_EXPORT LayoutCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param device    Vulkan device to create the layouts on
+         *
+         * No layouts are created upfront.
+         */
+        explicit LayoutCache(Device& device);
+
+        /**
+         * @brief Construct without creating the cache
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit LayoutCache(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        LayoutCache(const LayoutCache&) = delete;
+
+        /** @brief Move constructor */
+        LayoutCache(LayoutCache&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys all cached layouts. All pipelines created with them have
+         * to be destroyed before.
+         * @see @fn_vk_keyword{DestroyDescriptorSetLayout},
+         *      @fn_vk_keyword{DestroyPipelineLayout}
+         */
+        ~LayoutCache();
+
+        /** @brief Copying is not allowed */
+        LayoutCache& operator=(const LayoutCache&) = delete;
+
+        /** @brief Move assignment */
+        LayoutCache& operator=(LayoutCache&& other) noexcept;
+
+        /** @brief Count of cached descriptor set layouts */
+        UnsignedInt descriptorSetLayoutCount() const;
+
+        /** @brief Count of cached pipeline layouts */
+        UnsignedInt pipelineLayoutCount() const;
+
+        /**
+         * @brief Count of cache hits
+         *
+         * Count of @ref descriptorSetLayout() and @ref pipelineLayout() calls
+         * that returned an existing layout, accumulated since construction.
+         * Descriptor set layout lookups done by
+         * @ref pipelineLayout(const ShaderReflection&) are counted as well.
+         */
+        UnsignedLong cacheHitCount() const;
+
+        /**
+         * @brief Count of cache misses
+         *
+         * Count of @ref descriptorSetLayout() and @ref pipelineLayout() calls
+         * that had to create a new layout, accumulated since construction.
+         * The hit rate is then @ref cacheHitCount() divided by the sum of
+         * both.
+         */
+        UnsignedLong cacheMissCount() const;
+
+        /**
+         * @brief Get a descriptor set layout
+         *
+         * If a layout with the same flags and the same bindings was created
+         * already, returns it, otherwise creates a new one. The bindings are
+         * compared including immutable samplers and per-binding flags
+         * coming from @type_vk{DescriptorSetLayoutBindingFlagsCreateInfo}.
+         * Expects that the `pNext` chain of @p info contains nothing else.
+         * @see @fn_vk_keyword{CreateDescriptorSetLayout}
+         */
+        VkDescriptorSetLayout descriptorSetLayout(const DescriptorSetLayoutCreateInfo& info);
+
+        /**
+         * @brief Get a pipeline layout
+         *
+         * If a layout with the same flags, the same descriptor set layouts
+         * and the same push constant ranges was created already, returns it,
+         * otherwise creates a new one. Expects that @p info has an empty
+         * `pNext` chain.
+         * @see @fn_vk_keyword{CreatePipelineLayout}
+         */
+        VkPipelineLayout pipelineLayout(const PipelineLayoutCreateInfo& info);
+
+        /**
+         * @brief Get a pipeline layout for a shader reflection
+         *
+         * Gets a descriptor set layout for each of
+         * @ref ShaderReflection::descriptorSetCount() sets using
+         * @ref descriptorSetLayout() with
+         * @ref ShaderReflection::descriptorSetLayoutCreateInfo() and then a
+         * pipeline layout with these and
+         * @ref ShaderReflection::pushConstantRanges() using
+         * @ref pipelineLayout(const PipelineLayoutCreateInfo&).
+         */
+        VkPipelineLayout pipelineLayout(const ShaderReflection& reflection);
+
+    private:
+        Containers::Pointer<Implementation::LayoutCacheState> _state;
+};
+
+}}
+
+#endif
@@ -0,0 +1,358 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MemoryAllocator.h"
+
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Math.h>
+
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/MemoryAllocateInfo.h"
+#include "Magnum/Vk/Implementation/BuddyAllocator.h"
+
+namespace Magnum { namespace Vk {
+
+namespace Implementation {
+
+struct MemoryAllocatorBlock {
+    explicit MemoryAllocatorBlock(Memory&& memory, const UnsignedInt memoryIndex, const bool optimalImage): memory{Utility::move(memory)}, memoryIndex{memoryIndex}, optimalImage{optimalImage} {}
+
+    Memory memory;
+    /* Declared after the memory so it's unmapped before the memory gets
+       freed */
+    Containers::Array<char, MemoryMapDeleter> mapped;
+    /* Empty for dedicated allocations */
+    Containers::Optional<BuddyAllocator> allocator;
+    UnsignedInt memoryIndex;
+    bool optimalImage;
+    std::size_t allocationCount{};
+};
+
+struct MemoryAllocatorState {
+    explicit MemoryAllocatorState(Device& device, const UnsignedLong blockSize, const UnsignedLong minAllocationSize): device{&device}, blockSize{blockSize}, minAllocationSize{minAllocationSize} {
+        /* If the granularity is larger than the smallest allocation, a linear
+           buffer and an optimal image could end up on the same page, which is
+           disallowed. Putting optimal images into separate blocks is easier
+           than padding allocations in a buddy allocator. */
+        separateOptimalImages = device.properties().properties().properties.limits.bufferImageGranularity > minAllocationSize;
+    }
+
+    MemoryAllocatorBlock& addBlock(UnsignedLong size, UnsignedInt memoryIndex, bool optimalImage, bool dedicated);
+    void removeBlock(MemoryAllocatorBlock& block);
+    void free(MemoryAllocatorBlock& block, UnsignedLong offset);
+
+    Device* device;
+    UnsignedLong blockSize, minAllocationSize;
+    bool separateOptimalImages;
+    Containers::Array<Containers::Pointer<MemoryAllocatorBlock>> blocks;
+    std::size_t allocationCount{};
+};
+
+MemoryAllocatorBlock& MemoryAllocatorState::addBlock(const UnsignedLong size, const UnsignedInt memoryIndex, const bool optimalImage, const bool dedicated) {
+    Containers::Pointer<MemoryAllocatorBlock> block = Containers::pointer<MemoryAllocatorBlock>(Memory{*device, MemoryAllocateInfo{size, memoryIndex}}, memoryIndex, optimalImage);
+    if(!dedicated)
+        block->allocator.emplace(size, minAllocationSize);
+
+    /* Persistently map all host-visible memory, mapping again for every
+       access is needlessly expensive */
+    if(device->properties().memoryFlags(memoryIndex) & MemoryFlag::HostVisible)
+        block->mapped = block->memory.map();
+
+    MemoryAllocatorBlock& out = *block;
+    arrayAppend(blocks, Utility::move(block));
+    return out;
+}
+
+void MemoryAllocatorState::removeBlock(MemoryAllocatorBlock& block) {
+    for(std::size_t i = 0; i != blocks.size(); ++i) {
+        if(blocks[i].get() != &block) continue;
+        if(i != blocks.size() - 1)
+            blocks[i] = Utility::move(blocks.back());
+        arrayRemoveSuffix(blocks, 1);
+        return;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+void MemoryAllocatorState::free(MemoryAllocatorBlock& block, const UnsignedLong offset) {
+    --allocationCount;
+    --block.allocationCount;
+
+    if(!block.allocator) {
+        removeBlock(block);
+        return;
+    }
+
+    block.allocator->free(offset);
+    if(block.allocationCount) return;
+
+    /* Keep one empty block per memory type around to avoid allocation churn
+       when a single resource gets repeatedly created and destroyed, but free
+       the others */
+    for(const Containers::Pointer<MemoryAllocatorBlock>& other: blocks) {
+        if(other.get() == &block || !other->allocator || other->allocationCount || other->memoryIndex != block.memoryIndex || other->optimalImage != block.optimalImage) continue;
+        removeBlock(block);
+        return;
+    }
+}
+
+}
+
+Debug& operator<<(Debug& debug, const MemoryAllocationFlag value) {
+    debug << "Vk::MemoryAllocationFlag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Vk::MemoryAllocationFlag::value: return debug << "::" << Debug::nospace << #value;
+        _c(Dedicated)
+        _c(OptimalImage)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    /* Flag bits should be in hex, unlike plain values */
+    return debug << "(" << Debug::nospace << Debug::hex << UnsignedInt(value) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const MemoryAllocationFlags value) {
+    return Containers::enumSetDebugOutput(debug, value, "Vk::MemoryAllocationFlags{}", {
+        Vk::MemoryAllocationFlag::Dedicated,
+        Vk::MemoryAllocationFlag::OptimalImage});
+}
+
+MemoryAllocation::MemoryAllocation(Implementation::MemoryAllocatorState& state, Implementation::MemoryAllocatorBlock& block, const UnsignedLong offset, const UnsignedLong size) noexcept: _state{&state}, _block{&block}, _offset{offset}, _size{size} {}
+
+MemoryAllocation::MemoryAllocation(NoCreateT) noexcept: _state{}, _block{}, _offset{}, _size{} {}
+
+MemoryAllocation::MemoryAllocation(MemoryAllocation&& other) noexcept: _state{other._state}, _block{other._block}, _offset{other._offset}, _size{other._size} {
+    other._state = {};
+    other._block = {};
+}
+
+MemoryAllocation::~MemoryAllocation() {
+    if(_block) _state->free(*_block, _offset);
+}
+
+MemoryAllocation& MemoryAllocation::operator=(MemoryAllocation&& other) noexcept {
+    using Utility::swap;
+    swap(other._state, _state);
+    swap(other._block, _block);
+    swap(other._offset, _offset);
+    swap(other._size, _size);
+    return *this;
+}
+
+Memory& MemoryAllocation::memory() {
+    #ifndef CORRADE_NO_ASSERT
+    /* There's no block to return a memory reference from, so return an empty
+       instance in case of a graceful assert */
+    if(!_block) {
+        static Memory empty{NoCreate};
+        CORRADE_ASSERT_UNREACHABLE("Vk::MemoryAllocation::memory(): the instance holds no allocation", empty);
+    }
+    #endif
+    return _block->memory;
+}
+
+UnsignedInt MemoryAllocation::memoryIndex() const {
+    CORRADE_ASSERT(_block,
+        "Vk::MemoryAllocation::memoryIndex(): the instance holds no allocation", {});
+    return _block->memoryIndex;
+}
+
+bool MemoryAllocation::isDedicated() const {
+    CORRADE_ASSERT(_block,
+        "Vk::MemoryAllocation::isDedicated(): the instance holds no allocation", {});
+    return !_block->allocator;
+}
+
+Containers::ArrayView<char> MemoryAllocation::mappedData() {
+    CORRADE_ASSERT(_block,
+        "Vk::MemoryAllocation::mappedData(): the instance holds no allocation", {});
+    CORRADE_ASSERT(!_block->mapped.isEmpty(),
+        "Vk::MemoryAllocation::mappedData(): the memory is not host-visible", {});
+    return _block->mapped.slice(_offset, _offset + _size);
+}
+
+MemoryAllocator::MemoryAllocator(Device& device, const UnsignedLong blockSize, const UnsignedLong minAllocationSize) {
+    CORRADE_ASSERT(blockSize && !(blockSize & (blockSize - 1)) && minAllocationSize && !(minAllocationSize & (minAllocationSize - 1)) && blockSize >= minAllocationSize && blockSize/minAllocationSize <= (1 << 23),
+        "Vk::MemoryAllocator: expected block size and minimal allocation size to be powers of two with a ratio between 1 and 8388608, got" << blockSize << "and" << minAllocationSize, );
+    _state.emplace(device, blockSize, minAllocationSize);
+}
+
+MemoryAllocator::MemoryAllocator(NoCreateT) noexcept {}
+
+MemoryAllocator::MemoryAllocator(MemoryAllocator&&) noexcept = default;
+
+MemoryAllocator::~MemoryAllocator() {
+    CORRADE_ASSERT(!_state || !_state->allocationCount,
+        "Vk::MemoryAllocator: destroyed with" << _state->allocationCount << "allocations still alive", );
+}
+
+MemoryAllocator& MemoryAllocator::operator=(MemoryAllocator&&) noexcept = default;
+
+UnsignedLong MemoryAllocator::blockSize() const {
+    return _state ? _state->blockSize : 0;
+}
+
+UnsignedLong MemoryAllocator::minAllocationSize() const {
+    return _state ? _state->minAllocationSize : 0;
+}
+
+MemoryAllocation MemoryAllocator::allocate(const MemoryRequirements& requirements, const MemoryFlags requiredFlags, const MemoryFlags preferredFlags, const MemoryAllocationFlags flags) {
+    CORRADE_ASSERT(_state,
+        "Vk::MemoryAllocator::allocate(): the allocator is not created", MemoryAllocation{NoCreate});
+
+    Implementation::MemoryAllocatorState& state = *_state;
+    const UnsignedInt memoryIndex = state.device->properties().pickMemory(requiredFlags, preferredFlags, requirements.memories());
+    const UnsignedLong size = requirements.size();
+
+    /* Dedicated allocation, the alignment is implicitly satisfied by the
+       offset being zero */
+    if((flags & MemoryAllocationFlag::Dedicated) || size > state.blockSize/2) {
+        Implementation::MemoryAllocatorBlock& block = state.addBlock(size, memoryIndex, false, true);
+        ++block.allocationCount;
+        ++state.allocationCount;
+        return MemoryAllocation{state, block, 0, size};
+    }
+
+    const bool optimalImage = state.separateOptimalImages && (flags & MemoryAllocationFlag::OptimalImage);
+
+    /* Try to fit into an existing block first */
+    for(Containers::Pointer<Implementation::MemoryAllocatorBlock>& block: state.blocks) {
+        if(!block->allocator || block->memoryIndex != memoryIndex || block->optimalImage != optimalImage) continue;
+
+        if(const Containers::Optional<UnsignedLong> offset = block->allocator->allocate(size, requirements.alignment())) {
+            ++block->allocationCount;
+            ++state.allocationCount;
+            return MemoryAllocation{state, *block, *offset, size};
+        }
+    }
+
+    /* Otherwise allocate a new block. The size is at most half the block
+       size so it'll always fit unless the alignment is absurdly large. */
+    Implementation::MemoryAllocatorBlock& block = state.addBlock(state.blockSize, memoryIndex, optimalImage, false);
+    const Containers::Optional<UnsignedLong> offset = block.allocator->allocate(size, requirements.alignment());
+    CORRADE_INTERNAL_ASSERT(offset);
+    ++block.allocationCount;
+    ++state.allocationCount;
+    return MemoryAllocation{state, block, *offset, size};
+}
+
+std::size_t MemoryAllocator::blockCount() const {
+    if(!_state) return 0;
+    std::size_t count = 0;
+    for(const Containers::Pointer<Implementation::MemoryAllocatorBlock>& block: _state->blocks)
+        if(block->allocator) ++count;
+    return count;
+}
+
+std::size_t MemoryAllocator::dedicatedAllocationCount() const {
+    if(!_state) return 0;
+    std::size_t count = 0;
+    for(const Containers::Pointer<Implementation::MemoryAllocatorBlock>& block: _state->blocks)
+        if(!block->allocator) ++count;
+    return count;
+}
+
+std::size_t MemoryAllocator::allocationCount() const {
+    return _state ? _state->allocationCount : 0;
+}
+
+UnsignedLong MemoryAllocator::allocatedSize() const {
+    if(!_state) return 0;
+    UnsignedLong size = 0;
+    for(const Containers::Pointer<Implementation::MemoryAllocatorBlock>& block: _state->blocks)
+        size += block->memory.size();
+    return size;
+}
+
+UnsignedLong MemoryAllocator::usedSize() const {
+    if(!_state) return 0;
+    UnsignedLong size = 0;
+    for(const Containers::Pointer<Implementation::MemoryAllocatorBlock>& block: _state->blocks)
+        size += block->allocator ? block->allocator->size() - block->allocator->freeSize() : block->memory.size();
+    return size;
+}
+
+Float MemoryAllocator::fragmentation() const {
+    if(!_state) return 0.0f;
+    UnsignedLong freeSize = 0;
+    UnsignedLong largestFreeSize = 0;
+    for(const Containers::Pointer<Implementation::MemoryAllocatorBlock>& block: _state->blocks) {
+        if(!block->allocator) continue;
+        freeSize += block->allocator->freeSize();
+        largestFreeSize = Utility::max(largestFreeSize, block->allocator->largestFreeSize());
+    }
+
+    return freeSize ? 1.0f - Float(largestFreeSize)/Float(freeSize) : 0.0f;
+}
+
+MemoryArena::MemoryArena(Device& device, const UnsignedLong size, const MemoryFlags requiredFlags, const MemoryFlags preferredFlags, const UnsignedInt memories): _memory{NoCreate}, _memoryIndex{device.properties().pickMemory(requiredFlags, preferredFlags, memories)}, _offset{} {
+    _memory = Memory{device, MemoryAllocateInfo{size, _memoryIndex}};
+    if(device.properties().memoryFlags(_memoryIndex) & MemoryFlag::HostVisible)
+        _mapped = _memory.map();
+}
+
+MemoryArena::MemoryArena(NoCreateT): _memory{NoCreate}, _memoryIndex{}, _offset{} {}
+
+MemoryArena::MemoryArena(MemoryArena&& other) noexcept: _memory{Utility::move(other._memory)}, _mapped{Utility::move(other._mapped)}, _memoryIndex{other._memoryIndex}, _offset{other._offset} {}
+
+MemoryArena& MemoryArena::operator=(MemoryArena&& other) noexcept {
+    using Utility::swap;
+    /* Unmapping has to happen before the memory is freed, which is ensured
+       by the member order in the destructor, so the order of swaps here
+       doesn't matter */
+    swap(other._memory, _memory);
+    swap(other._mapped, _mapped);
+    swap(other._memoryIndex, _memoryIndex);
+    swap(other._offset, _offset);
+    return *this;
+}
+
+Containers::Optional<UnsignedLong> MemoryArena::allocate(const MemoryRequirements& requirements) {
+    CORRADE_ASSERT(requirements.memories() & (1u << _memoryIndex),
+        "Vk::MemoryArena::allocate(): memory type" << _memoryIndex << "not allowed by requirements" << Debug::hex << requirements.memories(), {});
+
+    const UnsignedLong alignment = requirements.alignment() ? requirements.alignment() : 1;
+    const UnsignedLong offset = (_offset + alignment - 1)/alignment*alignment;
+    if(offset + requirements.size() > _memory.size()) return {};
+
+    _offset = offset + requirements.size();
+    return offset;
+}
+
+Containers::ArrayView<char> MemoryArena::mappedData() {
+    CORRADE_ASSERT(!_mapped.isEmpty(),
+        "Vk::MemoryArena::mappedData(): the memory is not host-visible", {});
+    return _mapped;
+}
+
+}}
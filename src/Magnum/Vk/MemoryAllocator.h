@@ -0,0 +1,470 @@
+#ifndef Magnum_Vk_MemoryAllocator_h
+#define Magnum_Vk_MemoryAllocator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::MemoryAllocator, @ref Magnum::Vk::MemoryAllocation, @ref Magnum::Vk::MemoryArena, enum @ref Magnum::Vk::MemoryAllocationFlag, enum set @ref Magnum::Vk::MemoryAllocationFlags
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+namespace Implementation {
+    struct MemoryAllocatorState;
+    struct MemoryAllocatorBlock;
+}
+
+/**
+@brief Memory allocation flag
+@m_since_latest
+
+@see @ref MemoryAllocationFlags, @ref MemoryAllocator::allocate()
+*/
+enum class MemoryAllocationFlag: UnsignedByte {
+    /**
+     * Always use a dedicated @ref Memory for the allocation instead of
+     * sub-allocating it from a shared block. Allocations larger than half
+     * of @ref MemoryAllocator::blockSize() are dedicated implicitly.
+     */
+    Dedicated = 1 << 0,
+
+    /**
+     * The allocation is for an image with
+     * @val_vk{IMAGE_TILING_OPTIMAL,ImageTiling} tiling. If the
+     * device reports a @cpp bufferImageGranularity @ce larger than the
+     * minimal allocation size, such allocations are put into separate blocks
+     * to avoid linear and optimal resources aliasing the same memory page.
+     * Set implicitly by @ref Image::Image(Device&, const ImageCreateInfo&, MemoryAllocator&, MemoryFlags).
+     */
+    OptimalImage = 1 << 1
+};
+
+/**
+@debugoperatorenum{MemoryAllocationFlag}
+@m_since_latest
+*/
+MAGNUM_VK_EXPORT Debug& operator<<(Debug& debug, MemoryAllocationFlag value);
+
+/**
+@brief Memory allocation flags
+@m_since_latest
+
+@see @ref MemoryAllocator::allocate()
+*/
+typedef Containers::EnumSet<MemoryAllocationFlag> MemoryAllocationFlags;
+
+CORRADE_ENUMSET_OPERATORS(MemoryAllocationFlags)
+
+/**
+@debugoperatorenum{MemoryAllocationFlags}
+@m_since_latest
+*/
+MAGNUM_VK_EXPORT Debug& operator<<(Debug& debug, MemoryAllocationFlags value);
+
+/**
+@brief Memory allocation
+@m_since_latest
+
+A range of @ref Memory returned from @ref MemoryAllocator::allocate(). The
+range is given back to the allocator on destruction. See @ref MemoryAllocator
+for usage information.
+*/
+class MAGNUM_VK_EXPORT MemoryAllocation {
+    public:
+        /**
+         * @brief Construct without allocating
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit MemoryAllocation(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        MemoryAllocation(const MemoryAllocation&) = delete;
+
+        /** @brief Move constructor */
+        MemoryAllocation(MemoryAllocation&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Gives the memory range back to the originating
+         * @ref MemoryAllocator. If it was a dedicated allocation or the
+         * containing block became empty and there's another empty block
+         * already, the underlying @ref Memory is freed as well.
+         */
+        ~MemoryAllocation();
+
+        /** @brief Copying is not allowed */
+        MemoryAllocation& operator=(const MemoryAllocation&) = delete;
+
+        /** @brief Move assignment */
+        MemoryAllocation& operator=(MemoryAllocation&& other) noexcept;
+
+        /**
+         * @brief Whether the instance holds an allocation
+         *
+         * Returns @cpp false @ce for a @ref MemoryAllocation(NoCreateT)
+         * instance or a moved-out instance.
+         */
+        explicit operator bool() const { return _block; }
+
+        /**
+         * @brief Memory the allocation is in
+         *
+         * Shared with other allocations unless @ref isDedicated() is
+         * @cpp true @ce. Expects that the instance holds an allocation.
+         */
+        Memory& memory();
+
+        /** @brief Byte offset of the allocation in @ref memory() */
+        UnsignedLong offset() const { return _offset; }
+
+        /**
+         * @brief Allocation size
+         *
+         * Equal to the size the allocation was requested with. The range
+         * reserved in @ref memory() may be larger due to alignment.
+         */
+        UnsignedLong size() const { return _size; }
+
+        /**
+         * @brief Memory type index
+         *
+         * Index of the memory type the allocation is in, with properties
+         * available through @ref DeviceProperties::memoryFlags().
+         */
+        UnsignedInt memoryIndex() const;
+
+        /** @brief Whether the allocation has a dedicated @ref Memory */
+        bool isDedicated() const;
+
+        /**
+         * @brief Mapped allocation data
+         *
+         * Memory of types with @ref MemoryFlag::HostVisible is persistently
+         * mapped by the allocator, this returns a view on the allocation
+         * range in it. Expects that the allocation is in a host-visible
+         * memory. If the memory isn't @ref MemoryFlag::HostCoherent, you're
+         * responsible for flushing and invalidating the range.
+         */
+        Containers::ArrayView<char> mappedData();
+
+    private:
+        friend MemoryAllocator;
+
+        explicit MemoryAllocation(Implementation::MemoryAllocatorState& state, Implementation::MemoryAllocatorBlock& block, UnsignedLong offset, UnsignedLong size) noexcept;
+
+        Implementation::MemoryAllocatorState* _state;
+        Implementation::MemoryAllocatorBlock* _block;
+        UnsignedLong _offset, _size;
+};
+
+/**
+@brief Sub-allocating device memory allocator
+@m_since_latest
+
+Allocating a dedicated @ref Memory for every @ref Buffer and @ref Image is
+slow and implementations have a limit on the total count of allocations that
+can be as low as 4096. This allocator instead allocates large blocks of
+@ref Memory for each memory type and sub-allocates from them using a binary
+buddy allocator, which keeps fragmentation bounded and both allocation and
+deallocation cheap.
+
+@section Vk-MemoryAllocator-usage Usage
+
+Create the allocator for a @ref Device and then pass it to the @ref Buffer
+and @ref Image constructors instead of the @ref NoAllocate tag. The resulting
+@ref MemoryAllocation is then owned by the buffer or image and available
+through @ref Buffer::allocation() or @ref Image::allocation().
+
+@snippet Vk.cpp MemoryAllocator-usage
+
+Alternatively, call @ref allocate() directly with
+@ref Buffer::memoryRequirements() / @ref Image::memoryRequirements() and bind
+the memory yourself. The returned @ref MemoryAllocation has to be kept alive
+for as long as the memory is used.
+
+@snippet Vk.cpp MemoryAllocator-allocate
+
+@section Vk-MemoryAllocator-mapping Persistent mapping
+
+Blocks of memory types that have @ref MemoryFlag::HostVisible are mapped once
+when allocated and stay mapped until freed. The mapped range corresponding to
+given allocation is available through @ref MemoryAllocation::mappedData(),
+without having to go through @ref Memory::map() for every access.
+
+@section Vk-MemoryAllocator-statistics Statistics
+
+The @ref blockCount(), @ref dedicatedAllocationCount(), @ref allocatedSize(),
+@ref usedSize() and @ref fragmentation() queries give an overview of the
+allocator state, useful for example for on-screen statistics or for tuning
+the @ref blockSize().
+
+@section Vk-MemoryAllocator-lifetime Lifetime and thread safety
+
+All allocations have to be destroyed before the allocator is. The allocator
+isn't thread-safe --- if resources are created from multiple threads, either
+guard the allocator with a mutex or use a separate allocator per thread.
+
+For short-lived per-frame data, where individual deallocations aren't
+needed, a @ref MemoryArena is a cheaper alternative.
+*/
+class MAGNUM_VK_EXPORT MemoryAllocator {
+    public:
+        /**
+         * @brief Constructor
+         * @param device            Vulkan device to allocate the memory on
+         * @param blockSize         Size of a single memory block
+         * @param minAllocationSize Minimal size of a sub-allocation
+         *
+         * Both @p blockSize and @p minAllocationSize are expected to be
+         * powers of two, with @p minAllocationSize not larger than
+         * @p blockSize and @p blockSize not more than @cpp 1 << 23 @ce times
+         * larger than @p minAllocationSize. No memory is allocated until the
+         * first call to @ref allocate().
+         */
+        explicit MemoryAllocator(Device& device, UnsignedLong blockSize = 32*1024*1024, UnsignedLong minAllocationSize = 256);
+
+        /**
+         * @brief Construct without creating the allocator
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit MemoryAllocator(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        MemoryAllocator(const MemoryAllocator&) = delete;
+
+        /**
+         * @brief Move constructor
+         *
+         * Existing @ref MemoryAllocation instances stay valid and will be
+         * given back to the new instance.
+         */
+        MemoryAllocator(MemoryAllocator&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Expects that all allocations were already destroyed.
+         */
+        ~MemoryAllocator();
+
+        /** @brief Copying is not allowed */
+        MemoryAllocator& operator=(const MemoryAllocator&) = delete;
+
+        /** @brief Move assignment */
+        MemoryAllocator& operator=(MemoryAllocator&& other) noexcept;
+
+        /** @brief Size of a single memory block */
+        UnsignedLong blockSize() const;
+
+        /** @brief Minimal size of a sub-allocation */
+        UnsignedLong minAllocationSize() const;
+
+        /**
+         * @brief Allocate memory
+         * @param requirements      Memory requirements
+         * @param requiredFlags     Memory flags the memory type is required
+         *      to have
+         * @param preferredFlags    Memory flags the memory type is preferred
+         *      to have
+         * @param flags             Allocation flags
+         *
+         * Picks a memory type using @ref DeviceProperties::pickMemory() and
+         * then either sub-allocates from an existing block of that type,
+         * allocates a new block or, if @p flags contain
+         * @ref MemoryAllocationFlag::Dedicated or the size is larger than
+         * half of @ref blockSize(), allocates a dedicated @ref Memory.
+         */
+        MemoryAllocation allocate(const MemoryRequirements& requirements, MemoryFlags requiredFlags, MemoryFlags preferredFlags = {}, MemoryAllocationFlags flags = {});
+
+        /**
+         * @brief Count of memory blocks
+         *
+         * Doesn't include dedicated allocations.
+         * @see @ref dedicatedAllocationCount()
+         */
+        std::size_t blockCount() const;
+
+        /** @brief Count of dedicated allocations */
+        std::size_t dedicatedAllocationCount() const;
+
+        /**
+         * @brief Count of live allocations
+         *
+         * Including dedicated allocations.
+         */
+        std::size_t allocationCount() const;
+
+        /**
+         * @brief Total size of allocated device memory
+         *
+         * Sum of sizes of all blocks and dedicated allocations.
+         */
+        UnsignedLong allocatedSize() const;
+
+        /**
+         * @brief Total size of used device memory
+         *
+         * Sum of ranges reserved by live allocations, including padding due
+         * to alignment and size rounding.
+         */
+        UnsignedLong usedSize() const;
+
+        /**
+         * @brief Fragmentation of the free space
+         *
+         * Calculated as @f$ 1 - \frac{s_\text{largest}}{s_\text{free}} @f$,
+         * where @f$ s_\text{largest} @f$ is the largest contiguous free range
+         * across all blocks and @f$ s_\text{free} @f$ is the total free size
+         * in all blocks. Returns @cpp 0.0f @ce if there are no blocks.
+         */
+        Float fragmentation() const;
+
+    private:
+        Containers::Pointer<Implementation::MemoryAllocatorState> _state;
+};
+
+/**
+@brief Linear memory arena
+@m_since_latest
+
+A single @ref Memory from which allocations are done by simply bumping an
+offset. Individual allocations can't be freed, instead the whole arena is
+reset at once with @ref reset(). Useful for per-frame data such as uniform or
+staging buffers where everything allocated in a frame is discarded once the
+frame finishes on the GPU. Memory with @ref MemoryFlag::HostVisible is
+persistently mapped, available through @ref mappedData().
+
+@snippet Vk.cpp MemoryArena-usage
+
+Similarly to @ref MemoryAllocator, the class isn't thread-safe.
+*/
+class MAGNUM_VK_EXPORT MemoryArena {
+    public:
+        /**
+         * @brief Constructor
+         * @param device            Vulkan device to allocate the memory on
+         * @param size              Arena size
+         * @param requiredFlags     Memory flags the memory type is required
+         *      to have
+         * @param preferredFlags    Memory flags the memory type is preferred
+         *      to have
+         * @param memories          Bits indicating which memory types are
+         *      allowed
+         *
+         * The memory type is picked with @ref DeviceProperties::pickMemory().
+         * Pass @ref MemoryRequirements::memories() of the resources you'll
+         * put into the arena to @p memories, otherwise @ref allocate() may
+         * fail on an incompatible memory type.
+         */
+        explicit MemoryArena(Device& device, UnsignedLong size, MemoryFlags requiredFlags, MemoryFlags preferredFlags = {}, UnsignedInt memories = ~UnsignedInt{});
+
+        /**
+         * @brief Construct without allocating the arena
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit MemoryArena(NoCreateT);
+
+        /** @brief Copying is not allowed */
+        MemoryArena(const MemoryArena&) = delete;
+
+        /** @brief Move constructor */
+        MemoryArena(MemoryArena&& other) noexcept;
+
+        /** @brief Copying is not allowed */
+        MemoryArena& operator=(const MemoryArena&) = delete;
+
+        /** @brief Move assignment */
+        MemoryArena& operator=(MemoryArena&& other) noexcept;
+
+        /** @brief Underlying memory */
+        Memory& memory() { return _memory; }
+
+        /** @brief Memory type index */
+        UnsignedInt memoryIndex() const { return _memoryIndex; }
+
+        /** @brief Arena size */
+        UnsignedLong size() const { return _memory.size(); }
+
+        /** @brief Size used by allocations since the last @ref reset() */
+        UnsignedLong usedSize() const { return _offset; }
+
+        /**
+         * @brief Allocate from the arena
+         *
+         * Returns an offset in @ref memory() satisfying alignment of
+         * @p requirements or @ref Containers::NullOpt if there's not enough
+         * space left. Expects that @p requirements allow the arena memory
+         * type.
+         */
+        Containers::Optional<UnsignedLong> allocate(const MemoryRequirements& requirements);
+
+        /**
+         * @brief Mapped arena data
+         *
+         * Expects that the arena is in a memory with
+         * @ref MemoryFlag::HostVisible.
+         */
+        Containers::ArrayView<char> mappedData();
+
+        /**
+         * @brief Reset the arena
+         *
+         * Makes the whole arena available again. It's the user responsibility
+         * to ensure the GPU no longer accesses the previous contents.
+         */
+        void reset() { _offset = 0; }
+
+    private:
+        Memory _memory;
+        Containers::Array<char, MemoryMapDeleter> _mapped;
+        UnsignedInt _memoryIndex;
+        UnsignedLong _offset;
+};
+
+}}
+
+#endif
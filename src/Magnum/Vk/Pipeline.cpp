@@ -300,7 +300,9 @@ Pipeline Pipeline::wrap(Device& device, const PipelineBindPoint bindPoint, const
     return wrap(device, bindPoint, handle, DynamicRasterizationStates{}, flags);
 }
 
-Pipeline::Pipeline(Device& device, const RasterizationPipelineCreateInfo& info):
+Pipeline::Pipeline(Device& device, const RasterizationPipelineCreateInfo& info): Pipeline{device, info, VkPipelineCache{}} {}
+
+Pipeline::Pipeline(Device& device, const RasterizationPipelineCreateInfo& info, const VkPipelineCache cache):
     _device{&device},
     #ifdef CORRADE_GRACEFUL_ASSERT
     /* Otherwise vkDestroyPipeline() crashes when we hit the assert */
@@ -315,11 +317,13 @@ Pipeline::Pipeline(Device& device, const RasterizationPipelineCreateInfo& info):
     CORRADE_ASSERT(info->pViewportState || info->pRasterizationState->rasterizerDiscardEnable || info->pDynamicState,
         "Vk::Pipeline: if rasterization discard is not enabled, the viewport has to be either dynamic or set via setViewport()", );
 
-    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateGraphicsPipelines(device, {}, 1, info, nullptr, &_handle));
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateGraphicsPipelines(device, cache, 1, info, nullptr, &_handle));
 }
 
-Pipeline::Pipeline(Device& device, const ComputePipelineCreateInfo& info): _device{&device}, _bindPoint{PipelineBindPoint::Compute}, _flags{HandleFlag::DestroyOnDestruction}, _dynamicStates{} {
-    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateComputePipelines(device, {}, 1, info, nullptr, &_handle));
+Pipeline::Pipeline(Device& device, const ComputePipelineCreateInfo& info): Pipeline{device, info, VkPipelineCache{}} {}
+
+Pipeline::Pipeline(Device& device, const ComputePipelineCreateInfo& info, const VkPipelineCache cache): _device{&device}, _bindPoint{PipelineBindPoint::Compute}, _flags{HandleFlag::DestroyOnDestruction}, _dynamicStates{} {
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateComputePipelines(device, cache, 1, info, nullptr, &_handle));
 }
 
 Pipeline::Pipeline(NoCreateT): _device{}, _handle{}, _bindPoint{}, _dynamicStates{} {}
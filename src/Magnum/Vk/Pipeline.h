@@ -146,6 +146,20 @@ class MAGNUM_VK_EXPORT Pipeline {
          */
         explicit Pipeline(Device& device, const RasterizationPipelineCreateInfo& info);
 
+        /**
+         * @brief Construct a rasterization pipeline using a pipeline cache
+         * @param device    Vulkan device to create the pipeline on
+         * @param info      Rasterization pipeline creation info
+         * @param cache     Pipeline cache
+         *
+         * Compared to @ref Pipeline(Device&, const RasterizationPipelineCreateInfo&)
+         * passes @p cache to the driver, allowing it to reuse results of
+         * previous compilations. The @p cache can be shared by pipeline
+         * creation on multiple threads. See @ref PipelineCache for more
+         * information.
+         */
+        explicit Pipeline(Device& device, const RasterizationPipelineCreateInfo& info, VkPipelineCache cache);
+
         /**
          * @brief Construct a compute pipeline
          * @param device    Vulkan device to create the pipeline on
@@ -156,6 +170,20 @@ class MAGNUM_VK_EXPORT Pipeline {
          */
         explicit Pipeline(Device& device, const ComputePipelineCreateInfo& info);
 
+        /**
+         * @brief Construct a compute pipeline using a pipeline cache
+         * @param device    Vulkan device to create the pipeline on
+         * @param info      Compute pipeline creation info
+         * @param cache     Pipeline cache
+         *
+         * Compared to @ref Pipeline(Device&, const ComputePipelineCreateInfo&)
+         * passes @p cache to the driver, allowing it to reuse results of
+         * previous compilations. The @p cache can be shared by pipeline
+         * creation on multiple threads. See @ref PipelineCache for more
+         * information.
+         */
+        explicit Pipeline(Device& device, const ComputePipelineCreateInfo& info, VkPipelineCache cache);
+
         /**
          * @brief Construct without creating the pipeline layout
          *
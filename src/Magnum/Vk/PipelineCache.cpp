@@ -0,0 +1,144 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PipelineCache.h"
+#include "PipelineCacheCreateInfo.h"
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Vk/Assert.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Result.h"
+
+namespace Magnum { namespace Vk {
+
+PipelineCacheCreateInfo::PipelineCacheCreateInfo(const Containers::ArrayView<const void> initialData, const Flags flags): _info{} {
+    _info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    _info.flags = VkPipelineCacheCreateFlags(flags);
+    _info.initialDataSize = initialData.size();
+    _info.pInitialData = initialData.data();
+}
+
+PipelineCacheCreateInfo::PipelineCacheCreateInfo(NoInitT) noexcept {}
+
+PipelineCacheCreateInfo::PipelineCacheCreateInfo(const VkPipelineCacheCreateInfo& info):
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(info) {}
+
+PipelineCache PipelineCache::wrap(Device& device, const VkPipelineCache handle, const HandleFlags flags) {
+    PipelineCache out{NoCreate};
+    out._device = &device;
+    out._handle = handle;
+    out._flags = flags;
+    return out;
+}
+
+bool PipelineCache::isDataCompatible(DeviceProperties& properties, const Containers::ArrayView<const void> data) {
+    /* The data can come from an arbitrary file so they're not guaranteed to
+       be aligned, copy the header out instead of casting */
+    VkPipelineCacheHeaderVersionOne header;
+    if(data.size() < sizeof(header)) return false;
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    const VkPhysicalDeviceProperties& deviceProperties = properties.properties().properties;
+    return header.headerSize >= sizeof(header) &&
+        header.headerSize <= data.size() &&
+        header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+        header.vendorID == deviceProperties.vendorID &&
+        header.deviceID == deviceProperties.deviceID &&
+        std::memcmp(header.pipelineCacheUUID, deviceProperties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+PipelineCache::PipelineCache(Device& device, const PipelineCacheCreateInfo& info): _device{&device}, _flags{HandleFlag::DestroyOnDestruction} {
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreatePipelineCache(device, info, nullptr, &_handle));
+}
+
+PipelineCache::PipelineCache(Device& device): PipelineCache{device, PipelineCacheCreateInfo{}} {}
+
+PipelineCache::PipelineCache(NoCreateT): _device{}, _handle{} {}
+
+PipelineCache::PipelineCache(PipelineCache&& other) noexcept: _device{other._device}, _handle{other._handle}, _flags{other._flags} {
+    other._handle = {};
+}
+
+PipelineCache::~PipelineCache() {
+    if(_handle && (_flags & HandleFlag::DestroyOnDestruction))
+        (**_device).DestroyPipelineCache(*_device, _handle, nullptr);
+}
+
+PipelineCache& PipelineCache::operator=(PipelineCache&& other) noexcept {
+    using Utility::swap;
+    swap(other._device, _device);
+    swap(other._handle, _handle);
+    swap(other._flags, _flags);
+    return *this;
+}
+
+Containers::Array<char> PipelineCache::data() {
+    /* Other threads may be adding to the cache between the size query and
+       the retrieval, in which case the call returns VK_INCOMPLETE with a
+       truncated but valid result. Query again until it fits. */
+    Containers::Array<char> out;
+    for(;;) {
+        std::size_t size;
+        MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).GetPipelineCacheData(*_device, _handle, &size, nullptr));
+        out = Containers::Array<char>{NoInit, size};
+        if(MAGNUM_VK_INTERNAL_ASSERT_SUCCESS_OR((**_device).GetPipelineCacheData(*_device, _handle, &size, out.data()), Result::Incomplete) == Result::Success) {
+            /* The size can only get smaller here */
+            if(size != out.size()) {
+                Containers::Array<char> shrunk{NoInit, size};
+                Utility::copy(out.prefix(size), shrunk);
+                out = Utility::move(shrunk);
+            }
+            return out;
+        }
+    }
+}
+
+void PipelineCache::merge(const Containers::ArrayView<const VkPipelineCache> caches) {
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != caches.size(); ++i)
+        CORRADE_ASSERT(caches[i] != _handle,
+            "Vk::PipelineCache::merge(): can't merge a cache into itself, found at index" << i, );
+    #endif
+
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).MergePipelineCaches(*_device, _handle, caches.size(), caches.data()));
+}
+
+void PipelineCache::merge(const std::initializer_list<VkPipelineCache> caches) {
+    merge(Containers::arrayView(caches));
+}
+
+VkPipelineCache PipelineCache::release() {
+    const VkPipelineCache handle = _handle;
+    _handle = {};
+    return handle;
+}
+
+}}
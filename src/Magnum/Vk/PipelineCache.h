@@ -0,0 +1,205 @@
+#ifndef Magnum_Vk_PipelineCache_h
+#define Magnum_Vk_PipelineCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::PipelineCache
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Pipeline cache
+@m_since_latest
+
+Wraps a @type_vk_keyword{PipelineCache}, which allows the driver to reuse
+results of pipeline compilation across @ref Pipeline creations and, after
+serializing its contents, across application runs.
+
+@section Vk-PipelineCache-creation Pipeline cache creation
+
+An empty cache can be constructed directly using
+@ref PipelineCache(Device&, const PipelineCacheCreateInfo&), leaving the
+@p info parameter at its default. To make use of data from a previous run,
+load them, check that they were produced by the same driver and device with
+@ref isDataCompatible() and pass them to @ref PipelineCacheCreateInfo:
+
+@snippet Vk.cpp PipelineCache-creation
+
+@section Vk-PipelineCache-usage Usage
+
+Pass the cache to the @ref Pipeline constructor. Once the pipelines are
+created, retrieve the cache contents using @ref data() and save them for the
+next run:
+
+@snippet Vk.cpp PipelineCache-usage
+
+@section Vk-PipelineCache-threading Thread safety
+
+A pipeline cache is internally synchronized by the driver, which means a
+single instance can be shared by pipeline creation happening in parallel on
+multiple threads. Alternatively, each thread can use its own cache to avoid
+any contention in the driver, and the per-thread caches are then combined
+into one with @ref merge(). The cache merged into has to be externally
+synchronized, i.e. not used by any other thread during the merge.
+*/
+class MAGNUM_VK_EXPORT PipelineCache {
+    public:
+        /**
+         * @brief Wrap existing Vulkan handle
+         * @param device            Vulkan device the pipeline cache is
+         *      created on
+         * @param handle            The @type_vk{PipelineCache} handle
+         * @param flags             Handle flags
+         *
+         * The @p handle is expected to be originating from @p device. Unlike
+         * a pipeline cache created using a constructor, the Vulkan pipeline
+         * cache is by default not deleted on destruction, use @p flags for
+         * different behavior.
+         * @see @ref release()
+         */
+        static PipelineCache wrap(Device& device, VkPipelineCache handle, HandleFlags flags = {});
+
+        /**
+         * @brief Check whether pipeline cache data are compatible with a device
+         *
+         * Validates the @type_vk_keyword{PipelineCacheHeaderVersionOne}
+         * header of @p data against vendor and device ID and the pipeline
+         * cache UUID in @ref DeviceProperties::properties(). Returns
+         * @cpp false @ce if @p data are too short, have an unknown header
+         * version or were produced by a different device or driver version,
+         * in which case they should be discarded.
+         */
+        static bool isDataCompatible(DeviceProperties& properties, Containers::ArrayView<const void> data);
+
+        /**
+         * @brief Constructor
+         * @param device    Vulkan device to create the pipeline cache on
+         * @param info      Pipeline cache creation info
+         *
+         * @see @fn_vk_keyword{CreatePipelineCache}
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        explicit PipelineCache(Device& device, const PipelineCacheCreateInfo& info = PipelineCacheCreateInfo{});
+        #else
+        explicit PipelineCache(Device& device, const PipelineCacheCreateInfo& info);
+        explicit PipelineCache(Device& device);
+        #endif
+
+        /**
+         * @brief Construct without creating the pipeline cache
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit PipelineCache(NoCreateT);
+
+        /** @brief Copying is not allowed */
+        PipelineCache(const PipelineCache&) = delete;
+
+        /** @brief Move constructor */
+        PipelineCache(PipelineCache&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys associated @type_vk{PipelineCache} handle, unless the
+         * instance was created using @ref wrap() without
+         * @ref HandleFlag::DestroyOnDestruction specified.
+         * @see @fn_vk_keyword{DestroyPipelineCache}, @ref release()
+         */
+        ~PipelineCache();
+
+        /** @brief Copying is not allowed */
+        PipelineCache& operator=(const PipelineCache&) = delete;
+
+        /** @brief Move assignment */
+        PipelineCache& operator=(PipelineCache&& other) noexcept;
+
+        /** @brief Underlying @type_vk{PipelineCache} handle */
+        VkPipelineCache handle() { return _handle; }
+        /** @overload */
+        operator VkPipelineCache() { return _handle; }
+
+        /** @brief Handle flags */
+        HandleFlags handleFlags() const { return _flags; }
+
+        /**
+         * @brief Pipeline cache data
+         *
+         * The data can be saved to a file and then passed to
+         * @ref PipelineCacheCreateInfo in a subsequent run. Can be called
+         * while other threads create pipelines using the same cache.
+         * @see @fn_vk_keyword{GetPipelineCacheData}
+         */
+        Containers::Array<char> data();
+
+        /**
+         * @brief Merge other pipeline caches into this one
+         *
+         * The @p caches are expected to not contain this cache. This cache
+         * has to be externally synchronized during the operation, the
+         * @p caches can be used concurrently.
+         * @see @fn_vk_keyword{MergePipelineCaches}
+         */
+        void merge(Containers::ArrayView<const VkPipelineCache> caches);
+
+        /** @overload */
+        void merge(std::initializer_list<VkPipelineCache> caches);
+
+        /**
+         * @brief Release the underlying Vulkan pipeline cache
+         *
+         * Releases ownership of the Vulkan pipeline cache and returns its
+         * handle so @fn_vk{DestroyPipelineCache} is not called on
+         * destruction. The internal state is then equivalent to moved-from
+         * state.
+         * @see @ref wrap()
+         */
+        VkPipelineCache release();
+
+    private:
+        /* Can't be a reference because of the NoCreate constructor */
+        Device* _device;
+
+        VkPipelineCache _handle;
+        HandleFlags _flags;
+};
+
+}}
+
+#endif
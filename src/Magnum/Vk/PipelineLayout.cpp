@@ -35,19 +35,31 @@
 
 namespace Magnum { namespace Vk {
 
-PipelineLayoutCreateInfo::PipelineLayoutCreateInfo(const Containers::ArrayView<const VkDescriptorSetLayout> descriptorSetLayouts): _info{} {
-    /* Make a copy of the descriptor set layout list */
+PipelineLayoutCreateInfo::PipelineLayoutCreateInfo(const Containers::ArrayView<const VkDescriptorSetLayout> descriptorSetLayouts, const Containers::ArrayView<const VkPushConstantRange> pushConstantRanges): _info{} {
+    /* Make a copy of the descriptor set layout and push constant range
+       lists */
     Containers::ArrayView<VkDescriptorSetLayout> descriptorSetLayoutsCopy;
+    Containers::ArrayView<VkPushConstantRange> pushConstantRangesCopy;
     _data = Containers::ArrayTuple{
-        {NoInit, descriptorSetLayouts.size(), descriptorSetLayoutsCopy}
+        {NoInit, descriptorSetLayouts.size(), descriptorSetLayoutsCopy},
+        {NoInit, pushConstantRanges.size(), pushConstantRangesCopy}
     };
     Utility::copy(descriptorSetLayouts, descriptorSetLayoutsCopy);
+    Utility::copy(pushConstantRanges, pushConstantRangesCopy);
 
     _info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     _info.setLayoutCount = descriptorSetLayoutsCopy.size();
     _info.pSetLayouts = descriptorSetLayoutsCopy;
+    if(!pushConstantRangesCopy.isEmpty()) {
+        _info.pushConstantRangeCount = pushConstantRangesCopy.size();
+        _info.pPushConstantRanges = pushConstantRangesCopy;
+    }
 }
 
+PipelineLayoutCreateInfo::PipelineLayoutCreateInfo(const std::initializer_list<VkDescriptorSetLayout> descriptorSetLayouts, const std::initializer_list<VkPushConstantRange> pushConstantRanges): PipelineLayoutCreateInfo{Containers::arrayView(descriptorSetLayouts), Containers::arrayView(pushConstantRanges)} {}
+
+PipelineLayoutCreateInfo::PipelineLayoutCreateInfo(const Containers::ArrayView<const VkDescriptorSetLayout> descriptorSetLayouts): PipelineLayoutCreateInfo{descriptorSetLayouts, nullptr} {}
+
 PipelineLayoutCreateInfo::PipelineLayoutCreateInfo(): PipelineLayoutCreateInfo{Containers::ArrayView<const VkDescriptorSetLayout>{}} {}
 
 PipelineLayoutCreateInfo::PipelineLayoutCreateInfo(const std::initializer_list<VkDescriptorSetLayout> descriptorSetLayouts): PipelineLayoutCreateInfo{Containers::arrayView(descriptorSetLayouts)} {}
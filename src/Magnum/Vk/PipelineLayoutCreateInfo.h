@@ -72,6 +72,23 @@ class MAGNUM_VK_EXPORT PipelineLayoutCreateInfo {
         /** @overload */
         explicit PipelineLayoutCreateInfo(std::initializer_list<VkDescriptorSetLayout> descriptorSetLayouts);
 
+        /**
+         * @brief Construct with push constant ranges
+         * @param descriptorSetLayouts  Descriptor set layouts used in this
+         *      pipeline layout
+         * @param pushConstantRanges    Push constant ranges. Each shader
+         *      stage is allowed to be present in at most one range.
+         * @m_since_latest
+         *
+         * Compared to @ref PipelineLayoutCreateInfo(Containers::ArrayView<const VkDescriptorSetLayout>)
+         * additionally sets `pushConstantRangeCount` and `pPushConstantRanges`
+         * to a copy of @p pushConstantRanges.
+         * @see @ref ShaderReflection::pushConstantRanges()
+         */
+        explicit PipelineLayoutCreateInfo(Containers::ArrayView<const VkDescriptorSetLayout> descriptorSetLayouts, Containers::ArrayView<const VkPushConstantRange> pushConstantRanges);
+        /** @overload */
+        explicit PipelineLayoutCreateInfo(std::initializer_list<VkDescriptorSetLayout> descriptorSetLayouts, std::initializer_list<VkPushConstantRange> pushConstantRanges);
+
         /**
          * @brief Construct without initializing the contents
          *
@@ -0,0 +1,251 @@
+#ifndef Magnum_Vk_QueryPool_h
+#define Magnum_Vk_QueryPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::QueryPool, enum @ref Magnum::Vk::QueryResultFlag, @ref Magnum::Vk::QueryControlFlag, enum set @ref Magnum::Vk::QueryResultFlags, @ref Magnum::Vk::QueryControlFlags
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Query result flag
+@m_since_latest
+
+Wraps a @type_vk_keyword{QueryResultFlagBits}. The
+@val_vk{QUERY_RESULT_64,QueryResultFlagBits} flag is always set implicitly, as
+@ref QueryPool::results() always returns 64-bit values.
+@see @ref QueryResultFlags, @ref QueryPool::results()
+@m_enum_values_as_keywords
+*/
+enum class QueryResultFlag: UnsignedInt {
+    /**
+     * Wait for the results of all queries to become available. Without this
+     * flag, @ref QueryPool::results() returns @cpp false @ce if any of the
+     * results isn't available yet.
+     */
+    Wait = VK_QUERY_RESULT_WAIT_BIT,
+
+    /**
+     * Write an additional value after the results of each query, which is
+     * non-zero if the results are available and zero otherwise.
+     */
+    WithAvailability = VK_QUERY_RESULT_WITH_AVAILABILITY_BIT,
+
+    /**
+     * Allow returning partial results for queries that aren't available
+     * yet. Not allowed for @ref QueryType::Timestamp queries.
+     */
+    Partial = VK_QUERY_RESULT_PARTIAL_BIT
+};
+
+/**
+@brief Query result flags
+@m_since_latest
+
+Type-safe wrapper for @type_vk_keyword{QueryResultFlags}.
+@see @ref QueryPool::results()
+*/
+typedef Containers::EnumSet<QueryResultFlag> QueryResultFlags;
+
+CORRADE_ENUMSET_OPERATORS(QueryResultFlags)
+
+/**
+@brief Query control flag
+@m_since_latest
+
+Wraps a @type_vk_keyword{QueryControlFlagBits}.
+@see @ref QueryControlFlags, @ref CommandBuffer::beginQuery()
+@m_enum_values_as_keywords
+*/
+enum class QueryControlFlag: UnsignedInt {
+    /**
+     * Return the exact count of samples passing the per-fragment tests for
+     * a @ref QueryType::Occlusion query instead of just a non-zero value.
+     * @requires_vk_feature @ref DeviceFeature::OcclusionQueryPrecise
+     */
+    Precise = VK_QUERY_CONTROL_PRECISE_BIT
+};
+
+/**
+@brief Query control flags
+@m_since_latest
+
+Type-safe wrapper for @type_vk_keyword{QueryControlFlags}.
+@see @ref CommandBuffer::beginQuery()
+*/
+typedef Containers::EnumSet<QueryControlFlag> QueryControlFlags;
+
+CORRADE_ENUMSET_OPERATORS(QueryControlFlags)
+
+/**
+@brief Query pool
+@m_since_latest
+
+Wraps a @type_vk_keyword{QueryPool}, which is used for retrieving timestamps,
+pipeline statistics and occlusion results from commands executed on a Vulkan
+device.
+
+@section Vk-QueryPool-creation Query pool creation
+
+The @ref QueryPoolCreateInfo takes a query type and count of queries in the
+pool. Pipeline statistics queries take the set of queried statistics instead
+of the type:
+
+@snippet Vk.cpp QueryPool-creation
+
+@section Vk-QueryPool-usage Basic usage
+
+Queries have to be reset with @ref CommandBuffer::resetQueryPool() before
+being used. Timestamps are then written with
+@ref CommandBuffer::writeTimestamp(), other query types are delimited with
+@ref CommandBuffer::beginQuery() and @ref CommandBuffer::endQuery(). Once the
+command buffer executes, the results can be retrieved with @ref results():
+
+@snippet Vk.cpp QueryPool-usage
+
+Without @ref QueryResultFlag::Wait, @ref results() returns @cpp false @ce
+instead of blocking if any of the results isn't available yet, which can be
+used to read the results back without stalling, for example a few frames
+later. See @ref DebugTools::FrameProfilerVk for a profiler built on top.
+*/
+class MAGNUM_VK_EXPORT QueryPool {
+    public:
+        /**
+         * @brief Wrap existing Vulkan handle
+         * @param device            Vulkan device the query pool is created on
+         * @param handle            The @type_vk{QueryPool} handle
+         * @param flags             Handle flags
+         *
+         * The @p handle is expected to be originating from @p device. Unlike
+         * a query pool created using a constructor, the Vulkan query pool is
+         * by default not deleted on destruction, use @p flags for different
+         * behavior.
+         * @see @ref release()
+         */
+        static QueryPool wrap(Device& device, VkQueryPool handle, HandleFlags flags = {});
+
+        /**
+         * @brief Constructor
+         * @param device    Vulkan device to create the query pool on
+         * @param info      Query pool creation info
+         *
+         * @see @fn_vk_keyword{CreateQueryPool}
+         */
+        explicit QueryPool(Device& device, const QueryPoolCreateInfo& info);
+
+        /**
+         * @brief Construct without creating the query pool
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit QueryPool(NoCreateT);
+
+        /** @brief Copying is not allowed */
+        QueryPool(const QueryPool&) = delete;
+
+        /** @brief Move constructor */
+        QueryPool(QueryPool&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys associated @type_vk{QueryPool} handle, unless the instance
+         * was created using @ref wrap() without
+         * @ref HandleFlag::DestroyOnDestruction specified.
+         * @see @fn_vk_keyword{DestroyQueryPool}, @ref release()
+         */
+        ~QueryPool();
+
+        /** @brief Copying is not allowed */
+        QueryPool& operator=(const QueryPool&) = delete;
+
+        /** @brief Move assignment */
+        QueryPool& operator=(QueryPool&& other) noexcept;
+
+        /** @brief Underlying @type_vk{QueryPool} handle */
+        VkQueryPool handle() { return _handle; }
+        /** @overload */
+        operator VkQueryPool() { return _handle; }
+
+        /** @brief Handle flags */
+        HandleFlags handleFlags() const { return _flags; }
+
+        /**
+         * @brief Retrieve query results
+         * @param first     First query to retrieve
+         * @param count     Count of queries to retrieve
+         * @param data      Where to put the results. Expected to have a size
+         *      divisible by @p count, the values for each query are then
+         *      written to consecutive ranges of @cpp data.size()/count @ce
+         *      items.
+         * @param flags     Query result flags
+         *
+         * Returns @cpp true @ce if the results of all queries were available
+         * and got written to @p data, @cpp false @ce otherwise. With
+         * @ref QueryResultFlag::Wait the function blocks until all results are
+         * available and always returns @cpp true @ce. A
+         * @ref QueryType::Timestamp or @ref QueryType::Occlusion query has one
+         * value, a @ref QueryType::PipelineStatistics query has one value for
+         * each statistic it was created with, and
+         * @ref QueryResultFlag::WithAvailability adds one more value.
+         * @see @fn_vk_keyword{GetQueryPoolResults}
+         */
+        bool results(UnsignedInt first, UnsignedInt count, Containers::ArrayView<UnsignedLong> data, QueryResultFlags flags = {});
+
+        /**
+         * @brief Release the underlying Vulkan query pool
+         *
+         * Releases ownership of the Vulkan query pool and returns its handle
+         * so @fn_vk{DestroyQueryPool} is not called on destruction. The
+         * internal state is then equivalent to moved-from state.
+         * @see @ref wrap()
+         */
+        VkQueryPool release();
+
+    private:
+        /* Can't be a reference because of the NoCreate constructor */
+        Device* _device;
+
+        VkQueryPool _handle;
+        HandleFlags _flags;
+};
+
+}}
+
+#endif
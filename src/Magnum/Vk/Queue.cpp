@@ -26,12 +26,15 @@
 #include "Queue.h"
 
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pair.h>
 #include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/Triple.h>
 #include <Corrade/Utility/Algorithms.h>
 
 #include "Magnum/Vk/Assert.h"
 #include "Magnum/Vk/Device.h"
 #include "Magnum/Vk/Fence.h"
+#include "Magnum/Vk/Pipeline.h"
 
 namespace Magnum { namespace Vk {
 
@@ -96,6 +99,12 @@ Fence Queue::submit(const std::initializer_list<Containers::Reference<const Subm
 
 struct SubmitInfo::State {
     Containers::Array<VkCommandBuffer> commandBuffers;
+    Containers::Array<VkSemaphore> waitSemaphores;
+    Containers::Array<VkPipelineStageFlags> waitStages;
+    Containers::Array<UnsignedLong> waitValues;
+    Containers::Array<VkSemaphore> signalSemaphores;
+    Containers::Array<UnsignedLong> signalValues;
+    VkTimelineSemaphoreSubmitInfo timelineInfo{};
 };
 
 SubmitInfo::SubmitInfo(): _info{} {
@@ -151,4 +160,109 @@ SubmitInfo& SubmitInfo::setCommandBuffers(const std::initializer_list<VkCommandB
     return setCommandBuffers(Containers::arrayView(buffers));
 }
 
+SubmitInfo& SubmitInfo::setWaitSemaphores(const Containers::ArrayView<const Containers::Pair<VkSemaphore, PipelineStages>> semaphores) {
+    if(!_state) _state.emplace();
+
+    _state->waitSemaphores = Containers::Array<VkSemaphore>{NoInit, semaphores.size()};
+    _state->waitStages = Containers::Array<VkPipelineStageFlags>{NoInit, semaphores.size()};
+    for(std::size_t i = 0; i != semaphores.size(); ++i) {
+        _state->waitSemaphores[i] = semaphores[i].first();
+        _state->waitStages[i] = VkPipelineStageFlags(semaphores[i].second());
+    }
+    _info.waitSemaphoreCount = _state->waitSemaphores.size();
+    _info.pWaitSemaphores = _state->waitSemaphores;
+    _info.pWaitDstStageMask = _state->waitStages;
+
+    /* Discard timeline values from a potential previous call */
+    if(_state->timelineInfo.waitSemaphoreValueCount) {
+        _state->waitValues = Containers::Array<UnsignedLong>{};
+        _state->timelineInfo.waitSemaphoreValueCount = 0;
+        _state->timelineInfo.pWaitSemaphoreValues = nullptr;
+    }
+    return *this;
+}
+
+SubmitInfo& SubmitInfo::setWaitSemaphores(const std::initializer_list<Containers::Pair<VkSemaphore, PipelineStages>> semaphores) {
+    return setWaitSemaphores(Containers::arrayView(semaphores));
+}
+
+SubmitInfo& SubmitInfo::setWaitSemaphores(const Containers::ArrayView<const Containers::Triple<VkSemaphore, UnsignedLong, PipelineStages>> semaphores) {
+    if(!_state) _state.emplace();
+
+    _state->waitSemaphores = Containers::Array<VkSemaphore>{NoInit, semaphores.size()};
+    _state->waitStages = Containers::Array<VkPipelineStageFlags>{NoInit, semaphores.size()};
+    _state->waitValues = Containers::Array<UnsignedLong>{NoInit, semaphores.size()};
+    for(std::size_t i = 0; i != semaphores.size(); ++i) {
+        _state->waitSemaphores[i] = semaphores[i].first();
+        _state->waitValues[i] = semaphores[i].second();
+        _state->waitStages[i] = VkPipelineStageFlags(semaphores[i].third());
+    }
+    _info.waitSemaphoreCount = _state->waitSemaphores.size();
+    _info.pWaitSemaphores = _state->waitSemaphores;
+    _info.pWaitDstStageMask = _state->waitStages;
+
+    _state->timelineInfo.waitSemaphoreValueCount = _state->waitValues.size();
+    _state->timelineInfo.pWaitSemaphoreValues = _state->waitValues;
+    connectTimelineInfo();
+    return *this;
+}
+
+SubmitInfo& SubmitInfo::setWaitSemaphores(const std::initializer_list<Containers::Triple<VkSemaphore, UnsignedLong, PipelineStages>> semaphores) {
+    return setWaitSemaphores(Containers::arrayView(semaphores));
+}
+
+SubmitInfo& SubmitInfo::setSignalSemaphores(const Containers::ArrayView<const VkSemaphore> semaphores) {
+    if(!_state) _state.emplace();
+
+    _state->signalSemaphores = Containers::Array<VkSemaphore>{NoInit, semaphores.size()};
+    Utility::copy(semaphores, _state->signalSemaphores);
+    _info.signalSemaphoreCount = _state->signalSemaphores.size();
+    _info.pSignalSemaphores = _state->signalSemaphores;
+
+    /* Discard timeline values from a potential previous call */
+    if(_state->timelineInfo.signalSemaphoreValueCount) {
+        _state->signalValues = Containers::Array<UnsignedLong>{};
+        _state->timelineInfo.signalSemaphoreValueCount = 0;
+        _state->timelineInfo.pSignalSemaphoreValues = nullptr;
+    }
+    return *this;
+}
+
+SubmitInfo& SubmitInfo::setSignalSemaphores(const std::initializer_list<VkSemaphore> semaphores) {
+    return setSignalSemaphores(Containers::arrayView(semaphores));
+}
+
+SubmitInfo& SubmitInfo::setSignalSemaphores(const Containers::ArrayView<const Containers::Pair<VkSemaphore, UnsignedLong>> semaphores) {
+    if(!_state) _state.emplace();
+
+    _state->signalSemaphores = Containers::Array<VkSemaphore>{NoInit, semaphores.size()};
+    _state->signalValues = Containers::Array<UnsignedLong>{NoInit, semaphores.size()};
+    for(std::size_t i = 0; i != semaphores.size(); ++i) {
+        _state->signalSemaphores[i] = semaphores[i].first();
+        _state->signalValues[i] = semaphores[i].second();
+    }
+    _info.signalSemaphoreCount = _state->signalSemaphores.size();
+    _info.pSignalSemaphores = _state->signalSemaphores;
+
+    _state->timelineInfo.signalSemaphoreValueCount = _state->signalValues.size();
+    _state->timelineInfo.pSignalSemaphoreValues = _state->signalValues;
+    connectTimelineInfo();
+    return *this;
+}
+
+SubmitInfo& SubmitInfo::setSignalSemaphores(const std::initializer_list<Containers::Pair<VkSemaphore, UnsignedLong>> semaphores) {
+    return setSignalSemaphores(Containers::arrayView(semaphores));
+}
+
+void SubmitInfo::connectTimelineInfo() {
+    /* The structure is in the heap-allocated state so it doesn't need any
+       pointer patching on move. If it's already connected, nothing to do. */
+    VkTimelineSemaphoreSubmitInfo& info = _state->timelineInfo;
+    if(info.sType) return;
+
+    info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    info.pNext = _info.pNext;
+    _info.pNext = &info;
+}
+
 }}
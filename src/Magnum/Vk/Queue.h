@@ -149,7 +149,8 @@ class MAGNUM_VK_EXPORT Queue {
 @brief Queue submit info
 @m_since_latest
 
-Wraps a @type_vk_keyword{SubmitInfo}.
+Wraps a @type_vk_keyword{SubmitInfo}. See @ref Vk-Semaphore-usage for
+information about synchronizing submissions using semaphores.
 */
 class MAGNUM_VK_EXPORT SubmitInfo {
     public:
@@ -161,7 +162,8 @@ class MAGNUM_VK_EXPORT SubmitInfo {
          *
          * -    *(none)*
          *
-         * @see @ref setCommandBuffers()
+         * @see @ref setCommandBuffers(), @ref setWaitSemaphores(),
+         *      @ref setSignalSemaphores()
          */
         explicit SubmitInfo();
 
@@ -208,6 +210,68 @@ class MAGNUM_VK_EXPORT SubmitInfo {
         /** @overload */
         SubmitInfo& setCommandBuffers(std::initializer_list<VkCommandBuffer> buffers);
 
+        /**
+         * @brief Set semaphores to wait on before executing the batch
+         * @return Reference to self (for method chaining)
+         *
+         * Each item is a semaphore and pipeline stages at which the wait
+         * happens. Fills `waitSemaphoreCount`, `pWaitSemaphores` and
+         * `pWaitDstStageMask`. Use
+         * @ref setWaitSemaphores(Containers::ArrayView<const Containers::Triple<VkSemaphore, UnsignedLong, PipelineStages>>)
+         * to wait on timeline semaphores. Calling this function discards wait
+         * values set by a previous call to the timeline variant.
+         */
+        SubmitInfo& setWaitSemaphores(Containers::ArrayView<const Containers::Pair<VkSemaphore, PipelineStages>> semaphores);
+        /** @overload */
+        SubmitInfo& setWaitSemaphores(std::initializer_list<Containers::Pair<VkSemaphore, PipelineStages>> semaphores);
+
+        /**
+         * @brief Set timeline semaphores to wait on before executing the batch
+         * @return Reference to self (for method chaining)
+         *
+         * Each item is a semaphore, a counter value to wait for and pipeline
+         * stages at which the wait happens. In addition to what's done in
+         * @ref setWaitSemaphores(Containers::ArrayView<const Containers::Pair<VkSemaphore, PipelineStages>>),
+         * a @type_vk_keyword{TimelineSemaphoreSubmitInfo} structure is
+         * connected to the `pNext` chain and its `waitSemaphoreValueCount`
+         * and `pWaitSemaphoreValues` fields are filled. Values for binary
+         * semaphores in the list are ignored.
+         * @requires_vk12 Extension @vk_extension{KHR,timeline_semaphore}
+         */
+        SubmitInfo& setWaitSemaphores(Containers::ArrayView<const Containers::Triple<VkSemaphore, UnsignedLong, PipelineStages>> semaphores);
+        /** @overload */
+        SubmitInfo& setWaitSemaphores(std::initializer_list<Containers::Triple<VkSemaphore, UnsignedLong, PipelineStages>> semaphores);
+
+        /**
+         * @brief Set semaphores to signal after the batch finishes executing
+         * @return Reference to self (for method chaining)
+         *
+         * Fills `signalSemaphoreCount` and `pSignalSemaphores`. Use
+         * @ref setSignalSemaphores(Containers::ArrayView<const Containers::Pair<VkSemaphore, UnsignedLong>>)
+         * to signal timeline semaphores. Calling this function discards
+         * signal values set by a previous call to the timeline variant.
+         */
+        SubmitInfo& setSignalSemaphores(Containers::ArrayView<const VkSemaphore> semaphores);
+        /** @overload */
+        SubmitInfo& setSignalSemaphores(std::initializer_list<VkSemaphore> semaphores);
+
+        /**
+         * @brief Set timeline semaphores to signal after the batch finishes executing
+         * @return Reference to self (for method chaining)
+         *
+         * Each item is a semaphore and a counter value to signal it with. In
+         * addition to what's done in
+         * @ref setSignalSemaphores(Containers::ArrayView<const VkSemaphore>),
+         * a @type_vk_keyword{TimelineSemaphoreSubmitInfo} structure is
+         * connected to the `pNext` chain and its `signalSemaphoreValueCount`
+         * and `pSignalSemaphoreValues` fields are filled. Values for binary
+         * semaphores in the list are ignored.
+         * @requires_vk12 Extension @vk_extension{KHR,timeline_semaphore}
+         */
+        SubmitInfo& setSignalSemaphores(Containers::ArrayView<const Containers::Pair<VkSemaphore, UnsignedLong>> semaphores);
+        /** @overload */
+        SubmitInfo& setSignalSemaphores(std::initializer_list<Containers::Pair<VkSemaphore, UnsignedLong>> semaphores);
+
         /** @brief Underlying @type_vk{SubmitInfo} structure */
         VkSubmitInfo& operator*() { return _info; }
         /** @overload */
@@ -229,6 +293,8 @@ class MAGNUM_VK_EXPORT SubmitInfo {
         operator const VkSubmitInfo&() const { return _info; }
 
     private:
+        MAGNUM_VK_LOCAL void connectTimelineInfo();
+
         VkSubmitInfo _info;
 
         struct State;
@@ -0,0 +1,841 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RenderGraph.h"
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Containers/StringStl.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/ImageCreateInfo.h"
+#include "Magnum/Vk/MemoryAllocateInfo.h"
+#include "Magnum/Vk/Pipeline.h"
+
+namespace Magnum { namespace Vk {
+
+namespace Implementation {
+
+namespace {
+
+struct RenderGraphUsageMapping {
+    PipelineStages stages;
+    Accesses readAccess;
+    Accesses writeAccess;
+    /* ImageLayout::Undefined for buffer-only usages */
+    ImageLayout layout;
+    /* Zero if not applicable to given resource type */
+    UnsignedInt imageUsage;
+    UnsignedInt bufferUsage;
+};
+
+RenderGraphUsageMapping renderGraphUsageMapping(const RenderGraphUsage usage) {
+    const PipelineStages shaderStages = PipelineStage::VertexShader|PipelineStage::FragmentShader|PipelineStage::ComputeShader;
+
+    switch(usage) {
+        case RenderGraphUsage::ColorAttachment:
+            return {PipelineStage::ColorAttachmentOutput,
+                Access::ColorAttachmentRead, Access::ColorAttachmentWrite,
+                ImageLayout::ColorAttachment,
+                UnsignedInt(ImageUsage::ColorAttachment), 0};
+        case RenderGraphUsage::DepthStencilAttachment:
+            return {PipelineStage::EarlyFragmentTests|PipelineStage::LateFragmentTests,
+                Access::DepthStencilAttachmentRead, Access::DepthStencilAttachmentWrite,
+                ImageLayout::DepthStencilAttachment,
+                UnsignedInt(ImageUsage::DepthStencilAttachment), 0};
+        case RenderGraphUsage::InputAttachment:
+            return {PipelineStage::FragmentShader,
+                Access::InputAttachmentRead, {},
+                ImageLayout::ShaderReadOnly,
+                UnsignedInt(ImageUsage::InputAttachment), 0};
+        case RenderGraphUsage::Sampled:
+            return {shaderStages,
+                Access::ShaderRead, {},
+                ImageLayout::ShaderReadOnly,
+                UnsignedInt(ImageUsage::Sampled), 0};
+        case RenderGraphUsage::Storage:
+            return {shaderStages,
+                Access::ShaderRead, Access::ShaderWrite,
+                ImageLayout::General,
+                UnsignedInt(ImageUsage::Storage),
+                UnsignedInt(BufferUsage::StorageBuffer)};
+        case RenderGraphUsage::TransferSource:
+            return {PipelineStage::Transfer,
+                Access::TransferRead, {},
+                ImageLayout::TransferSource,
+                UnsignedInt(ImageUsage::TransferSource),
+                UnsignedInt(BufferUsage::TransferSource)};
+        case RenderGraphUsage::TransferDestination:
+            return {PipelineStage::Transfer,
+                {}, Access::TransferWrite,
+                ImageLayout::TransferDestination,
+                UnsignedInt(ImageUsage::TransferDestination),
+                UnsignedInt(BufferUsage::TransferDestination)};
+        case RenderGraphUsage::VertexBuffer:
+            return {PipelineStage::VertexInput,
+                Access::VertexAttributeRead, {},
+                ImageLayout::Undefined,
+                0, UnsignedInt(BufferUsage::VertexBuffer)};
+        case RenderGraphUsage::IndexBuffer:
+            return {PipelineStage::VertexInput,
+                Access::IndexRead, {},
+                ImageLayout::Undefined,
+                0, UnsignedInt(BufferUsage::IndexBuffer)};
+        case RenderGraphUsage::IndirectBuffer:
+            return {PipelineStage::DrawIndirect,
+                Access::IndirectCommandRead, {},
+                ImageLayout::Undefined,
+                0, UnsignedInt(BufferUsage::IndirectBuffer)};
+        case RenderGraphUsage::UniformBuffer:
+            return {shaderStages,
+                Access::UniformRead, {},
+                ImageLayout::Undefined,
+                0, UnsignedInt(BufferUsage::UniformBuffer)};
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* There's no debug output for ImageLayout, and the dump is better readable
+   with short names anyway */
+const char* imageLayoutName(const VkImageLayout layout) {
+    switch(layout) {
+        /* LCOV_EXCL_START */
+        #define _c(value, vkValue) case VK_IMAGE_LAYOUT_ ## vkValue: return #value;
+        _c(Undefined, UNDEFINED)
+        _c(Preinitialized, PREINITIALIZED)
+        _c(General, GENERAL)
+        _c(ColorAttachment, COLOR_ATTACHMENT_OPTIMAL)
+        _c(DepthStencilAttachment, DEPTH_STENCIL_ATTACHMENT_OPTIMAL)
+        _c(ShaderReadOnly, SHADER_READ_ONLY_OPTIMAL)
+        _c(TransferSource, TRANSFER_SRC_OPTIMAL)
+        _c(TransferDestination, TRANSFER_DST_OPTIMAL)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+        default: return nullptr;
+    }
+}
+
+}
+
+struct RenderGraphResource {
+    Containers::String name;
+    bool isImage;
+    bool isImported;
+
+    /* Used for both imported and transient resources, the latter get it
+       filled in compile() */
+    VkImage imageHandle{};
+    VkBuffer bufferHandle{};
+
+    ImageAspects aspects;
+    ImageLayout initialLayout{ImageLayout::Undefined}, finalLayout{ImageLayout::Undefined};
+
+    /* Transient resources only. The usage flags are extended in compile(). */
+    VkImageCreateInfo imageInfo;
+    VkBufferCreateInfo bufferInfo;
+    Image image{NoCreate};
+    Buffer buffer{NoCreate};
+
+    /* Filled in compile(), transient resources only. Indices into the
+       execution order, firstUse is ~UnsignedInt{} if the resource isn't
+       used by any pass that wasn't culled. */
+    UnsignedInt firstUse, lastUse;
+    UnsignedInt heap;
+    UnsignedLong offset, size;
+};
+
+struct RenderGraphResourceUsage {
+    UnsignedInt resource;
+    /* Bitmask of RenderGraphUsage values, used for debug output */
+    UnsignedShort readUsages, writeUsages;
+    PipelineStages stages;
+    Accesses readAccess, writeAccess;
+    ImageLayout layout;
+};
+
+struct RenderGraphPass {
+    Containers::String name;
+    RenderGraph::PassFunction function;
+    void* state;
+    Containers::Array<RenderGraphResourceUsage> usages;
+
+    /* Filled in compile() */
+    bool culled;
+    PipelineStages sourceStages, destinationStages;
+    UnsignedInt imageBarrierOffset, imageBarrierCount;
+    UnsignedInt bufferBarrierOffset, bufferBarrierCount;
+};
+
+struct RenderGraphHeap {
+    UnsignedInt memory;
+    bool isImage;
+    UnsignedLong size;
+    Memory allocation{NoCreate};
+};
+
+/* Synchronization state of a resource while walking the passes in
+   compile() */
+struct RenderGraphResourceTracking {
+    ImageLayout layout;
+    PipelineStages writeStages, readStages;
+    Accesses writeAccess, readAccess;
+};
+
+struct RenderGraphState {
+    explicit RenderGraphState(Device& device): device(device) {}
+
+    Device& device;
+    /* Order of the members matters -- the transient resources have to be
+       destroyed before the memory they're bound to is freed */
+    Containers::Array<RenderGraphHeap> heaps;
+    Containers::Array<RenderGraphResource> resources;
+    Containers::Array<RenderGraphPass> passes;
+
+    bool compiled{};
+    Containers::Array<UnsignedInt> order;
+    Containers::Array<ImageMemoryBarrier> imageBarriers;
+    Containers::Array<UnsignedInt> imageBarrierResources;
+    Containers::Array<BufferMemoryBarrier> bufferBarriers;
+    Containers::Array<UnsignedInt> bufferBarrierResources;
+    /* Final layout transitions of imported images, at the end of the
+       imageBarriers array */
+    PipelineStages finalSourceStages;
+    UnsignedInt finalImageBarrierOffset, finalImageBarrierCount;
+    UnsignedLong unaliasedSize;
+};
+
+}
+
+Debug& operator<<(Debug& debug, const RenderGraphUsage value) {
+    debug << "Vk::RenderGraphUsage" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Vk::RenderGraphUsage::value: return debug << "::" << Debug::nospace << #value;
+        _c(ColorAttachment)
+        _c(DepthStencilAttachment)
+        _c(InputAttachment)
+        _c(Sampled)
+        _c(Storage)
+        _c(TransferSource)
+        _c(TransferDestination)
+        _c(VertexBuffer)
+        _c(IndexBuffer)
+        _c(IndirectBuffer)
+        _c(UniformBuffer)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << UnsignedInt(value) << Debug::nospace << ")";
+}
+
+RenderGraph::RenderGraph(Device& device): _state{Containers::pointer<Implementation::RenderGraphState>(device)} {}
+
+RenderGraph::RenderGraph(NoCreateT) noexcept {}
+
+RenderGraph::RenderGraph(RenderGraph&&) noexcept = default;
+
+RenderGraph::~RenderGraph() = default;
+
+RenderGraph& RenderGraph::operator=(RenderGraph&&) noexcept = default;
+
+UnsignedInt RenderGraph::importImage(const Containers::StringView name, const VkImage image, const ImageAspects aspects, const ImageLayout initialLayout, const ImageLayout finalLayout) {
+    CORRADE_ASSERT(finalLayout != ImageLayout::Undefined,
+        "Vk::RenderGraph::importImage(): final layout can't be undefined", {});
+
+    Implementation::RenderGraphResource& resource = arrayAppend(_state->resources, InPlaceInit);
+    resource.name = name;
+    resource.isImage = true;
+    resource.isImported = true;
+    resource.imageHandle = image;
+    resource.aspects = aspects;
+    resource.initialLayout = initialLayout;
+    resource.finalLayout = finalLayout;
+    _state->compiled = false;
+    return _state->resources.size() - 1;
+}
+
+UnsignedInt RenderGraph::importBuffer(const Containers::StringView name, const VkBuffer buffer) {
+    Implementation::RenderGraphResource& resource = arrayAppend(_state->resources, InPlaceInit);
+    resource.name = name;
+    resource.isImage = false;
+    resource.isImported = true;
+    resource.bufferHandle = buffer;
+    _state->compiled = false;
+    return _state->resources.size() - 1;
+}
+
+UnsignedInt RenderGraph::addImage(const Containers::StringView name, const ImageCreateInfo& info, const ImageAspects aspects) {
+    Implementation::RenderGraphResource& resource = arrayAppend(_state->resources, InPlaceInit);
+    resource.name = name;
+    resource.isImage = true;
+    resource.isImported = false;
+    resource.imageInfo = *info;
+    resource.aspects = aspects;
+    _state->compiled = false;
+    return _state->resources.size() - 1;
+}
+
+UnsignedInt RenderGraph::addBuffer(const Containers::StringView name, const BufferCreateInfo& info) {
+    Implementation::RenderGraphResource& resource = arrayAppend(_state->resources, InPlaceInit);
+    resource.name = name;
+    resource.isImage = false;
+    resource.isImported = false;
+    resource.bufferInfo = *info;
+    _state->compiled = false;
+    return _state->resources.size() - 1;
+}
+
+UnsignedInt RenderGraph::addPass(const Containers::StringView name, const PassFunction function, void* const state) {
+    CORRADE_ASSERT(function,
+        "Vk::RenderGraph::addPass(): the function is null", {});
+
+    Implementation::RenderGraphPass& pass = arrayAppend(_state->passes, InPlaceInit);
+    pass.name = name;
+    pass.function = function;
+    pass.state = state;
+    _state->compiled = false;
+    return _state->passes.size() - 1;
+}
+
+void RenderGraph::addUsage(const UnsignedInt pass, const UnsignedInt resource, const RenderGraphUsage usage, const bool write) {
+    Implementation::RenderGraphState& state = *_state;
+    #ifndef CORRADE_NO_ASSERT
+    const char* const function = write ? "Vk::RenderGraph::addWrite():" : "Vk::RenderGraph::addRead():";
+    #endif
+    CORRADE_ASSERT(pass < state.passes.size(),
+        function << "index" << pass << "out of range for" << state.passes.size() << "passes", );
+    CORRADE_ASSERT(resource < state.resources.size(),
+        function << "index" << resource << "out of range for" << state.resources.size() << "resources", );
+
+    const Implementation::RenderGraphUsageMapping mapping = Implementation::renderGraphUsageMapping(usage);
+    const bool isImage = state.resources[resource].isImage;
+    CORRADE_ASSERT(isImage ? mapping.imageUsage : mapping.bufferUsage,
+        function << usage << "is not applicable to" << (isImage ? "an image" : "a buffer"), );
+    CORRADE_ASSERT(write ? mapping.writeAccess : mapping.readAccess,
+        function << usage << "is" << (write ? "read-only" : "write-only"), );
+
+    /* Merge with an existing usage of the same resource in this pass */
+    Implementation::RenderGraphPass& p = state.passes[pass];
+    Implementation::RenderGraphResourceUsage* found = nullptr;
+    for(Implementation::RenderGraphResourceUsage& i: p.usages) if(i.resource == resource) {
+        found = &i;
+        break;
+    }
+    if(!found) {
+        found = &arrayAppend(p.usages, InPlaceInit);
+        found->resource = resource;
+        found->readUsages = found->writeUsages = 0;
+        found->layout = isImage ? mapping.layout : ImageLayout::Undefined;
+    } else CORRADE_ASSERT(!isImage || found->layout == mapping.layout,
+        function << usage << "conflicts with a layout of an earlier usage of resource" << resource << "in pass" << pass, );
+
+    found->stages |= mapping.stages;
+    if(write) {
+        found->writeUsages |= 1 << UnsignedInt(usage);
+        found->writeAccess |= mapping.writeAccess;
+    } else {
+        found->readUsages |= 1 << UnsignedInt(usage);
+        found->readAccess |= mapping.readAccess;
+    }
+
+    state.compiled = false;
+}
+
+RenderGraph& RenderGraph::addRead(const UnsignedInt pass, const UnsignedInt resource, const RenderGraphUsage usage) {
+    addUsage(pass, resource, usage, false);
+    return *this;
+}
+
+RenderGraph& RenderGraph::addWrite(const UnsignedInt pass, const UnsignedInt resource, const RenderGraphUsage usage) {
+    addUsage(pass, resource, usage, true);
+    return *this;
+}
+
+UnsignedInt RenderGraph::resourceCount() const {
+    return _state ? _state->resources.size() : 0;
+}
+
+UnsignedInt RenderGraph::passCount() const {
+    return _state ? _state->passes.size() : 0;
+}
+
+RenderGraph& RenderGraph::setImportedImage(const UnsignedInt resource, const VkImage image) {
+    CORRADE_ASSERT(resource < _state->resources.size(),
+        "Vk::RenderGraph::setImportedImage(): index" << resource << "out of range for" << _state->resources.size() << "resources", *this);
+    Implementation::RenderGraphResource& r = _state->resources[resource];
+    CORRADE_ASSERT(r.isImage && r.isImported,
+        "Vk::RenderGraph::setImportedImage(): resource" << resource << "is not an imported image", *this);
+    r.imageHandle = image;
+    return *this;
+}
+
+RenderGraph& RenderGraph::setImportedBuffer(const UnsignedInt resource, const VkBuffer buffer) {
+    CORRADE_ASSERT(resource < _state->resources.size(),
+        "Vk::RenderGraph::setImportedBuffer(): index" << resource << "out of range for" << _state->resources.size() << "resources", *this);
+    Implementation::RenderGraphResource& r = _state->resources[resource];
+    CORRADE_ASSERT(!r.isImage && r.isImported,
+        "Vk::RenderGraph::setImportedBuffer(): resource" << resource << "is not an imported buffer", *this);
+    r.bufferHandle = buffer;
+    return *this;
+}
+
+RenderGraph& RenderGraph::compile() {
+    Implementation::RenderGraphState& state = *_state;
+
+    /* Destroy previously created transient resources, the resources first
+       and their memory after */
+    for(Implementation::RenderGraphResource& resource: state.resources) {
+        if(resource.isImported) continue;
+        resource.image = Image{NoCreate};
+        resource.buffer = Buffer{NoCreate};
+        resource.imageHandle = {};
+        resource.bufferHandle = {};
+    }
+    state.heaps = Containers::Array<Implementation::RenderGraphHeap>{};
+    state.order = Containers::Array<UnsignedInt>{};
+    state.imageBarriers = Containers::Array<ImageMemoryBarrier>{};
+    state.imageBarrierResources = Containers::Array<UnsignedInt>{};
+    state.bufferBarriers = Containers::Array<BufferMemoryBarrier>{};
+    state.bufferBarrierResources = Containers::Array<UnsignedInt>{};
+
+    /* 1. Cull passes, walking them from the last. A pass is needed if it
+       has no declared usage at all (so we can't know what it does), if it
+       writes an imported resource or if it writes a resource that's read
+       by a pass that's needed. All resources read by a needed pass are
+       then needed as well. */
+    Containers::Array<bool> resourceNeeded{ValueInit, state.resources.size()};
+    for(std::size_t i = state.passes.size(); i != 0; --i) {
+        Implementation::RenderGraphPass& pass = state.passes[i - 1];
+        bool needed = pass.usages.isEmpty();
+        for(const Implementation::RenderGraphResourceUsage& usage: pass.usages) {
+            if(usage.writeUsages && (state.resources[usage.resource].isImported || resourceNeeded[usage.resource])) {
+                needed = true;
+                break;
+            }
+        }
+
+        pass.culled = !needed;
+        if(!needed) continue;
+
+        for(const Implementation::RenderGraphResourceUsage& usage: pass.usages)
+            if(usage.readUsages) resourceNeeded[usage.resource] = true;
+    }
+
+    /* 2. Execution order. As dependencies always go from a pass declared
+       earlier to a pass declared later, the declaration order is a valid
+       topological order, which additionally keeps independent passes in
+       the order the user expects. */
+    for(std::size_t i = 0; i != state.passes.size(); ++i)
+        if(!state.passes[i].culled) arrayAppend(state.order, UnsignedInt(i));
+
+    /* 3. Lifetimes and usage flags of transient resources */
+    for(Implementation::RenderGraphResource& resource: state.resources) {
+        resource.firstUse = resource.lastUse = ~UnsignedInt{};
+        if(resource.isImported) continue;
+        if(resource.isImage) resource.imageInfo.usage = 0;
+        else resource.bufferInfo.usage = 0;
+    }
+    for(std::size_t i = 0; i != state.order.size(); ++i) {
+        for(const Implementation::RenderGraphResourceUsage& usage: state.passes[state.order[i]].usages) {
+            Implementation::RenderGraphResource& resource = state.resources[usage.resource];
+            if(resource.isImported) continue;
+
+            if(resource.firstUse == ~UnsignedInt{}) resource.firstUse = i;
+            resource.lastUse = i;
+
+            for(UnsignedInt j = 0; j != 16; ++j) {
+                if(!((usage.readUsages|usage.writeUsages) & (1 << j))) continue;
+                const Implementation::RenderGraphUsageMapping mapping = Implementation::renderGraphUsageMapping(RenderGraphUsage(j));
+                if(resource.isImage) resource.imageInfo.usage |= mapping.imageUsage;
+                else resource.bufferInfo.usage |= mapping.bufferUsage;
+            }
+        }
+    }
+
+    /* 4. Create the used transient resources without memory and place them
+       into heaps, biggest first. Each resource gets the lowest offset that
+       doesn't overlap with any already placed resource that has an
+       overlapping lifetime. */
+    Containers::Array<UnsignedInt> transients;
+    state.unaliasedSize = 0;
+    for(std::size_t i = 0; i != state.resources.size(); ++i) {
+        Implementation::RenderGraphResource& resource = state.resources[i];
+        if(resource.isImported || resource.firstUse == ~UnsignedInt{})
+            continue;
+
+        MemoryRequirements requirements{NoInit};
+        if(resource.isImage) {
+            resource.image = Image{state.device, ImageCreateInfo{resource.imageInfo}, NoAllocate};
+            resource.imageHandle = resource.image;
+            requirements = resource.image.memoryRequirements();
+        } else {
+            resource.buffer = Buffer{state.device, BufferCreateInfo{resource.bufferInfo}, NoAllocate};
+            resource.bufferHandle = resource.buffer;
+            requirements = resource.buffer.memoryRequirements();
+        }
+
+        const UnsignedInt memory = state.device.properties().pickMemory(MemoryFlag::DeviceLocal, requirements.memories());
+        resource.heap = ~UnsignedInt{};
+        for(std::size_t j = 0; j != state.heaps.size(); ++j) {
+            if(state.heaps[j].memory == memory && state.heaps[j].isImage == resource.isImage) {
+                resource.heap = j;
+                break;
+            }
+        }
+        if(resource.heap == ~UnsignedInt{}) {
+            Implementation::RenderGraphHeap& heap = arrayAppend(state.heaps, InPlaceInit);
+            heap.memory = memory;
+            heap.isImage = resource.isImage;
+            heap.size = 0;
+            resource.heap = state.heaps.size() - 1;
+        }
+
+        /* The alignment is abused as a temporary storage until placed */
+        resource.size = requirements.size();
+        resource.offset = requirements.alignment();
+        state.unaliasedSize += requirements.size();
+        arrayAppend(transients, UnsignedInt(i));
+    }
+
+    std::stable_sort(transients.begin(), transients.end(), [&state](UnsignedInt a, UnsignedInt b) {
+        return state.resources[a].size > state.resources[b].size;
+    });
+
+    Containers::Array<UnsignedInt> overlapping;
+    for(std::size_t i = 0; i != transients.size(); ++i) {
+        Implementation::RenderGraphResource& resource = state.resources[transients[i]];
+        const UnsignedLong alignment = resource.offset;
+
+        /* Resources already placed into the same heap and alive at the same
+           time, sorted by offset */
+        arrayResize(overlapping, 0);
+        for(std::size_t j = 0; j != i; ++j) {
+            const Implementation::RenderGraphResource& other = state.resources[transients[j]];
+            if(other.heap == resource.heap && other.firstUse <= resource.lastUse && resource.firstUse <= other.lastUse)
+                arrayAppend(overlapping, transients[j]);
+        }
+        std::sort(overlapping.begin(), overlapping.end(), [&state](UnsignedInt a, UnsignedInt b) {
+            return state.resources[a].offset < state.resources[b].offset;
+        });
+
+        UnsignedLong offset = 0;
+        for(const UnsignedInt j: overlapping) {
+            const Implementation::RenderGraphResource& other = state.resources[j];
+            if(offset + resource.size <= other.offset) break;
+            offset = Math::max(offset, (other.offset + other.size + alignment - 1)/alignment*alignment);
+        }
+
+        resource.offset = offset;
+        Implementation::RenderGraphHeap& heap = state.heaps[resource.heap];
+        heap.size = Math::max(heap.size, offset + resource.size);
+    }
+
+    for(Implementation::RenderGraphHeap& heap: state.heaps)
+        heap.allocation = Memory{state.device, MemoryAllocateInfo{heap.size, heap.memory}};
+    for(const UnsignedInt i: transients) {
+        Implementation::RenderGraphResource& resource = state.resources[i];
+        if(resource.isImage)
+            resource.image.bindMemory(state.heaps[resource.heap].allocation, resource.offset);
+        else
+            resource.buffer.bindMemory(state.heaps[resource.heap].allocation, resource.offset);
+    }
+
+    /* 5. Walk the passes in execution order and calculate barriers */
+    Containers::Array<Implementation::RenderGraphResourceTracking> tracking{ValueInit, state.resources.size()};
+    for(std::size_t i = 0; i != state.resources.size(); ++i)
+        tracking[i].layout = state.resources[i].isImported ? state.resources[i].initialLayout : ImageLayout::Undefined;
+
+    for(std::size_t i = 0; i != state.order.size(); ++i) {
+        Implementation::RenderGraphPass& pass = state.passes[state.order[i]];
+        pass.sourceStages = pass.destinationStages = {};
+        pass.imageBarrierOffset = state.imageBarriers.size();
+        pass.bufferBarrierOffset = state.bufferBarriers.size();
+
+        for(const Implementation::RenderGraphResourceUsage& usage: pass.usages) {
+            const Implementation::RenderGraphResource& resource = state.resources[usage.resource];
+            Implementation::RenderGraphResourceTracking& t = tracking[usage.resource];
+            const bool write = usage.writeUsages;
+            const Accesses access = usage.readAccess|usage.writeAccess;
+
+            PipelineStages sourceStages;
+            Accesses sourceAccess;
+            bool needed = false;
+
+            /* First use of a transient resource that shares memory with
+               resources used earlier has to wait for them to finish.
+               These are all already past their last use, so their tracked
+               state is final. */
+            if(!resource.isImported && resource.firstUse == i) {
+                for(const UnsignedInt j: transients) {
+                    const Implementation::RenderGraphResource& other = state.resources[j];
+                    if(other.heap != resource.heap || other.lastUse >= i || other.offset >= resource.offset + resource.size || resource.offset >= other.offset + other.size)
+                        continue;
+                    sourceStages |= tracking[j].writeStages|tracking[j].readStages;
+                    sourceAccess |= tracking[j].writeAccess;
+                    needed = true;
+                }
+            }
+
+            /* Layout transitions and writes have to wait for all previous
+               accesses, reads only for the last write and only if it wasn't
+               made visible to them already */
+            if((resource.isImage && usage.layout != t.layout) || write) {
+                if(resource.isImage && usage.layout != t.layout) needed = true;
+                if(t.writeStages|t.readStages) needed = true;
+                sourceStages |= t.writeStages|t.readStages;
+                sourceAccess |= t.writeAccess;
+            } else if(t.writeStages && ((usage.stages & ~t.readStages) || (access & ~t.readAccess))) {
+                needed = true;
+                sourceStages |= t.writeStages;
+                sourceAccess |= t.writeAccess;
+            }
+
+            if(needed) {
+                if(resource.isImage) {
+                    arrayAppend(state.imageBarriers, InPlaceInit, sourceAccess, access, t.layout, usage.layout, resource.imageHandle, resource.aspects);
+                    arrayAppend(state.imageBarrierResources, usage.resource);
+                } else {
+                    arrayAppend(state.bufferBarriers, InPlaceInit, sourceAccess, access, resource.bufferHandle);
+                    arrayAppend(state.bufferBarrierResources, usage.resource);
+                }
+                pass.sourceStages |= sourceStages ? sourceStages : PipelineStage::TopOfPipe;
+                pass.destinationStages |= usage.stages;
+            }
+
+            /* A layout transition is a write as well, but is already
+               visible to the accesses of this pass */
+            if(write) {
+                t.writeStages = usage.stages;
+                t.writeAccess = usage.writeAccess;
+                t.readStages = {};
+                t.readAccess = {};
+            } else if(resource.isImage && usage.layout != t.layout) {
+                t.writeStages = usage.stages;
+                t.writeAccess = {};
+                t.readStages = usage.stages;
+                t.readAccess = access;
+            } else {
+                t.readStages |= usage.stages;
+                t.readAccess |= access;
+            }
+            if(resource.isImage) t.layout = usage.layout;
+        }
+
+        pass.imageBarrierCount = state.imageBarriers.size() - pass.imageBarrierOffset;
+        pass.bufferBarrierCount = state.bufferBarriers.size() - pass.bufferBarrierOffset;
+    }
+
+    /* 6. Final layout transitions of imported images */
+    state.finalSourceStages = {};
+    state.finalImageBarrierOffset = state.imageBarriers.size();
+    for(std::size_t i = 0; i != state.resources.size(); ++i) {
+        const Implementation::RenderGraphResource& resource = state.resources[i];
+        const Implementation::RenderGraphResourceTracking& t = tracking[i];
+        if(!resource.isImported || !resource.isImage || resource.finalLayout == t.layout)
+            continue;
+
+        arrayAppend(state.imageBarriers, InPlaceInit, t.writeAccess, Accesses{}, t.layout, resource.finalLayout, resource.imageHandle, resource.aspects);
+        arrayAppend(state.imageBarrierResources, UnsignedInt(i));
+        state.finalSourceStages |= (t.writeStages|t.readStages) ? t.writeStages|t.readStages : PipelineStages{PipelineStage::TopOfPipe};
+    }
+    state.finalImageBarrierCount = state.imageBarriers.size() - state.finalImageBarrierOffset;
+
+    state.compiled = true;
+    return *this;
+}
+
+bool RenderGraph::isCompiled() const {
+    return _state && _state->compiled;
+}
+
+RenderGraph& RenderGraph::execute(CommandBuffer& commandBuffer) {
+    Implementation::RenderGraphState& state = *_state;
+    CORRADE_ASSERT(state.compiled,
+        "Vk::RenderGraph::execute(): the graph is not compiled", *this);
+
+    /* Imported handles could have changed since compile() */
+    for(std::size_t i = 0; i != state.imageBarriers.size(); ++i)
+        state.imageBarriers[i]->image = state.resources[state.imageBarrierResources[i]].imageHandle;
+    for(std::size_t i = 0; i != state.bufferBarriers.size(); ++i)
+        state.bufferBarriers[i]->buffer = state.resources[state.bufferBarrierResources[i]].bufferHandle;
+
+    for(const UnsignedInt i: state.order) {
+        const Implementation::RenderGraphPass& pass = state.passes[i];
+        if(pass.imageBarrierCount || pass.bufferBarrierCount)
+            commandBuffer.pipelineBarrier(pass.sourceStages, pass.destinationStages, nullptr,
+                state.bufferBarriers.sliceSize(pass.bufferBarrierOffset, pass.bufferBarrierCount),
+                state.imageBarriers.sliceSize(pass.imageBarrierOffset, pass.imageBarrierCount));
+        pass.function(*this, commandBuffer, pass.state);
+    }
+
+    if(state.finalImageBarrierCount)
+        commandBuffer.pipelineBarrier(state.finalSourceStages, PipelineStage::BottomOfPipe, nullptr, nullptr,
+            state.imageBarriers.sliceSize(state.finalImageBarrierOffset, state.finalImageBarrierCount));
+
+    return *this;
+}
+
+VkImage RenderGraph::image(const UnsignedInt resource) const {
+    CORRADE_ASSERT(resource < _state->resources.size(),
+        "Vk::RenderGraph::image(): index" << resource << "out of range for" << _state->resources.size() << "resources", {});
+    const Implementation::RenderGraphResource& r = _state->resources[resource];
+    CORRADE_ASSERT(r.isImage,
+        "Vk::RenderGraph::image(): resource" << resource << "is not an image", {});
+    CORRADE_ASSERT(r.isImported || _state->compiled,
+        "Vk::RenderGraph::image(): the graph is not compiled", {});
+    return r.imageHandle;
+}
+
+VkBuffer RenderGraph::buffer(const UnsignedInt resource) const {
+    CORRADE_ASSERT(resource < _state->resources.size(),
+        "Vk::RenderGraph::buffer(): index" << resource << "out of range for" << _state->resources.size() << "resources", {});
+    const Implementation::RenderGraphResource& r = _state->resources[resource];
+    CORRADE_ASSERT(!r.isImage,
+        "Vk::RenderGraph::buffer(): resource" << resource << "is not a buffer", {});
+    CORRADE_ASSERT(r.isImported || _state->compiled,
+        "Vk::RenderGraph::buffer(): the graph is not compiled", {});
+    return r.bufferHandle;
+}
+
+Containers::ArrayView<const UnsignedInt> RenderGraph::passOrder() const {
+    CORRADE_ASSERT(_state->compiled,
+        "Vk::RenderGraph::passOrder(): the graph is not compiled", {});
+    return _state->order;
+}
+
+bool RenderGraph::isPassCulled(const UnsignedInt pass) const {
+    CORRADE_ASSERT(_state->compiled,
+        "Vk::RenderGraph::isPassCulled(): the graph is not compiled", {});
+    CORRADE_ASSERT(pass < _state->passes.size(),
+        "Vk::RenderGraph::isPassCulled(): index" << pass << "out of range for" << _state->passes.size() << "passes", {});
+    return _state->passes[pass].culled;
+}
+
+UnsignedInt RenderGraph::barrierCount() const {
+    CORRADE_ASSERT(_state->compiled,
+        "Vk::RenderGraph::barrierCount(): the graph is not compiled", {});
+    return _state->imageBarriers.size() + _state->bufferBarriers.size();
+}
+
+UnsignedLong RenderGraph::transientMemorySize() const {
+    CORRADE_ASSERT(_state->compiled,
+        "Vk::RenderGraph::transientMemorySize(): the graph is not compiled", {});
+    UnsignedLong size = 0;
+    for(const Implementation::RenderGraphHeap& heap: _state->heaps)
+        size += heap.size;
+    return size;
+}
+
+UnsignedLong RenderGraph::transientMemorySizeUnaliased() const {
+    CORRADE_ASSERT(_state->compiled,
+        "Vk::RenderGraph::transientMemorySizeUnaliased(): the graph is not compiled", {});
+    return _state->unaliasedSize;
+}
+
+namespace {
+
+void printUsages(Debug& d, const char* const what, const Containers::StringView name, const UnsignedShort usages) {
+    if(!usages) return;
+    d << Debug::newline << "   " << what << name << "as";
+    bool first = true;
+    for(UnsignedInt i = 0; i != 16; ++i) {
+        if(!(usages & (1 << i))) continue;
+        if(!first) d << Debug::nospace << ",";
+        d << RenderGraphUsage(i);
+        first = false;
+    }
+}
+
+void printImageLayout(Debug& d, const VkImageLayout layout) {
+    if(const char* name = Implementation::imageLayoutName(layout)) d << name;
+    else d << Debug::hex << UnsignedInt(layout);
+}
+
+void printImageBarrier(Debug& d, const Containers::StringView name, const ImageMemoryBarrier& barrier) {
+    d << Debug::newline << "    barrier" << name << Debug::nospace << ":";
+    printImageLayout(d, barrier->oldLayout);
+    if(barrier->newLayout != barrier->oldLayout) {
+        d << "->";
+        printImageLayout(d, barrier->newLayout);
+    }
+}
+
+}
+
+Containers::String RenderGraph::dump() const {
+    const Implementation::RenderGraphState& state = *_state;
+    CORRADE_ASSERT(state.compiled,
+        "Vk::RenderGraph::dump(): the graph is not compiled", {});
+
+    UnsignedInt transientCount = 0;
+    for(const Implementation::RenderGraphResource& resource: state.resources)
+        if(!resource.isImported && resource.firstUse != ~UnsignedInt{}) ++transientCount;
+
+    std::ostringstream out;
+    {
+        Debug d{&out, Debug::Flag::NoNewlineAtTheEnd};
+        d << "Vk::RenderGraph:" << state.passes.size() << "passes," << state.passes.size() - state.order.size() << "culled," << transientCount << "transient resources in" << state.heaps.size() << "allocations";
+
+        for(const UnsignedInt i: state.order) {
+            const Implementation::RenderGraphPass& pass = state.passes[i];
+            d << Debug::newline << "  Pass" << i << pass.name << Debug::nospace << ":";
+            for(UnsignedInt j = 0; j != pass.bufferBarrierCount; ++j)
+                d << Debug::newline << "    barrier" << state.resources[state.bufferBarrierResources[pass.bufferBarrierOffset + j]].name;
+            for(UnsignedInt j = 0; j != pass.imageBarrierCount; ++j)
+                printImageBarrier(d, state.resources[state.imageBarrierResources[pass.imageBarrierOffset + j]].name, state.imageBarriers[pass.imageBarrierOffset + j]);
+            for(const Implementation::RenderGraphResourceUsage& usage: pass.usages) {
+                printUsages(d, "read", state.resources[usage.resource].name, usage.readUsages);
+                printUsages(d, "write", state.resources[usage.resource].name, usage.writeUsages);
+            }
+        }
+
+        if(state.finalImageBarrierCount) {
+            d << Debug::newline << "  Final:";
+            for(UnsignedInt j = 0; j != state.finalImageBarrierCount; ++j)
+                printImageBarrier(d, state.resources[state.imageBarrierResources[state.finalImageBarrierOffset + j]].name, state.imageBarriers[state.finalImageBarrierOffset + j]);
+        }
+
+        for(std::size_t i = 0; i != state.passes.size(); ++i)
+            if(state.passes[i].culled)
+                d << Debug::newline << "  Culled pass" << i << state.passes[i].name;
+
+        d << Debug::newline << "  Transient memory:" << transientMemorySize() << "bytes," << state.unaliasedSize << "bytes without aliasing";
+    }
+
+    return out.str();
+}
+
+}}
@@ -0,0 +1,488 @@
+#ifndef Magnum_Vk_RenderGraph_h
+#define Magnum_Vk_RenderGraph_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::RenderGraph, enum @ref Magnum::Vk::RenderGraphUsage
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+namespace Implementation { struct RenderGraphState; }
+
+/**
+@brief Render graph resource usage
+@m_since_latest
+
+Describes how a @ref RenderGraph pass accesses a resource. Each usage implies
+a set of pipeline stages, memory accesses and, for images, an image layout
+the resource has to be in.
+
+@see @ref RenderGraph::addRead(), @ref RenderGraph::addWrite()
+*/
+enum class RenderGraphUsage: UnsignedByte {
+    /**
+     * Image used as a color attachment. Implies
+     * @ref PipelineStage::ColorAttachmentOutput,
+     * @ref Access::ColorAttachmentRead / @ref Access::ColorAttachmentWrite
+     * and @ref ImageLayout::ColorAttachment.
+     */
+    ColorAttachment,
+
+    /**
+     * Image used as a depth/stencil attachment. Implies
+     * @ref PipelineStage::EarlyFragmentTests and
+     * @ref PipelineStage::LateFragmentTests,
+     * @ref Access::DepthStencilAttachmentRead /
+     * @ref Access::DepthStencilAttachmentWrite and
+     * @ref ImageLayout::DepthStencilAttachment.
+     */
+    DepthStencilAttachment,
+
+    /**
+     * Image used as an input attachment. Read-only, implies
+     * @ref PipelineStage::FragmentShader, @ref Access::InputAttachmentRead
+     * and @ref ImageLayout::ShaderReadOnly.
+     */
+    InputAttachment,
+
+    /**
+     * Image sampled in a shader. Read-only, implies
+     * @ref PipelineStage::VertexShader, @ref PipelineStage::FragmentShader
+     * and @ref PipelineStage::ComputeShader, @ref Access::ShaderRead and
+     * @ref ImageLayout::ShaderReadOnly.
+     */
+    Sampled,
+
+    /**
+     * Storage image or storage buffer accessed from a shader. Implies
+     * @ref PipelineStage::VertexShader, @ref PipelineStage::FragmentShader
+     * and @ref PipelineStage::ComputeShader, @ref Access::ShaderRead /
+     * @ref Access::ShaderWrite and, for images, @ref ImageLayout::General.
+     */
+    Storage,
+
+    /**
+     * Image or buffer used as a source of a transfer operation. Read-only,
+     * implies @ref PipelineStage::Transfer, @ref Access::TransferRead and,
+     * for images, @ref ImageLayout::TransferSource.
+     */
+    TransferSource,
+
+    /**
+     * Image or buffer used as a destination of a transfer operation.
+     * Write-only, implies @ref PipelineStage::Transfer,
+     * @ref Access::TransferWrite and, for images,
+     * @ref ImageLayout::TransferDestination.
+     */
+    TransferDestination,
+
+    /**
+     * Buffer used as a vertex buffer. Read-only, implies
+     * @ref PipelineStage::VertexInput and @ref Access::VertexAttributeRead.
+     */
+    VertexBuffer,
+
+    /**
+     * Buffer used as an index buffer. Read-only, implies
+     * @ref PipelineStage::VertexInput and @ref Access::IndexRead.
+     */
+    IndexBuffer,
+
+    /**
+     * Buffer used as a source of indirect draw or dispatch parameters.
+     * Read-only, implies @ref PipelineStage::DrawIndirect and
+     * @ref Access::IndirectCommandRead.
+     */
+    IndirectBuffer,
+
+    /**
+     * Buffer used as a uniform buffer. Read-only, implies
+     * @ref PipelineStage::VertexShader, @ref PipelineStage::FragmentShader
+     * and @ref PipelineStage::ComputeShader and @ref Access::UniformRead.
+     */
+    UniformBuffer
+};
+
+/**
+@debugoperatorenum{RenderGraphUsage}
+@m_since_latest
+*/
+MAGNUM_VK_EXPORT Debug& operator<<(Debug& debug, RenderGraphUsage value);
+
+/**
+@brief Render graph
+@m_since_latest
+
+Records a frame as a sequence of passes that declare which resources they
+read and write, and derives all @ref CommandBuffer::pipelineBarrier() calls,
+image layout transitions and lifetimes of intermediate render targets from
+those declarations instead of having them written by hand.
+
+@section Vk-RenderGraph-usage Usage
+
+Resources are either imported, such as a swapchain image or a persistent
+buffer, or transient, which are created by the graph itself and exist only
+for the duration of the passes that use them. Passes are added with a
+function that records their commands and declare their resource usage with
+@ref addRead() and @ref addWrite(). The graph is then compiled once and
+executed into a command buffer every frame:
+
+@snippet Vk.cpp RenderGraph-usage
+
+Usage flags of transient images and buffers are derived from the declared
+usages, the ones passed in the create info are only extended. Pass functions
+get the actual resource handles through @ref image() and @ref buffer().
+Render passes used inside pass functions are expected to have both initial
+and final layout of their attachments equal to the layout implied by the
+declared @ref RenderGraphUsage, as the transitions are done by the graph.
+
+@section Vk-RenderGraph-compilation Compilation
+
+@ref compile() does the following:
+
+-   Passes are executed in a topological order of their dependencies. A
+    dependency is formed between passes that access the same resource and at
+    least one of them writes it, with declaration order deciding which of the
+    two goes first. Thus the order in which passes are added is always a
+    valid execution order and independent passes keep their relative order.
+-   Passes that don't contribute to any imported resource are culled. A pass
+    is kept if it writes an imported resource, if it doesn't declare any
+    resource usage at all, or if it writes a resource that's read by another
+    pass that's kept.
+-   Transient resources not used by any remaining pass aren't created at all.
+    The remaining ones are created without memory, and resources whose
+    lifetimes don't overlap get assigned overlapping ranges of the same
+    @ref Memory allocation. Images and buffers are never placed into the same
+    allocation, which avoids having to deal with the
+    @m_class{m-doc-external} [bufferImageGranularity](https://www.khronos.org/registry/vulkan/specs/1.2-extensions/man/html/VkPhysicalDeviceLimits.html#limits-bufferImageGranularity)
+    limit.
+-   For each pass a single @ref CommandBuffer::pipelineBarrier() is
+    calculated, containing only barriers needed for read-after-write,
+    write-after-read and write-after-write hazards and layout transitions.
+    Consecutive reads in the same layout don't need any barrier. The first
+    use of a transient resource sharing memory with a resource used earlier
+    is synchronized with the last use of the earlier resource. Imported
+    images are transitioned to their final layout after the last pass.
+
+@ref transientMemorySize() and @ref transientMemorySizeUnaliased() show how
+much memory aliasing saved, @ref dump() prints the compiled graph in a
+human-readable form for debugging.
+
+@section Vk-RenderGraph-limitations Limitations
+
+Resources are always tracked as a whole, there's no tracking of individual
+image subresources or buffer ranges. Imported resources are assumed to have
+all previous writes already made visible at the start of @ref execute(), for
+example by waiting on a semaphore with an appropriate stage mask. All passes
+are expected to be executed on a single queue.
+*/
+class MAGNUM_VK_EXPORT RenderGraph {
+    public:
+        /**
+         * @brief Pass function
+         *
+         * Called from @ref execute() with the graph itself, command buffer
+         * to record the pass into and the state pointer passed to
+         * @ref addPass().
+         */
+        typedef void(*PassFunction)(const RenderGraph&, CommandBuffer&, void*);
+
+        /**
+         * @brief Constructor
+         * @param device    Vulkan device to create the transient resources
+         *      on
+         */
+        explicit RenderGraph(Device& device);
+
+        /**
+         * @brief Construct without creating the graph
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit RenderGraph(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        RenderGraph(const RenderGraph&) = delete;
+
+        /** @brief Move constructor */
+        RenderGraph(RenderGraph&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys all transient resources and their memory. The caller is
+         * responsible for ensuring no command buffer recorded with
+         * @ref execute() is still in use.
+         */
+        ~RenderGraph();
+
+        /** @brief Copying is not allowed */
+        RenderGraph& operator=(const RenderGraph&) = delete;
+
+        /** @brief Move assignment */
+        RenderGraph& operator=(RenderGraph&& other) noexcept;
+
+        /**
+         * @brief Import an image
+         * @param name          Name, used for debug output
+         * @param image         An @ref Image or a raw Vulkan image handle
+         * @param aspects       Image aspects
+         * @param initialLayout Layout the image is in at the start of
+         *      @ref execute()
+         * @param finalLayout   Layout the image should be transitioned to
+         *      at the end of @ref execute(). Pass the same value as the
+         *      initial layout to keep it in the layout it was last used in.
+         * @return Resource ID
+         *
+         * The image contents are preserved, unless @p initialLayout is
+         * @ref ImageLayout::Undefined. Invalidates the compiled state.
+         * @see @ref setImportedImage()
+         */
+        UnsignedInt importImage(Containers::StringView name, VkImage image, ImageAspects aspects, ImageLayout initialLayout, ImageLayout finalLayout);
+
+        /**
+         * @brief Import a buffer
+         * @param name          Name, used for debug output
+         * @param buffer        A @ref Buffer or a raw Vulkan buffer handle
+         * @return Resource ID
+         *
+         * Invalidates the compiled state.
+         * @see @ref setImportedBuffer()
+         */
+        UnsignedInt importBuffer(Containers::StringView name, VkBuffer buffer);
+
+        /**
+         * @brief Add a transient image
+         * @param name          Name, used for debug output
+         * @param info          Image creation info. Usage flags get
+         *      extended based on the declared usages. The structure is
+         *      copied, any extension structures in the `pNext` chain have to
+         *      stay in scope until @ref compile() is called.
+         * @param aspects       Image aspects
+         * @return Resource ID
+         *
+         * The image gets created in @ref compile() if it's used by at least
+         * one pass that isn't culled. Its contents are undefined at the
+         * start of the first pass that uses it. Invalidates the compiled
+         * state.
+         */
+        UnsignedInt addImage(Containers::StringView name, const ImageCreateInfo& info, ImageAspects aspects);
+
+        /**
+         * @brief Add a transient buffer
+         * @param name          Name, used for debug output
+         * @param info          Buffer creation info. Usage flags get
+         *      extended based on the declared usages. The structure is
+         *      copied, any extension structures in the `pNext` chain have to
+         *      stay in scope until @ref compile() is called.
+         * @return Resource ID
+         *
+         * The buffer gets created in @ref compile() if it's used by at least
+         * one pass that isn't culled. Its contents are undefined at the
+         * start of the first pass that uses it. Invalidates the compiled
+         * state.
+         */
+        UnsignedInt addBuffer(Containers::StringView name, const BufferCreateInfo& info);
+
+        /**
+         * @brief Add a pass
+         * @param name          Name, used for debug output
+         * @param function      Function recording the pass commands
+         * @param state         State pointer passed to @p function
+         * @return Pass ID
+         *
+         * Passes are executed in the order they're added, unless culled.
+         * Invalidates the compiled state.
+         */
+        UnsignedInt addPass(Containers::StringView name, PassFunction function, void* state = nullptr);
+
+        /**
+         * @brief Declare a resource read
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p pass and @p resource are valid IDs, that
+         * @p usage is applicable to given resource type and isn't write-only.
+         * If the same resource is used multiple times in a single pass, the
+         * usages are expected to imply the same image layout. Invalidates
+         * the compiled state.
+         */
+        RenderGraph& addRead(UnsignedInt pass, UnsignedInt resource, RenderGraphUsage usage);
+
+        /**
+         * @brief Declare a resource write
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p pass and @p resource are valid IDs, that
+         * @p usage is applicable to given resource type and isn't read-only.
+         * If the pass depends on previous contents of the resource, such as
+         * when blending or depth testing, declare a read of it as well. If
+         * the same resource is used multiple times in a single pass, the
+         * usages are expected to imply the same image layout. Invalidates
+         * the compiled state.
+         */
+        RenderGraph& addWrite(UnsignedInt pass, UnsignedInt resource, RenderGraphUsage usage);
+
+        /** @brief Resource count */
+        UnsignedInt resourceCount() const;
+
+        /** @brief Pass count */
+        UnsignedInt passCount() const;
+
+        /**
+         * @brief Replace an imported image handle
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p resource is an imported image. Useful for example
+         * for swapchain images that change every frame. Doesn't invalidate
+         * the compiled state.
+         */
+        RenderGraph& setImportedImage(UnsignedInt resource, VkImage image);
+
+        /**
+         * @brief Replace an imported buffer handle
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p resource is an imported buffer. Doesn't invalidate
+         * the compiled state.
+         */
+        RenderGraph& setImportedBuffer(UnsignedInt resource, VkBuffer buffer);
+
+        /**
+         * @brief Compile the graph
+         * @return Reference to self (for method chaining)
+         *
+         * Culls unused passes, creates transient resources with aliased
+         * memory and calculates barriers. See
+         * @ref Vk-RenderGraph-compilation for details. Any previously
+         * created transient resources are destroyed, the caller is
+         * responsible for ensuring they're not in use anymore.
+         */
+        RenderGraph& compile();
+
+        /** @brief Whether the graph is compiled */
+        bool isCompiled() const;
+
+        /**
+         * @brief Record the graph into a command buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the graph is compiled. For each pass that wasn't
+         * culled records the calculated barriers and then calls the pass
+         * function. At the end records transitions of imported images to
+         * their final layout.
+         */
+        RenderGraph& execute(CommandBuffer& commandBuffer);
+
+        /**
+         * @brief Image handle
+         *
+         * Expects that @p resource is an image. For transient images
+         * expects that the graph is compiled and returns a null handle if
+         * the image wasn't created because all passes using it were culled.
+         */
+        VkImage image(UnsignedInt resource) const;
+
+        /**
+         * @brief Buffer handle
+         *
+         * Expects that @p resource is a buffer. For transient buffers
+         * expects that the graph is compiled and returns a null handle if
+         * the buffer wasn't created because all passes using it were culled.
+         */
+        VkBuffer buffer(UnsignedInt resource) const;
+
+        /**
+         * @brief Pass execution order
+         *
+         * IDs of passes that weren't culled, in the order they get
+         * executed. Expects that the graph is compiled.
+         */
+        Containers::ArrayView<const UnsignedInt> passOrder() const;
+
+        /**
+         * @brief Whether a pass got culled
+         *
+         * Expects that the graph is compiled and @p pass is a valid ID.
+         */
+        bool isPassCulled(UnsignedInt pass) const;
+
+        /**
+         * @brief Count of barriers
+         *
+         * Count of individual image and buffer memory barriers recorded by
+         * @ref execute(), including final layout transitions of imported
+         * images. Expects that the graph is compiled.
+         */
+        UnsignedInt barrierCount() const;
+
+        /**
+         * @brief Transient memory size
+         *
+         * Total size of memory allocated for transient resources. Expects
+         * that the graph is compiled.
+         * @see @ref transientMemorySizeUnaliased()
+         */
+        UnsignedLong transientMemorySize() const;
+
+        /**
+         * @brief Transient memory size without aliasing
+         *
+         * Total size of memory transient resources would need if each had
+         * its own allocation. Expects that the graph is compiled.
+         * @see @ref transientMemorySize()
+         */
+        UnsignedLong transientMemorySizeUnaliased() const;
+
+        /**
+         * @brief Debug dump of the compiled graph
+         *
+         * Lists passes in execution order together with barriers and
+         * resource usages, culled passes and transient memory usage.
+         * Expects that the graph is compiled.
+         */
+        Containers::String dump() const;
+
+    private:
+        MAGNUM_VK_LOCAL void addUsage(UnsignedInt pass, UnsignedInt resource, RenderGraphUsage usage, bool write);
+
+        Containers::Pointer<Implementation::RenderGraphState> _state;
+};
+
+}}
+
+#endif
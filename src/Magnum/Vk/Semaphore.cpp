@@ -0,0 +1,177 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Semaphore.h"
+#include "SemaphoreCreateInfo.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Vk/Assert.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/Result.h"
+#include "Magnum/Vk/Implementation/DeviceState.h"
+
+namespace Magnum { namespace Vk {
+
+SemaphoreCreateInfo::SemaphoreCreateInfo(const Type type, const UnsignedLong initialValue): _info{}, _typeInfo{} {
+    CORRADE_ASSERT(type == Type::Timeline || !initialValue,
+        "Vk::SemaphoreCreateInfo: initial value can be set only for a timeline semaphore", );
+
+    _info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    if(type == Type::Timeline) {
+        _typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        _typeInfo.semaphoreType = VkSemaphoreType(type);
+        _typeInfo.initialValue = initialValue;
+        _info.pNext = &_typeInfo;
+    }
+}
+
+SemaphoreCreateInfo::SemaphoreCreateInfo(NoInitT) noexcept {}
+
+SemaphoreCreateInfo::SemaphoreCreateInfo(const VkSemaphoreCreateInfo& info):
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(info), _typeInfo{} {}
+
+SemaphoreCreateInfo::SemaphoreCreateInfo(SemaphoreCreateInfo&& other) noexcept:
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(other._info),
+    _typeInfo(other._typeInfo)
+{
+    /* Redirect the pNext to our copy of the type info, if it pointed to the
+       other instance's, and ensure the previous instance doesn't reference
+       state that's now ours */
+    if(_info.pNext == &other._typeInfo) {
+        _info.pNext = &_typeInfo;
+        other._info.pNext = nullptr;
+    }
+}
+
+SemaphoreCreateInfo::~SemaphoreCreateInfo() = default;
+
+SemaphoreCreateInfo& SemaphoreCreateInfo::operator=(SemaphoreCreateInfo&& other) noexcept {
+    using Utility::swap;
+    swap(other._info, _info);
+    swap(other._typeInfo, _typeInfo);
+
+    /* Fix up the pNext pointers that now point to the other instance */
+    if(_info.pNext == &other._typeInfo) _info.pNext = &_typeInfo;
+    if(other._info.pNext == &_typeInfo) other._info.pNext = &other._typeInfo;
+    return *this;
+}
+
+Semaphore Semaphore::wrap(Device& device, const VkSemaphore handle, const HandleFlags flags) {
+    Semaphore out{NoCreate};
+    out._device = &device;
+    out._handle = handle;
+    out._flags = flags;
+    return out;
+}
+
+Semaphore::Semaphore(Device& device, const SemaphoreCreateInfo& info): _device{&device}, _flags{HandleFlag::DestroyOnDestruction} {
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateSemaphore(device, info, nullptr, &_handle));
+}
+
+Semaphore::Semaphore(Device& device): Semaphore{device, SemaphoreCreateInfo{}} {}
+
+Semaphore::Semaphore(NoCreateT): _device{}, _handle{} {}
+
+Semaphore::Semaphore(Semaphore&& other) noexcept: _device{other._device}, _handle{other._handle}, _flags{other._flags} {
+    other._handle = {};
+}
+
+Semaphore::~Semaphore() {
+    if(_handle && (_flags & HandleFlag::DestroyOnDestruction))
+        (**_device).DestroySemaphore(*_device, _handle, nullptr);
+}
+
+Semaphore& Semaphore::operator=(Semaphore&& other) noexcept {
+    using Utility::swap;
+    swap(other._device, _device);
+    swap(other._handle, _handle);
+    swap(other._flags, _flags);
+    return *this;
+}
+
+UnsignedLong Semaphore::value() {
+    UnsignedLong value;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(_device->state().getSemaphoreCounterValueImplementation(*_device, _handle, value));
+    return value;
+}
+
+void Semaphore::signal(const UnsignedLong value) {
+    VkSemaphoreSignalInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+    info.semaphore = _handle;
+    info.value = value;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(_device->state().signalSemaphoreImplementation(*_device, info));
+}
+
+bool Semaphore::wait(const UnsignedLong value, const std::chrono::nanoseconds timeout) {
+    VkSemaphoreWaitInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    info.semaphoreCount = 1;
+    info.pSemaphores = &_handle;
+    info.pValues = &value;
+    return MAGNUM_VK_INTERNAL_ASSERT_SUCCESS_OR(_device->state().waitSemaphoresImplementation(*_device, info, timeout.count()), Result::Timeout) == Result::Success;
+}
+
+void Semaphore::wait(const UnsignedLong value) {
+    CORRADE_INTERNAL_ASSERT_OUTPUT(wait(value, std::chrono::nanoseconds{~std::uint64_t{}}));
+}
+
+VkSemaphore Semaphore::release() {
+    const VkSemaphore handle = _handle;
+    _handle = {};
+    return handle;
+}
+
+VkResult Semaphore::getCounterValueImplementationKHR(Device& device, const VkSemaphore semaphore, UnsignedLong& value) {
+    return device->GetSemaphoreCounterValueKHR(device, semaphore, &value);
+}
+
+VkResult Semaphore::getCounterValueImplementation12(Device& device, const VkSemaphore semaphore, UnsignedLong& value) {
+    return device->GetSemaphoreCounterValue(device, semaphore, &value);
+}
+
+VkResult Semaphore::signalImplementationKHR(Device& device, const VkSemaphoreSignalInfo& info) {
+    return device->SignalSemaphoreKHR(device, &info);
+}
+
+VkResult Semaphore::signalImplementation12(Device& device, const VkSemaphoreSignalInfo& info) {
+    return device->SignalSemaphore(device, &info);
+}
+
+VkResult Semaphore::waitImplementationKHR(Device& device, const VkSemaphoreWaitInfo& info, const UnsignedLong timeout) {
+    return device->WaitSemaphoresKHR(device, &info, timeout);
+}
+
+VkResult Semaphore::waitImplementation12(Device& device, const VkSemaphoreWaitInfo& info, const UnsignedLong timeout) {
+    return device->WaitSemaphores(device, &info, timeout);
+}
+
+}}
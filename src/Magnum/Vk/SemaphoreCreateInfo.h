@@ -0,0 +1,149 @@
+#ifndef Magnum_Vk_SemaphoreCreateInfo_h
+#define Magnum_Vk_SemaphoreCreateInfo_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::SemaphoreCreateInfo
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/visibility.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Semaphore creation info
+@m_since_latest
+
+Wraps a @type_vk_keyword{SemaphoreCreateInfo} and optionally also a
+@type_vk_keyword{SemaphoreTypeCreateInfo}. See
+@ref Vk-Semaphore-creation "Semaphore creation" for usage information.
+*/
+class MAGNUM_VK_EXPORT SemaphoreCreateInfo {
+    public:
+        /**
+         * @brief Semaphore type
+         *
+         * Wraps @type_vk_keyword{SemaphoreType}.
+         * @see @ref SemaphoreCreateInfo(Type, UnsignedLong)
+         * @m_enum_values_as_keywords
+         */
+        enum class Type: Int {
+            /**
+             * Binary semaphore, with a signaled and unsignaled state. Used
+             * for synchronization between queue submissions.
+             */
+            Binary = VK_SEMAPHORE_TYPE_BINARY,
+
+            /**
+             * Timeline semaphore, with a monotonically increasing 64-bit
+             * counter value. Can be additionally signaled and waited on from
+             * the host.
+             * @requires_vk12 Extension @vk_extension{KHR,timeline_semaphore}
+             * @requires_vk_feature @ref DeviceFeature::TimelineSemaphore
+             */
+            Timeline = VK_SEMAPHORE_TYPE_TIMELINE
+        };
+
+        /**
+         * @brief Constructor
+         * @param type          Semaphore type
+         * @param initialValue  Initial counter value. Expected to be
+         *      @cpp 0 @ce for a @ref Type::Binary semaphore.
+         *
+         * The following @type_vk{SemaphoreCreateInfo} fields are pre-filled
+         * in addition to `sType`, everything else is zero-filled:
+         *
+         * -    *(none)*
+         *
+         * If @p type is @ref Type::Timeline, a
+         * @type_vk{SemaphoreTypeCreateInfo} structure is additionally
+         * connected to the `pNext` chain, with the following fields
+         * pre-filled in addition to `sType`:
+         *
+         * -    `semaphoreType` to @p type
+         * -    `initialValue`
+         */
+        explicit SemaphoreCreateInfo(Type type = Type::Binary, UnsignedLong initialValue = 0);
+
+        /**
+         * @brief Construct without initializing the contents
+         *
+         * Note that not even the `sType` field is set --- the structure has to
+         * be fully initialized afterwards in order to be usable.
+         */
+        explicit SemaphoreCreateInfo(NoInitT) noexcept;
+
+        /**
+         * @brief Construct from existing data
+         *
+         * Copies the existing values verbatim, pointers are kept unchanged
+         * without taking over the ownership. Modifying the newly created
+         * instance will not modify the original data nor the pointed-to data.
+         */
+        explicit SemaphoreCreateInfo(const VkSemaphoreCreateInfo& info);
+
+        /** @brief Copying is not allowed */
+        SemaphoreCreateInfo(const SemaphoreCreateInfo&) = delete;
+
+        /** @brief Move constructor */
+        SemaphoreCreateInfo(SemaphoreCreateInfo&& other) noexcept;
+
+        ~SemaphoreCreateInfo();
+
+        /** @brief Copying is not allowed */
+        SemaphoreCreateInfo& operator=(const SemaphoreCreateInfo&) = delete;
+
+        /** @brief Move assignment */
+        SemaphoreCreateInfo& operator=(SemaphoreCreateInfo&& other) noexcept;
+
+        /** @brief Underlying @type_vk{SemaphoreCreateInfo} structure */
+        VkSemaphoreCreateInfo& operator*() { return _info; }
+        /** @overload */
+        const VkSemaphoreCreateInfo& operator*() const { return _info; }
+        /** @overload */
+        VkSemaphoreCreateInfo* operator->() { return &_info; }
+        /** @overload */
+        const VkSemaphoreCreateInfo* operator->() const { return &_info; }
+        /** @overload */
+        operator const VkSemaphoreCreateInfo*() const { return &_info; }
+
+    private:
+        VkSemaphoreCreateInfo _info;
+        VkSemaphoreTypeCreateInfo _typeInfo;
+};
+
+}}
+
+/* Make the definition complete -- it doesn't make sense to have a CreateInfo
+   without the corresponding object anyway. */
+#include "Magnum/Vk/Semaphore.h"
+
+#endif
@@ -0,0 +1,658 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include "ShaderReflection.h"
+
+#include <algorithm> /* std::sort() */
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Iterable.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Vk/DescriptorSetLayoutCreateInfo.h"
+#include "Magnum/Vk/DescriptorType.h"
+#include "Magnum/Vk/MeshLayout.h"
+#include "Magnum/Vk/Shader.h"
+
+/* All code in this file should be self-contained, with no link-time dependency
+   on ShaderTools */
+#include "Magnum/ShaderTools/Implementation/spirv.h"
+
+namespace Magnum { namespace Vk {
+
+namespace {
+
+/* Types, constants and variables are in SPIR-V defined before they're used
+   (except for forward pointer declarations, which aren't interesting here),
+   but a corrupted module could still make the type lookups loop forever. Real
+   shaders don't nest types anywhere close to this. */
+constexpr UnsignedInt MaxTypeDepth = 32;
+
+struct SpirvId {
+    /* Instruction defining the ID, empty if it's not a type, a constant or a
+       variable */
+    Containers::ArrayView<const UnsignedInt> instruction;
+    Containers::Optional<UnsignedInt> set, binding, arrayStride;
+    bool builtIn, block, bufferBlock;
+};
+
+struct SpirvMemberDecoration {
+    UnsignedInt structure;
+    UnsignedInt member;
+    UnsignedInt decoration;
+    UnsignedInt value;
+};
+
+struct SpirvModule {
+    /* Returns an empty view if the ID is out of range or the instruction is
+       not of given op or is too short */
+    Containers::ArrayView<const UnsignedInt> instruction(const UnsignedInt id, const SpvOp op, const std::size_t minSize) const {
+        if(id >= ids.size()) return {};
+        const Containers::ArrayView<const UnsignedInt> instruction = ids[id].instruction;
+        if(instruction.size() < minSize || SpvOp(instruction[0] & 0xffff) != op)
+            return {};
+        return instruction;
+    }
+
+    SpvOp op(const UnsignedInt id) const {
+        if(id >= ids.size() || ids[id].instruction.isEmpty()) return SpvOpNop;
+        return SpvOp(ids[id].instruction[0] & 0xffff);
+    }
+
+    Containers::Optional<UnsignedInt> constant(const UnsignedInt id) const {
+        if(const Containers::ArrayView<const UnsignedInt> constant = instruction(id, SpvOpConstant, 4))
+            return constant[3];
+        /* Specialization constants are taken with their default value */
+        if(const Containers::ArrayView<const UnsignedInt> constant = instruction(id, SpvOpSpecConstant, 4))
+            return constant[3];
+        return {};
+    }
+
+    Containers::Optional<UnsignedInt> memberDecoration(const UnsignedInt structure, const UnsignedInt member, const SpvDecoration decoration) const {
+        for(const SpirvMemberDecoration& i: memberDecorations)
+            if(i.structure == structure && i.member == member && i.decoration == UnsignedInt(decoration))
+                return i.value;
+        return {};
+    }
+
+    Containers::Array<SpirvId> ids;
+    Containers::Array<SpirvMemberDecoration> memberDecorations;
+};
+
+bool parseSpirv(SpirvModule& out, Containers::ArrayView<const UnsignedInt> data, const UnsignedInt bound) {
+    out.ids = Containers::Array<SpirvId>{ValueInit, bound};
+
+    while(!data.isEmpty()) {
+        const UnsignedInt size = data[0] >> 16;
+        if(!size || size > data.size()) return false;
+        const Containers::ArrayView<const UnsignedInt> instruction = data.prefix(size);
+        data = data.exceptPrefix(size);
+
+        switch(SpvOp(instruction[0] & 0xffff)) {
+            case SpvOpDecorate: {
+                if(size < 3 || instruction[1] >= bound) return false;
+                SpirvId& id = out.ids[instruction[1]];
+                switch(instruction[2]) {
+                    case SpvDecorationDescriptorSet:
+                        if(size < 4) return false;
+                        id.set = instruction[3];
+                        break;
+                    case SpvDecorationBinding:
+                        if(size < 4) return false;
+                        id.binding = instruction[3];
+                        break;
+                    case SpvDecorationArrayStride:
+                        if(size < 4) return false;
+                        id.arrayStride = instruction[3];
+                        break;
+                    case SpvDecorationBuiltIn:
+                        id.builtIn = true;
+                        break;
+                    case SpvDecorationBlock:
+                        id.block = true;
+                        break;
+                    case SpvDecorationBufferBlock:
+                        id.bufferBlock = true;
+                        break;
+                }
+            } break;
+
+            case SpvOpMemberDecorate: {
+                if(size < 4 || instruction[1] >= bound) return false;
+                /* A struct with builtin members is the gl_PerVertex block,
+                   treat it the same as a builtin variable */
+                if(instruction[3] == SpvDecorationBuiltIn)
+                    out.ids[instruction[1]].builtIn = true;
+                else if(instruction[3] == SpvDecorationRowMajor)
+                    arrayAppend(out.memberDecorations, InPlaceInit, instruction[1], instruction[2], instruction[3], 0u);
+                else if(instruction[3] == SpvDecorationOffset || instruction[3] == SpvDecorationMatrixStride) {
+                    if(size < 5) return false;
+                    arrayAppend(out.memberDecorations, InPlaceInit, instruction[1], instruction[2], instruction[3], instruction[4]);
+                }
+            } break;
+
+            /* Types have the result ID as the first operand */
+            case SpvOpTypeInt:
+            case SpvOpTypeFloat:
+            case SpvOpTypeVector:
+            case SpvOpTypeMatrix:
+            case SpvOpTypeImage:
+            case SpvOpTypeSampler:
+            case SpvOpTypeSampledImage:
+            case SpvOpTypeArray:
+            case SpvOpTypeRuntimeArray:
+            case SpvOpTypeStruct:
+            case SpvOpTypePointer:
+            case SpvOpTypeAccelerationStructureKHR:
+                if(size < 2 || instruction[1] >= bound) return false;
+                out.ids[instruction[1]].instruction = instruction;
+                break;
+
+            /* Constants and variables have the result type first */
+            case SpvOpConstant:
+            case SpvOpSpecConstant:
+            case SpvOpVariable:
+                if(size < 3 || instruction[2] >= bound) return false;
+                out.ids[instruction[2]].instruction = instruction;
+                break;
+
+            default: break;
+        }
+    }
+
+    return true;
+}
+
+Containers::Optional<ShaderStage> shaderStageForExecutionModel(const SpvExecutionModel model) {
+    switch(model) {
+        case SpvExecutionModelVertex: return ShaderStage::Vertex;
+        case SpvExecutionModelTessellationControl: return ShaderStage::TessellationControl;
+        case SpvExecutionModelTessellationEvaluation: return ShaderStage::TessellationEvaluation;
+        case SpvExecutionModelGeometry: return ShaderStage::Geometry;
+        case SpvExecutionModelFragment: return ShaderStage::Fragment;
+        case SpvExecutionModelGLCompute: return ShaderStage::Compute;
+        case SpvExecutionModelRayGenerationKHR: return ShaderStage::RayGeneration;
+        case SpvExecutionModelIntersectionKHR: return ShaderStage::RayIntersection;
+        case SpvExecutionModelAnyHitKHR: return ShaderStage::RayAnyHit;
+        case SpvExecutionModelClosestHitKHR: return ShaderStage::RayClosestHit;
+        case SpvExecutionModelMissKHR: return ShaderStage::RayMiss;
+        case SpvExecutionModelCallableKHR: return ShaderStage::RayCallable;
+        default: return {};
+    }
+}
+
+/* Returns false if the type isn't something that can be put into a
+   descriptor */
+bool descriptorTypeCount(const SpirvModule& module, UnsignedInt type, const UnsignedInt storageClass, DescriptorType& outType, UnsignedInt& outCount) {
+    /* Unwrap (possibly nested) arrays first */
+    outCount = 1;
+    for(UnsignedInt depth = 0; ; ++depth) {
+        if(depth == MaxTypeDepth) return false;
+
+        if(const Containers::ArrayView<const UnsignedInt> array = module.instruction(type, SpvOpTypeArray, 4)) {
+            const Containers::Optional<UnsignedInt> length = module.constant(array[3]);
+            if(!length) return false;
+            outCount *= *length;
+            type = array[2];
+        } else if(const Containers::ArrayView<const UnsignedInt> array = module.instruction(type, SpvOpTypeRuntimeArray, 3)) {
+            /* The size isn't known until allocation, any outer array
+               doesn't matter */
+            outCount = 0;
+            type = array[2];
+        } else break;
+    }
+
+    switch(module.op(type)) {
+        case SpvOpTypeSampler:
+            outType = DescriptorType::Sampler;
+            return true;
+        case SpvOpTypeSampledImage:
+            outType = DescriptorType::CombinedImageSampler;
+            return true;
+        case SpvOpTypeImage: {
+            /* Result, sampled type, dim, depth, arrayed, MS, sampled,
+               format */
+            const Containers::ArrayView<const UnsignedInt> image = module.instruction(type, SpvOpTypeImage, 9);
+            if(!image) return false;
+            /* Sampled is 1 if used with a sampler, 2 if used without, 0 if
+               known only at runtime, which is only for kernels */
+            const bool storage = image[7] == 2;
+            if(image[3] == SpvDimBuffer)
+                outType = storage ? DescriptorType::StorageTexelBuffer : DescriptorType::UniformTexelBuffer;
+            else if(image[3] == SpvDimSubpassData)
+                outType = DescriptorType::InputAttachment;
+            else
+                outType = storage ? DescriptorType::StorageImage : DescriptorType::SampledImage;
+            return true;
+        }
+        case SpvOpTypeAccelerationStructureKHR:
+            outType = DescriptorType::AccelerationStructure;
+            return true;
+        case SpvOpTypeStruct:
+            if(storageClass == SpvStorageClassUniform && module.ids[type].block) {
+                outType = DescriptorType::UniformBuffer;
+                return true;
+            }
+            /* BufferBlock is the pre-SPIR-V 1.3 way to specify storage
+               buffers */
+            if((storageClass == SpvStorageClassUniform && module.ids[type].bufferBlock) ||
+               (storageClass == SpvStorageClassStorageBuffer && module.ids[type].block)) {
+                outType = DescriptorType::StorageBuffer;
+                return true;
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+/* Size of a type inside a push constant block, calculated from the explicit
+   layout decorations */
+Containers::Optional<UnsignedInt> explicitTypeSize(const SpirvModule& module, const UnsignedInt type, const Containers::Optional<UnsignedInt> matrixStride, const bool rowMajor, const UnsignedInt depth);
+
+Containers::Optional<UnsignedInt> explicitStructSize(const SpirvModule& module, const UnsignedInt type, Containers::Optional<UnsignedInt>* const outMinOffset, const UnsignedInt depth) {
+    const Containers::ArrayView<const UnsignedInt> structure = module.instruction(type, SpvOpTypeStruct, 2);
+    if(!structure) return {};
+
+    UnsignedInt end = 0;
+    for(UnsignedInt i = 0; i != structure.size() - 2; ++i) {
+        const Containers::Optional<UnsignedInt> offset = module.memberDecoration(type, i, SpvDecorationOffset);
+        if(!offset) return {};
+        const Containers::Optional<UnsignedInt> size = explicitTypeSize(module, structure[2 + i], module.memberDecoration(type, i, SpvDecorationMatrixStride), !!module.memberDecoration(type, i, SpvDecorationRowMajor), depth + 1);
+        if(!size) return {};
+
+        end = Math::max(end, *offset + *size);
+        if(outMinOffset && (!*outMinOffset || **outMinOffset > *offset))
+            *outMinOffset = *offset;
+    }
+
+    return end;
+}
+
+Containers::Optional<UnsignedInt> explicitTypeSize(const SpirvModule& module, const UnsignedInt type, const Containers::Optional<UnsignedInt> matrixStride, const bool rowMajor, const UnsignedInt depth) {
+    if(depth == MaxTypeDepth) return {};
+
+    switch(module.op(type)) {
+        case SpvOpTypeInt:
+        case SpvOpTypeFloat: {
+            const Containers::ArrayView<const UnsignedInt> scalar = module.ids[type].instruction;
+            if(scalar.size() < 3) return {};
+            return scalar[2]/8;
+        }
+        case SpvOpTypeVector: {
+            const Containers::ArrayView<const UnsignedInt> vector = module.instruction(type, SpvOpTypeVector, 4);
+            if(!vector) return {};
+            const Containers::Optional<UnsignedInt> componentSize = explicitTypeSize(module, vector[2], {}, false, depth + 1);
+            if(!componentSize) return {};
+            return vector[3]**componentSize;
+        }
+        case SpvOpTypeMatrix: {
+            const Containers::ArrayView<const UnsignedInt> matrix = module.instruction(type, SpvOpTypeMatrix, 4);
+            if(!matrix) return {};
+            const Containers::ArrayView<const UnsignedInt> column = module.instruction(matrix[2], SpvOpTypeVector, 4);
+            if(!column) return {};
+            /* The stride is between columns for column-major matrices and
+               between rows for row-major ones */
+            if(matrixStride)
+                return (rowMajor ? column[3] : matrix[3])**matrixStride;
+            const Containers::Optional<UnsignedInt> columnSize = explicitTypeSize(module, matrix[2], {}, false, depth + 1);
+            if(!columnSize) return {};
+            return matrix[3]**columnSize;
+        }
+        case SpvOpTypeArray: {
+            const Containers::ArrayView<const UnsignedInt> array = module.instruction(type, SpvOpTypeArray, 4);
+            if(!array) return {};
+            const Containers::Optional<UnsignedInt> length = module.constant(array[3]);
+            if(!length) return {};
+            if(module.ids[type].arrayStride)
+                return *length**module.ids[type].arrayStride;
+            const Containers::Optional<UnsignedInt> elementSize = explicitTypeSize(module, array[2], matrixStride, rowMajor, depth + 1);
+            if(!elementSize) return {};
+            return *length**elementSize;
+        }
+        case SpvOpTypeStruct:
+            return explicitStructSize(module, type, nullptr, depth + 1);
+        default:
+            return {};
+    }
+}
+
+/* Appends vertex inputs for given type, splitting arrays and matrices into
+   consecutive locations */
+bool addVertexInputs(const SpirvModule& module, const UnsignedInt type, UnsignedInt& location, Containers::Array<ShaderReflection::VertexInput>& out, const UnsignedInt depth) {
+    if(depth == MaxTypeDepth) return false;
+
+    if(const Containers::ArrayView<const UnsignedInt> array = module.instruction(type, SpvOpTypeArray, 4)) {
+        const Containers::Optional<UnsignedInt> length = module.constant(array[3]);
+        if(!length) return false;
+        for(UnsignedInt i = 0; i != *length; ++i)
+            if(!addVertexInputs(module, array[2], location, out, depth + 1))
+                return false;
+        return true;
+    }
+
+    if(const Containers::ArrayView<const UnsignedInt> matrix = module.instruction(type, SpvOpTypeMatrix, 4)) {
+        for(UnsignedInt i = 0; i != matrix[3]; ++i)
+            if(!addVertexInputs(module, matrix[2], location, out, depth + 1))
+                return false;
+        return true;
+    }
+
+    UnsignedInt scalarType = type;
+    UnsignedInt componentCount = 1;
+    if(const Containers::ArrayView<const UnsignedInt> vector = module.instruction(type, SpvOpTypeVector, 4)) {
+        scalarType = vector[2];
+        componentCount = vector[3];
+        if(componentCount < 1 || componentCount > 4) return false;
+    }
+
+    Containers::Optional<Magnum::VertexFormat> format;
+    UnsignedInt width{};
+    if(const Containers::ArrayView<const UnsignedInt> scalar = module.instruction(scalarType, SpvOpTypeFloat, 3)) {
+        width = scalar[2];
+        if(width == 16) format = Magnum::VertexFormat::Half;
+        else if(width == 32) format = Magnum::VertexFormat::Float;
+        else if(width == 64) format = Magnum::VertexFormat::Double;
+    } else if(const Containers::ArrayView<const UnsignedInt> scalar = module.instruction(scalarType, SpvOpTypeInt, 4)) {
+        width = scalar[2];
+        const bool isSigned = scalar[3] != 0;
+        if(width == 8) format = isSigned ? Magnum::VertexFormat::Byte : Magnum::VertexFormat::UnsignedByte;
+        else if(width == 16) format = isSigned ? Magnum::VertexFormat::Short : Magnum::VertexFormat::UnsignedShort;
+        else if(width == 32) format = isSigned ? Magnum::VertexFormat::Int : Magnum::VertexFormat::UnsignedInt;
+    }
+    if(!format) return false;
+
+    arrayAppend(out, InPlaceInit, location, Magnum::vertexFormat(*format, componentCount, false));
+
+    /* Three- and four-component 64-bit vectors consume two locations */
+    location += width == 64 && componentCount > 2 ? 2 : 1;
+    return true;
+}
+
+}
+
+struct ShaderReflection::State {
+    struct PushConstantStage {
+        ShaderStage stage;
+        UnsignedInt offset;
+        UnsignedInt end;
+    };
+
+    Containers::Array<Binding> bindings;
+    Containers::Array<PushConstantStage> pushConstantStages;
+    Containers::Array<VkPushConstantRange> pushConstantRanges;
+    Containers::Array<VertexInput> vertexInputs;
+};
+
+ShaderReflection::ShaderReflection(): _state{InPlaceInit} {}
+
+ShaderReflection::ShaderReflection(ShaderReflection&&) noexcept = default;
+
+ShaderReflection::~ShaderReflection() = default;
+
+ShaderReflection& ShaderReflection::operator=(ShaderReflection&&) noexcept = default;
+
+bool ShaderReflection::addShader(const ShaderStage stage, const Containers::ArrayView<const void> code, const Containers::StringView entrypoint) {
+    const Containers::ArrayView<const UnsignedInt> spirv = ShaderTools::Implementation::spirvData(code.data(), code.size());
+    if(!spirv) {
+        Error{} << "Vk::ShaderReflection::addShader(): invalid SPIR-V";
+        return false;
+    }
+
+    /* spirvData() validated the header already, the version and ID bound
+       are the second and fourth word of it */
+    const UnsignedInt* const header = static_cast<const UnsignedInt*>(code.data());
+    const UnsignedInt version = header[1];
+    const UnsignedInt bound = header[3];
+
+    /* Find the entrypoint matching both the name and the stage, as a
+       multi-entrypoint module can have the same name for different stages */
+    Containers::Optional<ShaderTools::Implementation::SpirvEntrypoint> found;
+    {
+        Containers::ArrayView<const UnsignedInt> data = spirv;
+        while(Containers::Optional<ShaderTools::Implementation::SpirvEntrypoint> i = ShaderTools::Implementation::spirvNextEntrypoint(data)) {
+            const Containers::Optional<ShaderStage> entrypointStage = shaderStageForExecutionModel(i->executionModel);
+            if(i->name == entrypoint && entrypointStage && *entrypointStage == stage) {
+                found = *i;
+                break;
+            }
+        }
+    }
+    if(!found) {
+        Error{} << "Vk::ShaderReflection::addShader(): no entrypoint named" << entrypoint << "for given stage";
+        return false;
+    }
+
+    SpirvModule module;
+    if(!parseSpirv(module, spirv, bound)) {
+        Error{} << "Vk::ShaderReflection::addShader(): invalid SPIR-V";
+        return false;
+    }
+
+    /* Before SPIR-V 1.4 the entrypoint interface lists only inputs and
+       outputs, so all bindings and push constants in the module have to be
+       assumed to be used by it */
+    const bool interfaceListsAllGlobals = version >= 0x00010400;
+
+    Containers::Array<Binding> bindings;
+    Containers::Optional<UnsignedInt> pushConstantOffset;
+    UnsignedInt pushConstantEnd = 0;
+    for(UnsignedInt id = 0; id != module.ids.size(); ++id) {
+        const Containers::ArrayView<const UnsignedInt> variable = module.instruction(id, SpvOpVariable, 4);
+        if(!variable) continue;
+
+        const UnsignedInt storageClass = variable[3];
+        if(storageClass != SpvStorageClassUniformConstant &&
+           storageClass != SpvStorageClassUniform &&
+           storageClass != SpvStorageClassStorageBuffer &&
+           storageClass != SpvStorageClassPushConstant)
+            continue;
+
+        if(interfaceListsAllGlobals) {
+            bool used = false;
+            for(const UnsignedInt i: found->interfaces) if(i == id) {
+                used = true;
+                break;
+            }
+            if(!used) continue;
+        }
+
+        const Containers::ArrayView<const UnsignedInt> pointer = module.instruction(variable[1], SpvOpTypePointer, 4);
+        if(!pointer) {
+            Error{} << "Vk::ShaderReflection::addShader(): invalid SPIR-V";
+            return false;
+        }
+
+        if(storageClass == SpvStorageClassPushConstant) {
+            Containers::Optional<UnsignedInt> offset;
+            const Containers::Optional<UnsignedInt> end = explicitStructSize(module, pointer[3], &offset, 0);
+            if(!end) {
+                Error{} << "Vk::ShaderReflection::addShader(): can't calculate push constant block size";
+                return false;
+            }
+            /* Empty blocks have no offset */
+            if(!offset) continue;
+
+            /* There's only one push constant block allowed per entrypoint,
+               but pre-1.4 modules with multiple entrypoints can have more */
+            if(!pushConstantOffset || *pushConstantOffset > *offset)
+                pushConstantOffset = *offset;
+            pushConstantEnd = Math::max(pushConstantEnd, *end);
+            continue;
+        }
+
+        /* Uniform variables without a set and binding aren't usable in
+           Vulkan, and those are going to fail elsewhere */
+        const SpirvId& info = module.ids[id];
+        if(!info.set || !info.binding) continue;
+
+        Binding binding{*info.set, *info.binding, {}, {}, stage, {}};
+        if(!descriptorTypeCount(module, pointer[3], storageClass, binding.type, binding.count)) {
+            Error{} << "Vk::ShaderReflection::addShader(): unsupported type of a descriptor at set" << binding.set << "binding" << binding.binding;
+            return false;
+        }
+
+        arrayAppend(bindings, binding);
+    }
+
+    /* Gather vertex inputs */
+    Containers::Array<VertexInput> vertexInputs;
+    if(stage == ShaderStage::Vertex) {
+        Containers::Array<ShaderTools::Implementation::SpirvEntrypointInterface> interface{ValueInit, found->interfaces.size()};
+        ShaderTools::Implementation::spirvEntrypointInterface(spirv, *found, interface);
+        for(std::size_t i = 0; i != interface.size(); ++i) {
+            /* Builtins don't have a location */
+            if(!interface[i].storageClass || *interface[i].storageClass != SpvStorageClassInput || !interface[i].location || found->interfaces[i] >= module.ids.size() || module.ids[found->interfaces[i]].builtIn)
+                continue;
+
+            const Containers::ArrayView<const UnsignedInt> variable = module.instruction(found->interfaces[i], SpvOpVariable, 4);
+            const Containers::ArrayView<const UnsignedInt> pointer = variable ? module.instruction(variable[1], SpvOpTypePointer, 4) : nullptr;
+            UnsignedInt location = *interface[i].location;
+            if(!pointer || !addVertexInputs(module, pointer[3], location, vertexInputs, 0)) {
+                Error{} << "Vk::ShaderReflection::addShader(): unsupported type of a vertex input at location" << *interface[i].location;
+                return false;
+            }
+        }
+    }
+
+    /* Check for conflicts with existing bindings first so the state isn't
+       modified if this fails */
+    State& state = *_state;
+    for(const Binding& binding: bindings) {
+        for(const Binding& existing: state.bindings) {
+            if(existing.set != binding.set || existing.binding != binding.binding)
+                continue;
+            if(existing.type != binding.type || existing.count != binding.count) {
+                Error{} << "Vk::ShaderReflection::addShader(): set" << binding.set << "binding" << binding.binding << "is" << binding.type << "with" << binding.count << "descriptors but was" << existing.type << "with" << existing.count << "descriptors before";
+                return false;
+            }
+        }
+    }
+
+    /* Merge the bindings */
+    for(const Binding& binding: bindings) {
+        Binding* existing = nullptr;
+        for(Binding& i: state.bindings) if(i.set == binding.set && i.binding == binding.binding) {
+            existing = &i;
+            break;
+        }
+        if(existing) existing->stages |= binding.stages;
+        else arrayAppend(state.bindings, binding);
+    }
+    std::sort(state.bindings.begin(), state.bindings.end(), [](const Binding& a, const Binding& b) {
+        return a.set < b.set || (a.set == b.set && a.binding < b.binding);
+    });
+
+    /* Merge the push constant range for this stage and then rebuild the
+       ranges, sharing a range among all stages that use the same bytes */
+    if(pushConstantOffset) {
+        State::PushConstantStage* existing = nullptr;
+        for(State::PushConstantStage& i: state.pushConstantStages) if(i.stage == stage) {
+            existing = &i;
+            break;
+        }
+        if(existing) {
+            existing->offset = Math::min(existing->offset, *pushConstantOffset);
+            existing->end = Math::max(existing->end, pushConstantEnd);
+        } else arrayAppend(state.pushConstantStages, InPlaceInit, stage, *pushConstantOffset, pushConstantEnd);
+
+        arrayResize(state.pushConstantRanges, 0);
+        for(const State::PushConstantStage& i: state.pushConstantStages) {
+            VkPushConstantRange* range = nullptr;
+            for(VkPushConstantRange& j: state.pushConstantRanges) if(j.offset == i.offset && j.size == i.end - i.offset) {
+                range = &j;
+                break;
+            }
+            if(range) range->stageFlags |= VkShaderStageFlags(i.stage);
+            else arrayAppend(state.pushConstantRanges, InPlaceInit, VkShaderStageFlags(i.stage), i.offset, i.end - i.offset);
+        }
+        std::sort(state.pushConstantRanges.begin(), state.pushConstantRanges.end(), [](const VkPushConstantRange& a, const VkPushConstantRange& b) {
+            return a.offset < b.offset || (a.offset == b.offset && a.size < b.size);
+        });
+    }
+
+    /* There's just one vertex stage in a pipeline, so replace what was there
+       before */
+    if(stage == ShaderStage::Vertex) {
+        std::sort(vertexInputs.begin(), vertexInputs.end(), [](const VertexInput& a, const VertexInput& b) {
+            return a.location < b.location;
+        });
+        state.vertexInputs = Utility::move(vertexInputs);
+    }
+
+    return true;
+}
+
+Containers::ArrayView<ShaderReflection::Binding> ShaderReflection::bindings() {
+    return _state->bindings;
+}
+
+Containers::ArrayView<const ShaderReflection::Binding> ShaderReflection::bindings() const {
+    return _state->bindings;
+}
+
+UnsignedInt ShaderReflection::descriptorSetCount() const {
+    /* The bindings are sorted by set, so it's enough to check the last */
+    return _state->bindings.isEmpty() ? 0 : _state->bindings.back().set + 1;
+}
+
+Containers::ArrayView<const VkPushConstantRange> ShaderReflection::pushConstantRanges() const {
+    return _state->pushConstantRanges;
+}
+
+Containers::ArrayView<const ShaderReflection::VertexInput> ShaderReflection::vertexInputs() const {
+    return _state->vertexInputs;
+}
+
+DescriptorSetLayoutCreateInfo ShaderReflection::descriptorSetLayoutCreateInfo(const UnsignedInt set) const {
+    CORRADE_ASSERT(set < descriptorSetCount(),
+        "Vk::ShaderReflection::descriptorSetLayoutCreateInfo(): index" << set << "out of range for" << descriptorSetCount() << "descriptor sets", DescriptorSetLayoutCreateInfo{NoInit});
+
+    Containers::Array<DescriptorSetLayoutBinding> bindings;
+    for(const Binding& binding: _state->bindings) {
+        if(binding.set != set) continue;
+        arrayAppend(bindings, InPlaceInit, binding.binding, binding.type, binding.count, binding.stages, DescriptorSetLayoutBinding::Flags{DescriptorSetLayoutBinding::Flag(binding.flags)});
+    }
+
+    return DescriptorSetLayoutCreateInfo{Containers::arrayView(bindings)};
+}
+
+MeshLayout ShaderReflection::meshLayout(const MeshPrimitive primitive) const {
+    MeshLayout out{primitive};
+    for(const VertexInput& input: _state->vertexInputs)
+        out.addBinding(input.location, Magnum::vertexFormatSize(input.format));
+    for(const VertexInput& input: _state->vertexInputs)
+        out.addAttribute(input.location, input.location, input.format, 0);
+    return out;
+}
+
+MeshLayout ShaderReflection::meshLayout(const Magnum::MeshPrimitive primitive) const {
+    return meshLayout(meshPrimitive(primitive));
+}
+
+}}
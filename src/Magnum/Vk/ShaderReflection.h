@@ -0,0 +1,280 @@
+#ifndef Magnum_Vk_ShaderReflection_h
+#define Magnum_Vk_ShaderReflection_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::ShaderReflection
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Shader reflection
+@m_since_latest
+
+Extracts descriptor set bindings, push constant ranges and vertex inputs from
+SPIR-V shader modules, merges them across all stages of a pipeline and creates
+a @ref DescriptorSetLayoutCreateInfo, a @type_vk{PushConstantRange} list and a
+@ref MeshLayout from them, so they don't need to be kept in sync with the
+shader code by hand.
+
+@section Vk-ShaderReflection-usage Usage
+
+Call @ref addShader() with SPIR-V code of every stage in the pipeline. The
+binary is only parsed, it doesn't need to outlive the call and the
+@ref Shader itself doesn't need to be created from it yet. Then, either create
+the layouts directly from @ref descriptorSetLayoutCreateInfo() and
+@ref pushConstantRanges(), or pass the reflection to
+@ref LayoutCache::pipelineLayout(const ShaderReflection&), which creates every
+distinct descriptor set layout and pipeline layout just once no matter how many
+pipelines use it:
+
+@snippet Vk.cpp ShaderReflection-usage
+
+@section Vk-ShaderReflection-bindings Descriptor bindings
+
+For each variable decorated with a `DescriptorSet` and `Binding`, a
+@ref Binding entry is produced, with the @ref DescriptorType derived from the
+variable type and storage class as shown below. Arrays of descriptors,
+including arrays of arrays, get @ref Binding::count set to the total element
+count. Runtime-sized arrays have the count set to @cpp 0 @ce, as its upper
+bound isn't known from the shader. A binding accessed from more than one stage
+has all the stages in @ref Binding::stages. If two stages declare the same
+binding with a different type or count, @ref addShader() fails.
+
+-   `OpTypeSampler` is a @ref DescriptorType::Sampler
+-   `OpTypeSampledImage` is a @ref DescriptorType::CombinedImageSampler
+-   `OpTypeImage` with a `Buffer` dimension is a
+    @ref DescriptorType::UniformTexelBuffer or, if it's not sampled, a
+    @ref DescriptorType::StorageTexelBuffer
+-   `OpTypeImage` with a `SubpassData` dimension is a
+    @ref DescriptorType::InputAttachment
+-   other `OpTypeImage` is a @ref DescriptorType::SampledImage or, if it's not
+    sampled, a @ref DescriptorType::StorageImage
+-   `OpTypeAccelerationStructureKHR` is a
+    @ref DescriptorType::AccelerationStructure
+-   a `Block` in the `Uniform` storage class is a
+    @ref DescriptorType::UniformBuffer
+-   a `BufferBlock` in the `Uniform` storage class or a `Block` in the
+    `StorageBuffer` storage class is a @ref DescriptorType::StorageBuffer
+
+Whether a buffer should be dynamic, what's the upper bound of a runtime-sized
+array or whether a binding should have any
+@ref DescriptorSetLayoutBinding::Flags can't be inferred from the SPIR-V. Use
+@ref bindings() to patch the reflected data before creating the layouts in
+that case:
+
+@snippet Vk.cpp ShaderReflection-usage-dynamic
+
+@section Vk-ShaderReflection-push-constants Push constants
+
+The size of a push constant block is calculated from the `Offset`,
+`ArrayStride` and `MatrixStride` decorations of its members, the range starts
+at the first member offset. Stages that use the exact same range share a
+single @type_vk{PushConstantRange}, otherwise there's a range for each stage,
+which satisfies the Vulkan requirement of each stage being in at most one
+range.
+
+@section Vk-ShaderReflection-vertex-inputs Vertex inputs
+
+Non-builtin `Input` variables of a @ref ShaderStage::Vertex entrypoint are
+reported in @ref vertexInputs(). Vectors and scalars of 16-, 32- and 64-bit
+floats and 8-, 16- and 32-bit integers are supported, matrices and arrays are
+split into one input for each column or element on consecutive locations.
+Since the buffer layout isn't known from the shader, @ref meshLayout() puts
+each input into a separate binding --- if you have interleaved attributes,
+create the @ref MeshLayout by hand using the reflected formats.
+
+@section Vk-ShaderReflection-entrypoints Multiple entrypoints
+
+Entrypoints in SPIR-V 1.4 and newer list all global variables they use, so
+only bindings and push constants used by the entrypoint passed to
+@ref addShader() are added. With earlier versions the interface lists only
+inputs and outputs, so all bindings and push constants present in the module
+are conservatively assumed to be used by the entrypoint.
+*/
+class MAGNUM_VK_EXPORT ShaderReflection {
+    public:
+        /**
+         * @brief Descriptor binding
+         *
+         * @see @ref bindings()
+         */
+        struct Binding {
+            /** @brief Descriptor set */
+            UnsignedInt set;
+
+            /** @brief Binding index in the set */
+            UnsignedInt binding;
+
+            /** @brief Descriptor type */
+            DescriptorType type;
+
+            /**
+             * @brief Descriptor count
+             *
+             * @cpp 1 @ce for non-arrays, @cpp 0 @ce for runtime-sized arrays.
+             */
+            UnsignedInt count;
+
+            /** @brief Stages accessing the binding */
+            ShaderStages stages;
+
+            /**
+             * @brief Binding flags
+             *
+             * A @ref DescriptorSetLayoutBinding::Flags value. Never set by the
+             * reflection itself, meant to be filled by the user if needed.
+             */
+            VkDescriptorBindingFlags flags;
+        };
+
+        /**
+         * @brief Vertex input
+         *
+         * @see @ref vertexInputs()
+         */
+        struct VertexInput {
+            /** @brief Location */
+            UnsignedInt location;
+
+            /** @brief Format */
+            Magnum::VertexFormat format;
+        };
+
+        /**
+         * @brief Constructor
+         *
+         * Creates an empty reflection, call @ref addShader() to fill it.
+         */
+        explicit ShaderReflection();
+
+        /** @brief Copying is not allowed */
+        ShaderReflection(const ShaderReflection&) = delete;
+
+        /** @brief Move constructor */
+        ShaderReflection(ShaderReflection&&) noexcept;
+
+        /** @brief Destructor */
+        ~ShaderReflection();
+
+        /** @brief Copying is not allowed */
+        ShaderReflection& operator=(const ShaderReflection&) = delete;
+
+        /** @brief Move assignment */
+        ShaderReflection& operator=(ShaderReflection&&) noexcept;
+
+        /**
+         * @brief Add a shader
+         * @param stage         Shader stage
+         * @param code          SPIR-V code
+         * @param entrypoint    Entrypoint name
+         *
+         * Merges bindings, push constants and, for
+         * @ref ShaderStage::Vertex, vertex inputs of given entrypoint into
+         * the reflection. If @p code isn't a valid SPIR-V, the entrypoint
+         * isn't found, its execution model doesn't match @p stage or a
+         * binding conflicts with what was added before, prints a message to
+         * @relativeref{Magnum,Error} and returns @cpp false @ce, leaving the
+         * reflection unchanged.
+         */
+        bool addShader(ShaderStage stage, Containers::ArrayView<const void> code, Containers::StringView entrypoint);
+
+        /**
+         * @brief Descriptor bindings
+         *
+         * Sorted by @ref Binding::set and @ref Binding::binding. The mutable
+         * overload allows patching the properties that can't be inferred from
+         * SPIR-V, such as a dynamic buffer type, see
+         * @ref Vk-ShaderReflection-bindings for an example.
+         */
+        Containers::ArrayView<Binding> bindings();
+        /** @overload */
+        Containers::ArrayView<const Binding> bindings() const;
+
+        /**
+         * @brief Descriptor set count
+         *
+         * One more than the highest @ref Binding::set, or @cpp 0 @ce if
+         * there are no bindings. Sets in between that have no bindings are
+         * counted as well, as they still need a (empty) layout in the
+         * pipeline layout.
+         */
+        UnsignedInt descriptorSetCount() const;
+
+        /**
+         * @brief Push constant ranges
+         *
+         * Sorted by offset. See @ref Vk-ShaderReflection-push-constants for
+         * more information.
+         */
+        Containers::ArrayView<const VkPushConstantRange> pushConstantRanges() const;
+
+        /**
+         * @brief Vertex inputs
+         *
+         * Sorted by @ref VertexInput::location.
+         */
+        Containers::ArrayView<const VertexInput> vertexInputs() const;
+
+        /**
+         * @brief Descriptor set layout create info
+         *
+         * Contains all @ref bindings() with @p set. Expects that @p set is
+         * less than @ref descriptorSetCount(). The returned instance is
+         * self-contained and doesn't reference the reflection in any way.
+         */
+        DescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo(UnsignedInt set) const;
+
+        /**
+         * @brief Mesh layout
+         *
+         * Each of @ref vertexInputs() is added to a separate binding of the
+         * same index as its location with a stride matching the input size.
+         */
+        MeshLayout meshLayout(MeshPrimitive primitive) const;
+
+        /** @overload */
+        MeshLayout meshLayout(Magnum::MeshPrimitive primitive) const;
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -0,0 +1,192 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Vk/Implementation/BuddyAllocator.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct BuddyAllocatorTest: TestSuite::Tester {
+    explicit BuddyAllocatorTest();
+
+    void construct();
+
+    void allocate();
+    void allocateAlignment();
+    void allocateTooLarge();
+    void allocateFull();
+
+    void free();
+    void freeCoalesce();
+    void freeReuse();
+
+    void largestFreeSize();
+};
+
+BuddyAllocatorTest::BuddyAllocatorTest() {
+    addTests({&BuddyAllocatorTest::construct,
+
+              &BuddyAllocatorTest::allocate,
+              &BuddyAllocatorTest::allocateAlignment,
+              &BuddyAllocatorTest::allocateTooLarge,
+              &BuddyAllocatorTest::allocateFull,
+
+              &BuddyAllocatorTest::free,
+              &BuddyAllocatorTest::freeCoalesce,
+              &BuddyAllocatorTest::freeReuse,
+
+              &BuddyAllocatorTest::largestFreeSize});
+}
+
+using Implementation::BuddyAllocator;
+
+void BuddyAllocatorTest::construct() {
+    BuddyAllocator a{4096, 256};
+    CORRADE_COMPARE(a.size(), 4096);
+    CORRADE_COMPARE(a.minSize(), 256);
+    CORRADE_COMPARE(a.freeSize(), 4096);
+    CORRADE_COMPARE(a.largestFreeSize(), 4096);
+    CORRADE_VERIFY(a.isEmpty());
+}
+
+void BuddyAllocatorTest::allocate() {
+    BuddyAllocator a{4096, 256};
+
+    /* Rounded up to the min size */
+    CORRADE_COMPARE(a.allocate(17, 1), 0);
+    CORRADE_COMPARE(a.freeSize(), 4096 - 256);
+    CORRADE_VERIFY(!a.isEmpty());
+
+    /* Rounded up to a power of two, placed after the first allocation's
+       buddy */
+    CORRADE_COMPARE(a.allocate(300, 1), 512);
+    CORRADE_COMPARE(a.freeSize(), 4096 - 256 - 512);
+
+    /* Fills the remaining buddy of the first allocation */
+    CORRADE_COMPARE(a.allocate(256, 1), 256);
+    CORRADE_COMPARE(a.freeSize(), 4096 - 256 - 512 - 256);
+}
+
+void BuddyAllocatorTest::allocateAlignment() {
+    BuddyAllocator a{4096, 256};
+
+    CORRADE_COMPARE(a.allocate(256, 1), 0);
+
+    /* A small allocation with a large alignment occupies a node of the
+       alignment size */
+    CORRADE_COMPARE(a.nodeSize(16, 1024), 1024);
+    CORRADE_COMPARE(a.allocate(16, 1024), 1024);
+    CORRADE_COMPARE(a.freeSize(), 4096 - 256 - 1024);
+}
+
+void BuddyAllocatorTest::allocateTooLarge() {
+    BuddyAllocator a{4096, 256};
+    CORRADE_COMPARE(a.allocate(4097, 1), Containers::NullOpt);
+    CORRADE_COMPARE(a.allocate(16, 8192), Containers::NullOpt);
+    CORRADE_VERIFY(a.isEmpty());
+}
+
+void BuddyAllocatorTest::allocateFull() {
+    BuddyAllocator a{1024, 256};
+    CORRADE_COMPARE(a.allocate(256, 1), 0);
+    CORRADE_COMPARE(a.allocate(256, 1), 256);
+    CORRADE_COMPARE(a.allocate(256, 1), 512);
+    CORRADE_COMPARE(a.allocate(256, 1), 768);
+    CORRADE_COMPARE(a.freeSize(), 0);
+    CORRADE_COMPARE(a.largestFreeSize(), 0);
+    CORRADE_COMPARE(a.allocate(1, 1), Containers::NullOpt);
+}
+
+void BuddyAllocatorTest::free() {
+    BuddyAllocator a{4096, 256};
+    CORRADE_COMPARE(a.allocate(256, 1), 0);
+    CORRADE_COMPARE(a.allocate(1000, 1), 1024);
+
+    CORRADE_COMPARE(a.free(1024), 1024);
+    CORRADE_COMPARE(a.freeSize(), 4096 - 256);
+    CORRADE_COMPARE(a.free(0), 256);
+    CORRADE_COMPARE(a.freeSize(), 4096);
+    CORRADE_VERIFY(a.isEmpty());
+}
+
+void BuddyAllocatorTest::freeCoalesce() {
+    BuddyAllocator a{1024, 256};
+    CORRADE_COMPARE(a.allocate(256, 1), 0);
+    CORRADE_COMPARE(a.allocate(256, 1), 256);
+    CORRADE_COMPARE(a.allocate(256, 1), 512);
+    CORRADE_COMPARE(a.allocate(256, 1), 768);
+
+    /* Freeing non-buddies doesn't coalesce */
+    a.free(256);
+    a.free(512);
+    CORRADE_COMPARE(a.freeSize(), 512);
+    CORRADE_COMPARE(a.largestFreeSize(), 256);
+    CORRADE_COMPARE(a.allocate(512, 1), Containers::NullOpt);
+
+    /* Freeing a buddy merges it into a larger node */
+    a.free(0);
+    CORRADE_COMPARE(a.largestFreeSize(), 512);
+    CORRADE_COMPARE(a.allocate(512, 1), 0);
+    a.free(0);
+
+    /* And freeing the last merges everything */
+    a.free(768);
+    CORRADE_COMPARE(a.largestFreeSize(), 1024);
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_COMPARE(a.allocate(1024, 1), 0);
+}
+
+void BuddyAllocatorTest::freeReuse() {
+    BuddyAllocator a{131072, 256};
+
+    /* Repeated allocation and deallocation in a pattern shouldn't leak any
+       space */
+    for(std::size_t iteration = 0; iteration != 10; ++iteration) {
+        UnsignedLong offsets[32];
+        for(std::size_t i = 0; i != 32; ++i) {
+            Containers::Optional<UnsignedLong> offset = a.allocate(256 + i*37, 1);
+            CORRADE_VERIFY(offset);
+            offsets[i] = *offset;
+        }
+        for(std::size_t i = 0; i != 32; i += 2) a.free(offsets[i]);
+        for(std::size_t i = 1; i < 32; i += 2) a.free(offsets[i]);
+        CORRADE_VERIFY(a.isEmpty());
+    }
+
+    CORRADE_COMPARE(a.largestFreeSize(), 131072);
+}
+
+void BuddyAllocatorTest::largestFreeSize() {
+    BuddyAllocator a{4096, 256};
+    CORRADE_COMPARE(a.allocate(256, 1), 0);
+    /* The remaining space is split into 256 + 512 + 1024 + 2048 */
+    CORRADE_COMPARE(a.freeSize(), 3840);
+    CORRADE_COMPARE(a.largestFreeSize(), 2048);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::BuddyAllocatorTest)
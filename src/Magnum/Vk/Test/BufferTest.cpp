@@ -44,6 +44,7 @@ struct BufferTest: TestSuite::Tester {
     void constructCopy();
 
     void dedicatedMemoryNotDedicated();
+    void allocationNotAllocated();
 
     /* While *ConstructFromVk() tests that going from VkFromThing -> Vk::Thing
        -> VkToThing doesn't result in information loss, the *ConvertToVk()
@@ -72,6 +73,7 @@ BufferTest::BufferTest() {
               &BufferTest::constructCopy,
 
               &BufferTest::dedicatedMemoryNotDedicated,
+              &BufferTest::allocationNotAllocated,
 
               &BufferTest::bufferCopyConstruct,
               &BufferTest::bufferCopyConstructNoInit,
@@ -161,6 +163,18 @@ void BufferTest::dedicatedMemoryNotDedicated() {
     CORRADE_COMPARE(out.str(), "Vk::Buffer::dedicatedMemory(): buffer doesn't have a dedicated memory\n");
 }
 
+void BufferTest::allocationNotAllocated() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Buffer buffer{NoCreate};
+    CORRADE_VERIFY(!buffer.hasAllocation());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    buffer.allocation();
+    CORRADE_COMPARE(out.str(), "Vk::Buffer::allocation(): buffer doesn't have memory from an allocator\n");
+}
+
 void BufferTest::bufferCopyConstruct() {
     BufferCopy copy{3, 5, 7};
     CORRADE_COMPARE(copy->srcOffset, 3);
@@ -33,7 +33,14 @@ namespace Magnum { namespace Vk { namespace Test { namespace {
 struct CommandBufferTest: TestSuite::Tester {
     explicit CommandBufferTest();
 
+    void inheritanceInfoConstruct();
+    void inheritanceInfoConstructOutsideRenderPass();
+    void inheritanceInfoConstructNoInit();
+    void inheritanceInfoConstructFromVk();
+
     void beginInfoConstruct();
+    void beginInfoConstructInheritance();
+    void beginInfoConstructInheritanceOutsideRenderPass();
     void beginInfoConstructNoInit();
     void beginInfoConstructFromVk();
 
@@ -42,7 +49,14 @@ struct CommandBufferTest: TestSuite::Tester {
 };
 
 CommandBufferTest::CommandBufferTest() {
-    addTests({&CommandBufferTest::beginInfoConstruct,
+    addTests({&CommandBufferTest::inheritanceInfoConstruct,
+              &CommandBufferTest::inheritanceInfoConstructOutsideRenderPass,
+              &CommandBufferTest::inheritanceInfoConstructNoInit,
+              &CommandBufferTest::inheritanceInfoConstructFromVk,
+
+              &CommandBufferTest::beginInfoConstruct,
+              &CommandBufferTest::beginInfoConstructInheritance,
+              &CommandBufferTest::beginInfoConstructInheritanceOutsideRenderPass,
               &CommandBufferTest::beginInfoConstructNoInit,
               &CommandBufferTest::beginInfoConstructFromVk,
 
@@ -50,9 +64,67 @@ CommandBufferTest::CommandBufferTest() {
               &CommandBufferTest::constructCopy});
 }
 
+void CommandBufferTest::inheritanceInfoConstruct() {
+    auto renderPass = reinterpret_cast<VkRenderPass>(reinterpret_cast<void*>(std::size_t{0xdead}));
+    auto framebuffer = reinterpret_cast<VkFramebuffer>(reinterpret_cast<void*>(std::size_t{0xbeef}));
+
+    CommandBufferInheritanceInfo info{renderPass, 3, framebuffer};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO);
+    CORRADE_COMPARE(info->renderPass, renderPass);
+    CORRADE_COMPARE(info->subpass, 3);
+    CORRADE_COMPARE(info->framebuffer, framebuffer);
+}
+
+void CommandBufferTest::inheritanceInfoConstructOutsideRenderPass() {
+    CommandBufferInheritanceInfo info;
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO);
+    CORRADE_VERIFY(!info->renderPass);
+    CORRADE_COMPARE(info->subpass, 0);
+    CORRADE_VERIFY(!info->framebuffer);
+}
+
+void CommandBufferTest::inheritanceInfoConstructNoInit() {
+    CommandBufferInheritanceInfo info{NoInit};
+    info->sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    new(&info) CommandBufferInheritanceInfo{NoInit};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<CommandBufferInheritanceInfo, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, CommandBufferInheritanceInfo>::value);
+}
+
+void CommandBufferTest::inheritanceInfoConstructFromVk() {
+    VkCommandBufferInheritanceInfo vkInfo;
+    vkInfo.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+
+    CommandBufferInheritanceInfo info{vkInfo};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+}
+
 void CommandBufferTest::beginInfoConstruct() {
     CommandBufferBeginInfo info{CommandBufferBeginInfo::Flag::OneTimeSubmit};
     CORRADE_COMPARE(info->flags, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    CORRADE_VERIFY(!info->pInheritanceInfo);
+}
+
+void CommandBufferTest::beginInfoConstructInheritance() {
+    CommandBufferInheritanceInfo inheritanceInfo{reinterpret_cast<VkRenderPass>(reinterpret_cast<void*>(std::size_t{0xdead})), 1};
+
+    /* RenderPassContinue is added implicitly */
+    CommandBufferBeginInfo info{inheritanceInfo, CommandBufferBeginInfo::Flag::OneTimeSubmit};
+    CORRADE_COMPARE(info->flags, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT|VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT);
+    CORRADE_COMPARE(info->pInheritanceInfo, &*inheritanceInfo);
+}
+
+void CommandBufferTest::beginInfoConstructInheritanceOutsideRenderPass() {
+    CommandBufferInheritanceInfo inheritanceInfo;
+
+    /* No render pass, so RenderPassContinue isn't added */
+    CommandBufferBeginInfo info{inheritanceInfo, CommandBufferBeginInfo::Flag::SimultaneousUse};
+    CORRADE_COMPARE(info->flags, VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT);
+    CORRADE_COMPARE(info->pInheritanceInfo, &*inheritanceInfo);
 }
 
 void CommandBufferTest::beginInfoConstructNoInit() {
@@ -23,10 +23,19 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Vk/BufferCreateInfo.h"
 #include "Magnum/Vk/CommandBuffer.h"
 #include "Magnum/Vk/CommandPoolCreateInfo.h"
 #include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Fence.h"
 #include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/Queue.h"
 #include "Magnum/Vk/Result.h"
 #include "Magnum/Vk/VulkanTester.h"
 
@@ -42,8 +51,13 @@ struct CommandBufferVkTest: VulkanTester {
     void reset();
 
     void beginEnd();
+    void beginEndSecondary();
+
+    void executeCommands();
 };
 
+using namespace Containers::Literals;
+
 CommandBufferVkTest::CommandBufferVkTest() {
     addTests({&CommandBufferVkTest::construct,
               &CommandBufferVkTest::constructMove,
@@ -51,7 +65,10 @@ CommandBufferVkTest::CommandBufferVkTest() {
 
               &CommandBufferVkTest::reset,
 
-              &CommandBufferVkTest::beginEnd});
+              &CommandBufferVkTest::beginEnd,
+              &CommandBufferVkTest::beginEndSecondary,
+
+              &CommandBufferVkTest::executeCommands});
 }
 
 void CommandBufferVkTest::construct() {
@@ -140,6 +157,48 @@ void CommandBufferVkTest::beginEnd() {
     CORRADE_VERIFY(true);
 }
 
+void CommandBufferVkTest::beginEndSecondary() {
+    CommandPool pool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+
+    pool.allocate(CommandBufferLevel::Secondary)
+        .begin(CommandBufferBeginInfo{CommandBufferInheritanceInfo{}})
+        .end();
+
+    /* Does not do anything visible, so just test that it didn't blow up */
+    CORRADE_VERIFY(true);
+}
+
+void CommandBufferVkTest::executeCommands() {
+    CommandPool pool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+
+    Buffer buffer{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 16
+    }, MemoryFlag::HostVisible};
+    Utility::copy("0123456789abcdef"_s, buffer.dedicatedMemory().map());
+
+    /* Each secondary command buffer fills a different part of the buffer */
+    CommandBuffer a = pool.allocate(CommandBufferLevel::Secondary);
+    a.begin(CommandBufferBeginInfo{CommandBufferInheritanceInfo{}})
+     .fillBuffer(buffer, 2, 4, 0x2e2e2e2e)
+     .end();
+    CommandBuffer b = pool.allocate(CommandBufferLevel::Secondary);
+    b.begin(CommandBufferBeginInfo{CommandBufferInheritanceInfo{}})
+     .fillBuffer(buffer, 10, 4, 0x2d2d2d2d)
+     .end();
+
+    CommandBuffer cmd = pool.allocate();
+    cmd.begin()
+       .executeCommands({a, b})
+       .pipelineBarrier(PipelineStage::Transfer, PipelineStage::Host, {
+           {Access::TransferWrite, Access::HostRead}
+        }, {}, {})
+       .end();
+    queue().submit({SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+    CORRADE_COMPARE(arrayView(buffer.dedicatedMemory().mapRead()), "01....6789----ef"_s);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Vk::Test::CommandBufferVkTest)
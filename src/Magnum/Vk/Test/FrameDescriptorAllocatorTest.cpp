@@ -0,0 +1,184 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/DescriptorType.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/Fence.h"
+#include "Magnum/Vk/FrameDescriptorAllocator.h"
+#include "Magnum/Vk/Image.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct FrameDescriptorAllocatorTest: TestSuite::Tester {
+    explicit FrameDescriptorAllocatorTest();
+
+    void writeConstructBuffer();
+    void writeConstructImage();
+    void writeConstructSampler();
+    void writeConstructInvalidType();
+
+    void constructNoCreate();
+    void constructInvalid();
+    void constructCopy();
+
+    void noPools();
+};
+
+FrameDescriptorAllocatorTest::FrameDescriptorAllocatorTest() {
+    addTests({&FrameDescriptorAllocatorTest::writeConstructBuffer,
+              &FrameDescriptorAllocatorTest::writeConstructImage,
+              &FrameDescriptorAllocatorTest::writeConstructSampler,
+              &FrameDescriptorAllocatorTest::writeConstructInvalidType,
+
+              &FrameDescriptorAllocatorTest::constructNoCreate,
+              &FrameDescriptorAllocatorTest::constructInvalid,
+              &FrameDescriptorAllocatorTest::constructCopy,
+
+              &FrameDescriptorAllocatorTest::noPools});
+}
+
+void FrameDescriptorAllocatorTest::writeConstructBuffer() {
+    DescriptorWrite write{3, DescriptorType::UniformBufferDynamic, reinterpret_cast<VkBuffer>(reinterpret_cast<void*>(std::size_t{0xdead})), 256, 64};
+    CORRADE_COMPARE(write.binding(), 3);
+    CORRADE_COMPARE(write.arrayElement(), 0);
+    CORRADE_COMPARE(write.type(), DescriptorType::UniformBufferDynamic);
+    CORRADE_COMPARE(write.buffer(), reinterpret_cast<VkBuffer>(reinterpret_cast<void*>(std::size_t{0xdead})));
+    CORRADE_COMPARE(write.offset(), 256);
+    CORRADE_COMPARE(write.range(), 64);
+    CORRADE_COMPARE(write.imageView(), VkImageView{});
+    CORRADE_COMPARE(write.imageLayout(), ImageLayout::Undefined);
+    CORRADE_COMPARE(write.sampler(), VkSampler{});
+
+    DescriptorWrite whole{0, DescriptorType::StorageBuffer, reinterpret_cast<VkBuffer>(reinterpret_cast<void*>(std::size_t{0xdead}))};
+    CORRADE_COMPARE(whole.offset(), 0);
+    CORRADE_COMPARE(whole.range(), VK_WHOLE_SIZE);
+}
+
+void FrameDescriptorAllocatorTest::writeConstructImage() {
+    DescriptorWrite write{1, DescriptorType::CombinedImageSampler, reinterpret_cast<VkImageView>(reinterpret_cast<void*>(std::size_t{0xbeef})), ImageLayout::ShaderReadOnly, reinterpret_cast<VkSampler>(reinterpret_cast<void*>(std::size_t{0xcafe}))};
+    write.setArrayElement(5);
+    CORRADE_COMPARE(write.binding(), 1);
+    CORRADE_COMPARE(write.arrayElement(), 5);
+    CORRADE_COMPARE(write.type(), DescriptorType::CombinedImageSampler);
+    CORRADE_COMPARE(write.buffer(), VkBuffer{});
+    CORRADE_COMPARE(write.offset(), 0);
+    CORRADE_COMPARE(write.range(), 0);
+    CORRADE_COMPARE(write.imageView(), reinterpret_cast<VkImageView>(reinterpret_cast<void*>(std::size_t{0xbeef})));
+    CORRADE_COMPARE(write.imageLayout(), ImageLayout::ShaderReadOnly);
+    CORRADE_COMPARE(write.sampler(), reinterpret_cast<VkSampler>(reinterpret_cast<void*>(std::size_t{0xcafe})));
+}
+
+void FrameDescriptorAllocatorTest::writeConstructSampler() {
+    DescriptorWrite write{2, reinterpret_cast<VkSampler>(reinterpret_cast<void*>(std::size_t{0xcafe}))};
+    CORRADE_COMPARE(write.binding(), 2);
+    CORRADE_COMPARE(write.type(), DescriptorType::Sampler);
+    CORRADE_COMPARE(write.buffer(), VkBuffer{});
+    CORRADE_COMPARE(write.imageView(), VkImageView{});
+    CORRADE_COMPARE(write.sampler(), reinterpret_cast<VkSampler>(reinterpret_cast<void*>(std::size_t{0xcafe})));
+}
+
+void FrameDescriptorAllocatorTest::writeConstructInvalidType() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    DescriptorWrite{0, DescriptorType::SampledImage, VkBuffer{}};
+    DescriptorWrite{0, DescriptorType::UniformTexelBuffer, VkBuffer{}};
+    DescriptorWrite{0, DescriptorType::UniformBuffer, VkImageView{}, ImageLayout::General};
+    CORRADE_COMPARE(out.str(),
+        "Vk::DescriptorWrite: expected a buffer descriptor type but got Vk::DescriptorType::SampledImage\n"
+        "Vk::DescriptorWrite: expected a buffer descriptor type but got Vk::DescriptorType::UniformTexelBuffer\n"
+        "Vk::DescriptorWrite: expected an image descriptor type but got Vk::DescriptorType::UniformBuffer\n");
+}
+
+void FrameDescriptorAllocatorTest::constructNoCreate() {
+    {
+        FrameDescriptorAllocator allocator{NoCreate};
+        CORRADE_COMPARE(allocator.frameCount(), 0);
+        CORRADE_COMPARE(allocator.frame(), 0);
+        CORRADE_COMPARE(allocator.poolCount(), 0);
+        CORRADE_COMPARE(allocator.setCount(), 0);
+        CORRADE_COMPARE(allocator.cacheHitCount(), 0);
+        CORRADE_COMPARE(allocator.cacheMissCount(), 0);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, FrameDescriptorAllocator>::value);
+}
+
+void FrameDescriptorAllocatorTest::constructInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    /* The device is never accessed, so NoCreate is fine */
+    Device device{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FrameDescriptorAllocator{device, 0, 16, {{DescriptorType::UniformBuffer, 16}}};
+    FrameDescriptorAllocator{device, 3, 0, {{DescriptorType::UniformBuffer, 16}}};
+    FrameDescriptorAllocator{device, 3, 16, {}};
+    FrameDescriptorAllocator{device, 3, 16, {
+        {DescriptorType::UniformBuffer, 16},
+        {DescriptorType::CombinedImageSampler, 0}
+    }};
+    CORRADE_COMPARE(out.str(),
+        "Vk::FrameDescriptorAllocator: expected non-zero frame and set count but got 0 and 16\n"
+        "Vk::FrameDescriptorAllocator: expected non-zero frame and set count but got 3 and 0\n"
+        "Vk::FrameDescriptorAllocator: there has to be at least one pool size\n"
+        "Vk::FrameDescriptorAllocator: pool size 1 of Vk::DescriptorType::CombinedImageSampler has no descriptors\n");
+}
+
+void FrameDescriptorAllocatorTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<FrameDescriptorAllocator>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<FrameDescriptorAllocator>{});
+}
+
+void FrameDescriptorAllocatorTest::noPools() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    FrameDescriptorAllocator allocator{NoCreate};
+    Fence fence{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    allocator.allocate({});
+    allocator.allocate({}, {DescriptorWrite{0, DescriptorType::UniformBuffer, VkBuffer{}}});
+    allocator.nextFrame();
+    allocator.nextFrame(fence);
+    CORRADE_COMPARE(out.str(),
+        "Vk::FrameDescriptorAllocator::allocate(): the allocator has no descriptor pools\n"
+        "Vk::FrameDescriptorAllocator::allocate(): the allocator has no descriptor pools\n"
+        "Vk::FrameDescriptorAllocator::nextFrame(): the allocator has no descriptor pools\n"
+        "Vk::FrameDescriptorAllocator::nextFrame(): the allocator has no descriptor pools\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::FrameDescriptorAllocatorTest)
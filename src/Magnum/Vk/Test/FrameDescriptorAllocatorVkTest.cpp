@@ -0,0 +1,303 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/DescriptorSetLayoutCreateInfo.h"
+#include "Magnum/Vk/DescriptorType.h"
+#include "Magnum/Vk/Fence.h"
+#include "Magnum/Vk/FenceCreateInfo.h"
+#include "Magnum/Vk/FrameDescriptorAllocator.h"
+#include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct FrameDescriptorAllocatorVkTest: VulkanTester {
+    explicit FrameDescriptorAllocatorVkTest();
+
+    void construct();
+    void constructMove();
+
+    void allocate();
+    void allocateTooLarge();
+
+    void cache();
+    void cacheEmptyWrites();
+
+    void nextFrame();
+    void nextFrameFence();
+};
+
+FrameDescriptorAllocatorVkTest::FrameDescriptorAllocatorVkTest() {
+    addTests({&FrameDescriptorAllocatorVkTest::construct,
+              &FrameDescriptorAllocatorVkTest::constructMove,
+
+              &FrameDescriptorAllocatorVkTest::allocate,
+              &FrameDescriptorAllocatorVkTest::allocateTooLarge,
+
+              &FrameDescriptorAllocatorVkTest::cache,
+              &FrameDescriptorAllocatorVkTest::cacheEmptyWrites,
+
+              &FrameDescriptorAllocatorVkTest::nextFrame,
+              &FrameDescriptorAllocatorVkTest::nextFrameFence});
+}
+
+void FrameDescriptorAllocatorVkTest::construct() {
+    {
+        FrameDescriptorAllocator allocator{device(), 3, 16, {
+            {DescriptorType::UniformBuffer, 16},
+            {DescriptorType::CombinedImageSampler, 32}
+        }};
+        CORRADE_COMPARE(allocator.frameCount(), 3);
+        CORRADE_COMPARE(allocator.frame(), 0);
+        /* No pools created upfront */
+        CORRADE_COMPARE(allocator.poolCount(), 0);
+        CORRADE_COMPARE(allocator.setCount(), 0);
+        CORRADE_COMPARE(allocator.cacheHitCount(), 0);
+        CORRADE_COMPARE(allocator.cacheMissCount(), 0);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void FrameDescriptorAllocatorVkTest::constructMove() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer}}
+    }};
+
+    FrameDescriptorAllocator a{device(), 2, 4, {
+        {DescriptorType::UniformBuffer, 4}
+    }};
+    a.allocate(layout);
+    a.nextFrame();
+    a.allocate(layout);
+
+    FrameDescriptorAllocator b = Utility::move(a);
+    CORRADE_COMPARE(a.frameCount(), 0);
+    CORRADE_COMPARE(a.poolCount(), 0);
+    CORRADE_COMPARE(b.frameCount(), 2);
+    CORRADE_COMPARE(b.frame(), 1);
+    CORRADE_COMPARE(b.poolCount(), 2);
+    CORRADE_COMPARE(b.setCount(), 1);
+
+    FrameDescriptorAllocator c{NoCreate};
+    c = Utility::move(b);
+    CORRADE_COMPARE(b.frameCount(), 0);
+    CORRADE_COMPARE(b.poolCount(), 0);
+    CORRADE_COMPARE(c.frameCount(), 2);
+    CORRADE_COMPARE(c.frame(), 1);
+    CORRADE_COMPARE(c.poolCount(), 2);
+    CORRADE_COMPARE(c.setCount(), 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<FrameDescriptorAllocator>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<FrameDescriptorAllocator>::value);
+}
+
+void FrameDescriptorAllocatorVkTest::allocate() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer}}
+    }};
+
+    /* At most two sets in a pool */
+    FrameDescriptorAllocator allocator{device(), 2, 2, {
+        {DescriptorType::UniformBuffer, 2}
+    }};
+
+    VkDescriptorSet sets[5];
+    for(VkDescriptorSet& set: sets) {
+        set = allocator.allocate(layout);
+        CORRADE_VERIFY(set);
+    }
+
+    /* Five sets need three pools */
+    CORRADE_COMPARE(allocator.setCount(), 5);
+    CORRADE_COMPARE(allocator.poolCount(), 3);
+
+    /* All sets are distinct */
+    for(std::size_t i = 0; i != 5; ++i) {
+        CORRADE_ITERATION(i);
+        for(std::size_t j = 0; j != i; ++j)
+            CORRADE_VERIFY(sets[i] != sets[j]);
+    }
+
+    /* No caching is done with plain allocation */
+    CORRADE_COMPARE(allocator.cacheHitCount(), 0);
+    CORRADE_COMPARE(allocator.cacheMissCount(), 0);
+}
+
+void FrameDescriptorAllocatorVkTest::allocateTooLarge() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer, 4}}
+    }};
+
+    FrameDescriptorAllocator allocator{device(), 2, 2, {
+        {DescriptorType::UniformBuffer, 2}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    allocator.allocate(layout);
+    CORRADE_COMPARE(out.str(), "Vk::FrameDescriptorAllocator::allocate(): allocation failed in a newly created pool, the layout needs more descriptors than a single pool has\n");
+}
+
+void FrameDescriptorAllocatorVkTest::cache() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{{
+        {{0, DescriptorType::UniformBuffer}},
+        {{1, DescriptorType::StorageBuffer}}
+    }}};
+
+    Buffer buffer{device(), BufferCreateInfo{
+        BufferUsage::UniformBuffer|BufferUsage::StorageBuffer, 1024
+    }, MemoryFlag::DeviceLocal};
+
+    FrameDescriptorAllocator allocator{device(), 2, 16, {
+        {DescriptorType::UniformBuffer, 16},
+        {DescriptorType::StorageBuffer, 16}
+    }};
+
+    VkDescriptorSet a = allocator.allocate(layout, {
+        DescriptorWrite{0, DescriptorType::UniformBuffer, buffer, 0, 256},
+        DescriptorWrite{1, DescriptorType::StorageBuffer, buffer, 512}
+    });
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(allocator.setCount(), 1);
+    CORRADE_COMPARE(allocator.cacheHitCount(), 0);
+    CORRADE_COMPARE(allocator.cacheMissCount(), 1);
+
+    /* Same layout and writes returns the same set */
+    VkDescriptorSet b = allocator.allocate(layout, {
+        DescriptorWrite{0, DescriptorType::UniformBuffer, buffer, 0, 256},
+        DescriptorWrite{1, DescriptorType::StorageBuffer, buffer, 512}
+    });
+    CORRADE_COMPARE(b, a);
+    CORRADE_COMPARE(allocator.setCount(), 1);
+    CORRADE_COMPARE(allocator.cacheHitCount(), 1);
+    CORRADE_COMPARE(allocator.cacheMissCount(), 1);
+
+    /* Different offset is a different set */
+    VkDescriptorSet c = allocator.allocate(layout, {
+        DescriptorWrite{0, DescriptorType::UniformBuffer, buffer, 256, 256},
+        DescriptorWrite{1, DescriptorType::StorageBuffer, buffer, 512}
+    });
+    CORRADE_VERIFY(c != a);
+    CORRADE_COMPARE(allocator.setCount(), 2);
+    CORRADE_COMPARE(allocator.cacheHitCount(), 1);
+    CORRADE_COMPARE(allocator.cacheMissCount(), 2);
+
+    /* Resetting the statistics doesn't affect the cache */
+    allocator.resetCacheStatistics();
+    CORRADE_COMPARE(allocator.cacheHitCount(), 0);
+    CORRADE_COMPARE(allocator.cacheMissCount(), 0);
+    VkDescriptorSet d = allocator.allocate(layout, {
+        DescriptorWrite{0, DescriptorType::UniformBuffer, buffer, 256, 256},
+        DescriptorWrite{1, DescriptorType::StorageBuffer, buffer, 512}
+    });
+    CORRADE_COMPARE(d, c);
+    CORRADE_COMPARE(allocator.cacheHitCount(), 1);
+    CORRADE_COMPARE(allocator.cacheMissCount(), 0);
+
+    /* The next frame has its own cache */
+    allocator.nextFrame();
+    allocator.allocate(layout, {
+        DescriptorWrite{0, DescriptorType::UniformBuffer, buffer, 0, 256},
+        DescriptorWrite{1, DescriptorType::StorageBuffer, buffer, 512}
+    });
+    CORRADE_COMPARE(allocator.setCount(), 1);
+    CORRADE_COMPARE(allocator.cacheHitCount(), 1);
+    CORRADE_COMPARE(allocator.cacheMissCount(), 1);
+}
+
+void FrameDescriptorAllocatorVkTest::cacheEmptyWrites() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer}}
+    }};
+
+    FrameDescriptorAllocator allocator{device(), 1, 4, {
+        {DescriptorType::UniformBuffer, 4}
+    }};
+
+    /* Cached purely by the layout, nothing is written */
+    VkDescriptorSet a = allocator.allocate(layout, {});
+    VkDescriptorSet b = allocator.allocate(layout, {});
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(b, a);
+    CORRADE_COMPARE(allocator.setCount(), 1);
+    CORRADE_COMPARE(allocator.cacheHitCount(), 1);
+    CORRADE_COMPARE(allocator.cacheMissCount(), 1);
+}
+
+void FrameDescriptorAllocatorVkTest::nextFrame() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer}}
+    }};
+
+    FrameDescriptorAllocator allocator{device(), 2, 2, {
+        {DescriptorType::UniformBuffer, 2}
+    }};
+
+    /* Frame 0 needs two pools */
+    for(std::size_t i = 0; i != 3; ++i) allocator.allocate(layout);
+    CORRADE_COMPARE(allocator.poolCount(), 2);
+    CORRADE_COMPARE(allocator.setCount(), 3);
+
+    /* Frame 1 needs one more */
+    allocator.nextFrame();
+    CORRADE_COMPARE(allocator.frame(), 1);
+    CORRADE_COMPARE(allocator.setCount(), 0);
+    allocator.allocate(layout);
+    CORRADE_COMPARE(allocator.poolCount(), 3);
+    CORRADE_COMPARE(allocator.setCount(), 1);
+
+    /* Wrapping around back to frame 0 resets its pools and reuses them, no
+       new pools get created */
+    allocator.nextFrame();
+    CORRADE_COMPARE(allocator.frame(), 0);
+    CORRADE_COMPARE(allocator.setCount(), 0);
+    for(std::size_t i = 0; i != 4; ++i) allocator.allocate(layout);
+    CORRADE_COMPARE(allocator.poolCount(), 3);
+    CORRADE_COMPARE(allocator.setCount(), 4);
+}
+
+void FrameDescriptorAllocatorVkTest::nextFrameFence() {
+    FrameDescriptorAllocator allocator{device(), 2, 2, {
+        {DescriptorType::UniformBuffer, 2}
+    }};
+
+    /* Already signaled, so this shouldn't block */
+    Fence fence{device(), FenceCreateInfo{FenceCreateInfo::Flag::Signaled}};
+    allocator.nextFrame(fence);
+    CORRADE_COMPARE(allocator.frame(), 1);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::FrameDescriptorAllocatorVkTest)
@@ -0,0 +1,115 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/FramePacer.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct FramePacerTest: TestSuite::Tester {
+    explicit FramePacerTest();
+
+    void constructNoCreate();
+    void constructZeroCount();
+    void constructCopy();
+
+    void noSemaphore();
+    void signalSemaphoreNoFrame();
+};
+
+FramePacerTest::FramePacerTest() {
+    addTests({&FramePacerTest::constructNoCreate,
+              &FramePacerTest::constructZeroCount,
+              &FramePacerTest::constructCopy,
+
+              &FramePacerTest::noSemaphore,
+              &FramePacerTest::signalSemaphoreNoFrame});
+}
+
+void FramePacerTest::constructNoCreate() {
+    {
+        FramePacer pacer{NoCreate};
+        CORRADE_COMPARE(pacer.frameCount(), 0);
+        CORRADE_COMPARE(pacer.frameNumber(), 0);
+        CORRADE_COMPARE(pacer.frame(), 0);
+        CORRADE_VERIFY(!pacer.semaphore().handle());
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, FramePacer>::value);
+}
+
+void FramePacerTest::constructZeroCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    /* The device is never accessed, so NoCreate is fine */
+    Device device{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FramePacer{device, 0};
+    CORRADE_COMPARE(out.str(), "Vk::FramePacer: expected non-zero frame count\n");
+}
+
+void FramePacerTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<FramePacer>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<FramePacer>{});
+}
+
+void FramePacerTest::noSemaphore() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    FramePacer pacer{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pacer.completedFrameNumber();
+    pacer.beginFrame();
+    pacer.waitIdle();
+    CORRADE_COMPARE(out.str(),
+        "Vk::FramePacer::completedFrameNumber(): the pacer has no semaphore\n"
+        "Vk::FramePacer::beginFrame(): the pacer has no semaphore\n"
+        "Vk::FramePacer::waitIdle(): the pacer has no semaphore\n");
+}
+
+void FramePacerTest::signalSemaphoreNoFrame() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    FramePacer pacer{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pacer.signalSemaphore();
+    CORRADE_COMPARE(out.str(), "Vk::FramePacer::signalSemaphore(): no frame started\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::FramePacerTest)
@@ -0,0 +1,201 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Pair.h>
+
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/DeviceCreateInfo.h"
+#include "Magnum/Vk/DeviceFeatures.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Extensions.h"
+#include "Magnum/Vk/FramePacer.h"
+#include "Magnum/Vk/Version.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct FramePacerVkTest: VulkanTester {
+    explicit FramePacerVkTest();
+
+    void setup();
+    void teardown();
+
+    void construct();
+    void constructMove();
+
+    void beginFrame();
+    void submit();
+
+    Queue _queueTimeline{NoCreate};
+    Device _deviceTimeline{NoCreate};
+};
+
+FramePacerVkTest::FramePacerVkTest() {
+    addTests({&FramePacerVkTest::construct,
+              &FramePacerVkTest::constructMove,
+
+              &FramePacerVkTest::beginFrame,
+              &FramePacerVkTest::submit},
+        &FramePacerVkTest::setup,
+        &FramePacerVkTest::teardown);
+}
+
+void FramePacerVkTest::setup() {
+    DeviceProperties properties = pickDevice(instance());
+    if(!(properties.features() & DeviceFeature::TimelineSemaphore))
+        return;
+
+    /* Create the device only if not already, to avoid spamming the output */
+    if(_deviceTimeline.handle()) return;
+
+    /* On 1.1 and older the feature comes from the extension */
+    const bool needsExtension = !properties.isVersionSupported(Version::Vk12);
+    DeviceCreateInfo info{Utility::move(properties)};
+    info.addQueues(QueueFlag::Graphics, {0.0f}, {_queueTimeline})
+        .setEnabledFeatures(DeviceFeature::TimelineSemaphore);
+    if(needsExtension)
+        info.addEnabledExtensions<Extensions::KHR::timeline_semaphore>();
+    _deviceTimeline.create(instance(), Utility::move(info));
+}
+
+void FramePacerVkTest::teardown() {
+    /* Nothing, the device & queue created by setup() is created just once and
+       so shouldn't be destroyed right after */
+}
+
+void FramePacerVkTest::construct() {
+    if(!_deviceTimeline.handle())
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    {
+        FramePacer pacer{_deviceTimeline, 3};
+        CORRADE_COMPARE(pacer.frameCount(), 3);
+        CORRADE_COMPARE(pacer.frameNumber(), 0);
+        CORRADE_COMPARE(pacer.frame(), 0);
+        CORRADE_VERIFY(pacer.semaphore().handle());
+        CORRADE_COMPARE(pacer.completedFrameNumber(), 0);
+
+        /* No frame started, so this shouldn't block */
+        pacer.waitIdle();
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void FramePacerVkTest::constructMove() {
+    if(!_deviceTimeline.handle())
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    FramePacer a{_deviceTimeline, 2};
+    a.beginFrame();
+    VkSemaphore handle = a.semaphore().handle();
+
+    FramePacer b = Utility::move(a);
+    CORRADE_COMPARE(a.frameCount(), 0);
+    CORRADE_COMPARE(a.frameNumber(), 0);
+    CORRADE_VERIFY(!a.semaphore().handle());
+    CORRADE_COMPARE(b.frameCount(), 2);
+    CORRADE_COMPARE(b.frameNumber(), 1);
+    CORRADE_COMPARE(b.semaphore().handle(), handle);
+
+    FramePacer c{NoCreate};
+    c = Utility::move(b);
+    CORRADE_COMPARE(b.frameCount(), 0);
+    CORRADE_VERIFY(!b.semaphore().handle());
+    CORRADE_COMPARE(c.frameCount(), 2);
+    CORRADE_COMPARE(c.frameNumber(), 1);
+    CORRADE_COMPARE(c.semaphore().handle(), handle);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<FramePacer>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<FramePacer>::value);
+}
+
+void FramePacerVkTest::beginFrame() {
+    if(!_deviceTimeline.handle())
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    FramePacer pacer{_deviceTimeline, 2};
+
+    /* The first two frames don't wait for anything */
+    pacer.beginFrame();
+    CORRADE_COMPARE(pacer.frameNumber(), 1);
+    CORRADE_COMPARE(pacer.frame(), 0);
+    CORRADE_COMPARE(pacer.signalSemaphore().first(), pacer.semaphore().handle());
+    CORRADE_COMPARE(pacer.signalSemaphore().second(), 1);
+    pacer.beginFrame();
+    CORRADE_COMPARE(pacer.frameNumber(), 2);
+    CORRADE_COMPARE(pacer.frame(), 1);
+    CORRADE_COMPARE(pacer.signalSemaphore().second(), 2);
+
+    /* The third frame waits for the first, simulate the GPU finishing it
+       from the host to not block indefinitely */
+    pacer.semaphore().signal(1);
+    CORRADE_COMPARE(pacer.completedFrameNumber(), 1);
+    pacer.beginFrame();
+    CORRADE_COMPARE(pacer.frameNumber(), 3);
+    CORRADE_COMPARE(pacer.frame(), 0);
+
+    pacer.semaphore().signal(3);
+    pacer.waitIdle();
+    CORRADE_COMPARE(pacer.completedFrameNumber(), 3);
+}
+
+void FramePacerVkTest::submit() {
+    if(!_deviceTimeline.handle())
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    FramePacer pacer{_deviceTimeline, 2};
+    CommandPool pool{_deviceTimeline, CommandPoolCreateInfo{
+        _deviceTimeline.properties().pickQueueFamily(QueueFlag::Graphics),
+        CommandPoolCreateInfo::Flag::ResetCommandBuffer}};
+    CommandBuffer cmds[]{pool.allocate(), pool.allocate()};
+
+    /* Without the pacing, re-recording a command buffer that's still in
+       flight would trigger a validation error */
+    for(UnsignedInt i = 0; i != 7; ++i) {
+        CORRADE_ITERATION(i);
+
+        pacer.beginFrame();
+        CORRADE_COMPARE(pacer.frame(), i % 2);
+        CORRADE_VERIFY(pacer.completedFrameNumber() + 2 >= pacer.frameNumber());
+
+        CommandBuffer& cmd = cmds[pacer.frame()];
+        cmd.begin();
+        cmd.end();
+        _queueTimeline.submit({SubmitInfo{}
+            .setCommandBuffers({cmd})
+            .setSignalSemaphores({pacer.signalSemaphore()})
+        }, {});
+    }
+
+    pacer.waitIdle();
+    CORRADE_COMPARE(pacer.completedFrameNumber(), 7);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::FramePacerVkTest)
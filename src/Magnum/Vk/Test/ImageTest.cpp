@@ -60,6 +60,7 @@ struct ImageTest: TestSuite::Tester {
     void constructCopy();
 
     void dedicatedMemoryNotDedicated();
+    void allocationNotAllocated();
 
     /* While *ConstructFromVk() tests that going from VkFromThing -> Vk::Thing
        -> VkToThing doesn't result in information loss, the *ConvertToVk()
@@ -141,6 +142,7 @@ ImageTest::ImageTest() {
               &ImageTest::constructCopy,
 
               &ImageTest::dedicatedMemoryNotDedicated,
+              &ImageTest::allocationNotAllocated,
 
               &ImageTest::imageCopyConstruct,
               &ImageTest::imageCopyConstructNoInit,
@@ -389,6 +391,18 @@ void ImageTest::dedicatedMemoryNotDedicated() {
     CORRADE_COMPARE(out.str(), "Vk::Image::dedicatedMemory(): image doesn't have a dedicated memory\n");
 }
 
+void ImageTest::allocationNotAllocated() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Image image{NoCreate};
+    CORRADE_VERIFY(!image.hasAllocation());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    image.allocation();
+    CORRADE_COMPARE(out.str(), "Vk::Image::allocation(): image doesn't have memory from an allocator\n");
+}
+
 void ImageTest::imageCopyConstruct() {
     ImageCopy copy{ImageAspect::Color|ImageAspect::Depth, 3, 5, 7, {9, 11, 13}, 4, 6, 8, {10, 12, 14}, {1, 2, 15}};
     CORRADE_COMPARE(copy->srcSubresource.aspectMask, VK_IMAGE_ASPECT_COLOR_BIT|VK_IMAGE_ASPECT_DEPTH_BIT);
@@ -0,0 +1,145 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/DescriptorSetLayoutCreateInfo.h"
+#include "Magnum/Vk/DescriptorType.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/LayoutCache.h"
+#include "Magnum/Vk/PipelineLayoutCreateInfo.h"
+#include "Magnum/Vk/ShaderReflection.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct LayoutCacheTest: TestSuite::Tester {
+    explicit LayoutCacheTest();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void noDevice();
+    void descriptorSetLayoutUnsupportedNextChain();
+    void pipelineLayoutUnsupportedNextChain();
+};
+
+LayoutCacheTest::LayoutCacheTest() {
+    addTests({&LayoutCacheTest::constructNoCreate,
+              &LayoutCacheTest::constructCopy,
+
+              &LayoutCacheTest::noDevice,
+              &LayoutCacheTest::descriptorSetLayoutUnsupportedNextChain,
+              &LayoutCacheTest::pipelineLayoutUnsupportedNextChain});
+}
+
+void LayoutCacheTest::constructNoCreate() {
+    {
+        LayoutCache cache{NoCreate};
+        CORRADE_COMPARE(cache.descriptorSetLayoutCount(), 0);
+        CORRADE_COMPARE(cache.pipelineLayoutCount(), 0);
+        CORRADE_COMPARE(cache.cacheHitCount(), 0);
+        CORRADE_COMPARE(cache.cacheMissCount(), 0);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, LayoutCache>::value);
+}
+
+void LayoutCacheTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<LayoutCache>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<LayoutCache>{});
+}
+
+void LayoutCacheTest::noDevice() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    LayoutCache cache{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.descriptorSetLayout(DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer}}
+    });
+    cache.pipelineLayout(PipelineLayoutCreateInfo{});
+    cache.pipelineLayout(ShaderReflection{});
+    CORRADE_COMPARE(out.str(),
+        "Vk::LayoutCache::descriptorSetLayout(): the cache has no device\n"
+        "Vk::LayoutCache::pipelineLayout(): the cache has no device\n"
+        "Vk::LayoutCache::pipelineLayout(): the cache has no device\n");
+}
+
+void LayoutCacheTest::descriptorSetLayoutUnsupportedNextChain() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    /* The device is never accessed, so NoCreate is fine */
+    Device device{NoCreate};
+    LayoutCache cache{device};
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo next{};
+    next.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    VkDescriptorSetLayoutCreateInfo nested{};
+    next.pNext = &nested;
+
+    DescriptorSetLayoutCreateInfo info{
+        {{0, DescriptorType::UniformBuffer}}
+    };
+    info->pNext = &nested;
+
+    DescriptorSetLayoutCreateInfo infoNested{
+        {{0, DescriptorType::UniformBuffer}}
+    };
+    infoNested->pNext = &next;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.descriptorSetLayout(info);
+    cache.descriptorSetLayout(infoNested);
+    CORRADE_COMPARE(out.str(),
+        "Vk::LayoutCache::descriptorSetLayout(): only binding flags are supported in the pNext chain\n"
+        "Vk::LayoutCache::descriptorSetLayout(): only binding flags are supported in the pNext chain\n");
+}
+
+void LayoutCacheTest::pipelineLayoutUnsupportedNextChain() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    /* The device is never accessed, so NoCreate is fine */
+    Device device{NoCreate};
+    LayoutCache cache{device};
+
+    VkPipelineLayoutCreateInfo next{};
+    PipelineLayoutCreateInfo info;
+    info->pNext = &next;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.pipelineLayout(info);
+    CORRADE_COMPARE(out.str(),
+        "Vk::LayoutCache::pipelineLayout(): the pNext chain is expected to be empty\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::LayoutCacheTest)
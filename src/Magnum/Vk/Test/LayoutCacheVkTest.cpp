@@ -0,0 +1,230 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include "Magnum/Vk/DescriptorSetLayoutCreateInfo.h"
+#include "Magnum/Vk/DescriptorType.h"
+#include "Magnum/Vk/LayoutCache.h"
+#include "Magnum/Vk/PipelineLayoutCreateInfo.h"
+#include "Magnum/Vk/Shader.h"
+#include "Magnum/Vk/ShaderReflection.h"
+#include "Magnum/Vk/VulkanTester.h"
+#include "MagnumExternal/Vulkan/spirv.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct LayoutCacheVkTest: VulkanTester {
+    explicit LayoutCacheVkTest();
+
+    void construct();
+    void constructMove();
+
+    void descriptorSetLayout();
+    void pipelineLayout();
+    void pipelineLayoutReflection();
+};
+
+LayoutCacheVkTest::LayoutCacheVkTest() {
+    addTests({&LayoutCacheVkTest::construct,
+              &LayoutCacheVkTest::constructMove,
+
+              &LayoutCacheVkTest::descriptorSetLayout,
+              &LayoutCacheVkTest::pipelineLayout,
+              &LayoutCacheVkTest::pipelineLayoutReflection});
+}
+
+void LayoutCacheVkTest::construct() {
+    {
+        LayoutCache cache{device()};
+        /* No layouts created upfront */
+        CORRADE_COMPARE(cache.descriptorSetLayoutCount(), 0);
+        CORRADE_COMPARE(cache.pipelineLayoutCount(), 0);
+        CORRADE_COMPARE(cache.cacheHitCount(), 0);
+        CORRADE_COMPARE(cache.cacheMissCount(), 0);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void LayoutCacheVkTest::constructMove() {
+    LayoutCache a{device()};
+    VkDescriptorSetLayout layout = a.descriptorSetLayout(DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer}}
+    });
+
+    LayoutCache b = Utility::move(a);
+    CORRADE_COMPARE(a.descriptorSetLayoutCount(), 0);
+    CORRADE_COMPARE(b.descriptorSetLayoutCount(), 1);
+    CORRADE_COMPARE(b.cacheMissCount(), 1);
+
+    LayoutCache c{NoCreate};
+    c = Utility::move(b);
+    CORRADE_COMPARE(b.descriptorSetLayoutCount(), 0);
+    CORRADE_COMPARE(c.descriptorSetLayoutCount(), 1);
+
+    /* The layout is still there */
+    CORRADE_COMPARE(c.descriptorSetLayout(DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer}}
+    }), layout);
+    CORRADE_COMPARE(c.cacheHitCount(), 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<LayoutCache>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<LayoutCache>::value);
+}
+
+void LayoutCacheVkTest::descriptorSetLayout() {
+    LayoutCache cache{device()};
+
+    VkDescriptorSetLayout a = cache.descriptorSetLayout(DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer}},
+        {{1, DescriptorType::CombinedImageSampler, 2, ShaderStage::Fragment}}
+    });
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(cache.descriptorSetLayoutCount(), 1);
+    CORRADE_COMPARE(cache.cacheHitCount(), 0);
+    CORRADE_COMPARE(cache.cacheMissCount(), 1);
+
+    /* Same bindings in a different order give back the same layout */
+    VkDescriptorSetLayout b = cache.descriptorSetLayout(DescriptorSetLayoutCreateInfo{
+        {{1, DescriptorType::CombinedImageSampler, 2, ShaderStage::Fragment}},
+        {{0, DescriptorType::UniformBuffer}}
+    });
+    CORRADE_COMPARE(b, a);
+    CORRADE_COMPARE(cache.descriptorSetLayoutCount(), 1);
+    CORRADE_COMPARE(cache.cacheHitCount(), 1);
+    CORRADE_COMPARE(cache.cacheMissCount(), 1);
+
+    /* Different count, type or stages give a new one */
+    VkDescriptorSetLayout c = cache.descriptorSetLayout(DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer}},
+        {{1, DescriptorType::CombinedImageSampler, 3, ShaderStage::Fragment}}
+    });
+    VkDescriptorSetLayout d = cache.descriptorSetLayout(DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBufferDynamic}},
+        {{1, DescriptorType::CombinedImageSampler, 2, ShaderStage::Fragment}}
+    });
+    VkDescriptorSetLayout e = cache.descriptorSetLayout(DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer}},
+        {{1, DescriptorType::CombinedImageSampler, 2, ShaderStage::Fragment|ShaderStage::Vertex}}
+    });
+    CORRADE_VERIFY(c != a);
+    CORRADE_VERIFY(d != a);
+    CORRADE_VERIFY(e != a);
+    CORRADE_VERIFY(d != c);
+    CORRADE_VERIFY(e != c);
+    CORRADE_VERIFY(e != d);
+    CORRADE_COMPARE(cache.descriptorSetLayoutCount(), 4);
+    CORRADE_COMPARE(cache.cacheHitCount(), 1);
+    CORRADE_COMPARE(cache.cacheMissCount(), 4);
+}
+
+void LayoutCacheVkTest::pipelineLayout() {
+    LayoutCache cache{device()};
+
+    VkDescriptorSetLayout set = cache.descriptorSetLayout(DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer}}
+    });
+
+    VkPipelineLayout a = cache.pipelineLayout(PipelineLayoutCreateInfo{set});
+    VkPipelineLayout b = cache.pipelineLayout(PipelineLayoutCreateInfo{set});
+    VkPipelineLayout c = cache.pipelineLayout(PipelineLayoutCreateInfo{{set}, {
+        VkPushConstantRange{VK_SHADER_STAGE_VERTEX_BIT, 0, 64}
+    }});
+    VkPipelineLayout d = cache.pipelineLayout(PipelineLayoutCreateInfo{set, set});
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(b, a);
+    CORRADE_VERIFY(c != a);
+    CORRADE_VERIFY(d != a);
+    CORRADE_VERIFY(d != c);
+    CORRADE_COMPARE(cache.descriptorSetLayoutCount(), 1);
+    CORRADE_COMPARE(cache.pipelineLayoutCount(), 3);
+    CORRADE_COMPARE(cache.cacheHitCount(), 1);
+    CORRADE_COMPARE(cache.cacheMissCount(), 4);
+}
+
+constexpr UnsignedInt op(UnsignedInt length, SpvOp op) {
+    return length << 16 | op;
+}
+
+/* A vertex and a fragment entrypoint sharing a uniform buffer in set 0, with
+   the fragment one additionally using a sampler in set 1 and a push constant
+   float. Not a complete module, but enough for the reflection. */
+constexpr UnsignedInt ReflectionSpirv[] {
+    SpvMagicNumber, 0x00010400, 0, 18, 0,
+    op(5, SpvOpEntryPoint), SpvExecutionModelVertex, 1, 'v' | 'e' << 8 | 'r' << 16, 10,
+    op(7, SpvOpEntryPoint), SpvExecutionModelFragment, 2, 'f' | 'r' << 8 | 'a' << 16, 10, 13, 17,
+
+    op(4, SpvOpDecorate), 10, SpvDecorationDescriptorSet, 0,
+    op(4, SpvOpDecorate), 10, SpvDecorationBinding, 0,
+    op(4, SpvOpDecorate), 13, SpvDecorationDescriptorSet, 1,
+    op(4, SpvOpDecorate), 13, SpvDecorationBinding, 0,
+    op(3, SpvOpDecorate), 7, SpvDecorationBlock,
+    op(5, SpvOpMemberDecorate), 7, 0, SpvDecorationOffset, 0,
+    op(3, SpvOpDecorate), 15, SpvDecorationBlock,
+    op(5, SpvOpMemberDecorate), 15, 0, SpvDecorationOffset, 0,
+
+    op(3, SpvOpTypeFloat), 6, 32,
+    op(3, SpvOpTypeStruct), 7, 6,
+    op(4, SpvOpTypePointer), 8, SpvStorageClassUniform, 7,
+    op(4, SpvOpVariable), 8, 10, SpvStorageClassUniform,
+    op(2, SpvOpTypeSampler), 11,
+    op(4, SpvOpTypePointer), 12, SpvStorageClassUniformConstant, 11,
+    op(4, SpvOpVariable), 12, 13, SpvStorageClassUniformConstant,
+    op(3, SpvOpTypeStruct), 15, 6,
+    op(4, SpvOpTypePointer), 16, SpvStorageClassPushConstant, 15,
+    op(4, SpvOpVariable), 16, 17, SpvStorageClassPushConstant
+};
+
+void LayoutCacheVkTest::pipelineLayoutReflection() {
+    ShaderReflection reflection;
+    CORRADE_VERIFY(reflection.addShader(ShaderStage::Vertex, Containers::arrayView(ReflectionSpirv), "ver"));
+    CORRADE_VERIFY(reflection.addShader(ShaderStage::Fragment, Containers::arrayView(ReflectionSpirv), "fra"));
+    CORRADE_COMPARE(reflection.descriptorSetCount(), 2);
+    CORRADE_COMPARE(reflection.pushConstantRanges().size(), 1);
+
+    LayoutCache cache{device()};
+    VkPipelineLayout a = cache.pipelineLayout(reflection);
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(cache.descriptorSetLayoutCount(), 2);
+    CORRADE_COMPARE(cache.pipelineLayoutCount(), 1);
+    CORRADE_COMPARE(cache.cacheMissCount(), 3);
+
+    /* Second time everything is taken from the cache */
+    VkPipelineLayout b = cache.pipelineLayout(reflection);
+    CORRADE_COMPARE(b, a);
+    CORRADE_COMPARE(cache.descriptorSetLayoutCount(), 2);
+    CORRADE_COMPARE(cache.pipelineLayoutCount(), 1);
+    CORRADE_COMPARE(cache.cacheHitCount(), 3);
+    CORRADE_COMPARE(cache.cacheMissCount(), 3);
+
+    /* The same set layout can be looked up explicitly as well */
+    CORRADE_COMPARE(cache.descriptorSetLayout(DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::Sampler, 1, ShaderStage::Fragment}}
+    }), cache.descriptorSetLayout(reflection.descriptorSetLayoutCreateInfo(1)));
+    CORRADE_COMPARE(cache.descriptorSetLayoutCount(), 2);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::LayoutCacheVkTest)
@@ -0,0 +1,225 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/MemoryAllocateInfo.h"
+#include "Magnum/Vk/MemoryAllocator.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct MemoryAllocatorTest: TestSuite::Tester {
+    explicit MemoryAllocatorTest();
+
+    void allocationConstructNoCreate();
+    void allocationConstructCopy();
+    void allocationNoAllocation();
+
+    void constructNoCreate();
+    void constructCopy();
+    void constructInvalidSizes();
+    void allocateNoCreate();
+
+    void arenaConstructNoCreate();
+    void arenaConstructCopy();
+    void arenaAllocateWrongMemoryType();
+    void arenaMappedDataNotHostVisible();
+
+    void debugFlag();
+    void debugFlags();
+};
+
+MemoryAllocatorTest::MemoryAllocatorTest() {
+    addTests({&MemoryAllocatorTest::allocationConstructNoCreate,
+              &MemoryAllocatorTest::allocationConstructCopy,
+              &MemoryAllocatorTest::allocationNoAllocation,
+
+              &MemoryAllocatorTest::constructNoCreate,
+              &MemoryAllocatorTest::constructCopy,
+              &MemoryAllocatorTest::constructInvalidSizes,
+              &MemoryAllocatorTest::allocateNoCreate,
+
+              &MemoryAllocatorTest::arenaConstructNoCreate,
+              &MemoryAllocatorTest::arenaConstructCopy,
+              &MemoryAllocatorTest::arenaAllocateWrongMemoryType,
+              &MemoryAllocatorTest::arenaMappedDataNotHostVisible,
+
+              &MemoryAllocatorTest::debugFlag,
+              &MemoryAllocatorTest::debugFlags});
+}
+
+void MemoryAllocatorTest::allocationConstructNoCreate() {
+    {
+        MemoryAllocation allocation{NoCreate};
+        CORRADE_VERIFY(!allocation);
+        CORRADE_COMPARE(allocation.offset(), 0);
+        CORRADE_COMPARE(allocation.size(), 0);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<MemoryAllocation, NoCreateT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, MemoryAllocation>::value);
+}
+
+void MemoryAllocatorTest::allocationConstructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<MemoryAllocation>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<MemoryAllocation>{});
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<MemoryAllocation>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<MemoryAllocation>::value);
+}
+
+void MemoryAllocatorTest::allocationNoAllocation() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    MemoryAllocation allocation{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    allocation.memory();
+    allocation.memoryIndex();
+    allocation.isDedicated();
+    allocation.mappedData();
+    CORRADE_COMPARE(out.str(),
+        "Vk::MemoryAllocation::memory(): the instance holds no allocation\n"
+        "Vk::MemoryAllocation::memoryIndex(): the instance holds no allocation\n"
+        "Vk::MemoryAllocation::isDedicated(): the instance holds no allocation\n"
+        "Vk::MemoryAllocation::mappedData(): the instance holds no allocation\n");
+}
+
+void MemoryAllocatorTest::constructNoCreate() {
+    {
+        MemoryAllocator allocator{NoCreate};
+        CORRADE_COMPARE(allocator.blockSize(), 0);
+        CORRADE_COMPARE(allocator.blockCount(), 0);
+        CORRADE_COMPARE(allocator.allocationCount(), 0);
+        CORRADE_COMPARE(allocator.allocatedSize(), 0);
+        CORRADE_COMPARE(allocator.fragmentation(), 0.0f);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, MemoryAllocator>::value);
+}
+
+void MemoryAllocatorTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<MemoryAllocator>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<MemoryAllocator>{});
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<MemoryAllocator>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<MemoryAllocator>::value);
+}
+
+void MemoryAllocatorTest::constructInvalidSizes() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Device device{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MemoryAllocator{device, 3000, 256};
+    MemoryAllocator{device, 4096, 0};
+    MemoryAllocator{device, 256, 4096};
+    MemoryAllocator{device, 1ull << 40, 256};
+    CORRADE_COMPARE(out.str(),
+        "Vk::MemoryAllocator: expected block size and minimal allocation size to be powers of two with a ratio between 1 and 8388608, got 3000 and 256\n"
+        "Vk::MemoryAllocator: expected block size and minimal allocation size to be powers of two with a ratio between 1 and 8388608, got 4096 and 0\n"
+        "Vk::MemoryAllocator: expected block size and minimal allocation size to be powers of two with a ratio between 1 and 8388608, got 256 and 4096\n"
+        "Vk::MemoryAllocator: expected block size and minimal allocation size to be powers of two with a ratio between 1 and 8388608, got 1099511627776 and 256\n");
+}
+
+void MemoryAllocatorTest::allocateNoCreate() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    MemoryAllocator allocator{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    allocator.allocate(MemoryRequirements{VkMemoryRequirements2{}}, MemoryFlag::DeviceLocal);
+    CORRADE_COMPARE(out.str(), "Vk::MemoryAllocator::allocate(): the allocator is not created\n");
+}
+
+void MemoryAllocatorTest::arenaConstructNoCreate() {
+    {
+        MemoryArena arena{NoCreate};
+        CORRADE_VERIFY(!arena.memory().handle());
+        CORRADE_COMPARE(arena.size(), 0);
+        CORRADE_COMPARE(arena.usedSize(), 0);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, MemoryArena>::value);
+}
+
+void MemoryAllocatorTest::arenaConstructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<MemoryArena>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<MemoryArena>{});
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<MemoryArena>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<MemoryArena>::value);
+}
+
+void MemoryAllocatorTest::arenaAllocateWrongMemoryType() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    MemoryArena arena{NoCreate};
+
+    VkMemoryRequirements2 requirements{};
+    requirements.memoryRequirements.size = 16;
+    requirements.memoryRequirements.memoryTypeBits = 0xe;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    arena.allocate(MemoryRequirements{requirements});
+    CORRADE_COMPARE(out.str(), "Vk::MemoryArena::allocate(): memory type 0 not allowed by requirements 0xe\n");
+}
+
+void MemoryAllocatorTest::arenaMappedDataNotHostVisible() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    MemoryArena arena{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    arena.mappedData();
+    CORRADE_COMPARE(out.str(), "Vk::MemoryArena::mappedData(): the memory is not host-visible\n");
+}
+
+void MemoryAllocatorTest::debugFlag() {
+    std::ostringstream out;
+    Debug{&out} << MemoryAllocationFlag::OptimalImage << MemoryAllocationFlag(0xa0);
+    CORRADE_COMPARE(out.str(), "Vk::MemoryAllocationFlag::OptimalImage Vk::MemoryAllocationFlag(0xa0)\n");
+}
+
+void MemoryAllocatorTest::debugFlags() {
+    std::ostringstream out;
+    Debug{&out} << (MemoryAllocationFlag::Dedicated|MemoryAllocationFlag::OptimalImage) << MemoryAllocationFlags{};
+    CORRADE_COMPARE(out.str(), "Vk::MemoryAllocationFlag::Dedicated|Vk::MemoryAllocationFlag::OptimalImage Vk::MemoryAllocationFlags{}\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::MemoryAllocatorTest)
@@ -0,0 +1,383 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/ImageCreateInfo.h"
+#include "Magnum/Vk/MemoryAllocateInfo.h"
+#include "Magnum/Vk/MemoryAllocator.h"
+#include "Magnum/Vk/PixelFormat.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct MemoryAllocatorVkTest: VulkanTester {
+    explicit MemoryAllocatorVkTest();
+
+    void construct();
+    void constructMove();
+
+    void allocate();
+    void allocateSameBlock();
+    void allocateNewBlock();
+    void allocateDedicated();
+    void allocateDedicatedLarge();
+    void allocationMove();
+
+    void freeKeepsOneEmptyBlock();
+
+    void mappedData();
+
+    void statistics();
+
+    void buffer();
+    void image();
+
+    void arena();
+    void arenaFull();
+    void arenaMappedData();
+};
+
+MemoryAllocatorVkTest::MemoryAllocatorVkTest() {
+    addTests({&MemoryAllocatorVkTest::construct,
+              &MemoryAllocatorVkTest::constructMove,
+
+              &MemoryAllocatorVkTest::allocate,
+              &MemoryAllocatorVkTest::allocateSameBlock,
+              &MemoryAllocatorVkTest::allocateNewBlock,
+              &MemoryAllocatorVkTest::allocateDedicated,
+              &MemoryAllocatorVkTest::allocateDedicatedLarge,
+              &MemoryAllocatorVkTest::allocationMove,
+
+              &MemoryAllocatorVkTest::freeKeepsOneEmptyBlock,
+
+              &MemoryAllocatorVkTest::mappedData,
+
+              &MemoryAllocatorVkTest::statistics,
+
+              &MemoryAllocatorVkTest::buffer,
+              &MemoryAllocatorVkTest::image,
+
+              &MemoryAllocatorVkTest::arena,
+              &MemoryAllocatorVkTest::arenaFull,
+              &MemoryAllocatorVkTest::arenaMappedData});
+}
+
+MemoryRequirements requirements(UnsignedLong size, UnsignedLong alignment) {
+    VkMemoryRequirements2 requirements{};
+    requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    requirements.memoryRequirements.size = size;
+    requirements.memoryRequirements.alignment = alignment;
+    requirements.memoryRequirements.memoryTypeBits = ~UnsignedInt{};
+    return MemoryRequirements{requirements};
+}
+
+void MemoryAllocatorVkTest::construct() {
+    MemoryAllocator allocator{device(), 1024*1024, 256};
+    CORRADE_COMPARE(allocator.blockSize(), 1024*1024);
+    CORRADE_COMPARE(allocator.minAllocationSize(), 256);
+
+    /* Nothing is allocated upfront */
+    CORRADE_COMPARE(allocator.blockCount(), 0);
+    CORRADE_COMPARE(allocator.allocatedSize(), 0);
+}
+
+void MemoryAllocatorVkTest::constructMove() {
+    MemoryAllocator a{device(), 1024*1024, 256};
+    MemoryAllocation allocation = a.allocate(requirements(1000, 16), MemoryFlag::DeviceLocal);
+
+    MemoryAllocator b = Utility::move(a);
+    CORRADE_COMPARE(a.blockSize(), 0);
+    CORRADE_COMPARE(b.blockSize(), 1024*1024);
+    CORRADE_COMPARE(b.allocationCount(), 1);
+
+    MemoryAllocator c{NoCreate};
+    c = Utility::move(b);
+    CORRADE_COMPARE(c.blockSize(), 1024*1024);
+    CORRADE_COMPARE(c.allocationCount(), 1);
+
+    /* The allocation gets given back to the moved-to instance */
+    allocation = MemoryAllocation{NoCreate};
+    CORRADE_COMPARE(c.allocationCount(), 0);
+}
+
+void MemoryAllocatorVkTest::allocate() {
+    MemoryAllocator allocator{device(), 1024*1024, 256};
+
+    {
+        MemoryAllocation allocation = allocator.allocate(requirements(1000, 16), MemoryFlag::DeviceLocal);
+        CORRADE_VERIFY(allocation);
+        CORRADE_VERIFY(allocation.memory().handle());
+        CORRADE_COMPARE(allocation.offset(), 0);
+        CORRADE_COMPARE(allocation.size(), 1000);
+        CORRADE_VERIFY(!allocation.isDedicated());
+        CORRADE_VERIFY(device().properties().memoryFlags(allocation.memoryIndex()) & MemoryFlag::DeviceLocal);
+        CORRADE_COMPARE(allocator.allocationCount(), 1);
+        CORRADE_COMPARE(allocator.blockCount(), 1);
+        CORRADE_COMPARE(allocator.allocatedSize(), 1024*1024);
+        CORRADE_COMPARE(allocator.usedSize(), 1024);
+    }
+
+    /* The block is kept around even after it's empty */
+    CORRADE_COMPARE(allocator.allocationCount(), 0);
+    CORRADE_COMPARE(allocator.blockCount(), 1);
+    CORRADE_COMPARE(allocator.usedSize(), 0);
+}
+
+void MemoryAllocatorVkTest::allocateSameBlock() {
+    MemoryAllocator allocator{device(), 1024*1024, 256};
+
+    Containers::Array<MemoryAllocation> allocations{NoInit, 100};
+    for(std::size_t i = 0; i != allocations.size(); ++i)
+        new(&allocations[i]) MemoryAllocation{allocator.allocate(requirements(100 + i*10, 64), MemoryFlag::DeviceLocal)};
+
+    /* All share the same memory, with no overlaps */
+    CORRADE_COMPARE(allocator.blockCount(), 1);
+    CORRADE_COMPARE(allocator.allocationCount(), 100);
+    for(std::size_t i = 0; i != allocations.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(allocations[i].memory().handle(), allocations[0].memory().handle());
+        CORRADE_COMPARE(allocations[i].offset() % 64, 0);
+        for(std::size_t j = 0; j != i; ++j) {
+            CORRADE_ITERATION(j);
+            CORRADE_VERIFY(allocations[i].offset() >= allocations[j].offset() + allocations[j].size() || allocations[j].offset() >= allocations[i].offset() + allocations[i].size());
+        }
+    }
+}
+
+void MemoryAllocatorVkTest::allocateNewBlock() {
+    MemoryAllocator allocator{device(), 4096, 256};
+
+    MemoryAllocation a = allocator.allocate(requirements(2048, 16), MemoryFlag::DeviceLocal);
+    MemoryAllocation b = allocator.allocate(requirements(2048, 16), MemoryFlag::DeviceLocal);
+    CORRADE_COMPARE(allocator.blockCount(), 1);
+    CORRADE_COMPARE(a.memory().handle(), b.memory().handle());
+
+    /* Doesn't fit anymore, a new block is allocated */
+    MemoryAllocation c = allocator.allocate(requirements(256, 16), MemoryFlag::DeviceLocal);
+    CORRADE_COMPARE(allocator.blockCount(), 2);
+    CORRADE_VERIFY(c.memory().handle() != a.memory().handle());
+    CORRADE_COMPARE(c.offset(), 0);
+}
+
+void MemoryAllocatorVkTest::allocateDedicated() {
+    MemoryAllocator allocator{device(), 1024*1024, 256};
+
+    {
+        MemoryAllocation allocation = allocator.allocate(requirements(1000, 16), MemoryFlag::DeviceLocal, {}, MemoryAllocationFlag::Dedicated);
+        CORRADE_VERIFY(allocation.isDedicated());
+        CORRADE_COMPARE(allocation.offset(), 0);
+        CORRADE_COMPARE(allocation.memory().size(), 1000);
+        CORRADE_COMPARE(allocator.blockCount(), 0);
+        CORRADE_COMPARE(allocator.dedicatedAllocationCount(), 1);
+        CORRADE_COMPARE(allocator.allocatedSize(), 1000);
+        CORRADE_COMPARE(allocator.usedSize(), 1000);
+    }
+
+    /* Dedicated allocations are freed right away */
+    CORRADE_COMPARE(allocator.dedicatedAllocationCount(), 0);
+    CORRADE_COMPARE(allocator.allocatedSize(), 0);
+}
+
+void MemoryAllocatorVkTest::allocateDedicatedLarge() {
+    MemoryAllocator allocator{device(), 1024*1024, 256};
+
+    /* Over a half of the block size is dedicated implicitly */
+    MemoryAllocation allocation = allocator.allocate(requirements(512*1024 + 1, 16), MemoryFlag::DeviceLocal);
+    CORRADE_VERIFY(allocation.isDedicated());
+    CORRADE_COMPARE(allocator.blockCount(), 0);
+    CORRADE_COMPARE(allocator.dedicatedAllocationCount(), 1);
+}
+
+void MemoryAllocatorVkTest::allocationMove() {
+    MemoryAllocator allocator{device(), 1024*1024, 256};
+
+    MemoryAllocation a = allocator.allocate(requirements(1000, 16), MemoryFlag::DeviceLocal);
+    VkDeviceMemory handle = a.memory().handle();
+
+    MemoryAllocation b = Utility::move(a);
+    CORRADE_VERIFY(!a);
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(b.memory().handle(), handle);
+    CORRADE_COMPARE(b.size(), 1000);
+
+    MemoryAllocation c{NoCreate};
+    c = Utility::move(b);
+    CORRADE_VERIFY(!b);
+    CORRADE_VERIFY(c);
+    CORRADE_COMPARE(c.memory().handle(), handle);
+    CORRADE_COMPARE(c.size(), 1000);
+
+    /* Only one allocation was done, so only one should be freed */
+    CORRADE_COMPARE(allocator.allocationCount(), 1);
+}
+
+void MemoryAllocatorVkTest::freeKeepsOneEmptyBlock() {
+    MemoryAllocator allocator{device(), 4096, 256};
+
+    {
+        MemoryAllocation a = allocator.allocate(requirements(2048, 16), MemoryFlag::DeviceLocal);
+        MemoryAllocation b = allocator.allocate(requirements(2048, 16), MemoryFlag::DeviceLocal);
+        MemoryAllocation c = allocator.allocate(requirements(2048, 16), MemoryFlag::DeviceLocal);
+        MemoryAllocation d = allocator.allocate(requirements(2048, 16), MemoryFlag::DeviceLocal);
+        MemoryAllocation e = allocator.allocate(requirements(2048, 16), MemoryFlag::DeviceLocal);
+        CORRADE_COMPARE(allocator.blockCount(), 3);
+    }
+
+    /* Only one empty block is kept */
+    CORRADE_COMPARE(allocator.allocationCount(), 0);
+    CORRADE_COMPARE(allocator.blockCount(), 1);
+    CORRADE_COMPARE(allocator.allocatedSize(), 4096);
+}
+
+void MemoryAllocatorVkTest::mappedData() {
+    MemoryAllocator allocator{device(), 1024*1024, 256};
+
+    MemoryAllocation a = allocator.allocate(requirements(1000, 16), MemoryFlag::HostVisible|MemoryFlag::HostCoherent);
+    MemoryAllocation b = allocator.allocate(requirements(300, 16), MemoryFlag::HostVisible|MemoryFlag::HostCoherent);
+    CORRADE_COMPARE(a.memory().handle(), b.memory().handle());
+
+    Containers::ArrayView<char> aData = a.mappedData();
+    Containers::ArrayView<char> bData = b.mappedData();
+    CORRADE_COMPARE(aData.size(), 1000);
+    CORRADE_COMPARE(bData.size(), 300);
+    aData[37] = 'a';
+    bData[37] = 'b';
+
+    /* The views should point to the same mapping, offset by the allocation
+       offsets */
+    CORRADE_COMPARE(aData[37], 'a');
+    CORRADE_COMPARE(bData[37], 'b');
+    CORRADE_COMPARE(static_cast<const void*>(bData.data()), static_cast<const void*>(aData.data() + (b.offset() - a.offset())));
+}
+
+void MemoryAllocatorVkTest::statistics() {
+    MemoryAllocator allocator{device(), 4096, 256};
+    CORRADE_COMPARE(allocator.fragmentation(), 0.0f);
+
+    MemoryAllocation a = allocator.allocate(requirements(1024, 16), MemoryFlag::DeviceLocal);
+    MemoryAllocation b = allocator.allocate(requirements(1024, 16), MemoryFlag::DeviceLocal);
+    MemoryAllocation c = allocator.allocate(requirements(1024, 16), MemoryFlag::DeviceLocal);
+    CORRADE_COMPARE(allocator.usedSize(), 3072);
+    CORRADE_COMPARE(allocator.fragmentation(), 0.0f);
+
+    /* Freeing the middle allocation results in two 1024-byte free ranges
+       that can't be merged */
+    b = MemoryAllocation{NoCreate};
+    CORRADE_COMPARE(allocator.usedSize(), 2048);
+    CORRADE_COMPARE(allocator.allocatedSize(), 4096);
+    CORRADE_COMPARE(allocator.fragmentation(), 0.5f);
+}
+
+void MemoryAllocatorVkTest::buffer() {
+    MemoryAllocator allocator{device()};
+
+    Buffer a{device(), BufferCreateInfo{BufferUsage::VertexBuffer, 1024}, allocator, MemoryFlag::DeviceLocal};
+    Buffer b{device(), BufferCreateInfo{BufferUsage::IndexBuffer, 512}, allocator, MemoryFlag::DeviceLocal};
+    CORRADE_VERIFY(a.handle());
+    CORRADE_VERIFY(!a.hasDedicatedMemory());
+    CORRADE_VERIFY(a.hasAllocation());
+    CORRADE_VERIFY(b.hasAllocation());
+    CORRADE_COMPARE_AS(a.allocation().size(), 1024,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE(a.allocation().memory().handle(), b.allocation().memory().handle());
+    CORRADE_COMPARE(allocator.allocationCount(), 2);
+    CORRADE_COMPARE(allocator.blockCount(), 1);
+
+    /* Moving the buffer moves the allocation as well */
+    Buffer c = Utility::move(a);
+    CORRADE_VERIFY(!a.hasAllocation());
+    CORRADE_VERIFY(c.hasAllocation());
+    CORRADE_COMPARE(allocator.allocationCount(), 2);
+}
+
+void MemoryAllocatorVkTest::image() {
+    MemoryAllocator allocator{device()};
+
+    {
+        Image a{device(), ImageCreateInfo2D{ImageUsage::Sampled,
+            PixelFormat::RGBA8Unorm, {256, 256}, 1}, allocator, MemoryFlag::DeviceLocal};
+        Image b{device(), ImageCreateInfo2D{ImageUsage::Sampled,
+            PixelFormat::RGBA8Unorm, {128, 128}, 1}, allocator, MemoryFlag::DeviceLocal};
+        CORRADE_VERIFY(a.handle());
+        CORRADE_VERIFY(!a.hasDedicatedMemory());
+        CORRADE_VERIFY(a.hasAllocation());
+        CORRADE_VERIFY(b.hasAllocation());
+        CORRADE_COMPARE(a.allocation().memory().handle(), b.allocation().memory().handle());
+        CORRADE_COMPARE(allocator.allocationCount(), 2);
+    }
+
+    CORRADE_COMPARE(allocator.allocationCount(), 0);
+}
+
+void MemoryAllocatorVkTest::arena() {
+    MemoryArena arena{device(), 4096, MemoryFlag::DeviceLocal};
+    CORRADE_VERIFY(arena.memory().handle());
+    CORRADE_COMPARE(arena.size(), 4096);
+    CORRADE_COMPARE(arena.usedSize(), 0);
+    CORRADE_VERIFY(device().properties().memoryFlags(arena.memoryIndex()) & MemoryFlag::DeviceLocal);
+
+    CORRADE_COMPARE(arena.allocate(requirements(100, 16)), 0);
+    CORRADE_COMPARE(arena.usedSize(), 100);
+
+    /* Aligned */
+    CORRADE_COMPARE(arena.allocate(requirements(100, 256)), 256);
+    CORRADE_COMPARE(arena.usedSize(), 356);
+
+    arena.reset();
+    CORRADE_COMPARE(arena.usedSize(), 0);
+    CORRADE_COMPARE(arena.allocate(requirements(100, 16)), 0);
+}
+
+void MemoryAllocatorVkTest::arenaFull() {
+    MemoryArena arena{device(), 4096, MemoryFlag::DeviceLocal};
+
+    CORRADE_COMPARE(arena.allocate(requirements(4000, 16)), 0);
+    CORRADE_COMPARE(arena.allocate(requirements(100, 16)), Containers::NullOpt);
+    /* A failed allocation doesn't change anything */
+    CORRADE_COMPARE(arena.usedSize(), 4000);
+    CORRADE_COMPARE(arena.allocate(requirements(96, 16)), 4000);
+    CORRADE_COMPARE(arena.usedSize(), 4096);
+}
+
+void MemoryAllocatorVkTest::arenaMappedData() {
+    MemoryArena arena{device(), 4096, MemoryFlag::HostVisible|MemoryFlag::HostCoherent};
+
+    Containers::ArrayView<char> data = arena.mappedData();
+    CORRADE_COMPARE(data.size(), 4096);
+
+    Containers::Optional<UnsignedLong> offset = arena.allocate(requirements(100, 16));
+    CORRADE_VERIFY(offset);
+    data[*offset + 37] = 'a';
+    CORRADE_COMPARE(data[*offset + 37], 'a');
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::MemoryAllocatorVkTest)
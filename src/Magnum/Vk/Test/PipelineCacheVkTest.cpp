@@ -0,0 +1,227 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Path.h>
+
+#include "Magnum/Vk/ComputePipelineCreateInfo.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/PipelineCacheCreateInfo.h"
+#include "Magnum/Vk/PipelineLayoutCreateInfo.h"
+#include "Magnum/Vk/Result.h"
+#include "Magnum/Vk/ShaderCreateInfo.h"
+#include "Magnum/Vk/ShaderSet.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct PipelineCacheVkTest: VulkanTester {
+    explicit PipelineCacheVkTest();
+
+    void construct();
+    void constructData();
+    void constructMove();
+
+    void wrap();
+
+    void data();
+    void dataCompatible();
+    void dataIncompatible();
+
+    void merge();
+
+    void pipeline();
+};
+
+PipelineCacheVkTest::PipelineCacheVkTest() {
+    addTests({&PipelineCacheVkTest::construct,
+              &PipelineCacheVkTest::constructData,
+              &PipelineCacheVkTest::constructMove,
+
+              &PipelineCacheVkTest::wrap,
+
+              &PipelineCacheVkTest::data,
+              &PipelineCacheVkTest::dataCompatible,
+              &PipelineCacheVkTest::dataIncompatible,
+
+              &PipelineCacheVkTest::merge,
+
+              &PipelineCacheVkTest::pipeline});
+}
+
+using namespace Containers::Literals;
+
+void PipelineCacheVkTest::construct() {
+    {
+        PipelineCache cache{device()};
+        CORRADE_VERIFY(cache.handle());
+        CORRADE_COMPARE(cache.handleFlags(), HandleFlag::DestroyOnDestruction);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void PipelineCacheVkTest::constructData() {
+    Containers::Array<char> data = PipelineCache{device()}.data();
+
+    PipelineCache cache{device(), PipelineCacheCreateInfo{data}};
+    CORRADE_VERIFY(cache.handle());
+}
+
+void PipelineCacheVkTest::constructMove() {
+    PipelineCache a{device()};
+    VkPipelineCache handle = a.handle();
+
+    PipelineCache b = Utility::move(a);
+    CORRADE_VERIFY(!a.handle());
+    CORRADE_COMPARE(b.handle(), handle);
+    CORRADE_COMPARE(b.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    PipelineCache c{NoCreate};
+    c = Utility::move(b);
+    CORRADE_VERIFY(!b.handle());
+    CORRADE_COMPARE(b.handleFlags(), HandleFlags{});
+    CORRADE_COMPARE(c.handle(), handle);
+    CORRADE_COMPARE(c.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<PipelineCache>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<PipelineCache>::value);
+}
+
+void PipelineCacheVkTest::wrap() {
+    VkPipelineCache cache{};
+    CORRADE_COMPARE(Result(device()->CreatePipelineCache(device(),
+        PipelineCacheCreateInfo{},
+        nullptr, &cache)), Result::Success);
+
+    auto wrapped = PipelineCache::wrap(device(), cache, HandleFlag::DestroyOnDestruction);
+    CORRADE_COMPARE(wrapped.handle(), cache);
+
+    /* Release the handle again, destroy by hand */
+    CORRADE_COMPARE(wrapped.release(), cache);
+    CORRADE_VERIFY(!wrapped.handle());
+    device()->DestroyPipelineCache(device(), cache, nullptr);
+}
+
+void PipelineCacheVkTest::data() {
+    PipelineCache cache{device()};
+
+    /* Even an empty cache has at least the header */
+    Containers::Array<char> data = cache.data();
+    CORRADE_COMPARE_AS(data.size(), sizeof(VkPipelineCacheHeaderVersionOne),
+        TestSuite::Compare::GreaterOrEqual);
+}
+
+void PipelineCacheVkTest::dataCompatible() {
+    Containers::Array<char> data = PipelineCache{device()}.data();
+    CORRADE_VERIFY(PipelineCache::isDataCompatible(device().properties(), data));
+}
+
+void PipelineCacheVkTest::dataIncompatible() {
+    Containers::Array<char> data = PipelineCache{device()}.data();
+    CORRADE_VERIFY(PipelineCache::isDataCompatible(device().properties(), data));
+
+    /* Too short */
+    CORRADE_VERIFY(!PipelineCache::isDataCompatible(device().properties(), data.prefix(sizeof(VkPipelineCacheHeaderVersionOne) - 1)));
+
+    /* Header size larger than the data */
+    {
+        Containers::Array<char> copy{NoInit, data.size()};
+        Utility::copy(data, copy);
+        UnsignedInt headerSize = copy.size() + 1;
+        std::memcpy(copy.data(), &headerSize, 4);
+        CORRADE_VERIFY(!PipelineCache::isDataCompatible(device().properties(), copy));
+    }
+
+    /* Different pipeline cache UUID, i.e. a different driver version */
+    {
+        Containers::Array<char> copy{NoInit, data.size()};
+        Utility::copy(data, copy);
+        copy[offsetof(VkPipelineCacheHeaderVersionOne, pipelineCacheUUID) + 3] ^= 0x5a;
+        CORRADE_VERIFY(!PipelineCache::isDataCompatible(device().properties(), copy));
+    }
+
+    /* Different device ID */
+    {
+        Containers::Array<char> copy{NoInit, data.size()};
+        Utility::copy(data, copy);
+        copy[offsetof(VkPipelineCacheHeaderVersionOne, deviceID)] ^= 0x5a;
+        CORRADE_VERIFY(!PipelineCache::isDataCompatible(device().properties(), copy));
+    }
+}
+
+void PipelineCacheVkTest::merge() {
+    PipelineCache a{device()};
+    PipelineCache b{device()};
+    PipelineCache c{device()};
+    a.merge({b, c});
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void PipelineCacheVkTest::pipeline() {
+    PipelineLayout pipelineLayout{device(), PipelineLayoutCreateInfo{}};
+
+    Containers::Optional<Containers::Array<char>> shaderData = Utility::Path::read(Utility::Path::join(VK_TEST_DIR, "compute-noop.spv"));
+    CORRADE_VERIFY(shaderData);
+    Shader shader{device(), ShaderCreateInfo{*shaderData}};
+
+    ShaderSet shaderSet;
+    shaderSet.addShader(ShaderStage::Compute, shader, "main"_s);
+
+    /* Create a pipeline with a cache, serialize the cache */
+    Containers::Array<char> data;
+    {
+        PipelineCache cache{device()};
+        Pipeline pipeline{device(), ComputePipelineCreateInfo{
+            shaderSet, pipelineLayout
+        }, cache};
+        CORRADE_VERIFY(pipeline.handle());
+        data = cache.data();
+    }
+
+    /* Load the serialized cache and create the pipeline again */
+    CORRADE_VERIFY(PipelineCache::isDataCompatible(device().properties(), data));
+    PipelineCache cache{device(), PipelineCacheCreateInfo{data}};
+    Pipeline pipeline{device(), ComputePipelineCreateInfo{
+        shaderSet, pipelineLayout
+    }, cache};
+    CORRADE_VERIFY(pipeline.handle());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::PipelineCacheVkTest)
@@ -36,6 +36,7 @@ struct PipelineLayoutTest: TestSuite::Tester {
 
     void createInfoConstruct();
     void createInfoConstructDescriptorSetLayouts();
+    void createInfoConstructPushConstantRanges();
     void createInfoConstructNoInit();
     void createInfoConstructFromVk();
     void createInfoConstructCopy();
@@ -48,6 +49,7 @@ struct PipelineLayoutTest: TestSuite::Tester {
 PipelineLayoutTest::PipelineLayoutTest() {
     addTests({&PipelineLayoutTest::createInfoConstruct,
               &PipelineLayoutTest::createInfoConstructDescriptorSetLayouts,
+              &PipelineLayoutTest::createInfoConstructPushConstantRanges,
               &PipelineLayoutTest::createInfoConstructNoInit,
               &PipelineLayoutTest::createInfoConstructFromVk,
               &PipelineLayoutTest::createInfoConstructCopy,
@@ -77,6 +79,27 @@ void PipelineLayoutTest::createInfoConstructDescriptorSetLayouts() {
     CORRADE_COMPARE(info->pSetLayouts[1], reinterpret_cast<VkDescriptorSetLayout>(reinterpret_cast<void*>(std::size_t{0xbeef})));
 }
 
+void PipelineLayoutTest::createInfoConstructPushConstantRanges() {
+    /* The double reinterpret_cast is needed because the handle is an uint64_t
+       instead of a pointer on 32-bit builds and only this works on both */
+    VkDescriptorSetLayout layouts[]{reinterpret_cast<VkDescriptorSetLayout>(reinterpret_cast<void*>(std::size_t{0xdead}))};
+    VkPushConstantRange ranges[]{
+        {VK_SHADER_STAGE_VERTEX_BIT, 0, 64},
+        {VK_SHADER_STAGE_FRAGMENT_BIT, 64, 16}
+    };
+
+    PipelineLayoutCreateInfo info{layouts, ranges};
+    CORRADE_COMPARE(info->setLayoutCount, 1);
+    CORRADE_COMPARE(info->pSetLayouts[0], reinterpret_cast<VkDescriptorSetLayout>(reinterpret_cast<void*>(std::size_t{0xdead})));
+    CORRADE_COMPARE(info->pushConstantRangeCount, 2);
+    CORRADE_VERIFY(info->pPushConstantRanges);
+    /* The contents should be copied */
+    CORRADE_VERIFY(info->pPushConstantRanges != ranges);
+    CORRADE_COMPARE(info->pPushConstantRanges[1].stageFlags, VK_SHADER_STAGE_FRAGMENT_BIT);
+    CORRADE_COMPARE(info->pPushConstantRanges[1].offset, 64);
+    CORRADE_COMPARE(info->pPushConstantRanges[1].size, 16);
+}
+
 void PipelineLayoutTest::createInfoConstructNoInit() {
     PipelineLayoutCreateInfo info{NoInit};
     info->sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
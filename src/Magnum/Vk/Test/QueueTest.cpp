@@ -24,9 +24,12 @@
 */
 
 #include <new>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/Triple.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/Pipeline.h"
 #include "Magnum/Vk/Queue.h"
 
 namespace Magnum { namespace Vk { namespace Test { namespace {
@@ -43,6 +46,10 @@ struct QueueTest: TestSuite::Tester {
     void submitInfoConstruct();
     void submitInfoConstructNoInit();
     void submitInfoConstructCommandBuffers();
+    void submitInfoConstructWaitSemaphores();
+    void submitInfoConstructWaitSemaphoresTimeline();
+    void submitInfoConstructSignalSemaphores();
+    void submitInfoConstructSignalSemaphoresTimeline();
     void submitInfoConstructFromVk();
     void submitInfoConstructCopy();
     void submitInfoConstructMove();
@@ -58,6 +65,10 @@ QueueTest::QueueTest() {
               &QueueTest::submitInfoConstruct,
               &QueueTest::submitInfoConstructNoInit,
               &QueueTest::submitInfoConstructCommandBuffers,
+              &QueueTest::submitInfoConstructWaitSemaphores,
+              &QueueTest::submitInfoConstructWaitSemaphoresTimeline,
+              &QueueTest::submitInfoConstructSignalSemaphores,
+              &QueueTest::submitInfoConstructSignalSemaphoresTimeline,
               &QueueTest::submitInfoConstructFromVk,
               &QueueTest::submitInfoConstructCopy,
               &QueueTest::submitInfoConstructMove});
@@ -141,6 +152,100 @@ void QueueTest::submitInfoConstructCommandBuffers() {
     CORRADE_COMPARE(info->pCommandBuffers[1], reinterpret_cast<VkCommandBuffer>(reinterpret_cast<void*>(std::size_t{0xcafecafe})));
 }
 
+/* The double reinterpret_cast is needed because the handle is an uint64_t
+   instead of a pointer on 32-bit builds and only this works on both */
+const VkSemaphore SemaphoreA = reinterpret_cast<VkSemaphore>(reinterpret_cast<void*>(std::size_t{0xbadbeef}));
+const VkSemaphore SemaphoreB = reinterpret_cast<VkSemaphore>(reinterpret_cast<void*>(std::size_t{0xcafecafe}));
+
+void QueueTest::submitInfoConstructWaitSemaphores() {
+    SubmitInfo info;
+    info.setWaitSemaphores({
+        {SemaphoreA, PipelineStage::ColorAttachmentOutput},
+        {SemaphoreB, PipelineStage::Transfer|PipelineStage::ComputeShader}
+    });
+
+    CORRADE_VERIFY(!info->pNext);
+    CORRADE_COMPARE(info->waitSemaphoreCount, 2);
+    CORRADE_VERIFY(info->pWaitSemaphores);
+    CORRADE_VERIFY(info->pWaitDstStageMask);
+    CORRADE_COMPARE(info->pWaitSemaphores[0], SemaphoreA);
+    CORRADE_COMPARE(info->pWaitSemaphores[1], SemaphoreB);
+    CORRADE_COMPARE(info->pWaitDstStageMask[0], VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    CORRADE_COMPARE(info->pWaitDstStageMask[1], VK_PIPELINE_STAGE_TRANSFER_BIT|VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+}
+
+void QueueTest::submitInfoConstructWaitSemaphoresTimeline() {
+    SubmitInfo info;
+    info.setWaitSemaphores({
+        {SemaphoreA, 37, PipelineStage::ColorAttachmentOutput},
+        {SemaphoreB, 0, PipelineStage::Transfer}
+    });
+
+    CORRADE_COMPARE(info->waitSemaphoreCount, 2);
+    CORRADE_VERIFY(info->pWaitSemaphores);
+    CORRADE_VERIFY(info->pWaitDstStageMask);
+    CORRADE_COMPARE(info->pWaitSemaphores[1], SemaphoreB);
+    CORRADE_COMPARE(info->pWaitDstStageMask[1], VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+    CORRADE_VERIFY(info->pNext);
+    const auto& timelineInfo = *static_cast<const VkTimelineSemaphoreSubmitInfo*>(info->pNext);
+    CORRADE_COMPARE(timelineInfo.sType, VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO);
+    CORRADE_COMPARE(timelineInfo.waitSemaphoreValueCount, 2);
+    CORRADE_VERIFY(timelineInfo.pWaitSemaphoreValues);
+    CORRADE_COMPARE(timelineInfo.pWaitSemaphoreValues[0], 37);
+    CORRADE_COMPARE(timelineInfo.pWaitSemaphoreValues[1], 0);
+    CORRADE_COMPARE(timelineInfo.signalSemaphoreValueCount, 0);
+
+    /* Setting binary semaphores again discards the values but keeps the
+       structure in the chain */
+    info.setWaitSemaphores({{SemaphoreA, PipelineStage::Transfer}});
+    CORRADE_COMPARE(info->waitSemaphoreCount, 1);
+    CORRADE_VERIFY(info->pNext == &timelineInfo);
+    CORRADE_COMPARE(timelineInfo.waitSemaphoreValueCount, 0);
+    CORRADE_VERIFY(!timelineInfo.pWaitSemaphoreValues);
+}
+
+void QueueTest::submitInfoConstructSignalSemaphores() {
+    SubmitInfo info;
+    info.setSignalSemaphores({SemaphoreA, SemaphoreB});
+
+    CORRADE_VERIFY(!info->pNext);
+    CORRADE_COMPARE(info->signalSemaphoreCount, 2);
+    CORRADE_VERIFY(info->pSignalSemaphores);
+    CORRADE_COMPARE(info->pSignalSemaphores[0], SemaphoreA);
+    CORRADE_COMPARE(info->pSignalSemaphores[1], SemaphoreB);
+}
+
+void QueueTest::submitInfoConstructSignalSemaphoresTimeline() {
+    SubmitInfo info;
+    /* Wait values are set too, the signal values should go into the same
+       structure */
+    info.setWaitSemaphores({{SemaphoreB, 26, PipelineStage::Transfer}})
+        .setSignalSemaphores({{SemaphoreA, 37}, {SemaphoreB, 27}});
+
+    CORRADE_COMPARE(info->signalSemaphoreCount, 2);
+    CORRADE_VERIFY(info->pSignalSemaphores);
+    CORRADE_COMPARE(info->pSignalSemaphores[0], SemaphoreA);
+    CORRADE_COMPARE(info->pSignalSemaphores[1], SemaphoreB);
+
+    CORRADE_VERIFY(info->pNext);
+    const auto& timelineInfo = *static_cast<const VkTimelineSemaphoreSubmitInfo*>(info->pNext);
+    CORRADE_COMPARE(timelineInfo.sType, VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO);
+    CORRADE_VERIFY(!timelineInfo.pNext);
+    CORRADE_COMPARE(timelineInfo.waitSemaphoreValueCount, 1);
+    CORRADE_COMPARE(timelineInfo.signalSemaphoreValueCount, 2);
+    CORRADE_VERIFY(timelineInfo.pSignalSemaphoreValues);
+    CORRADE_COMPARE(timelineInfo.pSignalSemaphoreValues[0], 37);
+    CORRADE_COMPARE(timelineInfo.pSignalSemaphoreValues[1], 27);
+
+    /* Setting binary semaphores again discards the values */
+    info.setSignalSemaphores({SemaphoreA});
+    CORRADE_COMPARE(info->signalSemaphoreCount, 1);
+    CORRADE_COMPARE(timelineInfo.signalSemaphoreValueCount, 0);
+    CORRADE_VERIFY(!timelineInfo.pSignalSemaphoreValues);
+    CORRADE_COMPARE(timelineInfo.waitSemaphoreValueCount, 1);
+}
+
 void QueueTest::submitInfoConstructFromVk() {
     VkSubmitInfo vkInfo;
     vkInfo.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
@@ -0,0 +1,439 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/ImageCreateInfo.h"
+#include "Magnum/Vk/PixelFormat.h"
+#include "Magnum/Vk/RenderGraph.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct RenderGraphTest: TestSuite::Tester {
+    explicit RenderGraphTest();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void addResourcesPasses();
+
+    void cull();
+    void barriers();
+    void barriersWriteAfterRead();
+    void importedHandleChange();
+
+    void addUsageInvalid();
+    void importImageUndefinedFinalLayout();
+    void addPassNullFunction();
+    void setImportedInvalid();
+    void resourceAccessInvalid();
+    void notCompiled();
+
+    void debugUsage();
+};
+
+RenderGraphTest::RenderGraphTest() {
+    addTests({&RenderGraphTest::constructNoCreate,
+              &RenderGraphTest::constructCopy,
+
+              &RenderGraphTest::addResourcesPasses,
+
+              &RenderGraphTest::cull,
+              &RenderGraphTest::barriers,
+              &RenderGraphTest::barriersWriteAfterRead,
+              &RenderGraphTest::importedHandleChange,
+
+              &RenderGraphTest::addUsageInvalid,
+              &RenderGraphTest::importImageUndefinedFinalLayout,
+              &RenderGraphTest::addPassNullFunction,
+              &RenderGraphTest::setImportedInvalid,
+              &RenderGraphTest::resourceAccessInvalid,
+              &RenderGraphTest::notCompiled,
+
+              &RenderGraphTest::debugUsage});
+}
+
+const VkImage ImageA = reinterpret_cast<VkImage>(reinterpret_cast<void*>(std::size_t{0xdead}));
+const VkImage ImageB = reinterpret_cast<VkImage>(reinterpret_cast<void*>(std::size_t{0xbeef}));
+const VkBuffer BufferA = reinterpret_cast<VkBuffer>(reinterpret_cast<void*>(std::size_t{0xcafe}));
+const VkBuffer BufferB = reinterpret_cast<VkBuffer>(reinterpret_cast<void*>(std::size_t{0xf00d}));
+
+/* Passes recording nothing, the tests never call execute() with a real
+   command buffer */
+void nothing(const RenderGraph&, CommandBuffer&, void*) {}
+
+void RenderGraphTest::constructNoCreate() {
+    {
+        RenderGraph graph{NoCreate};
+        CORRADE_COMPARE(graph.resourceCount(), 0);
+        CORRADE_COMPARE(graph.passCount(), 0);
+        CORRADE_VERIFY(!graph.isCompiled());
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, RenderGraph>::value);
+}
+
+void RenderGraphTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<RenderGraph>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<RenderGraph>{});
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<RenderGraph>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<RenderGraph>::value);
+}
+
+void RenderGraphTest::addResourcesPasses() {
+    /* The device is never accessed as long as no transient resource is
+       used by a pass that isn't culled, so NoCreate is fine */
+    Device device{NoCreate};
+
+    RenderGraph graph{device};
+    CORRADE_COMPARE(graph.importImage("swapchain", ImageA, ImageAspect::Color, ImageLayout::Undefined, ImageLayout::ColorAttachment), 0);
+    CORRADE_COMPARE(graph.importBuffer("uniforms", BufferA), 1);
+    CORRADE_COMPARE(graph.addImage("depth", ImageCreateInfo2D{ImageUsage::DepthStencilAttachment, PixelFormat::Depth32F, {256, 256}, 1}, ImageAspect::Depth), 2);
+    CORRADE_COMPARE(graph.addBuffer("scratch", BufferCreateInfo{BufferUsage::StorageBuffer, 1024}), 3);
+    CORRADE_COMPARE(graph.addPass("main", nothing), 0);
+    CORRADE_COMPARE(graph.addPass("post", nothing), 1);
+    CORRADE_COMPARE(graph.resourceCount(), 4);
+    CORRADE_COMPARE(graph.passCount(), 2);
+    CORRADE_VERIFY(!graph.isCompiled());
+
+    /* Imported handles are available right away */
+    CORRADE_COMPARE(graph.image(0), ImageA);
+    CORRADE_COMPARE(graph.buffer(1), BufferA);
+
+    graph.compile();
+    CORRADE_VERIFY(graph.isCompiled());
+
+    /* Any modification invalidates the compiled state */
+    graph.addRead(0, 1, RenderGraphUsage::UniformBuffer);
+    CORRADE_VERIFY(!graph.isCompiled());
+}
+
+void RenderGraphTest::cull() {
+    Device device{NoCreate};
+
+    RenderGraph graph{device};
+    UnsignedInt source = graph.importBuffer("source", BufferA);
+    UnsignedInt destination = graph.importBuffer("destination", BufferB);
+    UnsignedInt unused = graph.addImage("unused", ImageCreateInfo2D{ImageUsage::ColorAttachment, PixelFormat::RGBA8Unorm, {256, 256}, 1}, ImageAspect::Color);
+    UnsignedInt intermediate = graph.addBuffer("intermediate", BufferCreateInfo{BufferUsage::StorageBuffer, 1024});
+
+    /* Written but never read */
+    UnsignedInt unusedPass = graph.addPass("unused", nothing);
+    graph.addWrite(unusedPass, unused, RenderGraphUsage::ColorAttachment);
+
+    /* Writes an imported buffer */
+    UnsignedInt copy = graph.addPass("copy", nothing);
+    graph.addRead(copy, source, RenderGraphUsage::TransferSource)
+         .addWrite(copy, destination, RenderGraphUsage::TransferDestination);
+
+    /* Doesn't declare anything, so it's kept */
+    UnsignedInt opaque = graph.addPass("opaque", nothing);
+
+    /* Writes a transient resource that's read only by a pass that's culled,
+       so it's culled as well */
+    UnsignedInt intermediatePass = graph.addPass("intermediate", nothing);
+    graph.addWrite(intermediatePass, intermediate, RenderGraphUsage::Storage);
+
+    /* Only reads */
+    UnsignedInt readOnly = graph.addPass("read-only", nothing);
+    graph.addRead(readOnly, destination, RenderGraphUsage::VertexBuffer)
+         .addRead(readOnly, intermediate, RenderGraphUsage::Storage);
+
+    graph.compile();
+    CORRADE_COMPARE_AS(graph.passOrder(), Containers::arrayView({
+        copy, opaque
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(graph.isPassCulled(unusedPass));
+    CORRADE_VERIFY(!graph.isPassCulled(copy));
+    CORRADE_VERIFY(!graph.isPassCulled(opaque));
+    CORRADE_VERIFY(graph.isPassCulled(intermediatePass));
+    CORRADE_VERIFY(graph.isPassCulled(readOnly));
+
+    /* Transient resources not used by any remaining pass aren't created */
+    CORRADE_COMPARE(graph.image(unused), VkImage{});
+    CORRADE_COMPARE(graph.buffer(intermediate), VkBuffer{});
+    CORRADE_COMPARE(graph.transientMemorySize(), 0);
+    CORRADE_COMPARE(graph.transientMemorySizeUnaliased(), 0);
+    CORRADE_COMPARE(graph.barrierCount(), 0);
+
+    CORRADE_COMPARE(graph.dump(),
+        "Vk::RenderGraph: 5 passes, 3 culled, 0 transient resources in 0 allocations\n"
+        "  Pass 1 copy:\n"
+        "    read source as Vk::RenderGraphUsage::TransferSource\n"
+        "    write destination as Vk::RenderGraphUsage::TransferDestination\n"
+        "  Pass 2 opaque:\n"
+        "  Culled pass 0 unused\n"
+        "  Culled pass 3 intermediate\n"
+        "  Culled pass 4 read-only\n"
+        "  Transient memory: 0 bytes, 0 bytes without aliasing");
+}
+
+void RenderGraphTest::barriers() {
+    Device device{NoCreate};
+
+    RenderGraph graph{device};
+    UnsignedInt color = graph.importImage("color", ImageA, ImageAspect::Color, ImageLayout::Undefined, ImageLayout::TransferSource);
+    UnsignedInt data = graph.importBuffer("data", BufferA);
+    UnsignedInt result = graph.importBuffer("result", BufferB);
+
+    UnsignedInt draw = graph.addPass("draw", nothing);
+    graph.addWrite(draw, color, RenderGraphUsage::ColorAttachment);
+
+    /* Layout transition */
+    UnsignedInt blur = graph.addPass("blur", nothing);
+    graph.addRead(blur, color, RenderGraphUsage::Sampled)
+         .addWrite(blur, data, RenderGraphUsage::Storage);
+
+    /* Same layout and same stages, no barrier for the image. Read after
+       write of the buffer needs a barrier. */
+    UnsignedInt copy = graph.addPass("copy", nothing);
+    graph.addRead(copy, color, RenderGraphUsage::Sampled)
+         .addRead(copy, data, RenderGraphUsage::TransferSource)
+         .addWrite(copy, result, RenderGraphUsage::TransferDestination);
+
+    graph.compile();
+
+    /* Two transitions, one buffer barrier, one final transition */
+    CORRADE_COMPARE(graph.barrierCount(), 4);
+    CORRADE_COMPARE(graph.dump(),
+        "Vk::RenderGraph: 3 passes, 0 culled, 0 transient resources in 0 allocations\n"
+        "  Pass 0 draw:\n"
+        "    barrier color: Undefined -> ColorAttachment\n"
+        "    write color as Vk::RenderGraphUsage::ColorAttachment\n"
+        "  Pass 1 blur:\n"
+        "    barrier color: ColorAttachment -> ShaderReadOnly\n"
+        "    read color as Vk::RenderGraphUsage::Sampled\n"
+        "    write data as Vk::RenderGraphUsage::Storage\n"
+        "  Pass 2 copy:\n"
+        "    barrier data\n"
+        "    read color as Vk::RenderGraphUsage::Sampled\n"
+        "    read data as Vk::RenderGraphUsage::TransferSource\n"
+        "    write result as Vk::RenderGraphUsage::TransferDestination\n"
+        "  Final:\n"
+        "    barrier color: ShaderReadOnly -> TransferSource\n"
+        "  Transient memory: 0 bytes, 0 bytes without aliasing");
+}
+
+void RenderGraphTest::barriersWriteAfterRead() {
+    Device device{NoCreate};
+
+    RenderGraph graph{device};
+    UnsignedInt vertices = graph.importBuffer("vertices", BufferA);
+    UnsignedInt depth = graph.importImage("depth", ImageA, ImageAspect::Depth, ImageLayout::DepthStencilAttachment, ImageLayout::DepthStencilAttachment);
+
+    /* Depth read & written in the same pass, merged into a single usage */
+    UnsignedInt draw = graph.addPass("draw", nothing);
+    graph.addRead(draw, vertices, RenderGraphUsage::VertexBuffer)
+         .addRead(draw, depth, RenderGraphUsage::DepthStencilAttachment)
+         .addWrite(draw, depth, RenderGraphUsage::DepthStencilAttachment);
+
+    /* Write after read of the vertex buffer needs an execution dependency,
+       depth stays in the same layout and is written again, thus needs a
+       barrier as well */
+    UnsignedInt update = graph.addPass("update", nothing);
+    graph.addWrite(update, vertices, RenderGraphUsage::TransferDestination)
+         .addWrite(update, depth, RenderGraphUsage::DepthStencilAttachment);
+
+    graph.compile();
+    CORRADE_COMPARE(graph.barrierCount(), 2);
+    CORRADE_COMPARE(graph.dump(),
+        "Vk::RenderGraph: 2 passes, 0 culled, 0 transient resources in 0 allocations\n"
+        "  Pass 0 draw:\n"
+        "    read vertices as Vk::RenderGraphUsage::VertexBuffer\n"
+        "    read depth as Vk::RenderGraphUsage::DepthStencilAttachment\n"
+        "    write depth as Vk::RenderGraphUsage::DepthStencilAttachment\n"
+        "  Pass 1 update:\n"
+        "    barrier vertices\n"
+        "    barrier depth: DepthStencilAttachment\n"
+        "    write vertices as Vk::RenderGraphUsage::TransferDestination\n"
+        "    write depth as Vk::RenderGraphUsage::DepthStencilAttachment\n"
+        "  Transient memory: 0 bytes, 0 bytes without aliasing");
+}
+
+void RenderGraphTest::importedHandleChange() {
+    Device device{NoCreate};
+
+    RenderGraph graph{device};
+    UnsignedInt image = graph.importImage("image", ImageA, ImageAspect::Color, ImageLayout::Undefined, ImageLayout::TransferSource);
+    UnsignedInt buffer = graph.importBuffer("buffer", BufferA);
+    graph.compile();
+
+    graph.setImportedImage(image, ImageB)
+         .setImportedBuffer(buffer, BufferB);
+    CORRADE_COMPARE(graph.image(image), ImageB);
+    CORRADE_COMPARE(graph.buffer(buffer), BufferB);
+
+    /* Doesn't invalidate the compiled state */
+    CORRADE_VERIFY(graph.isCompiled());
+}
+
+void RenderGraphTest::addUsageInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Device device{NoCreate};
+
+    RenderGraph graph{device};
+    UnsignedInt image = graph.importImage("image", ImageA, ImageAspect::Color, ImageLayout::Undefined, ImageLayout::General);
+    UnsignedInt buffer = graph.importBuffer("buffer", BufferA);
+    UnsignedInt pass = graph.addPass("pass", nothing);
+    graph.addWrite(pass, image, RenderGraphUsage::ColorAttachment);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.addRead(1, image, RenderGraphUsage::Sampled);
+    graph.addWrite(pass, 2, RenderGraphUsage::Storage);
+    graph.addRead(pass, image, RenderGraphUsage::VertexBuffer);
+    graph.addWrite(pass, buffer, RenderGraphUsage::Sampled);
+    graph.addRead(pass, buffer, RenderGraphUsage::TransferDestination);
+    graph.addWrite(pass, buffer, RenderGraphUsage::UniformBuffer);
+    graph.addRead(pass, image, RenderGraphUsage::Sampled);
+    CORRADE_COMPARE(out.str(),
+        "Vk::RenderGraph::addRead(): index 1 out of range for 1 passes\n"
+        "Vk::RenderGraph::addWrite(): index 2 out of range for 2 resources\n"
+        "Vk::RenderGraph::addRead(): Vk::RenderGraphUsage::VertexBuffer is not applicable to an image\n"
+        "Vk::RenderGraph::addWrite(): Vk::RenderGraphUsage::Sampled is not applicable to a buffer\n"
+        "Vk::RenderGraph::addRead(): Vk::RenderGraphUsage::TransferDestination is write-only\n"
+        "Vk::RenderGraph::addWrite(): Vk::RenderGraphUsage::UniformBuffer is read-only\n"
+        "Vk::RenderGraph::addRead(): Vk::RenderGraphUsage::Sampled conflicts with a layout of an earlier usage of resource 0 in pass 0\n");
+}
+
+void RenderGraphTest::importImageUndefinedFinalLayout() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Device device{NoCreate};
+    RenderGraph graph{device};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.importImage("image", ImageA, ImageAspect::Color, ImageLayout::General, ImageLayout::Undefined);
+    CORRADE_COMPARE(out.str(), "Vk::RenderGraph::importImage(): final layout can't be undefined\n");
+}
+
+void RenderGraphTest::addPassNullFunction() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Device device{NoCreate};
+    RenderGraph graph{device};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.addPass("pass", nullptr);
+    CORRADE_COMPARE(out.str(), "Vk::RenderGraph::addPass(): the function is null\n");
+}
+
+void RenderGraphTest::setImportedInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Device device{NoCreate};
+    RenderGraph graph{device};
+    UnsignedInt image = graph.importImage("image", ImageA, ImageAspect::Color, ImageLayout::Undefined, ImageLayout::General);
+    UnsignedInt transient = graph.addBuffer("transient", BufferCreateInfo{BufferUsage::StorageBuffer, 1024});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.setImportedImage(2, ImageB);
+    graph.setImportedImage(transient, ImageB);
+    graph.setImportedBuffer(2, BufferB);
+    graph.setImportedBuffer(image, BufferB);
+    CORRADE_COMPARE(out.str(),
+        "Vk::RenderGraph::setImportedImage(): index 2 out of range for 2 resources\n"
+        "Vk::RenderGraph::setImportedImage(): resource 1 is not an imported image\n"
+        "Vk::RenderGraph::setImportedBuffer(): index 2 out of range for 2 resources\n"
+        "Vk::RenderGraph::setImportedBuffer(): resource 0 is not an imported buffer\n");
+}
+
+void RenderGraphTest::resourceAccessInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Device device{NoCreate};
+    RenderGraph graph{device};
+    UnsignedInt image = graph.importImage("image", ImageA, ImageAspect::Color, ImageLayout::Undefined, ImageLayout::General);
+    UnsignedInt buffer = graph.importBuffer("buffer", BufferA);
+    graph.compile();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.image(2);
+    graph.image(buffer);
+    graph.buffer(2);
+    graph.buffer(image);
+    graph.isPassCulled(0);
+    CORRADE_COMPARE(out.str(),
+        "Vk::RenderGraph::image(): index 2 out of range for 2 resources\n"
+        "Vk::RenderGraph::image(): resource 1 is not an image\n"
+        "Vk::RenderGraph::buffer(): index 2 out of range for 2 resources\n"
+        "Vk::RenderGraph::buffer(): resource 0 is not a buffer\n"
+        "Vk::RenderGraph::isPassCulled(): index 0 out of range for 0 passes\n");
+}
+
+void RenderGraphTest::notCompiled() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Device device{NoCreate};
+    RenderGraph graph{device};
+    UnsignedInt image = graph.addImage("image", ImageCreateInfo2D{ImageUsage::ColorAttachment, PixelFormat::RGBA8Unorm, {256, 256}, 1}, ImageAspect::Color);
+    UnsignedInt buffer = graph.addBuffer("buffer", BufferCreateInfo{BufferUsage::StorageBuffer, 1024});
+    CommandBuffer cmd{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.execute(cmd);
+    graph.image(image);
+    graph.buffer(buffer);
+    graph.passOrder();
+    graph.isPassCulled(0);
+    graph.barrierCount();
+    graph.transientMemorySize();
+    graph.transientMemorySizeUnaliased();
+    graph.dump();
+    CORRADE_COMPARE(out.str(),
+        "Vk::RenderGraph::execute(): the graph is not compiled\n"
+        "Vk::RenderGraph::image(): the graph is not compiled\n"
+        "Vk::RenderGraph::buffer(): the graph is not compiled\n"
+        "Vk::RenderGraph::passOrder(): the graph is not compiled\n"
+        "Vk::RenderGraph::isPassCulled(): the graph is not compiled\n"
+        "Vk::RenderGraph::barrierCount(): the graph is not compiled\n"
+        "Vk::RenderGraph::transientMemorySize(): the graph is not compiled\n"
+        "Vk::RenderGraph::transientMemorySizeUnaliased(): the graph is not compiled\n"
+        "Vk::RenderGraph::dump(): the graph is not compiled\n");
+}
+
+void RenderGraphTest::debugUsage() {
+    std::ostringstream out;
+    Debug{&out} << RenderGraphUsage::DepthStencilAttachment << RenderGraphUsage(0xde);
+    CORRADE_COMPARE(out.str(), "Vk::RenderGraphUsage::DepthStencilAttachment Vk::RenderGraphUsage(222)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::RenderGraphTest)
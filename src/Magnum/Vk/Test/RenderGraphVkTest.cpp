@@ -0,0 +1,231 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Fence.h"
+#include "Magnum/Vk/ImageCreateInfo.h"
+#include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/PixelFormat.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/RenderGraph.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct RenderGraphVkTest: VulkanTester {
+    explicit RenderGraphVkTest();
+
+    void transientBuffers();
+    void transientImage();
+    void recompile();
+};
+
+using namespace Containers::Literals;
+using namespace Math::Literals;
+
+RenderGraphVkTest::RenderGraphVkTest() {
+    addTests({&RenderGraphVkTest::transientBuffers,
+              &RenderGraphVkTest::transientImage,
+              &RenderGraphVkTest::recompile});
+}
+
+struct BufferResources {
+    UnsignedInt a, b, c, out;
+};
+
+void RenderGraphVkTest::transientBuffers() {
+    Buffer out{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 8
+    }, MemoryFlag::HostVisible};
+
+    RenderGraph graph{device()};
+    BufferResources resources;
+    resources.a = graph.addBuffer("a", BufferCreateInfo{BufferUsage::TransferDestination, 4096});
+    resources.b = graph.addBuffer("b", BufferCreateInfo{BufferUsage::TransferDestination, 4096});
+    resources.c = graph.addBuffer("c", BufferCreateInfo{BufferUsage::TransferDestination, 4096});
+    resources.out = graph.importBuffer("out", out);
+
+    /* A is alive only in the first two passes, C only in the last two, so
+       they can share the same memory */
+    UnsignedInt fillA = graph.addPass("fill a", [](const RenderGraph& graph, CommandBuffer& cmd, void* state) {
+        cmd.fillBuffer(graph.buffer(static_cast<BufferResources*>(state)->a), 0x01010101);
+    }, &resources);
+    graph.addWrite(fillA, resources.a, RenderGraphUsage::TransferDestination);
+
+    UnsignedInt copyAB = graph.addPass("copy a to b", [](const RenderGraph& graph, CommandBuffer& cmd, void* state) {
+        auto& resources = *static_cast<BufferResources*>(state);
+        cmd.copyBuffer({graph.buffer(resources.a), graph.buffer(resources.b), {{0, 0, 4096}}});
+    }, &resources);
+    graph.addRead(copyAB, resources.a, RenderGraphUsage::TransferSource)
+         .addWrite(copyAB, resources.b, RenderGraphUsage::TransferDestination);
+
+    UnsignedInt fillC = graph.addPass("fill c", [](const RenderGraph& graph, CommandBuffer& cmd, void* state) {
+        cmd.fillBuffer(graph.buffer(static_cast<BufferResources*>(state)->c), 0x03030303);
+    }, &resources);
+    graph.addWrite(fillC, resources.c, RenderGraphUsage::TransferDestination);
+
+    UnsignedInt resolve = graph.addPass("resolve", [](const RenderGraph& graph, CommandBuffer& cmd, void* state) {
+        auto& resources = *static_cast<BufferResources*>(state);
+        cmd.copyBuffer({graph.buffer(resources.b), graph.buffer(resources.out), {{0, 0, 4}}})
+           .copyBuffer({graph.buffer(resources.c), graph.buffer(resources.out), {{0, 4, 4}}});
+    }, &resources);
+    graph.addRead(resolve, resources.b, RenderGraphUsage::TransferSource)
+         .addRead(resolve, resources.c, RenderGraphUsage::TransferSource)
+         .addWrite(resolve, resources.out, RenderGraphUsage::TransferDestination);
+
+    graph.compile();
+    CORRADE_COMPARE(graph.passOrder().size(), 4);
+    CORRADE_VERIFY(graph.buffer(resources.a));
+    CORRADE_VERIFY(graph.buffer(resources.b));
+    CORRADE_VERIFY(graph.buffer(resources.c));
+    CORRADE_COMPARE_AS(graph.transientMemorySize(), graph.transientMemorySizeUnaliased(),
+        TestSuite::Compare::Less);
+
+    CommandPool pool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+    CommandBuffer cmd = pool.allocate();
+    cmd.begin();
+    graph.execute(cmd);
+    cmd.pipelineBarrier(PipelineStage::Transfer, PipelineStage::Host, {
+           {Access::TransferWrite, Access::HostRead}
+        })
+       .end();
+    queue().submit({SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+
+    CORRADE_COMPARE(arrayView(out.dedicatedMemory().mapRead()),
+        "\x01\x01\x01\x01\x03\x03\x03\x03"_s);
+}
+
+struct ImageResources {
+    UnsignedInt image, out;
+};
+
+void RenderGraphVkTest::transientImage() {
+    Buffer out{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 4*4*4
+    }, MemoryFlag::HostVisible};
+
+    RenderGraph graph{device()};
+    ImageResources resources;
+    /* The usage gets extended with TransferSource by the graph */
+    resources.image = graph.addImage("image", ImageCreateInfo2D{ImageUsage::TransferDestination, PixelFormat::RGBA8Unorm, {4, 4}, 1}, ImageAspect::Color);
+    resources.out = graph.importBuffer("out", out);
+
+    UnsignedInt clear = graph.addPass("clear", [](const RenderGraph& graph, CommandBuffer& cmd, void* state) {
+        cmd.clearColorImage(graph.image(static_cast<ImageResources*>(state)->image), ImageLayout::TransferDestination, 0xdeadc0de_rgbaf);
+    }, &resources);
+    graph.addWrite(clear, resources.image, RenderGraphUsage::TransferDestination);
+
+    UnsignedInt download = graph.addPass("download", [](const RenderGraph& graph, CommandBuffer& cmd, void* state) {
+        auto& resources = *static_cast<ImageResources*>(state);
+        cmd.copyImageToBuffer({graph.image(resources.image), ImageLayout::TransferSource, graph.buffer(resources.out), {
+            BufferImageCopy2D{0, ImageAspect::Color, 0, {{}, {4, 4}}}
+        }});
+    }, &resources);
+    graph.addRead(download, resources.image, RenderGraphUsage::TransferSource)
+         .addWrite(download, resources.out, RenderGraphUsage::TransferDestination);
+
+    graph.compile();
+    CORRADE_VERIFY(graph.image(resources.image));
+    /* Undefined -> TransferDestination, TransferDestination -> TransferSource */
+    CORRADE_COMPARE(graph.barrierCount(), 2);
+
+    CommandPool pool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+    CommandBuffer cmd = pool.allocate();
+    cmd.begin();
+    graph.execute(cmd);
+    cmd.pipelineBarrier(PipelineStage::Transfer, PipelineStage::Host, {
+           {Access::TransferWrite, Access::HostRead}
+        })
+       .end();
+    queue().submit({SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+
+    CORRADE_COMPARE(arrayView(out.dedicatedMemory().mapRead()).prefix(8),
+        "\xde\xad\xc0\xde\xde\xad\xc0\xde"_s);
+}
+
+void RenderGraphVkTest::recompile() {
+    Buffer out{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 4
+    }, MemoryFlag::HostVisible};
+
+    RenderGraph graph{device()};
+    BufferResources resources;
+    resources.a = graph.addBuffer("a", BufferCreateInfo{BufferUsage::TransferDestination, 1024});
+    resources.out = graph.importBuffer("out", out);
+
+    UnsignedInt fill = graph.addPass("fill", [](const RenderGraph& graph, CommandBuffer& cmd, void* state) {
+        cmd.fillBuffer(graph.buffer(static_cast<BufferResources*>(state)->a), 0x05050505);
+    }, &resources);
+    graph.addWrite(fill, resources.a, RenderGraphUsage::TransferDestination);
+
+    graph.compile();
+
+    /* Nothing reads the transient buffer, so it's not created */
+    CORRADE_VERIFY(graph.isPassCulled(fill));
+    CORRADE_VERIFY(!graph.buffer(resources.a));
+    CORRADE_COMPARE(graph.transientMemorySize(), 0);
+
+    UnsignedInt copy = graph.addPass("copy", [](const RenderGraph& graph, CommandBuffer& cmd, void* state) {
+        auto& resources = *static_cast<BufferResources*>(state);
+        cmd.copyBuffer({graph.buffer(resources.a), graph.buffer(resources.out), {{0, 0, 4}}});
+    }, &resources);
+    graph.addRead(copy, resources.a, RenderGraphUsage::TransferSource)
+         .addWrite(copy, resources.out, RenderGraphUsage::TransferDestination);
+    CORRADE_VERIFY(!graph.isCompiled());
+
+    graph.compile();
+    CORRADE_VERIFY(!graph.isPassCulled(fill));
+    CORRADE_VERIFY(graph.buffer(resources.a));
+    CORRADE_COMPARE_AS(graph.transientMemorySize(), 1024,
+        TestSuite::Compare::GreaterOrEqual);
+
+    CommandPool pool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+    CommandBuffer cmd = pool.allocate();
+    cmd.begin();
+    graph.execute(cmd);
+    cmd.pipelineBarrier(PipelineStage::Transfer, PipelineStage::Host, {
+           {Access::TransferWrite, Access::HostRead}
+        })
+       .end();
+    queue().submit({SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+
+    CORRADE_COMPARE(arrayView(out.dedicatedMemory().mapRead()), "\x05\x05\x05\x05"_s);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::RenderGraphVkTest)
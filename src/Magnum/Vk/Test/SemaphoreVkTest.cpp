@@ -0,0 +1,279 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Containers/Triple.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/DeviceCreateInfo.h"
+#include "Magnum/Vk/DeviceFeatures.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Extensions.h"
+#include "Magnum/Vk/Fence.h"
+#include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/Result.h"
+#include "Magnum/Vk/SemaphoreCreateInfo.h"
+#include "Magnum/Vk/Version.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct SemaphoreVkTest: VulkanTester {
+    explicit SemaphoreVkTest();
+
+    void setupTimeline();
+    void teardown();
+
+    void construct();
+    void constructMove();
+
+    void wrap();
+
+    void submitBinary();
+
+    void constructTimeline();
+    void timelineSignalWait();
+    void timelineWaitTimeout();
+    void timelineSubmit();
+
+    Queue _queueTimeline{NoCreate};
+    Device _deviceTimeline{NoCreate};
+};
+
+using namespace Containers::Literals;
+
+SemaphoreVkTest::SemaphoreVkTest() {
+    addTests({&SemaphoreVkTest::construct,
+              &SemaphoreVkTest::constructMove,
+
+              &SemaphoreVkTest::wrap,
+
+              &SemaphoreVkTest::submitBinary});
+
+    addTests({&SemaphoreVkTest::constructTimeline,
+              &SemaphoreVkTest::timelineSignalWait,
+              &SemaphoreVkTest::timelineWaitTimeout,
+              &SemaphoreVkTest::timelineSubmit},
+        &SemaphoreVkTest::setupTimeline,
+        &SemaphoreVkTest::teardown);
+}
+
+void SemaphoreVkTest::setupTimeline() {
+    DeviceProperties properties = pickDevice(instance());
+    if(!(properties.features() & DeviceFeature::TimelineSemaphore))
+        return;
+
+    /* Create the device only if not already, to avoid spamming the output */
+    if(_deviceTimeline.handle()) return;
+
+    /* On 1.1 and older the feature comes from the extension */
+    const bool needsExtension = !properties.isVersionSupported(Version::Vk12);
+    DeviceCreateInfo info{Utility::move(properties)};
+    info.addQueues(QueueFlag::Graphics, {0.0f}, {_queueTimeline})
+        .setEnabledFeatures(DeviceFeature::TimelineSemaphore);
+    if(needsExtension)
+        info.addEnabledExtensions<Extensions::KHR::timeline_semaphore>();
+    _deviceTimeline.create(instance(), Utility::move(info));
+}
+
+void SemaphoreVkTest::teardown() {
+    /* Nothing, the device & queue created by setupTimeline() is created just
+       once and so shouldn't be destroyed right after */
+}
+
+void SemaphoreVkTest::construct() {
+    {
+        Semaphore semaphore{device()};
+        CORRADE_VERIFY(semaphore.handle());
+        CORRADE_COMPARE(semaphore.handleFlags(), HandleFlag::DestroyOnDestruction);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void SemaphoreVkTest::constructMove() {
+    Semaphore a{device()};
+    VkSemaphore handle = a.handle();
+
+    Semaphore b = Utility::move(a);
+    CORRADE_VERIFY(!a.handle());
+    CORRADE_COMPARE(b.handle(), handle);
+    CORRADE_COMPARE(b.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    Semaphore c{NoCreate};
+    c = Utility::move(b);
+    CORRADE_VERIFY(!b.handle());
+    CORRADE_COMPARE(b.handleFlags(), HandleFlags{});
+    CORRADE_COMPARE(c.handle(), handle);
+    CORRADE_COMPARE(c.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<Semaphore>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<Semaphore>::value);
+}
+
+void SemaphoreVkTest::wrap() {
+    VkSemaphore semaphore{};
+    CORRADE_COMPARE(Result(device()->CreateSemaphore(device(),
+        SemaphoreCreateInfo{},
+        nullptr, &semaphore)), Result::Success);
+
+    auto wrapped = Semaphore::wrap(device(), semaphore, HandleFlag::DestroyOnDestruction);
+    CORRADE_COMPARE(wrapped.handle(), semaphore);
+
+    /* Release the handle again, destroy by hand */
+    CORRADE_COMPARE(wrapped.release(), semaphore);
+    CORRADE_VERIFY(!wrapped.handle());
+    device()->DestroySemaphore(device(), semaphore, nullptr);
+}
+
+void SemaphoreVkTest::submitBinary() {
+    CommandPool pool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+
+    Buffer buffer{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 8
+    }, MemoryFlag::HostVisible};
+
+    /* The second command buffer overwrites half of what the first wrote, the
+       semaphore ensures they're ordered */
+    CommandBuffer a = pool.allocate();
+    a.begin()
+     .fillBuffer(buffer, 0x01010101)
+     .end();
+    CommandBuffer b = pool.allocate();
+    b.begin()
+     .fillBuffer(buffer, 4, 4, 0x02020202)
+     .pipelineBarrier(PipelineStage::Transfer, PipelineStage::Host, {
+        {Access::TransferWrite, Access::HostRead}
+      }, {}, {})
+     .end();
+
+    Semaphore semaphore{device()};
+    queue().submit({
+        SubmitInfo{}
+            .setCommandBuffers({a})
+            .setSignalSemaphores({semaphore}),
+        SubmitInfo{}
+            .setWaitSemaphores({{semaphore, PipelineStage::Transfer}})
+            .setCommandBuffers({b})
+    }).wait();
+
+    CORRADE_COMPARE(arrayView(buffer.dedicatedMemory().mapRead()),
+        "\x01\x01\x01\x01\x02\x02\x02\x02"_s);
+}
+
+void SemaphoreVkTest::constructTimeline() {
+    if(!_deviceTimeline.handle())
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    {
+        Semaphore semaphore{_deviceTimeline, SemaphoreCreateInfo{
+            SemaphoreCreateInfo::Type::Timeline, 37}};
+        CORRADE_VERIFY(semaphore.handle());
+        CORRADE_COMPARE(semaphore.handleFlags(), HandleFlag::DestroyOnDestruction);
+        CORRADE_COMPARE(semaphore.value(), 37);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void SemaphoreVkTest::timelineSignalWait() {
+    if(!_deviceTimeline.handle())
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    Semaphore semaphore{_deviceTimeline, SemaphoreCreateInfo{
+        SemaphoreCreateInfo::Type::Timeline}};
+    CORRADE_COMPARE(semaphore.value(), 0);
+
+    semaphore.signal(5);
+    CORRADE_COMPARE(semaphore.value(), 5);
+
+    /* Waiting for a value that was already reached returns immediately */
+    CORRADE_VERIFY(semaphore.wait(3, std::chrono::nanoseconds{}));
+    CORRADE_VERIFY(semaphore.wait(5, std::chrono::nanoseconds{}));
+    semaphore.wait(5);
+}
+
+void SemaphoreVkTest::timelineWaitTimeout() {
+    if(!_deviceTimeline.handle())
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    Semaphore semaphore{_deviceTimeline, SemaphoreCreateInfo{
+        SemaphoreCreateInfo::Type::Timeline, 2}};
+    CORRADE_VERIFY(!semaphore.wait(3, std::chrono::milliseconds{1}));
+}
+
+void SemaphoreVkTest::timelineSubmit() {
+    if(!_deviceTimeline.handle())
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    CommandPool pool{_deviceTimeline, CommandPoolCreateInfo{
+        _deviceTimeline.properties().pickQueueFamily(QueueFlag::Graphics)}};
+
+    Buffer buffer{_deviceTimeline, BufferCreateInfo{
+        BufferUsage::TransferDestination, 8
+    }, MemoryFlag::HostVisible};
+    Utility::copy("abcdefgh"_s, buffer.dedicatedMemory().map());
+
+    CommandBuffer cmd = pool.allocate();
+    cmd.begin()
+       .fillBuffer(buffer, 0x03030303)
+       .pipelineBarrier(PipelineStage::Transfer, PipelineStage::Host, {
+          {Access::TransferWrite, Access::HostRead}
+        }, {}, {})
+       .end();
+
+    /* The submit waits for value 1 and signals 2 */
+    Semaphore semaphore{_deviceTimeline, SemaphoreCreateInfo{
+        SemaphoreCreateInfo::Type::Timeline}};
+    _queueTimeline.submit({SubmitInfo{}
+        .setWaitSemaphores({{semaphore, 1, PipelineStage::Transfer}})
+        .setCommandBuffers({cmd})
+        .setSignalSemaphores({{semaphore, 2}})
+    }, {});
+
+    /* Nothing executes until the host signals the value the submit waits
+       for */
+    CORRADE_VERIFY(!semaphore.wait(2, std::chrono::milliseconds{10}));
+    CORRADE_COMPARE(arrayView(buffer.dedicatedMemory().mapRead()),
+        "abcdefgh"_s);
+
+    semaphore.signal(1);
+    CORRADE_VERIFY(semaphore.wait(2, std::chrono::milliseconds{1000}));
+    CORRADE_COMPARE(semaphore.value(), 2);
+    CORRADE_COMPARE(arrayView(buffer.dedicatedMemory().mapRead()),
+        "\x03\x03\x03\x03\x03\x03\x03\x03"_s);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::SemaphoreVkTest)
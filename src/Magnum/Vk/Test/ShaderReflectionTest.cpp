@@ -0,0 +1,654 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Vk/DescriptorSetLayoutCreateInfo.h"
+#include "Magnum/Vk/DescriptorType.h"
+#include "Magnum/Vk/MeshLayout.h"
+#include "Magnum/Vk/Shader.h"
+#include "Magnum/Vk/ShaderReflection.h"
+#include "MagnumExternal/Vulkan/spirv.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct ShaderReflectionTest: TestSuite::Tester {
+    explicit ShaderReflectionTest();
+
+    void construct();
+    void constructCopy();
+    void constructMove();
+
+    void descriptors();
+    void mergeStages();
+    void mergeStagesNoInterfaceFiltering();
+    void mergeConflict();
+    void pushConstants();
+    void vertexInputs();
+
+    void invalidSpirv();
+    void invalidInstruction();
+    void entrypointNotFound();
+    void unsupportedDescriptorType();
+    void unsupportedVertexInputType();
+
+    void descriptorSetLayoutCreateInfo();
+    void descriptorSetLayoutCreateInfoOutOfRange();
+    void meshLayout();
+};
+
+ShaderReflectionTest::ShaderReflectionTest() {
+    addTests({&ShaderReflectionTest::construct,
+              &ShaderReflectionTest::constructCopy,
+              &ShaderReflectionTest::constructMove,
+
+              &ShaderReflectionTest::descriptors,
+              &ShaderReflectionTest::mergeStages,
+              &ShaderReflectionTest::mergeStagesNoInterfaceFiltering,
+              &ShaderReflectionTest::mergeConflict,
+              &ShaderReflectionTest::pushConstants,
+              &ShaderReflectionTest::vertexInputs,
+
+              &ShaderReflectionTest::invalidSpirv,
+              &ShaderReflectionTest::invalidInstruction,
+              &ShaderReflectionTest::entrypointNotFound,
+              &ShaderReflectionTest::unsupportedDescriptorType,
+              &ShaderReflectionTest::unsupportedVertexInputType,
+
+              &ShaderReflectionTest::descriptorSetLayoutCreateInfo,
+              &ShaderReflectionTest::descriptorSetLayoutCreateInfoOutOfRange,
+              &ShaderReflectionTest::meshLayout});
+}
+
+constexpr UnsignedInt op(UnsignedInt length, SpvOp op) {
+    return length << 16 | op;
+}
+
+/* Entrypoint names are all three characters so they fit into a single word
+   together with the null terminator */
+constexpr UnsignedInt Ver = 'v' | 'e' << 8 | 'r' << 16;
+constexpr UnsignedInt Geo = 'g' | 'e' << 8 | 'o' << 16;
+constexpr UnsignedInt Fra = 'f' | 'r' << 8 | 'a' << 16;
+
+/* Various descriptor types in a single fragment shader, SPIR-V 1.0 */
+constexpr UnsignedInt DescriptorsSpirv[] {
+    SpvMagicNumber, 0x00010000, 0, 40, 0,
+    op(4, SpvOpEntryPoint), SpvExecutionModelFragment, 1, Fra,
+
+    op(4, SpvOpDecorate), 6, SpvDecorationDescriptorSet, 0,
+    op(4, SpvOpDecorate), 6, SpvDecorationBinding, 1,
+    op(4, SpvOpDecorate), 9, SpvDecorationDescriptorSet, 0,
+    op(4, SpvOpDecorate), 9, SpvDecorationBinding, 3,
+    op(4, SpvOpDecorate), 12, SpvDecorationDescriptorSet, 1,
+    op(4, SpvOpDecorate), 12, SpvDecorationBinding, 0,
+    op(3, SpvOpDecorate), 13, SpvDecorationBlock,
+    op(5, SpvOpMemberDecorate), 13, 0, SpvDecorationOffset, 0,
+    op(4, SpvOpDecorate), 15, SpvDecorationDescriptorSet, 0,
+    op(4, SpvOpDecorate), 15, SpvDecorationBinding, 0,
+    op(4, SpvOpDecorate), 16, SpvDecorationArrayStride, 4,
+    op(3, SpvOpDecorate), 17, SpvDecorationBlock,
+    op(5, SpvOpMemberDecorate), 17, 0, SpvDecorationOffset, 0,
+    op(4, SpvOpDecorate), 19, SpvDecorationDescriptorSet, 2,
+    op(4, SpvOpDecorate), 19, SpvDecorationBinding, 5,
+    op(4, SpvOpDecorate), 24, SpvDecorationDescriptorSet, 1,
+    op(4, SpvOpDecorate), 24, SpvDecorationBinding, 2,
+    op(4, SpvOpDecorate), 27, SpvDecorationDescriptorSet, 1,
+    op(4, SpvOpDecorate), 27, SpvDecorationBinding, 3,
+    op(4, SpvOpDecorate), 30, SpvDecorationDescriptorSet, 2,
+    op(4, SpvOpDecorate), 30, SpvDecorationBinding, 0,
+    op(4, SpvOpDecorate), 33, SpvDecorationDescriptorSet, 2,
+    op(4, SpvOpDecorate), 33, SpvDecorationBinding, 1,
+    op(3, SpvOpDecorate), 34, SpvDecorationBufferBlock,
+    op(5, SpvOpMemberDecorate), 34, 0, SpvDecorationOffset, 0,
+    op(4, SpvOpDecorate), 36, SpvDecorationDescriptorSet, 2,
+    op(4, SpvOpDecorate), 36, SpvDecorationBinding, 2,
+    op(4, SpvOpDecorate), 39, SpvDecorationDescriptorSet, 3,
+    op(4, SpvOpDecorate), 39, SpvDecorationBinding, 0,
+
+    /* Combined image sampler */
+    op(3, SpvOpTypeFloat), 2, 32,
+    op(9, SpvOpTypeImage), 3, 2, SpvDim2D, 0, 0, 0, 1, SpvImageFormatUnknown,
+    op(3, SpvOpTypeSampledImage), 4, 3,
+    op(4, SpvOpTypePointer), 5, SpvStorageClassUniformConstant, 4,
+    op(4, SpvOpVariable), 5, 6, SpvStorageClassUniformConstant,
+
+    /* Storage image */
+    op(9, SpvOpTypeImage), 7, 2, SpvDim2D, 0, 0, 0, 2, SpvImageFormatRgba8,
+    op(4, SpvOpTypePointer), 8, SpvStorageClassUniformConstant, 7,
+    op(4, SpvOpVariable), 8, 9, SpvStorageClassUniformConstant,
+
+    /* Sampler */
+    op(2, SpvOpTypeSampler), 10,
+    op(4, SpvOpTypePointer), 11, SpvStorageClassUniformConstant, 10,
+    op(4, SpvOpVariable), 11, 12, SpvStorageClassUniformConstant,
+
+    /* Uniform buffer */
+    op(3, SpvOpTypeStruct), 13, 2,
+    op(4, SpvOpTypePointer), 14, SpvStorageClassUniform, 13,
+    op(4, SpvOpVariable), 14, 15, SpvStorageClassUniform,
+
+    /* Storage buffer with a runtime array */
+    op(3, SpvOpTypeRuntimeArray), 16, 2,
+    op(3, SpvOpTypeStruct), 17, 16,
+    op(4, SpvOpTypePointer), 18, SpvStorageClassStorageBuffer, 17,
+    op(4, SpvOpVariable), 18, 19, SpvStorageClassStorageBuffer,
+
+    /* Array of four combined image samplers */
+    op(4, SpvOpTypeInt), 20, 32, 0,
+    op(4, SpvOpConstant), 20, 21, 4,
+    op(4, SpvOpTypeArray), 22, 4, 21,
+    op(4, SpvOpTypePointer), 23, SpvStorageClassUniformConstant, 22,
+    op(4, SpvOpVariable), 23, 24, SpvStorageClassUniformConstant,
+
+    /* Runtime array of sampled images */
+    op(3, SpvOpTypeRuntimeArray), 25, 3,
+    op(4, SpvOpTypePointer), 26, SpvStorageClassUniformConstant, 25,
+    op(4, SpvOpVariable), 26, 27, SpvStorageClassUniformConstant,
+
+    /* Uniform texel buffer */
+    op(9, SpvOpTypeImage), 28, 2, SpvDimBuffer, 0, 0, 0, 1, SpvImageFormatUnknown,
+    op(4, SpvOpTypePointer), 29, SpvStorageClassUniformConstant, 28,
+    op(4, SpvOpVariable), 29, 30, SpvStorageClassUniformConstant,
+
+    /* Input attachment */
+    op(9, SpvOpTypeImage), 31, 2, SpvDimSubpassData, 0, 0, 0, 2, SpvImageFormatUnknown,
+    op(4, SpvOpTypePointer), 32, SpvStorageClassUniformConstant, 31,
+    op(4, SpvOpVariable), 32, 33, SpvStorageClassUniformConstant,
+
+    /* Storage buffer using the pre-SPIR-V 1.3 BufferBlock decoration */
+    op(3, SpvOpTypeStruct), 34, 2,
+    op(4, SpvOpTypePointer), 35, SpvStorageClassUniform, 34,
+    op(4, SpvOpVariable), 35, 36, SpvStorageClassUniform,
+
+    /* Acceleration structure */
+    op(2, SpvOpTypeAccelerationStructureKHR), 37,
+    op(4, SpvOpTypePointer), 38, SpvStorageClassUniformConstant, 37,
+    op(4, SpvOpVariable), 38, 39, SpvStorageClassUniformConstant
+};
+
+/* A vertex and a fragment entrypoint sharing a uniform buffer at binding 0,
+   with the fragment one additionally using a sampler at binding 1. SPIR-V
+   1.4, so the interfaces list all used globals. */
+constexpr UnsignedInt MergeSpirv[] {
+    SpvMagicNumber, 0x00010400, 0, 14, 0,
+    op(5, SpvOpEntryPoint), SpvExecutionModelVertex, 1, Ver, 10,
+    op(6, SpvOpEntryPoint), SpvExecutionModelFragment, 2, Fra, 10, 13,
+
+    op(4, SpvOpDecorate), 10, SpvDecorationDescriptorSet, 0,
+    op(4, SpvOpDecorate), 10, SpvDecorationBinding, 0,
+    op(4, SpvOpDecorate), 13, SpvDecorationDescriptorSet, 0,
+    op(4, SpvOpDecorate), 13, SpvDecorationBinding, 1,
+    op(3, SpvOpDecorate), 7, SpvDecorationBlock,
+    op(5, SpvOpMemberDecorate), 7, 0, SpvDecorationOffset, 0,
+
+    op(3, SpvOpTypeFloat), 6, 32,
+    op(3, SpvOpTypeStruct), 7, 6,
+    op(4, SpvOpTypePointer), 8, SpvStorageClassUniform, 7,
+    op(4, SpvOpVariable), 8, 10, SpvStorageClassUniform,
+    op(2, SpvOpTypeSampler), 11,
+    op(4, SpvOpTypePointer), 12, SpvStorageClassUniformConstant, 11,
+    op(4, SpvOpVariable), 12, 13, SpvStorageClassUniformConstant
+};
+
+/* Vertex and geometry entrypoint using a block with a mat4 and a vec4, the
+   fragment entrypoint a block with a float and a vec3 right after */
+constexpr UnsignedInt PushConstantSpirv[] {
+    SpvMagicNumber, 0x00010400, 0, 30, 0,
+    op(5, SpvOpEntryPoint), SpvExecutionModelVertex, 1, Ver, 25,
+    op(5, SpvOpEntryPoint), SpvExecutionModelGeometry, 2, Geo, 25,
+    op(5, SpvOpEntryPoint), SpvExecutionModelFragment, 3, Fra, 29,
+
+    op(3, SpvOpDecorate), 23, SpvDecorationBlock,
+    op(5, SpvOpMemberDecorate), 23, 0, SpvDecorationOffset, 0,
+    op(4, SpvOpMemberDecorate), 23, 0, SpvDecorationColMajor,
+    op(5, SpvOpMemberDecorate), 23, 0, SpvDecorationMatrixStride, 16,
+    op(5, SpvOpMemberDecorate), 23, 1, SpvDecorationOffset, 64,
+    op(3, SpvOpDecorate), 27, SpvDecorationBlock,
+    op(5, SpvOpMemberDecorate), 27, 0, SpvDecorationOffset, 80,
+    op(5, SpvOpMemberDecorate), 27, 1, SpvDecorationOffset, 84,
+
+    op(3, SpvOpTypeFloat), 20, 32,
+    op(4, SpvOpTypeVector), 21, 20, 4,
+    op(4, SpvOpTypeMatrix), 22, 21, 4,
+    op(4, SpvOpTypeStruct), 23, 22, 21,
+    op(4, SpvOpTypePointer), 24, SpvStorageClassPushConstant, 23,
+    op(4, SpvOpVariable), 24, 25, SpvStorageClassPushConstant,
+    op(4, SpvOpTypeVector), 26, 20, 3,
+    op(4, SpvOpTypeStruct), 27, 20, 26,
+    op(4, SpvOpTypePointer), 28, SpvStorageClassPushConstant, 27,
+    op(4, SpvOpVariable), 28, 29, SpvStorageClassPushConstant
+};
+
+/* Vertex inputs of various types, in a random order in the interface and
+   mixed with a builtin and an output */
+constexpr UnsignedInt VertexInputSpirv[] {
+    SpvMagicNumber, 0x00010000, 0, 27, 0,
+    op(11, SpvOpEntryPoint), SpvExecutionModelVertex, 1, Ver, 21, 20, 24, 25, 22, 23, 26,
+
+    op(4, SpvOpDecorate), 20, SpvDecorationLocation, 0,
+    op(4, SpvOpDecorate), 21, SpvDecorationLocation, 2,
+    op(4, SpvOpDecorate), 22, SpvDecorationLocation, 1,
+    op(4, SpvOpDecorate), 23, SpvDecorationLocation, 4,
+    op(4, SpvOpDecorate), 24, SpvDecorationBuiltIn, SpvBuiltInVertexIndex,
+    op(4, SpvOpDecorate), 25, SpvDecorationLocation, 0,
+    op(4, SpvOpDecorate), 26, SpvDecorationLocation, 6,
+
+    op(3, SpvOpTypeFloat), 2, 32,
+    op(4, SpvOpTypeVector), 3, 2, 3,
+    op(4, SpvOpTypeVector), 4, 2, 2,
+    op(4, SpvOpTypeMatrix), 5, 4, 2,
+    op(4, SpvOpTypeInt), 6, 32, 1,
+    op(4, SpvOpTypeVector), 7, 6, 2,
+    op(3, SpvOpTypeFloat), 8, 64,
+    op(4, SpvOpTypeVector), 9, 8, 3,
+    op(4, SpvOpTypePointer), 10, SpvStorageClassInput, 3,
+    op(4, SpvOpTypePointer), 11, SpvStorageClassInput, 5,
+    op(4, SpvOpTypePointer), 12, SpvStorageClassInput, 7,
+    op(4, SpvOpTypePointer), 13, SpvStorageClassInput, 9,
+    op(4, SpvOpTypePointer), 14, SpvStorageClassInput, 6,
+    op(4, SpvOpTypePointer), 15, SpvStorageClassOutput, 3,
+    op(4, SpvOpTypePointer), 16, SpvStorageClassInput, 2,
+    op(4, SpvOpVariable), 10, 20, SpvStorageClassInput,
+    op(4, SpvOpVariable), 11, 21, SpvStorageClassInput,
+    op(4, SpvOpVariable), 12, 22, SpvStorageClassInput,
+    op(4, SpvOpVariable), 13, 23, SpvStorageClassInput,
+    op(4, SpvOpVariable), 14, 24, SpvStorageClassInput,
+    op(4, SpvOpVariable), 15, 25, SpvStorageClassOutput,
+    op(4, SpvOpVariable), 16, 26, SpvStorageClassInput
+};
+
+void ShaderReflectionTest::construct() {
+    ShaderReflection reflection;
+    CORRADE_VERIFY(reflection.bindings().isEmpty());
+    CORRADE_COMPARE(reflection.descriptorSetCount(), 0);
+    CORRADE_VERIFY(reflection.pushConstantRanges().isEmpty());
+    CORRADE_VERIFY(reflection.vertexInputs().isEmpty());
+}
+
+void ShaderReflectionTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<ShaderReflection>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<ShaderReflection>{});
+}
+
+void ShaderReflectionTest::constructMove() {
+    ShaderReflection a;
+    CORRADE_VERIFY(a.addShader(ShaderStage::Vertex, Containers::arrayView(MergeSpirv), "ver"));
+    CORRADE_COMPARE(a.bindings().size(), 1);
+
+    ShaderReflection b{Utility::move(a)};
+    CORRADE_COMPARE(b.bindings().size(), 1);
+
+    ShaderReflection c;
+    c = Utility::move(b);
+    CORRADE_COMPARE(c.bindings().size(), 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ShaderReflection>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ShaderReflection>::value);
+}
+
+void ShaderReflectionTest::descriptors() {
+    ShaderReflection reflection;
+    CORRADE_VERIFY(reflection.addShader(ShaderStage::Fragment, Containers::arrayView(DescriptorsSpirv), "fra"));
+
+    Containers::ArrayView<const ShaderReflection::Binding> bindings = reflection.bindings();
+    CORRADE_COMPARE(bindings.size(), 11);
+
+    CORRADE_COMPARE(bindings[0].set, 0);
+    CORRADE_COMPARE(bindings[0].binding, 0);
+    CORRADE_COMPARE(bindings[0].type, DescriptorType::UniformBuffer);
+    CORRADE_COMPARE(bindings[0].count, 1);
+    CORRADE_COMPARE(VkShaderStageFlags(bindings[0].stages), VK_SHADER_STAGE_FRAGMENT_BIT);
+    CORRADE_COMPARE(bindings[0].flags, 0);
+
+    CORRADE_COMPARE(bindings[1].set, 0);
+    CORRADE_COMPARE(bindings[1].binding, 1);
+    CORRADE_COMPARE(bindings[1].type, DescriptorType::CombinedImageSampler);
+    CORRADE_COMPARE(bindings[1].count, 1);
+
+    CORRADE_COMPARE(bindings[2].set, 0);
+    CORRADE_COMPARE(bindings[2].binding, 3);
+    CORRADE_COMPARE(bindings[2].type, DescriptorType::StorageImage);
+    CORRADE_COMPARE(bindings[2].count, 1);
+
+    CORRADE_COMPARE(bindings[3].set, 1);
+    CORRADE_COMPARE(bindings[3].binding, 0);
+    CORRADE_COMPARE(bindings[3].type, DescriptorType::Sampler);
+    CORRADE_COMPARE(bindings[3].count, 1);
+
+    CORRADE_COMPARE(bindings[4].set, 1);
+    CORRADE_COMPARE(bindings[4].binding, 2);
+    CORRADE_COMPARE(bindings[4].type, DescriptorType::CombinedImageSampler);
+    CORRADE_COMPARE(bindings[4].count, 4);
+
+    /* Runtime array has an unknown size */
+    CORRADE_COMPARE(bindings[5].set, 1);
+    CORRADE_COMPARE(bindings[5].binding, 3);
+    CORRADE_COMPARE(bindings[5].type, DescriptorType::SampledImage);
+    CORRADE_COMPARE(bindings[5].count, 0);
+
+    CORRADE_COMPARE(bindings[6].set, 2);
+    CORRADE_COMPARE(bindings[6].binding, 0);
+    CORRADE_COMPARE(bindings[6].type, DescriptorType::UniformTexelBuffer);
+    CORRADE_COMPARE(bindings[6].count, 1);
+
+    CORRADE_COMPARE(bindings[7].set, 2);
+    CORRADE_COMPARE(bindings[7].binding, 1);
+    CORRADE_COMPARE(bindings[7].type, DescriptorType::InputAttachment);
+    CORRADE_COMPARE(bindings[7].count, 1);
+
+    CORRADE_COMPARE(bindings[8].set, 2);
+    CORRADE_COMPARE(bindings[8].binding, 2);
+    CORRADE_COMPARE(bindings[8].type, DescriptorType::StorageBuffer);
+    CORRADE_COMPARE(bindings[8].count, 1);
+
+    /* The runtime array is inside the block, so this is a single
+       descriptor */
+    CORRADE_COMPARE(bindings[9].set, 2);
+    CORRADE_COMPARE(bindings[9].binding, 5);
+    CORRADE_COMPARE(bindings[9].type, DescriptorType::StorageBuffer);
+    CORRADE_COMPARE(bindings[9].count, 1);
+
+    CORRADE_COMPARE(bindings[10].set, 3);
+    CORRADE_COMPARE(bindings[10].binding, 0);
+    CORRADE_COMPARE(bindings[10].type, DescriptorType::AccelerationStructure);
+    CORRADE_COMPARE(bindings[10].count, 1);
+
+    CORRADE_COMPARE(reflection.descriptorSetCount(), 4);
+    CORRADE_VERIFY(reflection.pushConstantRanges().isEmpty());
+    CORRADE_VERIFY(reflection.vertexInputs().isEmpty());
+}
+
+void ShaderReflectionTest::mergeStages() {
+    ShaderReflection reflection;
+    CORRADE_VERIFY(reflection.addShader(ShaderStage::Vertex, Containers::arrayView(MergeSpirv), "ver"));
+
+    /* The sampler isn't in the vertex entrypoint interface */
+    CORRADE_COMPARE(reflection.bindings().size(), 1);
+    CORRADE_COMPARE(reflection.bindings()[0].binding, 0);
+    CORRADE_COMPARE(VkShaderStageFlags(reflection.bindings()[0].stages), VK_SHADER_STAGE_VERTEX_BIT);
+
+    CORRADE_VERIFY(reflection.addShader(ShaderStage::Fragment, Containers::arrayView(MergeSpirv), "fra"));
+    CORRADE_COMPARE(reflection.bindings().size(), 2);
+    CORRADE_COMPARE(reflection.bindings()[0].binding, 0);
+    CORRADE_COMPARE(reflection.bindings()[0].type, DescriptorType::UniformBuffer);
+    CORRADE_COMPARE(VkShaderStageFlags(reflection.bindings()[0].stages), VK_SHADER_STAGE_VERTEX_BIT|VK_SHADER_STAGE_FRAGMENT_BIT);
+    CORRADE_COMPARE(reflection.bindings()[1].binding, 1);
+    CORRADE_COMPARE(reflection.bindings()[1].type, DescriptorType::Sampler);
+    CORRADE_COMPARE(VkShaderStageFlags(reflection.bindings()[1].stages), VK_SHADER_STAGE_FRAGMENT_BIT);
+    CORRADE_COMPARE(reflection.descriptorSetCount(), 1);
+}
+
+void ShaderReflectionTest::mergeStagesNoInterfaceFiltering() {
+    /* Same as above but with the version patched to SPIR-V 1.3, which means
+       the interface lists only inputs and outputs and everything has to be
+       assumed to be used */
+    UnsignedInt data[Containers::arraySize(MergeSpirv)];
+    Utility::copy(Containers::arrayView(MergeSpirv), Containers::arrayView(data));
+    data[1] = 0x00010300;
+
+    ShaderReflection reflection;
+    CORRADE_VERIFY(reflection.addShader(ShaderStage::Vertex, Containers::arrayView(data), "ver"));
+    CORRADE_COMPARE(reflection.bindings().size(), 2);
+    CORRADE_COMPARE(VkShaderStageFlags(reflection.bindings()[0].stages), VK_SHADER_STAGE_VERTEX_BIT);
+    CORRADE_COMPARE(VkShaderStageFlags(reflection.bindings()[1].stages), VK_SHADER_STAGE_VERTEX_BIT);
+
+    CORRADE_VERIFY(reflection.addShader(ShaderStage::Fragment, Containers::arrayView(data), "fra"));
+    CORRADE_COMPARE(reflection.bindings().size(), 2);
+    CORRADE_COMPARE(VkShaderStageFlags(reflection.bindings()[0].stages), VK_SHADER_STAGE_VERTEX_BIT|VK_SHADER_STAGE_FRAGMENT_BIT);
+    CORRADE_COMPARE(VkShaderStageFlags(reflection.bindings()[1].stages), VK_SHADER_STAGE_VERTEX_BIT|VK_SHADER_STAGE_FRAGMENT_BIT);
+}
+
+void ShaderReflectionTest::mergeConflict() {
+    /* Patch the sampler to be at binding 0 as well */
+    UnsignedInt data[Containers::arraySize(MergeSpirv)];
+    Utility::copy(Containers::arrayView(MergeSpirv), Containers::arrayView(data));
+    CORRADE_COMPARE(data[29], 13);
+    CORRADE_COMPARE(data[30], SpvDecorationBinding);
+    data[31] = 0;
+
+    ShaderReflection reflection;
+    CORRADE_VERIFY(reflection.addShader(ShaderStage::Vertex, Containers::arrayView(data), "ver"));
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!reflection.addShader(ShaderStage::Fragment, Containers::arrayView(data), "fra"));
+    }
+    CORRADE_COMPARE(out.str(), "Vk::ShaderReflection::addShader(): set 0 binding 0 is Vk::DescriptorType::Sampler with 1 descriptors but was Vk::DescriptorType::UniformBuffer with 1 descriptors before\n");
+
+    /* The state is left untouched, including the uniform buffer that was
+       fine */
+    CORRADE_COMPARE(reflection.bindings().size(), 1);
+    CORRADE_COMPARE(reflection.bindings()[0].type, DescriptorType::UniformBuffer);
+    CORRADE_COMPARE(VkShaderStageFlags(reflection.bindings()[0].stages), VK_SHADER_STAGE_VERTEX_BIT);
+}
+
+void ShaderReflectionTest::pushConstants() {
+    ShaderReflection reflection;
+    CORRADE_VERIFY(reflection.addShader(ShaderStage::Vertex, Containers::arrayView(PushConstantSpirv), "ver"));
+    CORRADE_VERIFY(reflection.bindings().isEmpty());
+    CORRADE_COMPARE(reflection.pushConstantRanges().size(), 1);
+    CORRADE_COMPARE(reflection.pushConstantRanges()[0].stageFlags, VK_SHADER_STAGE_VERTEX_BIT);
+    CORRADE_COMPARE(reflection.pushConstantRanges()[0].offset, 0);
+    CORRADE_COMPARE(reflection.pushConstantRanges()[0].size, 80);
+
+    /* Fragment shader uses a different range, added after */
+    CORRADE_VERIFY(reflection.addShader(ShaderStage::Fragment, Containers::arrayView(PushConstantSpirv), "fra"));
+    CORRADE_COMPARE(reflection.pushConstantRanges().size(), 2);
+    CORRADE_COMPARE(reflection.pushConstantRanges()[1].stageFlags, VK_SHADER_STAGE_FRAGMENT_BIT);
+    CORRADE_COMPARE(reflection.pushConstantRanges()[1].offset, 80);
+    CORRADE_COMPARE(reflection.pushConstantRanges()[1].size, 16);
+
+    /* Geometry shader uses the same range as vertex, so it gets merged */
+    CORRADE_VERIFY(reflection.addShader(ShaderStage::Geometry, Containers::arrayView(PushConstantSpirv), "geo"));
+    CORRADE_COMPARE(reflection.pushConstantRanges().size(), 2);
+    CORRADE_COMPARE(reflection.pushConstantRanges()[0].stageFlags, VK_SHADER_STAGE_VERTEX_BIT|VK_SHADER_STAGE_GEOMETRY_BIT);
+    CORRADE_COMPARE(reflection.pushConstantRanges()[0].offset, 0);
+    CORRADE_COMPARE(reflection.pushConstantRanges()[0].size, 80);
+    CORRADE_COMPARE(reflection.pushConstantRanges()[1].stageFlags, VK_SHADER_STAGE_FRAGMENT_BIT);
+    CORRADE_COMPARE(reflection.pushConstantRanges()[1].offset, 80);
+    CORRADE_COMPARE(reflection.pushConstantRanges()[1].size, 16);
+}
+
+void ShaderReflectionTest::vertexInputs() {
+    ShaderReflection reflection;
+    CORRADE_VERIFY(reflection.addShader(ShaderStage::Vertex, Containers::arrayView(VertexInputSpirv), "ver"));
+
+    /* The builtin and the output are ignored, the matrix is split into two
+       locations and the 64-bit three-component vector takes two locations */
+    Containers::ArrayView<const ShaderReflection::VertexInput> inputs = reflection.vertexInputs();
+    CORRADE_COMPARE(inputs.size(), 6);
+    CORRADE_COMPARE(inputs[0].location, 0);
+    CORRADE_COMPARE(inputs[0].format, Magnum::VertexFormat::Vector3);
+    CORRADE_COMPARE(inputs[1].location, 1);
+    CORRADE_COMPARE(inputs[1].format, Magnum::VertexFormat::Vector2i);
+    CORRADE_COMPARE(inputs[2].location, 2);
+    CORRADE_COMPARE(inputs[2].format, Magnum::VertexFormat::Vector2);
+    CORRADE_COMPARE(inputs[3].location, 3);
+    CORRADE_COMPARE(inputs[3].format, Magnum::VertexFormat::Vector2);
+    CORRADE_COMPARE(inputs[4].location, 4);
+    CORRADE_COMPARE(inputs[4].format, Magnum::VertexFormat::Vector3d);
+    CORRADE_COMPARE(inputs[5].location, 6);
+    CORRADE_COMPARE(inputs[5].format, Magnum::VertexFormat::Float);
+
+    /* Adding a non-vertex stage doesn't affect the inputs */
+    CORRADE_VERIFY(reflection.addShader(ShaderStage::Fragment, Containers::arrayView(MergeSpirv), "fra"));
+    CORRADE_COMPARE(reflection.vertexInputs().size(), 6);
+}
+
+void ShaderReflectionTest::invalidSpirv() {
+    const UnsignedInt data[]{0xdeadbeef, 0x00010000, 0, 1, 0, 0};
+
+    ShaderReflection reflection;
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!reflection.addShader(ShaderStage::Vertex, Containers::arrayView(data), "ver"));
+    CORRADE_COMPARE(out.str(), "Vk::ShaderReflection::addShader(): invalid SPIR-V\n");
+}
+
+void ShaderReflectionTest::invalidInstruction() {
+    /* Instruction size going past the end of the data */
+    const UnsignedInt data[]{
+        SpvMagicNumber, 0x00010000, 0, 3, 0,
+        op(4, SpvOpEntryPoint), SpvExecutionModelVertex, 1, Ver,
+        op(4, SpvOpTypeFloat), 2, 32
+    };
+
+    ShaderReflection reflection;
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!reflection.addShader(ShaderStage::Vertex, Containers::arrayView(data), "ver"));
+    CORRADE_COMPARE(out.str(), "Vk::ShaderReflection::addShader(): invalid SPIR-V\n");
+}
+
+void ShaderReflectionTest::entrypointNotFound() {
+    ShaderReflection reflection;
+    std::ostringstream out;
+    Error redirectError{&out};
+    /* Name matches but the stage doesn't and vice versa */
+    CORRADE_VERIFY(!reflection.addShader(ShaderStage::Compute, Containers::arrayView(MergeSpirv), "ver"));
+    CORRADE_VERIFY(!reflection.addShader(ShaderStage::Vertex, Containers::arrayView(MergeSpirv), "fra"));
+    CORRADE_COMPARE(out.str(),
+        "Vk::ShaderReflection::addShader(): no entrypoint named ver for given stage\n"
+        "Vk::ShaderReflection::addShader(): no entrypoint named fra for given stage\n");
+}
+
+void ShaderReflectionTest::unsupportedDescriptorType() {
+    /* A plain float in the Uniform storage class */
+    const UnsignedInt data[]{
+        SpvMagicNumber, 0x00010000, 0, 5, 0,
+        op(4, SpvOpEntryPoint), SpvExecutionModelFragment, 1, Fra,
+        op(4, SpvOpDecorate), 4, SpvDecorationDescriptorSet, 1,
+        op(4, SpvOpDecorate), 4, SpvDecorationBinding, 7,
+        op(3, SpvOpTypeFloat), 2, 32,
+        op(4, SpvOpTypePointer), 3, SpvStorageClassUniform, 2,
+        op(4, SpvOpVariable), 3, 4, SpvStorageClassUniform
+    };
+
+    ShaderReflection reflection;
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!reflection.addShader(ShaderStage::Fragment, Containers::arrayView(data), "fra"));
+    CORRADE_COMPARE(out.str(), "Vk::ShaderReflection::addShader(): unsupported type of a descriptor at set 1 binding 7\n");
+}
+
+void ShaderReflectionTest::unsupportedVertexInputType() {
+    /* A bool input */
+    const UnsignedInt data[]{
+        SpvMagicNumber, 0x00010000, 0, 5, 0,
+        op(5, SpvOpEntryPoint), SpvExecutionModelVertex, 1, Ver, 4,
+        op(4, SpvOpDecorate), 4, SpvDecorationLocation, 3,
+        op(2, SpvOpTypeBool), 2,
+        op(4, SpvOpTypePointer), 3, SpvStorageClassInput, 2,
+        op(4, SpvOpVariable), 3, 4, SpvStorageClassInput
+    };
+
+    ShaderReflection reflection;
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!reflection.addShader(ShaderStage::Vertex, Containers::arrayView(data), "ver"));
+    CORRADE_COMPARE(out.str(), "Vk::ShaderReflection::addShader(): unsupported type of a vertex input at location 3\n");
+}
+
+void ShaderReflectionTest::descriptorSetLayoutCreateInfo() {
+    ShaderReflection reflection;
+    CORRADE_VERIFY(reflection.addShader(ShaderStage::Fragment, Containers::arrayView(DescriptorsSpirv), "fra"));
+
+    /* Patch what can't be inferred from the SPIR-V */
+    reflection.bindings()[0].type = DescriptorType::UniformBufferDynamic;
+    reflection.bindings()[5].count = 16;
+    reflection.bindings()[5].flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+
+    DescriptorSetLayoutCreateInfo set0 = reflection.descriptorSetLayoutCreateInfo(0);
+    CORRADE_COMPARE(set0->bindingCount, 3);
+    CORRADE_COMPARE(set0->pBindings[0].binding, 0);
+    CORRADE_COMPARE(set0->pBindings[0].descriptorType, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+    CORRADE_COMPARE(set0->pBindings[0].descriptorCount, 1);
+    CORRADE_COMPARE(set0->pBindings[0].stageFlags, VK_SHADER_STAGE_FRAGMENT_BIT);
+    CORRADE_COMPARE(set0->pBindings[2].binding, 3);
+    CORRADE_COMPARE(set0->pBindings[2].descriptorType, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);
+    CORRADE_VERIFY(!set0->pNext);
+
+    DescriptorSetLayoutCreateInfo set1 = reflection.descriptorSetLayoutCreateInfo(1);
+    CORRADE_COMPARE(set1->bindingCount, 3);
+    CORRADE_COMPARE(set1->pBindings[2].binding, 3);
+    CORRADE_COMPARE(set1->pBindings[2].descriptorType, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE);
+    CORRADE_COMPARE(set1->pBindings[2].descriptorCount, 16);
+    CORRADE_VERIFY(set1->pNext);
+    const auto& flags = *static_cast<const VkDescriptorSetLayoutBindingFlagsCreateInfo*>(set1->pNext);
+    CORRADE_COMPARE(flags.bindingCount, 3);
+    CORRADE_COMPARE(flags.pBindingFlags[0], 0);
+    CORRADE_COMPARE(flags.pBindingFlags[2], VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT);
+}
+
+void ShaderReflectionTest::descriptorSetLayoutCreateInfoOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ShaderReflection reflection;
+    CORRADE_VERIFY(reflection.addShader(ShaderStage::Vertex, Containers::arrayView(MergeSpirv), "ver"));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    reflection.descriptorSetLayoutCreateInfo(1);
+    CORRADE_COMPARE(out.str(), "Vk::ShaderReflection::descriptorSetLayoutCreateInfo(): index 1 out of range for 1 descriptor sets\n");
+}
+
+void ShaderReflectionTest::meshLayout() {
+    ShaderReflection reflection;
+    CORRADE_VERIFY(reflection.addShader(ShaderStage::Vertex, Containers::arrayView(VertexInputSpirv), "ver"));
+
+    MeshLayout layout = reflection.meshLayout(Magnum::MeshPrimitive::Triangles);
+    CORRADE_COMPARE(layout.vkPipelineInputAssemblyStateCreateInfo().topology, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
+
+    /* Each input gets its own binding, with the index matching the
+       location */
+    const VkPipelineVertexInputStateCreateInfo& info = layout.vkPipelineVertexInputStateCreateInfo();
+    CORRADE_COMPARE(info.vertexBindingDescriptionCount, 6);
+    CORRADE_COMPARE(info.vertexAttributeDescriptionCount, 6);
+    CORRADE_COMPARE(info.pVertexBindingDescriptions[0].binding, 0);
+    CORRADE_COMPARE(info.pVertexBindingDescriptions[0].stride, 12);
+    CORRADE_COMPARE(info.pVertexBindingDescriptions[4].binding, 4);
+    CORRADE_COMPARE(info.pVertexBindingDescriptions[4].stride, 24);
+    CORRADE_COMPARE(info.pVertexBindingDescriptions[5].binding, 6);
+    CORRADE_COMPARE(info.pVertexBindingDescriptions[5].stride, 4);
+    CORRADE_COMPARE(info.pVertexAttributeDescriptions[1].location, 1);
+    CORRADE_COMPARE(info.pVertexAttributeDescriptions[1].binding, 1);
+    CORRADE_COMPARE(info.pVertexAttributeDescriptions[1].format, VK_FORMAT_R32G32_SINT);
+    CORRADE_COMPARE(info.pVertexAttributeDescriptions[1].offset, 0);
+    CORRADE_COMPARE(info.pVertexAttributeDescriptions[4].location, 4);
+    CORRADE_COMPARE(info.pVertexAttributeDescriptions[4].binding, 4);
+    CORRADE_COMPARE(info.pVertexAttributeDescriptions[4].format, VK_FORMAT_R64G64B64_SFLOAT);
+    CORRADE_COMPARE(info.pVertexAttributeDescriptions[4].offset, 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::ShaderReflectionTest)
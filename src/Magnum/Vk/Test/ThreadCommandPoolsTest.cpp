@@ -0,0 +1,113 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/ThreadCommandPools.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct ThreadCommandPoolsTest: TestSuite::Tester {
+    explicit ThreadCommandPoolsTest();
+
+    void constructNoCreate();
+    void constructZeroCount();
+    void constructCopy();
+
+    void poolNoPools();
+    void nextFrameNoPools();
+};
+
+ThreadCommandPoolsTest::ThreadCommandPoolsTest() {
+    addTests({&ThreadCommandPoolsTest::constructNoCreate,
+              &ThreadCommandPoolsTest::constructZeroCount,
+              &ThreadCommandPoolsTest::constructCopy,
+
+              &ThreadCommandPoolsTest::poolNoPools,
+              &ThreadCommandPoolsTest::nextFrameNoPools});
+}
+
+void ThreadCommandPoolsTest::constructNoCreate() {
+    {
+        ThreadCommandPools pools{NoCreate};
+        CORRADE_COMPARE(pools.threadCount(), 0);
+        CORRADE_COMPARE(pools.frameCount(), 0);
+        CORRADE_COMPARE(pools.frame(), 0);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, ThreadCommandPools>::value);
+}
+
+void ThreadCommandPoolsTest::constructZeroCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    /* The device is never accessed, so NoCreate is fine */
+    Device device{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ThreadCommandPools{device, CommandPoolCreateInfo{0}, 0, 3};
+    ThreadCommandPools{device, CommandPoolCreateInfo{0}, 4, 0};
+    CORRADE_COMPARE(out.str(),
+        "Vk::ThreadCommandPools: expected non-zero thread and frame count but got 0 and 3\n"
+        "Vk::ThreadCommandPools: expected non-zero thread and frame count but got 4 and 0\n");
+}
+
+void ThreadCommandPoolsTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<ThreadCommandPools>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<ThreadCommandPools>{});
+}
+
+void ThreadCommandPoolsTest::poolNoPools() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ThreadCommandPools pools{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    /* The fallback shouldn't access the (empty) pool array */
+    CORRADE_COMPARE(pools.pool(0, 0).handle(), VkCommandPool{});
+    CORRADE_COMPARE(out.str(), "Vk::ThreadCommandPools::pool(): index 0,0 out of range for 0 frames and 0 threads\n");
+}
+
+void ThreadCommandPoolsTest::nextFrameNoPools() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ThreadCommandPools pools{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pools.nextFrame();
+    CORRADE_COMPARE(out.str(), "Vk::ThreadCommandPools::nextFrame(): the instance has no command pools\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::ThreadCommandPoolsTest)
@@ -0,0 +1,211 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <thread>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Fence.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/ThreadCommandPools.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct ThreadCommandPoolsVkTest: VulkanTester {
+    explicit ThreadCommandPoolsVkTest();
+
+    void construct();
+    void constructMove();
+
+    void poolOutOfRange();
+
+    void nextFrame();
+
+    void recordMultithreaded();
+};
+
+using namespace Containers::Literals;
+
+ThreadCommandPoolsVkTest::ThreadCommandPoolsVkTest() {
+    addTests({&ThreadCommandPoolsVkTest::construct,
+              &ThreadCommandPoolsVkTest::constructMove,
+
+              &ThreadCommandPoolsVkTest::poolOutOfRange,
+
+              &ThreadCommandPoolsVkTest::nextFrame,
+
+              &ThreadCommandPoolsVkTest::recordMultithreaded});
+}
+
+void ThreadCommandPoolsVkTest::construct() {
+    {
+        ThreadCommandPools pools{device(), CommandPoolCreateInfo{
+            device().properties().pickQueueFamily(QueueFlag::Graphics)}, 3, 2};
+        CORRADE_COMPARE(pools.threadCount(), 3);
+        CORRADE_COMPARE(pools.frameCount(), 2);
+        CORRADE_COMPARE(pools.frame(), 0);
+
+        /* All pools should be distinct and owned */
+        for(UnsignedInt frame = 0; frame != 2; ++frame) {
+            for(UnsignedInt thread = 0; thread != 3; ++thread) {
+                CORRADE_ITERATION(frame << Debug::nospace << "," << Debug::nospace << thread);
+                CommandPool& pool = pools.pool(frame, thread);
+                CORRADE_VERIFY(pool.handle());
+                CORRADE_COMPARE(pool.handleFlags(), HandleFlag::DestroyOnDestruction);
+                if(thread) CORRADE_VERIFY(pool.handle() != pools.pool(frame, thread - 1).handle());
+                if(frame) CORRADE_VERIFY(pool.handle() != pools.pool(frame - 1, thread).handle());
+            }
+        }
+
+        /* Pool for the current frame */
+        CORRADE_COMPARE(pools.pool(2).handle(), pools.pool(0, 2).handle());
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void ThreadCommandPoolsVkTest::constructMove() {
+    ThreadCommandPools a{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}, 2, 3};
+    a.nextFrame();
+    VkCommandPool handle = a.pool(1).handle();
+
+    ThreadCommandPools b = Utility::move(a);
+    CORRADE_COMPARE(a.threadCount(), 0);
+    CORRADE_COMPARE(a.frameCount(), 0);
+    CORRADE_COMPARE(b.threadCount(), 2);
+    CORRADE_COMPARE(b.frameCount(), 3);
+    CORRADE_COMPARE(b.frame(), 1);
+    CORRADE_COMPARE(b.pool(1).handle(), handle);
+
+    ThreadCommandPools c{NoCreate};
+    c = Utility::move(b);
+    CORRADE_COMPARE(b.threadCount(), 0);
+    CORRADE_COMPARE(b.frameCount(), 0);
+    CORRADE_COMPARE(c.threadCount(), 2);
+    CORRADE_COMPARE(c.frameCount(), 3);
+    CORRADE_COMPARE(c.frame(), 1);
+    CORRADE_COMPARE(c.pool(1).handle(), handle);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ThreadCommandPools>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ThreadCommandPools>::value);
+}
+
+void ThreadCommandPoolsVkTest::poolOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ThreadCommandPools pools{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}, 3, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pools.pool(3);
+    pools.pool(2, 0);
+    CORRADE_COMPARE(out.str(),
+        "Vk::ThreadCommandPools::pool(): index 0,3 out of range for 2 frames and 3 threads\n"
+        "Vk::ThreadCommandPools::pool(): index 2,0 out of range for 2 frames and 3 threads\n");
+}
+
+void ThreadCommandPoolsVkTest::nextFrame() {
+    ThreadCommandPools pools{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}, 2, 3};
+
+    VkCommandPool frame0 = pools.pool(1).handle();
+    pools.nextFrame();
+    CORRADE_COMPARE(pools.frame(), 1);
+    CORRADE_VERIFY(pools.pool(1).handle() != frame0);
+    pools.nextFrame(CommandPoolResetFlag::ReleaseResources);
+    CORRADE_COMPARE(pools.frame(), 2);
+
+    /* Wraps around back to the first set of pools */
+    pools.nextFrame();
+    CORRADE_COMPARE(pools.frame(), 0);
+    CORRADE_COMPARE(pools.pool(1).handle(), frame0);
+}
+
+void ThreadCommandPoolsVkTest::recordMultithreaded() {
+    const UnsignedInt queueFamily = device().properties().pickQueueFamily(QueueFlag::Graphics);
+    ThreadCommandPools pools{device(), CommandPoolCreateInfo{queueFamily}, 3, 2};
+    CommandPool primaryPool{device(), CommandPoolCreateInfo{queueFamily}};
+    CommandBuffer cmd = primaryPool.allocate();
+
+    Buffer buffer{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 16
+    }, MemoryFlag::HostVisible};
+
+    /* Record two frames to verify the pools get correctly recycled */
+    for(const char fill: {'.', '-'}) {
+        CORRADE_ITERATION(fill);
+
+        Utility::copy("0123456789abcdef"_s, buffer.dedicatedMemory().map());
+
+        /* Each worker thread records a secondary command buffer from its own
+           pool, filling its own part of the buffer */
+        CommandBuffer secondary[]{
+            CommandBuffer{NoCreate},
+            CommandBuffer{NoCreate},
+            CommandBuffer{NoCreate}
+        };
+        std::thread threads[3];
+        for(UnsignedInt i = 0; i != 3; ++i) threads[i] = std::thread{[&](const UnsignedInt thread) {
+            secondary[thread] = pools.pool(thread).allocate(CommandBufferLevel::Secondary);
+            secondary[thread]
+                .begin(CommandBufferBeginInfo{CommandBufferInheritanceInfo{}})
+                .fillBuffer(buffer, 4*thread, 4, UnsignedInt(fill)*0x01010101u)
+                .end();
+        }, i};
+        for(std::thread& i: threads) i.join();
+
+        cmd.begin()
+           .executeCommands({secondary[0], secondary[1], secondary[2]})
+           .pipelineBarrier(PipelineStage::Transfer, PipelineStage::Host, {
+               {Access::TransferWrite, Access::HostRead}
+            }, {}, {})
+           .end();
+        queue().submit({SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+        CORRADE_COMPARE(arrayView(buffer.dedicatedMemory().mapRead()),
+            fill == '.' ? "............cdef"_s : "------------cdef"_s);
+
+        /* The GPU is done with the frame, so everything can be recycled */
+        primaryPool.reset();
+        pools.nextFrame();
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::ThreadCommandPoolsVkTest)
@@ -0,0 +1,82 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/Uploader.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct UploaderTest: TestSuite::Tester {
+    explicit UploaderTest();
+
+    void constructNoCreate();
+    void constructStagingTooSmall();
+    void constructCopy();
+};
+
+UploaderTest::UploaderTest() {
+    addTests({&UploaderTest::constructNoCreate,
+              &UploaderTest::constructStagingTooSmall,
+              &UploaderTest::constructCopy});
+}
+
+void UploaderTest::constructNoCreate() {
+    {
+        Uploader uploader{NoCreate};
+        CORRADE_COMPARE(uploader.stagingSize(), 0);
+        CORRADE_COMPARE(uploader.pendingCopyCount(), 0);
+        CORRADE_COMPARE(uploader.submitCount(), 0);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, Uploader>::value);
+}
+
+void UploaderTest::constructStagingTooSmall() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    /* The device and queue are never accessed, so NoCreate is fine */
+    Device device{NoCreate};
+    Queue queue{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Uploader{device, queue, 0, 15};
+    CORRADE_COMPARE(out.str(), "Vk::Uploader: expected staging size to be at least 16 bytes but got 15\n");
+}
+
+void UploaderTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<Uploader>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<Uploader>{});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::UploaderTest)
@@ -0,0 +1,316 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Fence.h"
+#include "Magnum/Vk/ImageCreateInfo.h"
+#include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/Uploader.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct UploaderVkTest: VulkanTester {
+    explicit UploaderVkTest();
+
+    void construct();
+    void constructMove();
+
+    void uploadBuffer();
+    void uploadBufferLargerThanStaging();
+    void uploadBufferWrapAround();
+    void uploadBufferEmpty();
+    void uploadImage();
+    void uploadImageAutomaticSubmit();
+    void uploadImageTooLarge();
+
+    void submitNothing();
+};
+
+using namespace Containers::Literals;
+
+UploaderVkTest::UploaderVkTest() {
+    addTests({&UploaderVkTest::construct,
+              &UploaderVkTest::constructMove,
+
+              &UploaderVkTest::uploadBuffer,
+              &UploaderVkTest::uploadBufferLargerThanStaging,
+              &UploaderVkTest::uploadBufferWrapAround,
+              &UploaderVkTest::uploadBufferEmpty,
+              &UploaderVkTest::uploadImage,
+              &UploaderVkTest::uploadImageAutomaticSubmit,
+              &UploaderVkTest::uploadImageTooLarge,
+
+              &UploaderVkTest::submitNothing});
+}
+
+void UploaderVkTest::construct() {
+    {
+        Uploader uploader{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 4096};
+        CORRADE_COMPARE(uploader.stagingSize(), 4096);
+        CORRADE_COMPARE(uploader.pendingCopyCount(), 0);
+        CORRADE_COMPARE(uploader.submitCount(), 0);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void UploaderVkTest::constructMove() {
+    Buffer buffer{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 16
+    }, MemoryFlag::HostVisible};
+
+    Uploader a{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 4096};
+    a.uploadBuffer(buffer, 0, "0123456789abcdef"_s);
+
+    Uploader b = Utility::move(a);
+    CORRADE_COMPARE(a.stagingSize(), 0);
+    CORRADE_COMPARE(a.pendingCopyCount(), 0);
+    CORRADE_COMPARE(b.stagingSize(), 4096);
+    CORRADE_COMPARE(b.pendingCopyCount(), 1);
+
+    Uploader c{NoCreate};
+    c = Utility::move(b);
+    CORRADE_COMPARE(b.stagingSize(), 0);
+    CORRADE_COMPARE(c.stagingSize(), 4096);
+    CORRADE_COMPARE(c.pendingCopyCount(), 1);
+
+    /* The pending upload should survive the move */
+    c.wait();
+    CORRADE_COMPARE(arrayView(buffer.dedicatedMemory().mapRead()), "0123456789abcdef"_s);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<Uploader>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<Uploader>::value);
+}
+
+void UploaderVkTest::uploadBuffer() {
+    Uploader uploader{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 4096};
+
+    Buffer a{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 16
+    }, MemoryFlag::HostVisible};
+    Buffer b{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 8
+    }, MemoryFlag::HostVisible};
+
+    /* The first two get merged into a single copy command, but that's not
+       observable from the outside */
+    uploader
+        .uploadBuffer(a, 0, "01234567"_s)
+        .uploadBuffer(a, 8, "89abcdef"_s)
+        .uploadBuffer(b, 0, "ABCDEFGH"_s);
+    CORRADE_COMPARE(uploader.pendingCopyCount(), 3);
+    CORRADE_COMPARE(uploader.submitCount(), 0);
+
+    uploader.wait();
+    CORRADE_COMPARE(uploader.pendingCopyCount(), 0);
+    CORRADE_COMPARE(uploader.submitCount(), 1);
+    CORRADE_COMPARE(arrayView(a.dedicatedMemory().mapRead()), "0123456789abcdef"_s);
+    CORRADE_COMPARE(arrayView(b.dedicatedMemory().mapRead()), "ABCDEFGH"_s);
+}
+
+void UploaderVkTest::uploadBufferLargerThanStaging() {
+    Uploader uploader{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 32};
+
+    Buffer buffer{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 80
+    }, MemoryFlag::HostVisible};
+
+    /* Gets split into 16-byte parts, with the staging buffer being reused
+       several times */
+    uploader.uploadBuffer(buffer, 0,
+        "0123456789abcdef"
+        "ghijklmnopqrstuv"
+        "wxyzABCDEFGHIJKL"
+        "MNOPQRSTUVWXYZ01"
+        "23456789!@#$%^&*"_s);
+    uploader.wait();
+    CORRADE_COMPARE_AS(uploader.submitCount(), 1, TestSuite::Compare::Greater);
+    CORRADE_COMPARE(arrayView(buffer.dedicatedMemory().mapRead()),
+        "0123456789abcdef"
+        "ghijklmnopqrstuv"
+        "wxyzABCDEFGHIJKL"
+        "MNOPQRSTUVWXYZ01"
+        "23456789!@#$%^&*"_s);
+}
+
+void UploaderVkTest::uploadBufferWrapAround() {
+    Uploader uploader{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 64};
+
+    Buffer buffer{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 40
+    }, MemoryFlag::HostVisible};
+
+    /* Each upload is aligned to 16 bytes in the staging buffer, so the third
+       one doesn't fit after the first two anymore and has to wrap around,
+       which needs the first two to be submitted and finished first */
+    uploader
+        .uploadBuffer(buffer, 0, "0123456789"_s)
+        .uploadBuffer(buffer, 10, "abcdefghij"_s)
+        .uploadBuffer(buffer, 20, "ABCDEFGHIJ"_s)
+        .uploadBuffer(buffer, 30, "!@#$%^&*()"_s);
+    uploader.wait();
+    CORRADE_COMPARE(arrayView(buffer.dedicatedMemory().mapRead()),
+        "0123456789abcdefghijABCDEFGHIJ!@#$%^&*()"_s);
+}
+
+void UploaderVkTest::uploadBufferEmpty() {
+    Uploader uploader{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 64};
+
+    Buffer buffer{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 16
+    }, MemoryFlag::HostVisible};
+
+    uploader.uploadBuffer(buffer, 0, nullptr);
+    CORRADE_COMPARE(uploader.pendingCopyCount(), 0);
+}
+
+void UploaderVkTest::uploadImage() {
+    Uploader uploader{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 4096};
+
+    Image image{device(), ImageCreateInfo2D{
+        ImageUsage::TransferDestination|ImageUsage::TransferSource,
+        PixelFormat::RGBA8UI, {4, 2}, 1
+    }, MemoryFlag::DeviceLocal};
+
+    uploader.uploadImage(image, ImageLayout::TransferSource,
+        BufferImageCopy2D{0, ImageAspect::Color, 0, Range2Di::fromSize({}, {4, 2})},
+        "AaaaBbbbCcccDddd"
+        "EeeeFfffGgggHhhh"_s);
+    CORRADE_COMPARE(uploader.pendingCopyCount(), 1);
+    uploader.wait();
+    CORRADE_COMPARE(uploader.submitCount(), 1);
+
+    /* Read the data back. The image is expected to be in the TransferSource
+       layout already. */
+    CommandPool pool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+    CommandBuffer cmd = pool.allocate();
+    Buffer buffer{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 4*2*4
+    }, MemoryFlag::HostVisible};
+    cmd.begin()
+       .copyImageToBuffer(CopyImageToBufferInfo2D{image, ImageLayout::TransferSource, buffer, {
+           {0, ImageAspect::Color, 0, Range2Di::fromSize({}, {4, 2})}
+        }})
+       .pipelineBarrier(PipelineStage::Transfer, PipelineStage::Host, {
+           {Access::TransferWrite, Access::HostRead}
+        })
+       .end();
+    queue().submit({SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+
+    CORRADE_COMPARE(arrayView(buffer.dedicatedMemory().mapRead()),
+        "AaaaBbbbCcccDddd"
+        "EeeeFfffGgggHhhh"_s);
+}
+
+void UploaderVkTest::uploadImageAutomaticSubmit() {
+    Uploader uploader{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 16};
+
+    Image image{device(), ImageCreateInfo2D{
+        ImageUsage::TransferDestination|ImageUsage::TransferSource,
+        PixelFormat::RGBA8UI, {4, 2}, 1
+    }, MemoryFlag::DeviceLocal};
+
+    /* Each row fills the whole staging buffer, so the second upload to the
+       same subresource forces a submit in between. That one shouldn't
+       discard the first row by transitioning from ImageLayout::Undefined
+       again. */
+    uploader
+        .uploadImage(image, ImageLayout::TransferSource,
+            BufferImageCopy2D{0, ImageAspect::Color, 0, Range2Di::fromSize({0, 0}, {4, 1})},
+            "AaaaBbbbCcccDddd"_s)
+        .uploadImage(image, ImageLayout::TransferSource,
+            BufferImageCopy2D{0, ImageAspect::Color, 0, Range2Di::fromSize({0, 1}, {4, 1})},
+            "EeeeFfffGgggHhhh"_s);
+    CORRADE_COMPARE(uploader.submitCount(), 1);
+    CORRADE_COMPARE(uploader.pendingCopyCount(), 1);
+    uploader.wait();
+    CORRADE_COMPARE(uploader.submitCount(), 2);
+
+    CommandPool pool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+    CommandBuffer cmd = pool.allocate();
+    Buffer buffer{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 4*2*4
+    }, MemoryFlag::HostVisible};
+    cmd.begin()
+       .copyImageToBuffer(CopyImageToBufferInfo2D{image, ImageLayout::TransferSource, buffer, {
+           {0, ImageAspect::Color, 0, Range2Di::fromSize({}, {4, 2})}
+        }})
+       .pipelineBarrier(PipelineStage::Transfer, PipelineStage::Host, {
+           {Access::TransferWrite, Access::HostRead}
+        })
+       .end();
+    queue().submit({SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+
+    CORRADE_COMPARE(arrayView(buffer.dedicatedMemory().mapRead()),
+        "AaaaBbbbCcccDddd"
+        "EeeeFfffGgggHhhh"_s);
+}
+
+void UploaderVkTest::uploadImageTooLarge() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Uploader uploader{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 16};
+
+    Image image{device(), ImageCreateInfo2D{
+        ImageUsage::TransferDestination,
+        PixelFormat::RGBA8UI, {4, 2}, 1
+    }, MemoryFlag::DeviceLocal};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    uploader.uploadImage(image, ImageLayout::ShaderReadOnly,
+        BufferImageCopy2D{0, ImageAspect::Color, 0, Range2Di::fromSize({}, {4, 2})},
+        "AaaaBbbbCcccDddd"
+        "EeeeFfffGgggHhhh"_s);
+    CORRADE_COMPARE(out.str(), "Vk::Uploader::uploadImage(): expected at most 16 bytes but got 32\n");
+}
+
+void UploaderVkTest::submitNothing() {
+    Uploader uploader{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 64};
+
+    uploader.submit();
+    uploader.wait();
+    CORRADE_COMPARE(uploader.submitCount(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::UploaderVkTest)
@@ -0,0 +1,85 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ThreadCommandPools.h"
+
+#include <new>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Move.h>
+
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+
+namespace Magnum { namespace Vk {
+
+ThreadCommandPools::ThreadCommandPools(Device& device, const CommandPoolCreateInfo& info, const UnsignedInt threadCount, const UnsignedInt frameCount): _threadCount{threadCount}, _frameCount{frameCount}, _frame{} {
+    CORRADE_ASSERT(threadCount && frameCount,
+        "Vk::ThreadCommandPools: expected non-zero thread and frame count but got" << threadCount << "and" << frameCount, );
+
+    _pools = Containers::Array<CommandPool>{NoInit, std::size_t{threadCount}*frameCount};
+    for(CommandPool& pool: _pools) new(&pool) CommandPool{device, info};
+}
+
+ThreadCommandPools::ThreadCommandPools(NoCreateT) noexcept: _threadCount{}, _frameCount{}, _frame{} {}
+
+ThreadCommandPools::ThreadCommandPools(ThreadCommandPools&& other) noexcept: _pools{Utility::move(other._pools)}, _threadCount{other._threadCount}, _frameCount{other._frameCount}, _frame{other._frame} {
+    other._threadCount = other._frameCount = other._frame = 0;
+}
+
+ThreadCommandPools::~ThreadCommandPools() = default;
+
+ThreadCommandPools& ThreadCommandPools::operator=(ThreadCommandPools&& other) noexcept {
+    using Utility::swap;
+    swap(other._pools, _pools);
+    swap(other._threadCount, _threadCount);
+    swap(other._frameCount, _frameCount);
+    swap(other._frame, _frame);
+    return *this;
+}
+
+CommandPool& ThreadCommandPools::pool(const UnsignedInt thread) {
+    return pool(_frame, thread);
+}
+
+CommandPool& ThreadCommandPools::pool(const UnsignedInt frame, const UnsignedInt thread) {
+    #ifndef CORRADE_NO_ASSERT
+    /* The instance may have no pools at all if it's NoCreate'd or moved-out,
+       so the graceful assert fallback can't return any of them */
+    static CommandPool empty{NoCreate};
+    #endif
+    CORRADE_ASSERT(frame < _frameCount && thread < _threadCount,
+        "Vk::ThreadCommandPools::pool(): index" << frame << Debug::nospace << "," << Debug::nospace << thread << "out of range for" << _frameCount << "frames and" << _threadCount << "threads", empty);
+    return _pools[std::size_t{frame}*_threadCount + thread];
+}
+
+void ThreadCommandPools::nextFrame(const CommandPoolResetFlags flags) {
+    CORRADE_ASSERT(_frameCount,
+        "Vk::ThreadCommandPools::nextFrame(): the instance has no command pools", );
+
+    _frame = (_frame + 1) % _frameCount;
+    for(std::size_t i = 0; i != _threadCount; ++i)
+        _pools[std::size_t{_frame}*_threadCount + i].reset(flags);
+}
+
+}}
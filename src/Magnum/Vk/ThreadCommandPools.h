@@ -0,0 +1,180 @@
+#ifndef Magnum_Vk_ThreadCommandPools_h
+#define Magnum_Vk_ThreadCommandPools_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::ThreadCommandPools
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/CommandPool.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Per-thread, per-frame command pools
+@m_since_latest
+
+A set of @ref CommandPool instances for recording command buffers from
+multiple threads. Command pools are externally synchronized, so each thread
+needs its own pool to be able to allocate and record command buffers without
+locking. Additionally, because a command pool can be reset only once the GPU
+finished executing all command buffers allocated from it, the pools are
+duplicated for each frame in flight, resulting in
+@ref threadCount() @cpp * @ce @ref frameCount() pools in total.
+
+@section Vk-ThreadCommandPools-usage Usage
+
+Create the instance with a @ref CommandPoolCreateInfo that's used for all
+pools, a thread count and a count of frames in flight. Each worker thread then
+records into command buffers allocated from @ref pool(UnsignedInt) with its
+own thread index, usually @ref CommandBufferLevel::Secondary buffers that
+get executed from a primary command buffer using
+@ref CommandBuffer::executeCommands(). At the start of each frame, after
+waiting for the GPU to finish the frame that used the same set of pools,
+call @ref nextFrame() from the main thread to switch to and reset the pools
+for the next frame:
+
+@snippet Vk.cpp ThreadCommandPools-usage
+
+Command buffers allocated from the pools stay allocated across
+@ref nextFrame() calls, only their contents are reset. It's thus possible to
+allocate them just once for each thread and frame and then keep re-recording
+them, which avoids the allocation overhead altogether.
+
+@attention
+    The class itself isn't synchronized in any way. It's safe to access
+    @ref pool() with different thread indices from different threads at the
+    same time, but @ref nextFrame() has to be called only when none of the
+    worker threads is recording.
+
+@see @ref Vk-CommandBuffer-secondary
+*/
+class MAGNUM_VK_EXPORT ThreadCommandPools {
+    public:
+        /**
+         * @brief Constructor
+         * @param device        Vulkan device to create the command pools on
+         * @param info          Command pool creation info, used for all pools
+         * @param threadCount   Count of threads recording command buffers.
+         *      Expected to be non-zero.
+         * @param frameCount    Count of frames in flight. Expected to be
+         *      non-zero.
+         *
+         * Creates @p threadCount @cpp * @ce @p frameCount command pools.
+         * The @ref frame() is set to @cpp 0 @ce.
+         * @see @fn_vk_keyword{CreateCommandPool}
+         */
+        explicit ThreadCommandPools(Device& device, const CommandPoolCreateInfo& info, UnsignedInt threadCount, UnsignedInt frameCount);
+
+        /**
+         * @brief Construct without creating the command pools
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit ThreadCommandPools(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        ThreadCommandPools(const ThreadCommandPools&) = delete;
+
+        /** @brief Move constructor */
+        ThreadCommandPools(ThreadCommandPools&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys all command pools.
+         * @see @fn_vk_keyword{DestroyCommandPool}
+         */
+        ~ThreadCommandPools();
+
+        /** @brief Copying is not allowed */
+        ThreadCommandPools& operator=(const ThreadCommandPools&) = delete;
+
+        /** @brief Move assignment */
+        ThreadCommandPools& operator=(ThreadCommandPools&& other) noexcept;
+
+        /** @brief Thread count */
+        UnsignedInt threadCount() const { return _threadCount; }
+
+        /** @brief Count of frames in flight */
+        UnsignedInt frameCount() const { return _frameCount; }
+
+        /**
+         * @brief Current frame index
+         *
+         * A value in range @f$ [ 0, \operatorname{frameCount}() ) @f$,
+         * advanced by @ref nextFrame().
+         */
+        UnsignedInt frame() const { return _frame; }
+
+        /**
+         * @brief Command pool for given thread in the current frame
+         *
+         * Expects that @p thread is less than @ref threadCount().
+         * Equivalent to calling @ref pool(UnsignedInt, UnsignedInt) with
+         * @ref frame() as the first argument.
+         */
+        CommandPool& pool(UnsignedInt thread);
+
+        /**
+         * @brief Command pool for given frame and thread
+         *
+         * Expects that @p frame is less than @ref frameCount() and
+         * @p thread is less than @ref threadCount().
+         */
+        CommandPool& pool(UnsignedInt frame, UnsignedInt thread);
+
+        /**
+         * @brief Advance to the next frame
+         * @param flags     Flags passed to @ref CommandPool::reset()
+         *
+         * Sets @ref frame() to the next index, wrapping around to
+         * @cpp 0 @ce after @ref frameCount(), and resets all command pools
+         * of that frame. Before calling this function, it's the user
+         * responsibility to ensure the GPU finished executing command
+         * buffers from the frame that previously used the same pools, and
+         * that no worker thread is recording at the moment.
+         * @see @fn_vk_keyword{ResetCommandPool}
+         */
+        void nextFrame(CommandPoolResetFlags flags = {});
+
+    private:
+        Containers::Array<CommandPool> _pools;
+        UnsignedInt _threadCount, _frameCount, _frame;
+};
+
+}}
+
+#endif
@@ -0,0 +1,386 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Uploader.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Math.h>
+
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/Fence.h"
+#include "Magnum/Vk/Image.h"
+#include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/Queue.h"
+
+namespace Magnum { namespace Vk {
+
+namespace Implementation {
+
+namespace {
+
+/* Count of submissions that can be in flight at the same time. When all are
+   in flight, the oldest one is waited on before submitting a new one. */
+constexpr UnsignedInt UploaderSubmissionCount = 4;
+
+/* Alignment of data in the staging buffer. Satisfies the bufferOffset
+   requirements of vkCmdCopyBufferToImage() for all power-of-two texel block
+   sizes up to 16 bytes. */
+constexpr UnsignedLong UploaderStagingAlignment = 16;
+
+}
+
+struct UploaderSubmission {
+    CommandBuffer commandBuffer{NoCreate};
+    Fence fence{NoCreate};
+    /* Value of UploaderState::head at the time of submission, becomes the
+       new tail once the submission finishes */
+    UnsignedLong end;
+};
+
+struct UploaderBufferCopy {
+    VkBuffer buffer;
+    UnsignedLong stagingOffset;
+    UnsignedLong offset;
+    UnsignedLong size;
+};
+
+struct UploaderImageCopy {
+    VkImage image;
+    ImageLayout finalLayout;
+    VkBufferImageCopy2KHR region;
+};
+
+struct UploaderSubresource {
+    VkImage image;
+    VkImageSubresourceLayers subresource;
+    /* Layout the subresource was left in by the last submission */
+    ImageLayout layout;
+};
+
+struct UploaderState {
+    explicit UploaderState(Device& device, Queue& queue, UnsignedInt queueFamilyIndex, UnsignedLong stagingSize);
+
+    bool isEmpty() const {
+        return !inFlightCount && bufferCopies.isEmpty() && imageCopies.isEmpty();
+    }
+
+    void retireOldest();
+
+    Queue& queue;
+    /* Order of the members matters -- the command buffers have to be freed
+       before the pool, the staging memory unmapped before it's freed */
+    CommandPool pool;
+    Buffer staging;
+    Containers::Array<char, MemoryMapDeleter> stagingData;
+    UploaderSubmission submissions[UploaderSubmissionCount];
+    UnsignedInt nextSubmission{}, oldestSubmission{}, inFlightCount{};
+
+    /* Data of pending and in-flight copies occupy the range from tail to
+       head, possibly wrapping around the staging buffer end */
+    UnsignedLong head{}, tail{};
+
+    Containers::Array<UploaderBufferCopy> bufferCopies;
+    Containers::Array<UploaderImageCopy> imageCopies;
+    /* Image subresources uploaded to since the last explicit submit(). If an
+       automatic submit happens in between, further uploads to these
+       transition from the recorded layout instead of Undefined so the
+       already uploaded contents don't get discarded. */
+    Containers::Array<UploaderSubresource> subresources;
+    UnsignedInt submitCount{};
+};
+
+UploaderState::UploaderState(Device& device, Queue& queue, const UnsignedInt queueFamilyIndex, const UnsignedLong stagingSize): queue(queue),
+    pool{device, CommandPoolCreateInfo{queueFamilyIndex, CommandPoolCreateInfo::Flag::Transient|CommandPoolCreateInfo::Flag::ResetCommandBuffer}},
+    staging{device, BufferCreateInfo{BufferUsage::TransferSource, stagingSize}, MemoryFlag::HostVisible|MemoryFlag::HostCoherent},
+    stagingData{staging.dedicatedMemory().map()}
+{
+    for(UploaderSubmission& submission: submissions) {
+        submission.commandBuffer = pool.allocate();
+        submission.fence = Fence{device};
+    }
+}
+
+void UploaderState::retireOldest() {
+    CORRADE_INTERNAL_ASSERT(inFlightCount);
+    UploaderSubmission& submission = submissions[oldestSubmission];
+    submission.fence.wait();
+    tail = submission.end;
+    oldestSubmission = (oldestSubmission + 1) % UploaderSubmissionCount;
+    --inFlightCount;
+}
+
+}
+
+Uploader::Uploader(Device& device, Queue& queue, const UnsignedInt queueFamilyIndex, const UnsignedLong stagingSize) {
+    CORRADE_ASSERT(stagingSize >= Implementation::UploaderStagingAlignment,
+        "Vk::Uploader: expected staging size to be at least" << Implementation::UploaderStagingAlignment << "bytes but got" << stagingSize, );
+
+    _state = Containers::pointer<Implementation::UploaderState>(device, queue, queueFamilyIndex, stagingSize);
+}
+
+Uploader::Uploader(NoCreateT) noexcept {}
+
+Uploader::Uploader(Uploader&&) noexcept = default;
+
+Uploader::~Uploader() {
+    if(_state) while(_state->inFlightCount) _state->retireOldest();
+}
+
+Uploader& Uploader::operator=(Uploader&&) noexcept = default;
+
+UnsignedLong Uploader::stagingSize() const {
+    return _state ? _state->stagingData.size() : 0;
+}
+
+std::size_t Uploader::pendingCopyCount() const {
+    return _state ? _state->bufferCopies.size() + _state->imageCopies.size() : 0;
+}
+
+UnsignedInt Uploader::submitCount() const {
+    return _state ? _state->submitCount : 0;
+}
+
+UnsignedLong Uploader::allocate(const UnsignedLong size) {
+    Implementation::UploaderState& state = *_state;
+    const UnsignedLong stagingSize = state.stagingData.size();
+    CORRADE_INTERNAL_ASSERT(size <= stagingSize);
+
+    for(;;) {
+        /* If nothing is pending or in flight, start from the beginning
+           again to have the largest contiguous space available */
+        if(state.isEmpty()) state.head = state.tail = 0;
+
+        const UnsignedLong alignedHead = (state.head + Implementation::UploaderStagingAlignment - 1) & ~(Implementation::UploaderStagingAlignment - 1);
+        const bool wrapped = state.head < state.tail || (state.head == state.tail && !state.isEmpty());
+
+        /* If the occupied range doesn't wrap around, there's free space
+           both after the head and before the tail. Otherwise only between
+           the head and the tail. */
+        if(!wrapped) {
+            if(alignedHead + size <= stagingSize) {
+                state.head = alignedHead + size;
+                return alignedHead;
+            }
+            if(size <= state.tail) {
+                state.head = size;
+                return 0;
+            }
+        } else if(alignedHead + size <= state.tail) {
+            state.head = alignedHead + size;
+            return alignedHead;
+        }
+
+        /* Not enough space, submit the pending copies first. If there are
+           none or it didn't help, wait for the oldest submission to finish
+           to free up its space. */
+        if(!state.bufferCopies.isEmpty() || !state.imageCopies.isEmpty())
+            submitPending();
+        else
+            state.retireOldest();
+    }
+}
+
+Uploader& Uploader::uploadBuffer(const VkBuffer buffer, UnsignedLong offset, const Containers::ArrayView<const void> data) {
+    Implementation::UploaderState& state = *_state;
+
+    /* Split large uploads into parts that take at most a half of the
+       staging buffer, so the CPU can fill one part while the GPU copies
+       another */
+    const UnsignedLong maxSize = Utility::max(UnsignedLong(state.stagingData.size()/2), Implementation::UploaderStagingAlignment);
+    const char* src = static_cast<const char*>(data.data());
+    UnsignedLong remaining = data.size();
+    while(remaining) {
+        const UnsignedLong size = Utility::min(remaining, maxSize);
+        const UnsignedLong stagingOffset = allocate(size);
+        Utility::copy(Containers::arrayView(src, size),
+            state.stagingData.slice(stagingOffset, stagingOffset + size));
+        arrayAppend(state.bufferCopies, InPlaceInit, buffer, stagingOffset, offset, size);
+
+        src += size;
+        offset += size;
+        remaining -= size;
+    }
+
+    return *this;
+}
+
+Uploader& Uploader::uploadImage(const VkImage image, const ImageLayout finalLayout, const BufferImageCopy& region, const Containers::ArrayView<const void> data) {
+    Implementation::UploaderState& state = *_state;
+    CORRADE_ASSERT(data.size() <= state.stagingData.size(),
+        "Vk::Uploader::uploadImage(): expected at most" << state.stagingData.size() << "bytes but got" << data.size(), *this);
+
+    const UnsignedLong stagingOffset = allocate(data.size());
+    Utility::copy(Containers::arrayView(static_cast<const char*>(data.data()), data.size()),
+        state.stagingData.slice(stagingOffset, stagingOffset + data.size()));
+
+    VkBufferImageCopy2KHR vkRegion = *region;
+    vkRegion.bufferOffset += stagingOffset;
+    arrayAppend(state.imageCopies, InPlaceInit, image, finalLayout, vkRegion);
+
+    return *this;
+}
+
+namespace {
+
+bool isSameSubresource(const VkImage aImage, const VkImageSubresourceLayers& a, const VkImage bImage, const VkImageSubresourceLayers& b) {
+    return aImage == bImage &&
+        a.aspectMask == b.aspectMask &&
+        a.mipLevel == b.mipLevel &&
+        a.baseArrayLayer == b.baseArrayLayer &&
+        a.layerCount == b.layerCount;
+}
+
+}
+
+Uploader& Uploader::submit() {
+    submitPending();
+
+    /* An explicit submit ends the batch, next uploads to the same
+       subresources start from scratch again */
+    arrayRemoveSuffix(_state->subresources, _state->subresources.size());
+    return *this;
+}
+
+void Uploader::submitPending() {
+    Implementation::UploaderState& state = *_state;
+    if(state.bufferCopies.isEmpty() && state.imageCopies.isEmpty())
+        return;
+
+    /* If all submissions are in flight, wait for the oldest one to get its
+       command buffer and fence back */
+    if(state.inFlightCount == Implementation::UploaderSubmissionCount)
+        state.retireOldest();
+    Implementation::UploaderSubmission& submission = state.submissions[state.nextSubmission];
+    CommandBuffer& cmd = submission.commandBuffer;
+
+    cmd.reset();
+    cmd.begin(CommandBufferBeginInfo{CommandBufferBeginInfo::Flag::OneTimeSubmit});
+
+    /* Image subresources first need to be transitioned to a layout suitable
+       for a copy, and then to the final layout after. Put all transitions
+       into a single barrier call, with each subresource listed just once.
+       Subresources that got data already in an earlier automatic submit are
+       transitioned from the layout they were left in, which then also
+       has to wait for the earlier copy. */
+    Containers::Array<ImageMemoryBarrier> beforeBarriers;
+    Containers::Array<ImageMemoryBarrier> afterBarriers;
+    PipelineStages beforeStages = PipelineStage::TopOfPipe;
+    for(std::size_t i = 0; i != state.imageCopies.size(); ++i) {
+        const Implementation::UploaderImageCopy& copy = state.imageCopies[i];
+        const VkImageSubresourceLayers& subresource = copy.region.imageSubresource;
+        bool found = false;
+        for(std::size_t j = 0; j != i; ++j) if(isSameSubresource(state.imageCopies[j].image, state.imageCopies[j].region.imageSubresource, copy.image, subresource)) {
+            found = true;
+            break;
+        }
+        if(found) continue;
+
+        ImageLayout oldLayout = ImageLayout::Undefined;
+        Accesses oldAccesses;
+        Implementation::UploaderSubresource* uploaded = nullptr;
+        for(Implementation::UploaderSubresource& tracked: state.subresources) if(isSameSubresource(tracked.image, tracked.subresource, copy.image, subresource)) {
+            uploaded = &tracked;
+            break;
+        }
+        if(uploaded) {
+            oldLayout = uploaded->layout;
+            oldAccesses = Access::TransferWrite;
+            beforeStages = PipelineStage::Transfer;
+            uploaded->layout = copy.finalLayout;
+        } else arrayAppend(state.subresources, InPlaceInit, copy.image, subresource, copy.finalLayout);
+
+        arrayAppend(beforeBarriers, InPlaceInit,
+            oldAccesses, Access::TransferWrite,
+            oldLayout, ImageLayout::TransferDestination,
+            copy.image, ImageAspects{ImageAspect(subresource.aspectMask)},
+            subresource.baseArrayLayer, subresource.layerCount,
+            subresource.mipLevel, 1u);
+        arrayAppend(afterBarriers, InPlaceInit,
+            Access::TransferWrite, Access::MemoryRead,
+            ImageLayout::TransferDestination, copy.finalLayout,
+            copy.image, ImageAspects{ImageAspect(subresource.aspectMask)},
+            subresource.baseArrayLayer, subresource.layerCount,
+            subresource.mipLevel, 1u);
+    }
+    if(!beforeBarriers.isEmpty())
+        cmd.pipelineBarrier(beforeStages, PipelineStage::Transfer, beforeBarriers);
+
+    /* Merge consecutive copies to the same buffer into a single command */
+    {
+        Containers::Array<BufferCopy> regions;
+        for(std::size_t i = 0; i != state.bufferCopies.size(); ) {
+            const VkBuffer buffer = state.bufferCopies[i].buffer;
+            arrayRemoveSuffix(regions, regions.size());
+            for(; i != state.bufferCopies.size() && state.bufferCopies[i].buffer == buffer; ++i) {
+                const Implementation::UploaderBufferCopy& copy = state.bufferCopies[i];
+                arrayAppend(regions, InPlaceInit, copy.stagingOffset, copy.offset, copy.size);
+            }
+            cmd.copyBuffer(CopyBufferInfo{state.staging, buffer, regions});
+        }
+    }
+
+    /* Same for images */
+    {
+        Containers::Array<BufferImageCopy> regions;
+        for(std::size_t i = 0; i != state.imageCopies.size(); ) {
+            const VkImage image = state.imageCopies[i].image;
+            arrayRemoveSuffix(regions, regions.size());
+            for(; i != state.imageCopies.size() && state.imageCopies[i].image == image; ++i)
+                arrayAppend(regions, InPlaceInit, state.imageCopies[i].region);
+            cmd.copyBufferToImage(CopyBufferToImageInfo{state.staging, image, ImageLayout::TransferDestination, regions});
+        }
+    }
+
+    /* Make the results available to everything that comes after. Buffers
+       are covered by a global memory barrier, images additionally get
+       transitioned to their final layouts. */
+    const MemoryBarrier memoryBarrier{Access::TransferWrite, Access::MemoryRead};
+    cmd.pipelineBarrier(PipelineStage::Transfer, PipelineStage::AllCommands,
+        {&memoryBarrier, 1}, {}, afterBarriers);
+
+    cmd.end();
+
+    submission.fence.reset();
+    state.queue.submit({SubmitInfo{}.setCommandBuffers({cmd})}, submission.fence);
+    submission.end = state.head;
+
+    state.nextSubmission = (state.nextSubmission + 1) % Implementation::UploaderSubmissionCount;
+    ++state.inFlightCount;
+    ++state.submitCount;
+    arrayRemoveSuffix(state.bufferCopies, state.bufferCopies.size());
+    arrayRemoveSuffix(state.imageCopies, state.imageCopies.size());
+}
+
+void Uploader::wait() {
+    submit();
+    while(_state->inFlightCount) _state->retireOldest();
+}
+
+}}
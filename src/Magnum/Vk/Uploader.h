@@ -0,0 +1,244 @@
+#ifndef Magnum_Vk_Uploader_h
+#define Magnum_Vk_Uploader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::Uploader
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+namespace Implementation { struct UploaderState; }
+
+/**
+@brief Batching staging uploader
+@m_since_latest
+
+Uploading data to device-local memory requires copying them to a host-visible
+staging buffer first and then recording a @ref CommandBuffer::copyBuffer() or
+@ref CommandBuffer::copyBufferToImage() together with appropriate
+@ref CommandBuffer::pipelineBarrier() calls. Doing that separately for each
+buffer and image, each with its own staging allocation, command buffer and
+fence, makes loading of larger scenes dominated by submit and synchronization
+overhead. This class instead copies all data into a single persistently mapped
+staging ring buffer and records copies of many resources into a single
+command buffer, which is then submitted just once.
+
+@section Vk-Uploader-usage Usage
+
+The uploader is created on a @ref Device with a @ref Queue that's used for
+the submits and a matching queue family index. The queue can be a dedicated
+transfer queue, see below for restrictions related to that.
+
+@snippet Vk.cpp Uploader-usage
+
+Data passed to @ref uploadBuffer() and @ref uploadImage() get copied into the
+staging buffer right away, so the original memory can be freed immediately
+after the call. The copies are only recorded and submitted once @ref submit()
+or @ref wait() is called or once the staging buffer is full. The destination
+resources can't be used until the uploads finish, which is guaranteed by
+calling @ref wait().
+
+To upload a whole @ref Trade::MeshData and get a @ref Mesh configured for
+generic shader attribute locations, use
+@ref MeshTools::compile(Vk::Device&, Vk::Uploader&, const Trade::MeshData&).
+
+@section Vk-Uploader-ring Staging ring
+
+The staging buffer is used as a ring --- when it gets full, pending copies get
+submitted and the uploader continues filling the remaining space, only waiting
+for the GPU when it would need to overwrite data of copies that are still in
+progress. Buffer uploads larger than the whole staging buffer are split into
+multiple copies, images are expected to fit into the staging buffer as a whole.
+
+@section Vk-Uploader-barriers Synchronization
+
+Consecutive uploads to the same buffer or image are merged into a single
+copy command. Images are transitioned from @ref ImageLayout::Undefined to
+@ref ImageLayout::TransferDestination for the copy, discarding any previous
+contents, and then to the layout specified in @ref uploadImage() after. For
+this reason all uploads to a particular image subresource should be done
+before a @ref submit(). If the staging buffer gets full in the middle of
+uploads to a subresource, the copies get submitted automatically and the
+subresource is then transitioned from the layout it was left in instead of
+@ref ImageLayout::Undefined, so data uploaded before the automatic submit are
+preserved. At the end of each submission, a memory barrier making
+the results of all copies available for @ref Access::MemoryRead in
+@ref PipelineStage::AllCommands is recorded.
+
+No queue family ownership transfers are done. If the queue used by the
+uploader is from a different queue family than queues that later use the
+resources, the resources have to be created with a concurrent sharing mode.
+
+@section Vk-Uploader-lifetime Lifetime and thread safety
+
+Destination resources have to stay alive until the uploads finish. The
+destructor waits for all submitted uploads to finish, but copies that weren't
+submitted yet get discarded. The class isn't thread-safe.
+*/
+class MAGNUM_VK_EXPORT Uploader {
+    public:
+        /**
+         * @brief Constructor
+         * @param device            Vulkan device to upload the data to
+         * @param queue             Queue to submit the copies to. Has to
+         *      support transfer operations.
+         * @param queueFamilyIndex  Family index of @p queue
+         * @param stagingSize       Size of the staging buffer
+         *
+         * Allocates a @ref MemoryFlag::HostVisible and
+         * @ref MemoryFlag::HostCoherent staging buffer of @p stagingSize
+         * bytes and maps it for the whole uploader lifetime.
+         */
+        explicit Uploader(Device& device, Queue& queue, UnsignedInt queueFamilyIndex, UnsignedLong stagingSize = 16*1024*1024);
+
+        /**
+         * @brief Construct without creating the uploader
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit Uploader(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        Uploader(const Uploader&) = delete;
+
+        /** @brief Move constructor */
+        Uploader(Uploader&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Waits for all submitted uploads to finish. Pending uploads that
+         * weren't submitted yet are discarded.
+         */
+        ~Uploader();
+
+        /** @brief Copying is not allowed */
+        Uploader& operator=(const Uploader&) = delete;
+
+        /** @brief Move assignment */
+        Uploader& operator=(Uploader&& other) noexcept;
+
+        /** @brief Staging buffer size */
+        UnsignedLong stagingSize() const;
+
+        /**
+         * @brief Count of pending copies
+         *
+         * Copies that were not submitted yet. Consecutive uploads to the same
+         * buffer or image are counted separately even though they're later
+         * merged into a single copy command.
+         */
+        std::size_t pendingCopyCount() const;
+
+        /**
+         * @brief Count of submits done so far
+         *
+         * Includes submits done implicitly when the staging buffer got full.
+         */
+        UnsignedInt submitCount() const;
+
+        /**
+         * @brief Upload data to a buffer
+         * @param buffer    Destination @ref Buffer or a raw Vulkan buffer
+         *      handle. Expected to have been created with
+         *      @ref BufferUsage::TransferDestination.
+         * @param offset    Offset in the destination buffer, in bytes
+         * @param data      Data to upload
+         * @return Reference to self (for method chaining)
+         *
+         * The @p data are copied to the staging buffer immediately. If
+         * there's not enough space in the staging buffer, pending copies are
+         * submitted and the function waits for earlier submits to finish if
+         * needed. Data larger than @ref stagingSize() are uploaded in
+         * multiple parts. Empty @p data are ignored.
+         */
+        Uploader& uploadBuffer(VkBuffer buffer, UnsignedLong offset, Containers::ArrayView<const void> data);
+
+        /**
+         * @brief Upload data to an image
+         * @param image         Destination @ref Image or a raw Vulkan image
+         *      handle. Expected to have been created with
+         *      @ref ImageUsage::TransferDestination.
+         * @param finalLayout   Layout to transition the image subresource
+         *      to after the copy
+         * @param region        Region to copy. Its `bufferOffset` is
+         *      treated as an offset into @p data and gets adjusted to point
+         *      into the staging buffer.
+         * @param data          Data to upload
+         * @return Reference to self (for method chaining)
+         *
+         * The @p data are copied to the staging buffer immediately,
+         * expected to fit into @ref stagingSize(). The data are placed at an
+         * offset aligned to 16 bytes, so formats with a texel block size that
+         * isn't a power of two are not supported. If there's not enough space
+         * in the staging buffer, pending copies are submitted and the
+         * function waits for earlier submits to finish if needed.
+         */
+        Uploader& uploadImage(VkImage image, ImageLayout finalLayout, const BufferImageCopy& region, Containers::ArrayView<const void> data);
+
+        /**
+         * @brief Submit pending copies
+         * @return Reference to self (for method chaining)
+         *
+         * Records all pending copies with corresponding barriers into a
+         * single command buffer and submits it to the queue. If there are no
+         * pending copies, the function does nothing. Doesn't wait for the
+         * submission to finish, use @ref wait() for that.
+         * @see @fn_vk_keyword{QueueSubmit}
+         */
+        Uploader& submit();
+
+        /**
+         * @brief Submit pending copies and wait for all uploads to finish
+         *
+         * After this function returns, all destination resources can be
+         * used.
+         * @see @ref submit(), @fn_vk_keyword{WaitForFences}
+         */
+        void wait();
+
+    private:
+        MAGNUM_VK_LOCAL UnsignedLong allocate(UnsignedLong size);
+        MAGNUM_VK_LOCAL void submitPending();
+
+        Containers::Pointer<Implementation::UploaderState> _state;
+};
+
+}}
+
+#endif
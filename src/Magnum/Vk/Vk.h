@@ -40,9 +40,11 @@ enum class Access: UnsignedInt;
 typedef Containers::EnumSet<Access> Accesses;
 class Buffer;
 class BufferCreateInfo;
+class BufferImageCopy;
 class BufferMemoryBarrier;
 class CommandBuffer;
-/* CommandBufferBeginInfo is useful only in combination with CommandBuffer */
+/* CommandBufferBeginInfo, CommandBufferInheritanceInfo are useful only in
+   combination with CommandBuffer */
 class CommandPool;
 class CommandPoolCreateInfo;
 class ComputePipelineCreateInfo;
@@ -50,8 +52,6 @@ class ComputePipelineCreateInfo;
 class CopyBufferInfo;
 /* ImageCopy used only directly inside CopyImageInfo */
 class CopyImageInfo;
-/* BufferImageCopy used only directly inside CopyBufferToImageInfo /
-   CopyImageToBufferInfo */
 class CopyBufferToImageInfo;
 class CopyImageToBufferInfo;
 /* Not forward-declaring CopyBufferToImageInfo1D etc right now, I see no need */
@@ -63,6 +63,7 @@ class DescriptorSet;
 class DescriptorSetLayout;
 class DescriptorSetLayoutCreateInfo;
 enum class DescriptorType: Int;
+class DescriptorWrite;
 class Device;
 class DeviceCreateInfo;
 enum class DeviceFeature: UnsignedShort;
@@ -77,6 +78,8 @@ class Fence;
 class FenceCreateInfo;
 class Framebuffer;
 class FramebufferCreateInfo;
+class FrameDescriptorAllocator;
+class FramePacer;
 enum class HandleFlag: UnsignedByte;
 typedef Containers::EnumSet<HandleFlag> HandleFlags;
 class Image;
@@ -94,8 +97,14 @@ class InstanceCreateInfo;
 class InstanceExtension;
 class InstanceExtensionProperties;
 class LayerProperties;
+class LayoutCache;
 class Memory;
 class MemoryAllocateInfo;
+class MemoryAllocation;
+enum class MemoryAllocationFlag: UnsignedByte;
+typedef Containers::EnumSet<MemoryAllocationFlag> MemoryAllocationFlags;
+class MemoryAllocator;
+class MemoryArena;
 class MemoryBarrier;
 class MemoryMapDeleter;
 class MemoryRequirements;
@@ -109,15 +118,28 @@ class MeshLayout;
 enum class MeshPrimitive: Int;
 class Pipeline;
 enum class PipelineBindPoint: Int;
+class PipelineCache;
+class PipelineCacheCreateInfo;
 class PipelineLayout;
 class PipelineLayoutCreateInfo;
 enum class PipelineStage: UnsignedInt;
 typedef Containers::EnumSet<PipelineStage> PipelineStages;
 enum class PixelFormat: Int;
+enum class QueryControlFlag: UnsignedInt;
+typedef Containers::EnumSet<QueryControlFlag> QueryControlFlags;
+enum class QueryPipelineStatistic: UnsignedInt;
+typedef Containers::EnumSet<QueryPipelineStatistic> QueryPipelineStatistics;
+class QueryPool;
+class QueryPoolCreateInfo;
+enum class QueryResultFlag: UnsignedInt;
+typedef Containers::EnumSet<QueryResultFlag> QueryResultFlags;
+enum class QueryType: Int;
 class Queue;
 enum class QueueFlag: UnsignedInt;
 typedef Containers::EnumSet<QueueFlag> QueueFlags;
 class RasterizationPipelineCreateInfo;
+class RenderGraph;
+enum class RenderGraphUsage: UnsignedByte;
 class RenderPass;
 class RenderPassBeginInfo;
 class RenderPassCreateInfo;
@@ -130,8 +152,11 @@ class SamplerCreateInfo;
 enum class SamplerFilter: Int;
 enum class SamplerMipmap: Int;
 enum class SamplerWrapping: Int;
+class Semaphore;
+class SemaphoreCreateInfo;
 class Shader;
 class ShaderCreateInfo;
+class ShaderReflection;
 class ShaderSet;
 /* ShaderSpecialization used only directly with ShaderSet */
 enum class ShaderStage: UnsignedInt;
@@ -142,6 +167,8 @@ typedef Containers::EnumSet<ShaderStage, 0x7FFFFFFF> ShaderStages;
 class SubmitInfo;
 class SubpassBeginInfo;
 class SubpassEndInfo;
+class ThreadCommandPools;
+class Uploader;
 enum class Version: UnsignedInt;
 enum class VertexFormat: Int;
 #endif
@@ -45,7 +45,11 @@ AnyImporter::AnyImporter(PluginManager::AbstractManager& manager, const std::str
 
 AnyImporter::~AnyImporter() = default;
 
-ImporterFeatures AnyImporter::doFeatures() const { return {}; }
+ImporterFeatures AnyImporter::doFeatures() const {
+    /* Streaming and data views are advertised only if the concrete plugin
+       supports them */
+    return _in ? _in->features() & (ImporterFeature::Streaming|ImporterFeature::DataView) : ImporterFeatures{};
+}
 
 bool AnyImporter::doIsOpened() const { return !!_in; }
 
@@ -104,6 +108,18 @@ UnsignedInt AnyImporter::doFrequency() const { return _in->frequency(); }
 
 Containers::Array<char> AnyImporter::doData() { return _in->data(); }
 
+Containers::ArrayView<const char> AnyImporter::doDataView() { return _in->dataView(); }
+
+std::size_t AnyImporter::doFrameCount() const { return _in->frameCount(); }
+
+std::size_t AnyImporter::doFrameOffset() const { return _in->frameOffset(); }
+
+void AnyImporter::doReadInto(const Containers::ArrayView<char> destination) {
+    _in->readInto(destination);
+}
+
+void AnyImporter::doSeek(const std::size_t frame) { _in->seek(frame); }
+
 }}
 
 CORRADE_PLUGIN_REGISTER(AnyAudioImporter, Magnum::Audio::AnyImporter,
@@ -118,6 +118,11 @@ configuration of the target plugin.
 Calls to the @ref format(), @ref frequency() and @ref data() functions are then
 proxied to the concrete implementation. The @ref close() function closes and
 discards the internally instantiated plugin; @ref isOpened() works as usual.
+
+If the concrete implementation supports @ref ImporterFeature::Streaming or
+@ref ImporterFeature::DataView, it's advertised by @ref features() as well once
+a file is opened, and calls to @ref frameCount(), @ref frameOffset(),
+@ref readInto(), @ref seek() and @ref dataView() are proxied too.
 */
 class MAGNUM_ANYAUDIOIMPORTER_EXPORT AnyImporter: public AbstractImporter {
     public:
@@ -138,6 +143,12 @@ class MAGNUM_ANYAUDIOIMPORTER_EXPORT AnyImporter: public AbstractImporter {
         MAGNUM_ANYAUDIOIMPORTER_LOCAL BufferFormat doFormat() const override;
         MAGNUM_ANYAUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_ANYAUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL Containers::ArrayView<const char> doDataView() override;
+
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL std::size_t doFrameCount() const override;
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL std::size_t doFrameOffset() const override;
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL void doReadInto(Containers::ArrayView<char> destination) override;
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL void doSeek(std::size_t frame) override;
 
         Containers::Pointer<AbstractImporter> _in;
 };
@@ -27,6 +27,7 @@
 #include <Corrade/Containers/Array.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/FormatStl.h>
@@ -42,6 +43,7 @@ struct AnyImporterTest: TestSuite::Tester {
     explicit AnyImporterTest();
 
     void load();
+    void streaming();
     void detect();
 
     void unknown();
@@ -74,6 +76,8 @@ AnyImporterTest::AnyImporterTest() {
     addInstancedTests({&AnyImporterTest::load},
         Containers::arraySize(LoadData));
 
+    addTests({&AnyImporterTest::streaming});
+
     addInstancedTests({&AnyImporterTest::detect},
         Containers::arraySize(DetectData));
 
@@ -112,6 +116,34 @@ void AnyImporterTest::load() {
     CORRADE_VERIFY(!importer->isOpened());
 }
 
+void AnyImporterTest::streaming() {
+    if(!(_manager.loadState("WavAudioImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("WavAudioImporter plugin not enabled, cannot test");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnyAudioImporter");
+    CORRADE_VERIFY(!(importer->features() & ImporterFeature::Streaming));
+
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo8.wav")));
+    CORRADE_VERIFY(importer->features() & ImporterFeature::Streaming);
+    CORRADE_COMPARE(importer->frameCount(), 2);
+
+    char out[2];
+    CORRADE_COMPARE(importer->readInto(out), 1);
+    CORRADE_COMPARE(importer->frameOffset(), 1);
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView<char>({
+        '\xde', '\xfe'
+    }), TestSuite::Compare::Container);
+
+    importer->seek(0);
+    CORRADE_COMPARE(importer->frameOffset(), 0);
+
+    CORRADE_VERIFY(importer->features() & ImporterFeature::DataView);
+    CORRADE_COMPARE(importer->dataView().size(), 4);
+
+    importer->close();
+    CORRADE_VERIFY(!(importer->features() & ImporterFeature::Streaming));
+}
+
 void AnyImporterTest::detect() {
     auto&& data = DetectData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -65,6 +65,9 @@ AnySceneImporter::AnySceneImporter(PluginManager::AbstractManager& manager, cons
 AnySceneImporter::~AnySceneImporter() = default;
 
 ImporterFeatures AnySceneImporter::doFeatures() const {
+    /* Concurrent access is possible only if the concrete plugin allows it */
+    if(_in && (_in->features() & ImporterFeature::ConcurrentDataAccess))
+        return ImporterFeature::FileCallback|ImporterFeature::ConcurrentDataAccess;
     return ImporterFeature::FileCallback;
 }
 
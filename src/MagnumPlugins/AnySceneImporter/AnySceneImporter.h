@@ -154,6 +154,11 @@ count-/name-related functions are then proxied to the concrete implementation.
 The @ref close() function closes and discards the internally instantiated
 plugin; @ref isOpened() works as usual.
 
+If the concrete implementation advertises
+@ref ImporterFeature::ConcurrentDataAccess, the feature is advertised by
+@ref features() as well while the file is opened, as the proxied calls don't
+touch any state of the @ref AnySceneImporter itself.
+
 While the @ref meshAttributeName(), @ref meshAttributeForName(),
 @ref sceneFieldName() and @ref sceneFieldForName() APIs can be called without a
 file opened, they return an empty string or an invalid attribute in that case.
@@ -73,6 +73,8 @@ struct AnySceneImporterTest: TestSuite::Tester {
     void propagateConfigurationUnknownInEmptySubgroup();
     void propagateFileCallback();
 
+    void concurrentDataAccess();
+
     void animations();
     void animationTrackTargetNameNoFileOpened();
 
@@ -161,6 +163,8 @@ AnySceneImporterTest::AnySceneImporterTest() {
     addTests({&AnySceneImporterTest::propagateConfigurationUnknownInEmptySubgroup,
               &AnySceneImporterTest::propagateFileCallback,
 
+              &AnySceneImporterTest::concurrentDataAccess,
+
               &AnySceneImporterTest::animations,
               &AnySceneImporterTest::animationTrackTargetNameNoFileOpened,
 
@@ -403,6 +407,23 @@ void AnySceneImporterTest::propagateFileCallback() {
     CORRADE_VERIFY(!importer->isOpened());
 }
 
+void AnySceneImporterTest::concurrentDataAccess() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not enabled, cannot test");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+
+    /* Without a file opened the feature isn't advertised */
+    CORRADE_COMPARE(importer->features(), ImporterFeature::FileCallback);
+
+    /* With ObjImporter it is */
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(OBJIMPORTER_TEST_DIR, "mesh-multiple.obj")));
+    CORRADE_COMPARE(importer->features(), ImporterFeature::FileCallback|ImporterFeature::ConcurrentDataAccess);
+
+    importer->close();
+    CORRADE_COMPARE(importer->features(), ImporterFeature::FileCallback);
+}
+
 void AnySceneImporterTest::animations() {
     PluginManager::Manager<AbstractImporter> manager{MAGNUM_PLUGINS_IMPORTER_INSTALL_DIR};
     #ifdef ANYSCENEIMPORTER_PLUGIN_FILENAME
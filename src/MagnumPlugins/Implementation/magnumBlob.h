@@ -0,0 +1,217 @@
+#ifndef Magnum_Implementation_magnumBlob_h
+#define Magnum_Implementation_magnumBlob_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Magnum.h"
+
+/* Layout of the memory-mappable blob format shared by MagnumImporter and
+   MagnumSceneConverter. Everything is stored in the native endianness of the
+   machine that wrote the file, the endianness marker in the header is used
+   only to reject files coming from a machine of a different kind.
+
+   The file starts with a BlobHeader, followed by the chunk payloads,
+   followed by a null-terminated string table with chunk names. The table of
+   BlobHeader::chunkCount BlobChunk entries is at BlobHeader::chunkOffset at
+   the very end, which allows the payloads to be written out one by one
+   without knowing their count upfront. All offsets in BlobChunk are relative
+   to the start of the file, all offsets inside a payload are relative to the
+   start of given payload. Each payload starts at a
+   BlobAlignment-aligned offset and all arrays inside a payload are aligned
+   to BlobAlignment as well, which means the data can be used directly from
+   a mapped file as long as the mapping itself is suitably aligned. */
+
+namespace Magnum { namespace Implementation {
+
+enum: UnsignedInt {
+    BlobAlignment = 16
+};
+
+enum: UnsignedShort {
+    BlobVersion = 1,
+    BlobEndianness = 0x0102
+};
+
+constexpr char BlobMagic[]{'M', 'G', 'N', 'B'};
+
+/* Four-character codes, stored as a native integer */
+enum class BlobChunkType: UnsignedInt {
+    Mesh = 'M' << 24 | 'E' << 16 | 'S' << 8 | 'H',
+    Scene = 'S' << 24 | 'C' << 16 | 'N' << 8 | 'E',
+    Material = 'M' << 24 | 'T' << 16 | 'R' << 8 | 'L',
+    Image1D = 'I' << 24 | 'M' << 16 | 'G' << 8 | '1',
+    Image2D = 'I' << 24 | 'M' << 16 | 'G' << 8 | '2',
+    Image3D = 'I' << 24 | 'M' << 16 | 'G' << 8 | '3'
+};
+
+struct BlobHeader {
+    char magic[4];
+    UnsignedShort version;
+    UnsignedShort endianness;
+    UnsignedInt chunkCount;
+    /* -1 if there's no default scene */
+    Int defaultScene;
+    /* Offset of the chunk table, BlobAlignment-aligned */
+    UnsignedLong chunkOffset;
+    /* Size of the whole file */
+    UnsignedLong size;
+};
+
+struct BlobChunk {
+    BlobChunkType type;
+    /* Name size excluding the null terminator */
+    UnsignedInt nameSize;
+    UnsignedLong nameOffset;
+    UnsignedLong offset;
+    UnsignedLong size;
+};
+
+/* Followed by attributeCount BlobMeshAttribute entries. Index data are at
+   indexDataOffset, vertex data at vertexDataOffset. */
+struct BlobMesh {
+    /* Raw MeshPrimitive value, including implementation-specific ones */
+    UnsignedInt primitive;
+    /* Raw MeshIndexType value, zero if the mesh isn't indexed */
+    UnsignedInt indexType;
+    UnsignedInt indexCount;
+    Int indexStride;
+    UnsignedInt vertexCount;
+    UnsignedInt attributeCount;
+    /* Offset of the first index relative to indexDataOffset */
+    UnsignedLong indexOffset;
+    UnsignedLong indexDataOffset;
+    UnsignedLong indexDataSize;
+    UnsignedLong vertexDataOffset;
+    UnsignedLong vertexDataSize;
+};
+
+struct BlobMeshAttribute {
+    /* Raw MeshAttribute value, including custom ones */
+    UnsignedInt name;
+    /* Raw VertexFormat value, including implementation-specific ones */
+    UnsignedInt format;
+    /* Offset of the first element relative to vertexDataOffset */
+    UnsignedLong offset;
+    Int stride;
+    UnsignedShort arraySize;
+    Short morphTargetId;
+};
+
+/* Followed by fieldCount BlobSceneField entries. Field data are at
+   dataOffset. */
+struct BlobScene {
+    /* Raw SceneMappingType value */
+    UnsignedInt mappingType;
+    UnsignedInt fieldCount;
+    UnsignedLong mappingBound;
+    UnsignedLong dataOffset;
+    UnsignedLong dataSize;
+};
+
+struct BlobSceneField {
+    /* Raw SceneField value, including custom ones */
+    UnsignedInt name;
+    /* Raw SceneFieldType value */
+    UnsignedShort type;
+    UnsignedShort arraySize;
+    UnsignedLong size;
+    /* All offsets are relative to BlobScene::dataOffset */
+    UnsignedLong mappingOffset;
+    Long mappingStride;
+    UnsignedLong fieldOffset;
+    /* In bits for SceneFieldType::Bit */
+    Long fieldStride;
+    /* Used only for string fields */
+    UnsignedLong stringOffset;
+    /* Raw SceneFieldFlags value, with SceneFieldFlag::OffsetOnly cleared */
+    UnsignedByte flags;
+    /* Used only for SceneFieldType::Bit */
+    UnsignedByte fieldBitOffset;
+    UnsignedShort:16;
+    UnsignedInt:32;
+};
+
+/* Layer offsets are at layerDataOffset, MaterialAttributeData instances at
+   attributeDataOffset. The attribute data are stored as-is, which is
+   possible because MaterialAttributeData is trivially copyable and contains
+   pointers only for MaterialAttributeType::Pointer and MutablePointer, which
+   are rejected by the converter. */
+struct BlobMaterial {
+    /* Raw MaterialTypes value */
+    UnsignedInt types;
+    /* Zero if the material has just the implicit base layer */
+    UnsignedInt layerCount;
+    UnsignedInt attributeCount;
+    /* sizeof(MaterialAttributeData), to catch layout mismatches */
+    UnsignedInt attributeSize;
+    UnsignedLong layerDataOffset;
+    UnsignedLong attributeDataOffset;
+};
+
+/* Image data are at dataOffset. Sizes and pixel storage parameters are
+   always stored as three-dimensional, with the extra dimensions set to 1 or
+   0, respectively. */
+struct BlobImage {
+    UnsignedByte compressed;
+    UnsignedByte:8;
+    /* Raw ImageFlags value */
+    UnsignedShort flags;
+    /* Raw PixelFormat or CompressedPixelFormat value, including
+       implementation-specific ones */
+    UnsignedInt format;
+    /* Used only for uncompressed images */
+    UnsignedInt formatExtra;
+    UnsignedInt pixelSize;
+    Int size[3];
+    Int alignment;
+    Int rowLength;
+    Int imageHeight;
+    Int skip[3];
+    /* Used only for compressed images */
+    Int compressedBlockSize[3];
+    Int compressedBlockDataSize;
+    Int:32;
+    UnsignedLong dataOffset;
+    UnsignedLong dataSize;
+};
+
+/* All 64-bit members are placed at 8-byte-aligned offsets so the layout is
+   the same also on platforms where 64-bit types are only 4-byte aligned */
+static_assert(sizeof(BlobHeader) == 32, "improper size of BlobHeader");
+static_assert(sizeof(BlobChunk) == 32, "improper size of BlobChunk");
+static_assert(sizeof(BlobMesh) == 64, "improper size of BlobMesh");
+static_assert(sizeof(BlobMeshAttribute) == 24, "improper size of BlobMeshAttribute");
+static_assert(sizeof(BlobScene) == 32, "improper size of BlobScene");
+static_assert(sizeof(BlobSceneField) == 64, "improper size of BlobSceneField");
+static_assert(sizeof(BlobMaterial) == 32, "improper size of BlobMaterial");
+static_assert(sizeof(BlobImage) == 88, "improper size of BlobImage");
+
+constexpr UnsignedLong blobAlign(UnsignedLong offset) {
+    return (offset + BlobAlignment - 1) & ~UnsignedLong(BlobAlignment - 1);
+}
+
+}}
+
+#endif
@@ -0,0 +1,695 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "MagnumImporter.h"
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Path.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+#include "MagnumPlugins/Implementation/magnumBlob.h"
+
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+#define MAGNUM_MAGNUMIMPORTER_USE_MAP
+#endif
+
+namespace Magnum { namespace Trade {
+
+using namespace Magnum::Implementation;
+
+struct MagnumImporter::State {
+    #ifdef MAGNUM_MAGNUMIMPORTER_USE_MAP
+    Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> mapped;
+    #endif
+    Containers::Array<char> owned;
+    Containers::ArrayView<const char> data;
+
+    Containers::ArrayView<const BlobChunk> chunks;
+    Int defaultScene;
+    /* IDs into the chunk table for each data type, in the order they were
+       added to the converter */
+    Containers::Array<UnsignedInt> meshes;
+    Containers::Array<UnsignedInt> scenes;
+    Containers::Array<UnsignedInt> materials;
+    Containers::Array<UnsignedInt> images1D;
+    Containers::Array<UnsignedInt> images2D;
+    Containers::Array<UnsignedInt> images3D;
+};
+
+namespace {
+
+/* Checks that a strided view of count elements of elementSize bytes, starting
+   at offset, fits into size bytes. Used for both byte and bit views. */
+bool viewInBounds(const UnsignedLong offset, const Long stride, const UnsignedLong count, const UnsignedLong elementSize, const UnsignedLong size) {
+    if(!count) return true;
+    const Long last = Long(offset) + Long(count - 1)*stride;
+    const Long begin = stride < 0 ? last : Long(offset);
+    const Long end = (stride < 0 ? Long(offset) : last) + Long(elementSize);
+    return begin >= 0 && UnsignedLong(end) <= size;
+}
+
+Containers::String chunkName(const Containers::ArrayView<const char> data, const BlobChunk& chunk) {
+    return Containers::String{data.data() + chunk.nameOffset, chunk.nameSize};
+}
+
+Int chunkForName(const Containers::ArrayView<const char> data, const Containers::ArrayView<const BlobChunk> chunks, const Containers::ArrayView<const UnsignedInt> ids, const Containers::StringView name) {
+    for(std::size_t i = 0; i != ids.size(); ++i) {
+        const BlobChunk& chunk = chunks[ids[i]];
+        if(Containers::StringView{data.data() + chunk.nameOffset, chunk.nameSize} == name)
+            return i;
+    }
+    return -1;
+}
+
+/* Payload of given chunk, guaranteed to be in bounds of the file by
+   doOpenData() */
+Containers::ArrayView<const char> chunkData(const Containers::ArrayView<const char> data, const BlobChunk& chunk) {
+    return data.slice(chunk.offset, chunk.offset + chunk.size);
+}
+
+/* Adapter for Magnum::Implementation::imageDataSizeFor() */
+struct ImageProperties {
+    PixelStorage storage() const { return _storage; }
+    UnsignedInt pixelSize() const { return _pixelSize; }
+
+    PixelStorage _storage;
+    UnsignedInt _pixelSize;
+};
+
+/* Adapter for Magnum::Implementation::compressedImageDataSizeFor() */
+struct CompressedImageProperties {
+    CompressedPixelStorage storage() const { return _storage; }
+
+    CompressedPixelStorage _storage;
+};
+
+Vector3i blobImageSize(const BlobImage& image) {
+    return Vector3i::from(image.size);
+}
+
+template<UnsignedInt dimensions> VectorTypeFor<dimensions, Int> imageSize(const Vector3i& size);
+template<> Int imageSize<1>(const Vector3i& size) { return size.x(); }
+template<> Vector2i imageSize<2>(const Vector3i& size) { return size.xy(); }
+template<> Vector3i imageSize<3>(const Vector3i& size) { return size; }
+
+/* Checks the flags against the dimension count and size, the ImageData
+   constructor would otherwise assert on them */
+template<UnsignedInt dimensions> bool checkImageFlags(ImageFlags<dimensions> flags, const Vector3i& size);
+template<> bool checkImageFlags<1>(const ImageFlags1D flags, const Vector3i&) {
+    if(flags) {
+        Error{} << "Trade::MagnumImporter::image1D(): invalid flags" << flags;
+        return false;
+    }
+    return true;
+}
+template<> bool checkImageFlags<2>(const ImageFlags2D flags, const Vector3i&) {
+    if(flags & ~ImageFlag2D::Array) {
+        Error{} << "Trade::MagnumImporter::image2D(): invalid flags" << flags;
+        return false;
+    }
+    return true;
+}
+template<> bool checkImageFlags<3>(const ImageFlags3D flags, const Vector3i& size) {
+    if(flags & ~(ImageFlag3D::Array|ImageFlag3D::CubeMap)) {
+        Error{} << "Trade::MagnumImporter::image3D(): invalid flags" << flags;
+        return false;
+    }
+    if(!(flags & ImageFlag3D::CubeMap)) return true;
+
+    if(size.x() != size.y()) {
+        Error{} << "Trade::MagnumImporter::image3D(): expected square faces for a cube map, got" << Debug::packed << size.xy();
+        return false;
+    }
+    if(!(flags & ImageFlag3D::Array) && size.z() != 6) {
+        Error{} << "Trade::MagnumImporter::image3D(): expected exactly 6 faces for a cube map, got" << size.z();
+        return false;
+    }
+    if((flags & ImageFlag3D::Array) && size.z() % 6) {
+        Error{} << "Trade::MagnumImporter::image3D(): expected a multiple of 6 faces for a cube map array, got" << size.z();
+        return false;
+    }
+    return true;
+}
+
+template<UnsignedInt dimensions> Containers::Optional<ImageData<dimensions>> importImage(const Containers::ArrayView<const char> data, const BlobChunk& chunk) {
+    const Containers::ArrayView<const char> payload = chunkData(data, chunk);
+    if(payload.size() < sizeof(BlobImage)) {
+        Error{} << "Trade::MagnumImporter::image" << Debug::nospace << dimensions << Debug::nospace << "D(): expected at least" << sizeof(BlobImage) << "bytes for the header but got" << payload.size();
+        return {};
+    }
+
+    const BlobImage& image = *reinterpret_cast<const BlobImage*>(payload.data());
+    if(image.dataOffset > payload.size() || image.dataSize > payload.size() - image.dataOffset) {
+        Error{} << "Trade::MagnumImporter::image" << Debug::nospace << dimensions << Debug::nospace << "D(): image data out of range";
+        return {};
+    }
+
+    const Vector3i size = blobImageSize(image);
+    const Containers::ArrayView<const char> imageData = payload.sliceSize(image.dataOffset, image.dataSize);
+    const auto flags = ImageFlags<dimensions>{ImageFlag<dimensions>(image.flags)};
+
+    /* Only the components used by given dimension count are checked, the
+       others are ignored */
+    const Math::Vector<dimensions, Int> usedSize = Math::Vector<dimensions, Int>::pad(size);
+    if(usedSize.min() < 0) {
+        Error{} << "Trade::MagnumImporter::image" << Debug::nospace << dimensions << Debug::nospace << "D(): invalid size" << Debug::packed << usedSize;
+        return {};
+    }
+    if(image.rowLength < 0 || image.imageHeight < 0 || Vector3i::from(image.skip).min() < 0) {
+        Error{} << "Trade::MagnumImporter::image" << Debug::nospace << dimensions << Debug::nospace << "D(): invalid row length, image height or skip";
+        return {};
+    }
+    if(!checkImageFlags<dimensions>(flags, size))
+        return {};
+
+    if(image.compressed) {
+        /* The block properties are either all zero, in which case the ones
+           implied by the format are used and there's nothing to check the
+           data size against, or all positive. The upper bound on the block
+           size is way above what any real format has and makes sure the
+           block size product doesn't overflow in the data size
+           calculation. */
+        const Vector3i blockSize = Vector3i::from(image.compressedBlockSize);
+        const bool blockPropertiesSet = blockSize != Vector3i{} || image.compressedBlockDataSize;
+        if(blockPropertiesSet && (blockSize.min() <= 0 || blockSize.max() > 256 || image.compressedBlockDataSize <= 0)) {
+            Error{} << "Trade::MagnumImporter::image" << Debug::nospace << dimensions << Debug::nospace << "D(): invalid compressed block size" << Debug::packed << blockSize << "or block data size" << image.compressedBlockDataSize;
+            return {};
+        }
+
+        CompressedPixelStorage storage;
+        storage.setAlignment(image.alignment)
+            .setRowLength(image.rowLength)
+            .setImageHeight(image.imageHeight)
+            .setSkip(Vector3i::from(image.skip));
+        storage.setCompressedBlockSize(blockSize)
+            .setCompressedBlockDataSize(image.compressedBlockDataSize);
+        if(blockPropertiesSet && usedSize.product()) {
+            const std::size_t expectedSize = Magnum::Implementation::compressedImageDataSizeFor(CompressedImageProperties{storage}, usedSize);
+            if(imageData.size() < expectedSize) {
+                Error{} << "Trade::MagnumImporter::image" << Debug::nospace << dimensions << Debug::nospace << "D(): expected at least" << expectedSize << "bytes of compressed image data but got" << imageData.size();
+                return {};
+            }
+        }
+
+        return ImageData<dimensions>{storage, CompressedPixelFormat(image.format), imageSize<dimensions>(size), DataFlags{}, imageData, flags};
+    }
+
+    PixelStorage storage;
+    storage.setAlignment(image.alignment)
+        .setRowLength(image.rowLength)
+        .setImageHeight(image.imageHeight)
+        .setSkip(Vector3i::from(image.skip));
+    if(!image.pixelSize || (image.alignment != 1 && image.alignment != 2 && image.alignment != 4 && image.alignment != 8)) {
+        Error{} << "Trade::MagnumImporter::image" << Debug::nospace << dimensions << Debug::nospace << "D(): invalid pixel size or alignment";
+        return {};
+    }
+    const std::size_t expectedSize = Magnum::Implementation::imageDataSizeFor(ImageProperties{storage, image.pixelSize}, usedSize);
+    if(imageData.size() < expectedSize) {
+        Error{} << "Trade::MagnumImporter::image" << Debug::nospace << dimensions << Debug::nospace << "D(): expected at least" << expectedSize << "bytes of image data but got" << imageData.size();
+        return {};
+    }
+
+    return ImageData<dimensions>{storage, PixelFormat(image.format), image.formatExtra, image.pixelSize, imageSize<dimensions>(size), DataFlags{}, imageData, flags};
+}
+
+}
+
+MagnumImporter::MagnumImporter() = default;
+
+MagnumImporter::MagnumImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractImporter{manager, plugin} {}
+
+MagnumImporter::~MagnumImporter() = default;
+
+ImporterFeatures MagnumImporter::doFeatures() const { return ImporterFeature::OpenData; }
+
+bool MagnumImporter::doIsOpened() const { return !!_state; }
+
+void MagnumImporter::doClose() { _state = nullptr; }
+
+void MagnumImporter::doOpenFile(const Containers::StringView filename) {
+    #ifdef MAGNUM_MAGNUMIMPORTER_USE_MAP
+    Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> mapped = Utility::Path::mapRead(filename);
+    if(!mapped) {
+        Error{} << "Trade::MagnumImporter::openFile(): cannot map file" << filename;
+        return;
+    }
+
+    /* The mapping is page-aligned and stays around until close(), so it can
+       be treated the same as openMemory(). If opening fails, the mapping gets
+       released again by the state destructor. */
+    const Containers::ArrayView<const char> view = *mapped;
+    doOpenData(Containers::Array<char>{const_cast<char*>(view.data()), view.size(), [](char*, std::size_t) {}}, DataFlag::ExternallyOwned);
+    if(_state) _state->mapped = Utility::move(mapped);
+    #else
+    AbstractImporter::doOpenFile(filename);
+    #endif
+}
+
+void MagnumImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dataFlags) {
+    Containers::Pointer<State> state{InPlaceInit};
+
+    /* Take over the data if we can. Externally owned memory can be referenced
+       directly only if it's suitably aligned for the payloads, otherwise it
+       has to be copied. */
+    if((dataFlags & DataFlag::Owned) || ((dataFlags & DataFlag::ExternallyOwned) && reinterpret_cast<std::uintptr_t>(data.data()) % BlobAlignment == 0)) {
+        state->data = data;
+        if(dataFlags & DataFlag::Owned) state->owned = Utility::move(data);
+    } else {
+        state->owned = Containers::Array<char>{NoInit, data.size()};
+        Utility::copy(data, state->owned);
+        state->data = state->owned;
+    }
+
+    const Containers::ArrayView<const char> blob = state->data;
+    if(blob.size() < sizeof(BlobHeader)) {
+        Error{} << "Trade::MagnumImporter::openData(): expected at least" << sizeof(BlobHeader) << "bytes for the header but got" << blob.size();
+        return;
+    }
+
+    const BlobHeader& header = *reinterpret_cast<const BlobHeader*>(blob.data());
+    if(std::memcmp(header.magic, BlobMagic, sizeof(BlobMagic)) != 0) {
+        Error{} << "Trade::MagnumImporter::openData(): invalid file signature";
+        return;
+    }
+    if(header.endianness != BlobEndianness) {
+        Error{} << "Trade::MagnumImporter::openData(): file has a different endianness";
+        return;
+    }
+    if(header.version != BlobVersion) {
+        Error{} << "Trade::MagnumImporter::openData(): unsupported version" << header.version << Debug::nospace << ", expected" << BlobVersion;
+        return;
+    }
+    if(header.size != blob.size()) {
+        Error{} << "Trade::MagnumImporter::openData(): expected" << header.size << "bytes but got" << blob.size();
+        return;
+    }
+    if(header.chunkOffset % BlobAlignment || header.chunkOffset > blob.size() || header.chunkCount > (blob.size() - header.chunkOffset)/sizeof(BlobChunk)) {
+        Error{} << "Trade::MagnumImporter::openData(): chunk table of" << header.chunkCount << "entries at offset" << header.chunkOffset << "out of range";
+        return;
+    }
+
+    /* A single pass over the chunk table, payloads are validated only once
+       they're actually accessed */
+    state->chunks = Containers::arrayCast<const BlobChunk>(blob.sliceSize(header.chunkOffset, header.chunkCount*sizeof(BlobChunk)));
+    for(std::size_t i = 0; i != state->chunks.size(); ++i) {
+        const BlobChunk& chunk = state->chunks[i];
+        if(chunk.offset % BlobAlignment || chunk.offset > blob.size() || chunk.size > blob.size() - chunk.offset) {
+            Error{} << "Trade::MagnumImporter::openData(): chunk" << i << "out of range";
+            return;
+        }
+        if(chunk.nameOffset > blob.size() || chunk.nameSize > blob.size() - chunk.nameOffset) {
+            Error{} << "Trade::MagnumImporter::openData(): name of chunk" << i << "out of range";
+            return;
+        }
+
+        Containers::Array<UnsignedInt>* ids;
+        switch(chunk.type) {
+            case BlobChunkType::Mesh: ids = &state->meshes; break;
+            case BlobChunkType::Scene: ids = &state->scenes; break;
+            case BlobChunkType::Material: ids = &state->materials; break;
+            case BlobChunkType::Image1D: ids = &state->images1D; break;
+            case BlobChunkType::Image2D: ids = &state->images2D; break;
+            case BlobChunkType::Image3D: ids = &state->images3D; break;
+            /* Unknown chunks are skipped to allow future extensions */
+            default: continue;
+        }
+        arrayAppend(*ids, UnsignedInt(i));
+    }
+
+    if(header.defaultScene < -1 || (header.defaultScene != -1 && UnsignedInt(header.defaultScene) >= state->scenes.size())) {
+        Error{} << "Trade::MagnumImporter::openData(): default scene" << header.defaultScene << "out of range for" << state->scenes.size() << "scenes";
+        return;
+    }
+    state->defaultScene = header.defaultScene;
+
+    _state = Utility::move(state);
+}
+
+Int MagnumImporter::doDefaultScene() const { return _state->defaultScene; }
+
+UnsignedInt MagnumImporter::doSceneCount() const { return _state->scenes.size(); }
+
+Int MagnumImporter::doSceneForName(const Containers::StringView name) {
+    return chunkForName(_state->data, _state->chunks, _state->scenes, name);
+}
+
+Containers::String MagnumImporter::doSceneName(const UnsignedInt id) {
+    return chunkName(_state->data, _state->chunks[_state->scenes[id]]);
+}
+
+Containers::Optional<SceneData> MagnumImporter::doScene(const UnsignedInt id) {
+    const Containers::ArrayView<const char> payload = chunkData(_state->data, _state->chunks[_state->scenes[id]]);
+    if(payload.size() < sizeof(BlobScene)) {
+        Error{} << "Trade::MagnumImporter::scene(): expected at least" << sizeof(BlobScene) << "bytes for the header but got" << payload.size();
+        return {};
+    }
+
+    const BlobScene& scene = *reinterpret_cast<const BlobScene*>(payload.data());
+    if(scene.fieldCount > (payload.size() - sizeof(BlobScene))/sizeof(BlobSceneField)) {
+        Error{} << "Trade::MagnumImporter::scene(): field data out of range";
+        return {};
+    }
+    if(scene.dataOffset > payload.size() || scene.dataSize > payload.size() - scene.dataOffset) {
+        Error{} << "Trade::MagnumImporter::scene(): scene data out of range";
+        return {};
+    }
+
+    /* Enum values coming from the file are checked before they get passed to
+       any of the size helpers or SceneFieldData constructors, which would
+       assert on them */
+    if(!scene.mappingType || scene.mappingType > UnsignedInt(SceneMappingType::UnsignedLong)) {
+        Error{} << "Trade::MagnumImporter::scene(): invalid mapping type" << scene.mappingType;
+        return {};
+    }
+    const SceneMappingType mappingType = SceneMappingType(scene.mappingType);
+    const UnsignedInt mappingTypeSize = sceneMappingTypeSize(mappingType);
+    if(mappingTypeSize < 8 && scene.mappingBound > (1ull << mappingTypeSize*8) - 1) {
+        Error{} << "Trade::MagnumImporter::scene():" << mappingType << "is too small for" << scene.mappingBound << "objects";
+        return {};
+    }
+
+    const auto fields = Containers::arrayCast<const BlobSceneField>(payload.sliceSize(sizeof(BlobScene), scene.fieldCount*sizeof(BlobSceneField)));
+    Containers::Array<SceneFieldData> fieldData{fields.size()};
+    for(std::size_t i = 0; i != fields.size(); ++i) {
+        const BlobSceneField& field = fields[i];
+        if(!field.type || field.type > UnsignedShort(SceneFieldType::MutablePointer)) {
+            Error{} << "Trade::MagnumImporter::scene(): invalid type" << field.type << "of field" << i;
+            return {};
+        }
+
+        const SceneField name = SceneField(field.name);
+        const SceneFieldType type = SceneFieldType(field.type);
+        const SceneFieldFlags flags = SceneFieldFlag(field.flags);
+        const UnsignedInt arraySize = field.arraySize ? field.arraySize : 1;
+        if(!Trade::Implementation::isSceneFieldTypeCompatibleWithField(name, type)) {
+            Error{} << "Trade::MagnumImporter::scene():" << type << "is not a valid type for field" << i << "of" << name;
+            return {};
+        }
+        if(field.arraySize && !Trade::Implementation::isSceneFieldArrayAllowed(name)) {
+            Error{} << "Trade::MagnumImporter::scene(): field" << i << "of" << name << "can't be an array";
+            return {};
+        }
+        if(!Trade::Implementation::isSceneFieldTypeString(type) && (flags & (SceneFieldFlag::NullTerminatedString|Trade::Implementation::disallowedSceneFieldFlagsFor(name)))) {
+            Error{} << "Trade::MagnumImporter::scene(): invalid flags" << flags << "for field" << i << "of" << name;
+            return {};
+        }
+        if(field.mappingStride < -32768 || field.mappingStride > 32767 ||
+           field.fieldStride < -32768 || field.fieldStride > 32767 ||
+           field.fieldBitOffset >= 8) {
+            Error{} << "Trade::MagnumImporter::scene(): invalid stride or bit offset of field" << i;
+            return {};
+        }
+        for(std::size_t j = 0; j != i; ++j) {
+            if(fields[j].name == field.name) {
+                Error{} << "Trade::MagnumImporter::scene(): duplicate field" << name;
+                return {};
+            }
+        }
+
+        bool inBounds = viewInBounds(field.mappingOffset, field.mappingStride, field.size, mappingTypeSize, scene.dataSize);
+        if(type == SceneFieldType::Bit)
+            inBounds = inBounds && viewInBounds(field.fieldOffset*8 + field.fieldBitOffset, field.fieldStride, field.size, arraySize, scene.dataSize*8);
+        else
+            inBounds = inBounds && viewInBounds(field.fieldOffset, field.fieldStride, field.size, sceneFieldTypeSize(type)*arraySize, scene.dataSize);
+        if(!inBounds || field.stringOffset > scene.dataSize) {
+            Error{} << "Trade::MagnumImporter::scene(): data of field" << i << "out of range";
+            return {};
+        }
+
+        if(type == SceneFieldType::Bit)
+            fieldData[i] = SceneFieldData{name, std::size_t(field.size), mappingType, std::size_t(field.mappingOffset), std::ptrdiff_t(field.mappingStride), std::size_t(field.fieldOffset), field.fieldBitOffset, std::ptrdiff_t(field.fieldStride), field.arraySize, flags};
+        else if(Trade::Implementation::isSceneFieldTypeString(type))
+            fieldData[i] = SceneFieldData{name, std::size_t(field.size), mappingType, std::size_t(field.mappingOffset), std::ptrdiff_t(field.mappingStride), std::size_t(field.stringOffset), type, std::size_t(field.fieldOffset), std::ptrdiff_t(field.fieldStride), flags};
+        else
+            fieldData[i] = SceneFieldData{name, std::size_t(field.size), mappingType, std::size_t(field.mappingOffset), std::ptrdiff_t(field.mappingStride), type, std::size_t(field.fieldOffset), std::ptrdiff_t(field.fieldStride), field.arraySize, flags};
+    }
+
+    return SceneData{mappingType, scene.mappingBound, DataFlags{}, payload.sliceSize(std::size_t(scene.dataOffset), std::size_t(scene.dataSize)), Utility::move(fieldData)};
+}
+
+UnsignedInt MagnumImporter::doMeshCount() const { return _state->meshes.size(); }
+
+Int MagnumImporter::doMeshForName(const Containers::StringView name) {
+    return chunkForName(_state->data, _state->chunks, _state->meshes, name);
+}
+
+Containers::String MagnumImporter::doMeshName(const UnsignedInt id) {
+    return chunkName(_state->data, _state->chunks[_state->meshes[id]]);
+}
+
+Containers::Optional<MeshData> MagnumImporter::doMesh(const UnsignedInt id, UnsignedInt) {
+    const Containers::ArrayView<const char> payload = chunkData(_state->data, _state->chunks[_state->meshes[id]]);
+    if(payload.size() < sizeof(BlobMesh)) {
+        Error{} << "Trade::MagnumImporter::mesh(): expected at least" << sizeof(BlobMesh) << "bytes for the header but got" << payload.size();
+        return {};
+    }
+
+    const BlobMesh& mesh = *reinterpret_cast<const BlobMesh*>(payload.data());
+    if(mesh.attributeCount > (payload.size() - sizeof(BlobMesh))/sizeof(BlobMeshAttribute)) {
+        Error{} << "Trade::MagnumImporter::mesh(): attribute data out of range";
+        return {};
+    }
+    if(mesh.indexDataOffset > payload.size() || mesh.indexDataSize > payload.size() - mesh.indexDataOffset ||
+       mesh.vertexDataOffset > payload.size() || mesh.vertexDataSize > payload.size() - mesh.vertexDataOffset) {
+        Error{} << "Trade::MagnumImporter::mesh(): index or vertex data out of range";
+        return {};
+    }
+
+    const Containers::ArrayView<const char> indexData = payload.sliceSize(mesh.indexDataOffset, mesh.indexDataSize);
+    const Containers::ArrayView<const char> vertexData = payload.sliceSize(mesh.vertexDataOffset, mesh.vertexDataSize);
+
+    /* Enum values coming from the file are checked before they get passed to
+       any of the size helpers or MeshAttributeData constructors, which would
+       assert on them. Implementation-specific values are passed through. */
+    const MeshPrimitive primitive = MeshPrimitive(mesh.primitive);
+    if(!isMeshPrimitiveImplementationSpecific(primitive) && (!mesh.primitive || mesh.primitive > UnsignedInt(MeshPrimitive::Meshlets))) {
+        Error{} << "Trade::MagnumImporter::mesh(): invalid primitive" << mesh.primitive;
+        return {};
+    }
+
+    MeshIndexData indices;
+    if(mesh.indexType) {
+        const MeshIndexType indexType = MeshIndexType(mesh.indexType);
+        if(!isMeshIndexTypeImplementationSpecific(indexType) && mesh.indexType > UnsignedInt(MeshIndexType::UnsignedInt)) {
+            Error{} << "Trade::MagnumImporter::mesh(): invalid index type" << mesh.indexType;
+            return {};
+        }
+        if(mesh.indexStride < -32768 || mesh.indexStride > 32767) {
+            Error{} << "Trade::MagnumImporter::mesh(): invalid index stride" << mesh.indexStride;
+            return {};
+        }
+        /* Sizes of implementation-specific types are unknown, check at least
+           that the first index is in bounds */
+        if(!viewInBounds(mesh.indexOffset, mesh.indexStride, mesh.indexCount, isMeshIndexTypeImplementationSpecific(indexType) ? 1 : meshIndexTypeSize(indexType), indexData.size())) {
+            Error{} << "Trade::MagnumImporter::mesh(): index data out of range";
+            return {};
+        }
+        indices = MeshIndexData{indexType, Containers::StridedArrayView1D<const void>{indexData, indexData.data() + mesh.indexOffset, mesh.indexCount, mesh.indexStride}};
+    }
+
+    const auto attributes = Containers::arrayCast<const BlobMeshAttribute>(payload.sliceSize(sizeof(BlobMesh), mesh.attributeCount*sizeof(BlobMeshAttribute)));
+    Containers::Array<MeshAttributeData> attributeData{attributes.size()};
+    for(std::size_t i = 0; i != attributes.size(); ++i) {
+        const BlobMeshAttribute& attribute = attributes[i];
+        const MeshAttribute name = MeshAttribute(attribute.name);
+        const VertexFormat format = VertexFormat(attribute.format);
+        if(!isVertexFormatImplementationSpecific(format) && (!attribute.format || attribute.format > UnsignedInt(VertexFormat::Matrix4x3sNormalizedAligned))) {
+            Error{} << "Trade::MagnumImporter::mesh(): invalid format" << attribute.format << "of attribute" << i;
+            return {};
+        }
+        if(!Trade::Implementation::isVertexFormatCompatibleWithAttribute(name, format)) {
+            Error{} << "Trade::MagnumImporter::mesh():" << format << "is not a valid format for attribute" << i << "of" << name;
+            return {};
+        }
+        if(attribute.arraySize && !Trade::Implementation::isAttributeArrayAllowed(name)) {
+            Error{} << "Trade::MagnumImporter::mesh(): attribute" << i << "of" << name << "can't be an array";
+            return {};
+        }
+        if(attribute.morphTargetId != -1 && (attribute.morphTargetId < 0 || attribute.morphTargetId >= 128 || !Trade::Implementation::isMorphTargetAllowed(name))) {
+            Error{} << "Trade::MagnumImporter::mesh(): invalid morph target ID" << attribute.morphTargetId << "of attribute" << i << "of" << name;
+            return {};
+        }
+        if(attribute.stride < -32768 || attribute.stride > 32767) {
+            Error{} << "Trade::MagnumImporter::mesh(): invalid stride" << attribute.stride << "of attribute" << i;
+            return {};
+        }
+        if(!viewInBounds(attribute.offset, attribute.stride, mesh.vertexCount, isVertexFormatImplementationSpecific(format) ? 1 : vertexFormatSize(format)*(attribute.arraySize ? attribute.arraySize : 1), vertexData.size())) {
+            Error{} << "Trade::MagnumImporter::mesh(): data of attribute" << i << "out of range";
+            return {};
+        }
+        attributeData[i] = MeshAttributeData{name, format, std::size_t(attribute.offset), mesh.vertexCount, attribute.stride, attribute.arraySize, attribute.morphTargetId};
+    }
+
+    return MeshData{primitive,
+        DataFlags{}, indexData, indices,
+        DataFlags{}, vertexData, Utility::move(attributeData),
+        mesh.vertexCount};
+}
+
+UnsignedInt MagnumImporter::doMaterialCount() const { return _state->materials.size(); }
+
+Int MagnumImporter::doMaterialForName(const Containers::StringView name) {
+    return chunkForName(_state->data, _state->chunks, _state->materials, name);
+}
+
+Containers::String MagnumImporter::doMaterialName(const UnsignedInt id) {
+    return chunkName(_state->data, _state->chunks[_state->materials[id]]);
+}
+
+Containers::Optional<MaterialData> MagnumImporter::doMaterial(const UnsignedInt id) {
+    const Containers::ArrayView<const char> payload = chunkData(_state->data, _state->chunks[_state->materials[id]]);
+    if(payload.size() < sizeof(BlobMaterial)) {
+        Error{} << "Trade::MagnumImporter::material(): expected at least" << sizeof(BlobMaterial) << "bytes for the header but got" << payload.size();
+        return {};
+    }
+
+    const BlobMaterial& material = *reinterpret_cast<const BlobMaterial*>(payload.data());
+    if(material.attributeSize != sizeof(MaterialAttributeData)) {
+        Error{} << "Trade::MagnumImporter::material(): expected" << sizeof(MaterialAttributeData) << "bytes per attribute but got" << material.attributeSize;
+        return {};
+    }
+    if(material.layerDataOffset > payload.size() || material.layerCount > (payload.size() - material.layerDataOffset)/sizeof(UnsignedInt) ||
+       material.attributeDataOffset > payload.size() || material.attributeCount > (payload.size() - material.attributeDataOffset)/sizeof(MaterialAttributeData)) {
+        Error{} << "Trade::MagnumImporter::material(): layer or attribute data out of range";
+        return {};
+    }
+
+    const auto layers = Containers::arrayCast<const UnsignedInt>(payload.sliceSize(material.layerDataOffset, material.layerCount*sizeof(UnsignedInt)));
+    const auto attributes = Containers::arrayCast<const MaterialAttributeData>(payload.sliceSize(material.attributeDataOffset, material.attributeCount*sizeof(MaterialAttributeData)));
+    for(std::size_t i = 0; i != layers.size(); ++i) {
+        if(layers[i] > attributes.size() || (i && layers[i] < layers[i - 1]) || (i + 1 == layers.size() && layers[i] != attributes.size())) {
+            Error{} << "Trade::MagnumImporter::material(): invalid offset of layer" << i;
+            return {};
+        }
+    }
+
+    /* The attributes are stored as-is, so check that the type is valid and
+       that the name and value fit into the storage before anything inside
+       MaterialAttributeData or MaterialData gets to touch them */
+    for(std::size_t i = 0; i != attributes.size(); ++i) {
+        const char* const data = reinterpret_cast<const char*>(attributes + i);
+        const UnsignedByte type = data[0];
+        if(!type || type > UnsignedByte(MaterialAttributeType::TextureSwizzle) ||
+           type == UnsignedByte(MaterialAttributeType::Pointer) ||
+           type == UnsignedByte(MaterialAttributeType::MutablePointer)) {
+            Error{} << "Trade::MagnumImporter::material(): invalid type" << type << "of attribute" << i;
+            return {};
+        }
+
+        /* String values store their size in the last byte, buffer values
+           right after the null-terminated name */
+        const char* const nameEnd = static_cast<const char*>(std::memchr(data + 1, '\0', sizeof(MaterialAttributeData) - 1));
+        const std::size_t nameSize = nameEnd ? nameEnd - data - 1 : 0;
+        std::size_t valueSize;
+        if(!nameSize)
+            valueSize = sizeof(MaterialAttributeData);
+        else if(MaterialAttributeType(type) == MaterialAttributeType::String)
+            valueSize = UnsignedByte(data[sizeof(MaterialAttributeData) - 1]) + 2;
+        else if(MaterialAttributeType(type) == MaterialAttributeType::Buffer)
+            valueSize = nameSize + 2 < sizeof(MaterialAttributeData) ? UnsignedByte(nameEnd[1]) + 1 : sizeof(MaterialAttributeData);
+        else
+            valueSize = materialAttributeTypeSize(MaterialAttributeType(type));
+        if(nameSize + valueSize + 2 > sizeof(MaterialAttributeData)) {
+            Error{} << "Trade::MagnumImporter::material(): invalid name or value size of attribute" << i;
+            return {};
+        }
+    }
+
+    /* Non-owned attribute data have to be sorted and unique in each layer */
+    for(std::size_t i = 0, begin = 0; i != (layers.isEmpty() ? 1 : layers.size()); ++i) {
+        const std::size_t end = layers.isEmpty() ? attributes.size() : layers[i];
+        for(std::size_t j = begin + 1; j < end; ++j) {
+            if(!(attributes[j - 1].name() < attributes[j].name())) {
+                Error{} << "Trade::MagnumImporter::material(): attributes in layer" << i << "are not sorted or contain duplicates";
+                return {};
+            }
+        }
+        begin = end;
+    }
+
+    return MaterialData{MaterialTypes(MaterialType(material.types)),
+        DataFlags{}, attributes, DataFlags{}, layers};
+}
+
+UnsignedInt MagnumImporter::doImage1DCount() const { return _state->images1D.size(); }
+
+Int MagnumImporter::doImage1DForName(const Containers::StringView name) {
+    return chunkForName(_state->data, _state->chunks, _state->images1D, name);
+}
+
+Containers::String MagnumImporter::doImage1DName(const UnsignedInt id) {
+    return chunkName(_state->data, _state->chunks[_state->images1D[id]]);
+}
+
+Containers::Optional<ImageData1D> MagnumImporter::doImage1D(const UnsignedInt id, UnsignedInt) {
+    return importImage<1>(_state->data, _state->chunks[_state->images1D[id]]);
+}
+
+UnsignedInt MagnumImporter::doImage2DCount() const { return _state->images2D.size(); }
+
+Int MagnumImporter::doImage2DForName(const Containers::StringView name) {
+    return chunkForName(_state->data, _state->chunks, _state->images2D, name);
+}
+
+Containers::String MagnumImporter::doImage2DName(const UnsignedInt id) {
+    return chunkName(_state->data, _state->chunks[_state->images2D[id]]);
+}
+
+Containers::Optional<ImageData2D> MagnumImporter::doImage2D(const UnsignedInt id, UnsignedInt) {
+    return importImage<2>(_state->data, _state->chunks[_state->images2D[id]]);
+}
+
+UnsignedInt MagnumImporter::doImage3DCount() const { return _state->images3D.size(); }
+
+Int MagnumImporter::doImage3DForName(const Containers::StringView name) {
+    return chunkForName(_state->data, _state->chunks, _state->images3D, name);
+}
+
+Containers::String MagnumImporter::doImage3DName(const UnsignedInt id) {
+    return chunkName(_state->data, _state->chunks[_state->images3D[id]]);
+}
+
+Containers::Optional<ImageData3D> MagnumImporter::doImage3D(const UnsignedInt id, UnsignedInt) {
+    return importImage<3>(_state->data, _state->chunks[_state->images3D[id]]);
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MagnumImporter, Magnum::Trade::MagnumImporter,
+    MAGNUM_TRADE_ABSTRACTIMPORTER_PLUGIN_INTERFACE)
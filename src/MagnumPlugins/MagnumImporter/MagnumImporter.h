@@ -0,0 +1,180 @@
+#ifndef Magnum_Trade_MagnumImporter_h
+#define Magnum_Trade_MagnumImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MagnumImporter
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "MagnumPlugins/MagnumImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MAGNUMIMPORTER_BUILD_STATIC
+    #ifdef MagnumImporter_EXPORTS
+        #define MAGNUM_MAGNUMIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MAGNUMIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MAGNUMIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MAGNUMIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MAGNUMIMPORTER_EXPORT
+#define MAGNUM_MAGNUMIMPORTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Magnum blob importer plugin
+@m_since_latest
+
+Imports meshes, scenes, materials and images from a native memory-mappable
+blob (`*.blob`) produced by @ref MagnumSceneConverter. Opening a file costs
+only a pass over its chunk table, and all returned @ref MeshData,
+@ref SceneData, @ref MaterialData and @ref ImageData instances reference
+the file contents directly instead of copying them.
+
+@section Trade-MagnumImporter-usage Usage
+
+@m_class{m-note m-success}
+
+@par
+    This class is a plugin that's meant to be dynamically loaded and used
+    through the base @ref AbstractImporter interface. See its documentation for
+    introduction and usage examples.
+
+This plugin depends on the @ref Trade library and is built if
+`MAGNUM_WITH_MAGNUMIMPORTER` is enabled when building Magnum. To use as a
+dynamic plugin, load @cpp "MagnumImporter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(MAGNUM_WITH_MAGNUMIMPORTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::MagnumImporter)
+@endcode
+
+To use as a static plugin or as a dependency of another plugin with CMake, you
+need to request the `MagnumImporter` component of the `Magnum` package and
+link to the `Magnum::MagnumImporter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED MagnumImporter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::MagnumImporter)
+@endcode
+
+See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
+information.
+
+@section Trade-MagnumImporter-behavior Behavior and limitations
+
+On platforms that support it, @ref openFile() maps the file into memory
+instead of reading it. With @ref openMemory(), the passed memory is referenced
+directly if it's aligned to 16 bytes, otherwise and with @ref openData() a
+copy is made. In all cases the returned data are views with empty
+@ref DataFlags, pointing to memory owned by the importer --- they stay valid
+only until the file is closed or the importer is destroyed. Use the owning
+copy constructors such as @ref MeshTools::copy() if you need the data to
+outlive the importer.
+
+The file is validated only to the extent that's needed to safely access it.
+That includes range checks of all offsets as well as of all enum values and
+their combinations before they get passed to @ref SceneData, @ref MeshData or
+@ref MaterialData, so a malformed file results in an error message and
+@relativeref{Corrade,Containers::NullOpt} being returned. As the format stores data in the native endianness and contains a raw copy of
+@ref MaterialAttributeData, files produced on a machine with a different
+endianness or with a different Magnum version are rejected. Only a single
+level is supported for meshes and images, custom mesh attribute and scene
+field names are not preserved.
+*/
+class MAGNUM_MAGNUMIMPORTER_EXPORT MagnumImporter: public AbstractImporter {
+    public:
+        /** @brief Default constructor */
+        explicit MagnumImporter();
+
+        /** @brief Plugin manager constructor */
+        explicit MagnumImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
+
+        ~MagnumImporter();
+
+    private:
+        struct State;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL bool doIsOpened() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL void doOpenData(Containers::Array<char>&& data, DataFlags dataFlags) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL void doOpenFile(Containers::StringView filename) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL void doClose() override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL Int doDefaultScene() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doSceneCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Int doSceneForName(Containers::StringView name) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::String doSceneName(UnsignedInt id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<SceneData> doScene(UnsignedInt id) override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doMeshCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Int doMeshForName(Containers::StringView name) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::String doMeshName(UnsignedInt id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt level) override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doMaterialCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Int doMaterialForName(Containers::StringView name) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::String doMaterialName(UnsignedInt id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<MaterialData> doMaterial(UnsignedInt id) override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doImage1DCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Int doImage1DForName(Containers::StringView name) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::String doImage1DName(UnsignedInt id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<ImageData1D> doImage1D(UnsignedInt id, UnsignedInt level) override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doImage2DCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Int doImage2DForName(Containers::StringView name) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::String doImage2DName(UnsignedInt id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt level) override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doImage3DCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Int doImage3DForName(Containers::StringView name) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::String doImage3DName(UnsignedInt id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<ImageData3D> doImage3D(UnsignedInt id, UnsignedInt level) override;
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
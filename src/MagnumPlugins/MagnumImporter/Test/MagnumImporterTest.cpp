@@ -0,0 +1,803 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Path.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+#include "MagnumPlugins/Implementation/magnumBlob.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+using namespace Magnum::Implementation;
+
+struct MagnumImporterTest: TestSuite::Tester {
+    explicit MagnumImporterTest();
+
+    void invalid();
+    void empty();
+    void unknownChunk();
+
+    void mesh();
+    void meshOutOfRange();
+    void meshInvalid();
+
+    void scene();
+    void sceneInvalid();
+
+    void material();
+    void materialInvalid();
+
+    void image();
+    void imageCompressed();
+    void imageInvalid();
+
+    void openData();
+    void openMemory();
+    void openMemoryUnaligned();
+    void openFile();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+/* A mesh with three UnsignedShort indices, starting at a two-byte offset,
+   and three Vector3 positions. 152 bytes in total. */
+struct MeshPayload {
+    BlobMesh mesh;
+    BlobMeshAttribute position;
+    char padding[8];
+    UnsignedShort indices[4];
+    char padding2[8];
+    Float positions[9];
+};
+
+MeshPayload meshPayload() {
+    MeshPayload payload{};
+    payload.mesh.primitive = UnsignedInt(MeshPrimitive::Triangles);
+    payload.mesh.indexType = UnsignedInt(MeshIndexType::UnsignedShort);
+    payload.mesh.indexCount = 3;
+    payload.mesh.indexStride = 2;
+    payload.mesh.vertexCount = 3;
+    payload.mesh.attributeCount = 1;
+    payload.mesh.indexOffset = 2;
+    payload.mesh.indexDataOffset = offsetof(MeshPayload, indices);
+    payload.mesh.indexDataSize = sizeof(payload.indices);
+    payload.mesh.vertexDataOffset = offsetof(MeshPayload, positions);
+    payload.mesh.vertexDataSize = sizeof(payload.positions);
+    payload.position.name = UnsignedInt(MeshAttribute::Position);
+    payload.position.format = UnsignedInt(VertexFormat::Vector3);
+    payload.position.stride = 12;
+    payload.position.morphTargetId = -1;
+
+    const UnsignedShort indices[]{0xffff, 2, 0, 1};
+    const Float positions[]{
+        -1.0f, -1.0f, 0.0f,
+         1.0f, -1.0f, 0.0f,
+         0.0f,  1.0f, 0.0f
+    };
+    std::memcpy(payload.indices, indices, sizeof(indices));
+    std::memcpy(payload.positions, positions, sizeof(positions));
+    return payload;
+}
+
+/* A scene with a Parent field for two objects, 112 bytes in total */
+struct ScenePayload {
+    BlobScene scene;
+    BlobSceneField parent;
+    UnsignedInt mapping[2];
+    Int parents[2];
+};
+
+ScenePayload scenePayload() {
+    ScenePayload payload{};
+    payload.scene.mappingType = UnsignedInt(SceneMappingType::UnsignedInt);
+    payload.scene.fieldCount = 1;
+    payload.scene.mappingBound = 2;
+    payload.scene.dataOffset = offsetof(ScenePayload, mapping);
+    payload.scene.dataSize = sizeof(payload.mapping) + sizeof(payload.parents);
+    payload.parent.name = UnsignedInt(SceneField::Parent);
+    payload.parent.type = UnsignedShort(SceneFieldType::Int);
+    payload.parent.size = 2;
+    payload.parent.mappingOffset = 0;
+    payload.parent.mappingStride = 4;
+    payload.parent.fieldOffset = sizeof(payload.mapping);
+    payload.parent.fieldStride = 4;
+    payload.mapping[0] = 0;
+    payload.mapping[1] = 1;
+    payload.parents[0] = -1;
+    payload.parents[1] = 0;
+    return payload;
+}
+
+/* A material with an empty base layer and two attributes in the second
+   layer */
+struct MaterialPayload {
+    BlobMaterial material;
+    UnsignedInt layers[2];
+    char padding[8];
+    MaterialAttributeData attributes[2];
+};
+
+MaterialPayload materialPayload() {
+    MaterialPayload payload{};
+    payload.material.types = UnsignedInt(MaterialType::PbrMetallicRoughness);
+    payload.material.layerCount = 2;
+    payload.material.attributeCount = 2;
+    payload.material.attributeSize = sizeof(MaterialAttributeData);
+    payload.material.layerDataOffset = offsetof(MaterialPayload, layers);
+    payload.material.attributeDataOffset = offsetof(MaterialPayload, attributes);
+    payload.layers[0] = 0;
+    payload.layers[1] = 2;
+    payload.attributes[0] = MaterialAttributeData{MaterialAttribute::AlphaMask, 0.5f};
+    payload.attributes[1] = MaterialAttributeData{MaterialAttribute::Roughness, 0.25f};
+    return payload;
+}
+
+/* A 2x2x6 RG8Unorm image with default storage, 136 bytes in total */
+struct ImagePayload {
+    BlobImage image;
+    char data[48];
+};
+
+ImagePayload imagePayload() {
+    ImagePayload payload{};
+    payload.image.format = UnsignedInt(PixelFormat::RG8Unorm);
+    payload.image.pixelSize = 2;
+    payload.image.size[0] = 2;
+    payload.image.size[1] = 2;
+    payload.image.size[2] = 6;
+    payload.image.alignment = 4;
+    payload.image.dataOffset = offsetof(ImagePayload, data);
+    payload.image.dataSize = sizeof(payload.data);
+    for(std::size_t i = 0; i != sizeof(payload.data); ++i)
+        payload.data[i] = char(i);
+    return payload;
+}
+
+void setValue(char* const at, const UnsignedInt valueSize, const UnsignedLong value) {
+    switch(valueSize) {
+        case 0: break;
+        case 1: *reinterpret_cast<UnsignedByte*>(at) = value; break;
+        case 2: *reinterpret_cast<UnsignedShort*>(at) = value; break;
+        case 4: *reinterpret_cast<UnsignedInt*>(at) = value; break;
+        case 8: *reinterpret_cast<UnsignedLong*>(at) = value; break;
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+    }
+}
+
+/* Creates a file with a single chunk, or with no chunks if type is zero */
+Containers::Array<char> blob(const BlobChunkType type, const Containers::StringView name, const Containers::ArrayView<const void> payload) {
+    const std::size_t chunkCount = UnsignedInt(type) ? 1 : 0;
+    const std::size_t payloadOffset = sizeof(BlobHeader);
+    const std::size_t nameOffset = payloadOffset + payload.size();
+    const std::size_t chunkOffset = blobAlign(nameOffset + name.size() + 1);
+    Containers::Array<char> out{ValueInit, std::size_t(chunkOffset + chunkCount*sizeof(BlobChunk))};
+
+    BlobHeader& header = *reinterpret_cast<BlobHeader*>(out.data());
+    std::memcpy(header.magic, BlobMagic, sizeof(BlobMagic));
+    header.version = BlobVersion;
+    header.endianness = BlobEndianness;
+    header.chunkCount = chunkCount;
+    header.defaultScene = -1;
+    header.chunkOffset = chunkOffset;
+    header.size = out.size();
+
+    if(chunkCount) {
+        BlobChunk& chunk = *reinterpret_cast<BlobChunk*>(out.data() + chunkOffset);
+        chunk.type = type;
+        chunk.nameSize = name.size();
+        chunk.nameOffset = nameOffset;
+        chunk.offset = payloadOffset;
+        chunk.size = payload.size();
+        Utility::copy(Containers::arrayView(name.data(), name.size()), out.sliceSize(nameOffset, name.size()));
+        Utility::copy(Containers::arrayCast<const char>(payload), out.sliceSize(payloadOffset, payload.size()));
+    }
+
+    return out;
+}
+
+Containers::Array<char> meshBlob() {
+    const MeshPayload payload = meshPayload();
+    return blob(BlobChunkType::Mesh, "triangle", Containers::arrayView(&payload, 1));
+}
+
+/* Offset of the mesh payload and the chunk table in meshBlob() */
+constexpr std::size_t MeshPayloadOffset = sizeof(BlobHeader);
+constexpr std::size_t MeshChunkOffset = blobAlign(MeshPayloadOffset + sizeof(MeshPayload) + sizeof("triangle"));
+
+const struct {
+    const char* name;
+    std::size_t size;
+    std::size_t offset;
+    UnsignedInt valueSize;
+    UnsignedLong value;
+    const char* message;
+} InvalidData[]{
+    {"too short", sizeof(BlobHeader) - 1, 0, 0, 0,
+        "expected at least 32 bytes for the header but got 31"},
+    {"invalid signature", ~std::size_t{}, 0, 1, 'X',
+        "invalid file signature"},
+    {"different endianness", ~std::size_t{}, offsetof(BlobHeader, endianness), 2, 0x0201,
+        "file has a different endianness"},
+    {"unsupported version", ~std::size_t{}, offsetof(BlobHeader, version), 2, 2,
+        "unsupported version 2, expected 1"},
+    {"size mismatch", ~std::size_t{}, offsetof(BlobHeader, size), 8, 1000,
+        "expected 1000 bytes but got 240"},
+    {"chunk table out of range", ~std::size_t{}, offsetof(BlobHeader, chunkCount), 4, 100,
+        "chunk table of 100 entries at offset 208 out of range"},
+    {"chunk table offset out of range", ~std::size_t{}, offsetof(BlobHeader, chunkOffset), 8, 1008,
+        "chunk table of 1 entries at offset 1008 out of range"},
+    {"chunk table not aligned", ~std::size_t{}, offsetof(BlobHeader, chunkOffset), 8, MeshChunkOffset - 4,
+        "chunk table of 1 entries at offset 204 out of range"},
+    {"chunk out of range", ~std::size_t{}, MeshChunkOffset + offsetof(BlobChunk, size), 8, 1000,
+        "chunk 0 out of range"},
+    {"chunk not aligned", ~std::size_t{}, MeshChunkOffset + offsetof(BlobChunk, offset), 8, MeshPayloadOffset + 4,
+        "chunk 0 out of range"},
+    {"chunk name out of range", ~std::size_t{}, MeshChunkOffset + offsetof(BlobChunk, nameSize), 4, 1000,
+        "name of chunk 0 out of range"},
+    {"default scene out of range", ~std::size_t{}, offsetof(BlobHeader, defaultScene), 4, 0,
+        "default scene 0 out of range for 0 scenes"},
+};
+
+const struct {
+    const char* name;
+    std::size_t offset;
+    UnsignedLong value;
+    const char* message;
+} MeshOutOfRangeData[]{
+    {"index data", offsetof(MeshPayload, mesh) + offsetof(BlobMesh, indexDataSize), 1000,
+        "index or vertex data out of range"},
+    {"vertex data", offsetof(MeshPayload, mesh) + offsetof(BlobMesh, vertexDataOffset), 1000,
+        "index or vertex data out of range"},
+    {"indices", offsetof(MeshPayload, mesh) + offsetof(BlobMesh, indexOffset), 4,
+        "index data out of range"},
+    {"attribute", offsetof(MeshPayload, position) + offsetof(BlobMeshAttribute, offset), 4,
+        "data of attribute 0 out of range"},
+};
+
+const struct {
+    const char* name;
+    std::size_t offset;
+    UnsignedInt valueSize;
+    UnsignedLong value;
+    const char* message;
+} MeshInvalidData[]{
+    {"primitive", offsetof(MeshPayload, mesh) + offsetof(BlobMesh, primitive), 4, 0xfff,
+        "invalid primitive 4095"},
+    {"index type", offsetof(MeshPayload, mesh) + offsetof(BlobMesh, indexType), 4, 4,
+        "invalid index type 4"},
+    {"index stride", offsetof(MeshPayload, mesh) + offsetof(BlobMesh, indexStride), 4, 40000,
+        "invalid index stride 40000"},
+    {"vertex format", offsetof(MeshPayload, position) + offsetof(BlobMeshAttribute, format), 4, 0,
+        "invalid format 0 of attribute 0"},
+    {"vertex format not compatible", offsetof(MeshPayload, position) + offsetof(BlobMeshAttribute, format), 4, UnsignedInt(VertexFormat::Float),
+        "VertexFormat::Float is not a valid format for attribute 0 of Trade::MeshAttribute::Position"},
+    {"array not allowed", offsetof(MeshPayload, position) + offsetof(BlobMeshAttribute, arraySize), 2, 2,
+        "attribute 0 of Trade::MeshAttribute::Position can't be an array"},
+    {"morph target ID", offsetof(MeshPayload, position) + offsetof(BlobMeshAttribute, morphTargetId), 2, 200,
+        "invalid morph target ID 200 of attribute 0 of Trade::MeshAttribute::Position"},
+    {"stride", offsetof(MeshPayload, position) + offsetof(BlobMeshAttribute, stride), 4, 40000,
+        "invalid stride 40000 of attribute 0"},
+};
+
+const struct {
+    const char* name;
+    std::size_t offset;
+    UnsignedInt valueSize;
+    UnsignedLong value;
+    const char* message;
+} SceneInvalidData[]{
+    {"mapping type", offsetof(ScenePayload, scene) + offsetof(BlobScene, mappingType), 4, 5,
+        "invalid mapping type 5"},
+    {"mapping bound", offsetof(ScenePayload, scene) + offsetof(BlobScene, mappingBound), 8, 0x100000000ull,
+        "Trade::SceneMappingType::UnsignedInt is too small for 4294967296 objects"},
+    {"field type", offsetof(ScenePayload, parent) + offsetof(BlobSceneField, type), 2, 0xffff,
+        "invalid type 65535 of field 0"},
+    {"field type not compatible", offsetof(ScenePayload, parent) + offsetof(BlobSceneField, type), 2, UnsignedShort(SceneFieldType::Float),
+        "Trade::SceneFieldType::Float is not a valid type for field 0 of Trade::SceneField::Parent"},
+    {"array not allowed", offsetof(ScenePayload, parent) + offsetof(BlobSceneField, arraySize), 2, 2,
+        "field 0 of Trade::SceneField::Parent can't be an array"},
+    {"flags not allowed", offsetof(ScenePayload, parent) + offsetof(BlobSceneField, flags), 1, UnsignedByte(SceneFieldFlag::MultiEntry),
+        "invalid flags Trade::SceneFieldFlag::MultiEntry for field 0 of Trade::SceneField::Parent"},
+    {"stride", offsetof(ScenePayload, parent) + offsetof(BlobSceneField, fieldStride), 8, 65536,
+        "invalid stride or bit offset of field 0"},
+};
+
+const struct {
+    const char* name;
+    std::size_t offset;
+    UnsignedInt valueSize;
+    UnsignedLong value;
+    const char* message;
+} MaterialInvalidData[]{
+    {"last layer offset", offsetof(MaterialPayload, material) + offsetof(BlobMaterial, layerCount), 4, 1,
+        "invalid offset of layer 0"},
+    {"attribute type", offsetof(MaterialPayload, attributes) + sizeof(MaterialAttributeData), 1, 0xfe,
+        "invalid type 254 of attribute 1"},
+    {"empty attribute name", offsetof(MaterialPayload, attributes) + 1, 1, 0,
+        "invalid name or value size of attribute 0"},
+    /* The last byte of the Float value is taken as a string size that
+       doesn't fit */
+    {"string value too large", offsetof(MaterialPayload, attributes), 1, UnsignedByte(MaterialAttributeType::String),
+        "invalid name or value size of attribute 0"},
+    {"attributes not sorted", offsetof(MaterialPayload, attributes) + 1, 1, 'Z',
+        "attributes in layer 1 are not sorted or contain duplicates"},
+};
+
+const struct {
+    const char* name;
+    UnsignedInt dimensions;
+    bool compressed;
+    Vector3i size;
+    UnsignedShort flags;
+    Int rowLength;
+    Vector3i skip;
+    Vector3i compressedBlockSize;
+    Int compressedBlockDataSize;
+    const char* message;
+} ImageInvalidData[]{
+    {"1D with a flag", 1, false, {2, 1, 1}, 0x1, 0, {}, {}, 0,
+        "invalid flags ImageFlag1D(0x1)"},
+    {"2D cube map", 2, false, {2, 2, 1}, 0x2, 0, {}, {}, 0,
+        "invalid flags ImageFlag2D(0x2)"},
+    {"3D unknown flag", 3, false, {2, 2, 1}, 0x4, 0, {}, {}, 0,
+        "invalid flags ImageFlag3D(0x4)"},
+    {"cube map not square", 3, false, {2, 3, 6}, 0x2, 0, {}, {}, 0,
+        "expected square faces for a cube map, got {2, 3}"},
+    {"cube map without 6 faces", 3, false, {2, 2, 5}, 0x2, 0, {}, {}, 0,
+        "expected exactly 6 faces for a cube map, got 5"},
+    {"cube map array without a multiple of 6 faces", 3, false, {2, 2, 8}, 0x3, 0, {}, {}, 0,
+        "expected a multiple of 6 faces for a cube map array, got 8"},
+    {"compressed cube map not square", 3, true, {4, 8, 6}, 0x2, 0, {}, {4, 4, 1}, 8,
+        "expected square faces for a cube map, got {4, 8}"},
+    {"negative size", 2, false, {2, -1, 1}, 0, 0, {}, {}, 0,
+        "invalid size {2, -1}"},
+    {"negative compressed size", 1, true, {-4, 1, 1}, 0, 0, {}, {4, 4, 1}, 8,
+        "invalid size {-4}"},
+    {"negative row length", 2, false, {2, 2, 1}, 0, -1, {}, {}, 0,
+        "invalid row length, image height or skip"},
+    {"negative compressed skip", 3, true, {4, 4, 1}, 0, 0, {0, 0, -1}, {4, 4, 1}, 8,
+        "invalid row length, image height or skip"},
+    {"zero compressed block size", 2, true, {4, 4, 1}, 0, 0, {}, {4, 0, 1}, 8,
+        "invalid compressed block size {4, 0, 1} or block data size 8"},
+    {"negative compressed block size", 2, true, {4, 4, 1}, 0, 0, {}, {-4, 4, 1}, 8,
+        "invalid compressed block size {-4, 4, 1} or block data size 8"},
+    {"compressed block size too large", 2, true, {4, 4, 1}, 0, 0, {}, {4, 4096, 1}, 8,
+        "invalid compressed block size {4, 4096, 1} or block data size 8"},
+    {"zero compressed block data size", 2, true, {4, 4, 1}, 0, 0, {}, {4, 4, 1}, 0,
+        "invalid compressed block size {4, 4, 1} or block data size 0"},
+    {"negative compressed block data size", 2, true, {4, 4, 1}, 0, 0, {}, {4, 4, 1}, -8,
+        "invalid compressed block size {4, 4, 1} or block data size -8"},
+    {"compressed block data size without block size", 2, true, {4, 4, 1}, 0, 0, {}, {}, 8,
+        "invalid compressed block size {0, 0, 0} or block data size 8"},
+    {"compressed data too small", 2, true, {12, 12, 1}, 0, 0, {}, {4, 4, 1}, 8,
+        "expected at least 72 bytes of compressed image data but got 48"},
+};
+
+MagnumImporterTest::MagnumImporterTest() {
+    addInstancedTests({&MagnumImporterTest::invalid},
+        Containers::arraySize(InvalidData));
+
+    addTests({&MagnumImporterTest::empty,
+              &MagnumImporterTest::unknownChunk,
+
+              &MagnumImporterTest::mesh});
+
+    addInstancedTests({&MagnumImporterTest::meshOutOfRange},
+        Containers::arraySize(MeshOutOfRangeData));
+
+    addInstancedTests({&MagnumImporterTest::meshInvalid},
+        Containers::arraySize(MeshInvalidData));
+
+    addTests({&MagnumImporterTest::scene});
+
+    addInstancedTests({&MagnumImporterTest::sceneInvalid},
+        Containers::arraySize(SceneInvalidData));
+
+    addTests({&MagnumImporterTest::material});
+
+    addInstancedTests({&MagnumImporterTest::materialInvalid},
+        Containers::arraySize(MaterialInvalidData));
+
+    addTests({&MagnumImporterTest::image,
+              &MagnumImporterTest::imageCompressed});
+
+    addInstancedTests({&MagnumImporterTest::imageInvalid},
+        Containers::arraySize(ImageInvalidData));
+
+    addTests({&MagnumImporterTest::openData,
+              &MagnumImporterTest::openMemory,
+              &MagnumImporterTest::openMemoryUnaligned,
+              &MagnumImporterTest::openFile});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MAGNUMIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(MAGNUMIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* Create the output directory if it doesn't exist yet */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Path::make(MAGNUMIMPORTER_TEST_OUTPUT_DIR));
+}
+
+void MagnumImporterTest::invalid() {
+    auto&& data = InvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<char> file = meshBlob();
+    setValue(file.data() + data.offset, data.valueSize, data.value);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(file.prefix(data.size == ~std::size_t{} ? file.size() : data.size)));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MagnumImporter::openData(): {}\n", data.message));
+}
+
+void MagnumImporterTest::empty() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(blob({}, {}, nullptr)));
+
+    CORRADE_COMPARE(importer->defaultScene(), -1);
+    CORRADE_COMPARE(importer->sceneCount(), 0);
+    CORRADE_COMPARE(importer->meshCount(), 0);
+    CORRADE_COMPARE(importer->materialCount(), 0);
+    CORRADE_COMPARE(importer->image1DCount(), 0);
+    CORRADE_COMPARE(importer->image2DCount(), 0);
+    CORRADE_COMPARE(importer->image3DCount(), 0);
+}
+
+void MagnumImporterTest::unknownChunk() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    const char payload[16]{};
+    CORRADE_VERIFY(importer->openData(blob(BlobChunkType('F' << 24 | 'U' << 16 | 'T' << 8 | 'R'), "future", payload)));
+
+    /* The chunk is silently skipped */
+    CORRADE_COMPARE(importer->sceneCount(), 0);
+    CORRADE_COMPARE(importer->meshCount(), 0);
+    CORRADE_COMPARE(importer->materialCount(), 0);
+    CORRADE_COMPARE(importer->image2DCount(), 0);
+}
+
+void MagnumImporterTest::mesh() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(meshBlob()));
+
+    CORRADE_COMPARE(importer->meshCount(), 1);
+    CORRADE_COMPARE(importer->meshName(0), "triangle");
+    CORRADE_COMPARE(importer->meshForName("triangle"), 0);
+    CORRADE_COMPARE(importer->meshForName("square"), -1);
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indexDataFlags(), DataFlags{});
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlags{});
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(mesh->isIndexed());
+    CORRADE_COMPARE(mesh->indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(mesh->indexOffset(), 2);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(), Containers::arrayView<UnsignedShort>({
+        2, 0, 1
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->attributeCount(), 1);
+    CORRADE_COMPARE(mesh->attributeName(0), MeshAttribute::Position);
+    CORRADE_COMPARE(mesh->attributeFormat(0), VertexFormat::Vector3);
+    CORRADE_COMPARE(mesh->attributeStride(0), 12);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(0), Containers::arrayView<Vector3>({
+        {-1.0f, -1.0f, 0.0f},
+        { 1.0f, -1.0f, 0.0f},
+        { 0.0f,  1.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void MagnumImporterTest::meshOutOfRange() {
+    auto&& data = MeshOutOfRangeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<char> file = meshBlob();
+    /* All modified fields are 64-bit */
+    *reinterpret_cast<UnsignedLong*>(file.data() + MeshPayloadOffset + data.offset) = data.value;
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(file));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MagnumImporter::mesh(): {}\n", data.message));
+}
+
+void MagnumImporterTest::meshInvalid() {
+    auto&& data = MeshInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<char> file = meshBlob();
+    setValue(file.data() + MeshPayloadOffset + data.offset, data.valueSize, data.value);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(file));
+
+    /* Should fail gracefully instead of asserting inside MeshData */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MagnumImporter::mesh(): {}\n", data.message));
+}
+
+void MagnumImporterTest::scene() {
+    const ScenePayload payload = scenePayload();
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(blob(BlobChunkType::Scene, "tree", Containers::arrayView(&payload, 1))));
+    CORRADE_COMPARE(importer->sceneCount(), 1);
+    CORRADE_COMPARE(importer->sceneName(0), "tree");
+
+    Containers::Optional<SceneData> scene = importer->scene(0);
+    CORRADE_VERIFY(scene);
+    CORRADE_COMPARE(scene->mappingType(), SceneMappingType::UnsignedInt);
+    CORRADE_COMPARE(scene->mappingBound(), 2);
+    CORRADE_COMPARE(scene->fieldCount(), 1);
+    CORRADE_COMPARE(scene->fieldName(0), SceneField::Parent);
+    CORRADE_COMPARE(scene->fieldType(0), SceneFieldType::Int);
+    CORRADE_COMPARE_AS(scene->mapping<UnsignedInt>(0), Containers::arrayView<UnsignedInt>({
+        0, 1
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene->field<Int>(0), Containers::arrayView<Int>({
+        -1, 0
+    }), TestSuite::Compare::Container);
+}
+
+void MagnumImporterTest::sceneInvalid() {
+    auto&& data = SceneInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    ScenePayload payload = scenePayload();
+    setValue(reinterpret_cast<char*>(&payload) + data.offset, data.valueSize, data.value);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(blob(BlobChunkType::Scene, "tree", Containers::arrayView(&payload, 1))));
+
+    /* Should fail gracefully instead of asserting inside SceneData */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->scene(0));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MagnumImporter::scene(): {}\n", data.message));
+}
+
+void MagnumImporterTest::material() {
+    const MaterialPayload payload = materialPayload();
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(blob(BlobChunkType::Material, "shiny", Containers::arrayView(&payload, 1))));
+    CORRADE_COMPARE(importer->materialCount(), 1);
+    CORRADE_COMPARE(importer->materialName(0), "shiny");
+
+    Containers::Optional<MaterialData> material = importer->material(0);
+    CORRADE_VERIFY(material);
+    CORRADE_COMPARE(material->types(), MaterialType::PbrMetallicRoughness);
+    CORRADE_COMPARE(material->layerCount(), 2);
+    CORRADE_COMPARE(material->attributeCount(0), 0);
+    CORRADE_COMPARE(material->attributeCount(1), 2);
+    CORRADE_COMPARE(material->attribute<Float>(1, MaterialAttribute::AlphaMask), 0.5f);
+    CORRADE_COMPARE(material->attribute<Float>(1, MaterialAttribute::Roughness), 0.25f);
+}
+
+void MagnumImporterTest::materialInvalid() {
+    auto&& data = MaterialInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    MaterialPayload payload = materialPayload();
+    setValue(reinterpret_cast<char*>(&payload) + data.offset, data.valueSize, data.value);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(blob(BlobChunkType::Material, "shiny", Containers::arrayView(&payload, 1))));
+
+    /* Should fail gracefully instead of asserting inside MaterialData */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->material(0));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MagnumImporter::material(): {}\n", data.message));
+}
+
+void MagnumImporterTest::image() {
+    ImagePayload payload = imagePayload();
+    payload.image.flags = UnsignedShort(ImageFlag3D::CubeMap);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(blob(BlobChunkType::Image3D, "cube", Containers::arrayView(&payload, 1))));
+    CORRADE_COMPARE(importer->image3DCount(), 1);
+    CORRADE_COMPARE(importer->image3DName(0), "cube");
+
+    Containers::Optional<ImageData3D> image = importer->image3D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(!image->isCompressed());
+    CORRADE_COMPARE(image->flags(), ImageFlag3D::CubeMap);
+    CORRADE_COMPARE(image->format(), PixelFormat::RG8Unorm);
+    CORRADE_COMPARE(image->size(), (Vector3i{2, 2, 6}));
+    const ImagePayload expected = imagePayload();
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(expected.data),
+        TestSuite::Compare::Container);
+}
+
+void MagnumImporterTest::imageCompressed() {
+    ImagePayload payload = imagePayload();
+    payload.image.compressed = true;
+    payload.image.format = UnsignedInt(CompressedPixelFormat::Bc1RGBAUnorm);
+    payload.image.size[0] = 8;
+    payload.image.size[1] = 12;
+    payload.image.size[2] = 1;
+    payload.image.compressedBlockSize[0] = 4;
+    payload.image.compressedBlockSize[1] = 4;
+    payload.image.compressedBlockSize[2] = 1;
+    payload.image.compressedBlockDataSize = 8;
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(blob(BlobChunkType::Image2D, "bc1", Containers::arrayView(&payload, 1))));
+
+    /* 2x3 blocks of 8 bytes, which is exactly the data size */
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(image->isCompressed());
+    CORRADE_COMPARE(image->compressedFormat(), CompressedPixelFormat::Bc1RGBAUnorm);
+    CORRADE_COMPARE(image->size(), (Vector2i{8, 12}));
+    CORRADE_COMPARE(image->compressedStorage().compressedBlockSize(), (Vector3i{4, 4, 1}));
+    CORRADE_COMPARE(image->compressedStorage().compressedBlockDataSize(), 8);
+    CORRADE_COMPARE(image->data().size(), 48);
+}
+
+void MagnumImporterTest::imageInvalid() {
+    auto&& data = ImageInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    ImagePayload payload = imagePayload();
+    payload.image.compressed = data.compressed;
+    if(data.compressed)
+        payload.image.format = UnsignedInt(CompressedPixelFormat::Bc1RGBAUnorm);
+    payload.image.flags = data.flags;
+    Vector3i::from(payload.image.size) = data.size;
+    payload.image.rowLength = data.rowLength;
+    Vector3i::from(payload.image.skip) = data.skip;
+    Vector3i::from(payload.image.compressedBlockSize) = data.compressedBlockSize;
+    payload.image.compressedBlockDataSize = data.compressedBlockDataSize;
+
+    constexpr BlobChunkType chunkTypes[]{
+        BlobChunkType::Image1D,
+        BlobChunkType::Image2D,
+        BlobChunkType::Image3D
+    };
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(blob(chunkTypes[data.dimensions - 1], "image", Containers::arrayView(&payload, 1))));
+
+    /* Should fail gracefully instead of asserting inside ImageData */
+    std::ostringstream out;
+    Error redirectError{&out};
+    if(data.dimensions == 1)
+        CORRADE_VERIFY(!importer->image1D(0));
+    else if(data.dimensions == 2)
+        CORRADE_VERIFY(!importer->image2D(0));
+    else
+        CORRADE_VERIFY(!importer->image3D(0));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MagnumImporter::image{}D(): {}\n", data.dimensions, data.message));
+}
+
+void MagnumImporterTest::openData() {
+    Containers::Array<char> file = meshBlob();
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(file));
+
+    /* The data get copied, so the original can be modified after */
+    Utility::copy(Containers::arrayView({'X'}), file.prefix(1));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_VERIFY(mesh->vertexData().data() != file.data() + MeshPayloadOffset + offsetof(MeshPayload, positions));
+    CORRADE_COMPARE(mesh->attribute<Vector3>(0)[2], (Vector3{0.0f, 1.0f, 0.0f}));
+}
+
+void MagnumImporterTest::openMemory() {
+    Containers::Array<char> file = meshBlob();
+    alignas(BlobAlignment) char storage[256];
+    CORRADE_INTERNAL_ASSERT(file.size() <= sizeof(storage));
+    Utility::copy(file, Containers::arrayView(storage).prefix(file.size()));
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openMemory(Containers::arrayView(storage).prefix(file.size())));
+
+    /* The memory is referenced directly */
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexData().data(), static_cast<const void*>(storage + MeshPayloadOffset + offsetof(MeshPayload, positions)));
+    CORRADE_COMPARE(mesh->indexData().data(), static_cast<const void*>(storage + MeshPayloadOffset + offsetof(MeshPayload, indices)));
+    CORRADE_COMPARE(mesh->attribute<Vector3>(0)[2], (Vector3{0.0f, 1.0f, 0.0f}));
+}
+
+void MagnumImporterTest::openMemoryUnaligned() {
+    Containers::Array<char> file = meshBlob();
+    alignas(BlobAlignment) char storage[256 + 1];
+    CORRADE_INTERNAL_ASSERT(file.size() <= sizeof(storage) - 1);
+    Utility::copy(file, Containers::arrayView(storage).sliceSize(1, file.size()));
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openMemory(Containers::arrayView(storage).sliceSize(1, file.size())));
+
+    /* The memory isn't suitably aligned, so it gets copied */
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_VERIFY(mesh->vertexData().data() != storage + 1 + MeshPayloadOffset + offsetof(MeshPayload, positions));
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(mesh->vertexData().data()) % BlobAlignment, 0);
+    CORRADE_COMPARE(mesh->attribute<Vector3>(0)[2], (Vector3{0.0f, 1.0f, 0.0f}));
+}
+
+void MagnumImporterTest::openFile() {
+    const Containers::String filename = Utility::Path::join(MAGNUMIMPORTER_TEST_OUTPUT_DIR, "triangle.blob");
+    CORRADE_VERIFY(Utility::Path::write(filename, meshBlob()));
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openFile(filename));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlags{});
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(), Containers::arrayView<UnsignedShort>({
+        2, 0, 1
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(mesh->attribute<Vector3>(0)[1], (Vector3{1.0f, -1.0f, 0.0f}));
+
+    /* Closing releases the mapping, the file can be then overwritten */
+    importer->close();
+    CORRADE_VERIFY(Utility::Path::write(filename, blob({}, {}, nullptr)));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MagnumImporterTest)
@@ -0,0 +1,419 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "MagnumSceneConverter.h"
+
+#include <cstdio>
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StridedBitArrayView.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Utility/Algorithms.h>
+#ifdef CORRADE_TARGET_WINDOWS
+#include <Corrade/Utility/Unicode.h>
+#endif
+
+#include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+#include "MagnumPlugins/Implementation/magnumBlob.h"
+
+namespace Magnum { namespace Trade {
+
+using namespace Magnum::Implementation;
+
+namespace {
+
+struct Blob {
+    ~Blob() {
+        if(file) std::fclose(file);
+    }
+
+    /* Chunk offsets are absolute, name offsets relative to the string table
+       until finish() */
+    Containers::Array<BlobChunk> chunks;
+    Containers::Array<char> names;
+    /* Payloads not written to the file yet. For data conversion that's all of
+       them, for file conversion it's just the one currently being added. */
+    Containers::Array<char> payload;
+    /* Size of payloads already written to the file */
+    std::size_t flushed{};
+    /* Set only for file conversion */
+    std::FILE* file{};
+    /* Set if writing to the file failed. The file position then no longer
+       matches the chunk offsets, so all further add() calls and endFile()
+       fail as well. */
+    bool failed{};
+};
+
+/* Appends a new zero-filled chunk of given size and returns a view on it. The
+   view is valid only until the next call. */
+Containers::ArrayView<char> addChunk(Blob& blob, const BlobChunkType type, const Containers::StringView name, const std::size_t size) {
+    const std::size_t offset = blobAlign(blob.flushed + blob.payload.size());
+    arrayAppend(blob.chunks, BlobChunk{type, UnsignedInt(name.size()), blob.names.size(), sizeof(BlobHeader) + offset, size});
+
+    arrayAppend(blob.names, Containers::arrayView(name.data(), name.size()));
+    arrayAppend(blob.names, '\0');
+
+    arrayResize(blob.payload, ValueInit, offset - blob.flushed + size);
+    return blob.payload.exceptPrefix(offset - blob.flushed);
+}
+
+/* For file conversion writes the just-added chunk out and frees its memory,
+   so the memory use is bounded by the largest chunk and not by the whole
+   output. No-op for data conversion. */
+bool flush(Blob& blob) {
+    if(!blob.file) return true;
+
+    if(blob.failed) {
+        Error{} << "Trade::MagnumSceneConverter::add(): a previous write to the file failed";
+        blob.payload = {};
+        return false;
+    }
+
+    if(std::fwrite(blob.payload.data(), 1, blob.payload.size(), blob.file) != blob.payload.size()) {
+        Error{} << "Trade::MagnumSceneConverter::add(): cannot write to the file";
+        blob.failed = true;
+        blob.payload = {};
+        return false;
+    }
+
+    blob.flushed += blob.payload.size();
+    blob.payload = {};
+    return true;
+}
+
+/* Fills the header and returns the string table and the chunk table that
+   go after the payloads */
+Containers::Array<char> finish(const Blob& blob, const Int defaultScene, BlobHeader& header) {
+    const std::size_t namesOffset = sizeof(BlobHeader) + blob.flushed + blob.payload.size();
+    const std::size_t chunkOffset = blobAlign(namesOffset + blob.names.size());
+    Containers::Array<char> out{ValueInit, chunkOffset - namesOffset + blob.chunks.size()*sizeof(BlobChunk)};
+
+    std::memcpy(header.magic, BlobMagic, sizeof(BlobMagic));
+    header.version = BlobVersion;
+    header.endianness = BlobEndianness;
+    header.chunkCount = blob.chunks.size();
+    header.defaultScene = defaultScene;
+    header.chunkOffset = chunkOffset;
+    header.size = namesOffset + out.size();
+
+    Utility::copy(blob.names, out.prefix(blob.names.size()));
+    const Containers::ArrayView<BlobChunk> chunks = Containers::arrayCast<BlobChunk>(out.exceptPrefix(chunkOffset - namesOffset));
+    for(std::size_t i = 0; i != chunks.size(); ++i) {
+        chunks[i] = blob.chunks[i];
+        chunks[i].nameOffset += namesOffset;
+    }
+
+    return out;
+}
+
+Vector3i imageSize(Int size) { return {size, 1, 1}; }
+Vector3i imageSize(const Vector2i& size) { return {size, 1}; }
+Vector3i imageSize(const Vector3i& size) { return size; }
+
+template<UnsignedInt dimensions> void addImage(Blob& blob, const BlobChunkType type, const ImageData<dimensions>& image, const Containers::StringView name) {
+    const UnsignedLong dataOffset = blobAlign(sizeof(BlobImage));
+    const Containers::ArrayView<char> chunk = addChunk(blob, type, name, dataOffset + image.data().size());
+
+    BlobImage& out = *reinterpret_cast<BlobImage*>(chunk.data());
+    out.compressed = image.isCompressed();
+    out.flags = UnsignedShort(image.flags());
+    Vector3i::from(out.size) = imageSize(image.size());
+    out.dataOffset = dataOffset;
+    out.dataSize = image.data().size();
+
+    if(image.isCompressed()) {
+        const CompressedPixelStorage storage = image.compressedStorage();
+        out.format = UnsignedInt(image.compressedFormat());
+        out.alignment = storage.alignment();
+        out.rowLength = storage.rowLength();
+        out.imageHeight = storage.imageHeight();
+        Vector3i::from(out.skip) = storage.skip();
+        Vector3i::from(out.compressedBlockSize) = storage.compressedBlockSize();
+        out.compressedBlockDataSize = storage.compressedBlockDataSize();
+    } else {
+        const PixelStorage storage = image.storage();
+        out.format = UnsignedInt(image.format());
+        out.formatExtra = image.formatExtra();
+        out.pixelSize = image.pixelSize();
+        out.alignment = storage.alignment();
+        out.rowLength = storage.rowLength();
+        out.imageHeight = storage.imageHeight();
+        Vector3i::from(out.skip) = storage.skip();
+    }
+
+    Utility::copy(image.data(), chunk.sliceSize(dataOffset, image.data().size()));
+}
+
+}
+
+struct MagnumSceneConverter::State {
+    Blob blob;
+    Int defaultScene = -1;
+};
+
+MagnumSceneConverter::MagnumSceneConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractSceneConverter{manager, plugin} {}
+
+MagnumSceneConverter::~MagnumSceneConverter() = default;
+
+SceneConverterFeatures MagnumSceneConverter::doFeatures() const {
+    return SceneConverterFeature::ConvertMultipleToData|
+        SceneConverterFeature::StreamToFile|
+        SceneConverterFeature::AddScenes|
+        SceneConverterFeature::AddMeshes|
+        SceneConverterFeature::AddMaterials|
+        SceneConverterFeature::AddImages1D|
+        SceneConverterFeature::AddImages2D|
+        SceneConverterFeature::AddImages3D|
+        SceneConverterFeature::AddCompressedImages1D|
+        SceneConverterFeature::AddCompressedImages2D|
+        SceneConverterFeature::AddCompressedImages3D;
+}
+
+void MagnumSceneConverter::doAbort() { _state = nullptr; }
+
+bool MagnumSceneConverter::doBeginData() {
+    _state.emplace();
+    return true;
+}
+
+Containers::Optional<Containers::Array<char>> MagnumSceneConverter::doEndData() {
+    const Blob& blob = _state->blob;
+
+    /* Header, payloads, string table, chunk table */
+    BlobHeader header{};
+    const Containers::Array<char> tail = finish(blob, _state->defaultScene, header);
+    Containers::Array<char> out{NoInit, std::size_t(header.size)};
+    *reinterpret_cast<BlobHeader*>(out.data()) = header;
+    Utility::copy(blob.payload, out.sliceSize(sizeof(BlobHeader), blob.payload.size()));
+    Utility::copy(tail, out.exceptPrefix(sizeof(BlobHeader) + blob.payload.size()));
+
+    _state = nullptr;
+
+    /* GCC 4.8 needs extra help here */
+    return Containers::optional(Utility::move(out));
+}
+
+bool MagnumSceneConverter::doBeginFile(const Containers::StringView filename) {
+    #ifndef CORRADE_TARGET_WINDOWS
+    std::FILE* const file = std::fopen(Containers::String::nullTerminatedView(filename).data(), "wb");
+    #else
+    std::FILE* const file = _wfopen(Utility::Unicode::widen(filename), L"wb");
+    #endif
+    if(!file) {
+        Error{} << "Trade::MagnumSceneConverter::beginFile(): cannot open file" << filename;
+        return false;
+    }
+
+    _state.emplace();
+    _state->blob.file = file;
+
+    /* Reserve space for the header, it gets written once the chunk count and
+       the chunk table offset are known */
+    const BlobHeader header{};
+    if(std::fwrite(&header, sizeof(BlobHeader), 1, file) != 1) {
+        Error{} << "Trade::MagnumSceneConverter::beginFile(): cannot write to file" << filename;
+        _state = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+bool MagnumSceneConverter::doEndFile(const Containers::StringView filename) {
+    Blob& blob = _state->blob;
+
+    /* All payloads are written already in add(). What's left is the string
+       table and the chunk table at the end and the header at the start. If
+       writing failed in add(), the chunk offsets are no longer valid and the
+       file can't be finished. */
+    BlobHeader header{};
+    const Containers::Array<char> tail = finish(blob, _state->defaultScene, header);
+    const bool written = !blob.failed &&
+        std::fwrite(tail.data(), 1, tail.size(), blob.file) == tail.size() &&
+        std::fseek(blob.file, 0, SEEK_SET) == 0 &&
+        std::fwrite(&header, sizeof(BlobHeader), 1, blob.file) == 1;
+    const bool closed = std::fclose(blob.file) == 0;
+    blob.file = nullptr;
+    _state = nullptr;
+
+    if(!written || !closed) {
+        Error{} << "Trade::MagnumSceneConverter::endFile(): cannot write to file" << filename;
+        return false;
+    }
+
+    return true;
+}
+
+bool MagnumSceneConverter::doAdd(UnsignedInt, const SceneData& scene, const Containers::StringView name) {
+    const UnsignedLong fieldsSize = scene.fieldCount()*sizeof(BlobSceneField);
+    const UnsignedLong dataOffset = blobAlign(sizeof(BlobScene) + fieldsSize);
+    const Containers::ArrayView<char> chunk = addChunk(_state->blob, BlobChunkType::Scene, name, dataOffset + scene.data().size());
+
+    BlobScene& out = *reinterpret_cast<BlobScene*>(chunk.data());
+    out.mappingType = UnsignedInt(scene.mappingType());
+    out.fieldCount = scene.fieldCount();
+    out.mappingBound = scene.mappingBound();
+    out.dataOffset = dataOffset;
+    out.dataSize = scene.data().size();
+
+    /* Convert all fields to offsets relative to the data array. SceneData
+       guarantees that all views are contained in it. */
+    const char* const data = static_cast<const char*>(scene.data().data());
+    const Containers::ArrayView<BlobSceneField> fields = Containers::arrayCast<BlobSceneField>(chunk.sliceSize(sizeof(BlobScene), fieldsSize));
+    for(UnsignedInt i = 0; i != fields.size(); ++i) {
+        BlobSceneField& field = fields[i];
+        const SceneFieldType type = scene.fieldType(i);
+        field.name = UnsignedInt(scene.fieldName(i));
+        field.type = UnsignedShort(type);
+        field.arraySize = scene.fieldArraySize(i);
+        field.size = scene.fieldSize(i);
+        field.flags = UnsignedByte(scene.fieldFlags(i) & ~SceneFieldFlag::OffsetOnly);
+
+        /* Empty fields may have arbitrary pointers, keep the offsets zero for
+           those */
+        if(!field.size) continue;
+
+        const Containers::StridedArrayView2D<const char> mapping = scene.mapping(i);
+        field.mappingOffset = static_cast<const char*>(mapping.data()) - data;
+        field.mappingStride = mapping.stride()[0];
+
+        if(type == SceneFieldType::Bit) {
+            const Containers::StridedBitArrayView2D bits = scene.fieldBitArrays(i);
+            field.fieldOffset = static_cast<const char*>(bits.data()) - data;
+            field.fieldBitOffset = bits.offset();
+            field.fieldStride = bits.stride()[0];
+        } else {
+            const Containers::StridedArrayView2D<const char> fieldData = scene.field(i);
+            field.fieldOffset = static_cast<const char*>(fieldData.data()) - data;
+            field.fieldStride = fieldData.stride()[0];
+            if(type >= SceneFieldType::StringOffset8 && type <= SceneFieldType::StringRangeNullTerminated64)
+                field.stringOffset = scene.fieldStringData(i) - data;
+        }
+    }
+
+    Utility::copy(Containers::arrayView(data, scene.data().size()), chunk.sliceSize(dataOffset, scene.data().size()));
+    return flush(_state->blob);
+}
+
+void MagnumSceneConverter::doSetDefaultScene(const UnsignedInt id) {
+    _state->defaultScene = id;
+}
+
+bool MagnumSceneConverter::doAdd(UnsignedInt, const MeshData& mesh, const Containers::StringView name) {
+    const UnsignedLong attributesSize = mesh.attributeCount()*sizeof(BlobMeshAttribute);
+    const UnsignedLong indexDataOffset = blobAlign(sizeof(BlobMesh) + attributesSize);
+    const UnsignedLong vertexDataOffset = blobAlign(indexDataOffset + mesh.indexData().size());
+    const Containers::ArrayView<char> chunk = addChunk(_state->blob, BlobChunkType::Mesh, name, vertexDataOffset + mesh.vertexData().size());
+
+    BlobMesh& out = *reinterpret_cast<BlobMesh*>(chunk.data());
+    out.primitive = UnsignedInt(mesh.primitive());
+    if(mesh.isIndexed()) {
+        out.indexType = UnsignedInt(mesh.indexType());
+        out.indexCount = mesh.indexCount();
+        out.indexStride = mesh.indexStride();
+        out.indexOffset = mesh.indexOffset();
+    }
+    out.vertexCount = mesh.vertexCount();
+    out.attributeCount = mesh.attributeCount();
+    out.indexDataOffset = indexDataOffset;
+    out.indexDataSize = mesh.indexData().size();
+    out.vertexDataOffset = vertexDataOffset;
+    out.vertexDataSize = mesh.vertexData().size();
+
+    const Containers::ArrayView<BlobMeshAttribute> attributes = Containers::arrayCast<BlobMeshAttribute>(chunk.sliceSize(sizeof(BlobMesh), attributesSize));
+    for(UnsignedInt i = 0; i != attributes.size(); ++i) {
+        BlobMeshAttribute& attribute = attributes[i];
+        attribute.name = UnsignedInt(mesh.attributeName(i));
+        attribute.format = UnsignedInt(mesh.attributeFormat(i));
+        attribute.offset = mesh.attributeOffset(i);
+        attribute.stride = mesh.attributeStride(i);
+        attribute.arraySize = mesh.attributeArraySize(i);
+        attribute.morphTargetId = mesh.attributeMorphTargetId(i);
+    }
+
+    Utility::copy(mesh.indexData(), chunk.sliceSize(indexDataOffset, mesh.indexData().size()));
+    Utility::copy(mesh.vertexData(), chunk.sliceSize(vertexDataOffset, mesh.vertexData().size()));
+    return flush(_state->blob);
+}
+
+bool MagnumSceneConverter::doAdd(UnsignedInt, const MaterialData& material, const Containers::StringView name) {
+    /* Pointers can't survive a roundtrip through a file */
+    for(UnsignedInt i = 0; i != material.attributeData().size(); ++i) {
+        const MaterialAttributeType type = material.attributeData()[i].type();
+        if(type == MaterialAttributeType::Pointer || type == MaterialAttributeType::MutablePointer) {
+            Error{} << "Trade::MagnumSceneConverter::add(): material attribute" << material.attributeData()[i].name() << "is" << type << Debug::nospace << ", which can't be saved";
+            return false;
+        }
+    }
+
+    const UnsignedLong layersSize = material.layerData().size()*sizeof(UnsignedInt);
+    const UnsignedLong attributesSize = material.attributeData().size()*sizeof(MaterialAttributeData);
+    const UnsignedLong layerDataOffset = blobAlign(sizeof(BlobMaterial));
+    const UnsignedLong attributeDataOffset = blobAlign(layerDataOffset + layersSize);
+    const Containers::ArrayView<char> chunk = addChunk(_state->blob, BlobChunkType::Material, name, attributeDataOffset + attributesSize);
+
+    BlobMaterial& out = *reinterpret_cast<BlobMaterial*>(chunk.data());
+    out.types = UnsignedInt(material.types());
+    out.layerCount = material.layerData().size();
+    out.attributeCount = material.attributeData().size();
+    out.attributeSize = sizeof(MaterialAttributeData);
+    out.layerDataOffset = layerDataOffset;
+    out.attributeDataOffset = attributeDataOffset;
+
+    Utility::copy(Containers::arrayCast<const char>(material.layerData()), chunk.sliceSize(layerDataOffset, layersSize));
+    Utility::copy(Containers::arrayCast<const char>(material.attributeData()), chunk.sliceSize(attributeDataOffset, attributesSize));
+    return flush(_state->blob);
+}
+
+bool MagnumSceneConverter::doAdd(UnsignedInt, const ImageData1D& image, const Containers::StringView name) {
+    addImage(_state->blob, BlobChunkType::Image1D, image, name);
+    return flush(_state->blob);
+}
+
+bool MagnumSceneConverter::doAdd(UnsignedInt, const ImageData2D& image, const Containers::StringView name) {
+    addImage(_state->blob, BlobChunkType::Image2D, image, name);
+    return flush(_state->blob);
+}
+
+bool MagnumSceneConverter::doAdd(UnsignedInt, const ImageData3D& image, const Containers::StringView name) {
+    addImage(_state->blob, BlobChunkType::Image3D, image, name);
+    return flush(_state->blob);
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MagnumSceneConverter, Magnum::Trade::MagnumSceneConverter,
+    MAGNUM_TRADE_ABSTRACTSCENECONVERTER_PLUGIN_INTERFACE)
@@ -0,0 +1,155 @@
+#ifndef Magnum_Trade_MagnumSceneConverter_h
+#define Magnum_Trade_MagnumSceneConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MagnumSceneConverter
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "MagnumPlugins/MagnumSceneConverter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MAGNUMSCENECONVERTER_BUILD_STATIC
+    #ifdef MagnumSceneConverter_EXPORTS
+        #define MAGNUM_MAGNUMSCENECONVERTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MAGNUMSCENECONVERTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MAGNUMSCENECONVERTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MAGNUMSCENECONVERTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MAGNUMSCENECONVERTER_EXPORT
+#define MAGNUM_MAGNUMSCENECONVERTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Magnum blob scene converter plugin
+@m_since_latest
+
+Writes meshes, scenes, materials and images into a native memory-mappable
+blob (`*.blob`) that can be imported back with @ref MagnumImporter without
+any parsing or copying. The output consists of a small header, the data
+themselves with all arrays aligned to 16 bytes, and a table of chunks with one
+entry per data item at the end.
+
+@section Trade-MagnumSceneConverter-usage Usage
+
+@m_class{m-note m-success}
+
+@par
+    This class is a plugin that's meant to be dynamically loaded and used
+    through the base @ref AbstractSceneConverter interface. See its
+    documentation for introduction and usage examples.
+
+This plugin depends on the @ref Trade library and is built if
+`MAGNUM_WITH_MAGNUMSCENECONVERTER` is enabled when building Magnum. To use as
+a dynamic plugin, load @cpp "MagnumSceneConverter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(MAGNUM_WITH_MAGNUMSCENECONVERTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::MagnumSceneConverter)
+@endcode
+
+To use as a static plugin or as a dependency of another plugin with CMake, you
+need to request the `MagnumSceneConverter` component of the `Magnum` package
+and link to the `Magnum::MagnumSceneConverter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED MagnumSceneConverter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::MagnumSceneConverter)
+@endcode
+
+See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
+information.
+
+@section Trade-MagnumSceneConverter-behavior Behavior and limitations
+
+The data are written in the native endianness and the output is meant to be
+consumed by the same platform and Magnum version that produced it, not as an
+interchange format. Index, vertex, scene field and image data are written
+as-is, including their strides, padding and pixel storage parameters, so the
+imported instances are equivalent to the ones that were added.
+
+When converting to a file, each data item is written to the file directly in
+@ref add() and the converter keeps only the chunk table in memory, which is
+advertised with @ref SceneConverterFeature::StreamToFile. The added data can be
+thus released right after @ref add() returns, and memory use stays bounded by
+the largest item even for outputs much larger than available memory. When
+converting to data, the whole output is kept in memory until @ref endData().
+
+Materials containing @ref MaterialAttributeType::Pointer or
+@relativeref{MaterialAttributeType,MutablePointer} attributes can't be
+converted. Only a single level is supported for meshes and images, mesh
+attribute and scene field names, object names and texture, light, camera,
+skin and animation data are not written.
+*/
+class MAGNUM_MAGNUMSCENECONVERTER_EXPORT MagnumSceneConverter: public AbstractSceneConverter {
+    public:
+        /** @brief Plugin manager constructor */
+        explicit MagnumSceneConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
+
+        ~MagnumSceneConverter();
+
+    private:
+        struct State;
+
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL SceneConverterFeatures doFeatures() const override;
+
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL void doAbort() override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL bool doBeginData() override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL Containers::Optional<Containers::Array<char>> doEndData() override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL bool doBeginFile(Containers::StringView filename) override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL bool doEndFile(Containers::StringView filename) override;
+
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL bool doAdd(UnsignedInt id, const SceneData& scene, Containers::StringView name) override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL void doSetDefaultScene(UnsignedInt id) override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL bool doAdd(UnsignedInt id, const MeshData& mesh, Containers::StringView name) override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL bool doAdd(UnsignedInt id, const MaterialData& material, Containers::StringView name) override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL bool doAdd(UnsignedInt id, const ImageData1D& image, Containers::StringView name) override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL bool doAdd(UnsignedInt id, const ImageData2D& image, Containers::StringView name) override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL bool doAdd(UnsignedInt id, const ImageData3D& image, Containers::StringView name) override;
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
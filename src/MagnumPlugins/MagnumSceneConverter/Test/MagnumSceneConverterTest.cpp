@@ -0,0 +1,533 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/BitArrayView.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StridedBitArrayView.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringIterable.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Path.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+#include "MagnumPlugins/Implementation/magnumBlob.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+using namespace Magnum::Implementation;
+using namespace Containers::Literals;
+using namespace Math::Literals;
+
+struct MagnumSceneConverterTest: TestSuite::Tester {
+    explicit MagnumSceneConverterTest();
+
+    void empty();
+
+    void mesh();
+    void scene();
+    void material();
+    void materialPointer();
+    void image();
+    void imageCompressed();
+
+    void toFile();
+    void toFileStreaming();
+    void toFileCannotOpen();
+    void toFileCannotWrite();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractSceneConverter> _converterManager{"nonexistent"};
+    PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
+};
+
+MagnumSceneConverterTest::MagnumSceneConverterTest() {
+    addTests({&MagnumSceneConverterTest::empty,
+
+              &MagnumSceneConverterTest::mesh,
+              &MagnumSceneConverterTest::scene,
+              &MagnumSceneConverterTest::material,
+              &MagnumSceneConverterTest::materialPointer,
+              &MagnumSceneConverterTest::image,
+              &MagnumSceneConverterTest::imageCompressed,
+
+              &MagnumSceneConverterTest::toFile,
+              &MagnumSceneConverterTest::toFileStreaming,
+              &MagnumSceneConverterTest::toFileCannotOpen,
+              &MagnumSceneConverterTest::toFileCannotWrite});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MAGNUMSCENECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_converterManager.load(MAGNUMSCENECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    /* Optional plugins that don't have to be here */
+    #ifdef MAGNUMIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(MAGNUMIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* Create the output directory if it doesn't exist yet */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Path::make(MAGNUMSCENECONVERTER_TEST_OUTPUT_DIR));
+}
+
+void MagnumSceneConverterTest::empty() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    CORRADE_VERIFY(converter->beginData());
+    Containers::Optional<Containers::Array<char>> out = converter->endData();
+    CORRADE_VERIFY(out);
+
+    /* Just the header, aligned */
+    CORRADE_COMPARE(out->size(), 32);
+    const BlobHeader& header = *reinterpret_cast<const BlobHeader*>(out->data());
+    CORRADE_COMPARE((Containers::StringView{header.magic, 4}), "MGNB"_s);
+    CORRADE_COMPARE(header.version, 1);
+    CORRADE_COMPARE(header.endianness, BlobEndianness);
+    CORRADE_COMPARE(header.chunkCount, 0);
+    CORRADE_COMPARE(header.defaultScene, -1);
+    CORRADE_COMPARE(header.chunkOffset, 32);
+    CORRADE_COMPARE(header.size, 32);
+}
+
+void MagnumSceneConverterTest::mesh() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    const struct Vertex {
+        Vector3 position;
+        Color4ub color;
+    } vertices[]{
+        {{-1.0f, -1.0f, 0.0f}, 0xff3366cc_rgba},
+        {{ 1.0f, -1.0f, 0.0f}, 0x33ff66cc_rgba},
+        {{ 0.0f,  1.0f, 0.0f}, 0x6633ffcc_rgba}
+    };
+    const UnsignedByte indices[]{2, 0, 1, 0};
+    const auto view = Containers::stridedArrayView(vertices);
+
+    /* Meshes with no data survive as well */
+    CORRADE_VERIFY(converter->beginData());
+    CORRADE_VERIFY(converter->add(MeshData{MeshPrimitive::Points, 15}, "empty"));
+    CORRADE_VERIFY(converter->add(MeshData{MeshPrimitive::Triangles,
+        {}, indices, MeshIndexData{Containers::arrayView(indices).prefix(3)},
+        {}, vertices, {
+            MeshAttributeData{MeshAttribute::Position, view.slice(&Vertex::position)},
+            MeshAttributeData{MeshAttribute::Color, view.slice(&Vertex::color)}
+        }}, "triangle"));
+    Containers::Optional<Containers::Array<char>> out = converter->endData();
+    CORRADE_VERIFY(out);
+
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(*out));
+    CORRADE_COMPARE(importer->meshCount(), 2);
+    CORRADE_COMPARE(importer->meshName(0), "empty");
+    CORRADE_COMPARE(importer->meshForName("triangle"), 1);
+
+    Containers::Optional<MeshData> empty = importer->mesh(0);
+    CORRADE_VERIFY(empty);
+    CORRADE_COMPARE(empty->primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(!empty->isIndexed());
+    CORRADE_COMPARE(empty->vertexCount(), 15);
+    CORRADE_COMPARE(empty->attributeCount(), 0);
+
+    Containers::Optional<MeshData> mesh = importer->mesh(1);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh->indexType(), MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedByte>(), Containers::arrayView<UnsignedByte>({
+        2, 0, 1
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->attributeCount(), 2);
+    CORRADE_COMPARE(mesh->attributeStride(MeshAttribute::Color), sizeof(Vertex));
+    CORRADE_COMPARE(mesh->attributeOffset(MeshAttribute::Color), sizeof(Vector3));
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        view.slice(&Vertex::position),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Color4ub>(MeshAttribute::Color),
+        view.slice(&Vertex::color),
+        TestSuite::Compare::Container);
+}
+
+void MagnumSceneConverterTest::scene() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    struct Fields {
+        UnsignedShort mapping[3];
+        Short parent[3];
+        UnsignedByte visible[1];
+        UnsignedByte nameOffsets[3];
+        char names[12];
+    };
+    Containers::Array<char> data{ValueInit, sizeof(Fields)};
+    Fields& fields = *reinterpret_cast<Fields*>(data.data());
+    Utility::copy({7, 2, 5}, Containers::arrayView(fields.mapping));
+    Utility::copy({-1, 7, 7}, Containers::arrayView(fields.parent));
+    fields.visible[0] = 0x5;
+    Utility::copy({3, 8, 12}, Containers::arrayView(fields.nameOffsets));
+    Utility::copy(Containers::arrayView("redgreenblue").prefix(12), Containers::arrayView(fields.names));
+
+    const SceneField sceneFieldVisible = sceneFieldCustom(0);
+    const SceneField sceneFieldName = sceneFieldCustom(1);
+    SceneData scene{SceneMappingType::UnsignedShort, 8, Utility::move(data), {
+        SceneFieldData{SceneField::Parent,
+            Containers::arrayView(fields.mapping),
+            Containers::arrayView(fields.parent),
+            SceneFieldFlag::ImplicitMapping},
+        SceneFieldData{sceneFieldVisible, SceneMappingType::UnsignedShort,
+            Containers::arrayView(fields.mapping),
+            Containers::BitArrayView{fields.visible, 0, 3}},
+        SceneFieldData{sceneFieldName, SceneMappingType::UnsignedShort,
+            Containers::arrayView(fields.mapping),
+            fields.names, SceneFieldType::StringOffset8,
+            Containers::arrayView(fields.nameOffsets)},
+    }};
+
+    CORRADE_VERIFY(converter->beginData());
+    CORRADE_VERIFY(converter->add(SceneData{SceneMappingType::UnsignedInt, 0, nullptr, {}}));
+    CORRADE_VERIFY(converter->add(scene, "main"));
+    converter->setDefaultScene(1);
+    Containers::Optional<Containers::Array<char>> out = converter->endData();
+    CORRADE_VERIFY(out);
+
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(*out));
+    CORRADE_COMPARE(importer->sceneCount(), 2);
+    CORRADE_COMPARE(importer->defaultScene(), 1);
+    CORRADE_COMPARE(importer->sceneName(0), "");
+    CORRADE_COMPARE(importer->sceneForName("main"), 1);
+
+    Containers::Optional<SceneData> imported = importer->scene(1);
+    CORRADE_VERIFY(imported);
+    CORRADE_COMPARE(imported->dataFlags(), DataFlags{});
+    CORRADE_COMPARE(imported->mappingType(), SceneMappingType::UnsignedShort);
+    CORRADE_COMPARE(imported->mappingBound(), 8);
+    CORRADE_COMPARE(imported->fieldCount(), 3);
+
+    CORRADE_COMPARE(imported->fieldName(0), SceneField::Parent);
+    CORRADE_COMPARE(imported->fieldFlags(0), SceneFieldFlag::ImplicitMapping);
+    CORRADE_COMPARE_AS(imported->mapping<UnsignedShort>(0), Containers::arrayView<UnsignedShort>({
+        7, 2, 5
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(imported->field<Short>(0), Containers::arrayView<Short>({
+        -1, 7, 7
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(imported->fieldName(1), sceneFieldVisible);
+    CORRADE_COMPARE(imported->fieldType(1), SceneFieldType::Bit);
+    CORRADE_COMPARE_AS(imported->fieldBits(1), Containers::stridedArrayView({
+        true, false, true
+    }).sliceBit(0), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(imported->fieldName(2), sceneFieldName);
+    CORRADE_COMPARE(imported->fieldType(2), SceneFieldType::StringOffset8);
+    CORRADE_COMPARE_AS(imported->fieldStrings(2), Containers::arrayView({
+        "red"_s, "green"_s, "blue"_s
+    }), TestSuite::Compare::Container);
+}
+
+void MagnumSceneConverterTest::material() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    MaterialData material{MaterialType::PbrMetallicRoughness|MaterialType::PbrClearCoat, {
+        {MaterialAttribute::BaseColor, 0x3bd267ff_rgbaf},
+        {MaterialAttribute::BaseColorTexture, 5u},
+        {MaterialLayer::ClearCoat},
+        {MaterialAttribute::LayerFactor, 0.5f},
+        {"customName", "hello"_s}
+    }, {2, 5}};
+
+    CORRADE_VERIFY(converter->beginData());
+    CORRADE_VERIFY(converter->add(material, "shiny"));
+    Containers::Optional<Containers::Array<char>> out = converter->endData();
+    CORRADE_VERIFY(out);
+
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(*out));
+    CORRADE_COMPARE(importer->materialCount(), 1);
+    CORRADE_COMPARE(importer->materialName(0), "shiny");
+
+    Containers::Optional<MaterialData> imported = importer->material(0);
+    CORRADE_VERIFY(imported);
+    CORRADE_COMPARE(imported->attributeDataFlags(), DataFlags{});
+    CORRADE_COMPARE(imported->layerDataFlags(), DataFlags{});
+    CORRADE_COMPARE(imported->types(), MaterialType::PbrMetallicRoughness|MaterialType::PbrClearCoat);
+    CORRADE_COMPARE(imported->layerCount(), 2);
+    CORRADE_COMPARE(imported->attributeCount(0), 2);
+    CORRADE_COMPARE(imported->attributeCount(1), 3);
+    CORRADE_COMPARE(imported->attribute<Color4>(MaterialAttribute::BaseColor), 0x3bd267ff_rgbaf);
+    CORRADE_COMPARE(imported->attribute<UnsignedInt>(MaterialAttribute::BaseColorTexture), 5);
+    CORRADE_VERIFY(imported->hasLayer(MaterialLayer::ClearCoat));
+    CORRADE_COMPARE(imported->attribute<Float>(MaterialLayer::ClearCoat, MaterialAttribute::LayerFactor), 0.5f);
+    CORRADE_COMPARE(imported->attribute<Containers::StringView>(1, "customName"), "hello");
+}
+
+void MagnumSceneConverterTest::materialPointer() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    const Float value = 3.5f;
+    MaterialData material{{}, {
+        {"pointer", &value}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(converter->beginData());
+    CORRADE_VERIFY(!converter->add(material));
+    CORRADE_COMPARE(out.str(), "Trade::MagnumSceneConverter::add(): material attribute pointer is Trade::MaterialAttributeType::Pointer, which can't be saved\n");
+}
+
+void MagnumSceneConverterTest::image() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    /* Non-default pixel storage to verify it's preserved */
+    const char data1D[]{'a', 'b', 'c', 'd'};
+    const char data2D[]{
+        0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 1, 2, 3, 4, 0, 0,
+        0, 0, 5, 6, 7, 8, 0, 0
+    };
+    const char data3D[2*2*2*4]{};
+
+    CORRADE_VERIFY(converter->beginData());
+    CORRADE_VERIFY(converter->add(ImageData1D{PixelFormat::RG8Unorm, 2, DataFlags{}, data1D}));
+    CORRADE_VERIFY(converter->add(ImageData2D{PixelStorage{}.setSkip({1, 1, 0}), PixelFormat::RG8Unorm, {2, 2}, DataFlags{}, data2D}, "image"));
+    CORRADE_VERIFY(converter->add(ImageData3D{PixelFormat::RGBA8Unorm, {2, 2, 2}, DataFlags{}, data3D, ImageFlag3D::Array}));
+    Containers::Optional<Containers::Array<char>> out = converter->endData();
+    CORRADE_VERIFY(out);
+
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(*out));
+    CORRADE_COMPARE(importer->image1DCount(), 1);
+    CORRADE_COMPARE(importer->image2DCount(), 1);
+    CORRADE_COMPARE(importer->image3DCount(), 1);
+    CORRADE_COMPARE(importer->image2DName(0), "image");
+
+    Containers::Optional<ImageData1D> image1D = importer->image1D(0);
+    CORRADE_VERIFY(image1D);
+    CORRADE_VERIFY(!image1D->isCompressed());
+    CORRADE_COMPARE(image1D->format(), PixelFormat::RG8Unorm);
+    CORRADE_COMPARE(image1D->size(), 2);
+    CORRADE_COMPARE_AS(image1D->data(), Containers::arrayView(data1D),
+        TestSuite::Compare::Container);
+
+    Containers::Optional<ImageData2D> image2D = importer->image2D(0);
+    CORRADE_VERIFY(image2D);
+    CORRADE_COMPARE(image2D->dataFlags(), DataFlags{});
+    CORRADE_COMPARE(image2D->storage().skip(), (Vector3i{1, 1, 0}));
+    CORRADE_COMPARE(image2D->storage().alignment(), 4);
+    CORRADE_COMPARE(image2D->format(), PixelFormat::RG8Unorm);
+    CORRADE_COMPARE(image2D->pixelSize(), 2);
+    CORRADE_COMPARE(image2D->size(), (Vector2i{2, 2}));
+    CORRADE_COMPARE_AS(image2D->pixels<Vector2ub>()[1], Containers::arrayView<Vector2ub>({
+        {5, 6}, {7, 8}
+    }), TestSuite::Compare::Container);
+
+    Containers::Optional<ImageData3D> image3D = importer->image3D(0);
+    CORRADE_VERIFY(image3D);
+    CORRADE_COMPARE(image3D->flags(), ImageFlag3D::Array);
+    CORRADE_COMPARE(image3D->size(), (Vector3i{2, 2, 2}));
+    CORRADE_COMPARE(image3D->data().size(), sizeof(data3D));
+}
+
+void MagnumSceneConverterTest::imageCompressed() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    const char data[16]{'B', 'C', '1', '!'};
+    CORRADE_VERIFY(converter->beginData());
+    CORRADE_VERIFY(converter->add(ImageData2D{CompressedPixelFormat::Bc1RGBAUnorm, {4, 4}, DataFlags{}, data}));
+    Containers::Optional<Containers::Array<char>> out = converter->endData();
+    CORRADE_VERIFY(out);
+
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(*out));
+
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(image->isCompressed());
+    CORRADE_COMPARE(image->compressedFormat(), CompressedPixelFormat::Bc1RGBAUnorm);
+    CORRADE_COMPARE(image->size(), (Vector2i{4, 4}));
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(data),
+        TestSuite::Compare::Container);
+}
+
+void MagnumSceneConverterTest::toFile() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    const Vector2 positions[]{{1.0f, 2.0f}, {3.0f, 4.0f}};
+    const Containers::String filename = Utility::Path::join(MAGNUMSCENECONVERTER_TEST_OUTPUT_DIR, "mesh.blob");
+
+    /* Goes through the batch interface internally */
+    CORRADE_VERIFY(converter->convertToFile(MeshData{MeshPrimitive::Lines,
+        {}, positions, {
+            MeshAttributeData{MeshAttribute::Position, Containers::arrayView(positions)}
+        }}, filename));
+
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openFile(filename));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector2>(MeshAttribute::Position),
+        Containers::arrayView(positions),
+        TestSuite::Compare::Container);
+}
+
+void MagnumSceneConverterTest::toFileStreaming() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+    CORRADE_VERIFY(converter->features() & SceneConverterFeature::StreamToFile);
+
+    const Containers::String filename = Utility::Path::join(MAGNUMSCENECONVERTER_TEST_OUTPUT_DIR, "streaming.blob");
+    CORRADE_VERIFY(converter->beginFile(filename));
+
+    /* The data are written out right in add() and the converter doesn't
+       reference them after, so they can be freed or overwritten */
+    {
+        Containers::Array<char> vertexData{ValueInit, 3*sizeof(Vector2)};
+        const auto positions = Containers::arrayCast<Vector2>(vertexData);
+        positions[0] = {1.0f, 2.0f};
+        positions[1] = {3.0f, 4.0f};
+        positions[2] = {5.0f, 6.0f};
+        CORRADE_VERIFY(converter->add(MeshData{MeshPrimitive::Triangles,
+            Utility::move(vertexData), {
+                MeshAttributeData{MeshAttribute::Position, positions}
+            }}, "triangle"));
+    } {
+        Containers::Array<char> imageData{ValueInit, 4};
+        Utility::copy({'a', 'b', 'c', 'd'}, Containers::arrayView(imageData));
+        ImageData2D image{PixelFormat::RG8Unorm, {2, 1}, DataFlags{}, imageData};
+        CORRADE_VERIFY(converter->add(image, "image"));
+        Utility::copy({'X', 'X', 'X', 'X'}, Containers::arrayView(imageData));
+    }
+
+    /* Only the string table and the chunk table are written at the end */
+    CORRADE_VERIFY(converter->endFile());
+
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openFile(filename));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+    CORRADE_COMPARE(importer->image2DCount(), 1);
+    CORRADE_COMPARE(importer->meshName(0), "triangle");
+    CORRADE_COMPARE(importer->image2DName(0), "image");
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector2>(MeshAttribute::Position), Containers::arrayView<Vector2>({
+        {1.0f, 2.0f}, {3.0f, 4.0f}, {5.0f, 6.0f}
+    }), TestSuite::Compare::Container);
+
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView({'a', 'b', 'c', 'd'}),
+        TestSuite::Compare::Container);
+}
+
+void MagnumSceneConverterTest::toFileCannotOpen() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->beginFile("/some/path/that/does/not/exist.blob"));
+    CORRADE_COMPARE(out.str(), "Trade::MagnumSceneConverter::beginFile(): cannot open file /some/path/that/does/not/exist.blob\n");
+}
+
+void MagnumSceneConverterTest::toFileCannotWrite() {
+    #ifndef CORRADE_TARGET_LINUX
+    CORRADE_SKIP("Writes fail only to /dev/full, which is Linux-specific.");
+    #else
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    /* Opening succeeds and the header gets buffered */
+    CORRADE_VERIFY(converter->beginFile("/dev/full"));
+
+    /* Large enough to not fit into the stdio buffer, so the write fails
+       right in add() */
+    Containers::Array<char> vertexData{ValueInit, 1024*1024};
+    const auto positions = Containers::arrayCast<Vector2>(vertexData);
+    const MeshData mesh{MeshPrimitive::Points, DataFlags{}, vertexData, {
+        MeshAttributeData{MeshAttribute::Position, positions}
+    }};
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!converter->add(mesh));
+    }
+    CORRADE_COMPARE(out.str(), "Trade::MagnumSceneConverter::add(): cannot write to the file\n");
+
+    /* The file position no longer matches the chunk offsets, so further
+       additions and finishing the file fail as well */
+    out.str({});
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!converter->add(MeshData{MeshPrimitive::Points, 3}));
+        CORRADE_VERIFY(!converter->endFile());
+    }
+    CORRADE_COMPARE(out.str(),
+        "Trade::MagnumSceneConverter::add(): a previous write to the file failed\n"
+        "Trade::MagnumSceneConverter::endFile(): cannot write to file /dev/full\n");
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MagnumSceneConverterTest)
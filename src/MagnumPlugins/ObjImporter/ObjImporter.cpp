@@ -25,7 +25,6 @@
 
 #include "ObjImporter.h"
 
-#include <fstream>
 #include <limits>
 #include <sstream>
 #include <unordered_map>
@@ -49,7 +48,10 @@ struct ObjImporter::File {
     std::unordered_map<std::string, UnsignedInt> meshesForName;
     std::vector<std::string> meshNames;
     std::vector<std::tuple<std::streampos, std::streampos, UnsignedInt, UnsignedInt, UnsignedInt>> meshes;
-    Containers::Pointer<std::istream> in;
+    /* The whole file is kept in memory and each mesh() call parses its own
+       range through a local stream, so there's no shared mutable state and
+       the data can be accessed from multiple threads at once */
+    std::string data;
 };
 
 namespace {
@@ -89,34 +91,23 @@ ObjImporter::ObjImporter(PluginManager::AbstractManager& manager, const Containe
 
 ObjImporter::~ObjImporter() = default;
 
-ImporterFeatures ObjImporter::doFeatures() const { return ImporterFeature::OpenData; }
+ImporterFeatures ObjImporter::doFeatures() const { return ImporterFeature::OpenData|ImporterFeature::ConcurrentDataAccess; }
 
 void ObjImporter::doClose() { _file.reset(); }
 
 bool ObjImporter::doIsOpened() const { return !!_file; }
 
-void ObjImporter::doOpenFile(const Containers::StringView filename) {
-    /** @todo ARGH clean this up, won't work with UTF-8 */
-    Containers::Pointer<std::istream> in{new std::ifstream{filename, std::ios::binary}};
-    if(!in->good()) {
-        Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
-        return;
-    }
-
-    _file.reset(new File);
-    _file->in = Utility::move(in);
-    parseMeshNames();
-}
-
 void ObjImporter::doOpenData(Containers::Array<char>&& data, DataFlags) {
     _file.reset(new File);
     /** @todo ARGH MY EYES what is this cursed thing, burn it to the ground */
-    _file->in.reset(new std::istringstream{{data.begin(), data.size()}});
+    _file->data.assign(data.begin(), data.size());
 
     parseMeshNames();
 }
 
 void ObjImporter::parseMeshNames() {
+    std::istringstream in{_file->data};
+
     /* First mesh starts at the beginning, its indices start from 1. The end
        offset will be updated to proper value later. */
     UnsignedInt positionIndexOffset = 1;
@@ -129,24 +120,24 @@ void ObjImporter::parseMeshNames() {
     bool thisIsFirstMeshAndItHasNoData = true;
     _file->meshNames.emplace_back();
 
-    while(_file->in->good()) {
+    while(in.good()) {
         /* The previous object might end at the beginning of this line */
-        const std::streampos end = _file->in->tellg();
+        const std::streampos end = in.tellg();
 
         /* Comment line */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
+        if(in.peek() == '#') {
+            ignoreLine(in);
             continue;
         }
 
         /* Parse the keyword */
         std::string keyword;
-        *_file->in >> keyword;
+        in >> keyword;
 
         /* Mesh name */
         if(keyword == "o") {
             std::string name;
-            std::getline(*_file->in, name);
+            std::getline(in, name);
             name = Utility::String::trim(name);
 
             /* This is the name of first mesh */
@@ -159,7 +150,7 @@ void ObjImporter::parseMeshNames() {
                 _file->meshNames.back() = Utility::move(name);
 
                 /* Update its begin offset to be more precise */
-                std::get<0>(_file->meshes.back()) = _file->in->tellg();
+                std::get<0>(_file->meshes.back()) = in.tellg();
 
             /* Otherwise this is a name of new mesh */
             } else {
@@ -171,7 +162,7 @@ void ObjImporter::parseMeshNames() {
                 if(!name.empty())
                     _file->meshesForName.emplace(name, _file->meshes.size());
                 _file->meshNames.emplace_back(Utility::move(name));
-                _file->meshes.emplace_back(_file->in->tellg(), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
+                _file->meshes.emplace_back(in.tellg(), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
             }
 
             continue;
@@ -200,13 +191,13 @@ void ObjImporter::parseMeshNames() {
         }
 
         /* Ignore the rest of the line */
-        ignoreLine(*_file->in);
+        ignoreLine(in);
     }
 
     /* Set end of the last object */
-    _file->in->clear();
-    _file->in->seekg(0, std::ios::end);
-    std::get<1>(_file->meshes.back()) = _file->in->tellg();
+    in.clear();
+    in.seekg(0, std::ios::end);
+    std::get<1>(_file->meshes.back()) = in.tellg();
 }
 
 UnsignedInt ObjImporter::doMeshCount() const { return _file->meshes.size(); }
@@ -237,11 +228,11 @@ template<class T> bool checkAndDuplicateInto(const Containers::StridedArrayView1
 }
 
 Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt) {
-    /* Seek the file, set mesh parsing parameters */
+    /* Get the mesh range, set mesh parsing parameters */
     std::streampos begin, end;
     UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
     std::tie(begin, end, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset) = _file->meshes[id];
-    _file->in->seekg(begin);
+    std::istringstream in{_file->data.substr(std::streamoff(begin), std::streamoff(end - begin))};
 
     Containers::Optional<MeshPrimitive> primitive;
     Containers::Array<Vector3> positions;
@@ -252,16 +243,16 @@ Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt)
     Containers::Array<Vector3ui> indices;
     std::size_t textureCoordinateIndexCount = 0, normalIndexCount = 0;
 
-    try { while(_file->in->good() && _file->in->tellg() < end) {
+    try { while(in.good()) {
         /* Ignore comments */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
+        if(in.peek() == '#') {
+            ignoreLine(in);
             continue;
         }
 
         /* Get the line */
         std::string line;
-        std::getline(*_file->in, line);
+        std::getline(in, line);
         line = Utility::String::trim(line);
 
         /* Ignore empty lines */
@@ -105,6 +105,12 @@ positions with optional @ref VertexFormat::Vector3 normals and
 @ref VertexFormat::Vector2 texture coordinates, if present in the source file.
 
 Polygons (quads etc.) and material properties are currently not supported.
+
+The whole file is kept in memory while opened and each @ref mesh() call parses
+only the range belonging to given mesh. The importer advertises
+@ref ImporterFeature::ConcurrentDataAccess, so meshes can be imported from
+multiple threads at once. See @ref Trade-AbstractImporter-usage-concurrent for
+more information.
 */
 class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
     public:
@@ -123,7 +129,6 @@ class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
 
         MAGNUM_OBJIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_OBJIMPORTER_LOCAL void doOpenData(Containers::Array<char>&& data, DataFlags dataFlags) override;
-        MAGNUM_OBJIMPORTER_LOCAL void doOpenFile(Containers::StringView filename) override;
         MAGNUM_OBJIMPORTER_LOCAL void doClose() override;
 
         MAGNUM_OBJIMPORTER_LOCAL UnsignedInt doMeshCount() const override;
@@ -24,6 +24,7 @@
 */
 
 #include <sstream>
+#include <thread>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/TestSuite/Tester.h>
@@ -63,6 +64,9 @@ struct ObjImporterTest: TestSuite::Tester {
     void meshNamedFirstUnnamed();
 
     void moreMeshes();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void moreMeshesConcurrent();
+    #endif
 
     /* Technically, all invalid cases could be put into a single file, but
        because the indexing is global, it would get increasingly hard to
@@ -187,7 +191,11 @@ ObjImporterTest::ObjImporterTest() {
     addInstancedTests({&ObjImporterTest::meshNamedFirstUnnamed},
         Containers::arraySize(MeshNamedFirstUnnamedData));
 
-    addTests({&ObjImporterTest::moreMeshes});
+    addTests({&ObjImporterTest::moreMeshes,
+              #ifndef CORRADE_TARGET_EMSCRIPTEN
+              &ObjImporterTest::moreMeshesConcurrent
+              #endif
+              });
 
     addInstancedTests({&ObjImporterTest::invalid},
         Containers::arraySize(InvalidData));
@@ -555,6 +563,41 @@ void ObjImporterTest::moreMeshes() {
         TestSuite::Compare::Container);
 }
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void ObjImporterTest::moreMeshesConcurrent() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->features() & ImporterFeature::ConcurrentDataAccess);
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(OBJIMPORTER_TEST_DIR, "mesh-multiple.obj")));
+    CORRADE_COMPARE(importer->meshCount(), 3);
+
+    /* Each thread imports all meshes in a different order several times,
+       remembering the index count. The test macros aren't thread-safe, so
+       the results are checked only after. */
+    UnsignedInt indexCounts[3][3][16]{};
+    std::thread threads[3];
+    for(UnsignedInt i = 0; i != 3; ++i) threads[i] = std::thread{[&](UnsignedInt thread) {
+        for(UnsignedInt iteration = 0; iteration != 16; ++iteration) {
+            for(UnsignedInt j = 0; j != 3; ++j) {
+                const UnsignedInt id = (thread + j) % 3;
+                Containers::Optional<MeshData> mesh = importer->mesh(id);
+                indexCounts[thread][id][iteration] = mesh ? mesh->indexCount() : 0;
+            }
+        }
+    }, i};
+    for(std::thread& thread: threads) thread.join();
+
+    for(UnsignedInt i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        for(UnsignedInt iteration = 0; iteration != 16; ++iteration) {
+            CORRADE_ITERATION(iteration);
+            CORRADE_COMPARE(indexCounts[i][0][iteration], 2);
+            CORRADE_COMPARE(indexCounts[i][1][iteration], 4);
+            CORRADE_COMPARE(indexCounts[i][2][iteration], 6);
+        }
+    }
+}
+#endif
+
 void ObjImporterTest::invalid() {
     auto&& data = InvalidData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -33,6 +33,7 @@
 #include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Endianness.h>
 
+#include "Magnum/ImageConversion.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Swizzle.h"
@@ -289,17 +290,13 @@ Containers::Optional<Containers::Array<char>> TgaImageConverter::doConvertToData
             reinterpret_cast<Implementation::TgaHeader*>(data.begin())->imageType &= ~8;
         }
 
-        const Containers::ArrayView<char> pixels = data.exceptPrefix(sizeof(Implementation::TgaHeader));
-        Utility::copy(image.pixels(), Containers::StridedArrayView3D<char>{pixels,
-            {std::size_t(image.size().y()), std::size_t(image.size().x()), pixelSize}});
+        const MutableImageView2D pixels{PixelStorage{}.setAlignment(1),
+            image.format(), image.size(),
+            data.exceptPrefix(sizeof(Implementation::TgaHeader))};
+        Utility::copy(image.pixels(), pixels.pixels());
 
-        if(image.format() == PixelFormat::RGB8Unorm) {
-            for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(pixels))
-                pixel = Math::gather<'b', 'g', 'r'>(pixel);
-        } else if(image.format() == PixelFormat::RGBA8Unorm) {
-            for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(pixels))
-                pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
-        }
+        if(image.format() == PixelFormat::RGB8Unorm || image.format() == PixelFormat::RGBA8Unorm)
+            swizzleBgrImageInPlace(pixels);
     }
 
     /* If we started with a RLE-encoded file, turn the array back into a
@@ -61,6 +61,8 @@ struct TgaImporterTest: TestSuite::Tester {
     void fileTooLong();
 
     void openMemory();
+    void openMemoryZeroCopy();
+    void openMemoryZeroCopyRle();
     void openTwice();
     void importTwice();
 
@@ -300,7 +302,10 @@ TgaImporterTest::TgaImporterTest() {
     addInstancedTests({&TgaImporterTest::openMemory},
         Containers::arraySize(OpenMemoryData));
 
-    addTests({&TgaImporterTest::openTwice,
+    addTests({&TgaImporterTest::openMemoryZeroCopy,
+              &TgaImporterTest::openMemoryZeroCopyRle,
+
+              &TgaImporterTest::openTwice,
               &TgaImporterTest::importTwice});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
@@ -606,6 +611,54 @@ void TgaImporterTest::openMemory() {
     }), TestSuite::Compare::Container);
 }
 
+void TgaImporterTest::openMemoryZeroCopy() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openMemory(Grayscale8));
+
+    /* Uncompressed grayscale data need no processing, so the image references
+       the pixels right after the 18-byte header without any copy */
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::ExternallyOwned);
+    CORRADE_COMPARE(static_cast<const void*>(image->data().data()), Grayscale8 + 18);
+    CORRADE_COMPARE(image->storage().alignment(), 1);
+    CORRADE_COMPARE(image->format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView<char>({
+        1, 2,
+        3, 4,
+        5, 6
+    }), TestSuite::Compare::Container);
+
+    /* The view stays valid even after the importer is gone */
+    importer = nullptr;
+    CORRADE_COMPARE(image->data()[5], 6);
+
+    /* Data passed to openData() have no guaranteed lifetime, so those are
+       copied */
+    importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(Grayscale8));
+    image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_VERIFY(static_cast<const void*>(image->data().data()) != Grayscale8 + 18);
+}
+
+void TgaImporterTest::openMemoryZeroCopyRle() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openMemory(Grayscale8Rle));
+
+    /* RLE data have to be decoded, which means a copy */
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView<char>({
+        1, 2,
+        3, 3,
+        5, 6
+    }), TestSuite::Compare::Container);
+}
+
 void TgaImporterTest::openTwice() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
 
@@ -31,9 +31,9 @@
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Endianness.h>
 
+#include "Magnum/ImageConversion.h"
+#include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
-#include "Magnum/Math/Swizzle.h"
-#include "Magnum/Math/Vector4.h"
 #include "Magnum/Trade/ImageData.h"
 #include "MagnumPlugins/TgaImporter/TgaHeader.h"
 
@@ -73,6 +73,10 @@ void TgaImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dat
         _in = Containers::Array<char>{NoInit, data.size()};
         Utility::copy(data, _in);
     }
+
+    /* If the memory outlives the importer, uncompressed images that need no
+       further processing can reference it directly in doImage2D() */
+    _inExternallyOwned = !!(dataFlags & DataFlag::ExternallyOwned);
 }
 
 UnsignedInt TgaImporter::doImage2DCount() const { return 1; }
@@ -181,8 +185,13 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
         }
     }
 
+    /* Adjust pixel storage if row size is not four byte aligned */
+    PixelStorage storage;
+    if((size.x()*header.bpp/8)%4 != 0)
+        storage.setAlignment(1);
+
     /* Copy data directly if not RLE */
-    Containers::Array<char> data{outputSize};
+    Containers::Array<char> data;
     if(!rle) {
         if(srcPixels.size() < outputSize) {
             Error{} << "Trade::TgaImporter::image2D(): file too short, expected" << outputSize + sizeof(Implementation::TgaHeader) << "bytes but got" << _in.size();
@@ -196,10 +205,18 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
             Warning{} << "Trade::TgaImporter::image2D(): ignoring" << srcPixels.size() - outputSize << "extra bytes at the end of image data";
         }
 
+        /* If the memory passed to openMemory() is guaranteed to stay in
+           scope and there's no BGR(A) swizzle to be done, reference it
+           directly instead of making a copy */
+        if(_inExternallyOwned && format == PixelFormat::R8Unorm)
+            return ImageData2D{storage, format, size, DataFlag::ExternallyOwned, srcPixels.prefix(outputSize)};
+
+        data = Containers::Array<char>{NoInit, outputSize};
         Utility::copy(srcPixels.prefix(data.size()), data);
 
     /* Otherwise decode */
     } else {
+        data = Containers::Array<char>{ValueInit, outputSize};
         Containers::ArrayView<char> dstPixels = data;
         while(!srcPixels.isEmpty()) {
             /* Reference: http://www.paulbourke.net/dataformats/tga/ */
@@ -240,21 +257,14 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
         }
     }
 
-    /* Adjust pixel storage if row size is not four byte aligned */
-    PixelStorage storage;
-    if((size.x()*header.bpp/8)%4 != 0)
-        storage.setAlignment(1);
-
-    if(format == PixelFormat::RGB8Unorm) {
-        if(flags() & ImporterFlag::Verbose)
-            Debug{} << "Trade::TgaImporter::image2D(): converting from BGR to RGB";
-        for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(data))
-            pixel = Math::gather<'b', 'g', 'r'>(pixel);
-    } else if(format == PixelFormat::RGBA8Unorm) {
-        if(flags() & ImporterFlag::Verbose)
-            Debug{} << "Trade::TgaImporter::image2D(): converting from BGRA to RGBA";
-        for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(data))
-            pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+    if(format == PixelFormat::RGB8Unorm || format == PixelFormat::RGBA8Unorm) {
+        if(flags() & ImporterFlag::Verbose) {
+            if(format == PixelFormat::RGB8Unorm)
+                Debug{} << "Trade::TgaImporter::image2D(): converting from BGR to RGB";
+            else
+                Debug{} << "Trade::TgaImporter::image2D(): converting from BGRA to RGBA";
+        }
+        swizzleBgrImageInPlace(MutableImageView2D{storage, format, size, data});
     }
 
     return ImageData2D{storage, format, size, Utility::move(data)};
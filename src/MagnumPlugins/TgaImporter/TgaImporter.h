@@ -106,6 +106,13 @@ which may be changed to `1` if the data require it.
 
 RLE compression is supported, paletted images are not.
 
+If the file is opened with @ref openMemory(), uncompressed grayscale images are
+returned as a view directly on the passed memory, with
+@ref ImageData::dataFlags() being @ref DataFlag::ExternallyOwned, avoiding
+a copy. Color images are always copied as they need to be converted from BGR
+/ BGRA to RGB / RGBA, RLE-compressed images are decoded into a newly allocated
+array.
+
 If a TGA 2 footer is recognized in the file, the optional extension and
 developer area blocks at the end of the file are ignored.
 
@@ -132,6 +139,7 @@ class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
         MAGNUM_TGAIMPORTER_LOCAL Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt level) override;
 
         Containers::Array<char> _in;
+        bool _inExternallyOwned{};
 };
 
 }}
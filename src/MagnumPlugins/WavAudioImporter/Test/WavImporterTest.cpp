@@ -26,10 +26,13 @@
 
 #include <sstream>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/Containers/StringStl.h> /** @todo remove once AbstractImporter is <string>-free */
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/String.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Path.h>
 
@@ -39,6 +42,14 @@
 
 namespace Magnum { namespace Audio { namespace Test { namespace {
 
+const struct {
+    const char* name;
+    bool openData;
+} StreamingData[]{
+    {"from a file", false},
+    {"from data", true}
+};
+
 struct WavImporterTest: TestSuite::Tester {
     explicit WavImporterTest();
 
@@ -80,6 +91,15 @@ struct WavImporterTest: TestSuite::Tester {
     void surround51Channel16();
     void surround71Channel24();
 
+    void openFileNotFound();
+    void dataFromOpenData();
+    void streaming();
+    void streamingSeek();
+
+    void openMemory();
+    void openMemoryBigEndian();
+    void dataViewFromFile();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
@@ -121,7 +141,18 @@ WavImporterTest::WavImporterTest() {
               &WavImporterTest::stereo64fBigEndian,
 
               &WavImporterTest::surround51Channel16,
-              &WavImporterTest::surround71Channel24});
+              &WavImporterTest::surround71Channel24,
+
+              &WavImporterTest::openFileNotFound,
+              &WavImporterTest::dataFromOpenData});
+
+    addInstancedTests({&WavImporterTest::streaming,
+                       &WavImporterTest::streamingSeek},
+        Containers::arraySize(StreamingData));
+
+    addTests({&WavImporterTest::openMemory,
+              &WavImporterTest::openMemoryBigEndian,
+              &WavImporterTest::dataViewFromFile});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
@@ -471,6 +502,189 @@ void WavImporterTest::surround71Channel24() {
     CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::Extensible\n");
 }
 
+void WavImporterTest::openFileNotFound() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openFile("nonexistent.wav"));
+    /* There's an error from Path::mapRead() or Path::read() before */
+    CORRADE_COMPARE_AS(out.str(),
+        "::openFile(): cannot ",
+        TestSuite::Compare::StringContains);
+}
+
+void WavImporterTest::dataFromOpenData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+
+    /* The data are copied and endian-swapped on open, unlike with openFile()
+       where the swap happens when copying the data out. The file data should
+       not be needed after. */
+    {
+        Containers::Optional<Containers::Array<char>> data = Utility::Path::read(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "mono16be.wav"));
+        CORRADE_VERIFY(data);
+        CORRADE_VERIFY(importer->openData(*data));
+    }
+
+    CORRADE_COMPARE(importer->format(), BufferFormat::Mono16);
+    CORRADE_COMPARE(importer->frequency(), 44000);
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedShort>(importer->data()),
+        Containers::arrayView<UnsignedShort>({0x101d, 0xc571}),
+        TestSuite::Compare::Container);
+}
+
+void WavImporterTest::streaming() {
+    auto&& data = StreamingData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->features() & ImporterFeature::Streaming);
+
+    /* Big-endian data to verify the swapping is done for each chunk */
+    Containers::String filename = Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "mono32fbe.wav");
+    Containers::Optional<Containers::Array<char>> fileData;
+    if(data.openData) {
+        fileData = Utility::Path::read(filename);
+        CORRADE_VERIFY(fileData);
+        CORRADE_VERIFY(importer->openData(*fileData));
+    } else CORRADE_VERIFY(importer->openFile(filename));
+
+    CORRADE_COMPARE(importer->format(), BufferFormat::MonoFloat);
+    CORRADE_COMPARE(importer->frameCount(), 4);
+    CORRADE_COMPARE(importer->frameOffset(), 0);
+
+    Float out[3];
+    CORRADE_COMPARE(importer->readInto(out), 3);
+    CORRADE_COMPARE_AS(Containers::arrayView(out),
+        Containers::arrayView<Float>({0.0f, 0.00467603f, 0.010391f}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(importer->frameOffset(), 3);
+
+    CORRADE_COMPARE(importer->readInto(out), 1);
+    CORRADE_COMPARE(out[0], 0.0166854f);
+    CORRADE_COMPARE(importer->frameOffset(), 4);
+
+    CORRADE_COMPARE(importer->readInto(out), 0);
+    CORRADE_COMPARE(importer->frameOffset(), 4);
+
+    /* Streaming doesn't affect data() */
+    CORRADE_COMPARE_AS(Containers::arrayCast<Float>(importer->data()),
+        Containers::arrayView<Float>({0.0f, 0.00467603f, 0.010391f, 0.0166854f}),
+        TestSuite::Compare::Container);
+}
+
+void WavImporterTest::streamingSeek() {
+    auto&& data = StreamingData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+
+    Containers::String filename = Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo16.wav");
+    Containers::Optional<Containers::Array<char>> fileData;
+    if(data.openData) {
+        fileData = Utility::Path::read(filename);
+        CORRADE_VERIFY(fileData);
+        CORRADE_VERIFY(importer->openData(*fileData));
+    } else CORRADE_VERIFY(importer->openFile(filename));
+
+    CORRADE_COMPARE(importer->format(), BufferFormat::Stereo16);
+    CORRADE_COMPARE(importer->frameCount(), 1);
+
+    UnsignedShort out[2];
+    CORRADE_COMPARE(importer->readInto(out), 1);
+    CORRADE_COMPARE(importer->readInto(out), 0);
+
+    /* Seek back and read again, should give the same result */
+    importer->seek(0);
+    CORRADE_COMPARE(importer->frameOffset(), 0);
+    UnsignedShort again[2];
+    CORRADE_COMPARE(importer->readInto(again), 1);
+    CORRADE_COMPARE_AS(Containers::arrayView(again),
+        Containers::arrayView(out),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(again),
+        Containers::arrayCast<const UnsignedShort>(importer->data()),
+        TestSuite::Compare::Container);
+
+    /* Reopening resets the offset */
+    if(data.openData) CORRADE_VERIFY(importer->openData(*fileData));
+    else CORRADE_VERIFY(importer->openFile(filename));
+    CORRADE_COMPARE(importer->frameOffset(), 0);
+}
+
+void WavImporterTest::openMemory() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->features() & ImporterFeature::DataView);
+
+    Containers::Optional<Containers::Array<char>> file = Utility::Path::read(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo8.wav"));
+    CORRADE_VERIFY(file);
+    CORRADE_VERIFY(importer->openMemory(*file));
+
+    CORRADE_COMPARE(importer->format(), BufferFormat::Stereo8);
+    CORRADE_COMPARE(importer->frequency(), 96000);
+
+    /* The view points directly into the passed memory, right after the
+       44-byte header, i.e. no payload-sized copy was made */
+    Containers::ArrayView<const char> view = importer->dataView();
+    CORRADE_COMPARE(static_cast<const void*>(view.data()), file->data() + 44);
+    CORRADE_COMPARE_AS(view, Containers::arrayView<char>({
+        '\xde', '\xfe', '\xca', '\x7e'
+    }), TestSuite::Compare::Container);
+
+    /* Streaming reads from the same memory */
+    char out[2];
+    CORRADE_COMPARE(importer->readInto(out), 1);
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView<char>({
+        '\xde', '\xfe'
+    }), TestSuite::Compare::Container);
+
+    /* The data() is still an independent copy */
+    Containers::Array<char> copy = importer->data();
+    CORRADE_VERIFY(copy.data() != view.data());
+    CORRADE_COMPARE_AS(copy, view, TestSuite::Compare::Container);
+}
+
+void WavImporterTest::openMemoryBigEndian() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The file matches machine endianness, nothing to convert.");
+    #endif
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+
+    Containers::Optional<Containers::Array<char>> file = Utility::Path::read(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "mono16be.wav"));
+    CORRADE_VERIFY(file);
+    CORRADE_VERIFY(importer->openMemory(*file));
+
+    /* The data need swapping, so the view can't point to the original memory
+       but the memory itself stays untouched */
+    Containers::Array<char> original{NoInit, file->size()};
+    Utility::copy(*file, original);
+    Containers::ArrayView<const char> view = importer->dataView();
+    CORRADE_VERIFY(view.data() < file->begin() || view.data() >= file->end());
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedShort>(view),
+        Containers::arrayView<UnsignedShort>({0x101d, 0xc571}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(*file, original, TestSuite::Compare::Container);
+
+    /* Subsequent calls return the same converted copy, streaming uses it as
+       well */
+    CORRADE_COMPARE(importer->dataView().data(), view.data());
+    UnsignedShort out[2];
+    CORRADE_COMPARE(importer->readInto(out), 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(out),
+        Containers::arrayView<UnsignedShort>({0x101d, 0xc571}),
+        TestSuite::Compare::Container);
+}
+
+void WavImporterTest::dataViewFromFile() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo8.wav")));
+
+    CORRADE_COMPARE_AS(importer->dataView(), Containers::arrayView<char>({
+        '\xde', '\xfe', '\xca', '\x7e'
+    }), TestSuite::Compare::Container);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::WavImporterTest)
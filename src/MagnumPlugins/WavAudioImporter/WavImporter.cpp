@@ -26,13 +26,23 @@
 
 #include "WavImporter.h"
 
+#include <string>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringStl.h> /** @todo remove once AbstractImporter is <string>-free */
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/DebugStl.h> /** @todo remove once AbstractImporter is <string>-free */
 #include <Corrade/Utility/EndiannessBatch.h>
+#include <Corrade/Utility/Path.h>
 
+#include "Magnum/Audio/BufferFormat.h"
 #include "MagnumPlugins/WavAudioImporter/WavHeader.h"
 
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+#define MAGNUM_WAVAUDIOIMPORTER_USE_MAP
+#endif
+
 namespace Magnum { namespace Audio {
 
 using Implementation::RiffChunk;
@@ -40,29 +50,101 @@ using Implementation::WavAudioFormat;
 using Implementation::WavFormatChunk;
 using Implementation::WavHeaderChunk;
 
+struct WavImporter::State {
+    /* Parses the file header and sets up everything except the ownership.
+       The data view points into the passed data. */
+    bool parse(Containers::ArrayView<const char> file);
+
+    /* Converts endianness of the given data if the file endianness doesn't
+       match the machine */
+    void fixEndianness(Containers::ArrayView<char> out) const;
+
+    #ifdef MAGNUM_WAVAUDIOIMPORTER_USE_MAP
+    Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> mapped;
+    #endif
+    Containers::Array<char> owned;
+    /* Contents of the data chunk */
+    Containers::ArrayView<const char> data;
+
+    BufferFormat format;
+    UnsignedInt frequency;
+    UnsignedInt frameSize;
+    /* Size of a single sample for endian swapping, 0 if no swapping is
+       needed */
+    UnsignedInt swapSize;
+    std::size_t frameOffset;
+};
+
 WavImporter::WavImporter() = default;
 
 WavImporter::WavImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractImporter{manager, plugin} {}
 
-ImporterFeatures WavImporter::doFeatures() const { return ImporterFeature::OpenData; }
+WavImporter::~WavImporter() = default;
+
+ImporterFeatures WavImporter::doFeatures() const { return ImporterFeature::OpenData|ImporterFeature::Streaming|ImporterFeature::DataView; }
 
-bool WavImporter::doIsOpened() const { return !!_data; }
+bool WavImporter::doIsOpened() const { return !!_state; }
 
 void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
-    /* Check file size */
-    if(data.size() < sizeof(WavHeaderChunk) + sizeof(WavFormatChunk) + sizeof(RiffChunk)) {
-        Error() << "Audio::WavImporter::openData(): the file is too short:" << data.size() << "bytes";
+    Containers::Pointer<State> state{InPlaceInit};
+    if(!state->parse(data)) return;
+
+    /* The view isn't guaranteed to stay valid after the call, so copy the
+       data chunk and fix its endianness upfront */
+    state->owned = Containers::Array<char>{NoInit, state->data.size()};
+    Utility::copy(state->data, state->owned);
+    state->fixEndianness(state->owned);
+    state->data = state->owned;
+    state->swapSize = 0;
+
+    _state = Utility::move(state);
+}
+
+void WavImporter::doOpenMemory(const Containers::ArrayView<const char> memory) {
+    /* The memory is guaranteed to stay valid until close(), so reference it
+       directly. Endianness is fixed when copying out. */
+    Containers::Pointer<State> state{InPlaceInit};
+    if(!state->parse(memory)) return;
+
+    _state = Utility::move(state);
+}
+
+void WavImporter::doOpenFile(const std::string& filename) {
+    #ifdef MAGNUM_WAVAUDIOIMPORTER_USE_MAP
+    Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> mapped = Utility::Path::mapRead(filename);
+    if(!mapped) {
+        Error() << "Audio::WavImporter::openFile(): cannot map file" << filename;
         return;
     }
 
+    /* The mapping stays around until close(), so the data can be referenced
+       directly and only the parts that are actually read get paged in.
+       Endianness is fixed when copying out. */
+    Containers::Pointer<State> state{InPlaceInit};
+    if(!state->parse(*mapped)) return;
+    state->mapped = Utility::move(mapped);
+
+    _state = Utility::move(state);
+    #else
+    AbstractImporter::doOpenFile(filename);
+    #endif
+}
+
+bool WavImporter::State::parse(const Containers::ArrayView<const char> file) {
+    /* Check file size */
+    if(file.size() < sizeof(WavHeaderChunk) + sizeof(WavFormatChunk) + sizeof(RiffChunk)) {
+        Error() << "Audio::WavImporter::openData(): the file is too short:" << file.size() << "bytes";
+        return false;
+    }
+
     /* Get the RIFF/WAV header */
-    WavHeaderChunk header(*reinterpret_cast<const WavHeaderChunk*>(data.begin()));
+    WavHeaderChunk header(*reinterpret_cast<const WavHeaderChunk*>(file.begin()));
 
     /* Check RIFF/WAV file signature */
     if((std::strncmp(header.chunk.chunkId, "RIFF", 4) != 0 && std::strncmp(header.chunk.chunkId, "RIFX", 4) != 0) ||
        std::strncmp(header.format, "WAVE", 4) != 0) {
         Error() << "Audio::WavImporter::openData(): the file signature is invalid";
-        return;
+        return false;
     }
 
     /* Check if the file is Big-Endian. While RIFX files are extremely rare,
@@ -74,10 +156,10 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
         Utility::Endianness::swapInPlace(header.chunk.chunkSize);
 
     /* Check file size */
-    if(header.chunk.chunkSize < 36 || header.chunk.chunkSize + 8 != data.size()) {
+    if(header.chunk.chunkSize < 36 || header.chunk.chunkSize + 8 != file.size()) {
         Error() << "Audio::WavImporter::openData(): the file has improper size, expected"
-                << header.chunk.chunkSize + 8 << "but got" << data.size();
-        return;
+                << header.chunk.chunkSize + 8 << "but got" << file.size();
+        return false;
     }
 
     const RiffChunk* dataChunk = nullptr;
@@ -91,7 +173,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
 
     /* Skip any chunks that aren't the format or data chunk */
     while(headerSize + offset <= header.chunk.chunkSize) {
-        const RiffChunk* currChunk = reinterpret_cast<const RiffChunk*>(data.begin() + headerSize + offset);
+        const RiffChunk* currChunk = reinterpret_cast<const RiffChunk*>(file.begin() + headerSize + offset);
         UnsignedInt chunkSize = currChunk->chunkSize;
         if(hasBigEndianData != Utility::Endianness::isBigEndian())
             Utility::Endianness::swapInPlace(chunkSize);
@@ -101,7 +183,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
         if(std::strncmp(currChunk->chunkId, "fmt ", 4) == 0) {
             if(formatChunk) {
                 Error() << "Audio::WavImporter::openData(): the file contains too many format chunks";
-                return;
+                return false;
             }
 
             formatChunk = WavFormatChunk{*reinterpret_cast<const WavFormatChunk*>(currChunk)};
@@ -109,7 +191,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
         } else if(std::strncmp(currChunk->chunkId, "data", 4) == 0) {
             if(dataChunk != nullptr) {
                 Error() << "Audio::WavImporter::openData(): the file contains too many data chunks";
-                return;
+                return false;
             }
 
             dataChunk = currChunk;
@@ -121,13 +203,13 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     /* Make sure we actually got a format chunk */
     if(!formatChunk) {
         Error() << "Audio::WavImporter::openData(): the file contains no format chunk";
-        return;
+        return false;
     }
 
     /* Make sure we actually got a data chunk */
     if(dataChunk == nullptr) {
         Error() << "Audio::WavImporter::openData(): the file contains no data chunk";
-        return;
+        return false;
     }
 
     /* Fix endianness on Format chunk */
@@ -142,113 +224,162 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     if(formatChunk->audioFormat == WavAudioFormat::Pcm) {
         /* Decide about format */
         if(formatChunk->numChannels == 1 && formatChunk->bitsPerSample == 8)
-            _format = BufferFormat::Mono8;
+            format = BufferFormat::Mono8;
         else if(formatChunk->numChannels == 1 && formatChunk->bitsPerSample == 16)
-            _format = BufferFormat::Mono16;
+            format = BufferFormat::Mono16;
         else if(formatChunk->numChannels == 2 && formatChunk->bitsPerSample == 8)
-            _format = BufferFormat::Stereo8;
+            format = BufferFormat::Stereo8;
         else if(formatChunk->numChannels == 2 && formatChunk->bitsPerSample == 16)
-             _format = BufferFormat::Stereo16;
+             format = BufferFormat::Stereo16;
         else {
             Error() << "Audio::WavImporter::openData(): PCM with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return false;
         }
 
     /* Check IEEE Float format */
     } else if(formatChunk->audioFormat == WavAudioFormat::IeeeFloat) {
         if(formatChunk->numChannels == 1 && formatChunk->bitsPerSample == 32)
-            _format = BufferFormat::MonoFloat;
+            format = BufferFormat::MonoFloat;
         else if(formatChunk->numChannels == 2 && formatChunk->bitsPerSample == 32)
-            _format = BufferFormat::StereoFloat;
+            format = BufferFormat::StereoFloat;
         else if(formatChunk->numChannels == 1 && formatChunk->bitsPerSample == 64)
-            _format = BufferFormat::MonoDouble;
+            format = BufferFormat::MonoDouble;
         else if(formatChunk->numChannels == 2 && formatChunk->bitsPerSample == 64)
-            _format = BufferFormat::StereoDouble;
+            format = BufferFormat::StereoDouble;
         else {
             Error() << "Audio::WavImporter::openData(): IEEE with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return false;
         }
 
     /* Check A-Law format */
     } else if(formatChunk->audioFormat == WavAudioFormat::ALaw) {
         if(formatChunk->numChannels == 1)
-            _format = BufferFormat::MonoALaw;
+            format = BufferFormat::MonoALaw;
         else if(formatChunk->numChannels == 2)
-            _format = BufferFormat::StereoALaw;
+            format = BufferFormat::StereoALaw;
         else {
             Error() << "Audio::WavImporter::openData(): ALaw with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return false;
         }
 
     /* Check μ-Law format */
     } else if(formatChunk->audioFormat == WavAudioFormat::MuLaw) {
         if(formatChunk->numChannels == 1)
-            _format = BufferFormat::MonoMuLaw;
+            format = BufferFormat::MonoMuLaw;
         else if(formatChunk->numChannels == 2)
-            _format = BufferFormat::StereoMuLaw;
+            format = BufferFormat::StereoMuLaw;
         else {
             Error() << "Audio::WavImporter::openData(): MuLaw with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return false;
         }
 
     /* Unknown/unimplemented format */
     } else {
         Error() << "Audio::WavImporter::openData(): unsupported format" << formatChunk->audioFormat;
-        return;
+        return false;
     }
 
     /* Size sanity checks */
-    if(headerSize + offset > data.size()) {
+    if(headerSize + offset > file.size()) {
         Error() << "Audio::WavImporter::openData(): file size doesn't match computed size";
-        return;
+        return false;
     }
 
     /* Format sanity checks */
     if(formatChunk->blockAlign != formatChunk->numChannels * formatChunk->bitsPerSample / 8 ||
        formatChunk->byteRate != formatChunk->sampleRate * formatChunk->blockAlign) {
         Error() << "Audio::WavImporter::openData(): the file is corrupted";
-        return;
+        return false;
     }
 
     /* Save frequency */
-    _frequency = formatChunk->sampleRate;
+    frequency = formatChunk->sampleRate;
 
-    /* Copy the data */
-    _data = Containers::Array<char>{NoInit, dataChunkSize};
-    Utility::copy(Containers::arrayView(reinterpret_cast<const char*>(dataChunk + 1), dataChunkSize), *_data);
+    /* Reference the data, cutting away a trailing partial frame if there's
+       any */
+    frameSize = bufferFormatSize(format);
+    data = Containers::arrayView(reinterpret_cast<const char*>(dataChunk + 1), dataChunkSize - dataChunkSize % frameSize);
+    frameOffset = 0;
 
-    /* Fix the data endianness */
+    /* Remember whether the data endianness needs to be fixed */
     if(hasBigEndianData != Utility::Endianness::isBigEndian()) {
-        if(formatChunk->bitsPerSample == 16)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint16_t>(*_data));
-        else if(formatChunk->bitsPerSample == 32)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint32_t>(*_data));
-        else if(formatChunk->bitsPerSample == 64)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint64_t>(*_data));
-        else CORRADE_INTERNAL_ASSERT(formatChunk->bitsPerSample == 8);
-    }
+        CORRADE_INTERNAL_ASSERT(formatChunk->bitsPerSample == 8 ||
+                                formatChunk->bitsPerSample == 16 ||
+                                formatChunk->bitsPerSample == 32 ||
+                                formatChunk->bitsPerSample == 64);
+        swapSize = formatChunk->bitsPerSample == 8 ? 0 : formatChunk->bitsPerSample/8;
+    } else swapSize = 0;
+
+    return true;
 }
 
-void WavImporter::doClose() { _data = Containers::NullOpt; }
+void WavImporter::State::fixEndianness(const Containers::ArrayView<char> out) const {
+    if(swapSize == 2)
+        Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint16_t>(out));
+    else if(swapSize == 4)
+        Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint32_t>(out));
+    else if(swapSize == 8)
+        Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint64_t>(out));
+    else CORRADE_INTERNAL_ASSERT(swapSize == 0);
+}
 
-BufferFormat WavImporter::doFormat() const { return _format; }
+void WavImporter::doClose() { _state = nullptr; }
 
-UnsignedInt WavImporter::doFrequency() const { return _frequency; }
+BufferFormat WavImporter::doFormat() const { return _state->format; }
+
+UnsignedInt WavImporter::doFrequency() const { return _state->frequency; }
 
 Containers::Array<char> WavImporter::doData() {
-    Containers::Array<char> copy{NoInit, _data->size()};
-    Utility::copy(*_data, copy);
+    Containers::Array<char> copy{NoInit, _state->data.size()};
+    Utility::copy(_state->data, copy);
+    _state->fixEndianness(copy);
     return copy;
 }
 
+Containers::ArrayView<const char> WavImporter::doDataView() {
+    /* If the endianness doesn't match, there's no way around a copy. Make it
+       just once and reference it from the state for subsequent calls and
+       streaming as well. */
+    if(_state->swapSize) {
+        _state->owned = Containers::Array<char>{NoInit, _state->data.size()};
+        Utility::copy(_state->data, _state->owned);
+        _state->fixEndianness(_state->owned);
+        _state->data = _state->owned;
+        _state->swapSize = 0;
+    }
+
+    return _state->data;
+}
+
+std::size_t WavImporter::doFrameCount() const {
+    return _state->data.size()/_state->frameSize;
+}
+
+std::size_t WavImporter::doFrameOffset() const {
+    return _state->frameOffset;
+}
+
+void WavImporter::doReadInto(const Containers::ArrayView<char> destination) {
+    /* The base implementation guarantees the destination is whole frames and
+       not larger than what's left */
+    const std::size_t offset = _state->frameOffset*_state->frameSize;
+    Utility::copy(_state->data.slice(offset, offset + destination.size()), destination);
+    _state->fixEndianness(destination);
+    _state->frameOffset += destination.size()/_state->frameSize;
+}
+
+void WavImporter::doSeek(const std::size_t frame) {
+    _state->frameOffset = frame;
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(WavAudioImporter, Magnum::Audio::WavImporter,
@@ -31,7 +31,7 @@
  */
 
 #include <Corrade/Containers/Array.h>
-#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Audio/AbstractImporter.h"
 
@@ -117,6 +117,26 @@ Both Little-Endian files (with a `RIFF` header) and Big-Endian files (with
 a `RIFX` header) are supported, data is converted to machine endian on import.
 
 Multi-channel formats are not supported.
+
+@subsection Audio-WavImporter-behavior-streaming Streaming decoding
+
+The plugin supports @ref ImporterFeature::Streaming. Files opened with
+@ref openFile() are memory-mapped on platforms that support it and the
+@ref readInto() as well as @ref data() calls copy directly from the mapped
+file, converting endianness on the fly if needed. This means that only the
+parts of the file that are actually read are paged into memory, which makes
+it suitable for playing long tracks using @ref BufferStream. Data passed to
+@ref openData() are copied, as the view isn't guaranteed to stay valid after
+the call.
+
+@subsection Audio-WavImporter-behavior-zero-copy Zero-copy import
+
+The plugin supports @ref ImporterFeature::DataView. Memory passed to
+@ref openMemory() is referenced directly without a copy, same as a
+memory-mapped file opened with @ref openFile(), and the view returned by
+@ref dataView() then points straight into it. The only exception is a file
+with endianness not matching the machine, in which case the first
+@ref dataView() call makes a converted copy of the data chunk.
 */
 class MAGNUM_WAVAUDIOIMPORTER_EXPORT WavImporter: public AbstractImporter {
     public:
@@ -126,19 +146,29 @@ class MAGNUM_WAVAUDIOIMPORTER_EXPORT WavImporter: public AbstractImporter {
         /** @brief Plugin manager constructor */
         explicit WavImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
 
+        ~WavImporter();
+
     private:
+        struct State;
+
         MAGNUM_WAVAUDIOIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenMemory(Containers::ArrayView<const char> memory) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doClose() override;
 
         MAGNUM_WAVAUDIOIMPORTER_LOCAL BufferFormat doFormat() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL Containers::ArrayView<const char> doDataView() override;
+
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t doFrameCount() const override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t doFrameOffset() const override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void doReadInto(Containers::ArrayView<char> destination) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void doSeek(std::size_t frame) override;
 
-        Containers::Optional<Containers::Array<char>> _data;
-        BufferFormat _format;
-        UnsignedInt _frequency;
+        Containers::Pointer<State> _state;
 };
 
 }}